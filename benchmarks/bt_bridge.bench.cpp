@@ -0,0 +1,148 @@
+#include "../src/hardware/btBridge.h"
+#include <benchmark/benchmark.h>
+#include <httplib.h>
+#include <chrono>
+#include <csignal>
+#include <fstream>
+#include <functional>
+#include <sstream>
+#include <string>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+
+// Round trip of a device list query against a helper process, and the helper's CPU per call.
+// Http replays the old path: a fresh httplib client over the unix socket for each request, as the
+// BTControl getters did. Bridge sends the same query as a framed request on one long-lived
+// connection. The helper is a forked child so its CPU is read from /proc apart from the caller's.
+
+namespace {
+
+using namespace std::chrono_literals;
+
+const nlohmann::json kDevices = nlohmann::json::array({
+    { { "name", "device1" }, { "mac", "00:00:00:00:00:00" }, { "paired", true }, { "connected", true } },
+    { { "name", "device2" }, { "mac", "00:00:00:00:00:01" }, { "paired", false }, { "connected", false } },
+    { { "name", "device3" }, { "mac", "00:00:00:00:00:02" }, { "paired", true }, { "connected", false } },
+});
+
+class Helper {
+public:
+    explicit Helper(std::function<void()> run)
+    {
+        this->pid = fork();
+        if (this->pid == 0) {
+            run();
+            _exit(0);
+        }
+    }
+    ~Helper()
+    {
+        if (this->pid > 0) {
+            kill(this->pid, SIGKILL);
+            waitpid(this->pid, nullptr, 0);
+        }
+    }
+    bool running() const { return this->pid > 0; }
+
+    // utime + stime in clock ticks.
+    long cpuTicks() const
+    {
+        std::ifstream stat("/proc/" + std::to_string(this->pid) + "/stat");
+        std::string line;
+        std::getline(stat, line);
+        std::istringstream fields(line.substr(line.rfind(')') + 2));
+        std::string field;
+        long ticks = 0;
+        for (int i = 3; i <= 15 && fields >> field; i++) {
+            if (i >= 14) {
+                ticks += std::stol(field);
+            }
+        }
+        return ticks;
+    }
+
+private:
+    pid_t pid = -1;
+};
+
+std::string socketPath(const char* name)
+{
+    return "/tmp/cube_bench_" + std::to_string(getpid()) + "_" + name + ".sock";
+}
+
+void reportHelperCpu(benchmark::State& state, const Helper& helper, long startTicks)
+{
+    const double cpuUs = static_cast<double>(helper.cpuTicks() - startTicks) * 1e6 / static_cast<double>(sysconf(_SC_CLK_TCK));
+    state.counters["helper_cpu_us_per_call"] = benchmark::Counter(cpuUs / static_cast<double>(state.iterations()));
+}
+
+void BM_BtQuery_Http(benchmark::State& state)
+{
+    const std::string path = socketPath("http");
+    unlink(path.c_str());
+    Helper helper([&path] {
+        httplib::Server server;
+        server.set_address_family(AF_UNIX);
+        server.Get("/devices", [](const httplib::Request&, httplib::Response& res) {
+            res.set_content(kDevices.dump(), "application/json");
+        });
+        server.listen(path, 80);
+    });
+    for (int i = 0; i < 200 && access(path.c_str(), F_OK) != 0; i++) {
+        std::this_thread::sleep_for(5ms);
+    }
+    const long startTicks = helper.cpuTicks();
+    for (auto _ : state) {
+        httplib::Client client(path);
+        client.set_address_family(AF_UNIX);
+        auto res = client.Get("/devices");
+        if (!res || res->status != 200) {
+            state.SkipWithError("http helper unreachable");
+            break;
+        }
+        benchmark::DoNotOptimize(nlohmann::json::parse(res->body));
+    }
+    reportHelperCpu(state, helper, startTicks);
+    unlink(path.c_str());
+}
+BENCHMARK(BM_BtQuery_Http)->MeasureProcessCPUTime()->UseRealTime();
+
+void BM_BtQuery_Bridge(benchmark::State& state)
+{
+    const std::string path = socketPath("bridge");
+    Helper helper([&path] {
+        BtBridgeStandIn standIn(path);
+        standIn.handle("devices", [](const nlohmann::json&) -> std::expected<nlohmann::json, std::string> { return kDevices; });
+        if (!standIn.start()) {
+            return;
+        }
+        while (true) {
+            pause();
+        }
+    });
+    BtBridgeOptions options;
+    options.socketPath = path;
+    options.reconnectDelay = 5ms;
+    BtBridgeClient client(options);
+    client.start();
+    for (int i = 0; i < 200 && !client.isConnected(); i++) {
+        std::this_thread::sleep_for(5ms);
+    }
+    const long startTicks = helper.cpuTicks();
+    for (auto _ : state) {
+        auto result = client.call("devices");
+        if (!result) {
+            state.SkipWithError(btBridgeErrorToString(result.error()));
+            break;
+        }
+        benchmark::DoNotOptimize(*result);
+    }
+    reportHelperCpu(state, helper, startTicks);
+    client.stop();
+}
+BENCHMARK(BM_BtQuery_Bridge)->MeasureProcessCPUTime()->UseRealTime();
+
+} // namespace
@@ -0,0 +1,181 @@
+#include "../src/gui/animationTrack.h"
+#include "../src/gui/objects.h"
+#include <benchmark/benchmark.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <vector>
+
+// Per-tick CPU cost of playing Character_TheCube's anim_neutral_1 (keyframes copied below) on the
+// character's three parts. BM_AnimationTickPerKeyframe is the old Character_generic::animate() loop:
+// every keyframe copied and tested each tick, easing through std::function, one virtual call per live
+// keyframe per object. BM_AnimationTickCompiled evaluates the compiled AnimationTrack and folds each
+// tick into one scene graph write per object. Both report ticks as items; no GL is involved.
+
+namespace {
+
+const char* NEUTRAL_FRAMES = R"([
+    { "type": "ROTATE_ABOUT", "value": -30, "time": { "start": 0, "end": 20 }, "easing": "easeInOut", "axis": { "x": 0, "y": 1, "z": 0 }, "point": { "x": 0, "y": 0, "z": -16.5 } },
+    { "type": "SCALE_XYZ", "value": -0.9, "time": { "start": 0, "end": 20 }, "easing": "linear", "axis": { "x": 0, "y": 1, "z": 0 }, "point": { "x": 1, "y": 1, "z": 1 } },
+    { "type": "ROTATE_ABOUT", "value": 30, "time": { "start": 20, "end": 25 }, "easing": "easeIn", "axis": { "x": 0, "y": 1, "z": 0 }, "point": { "x": 0, "y": 0, "z": -16.5 } },
+    { "type": "SCALE_XYZ", "value": 1.2, "time": { "start": 20, "end": 35 }, "easing": "linear", "axis": { "x": 0, "y": 1, "z": 0 }, "point": { "x": 1, "y": 1, "z": 1 } },
+    { "type": "SCALE_XYZ", "value": -0.25, "time": { "start": 35, "end": 45 }, "easing": "linear", "axis": { "x": 0, "y": 1, "z": 0 }, "point": { "x": 1, "y": 1, "z": 1 } },
+    { "type": "TRANSLATE", "value": 0.5, "time": { "start": 25, "end": 50 }, "easing": "easeInOut", "axis": { "x": 0, "y": 1, "z": 0 }, "point": { "x": 0, "y": 0, "z": 0 } },
+    { "type": "TRANSLATE", "value": -0.55, "time": { "start": 50, "end": 75 }, "easing": "easeInOut", "axis": { "x": 0, "y": 1, "z": 0 }, "point": { "x": 0, "y": 0, "z": 0 } },
+    { "type": "ROTATE_ABOUT", "value": 360, "time": { "start": 25, "end": 75 }, "easing": "linear", "axis": { "x": 0, "y": 1, "z": 0 }, "point": { "x": 0, "y": 0, "z": -16.5 } },
+    { "type": "ROTATE_ABOUT", "value": 35, "time": { "start": 75, "end": 85 }, "easing": "easeOut", "axis": { "x": 0, "y": 1, "z": 0 }, "point": { "x": 0, "y": 0, "z": -16.5 } },
+    { "type": "ROTATE_ABOUT", "value": -30, "time": { "start": 85, "end": 105 }, "easing": "easeInOut", "axis": { "x": 0, "y": 1, "z": 0 }, "point": { "x": 0, "y": 0, "z": -16.5 } },
+    { "type": "NOP", "value": 0, "time": { "start": 100, "end": 180 }, "easing": "easeInOut", "axis": { "x": 0, "y": 1, "z": 0 }, "point": { "x": 0, "y": 0, "z": 0 } }
+])";
+// RETURN_HOME is left out: it reads the captured position, which both paths handle the same way.
+constexpr unsigned long long ANIMATION_FRAMES = 180;
+
+std::vector<AnimationKeyframe> neutralKeyframes()
+{
+    std::vector<AnimationKeyframe> keyframes;
+    for (const auto& frame : nlohmann::json::parse(NEUTRAL_FRAMES)) {
+        keyframes.push_back(loadKeyframe(frame));
+    }
+    return keyframes;
+}
+
+// Moves like OBJObject (a mutex and a scene graph write per call) without any GL.
+class PartMesh : public MeshObject {
+public:
+    void draw() override { }
+    void setProjectionMatrix(glm::mat4) override { }
+    void setViewMatrix(glm::vec3) override { }
+    void setViewMatrix(glm::mat4) override { }
+    void setModelMatrix(glm::mat4 m) override { setLocalMatrix(m); }
+    glm::mat4 getModelMatrix() override { return localMatrix(); }
+    glm::mat4 getViewMatrix() override { return glm::mat4(1.0f); }
+    glm::mat4 getProjectionMatrix() override { return glm::mat4(1.0f); }
+    void translate(glm::vec3 t) override
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        setLocalMatrix(glm::translate(localMatrix(), t));
+    }
+    void rotate(float angle, glm::vec3 axis) override
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        setLocalMatrix(glm::rotate(localMatrix(), glm::radians(angle), axis));
+    }
+    void scale(glm::vec3 s) override
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        setLocalMatrix(glm::scale(localMatrix(), s));
+    }
+    void uniformScale(float s) override { this->scale(glm::vec3(s)); }
+    void rotateAbout(float, glm::vec3) override { }
+    void rotateAbout(float angle, glm::vec3 axis, glm::vec3 point) override
+    {
+        std::lock_guard<std::mutex> lock(this->mutex);
+        glm::mat4 tempMat = glm::translate(glm::mat4(1.0f), point);
+        tempMat = glm::rotate(tempMat, glm::radians(angle), glm::normalize(axis));
+        tempMat = glm::translate(tempMat, -point);
+        setLocalMatrix(tempMat * localMatrix());
+    }
+    glm::vec3 getCenterPoint() override { return glm::vec3(0.0f); }
+    std::vector<Vertex> getVertices() override { return {}; }
+    float getWidth() override { return 0.0f; }
+    void capturePosition() override { }
+    void restorePosition() override { setLocalMatrix(glm::mat4(1.0f)); }
+    void setVisibility(bool) override { }
+    void getRestorePositionDiff(glm::mat4*, glm::mat4*, glm::mat4*) override { }
+
+private:
+    std::mutex mutex;
+};
+
+struct Character {
+    std::vector<PartMesh> storage = std::vector<PartMesh>(3);
+    std::vector<MeshObject*> objects;
+    Character()
+    {
+        for (auto& part : this->storage) {
+            this->objects.push_back(&part);
+        }
+    }
+};
+
+} // namespace
+
+static void BM_AnimationTickPerKeyframe(benchmark::State& state)
+{
+    const Animation animation = { Animations::AnimationNames_enum::NEUTRAL, "neutral", neutralKeyframes() };
+    Character character;
+    unsigned long long frame = 0;
+    for (auto _ : state) {
+        for (auto keyframe : animation.keyframes) {
+            if (keyframe.timeStart <= frame && keyframe.timeEnd > frame) {
+                double f = frame;
+                double s = keyframe.timeStart;
+                double e = keyframe.timeEnd;
+                double f_normal = (f - s) / (e - s);
+                double f2_normal = (f > 0) ? (f - s - 1) / (e - s) : 0.f;
+                double calcValue = (double)keyframe.value * (keyframe.easingFunction(f_normal) - keyframe.easingFunction(f2_normal));
+                if (calcValue == 0.0) {
+                    continue;
+                }
+                switch (keyframe.type) {
+                case Animations::AnimationType::TRANSLATE:
+                    for (auto object : character.objects) {
+                        object->translate(glm::vec3(keyframe.axis.x * calcValue, keyframe.axis.y * calcValue, keyframe.axis.z * calcValue));
+                    }
+                    break;
+                case Animations::AnimationType::SCALE_XYZ:
+                    calcValue = calcValue + 1.f;
+                    for (auto object : character.objects) {
+                        object->scale(glm::vec3((keyframe.axis.x > 0 ? calcValue : 1), (keyframe.axis.y > 0 ? calcValue : 1), (keyframe.axis.z > 0 ? calcValue : 1)));
+                    }
+                    break;
+                case Animations::AnimationType::ROTATE_ABOUT:
+                    for (auto object : character.objects) {
+                        object->rotateAbout(calcValue, keyframe.axis, keyframe.point);
+                    }
+                    break;
+                default:
+                    break;
+                }
+            }
+        }
+        if (++frame == ANIMATION_FRAMES) {
+            frame = 0;
+            for (auto object : character.objects) {
+                object->restorePosition();
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+static void BM_AnimationTickCompiled(benchmark::State& state)
+{
+    AnimationTrack track(neutralKeyframes());
+    Character character;
+    std::vector<AnimationStep> steps;
+    unsigned long long frame = 0;
+    for (auto _ : state) {
+        steps.clear();
+        track.evaluate(frame, steps);
+        size_t i = 0;
+        while (i < steps.size()) {
+            AnimationDelta delta;
+            i = AnimationTrack::fold(steps, i, delta);
+            for (auto object : character.objects) {
+                object->transformLocal(delta.pre, delta.post);
+            }
+            i += i < steps.size() ? 1 : 0; // nothing in this animation stops a fold
+        }
+        if (++frame == ANIMATION_FRAMES) {
+            frame = 0;
+            for (auto object : character.objects) {
+                object->restorePosition();
+            }
+        }
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_AnimationTickPerKeyframe);
+BENCHMARK(BM_AnimationTickCompiled);
@@ -0,0 +1,212 @@
+#include "../src/gui/eventHandler/eventHandler.h"
+#include <benchmark/benchmark.h>
+#include <memory>
+#include <vector>
+
+// Pointer input against a tree of menus the size of a fully materialized GUI: every menu registers
+// a screen's worth of 720x50 entries, only one menu is clickable at a time, and a few dozen handlers
+// of mixed types are registered the way gui.cpp does it. The drag-scroll case presses, drags 20
+// steps (moving every entry of the open menu each step, as Menu::scrollVert does), releases and taps
+// an entry. The Linear* cases replay the old full scans over the same data for comparison.
+
+namespace {
+
+class Entry final : public Clickable {
+public:
+    Entry(long yMin, bool clickable)
+        : clickable(clickable)
+    {
+        this->clickArea = ClickableArea(0, 720, yMin, yMin + 50, this);
+    }
+    void onClick(const CubeEvent&) override { this->clicks++; }
+    void onRelease(const CubeEvent&) override { }
+    void onMouseDown(const CubeEvent&) override { }
+    void onRightClick(const CubeEvent&) override { }
+    std::vector<MeshObject*> getObjects() override { return {}; }
+    void setOnClick(std::function<unsigned int(void*)>) override { }
+    void setOnRightClick(std::function<unsigned int(void*)>) override { }
+    ClickableArea* getClickableArea() override { return &this->clickArea; }
+    void setVisibleWidth(float) override { }
+    void setClickAreaSize(unsigned int xMin, unsigned int xMax, unsigned int yMin, unsigned int yMax) override
+    {
+        this->clickArea.xMin = xMin;
+        this->clickArea.xMax = xMax;
+        this->clickArea.yMin = yMin;
+        this->clickArea.yMax = yMax;
+        ClickableArea::changed();
+    }
+    void capturePosition() override { }
+    void restorePosition() override { }
+    void resetScroll() override { }
+    bool getIsClickable() override { return this->clickable; }
+    bool setIsClickable(bool isClickable) override
+    {
+        ClickableArea::changed();
+        return this->clickable = isClickable;
+    }
+    void draw() override { }
+    bool setVisible(bool) override { return true; }
+    bool getVisible() override { return this->clickable; }
+
+    uint64_t clicks = 0;
+
+private:
+    bool clickable;
+};
+
+constexpr int ENTRIES_PER_MENU = 24;
+constexpr int DRAG_STEPS = 20;
+
+struct Scene {
+    EventManager manager;
+    std::vector<std::unique_ptr<Entry>> entries;
+    std::vector<Entry*> openMenu;
+    uint64_t drags = 0;
+
+    explicit Scene(int areas)
+    {
+        for (int i = 0; i < areas; i++) {
+            const bool open = i < ENTRIES_PER_MENU;
+            this->entries.push_back(std::make_unique<Entry>((i % ENTRIES_PER_MENU) * 60L, open));
+            if (open) {
+                this->openMenu.push_back(this->entries.back().get());
+            }
+        }
+        // Register the open menu last, as the most recently built one would be.
+        for (auto it = this->entries.rbegin(); it != this->entries.rend(); ++it) {
+            this->manager.addClickableArea((*it)->getClickableArea());
+        }
+        const CubeEventType types[] = { CubeEventType::KeyPressed, CubeEventType::KeyReleased, CubeEventType::MouseMoved,
+            CubeEventType::MouseButtonPressed, CubeEventType::MouseButtonReleased };
+        for (int i = 0; i < 40; i++) {
+            EventHandler* handler = this->manager.getEvent(this->manager.createEvent("handler" + std::to_string(i)));
+            handler->setEventType(types[i % 5]);
+            if (i % 3 == 0) {
+                handler->setSpecificEventType(static_cast<SpecificEventTypes>(i));
+            }
+            handler->setAction([](const CubeEvent&) { });
+        }
+        EventHandler* drag = this->manager.getEvent(this->manager.createEvent("DRAG_Y"));
+        drag->setEventType(CubeEventType::MouseMoved);
+        drag->setSpecificEventType(SpecificEventTypes::DRAG_Y);
+        drag->setAction([this](const CubeEvent& event) {
+            this->drags++;
+            for (Entry* entry : this->openMenu) {
+                ClickableArea* area = entry->getClickableArea();
+                entry->setClickAreaSize(area->xMin, area->xMax, area->yMin + event.deltaY, area->yMax + event.deltaY);
+            }
+        });
+    }
+};
+
+CubeEvent pointer(CubeEventType type, int x, int y)
+{
+    CubeEvent event;
+    event.type = type;
+    event.mouseButton = CubeMouseButton::Left;
+    event.x = x;
+    event.y = y;
+    return event;
+}
+
+// The pre-index hit test: every registered area, hidden or not, checked in order.
+ClickableArea* linearHit(const std::vector<ClickableArea*>& areas, int x, int y)
+{
+    for (ClickableArea* area : areas) {
+        if (area == nullptr || area->clickableObject == nullptr || !area->clickableObject->getIsClickable()) {
+            continue;
+        }
+        if (x < area->xMax && x > area->xMin && y < area->yMax && y > area->yMin) {
+            return area;
+        }
+    }
+    return nullptr;
+}
+
+// The pre-table dispatch: every handler compared against the pair.
+bool linearDispatch(const std::vector<EventHandler*>& events, CubeEventType type, SpecificEventTypes specific, const CubeEvent& event)
+{
+    bool any = false;
+    for (EventHandler* handler : events) {
+        if (handler->getEventType() == type && handler->getSpecificEventType() == specific) {
+            any = handler->triggerEvent(event) || any;
+        }
+    }
+    return any;
+}
+
+} // namespace
+
+static void BM_EventManagerTap(benchmark::State& state)
+{
+    Scene scene(static_cast<int>(state.range(0)));
+    int y = 10;
+    for (auto _ : state) {
+        scene.manager.triggerEvent(pointer(CubeEventType::MouseButtonPressed, 200, y));
+        benchmark::DoNotOptimize(scene.manager.triggerEvent(pointer(CubeEventType::MouseButtonReleased, 200, y)));
+        y = (y + 60) % 720;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_EventManagerTap)->Arg(1000)->Arg(4000);
+
+static void BM_LinearTap(benchmark::State& state)
+{
+    Scene scene(static_cast<int>(state.range(0)));
+    std::vector<ClickableArea*> areas;
+    for (auto it = scene.entries.rbegin(); it != scene.entries.rend(); ++it) {
+        areas.push_back((*it)->getClickableArea());
+    }
+    int y = 10;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(linearHit(areas, 200, y));
+        benchmark::DoNotOptimize(linearHit(areas, 200, y));
+        y = (y + 60) % 720;
+    }
+    state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_LinearTap)->Arg(1000)->Arg(4000);
+
+static void BM_EventManagerDragScroll(benchmark::State& state)
+{
+    Scene scene(static_cast<int>(state.range(0)));
+    for (auto _ : state) {
+        scene.manager.triggerEvent(pointer(CubeEventType::MouseButtonPressed, 300, 400));
+        for (int step = 1; step <= DRAG_STEPS; step++) {
+            scene.manager.triggerEvent(pointer(CubeEventType::MouseMoved, 300, 400 + (step & 1 ? 8 : -8) * step));
+        }
+        scene.manager.triggerEvent(pointer(CubeEventType::MouseButtonReleased, 300, 400));
+        scene.manager.triggerEvent(pointer(CubeEventType::MouseButtonPressed, 300, 130));
+        scene.manager.triggerEvent(pointer(CubeEventType::MouseButtonReleased, 300, 130));
+    }
+    state.counters["drags"] = static_cast<double>(scene.drags) / static_cast<double>(state.iterations());
+    state.SetItemsProcessed(state.iterations() * (DRAG_STEPS + 4));
+}
+BENCHMARK(BM_EventManagerDragScroll)->Arg(1000)->Arg(4000);
+
+static void BM_LinearDragScroll(benchmark::State& state)
+{
+    Scene scene(static_cast<int>(state.range(0)));
+    std::vector<ClickableArea*> areas;
+    for (auto it = scene.entries.rbegin(); it != scene.entries.rend(); ++it) {
+        areas.push_back((*it)->getClickableArea());
+    }
+    const std::vector<EventHandler*> events = scene.manager.getEvents();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(linearHit(areas, 300, 400));
+        for (int step = 1; step <= DRAG_STEPS; step++) {
+            CubeEvent move = pointer(CubeEventType::MouseMoved, 300, 400 + (step & 1 ? 8 : -8) * step);
+            move.deltaY = (step & 1 ? 8 : -8) * step;
+            linearDispatch(events, CubeEventType::MouseMoved, SpecificEventTypes::DRAG_Y, move);
+        }
+        for (ClickableArea* area : areas) {
+            if (area->clickableObject->getIsClickable()) {
+                area->clickableObject->onRelease(pointer(CubeEventType::MouseButtonReleased, 300, 400));
+            }
+        }
+        benchmark::DoNotOptimize(linearHit(areas, 300, 130));
+        benchmark::DoNotOptimize(linearHit(areas, 300, 130));
+    }
+    state.SetItemsProcessed(state.iterations() * (DRAG_STEPS + 4));
+}
+BENCHMARK(BM_LinearDragScroll)->Arg(1000)->Arg(4000);
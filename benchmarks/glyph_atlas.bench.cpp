@@ -0,0 +1,276 @@
+#include "../src/gui/camera.h"
+#include "../src/gui/renderables/glyphAtlas.h"
+#include "../src/gui/renderables/shapes.h"
+#include <GLFW/glfw3.h>
+#include <benchmark/benchmark.h>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+// BM_TextFrame draws a screen of menu-sized strings and reports glDrawArrays calls and frame time
+// per frame. The atlas argument switches between M_Text (one shared atlas, one draw per string) and
+// a replay of the pre-atlas M_Text (one texture per glyph, one buffer upload and draw per character).
+// Needs a display; on a headless machine run it under xvfb-run (llvmpipe with LIBGL_ALWAYS_SOFTWARE=1).
+
+namespace {
+
+constexpr int TEXT_SCENE_SIZE = 720;
+constexpr float TEXT_SIZE = 24.f;
+
+// M_Text as it was before the glyph atlas: each string owns a texture per distinct glyph and streams
+// every quad through a six-vertex buffer.
+class PerGlyphText {
+public:
+    PerGlyphText(Shader* shader, FT_Face face, const std::string& text, int pixelSize, glm::vec2 position)
+        : shader(shader)
+        , position(position)
+        , codepoints(TextLayout::codepoints(text))
+    {
+        FT_Set_Pixel_Sizes(face, 0, pixelSize);
+        glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+        for (uint32_t codepoint : this->codepoints) {
+            if (this->glyphs.contains(codepoint) || FT_Load_Char(face, codepoint, FT_LOAD_RENDER)) {
+                continue;
+            }
+            const FT_Bitmap& bitmap = face->glyph->bitmap;
+            GLuint texture = 0;
+            if (bitmap.width > 0 && bitmap.rows > 0) {
+                glGenTextures(1, &texture);
+                glBindTexture(GL_TEXTURE_2D, texture);
+                glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, bitmap.width, bitmap.rows, 0, GL_RED, GL_UNSIGNED_BYTE, bitmap.buffer);
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+                glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+            }
+            this->glyphs[codepoint] = { texture, { static_cast<int>(bitmap.width), static_cast<int>(bitmap.rows) },
+                { face->glyph->bitmap_left, face->glyph->bitmap_top }, face->glyph->advance.x };
+        }
+        glBindTexture(GL_TEXTURE_2D, 0);
+        glGenVertexArrays(1, &this->VAO);
+        glGenBuffers(1, &this->VBO);
+        glBindVertexArray(this->VAO);
+        glBindBuffer(GL_ARRAY_BUFFER, this->VBO);
+        glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 6 * 4, nullptr, GL_DYNAMIC_DRAW);
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), 0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        glBindVertexArray(0);
+    }
+
+    ~PerGlyphText()
+    {
+        for (const auto& [codepoint, glyph] : this->glyphs) {
+            glDeleteTextures(1, &glyph.texture);
+        }
+        glDeleteVertexArrays(1, &this->VAO);
+        glDeleteBuffers(1, &this->VBO);
+    }
+
+    // Returns the number of draw calls issued.
+    uint64_t draw()
+    {
+        this->shader->use();
+        this->shader->setVec3(ShaderUniform::TEXT_COLOR, 1.f, 1.f, 1.f);
+        this->shader->setMat4(ShaderUniform::LOCAL, glm::mat4(1.0f));
+        this->shader->setVec2(ShaderUniform::OFFSET, 0.f, 0.f);
+        this->shader->setFloat(ShaderUniform::ZINDEX, 0.0f);
+        this->shader->setFloat(ShaderUniform::ALPHA, 1.0f);
+        this->shader->setFloat(ShaderUniform::BG_ALPHA, 0.0f);
+        glActiveTexture(GL_TEXTURE0);
+        glBindVertexArray(this->VAO);
+        uint64_t draws = 0;
+        float pen = this->position.x;
+        for (uint32_t codepoint : this->codepoints) {
+            auto it = this->glyphs.find(codepoint);
+            if (it == this->glyphs.end()) {
+                continue;
+            }
+            const Glyph& glyph = it->second;
+            if (glyph.texture != 0) {
+                const float x = pen + glyph.bearing.x;
+                const float y = this->position.y - (glyph.size.y - glyph.bearing.y);
+                const float w = glyph.size.x;
+                const float h = glyph.size.y;
+                const float vertices[6][4] = {
+                    { x, y + h, 0.0f, 0.0f },
+                    { x + w, y, 1.0f, 1.0f },
+                    { x, y, 0.0f, 1.0f },
+                    { x, y + h, 0.0f, 0.0f },
+                    { x + w, y + h, 1.0f, 0.0f },
+                    { x + w, y, 1.0f, 1.0f }
+                };
+                glBindTexture(GL_TEXTURE_2D, glyph.texture);
+                glBindBuffer(GL_ARRAY_BUFFER, this->VBO);
+                glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
+                glBindBuffer(GL_ARRAY_BUFFER, 0);
+                glDrawArrays(GL_TRIANGLES, 0, 6);
+                draws++;
+            }
+            pen += (glyph.advance >> 6);
+        }
+        glBindVertexArray(0);
+        glBindTexture(GL_TEXTURE_2D, 0);
+        return draws;
+    }
+
+private:
+    struct Glyph {
+        GLuint texture;
+        glm::ivec2 size;
+        glm::ivec2 bearing;
+        FT_Pos advance;
+    };
+    Shader* shader;
+    glm::vec2 position;
+    std::vector<uint32_t> codepoints;
+    std::map<uint32_t, Glyph> glyphs;
+    GLuint VAO = 0;
+    GLuint VBO = 0;
+};
+
+// 36 labels laid out in two columns, about what a settings page with an open message box shows.
+class TextScene {
+public:
+    static TextScene* get()
+    {
+        static std::unique_ptr<TextScene> scene = create();
+        return scene.get();
+    }
+
+    // Returns the number of glDrawArrays calls the strings issued.
+    uint64_t drawFrame(bool atlas)
+    {
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+        Camera::ui().upload();
+        uint64_t draws = 0;
+        if (atlas) {
+            const uint64_t before = M_Text::totalDrawCalls();
+            for (auto& text : this->atlasTexts) {
+                text->draw();
+            }
+            draws = M_Text::totalDrawCalls() - before;
+        } else {
+            for (auto& text : this->perGlyphTexts) {
+                draws += text->draw();
+            }
+        }
+        // llvmpipe rasterizes asynchronously; wait so the frame time includes it.
+        glFinish();
+        glfwSwapBuffers(this->window);
+        return draws;
+    }
+
+    ~TextScene()
+    {
+        this->atlasTexts.clear();
+        this->perGlyphTexts.clear();
+        this->shader.reset();
+        FT_Done_Face(this->face);
+        FT_Done_FreeType(this->ft);
+        glfwDestroyWindow(this->window);
+        glfwTerminate();
+    }
+
+private:
+    static std::unique_ptr<TextScene> create()
+    {
+        if (!glfwInit()) {
+            return nullptr;
+        }
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        glfwWindowHint(GLFW_DEPTH_BITS, 24);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 2);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 1);
+        GLFWwindow* window = glfwCreateWindow(TEXT_SCENE_SIZE, TEXT_SCENE_SIZE, "glyph_atlas", nullptr, nullptr);
+        if (window == nullptr) {
+            glfwTerminate();
+            return nullptr;
+        }
+        glfwMakeContextCurrent(window);
+        glfwSwapInterval(0);
+        glewExperimental = GL_TRUE;
+        if (glewInit() != GLEW_OK) {
+            glfwDestroyWindow(window);
+            glfwTerminate();
+            return nullptr;
+        }
+        return std::unique_ptr<TextScene>(new TextScene(window));
+    }
+
+    explicit TextScene(GLFWwindow* window)
+        : window(window)
+    {
+        glViewport(0, 0, TEXT_SCENE_SIZE, TEXT_SCENE_SIZE);
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+        this->shader = std::make_unique<Shader>("./shaders/text.vs", "./shaders/text.fs");
+        this->shader->bindUniformBlock(Camera::BLOCK_NAME, Camera::ui().binding());
+        FT_Init_FreeType(&this->ft);
+        FT_New_Face(this->ft, TextLayout::fontPath().c_str(), 0, &this->face);
+
+        const char* labels[] = {
+            "Back", "Apps", "Personality", "Notifications", "Do Not Disturb", "Display",
+            "Sound", "Microphone Enabled", "WiFi", "Bluetooth", "Accounts", "Privacy",
+            "Use Metric Units", "About", "Brightness", "Screen Timeout", "Volume", "Alarm Tone",
+            "Connected", "Forget Network", "Pair New Device", "Software Update", "Restart", "Shut Down",
+            "Time Zone", "24-Hour Clock", "Language", "Reset to Defaults", "Storage", "Battery",
+            "Cancel", "OK", "Are you sure?", "This cannot be undone.", "Version 1.0.0", "Serial Number",
+        };
+        int row = 0;
+        for (const char* label : labels) {
+            const glm::vec2 position { row < 18 ? 20.f : 380.f, TEXT_SCENE_SIZE - 40.f - (row % 18) * 38.f };
+            this->atlasTexts.push_back(std::make_unique<M_Text>(this->shader.get(), label, TEXT_SIZE, glm::vec3(1.f), position));
+            this->perGlyphTexts.push_back(std::make_unique<PerGlyphText>(this->shader.get(), this->face, label, static_cast<int>(TEXT_SIZE), position));
+            row++;
+        }
+    }
+
+    GLFWwindow* window;
+    std::unique_ptr<Shader> shader;
+    FT_Library ft = nullptr;
+    FT_Face face = nullptr;
+    std::vector<std::unique_ptr<M_Text>> atlasTexts;
+    std::vector<std::unique_ptr<PerGlyphText>> perGlyphTexts;
+};
+
+} // namespace
+
+static void BM_TextFrame(benchmark::State& state)
+{
+    TextScene* scene = TextScene::get();
+    if (scene == nullptr) {
+        state.SkipWithError("could not create a GL context (no display?)");
+        return;
+    }
+    const bool atlas = state.range(0) != 0;
+    // Upload everything once before counting.
+    scene->drawFrame(atlas);
+    uint64_t draws = 0;
+    for (auto _ : state) {
+        draws += scene->drawFrame(atlas);
+    }
+    state.counters["draws_per_frame"] = static_cast<double>(draws) / static_cast<double>(state.iterations());
+}
+
+BENCHMARK(BM_TextFrame)->ArgName("atlas")->Arg(0)->Arg(1)->Unit(benchmark::kMillisecond);
+
+// Fill one atlas page with glyph-sized cells; this is the CPU side of every
+// cache miss in M_Text and should stay well under the cost of a rasterize.
+static void BM_SkylinePackerFillPage(benchmark::State& state)
+{
+    int64_t packed = 0;
+    for (auto _ : state) {
+        SkylinePacker packer(GLYPH_ATLAS_PAGE_SIZE, GLYPH_ATLAS_PAGE_SIZE);
+        int i = 0;
+        while (auto origin = packer.pack(12 + i % 9, 18 + i % 7)) {
+            benchmark::DoNotOptimize(origin);
+            ++i;
+        }
+        packed += i;
+    }
+    state.SetItemsProcessed(packed);
+}
+
+BENCHMARK(BM_SkylinePackerFillPage);
@@ -0,0 +1,197 @@
+#include "../src/hardware/pi_i2c.h"
+#include <benchmark/benchmark.h>
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <utility>
+
+// A fake adapter in place of real hardware (i2c-stub only speaks SMBus and rejects I2C_RDWR): the bus is
+// pointed at /dev/null and given emulatedIoctl() through PiI2CBus::setIoctlCall(). It issues the real syscall
+// on that fd, so every call still pays a kernel round trip, then answers the i2c-dev requests from a 256-byte
+// register file. One "update" is what the BMI270 driver does per poll or per FIFO drain. Legacy replays the old
+// PiI2CBus: open, I2C_TENBIT, I2C_SLAVE, then write() or I2C_RDWR, then close, for every call.
+// syscalls_per_update is counted by the bus itself (or the replay); the time column is us per update.
+
+namespace {
+
+constexpr uint16_t kAccelAddress = 0x68;
+constexpr size_t kFifoBatchBytes = 16 * 6;
+
+std::array<uint8_t, 256> registers {};
+
+void emulateTransfer(i2c_rdwr_ioctl_data* rdwr)
+{
+    uint8_t pointer = 0;
+    for (uint32_t index = 0; index < rdwr->nmsgs; ++index) {
+        i2c_msg& message = rdwr->msgs[index];
+        if (message.flags & I2C_M_RD) {
+            for (uint16_t offset = 0; offset < message.len; ++offset) {
+                message.buf[offset] = registers[static_cast<uint8_t>(pointer + offset)];
+            }
+        } else if (message.len > 0) {
+            pointer = message.buf[0];
+            for (uint16_t offset = 1; offset < message.len; ++offset) {
+                registers[static_cast<uint8_t>(pointer + offset - 1)] = message.buf[offset];
+            }
+        }
+    }
+}
+
+int emulatedIoctl(int fd, unsigned long request, unsigned long argument)
+{
+    syscall(SYS_ioctl, fd, request, argument);
+    if (request == I2C_RDWR) {
+        emulateTransfer(reinterpret_cast<i2c_rdwr_ioctl_data*>(argument));
+    } else if (request == I2C_FUNCS) {
+        *reinterpret_cast<unsigned long*>(argument) = I2C_FUNC_I2C;
+    }
+    return 0;
+}
+
+std::shared_ptr<PiI2CBus> emulatedBus()
+{
+    auto bus = std::make_shared<PiI2CBus>();
+    bus->setI2cDevicePath("/dev/null");
+    bus->setIoctlCall(emulatedIoctl);
+    return bus;
+}
+
+class LegacyBus {
+public:
+    explicit LegacyBus(std::string path)
+        : path_(std::move(path))
+    {
+    }
+
+    bool write(uint16_t address, const I2CBytes& txData)
+    {
+        const int fd = open(path_.c_str(), O_RDWR | O_CLOEXEC);
+        emulatedIoctl(fd, I2C_TENBIT, 0);
+        emulatedIoctl(fd, I2C_SLAVE, address);
+        const ssize_t written = ::write(fd, txData.data(), txData.size());
+        close(fd);
+        syscalls += 5;
+        return written == static_cast<ssize_t>(txData.size());
+    }
+
+    I2CBytes writeRead(uint16_t address, const I2CBytes& txData, size_t rxLen)
+    {
+        I2CBytes rxData(rxLen, 0);
+        const int fd = open(path_.c_str(), O_RDWR | O_CLOEXEC);
+        emulatedIoctl(fd, I2C_TENBIT, 0);
+        emulatedIoctl(fd, I2C_SLAVE, address);
+        std::array<i2c_msg, 2> messages { {
+            { address, 0, static_cast<__u16>(txData.size()), const_cast<__u8*>(txData.data()) },
+            { address, I2C_M_RD, static_cast<__u16>(rxLen), rxData.data() },
+        } };
+        i2c_rdwr_ioctl_data rdwr { messages.data(), 2 };
+        emulatedIoctl(fd, I2C_RDWR, reinterpret_cast<unsigned long>(&rdwr));
+        close(fd);
+        syscalls += 5;
+        return rxData;
+    }
+
+    uint64_t syscalls = 0;
+
+private:
+    std::string path_;
+};
+
+const std::array<std::pair<uint8_t, uint8_t>, 11> kFifoSetup { {
+    { 0x40, 0xA8 },
+    { 0x41, 0x01 },
+    { 0x46, 0x60 },
+    { 0x47, 0x00 },
+    { 0x48, 0x00 },
+    { 0x49, 0x40 },
+    { 0x53, 0x0A },
+    { 0x55, 0x00 },
+    { 0x58, 0x02 },
+    { 0x7D, 0x04 },
+    { 0x7E, 0xB0 },
+} };
+
+void reportSyscalls(benchmark::State& state, uint64_t syscalls)
+{
+    state.counters["syscalls_per_update"] = benchmark::Counter(
+        static_cast<double>(syscalls), benchmark::Counter::kAvgIterations);
+}
+
+} // namespace
+
+static void BM_I2CSensorUpdate_Legacy(benchmark::State& state)
+{
+    LegacyBus bus("/dev/null");
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(bus.writeRead(kAccelAddress, I2CBytes { 0x0C }, 6));
+    }
+    reportSyscalls(state, bus.syscalls);
+}
+BENCHMARK(BM_I2CSensorUpdate_Legacy);
+
+static void BM_I2CSensorUpdate_PersistentFd(benchmark::State& state)
+{
+    auto bus = emulatedBus();
+    PiI2CBusView view(bus, I2CPriority::Periodic);
+    const uint64_t before = bus->stats().syscalls;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(view.writeRead(kAccelAddress, I2CBytes { 0x0C }, 6));
+    }
+    reportSyscalls(state, bus->stats().syscalls - before);
+}
+BENCHMARK(BM_I2CSensorUpdate_PersistentFd);
+
+static void BM_I2CFifoDrain_Legacy(benchmark::State& state)
+{
+    LegacyBus bus("/dev/null");
+    registers[0x24] = kFifoBatchBytes;
+    for (auto _ : state) {
+        const I2CBytes length = bus.writeRead(kAccelAddress, I2CBytes { 0x24 }, 2);
+        benchmark::DoNotOptimize(bus.writeRead(kAccelAddress, I2CBytes { 0x26 }, length[0]));
+    }
+    reportSyscalls(state, bus.syscalls);
+}
+BENCHMARK(BM_I2CFifoDrain_Legacy);
+
+static void BM_I2CFifoDrain_PersistentFd(benchmark::State& state)
+{
+    auto bus = emulatedBus();
+    PiI2CBusView view(bus, I2CPriority::Periodic);
+    registers[0x24] = kFifoBatchBytes;
+    const uint64_t before = bus->stats().syscalls;
+    for (auto _ : state) {
+        const auto length = view.writeRead(kAccelAddress, I2CBytes { 0x24 }, 2);
+        benchmark::DoNotOptimize(view.writeRead(kAccelAddress, I2CBytes { 0x26 }, (*length)[0]));
+    }
+    reportSyscalls(state, bus->stats().syscalls - before);
+}
+BENCHMARK(BM_I2CFifoDrain_PersistentFd);
+
+static void BM_I2CConfigBurst_Legacy(benchmark::State& state)
+{
+    LegacyBus bus("/dev/null");
+    for (auto _ : state) {
+        for (const auto& [reg, value] : kFifoSetup) {
+            benchmark::DoNotOptimize(bus.write(kAccelAddress, I2CBytes { reg, value }));
+        }
+    }
+    reportSyscalls(state, bus.syscalls);
+}
+BENCHMARK(BM_I2CConfigBurst_Legacy);
+
+static void BM_I2CConfigBurst_Batched(benchmark::State& state)
+{
+    auto bus = emulatedBus();
+    const uint64_t before = bus->stats().syscalls;
+    for (auto _ : state) {
+        I2CTransaction transaction;
+        for (const auto& [reg, value] : kFifoSetup) {
+            transaction.write(kAccelAddress, I2CBytes { reg, value });
+        }
+        benchmark::DoNotOptimize(bus->transfer(transaction, I2CPriority::Periodic));
+    }
+    reportSyscalls(state, bus->stats().syscalls - before);
+}
+BENCHMARK(BM_I2CConfigBurst_Batched);
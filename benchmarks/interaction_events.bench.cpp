@@ -0,0 +1,153 @@
+#include "../src/api/apiEventBroker.h"
+#include "../src/hardware/interactionEventBridge.h"
+#include "../src/hardware/interactionEvents.h"
+#include <benchmark/benchmark.h>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Tap-to-API-event latency while a slow in-process subscriber is attached.
+// The interaction thread publishes a tap every millisecond for half a second. A second subscriber spends
+// 2 ms on each event, standing in for a trigger whose action blocks. An API client long-polls the broker
+// and serializes each payload it reads. Latency runs from a tap's scheduled time to the client reading
+// it, so a publisher that falls behind its schedule counts against it.
+// Legacy replays the old dispatch: every callback runs inline on the publishing thread and the bridge
+// builds the JSON payload eagerly. Bus uses InteractionEvents and InteractionEventBridge as they are now.
+// The benchmark carries each tap's index in occurredAtEpochMs so the client can find its scheduled time.
+
+namespace {
+
+using namespace std::chrono_literals;
+using Clock = std::chrono::steady_clock;
+
+constexpr size_t kTaps = 500;
+constexpr auto kTapInterval = 1ms;
+constexpr auto kSlowSubscriberWork = 2ms;
+
+struct RunResult {
+    Metrics::Histogram apiLatency;
+    Metrics::Histogram publishTime;
+    uint64_t apiEvents = 0;
+    uint64_t publisherBehindUs = 0;
+};
+
+void spin(std::chrono::microseconds duration)
+{
+    const auto until = Clock::now() + duration;
+    while (Clock::now() < until) {
+    }
+}
+
+// Runs the publisher and an API client against `broker`; `publish` hands one tap to the dispatch under test.
+void runScenario(ApiEventBroker& broker, const std::function<void(const InteractionEvent&)>& publish, RunResult& result)
+{
+    std::array<Clock::time_point, kTaps> scheduled {};
+    const auto start = Clock::now() + 5ms;
+    for (size_t i = 0; i < kTaps; i++) {
+        scheduled[i] = start + i * kTapInterval;
+    }
+
+    std::atomic<bool> clientDone { false };
+    std::jthread client([&](std::stop_token stopToken) {
+        uint64_t cursor = broker.latestSequence();
+        const ApiEventBroker::SourceSet sources { "interaction" };
+        while (!stopToken.stop_requested()) {
+            const auto page = broker.waitForEvents(cursor, sources, 64, 20ms);
+            for (const auto& event : page.events) {
+                benchmark::DoNotOptimize(event.payload.get().dump());
+                const auto index = static_cast<size_t>(event.occurredAtEpochMs);
+                result.apiLatency.record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - scheduled[index]).count()));
+                result.apiEvents++;
+                if (index + 1 == kTaps) {
+                    clientDone = true;
+                    return;
+                }
+            }
+            cursor = page.nextSequence;
+        }
+    });
+
+    for (size_t i = 0; i < kTaps; i++) {
+        std::this_thread::sleep_until(scheduled[i]);
+        InteractionEvent event;
+        event.sequence = i + 1;
+        event.type = InteractionEventType::Tap;
+        event.occurredAtEpochMs = i;
+        event.liftStateAfter = Bmi270LiftState::OnDesk;
+        event.sample = Bmi270AccelerationSample { 0.01f * static_cast<float>(i % 7), 0.02f, 0.98f };
+        const auto before = Clock::now();
+        publish(event);
+        result.publishTime.record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - before).count()));
+    }
+    result.publisherBehindUs = static_cast<uint64_t>(std::max<int64_t>(0, std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - scheduled.back()).count()));
+
+    const auto deadline = Clock::now() + 10s;
+    while (!clientDone && Clock::now() < deadline) {
+        std::this_thread::sleep_for(1ms);
+    }
+    client.request_stop();
+    client.join();
+}
+
+void report(benchmark::State& state, const RunResult& result)
+{
+    const auto latency = result.apiLatency.snapshot();
+    state.counters["api_latency_p50_us"] = static_cast<double>(latency.percentile(0.5));
+    state.counters["api_latency_p99_us"] = static_cast<double>(latency.percentile(0.99));
+    state.counters["publish_p99_us"] = static_cast<double>(result.publishTime.snapshot().percentile(0.99));
+    state.counters["publisher_behind_us"] = static_cast<double>(result.publisherBehindUs);
+    state.counters["api_events"] = static_cast<double>(result.apiEvents);
+}
+
+void BM_TapToApiEvent_Legacy(benchmark::State& state)
+{
+    for (auto _ : state) {
+        ApiEventBroker broker;
+        broker.registerSource("interaction");
+        std::unordered_map<size_t, std::function<void(const InteractionEvent&)>> callbacks;
+        callbacks[1] = [](const InteractionEvent&) { spin(kSlowSubscriberWork); };
+        callbacks[2] = [&broker](const InteractionEvent& event) {
+            broker.publish(
+                "interaction",
+                interactionEventTypeToString(event.type),
+                nlohmann::json {
+                    { "liftStateAfter", interactionLiftStateToString(event.liftStateAfter) },
+                    { "sample", nlohmann::json { { "xG", event.sample->xG }, { "yG", event.sample->yG }, { "zG", event.sample->zG } } },
+                },
+                event.occurredAtEpochMs);
+        };
+        RunResult result;
+        runScenario(
+            broker,
+            [&callbacks](const InteractionEvent& event) {
+                for (const auto& [handle, callback] : callbacks) {
+                    callback(event);
+                }
+            },
+            result);
+        report(state, result);
+    }
+}
+BENCHMARK(BM_TapToApiEvent_Legacy)->Iterations(1)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+void BM_TapToApiEvent_Bus(benchmark::State& state)
+{
+    for (auto _ : state) {
+        auto broker = std::make_shared<ApiEventBroker>();
+        const auto slow = InteractionEvents::subscribe([](const InteractionEvent&) { spin(kSlowSubscriberWork); });
+        {
+            InteractionEventBridge bridge(broker);
+            RunResult result;
+            runScenario(*broker, InteractionEvents::publish, result);
+            report(state, result);
+        }
+        InteractionEvents::unsubscribe(slow);
+    }
+}
+BENCHMARK(BM_TapToApiEvent_Bus)->Iterations(1)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+} // namespace
@@ -0,0 +1,301 @@
+#include "../src/gui/camera.h"
+#include "../src/gui/menu/menu.h"
+#include <GLFW/glfw3.h>
+#include <benchmark/benchmark.h>
+#include <memory>
+
+// Draws the main menu (MenuBox, its stencil and a screen of entries and rules) the way Menu::draw()
+// does and reports how many program binds, uniform uploads, uniform lookups and buffer uploads one frame
+// costs. The batched argument turns PrimitiveBatch on or off, giving the frame time of the menu chrome
+// before and after batching in one run. uniform_cache=0 makes Shader look every uniform up and upload it
+// on every set, as it did before locations and values were cached; the per-object projection/view
+// uploads that the Camera block replaced are not replayed, so that baseline understates the old cost
+// by two lookups and two uploads per mesh and label draw. Needs a display; on a headless machine run it under xvfb-run
+// (llvmpipe with LIBGL_ALWAYS_SOFTWARE=1).
+
+using namespace MENUS;
+
+namespace {
+
+// GLEW resolves GL 2.0+ entry points into function pointers, so calls can be counted by swapping in
+// forwarding wrappers after glewInit().
+struct GLCallCounts {
+    uint64_t programBinds = 0;
+    uint64_t uniformLookups = 0;
+    uint64_t uniformUploads = 0;
+    uint64_t bufferUploads = 0;
+};
+
+GLCallCounts calls;
+PFNGLUSEPROGRAMPROC realUseProgram;
+PFNGLGETUNIFORMLOCATIONPROC realGetUniformLocation;
+PFNGLUNIFORM1IPROC realUniform1i;
+PFNGLUNIFORM1FPROC realUniform1f;
+PFNGLUNIFORM2FPROC realUniform2f;
+PFNGLUNIFORM3FPROC realUniform3f;
+PFNGLUNIFORM4FPROC realUniform4f;
+PFNGLUNIFORMMATRIX4FVPROC realUniformMatrix4fv;
+PFNGLBUFFERSUBDATAPROC realBufferSubData;
+
+void GLAPIENTRY countUseProgram(GLuint program)
+{
+    calls.programBinds++;
+    realUseProgram(program);
+}
+
+GLint GLAPIENTRY countGetUniformLocation(GLuint program, const GLchar* name)
+{
+    calls.uniformLookups++;
+    return realGetUniformLocation(program, name);
+}
+
+void GLAPIENTRY countUniform1i(GLint location, GLint v0)
+{
+    calls.uniformUploads++;
+    realUniform1i(location, v0);
+}
+
+void GLAPIENTRY countUniform1f(GLint location, GLfloat v0)
+{
+    calls.uniformUploads++;
+    realUniform1f(location, v0);
+}
+
+void GLAPIENTRY countUniform2f(GLint location, GLfloat v0, GLfloat v1)
+{
+    calls.uniformUploads++;
+    realUniform2f(location, v0, v1);
+}
+
+void GLAPIENTRY countUniform3f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2)
+{
+    calls.uniformUploads++;
+    realUniform3f(location, v0, v1, v2);
+}
+
+void GLAPIENTRY countUniform4f(GLint location, GLfloat v0, GLfloat v1, GLfloat v2, GLfloat v3)
+{
+    calls.uniformUploads++;
+    realUniform4f(location, v0, v1, v2, v3);
+}
+
+void GLAPIENTRY countUniformMatrix4fv(GLint location, GLsizei count, GLboolean transpose, const GLfloat* value)
+{
+    calls.uniformUploads++;
+    realUniformMatrix4fv(location, count, transpose, value);
+}
+
+void GLAPIENTRY countBufferSubData(GLenum target, GLintptr offset, GLsizeiptr size, const void* data)
+{
+    calls.bufferUploads++;
+    realBufferSubData(target, offset, size, data);
+}
+
+void installCallCounters()
+{
+    realUseProgram = __glewUseProgram;
+    __glewUseProgram = countUseProgram;
+    realGetUniformLocation = __glewGetUniformLocation;
+    __glewGetUniformLocation = countGetUniformLocation;
+    realUniform1i = __glewUniform1i;
+    __glewUniform1i = countUniform1i;
+    realUniform1f = __glewUniform1f;
+    __glewUniform1f = countUniform1f;
+    realUniform2f = __glewUniform2f;
+    __glewUniform2f = countUniform2f;
+    realUniform3f = __glewUniform3f;
+    __glewUniform3f = countUniform3f;
+    realUniform4f = __glewUniform4f;
+    __glewUniform4f = countUniform4f;
+    realUniformMatrix4fv = __glewUniformMatrix4fv;
+    __glewUniformMatrix4fv = countUniformMatrix4fv;
+    realBufferSubData = __glewBufferSubData;
+    __glewBufferSubData = countBufferSubData;
+}
+
+unsigned int entryStatus(void* arg)
+{
+    return arg != nullptr ? 1 : 0;
+}
+
+// The pieces Menu::setup() and Menu::addMenuEntry() create, laid out the same way, without the
+// Renderer and event plumbing a full Menu needs.
+class MainMenuScene {
+public:
+    static MainMenuScene* get()
+    {
+        static std::unique_ptr<MainMenuScene> scene = create();
+        return scene.get();
+    }
+
+    void drawFrame()
+    {
+        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+        Camera::scene().upload();
+        Camera::ui().upload();
+        {
+            PrimitiveBatch::Scope chrome;
+            this->box->draw();
+        }
+        this->stencil->enable();
+        this->drawList.clear();
+        for (auto clickable : this->children) {
+            clickable->collect(this->drawList);
+        }
+        SceneGraph::shared().update();
+        this->drawList.draw();
+        this->stencil->disable();
+        glfwSwapBuffers(this->window);
+    }
+
+    ~MainMenuScene()
+    {
+        this->children.clear();
+        this->entries.clear();
+        this->rules.clear();
+        this->stencil.reset();
+        this->box.reset();
+        this->edges.reset();
+        this->text.reset();
+        this->stencilShader.reset();
+        glfwDestroyWindow(this->window);
+        glfwTerminate();
+    }
+
+private:
+    static std::unique_ptr<MainMenuScene> create()
+    {
+        if (!glfwInit()) {
+            return nullptr;
+        }
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        glfwWindowHint(GLFW_DEPTH_BITS, 24);
+        glfwWindowHint(GLFW_STENCIL_BITS, 8);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 2);
+        glfwWindowHint(GLFW_CONTEXT_VERSION_MINOR, 1);
+        GLFWwindow* window = glfwCreateWindow(720, 720, "menu_render", nullptr, nullptr);
+        if (window == nullptr) {
+            glfwTerminate();
+            return nullptr;
+        }
+        glfwMakeContextCurrent(window);
+        glfwSwapInterval(0);
+        glewExperimental = GL_TRUE;
+        if (glewInit() != GLEW_OK) {
+            glfwDestroyWindow(window);
+            glfwTerminate();
+            return nullptr;
+        }
+        installCallCounters();
+        return std::unique_ptr<MainMenuScene>(new MainMenuScene(window));
+    }
+
+    explicit MainMenuScene(GLFWwindow* window)
+        : window(window)
+    {
+        glViewport(0, 0, 720, 720);
+        glEnable(GL_DEPTH_TEST);
+        glDepthFunc(GL_LESS);
+        glEnable(GL_BLEND);
+        glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+
+        this->edges = std::make_unique<Shader>("./shaders/edges.vs", "./shaders/edges.fs");
+        this->text = std::make_unique<Shader>("./shaders/text.vs", "./shaders/text.fs");
+        this->stencilShader = std::make_unique<Shader>("./shaders/menuStencil.vs", "./shaders/menuStencil.fs");
+        this->edges->bindUniformBlock(Camera::BLOCK_NAME, Camera::scene().binding());
+        this->text->bindUniformBlock(Camera::BLOCK_NAME, Camera::ui().binding());
+
+        this->box = std::make_unique<MenuBox>(glm::vec2 { MENU_POSITION_SCREEN_RELATIVE_X_CENTER, MENU_POSITION_SCREEN_RELATIVE_Y_CENTER }, glm::vec2 { MENU_WIDTH_SCREEN_RELATIVE, MENU_HEIGHT_SCREEN_RELATIVE }, this->edges.get());
+        this->box->setVisible(true);
+
+        const float stencilX = mapRange(MENU_POSITION_SCREEN_RELATIVE_X_CENTER - MENU_WIDTH_SCREEN_RELATIVE / 2, SCREEN_RELATIVE_MIN_X, SCREEN_RELATIVE_MAX_X, SCREEN_PX_MIN_X, SCREEN_PX_MAX_X);
+        const float stencilY = mapRange(MENU_POSITION_SCREEN_RELATIVE_Y_CENTER - MENU_HEIGHT_SCREEN_RELATIVE / 2, SCREEN_RELATIVE_MIN_Y, SCREEN_RELATIVE_MAX_Y, SCREEN_PX_MIN_Y, SCREEN_PX_MAX_Y);
+        const float stencilWidth = mapRange(MENU_WIDTH_SCREEN_RELATIVE, SCREEN_RELATIVE_MIN_WIDTH, SCREEN_RELATIVE_MAX_WIDTH, SCREEN_PX_MIN_X, SCREEN_PX_MAX_X) - (STENCIL_INSET_PX * 2);
+        const float stencilHeight = mapRange(MENU_HEIGHT_SCREEN_RELATIVE, SCREEN_RELATIVE_MIN_HEIGHT, SCREEN_RELATIVE_MAX_HEIGHT, SCREEN_PX_MIN_Y, SCREEN_PX_MAX_Y) - (STENCIL_INSET_PX * 2);
+        this->stencil = std::make_unique<MenuStencil>(glm::vec2 { stencilX + STENCIL_INSET_PX, stencilY + STENCIL_INSET_PX }, glm::vec2 { stencilWidth, stencilHeight }, this->stencilShader.get());
+
+        const std::pair<const char*, EntryType> items[] = {
+            { "Back", EntryType::MENUENTRY_TYPE_ACTION },
+            { "Apps", EntryType::MENUENTRY_TYPE_SUBMENU },
+            { "Personality", EntryType::MENUENTRY_TYPE_SUBMENU },
+            { "Notifications", EntryType::MENUENTRY_TYPE_SUBMENU },
+            { "Do Not Disturb", EntryType::MENUENTRY_TYPE_TOGGLE },
+            { "Display", EntryType::MENUENTRY_TYPE_SUBMENU },
+            { "Sound", EntryType::MENUENTRY_TYPE_SUBMENU },
+            { "Microphone Enabled", EntryType::MENUENTRY_TYPE_TOGGLE },
+            { "WiFi", EntryType::MENUENTRY_TYPE_SUBMENU },
+            { "Bluetooth", EntryType::MENUENTRY_TYPE_TOGGLE },
+            { "Accounts", EntryType::MENUENTRY_TYPE_SUBMENU },
+            { "Privacy", EntryType::MENUENTRY_TYPE_SUBMENU },
+            { "Use Metric Units", EntryType::MENUENTRY_TYPE_RADIOBUTTON_GROUP },
+            { "About", EntryType::MENUENTRY_TYPE_SUBMENU },
+        };
+        const float textSize = MENU_ITEM_TEXT_SIZE;
+        const float textX = mapRange(MENU_POSITION_SCREEN_RELATIVE_X_LEFT, SCREEN_RELATIVE_MIN_X, SCREEN_RELATIVE_MAX_X, SCREEN_PX_MIN_X, SCREEN_PX_MAX_X) + (STENCIL_INSET_PX * 2);
+        const float menuWidthPx = mapRange(MENU_WIDTH_SCREEN_RELATIVE, SCREEN_RELATIVE_MIN_WIDTH, SCREEN_RELATIVE_MAX_WIDTH, SCREEN_PX_MIN_X, SCREEN_PX_MAX_X);
+        const float visibleWidth = menuWidthPx - (STENCIL_INSET_PX * 2) - (MENU_ITEM_PADDING_PX * 2);
+        const float ruleX = textX + 30;
+        for (const auto& [label, type] : items) {
+            // Settings pages separate groups of entries with rules.
+            if (!this->entries.empty() && this->entries.size() % 4 == 0) {
+                const float ruleY = ((textSize * 1.2f) + MENU_ITEM_PADDING_PX) * this->children.size() + MENU_TOP_PADDING_PX + ((textSize + (MENU_ITEM_PADDING_PX * 2)) / 2);
+                this->rules.push_back(std::make_unique<MenuHorizontalRule>(glm::vec2 { ruleX, ruleY }, 350, this->edges.get()));
+                this->rules.back()->setVisible(true);
+                this->children.push_back(this->rules.back().get());
+            }
+            const float startY = ((textSize * 1.2f) + MENU_ITEM_PADDING_PX) * this->children.size() + MENU_TOP_PADDING_PX;
+            const float textY = mapRange(MENU_POSITION_SCREEN_RELATIVE_Y_TOP, SCREEN_RELATIVE_MIN_Y, SCREEN_RELATIVE_MAX_Y, SCREEN_PX_MIN_Y, SCREEN_PX_MAX_Y) - startY - (STENCIL_INSET_PX * 2) - textSize;
+            void* status = this->entries.size() % 2 == 0 ? this : nullptr;
+            this->entries.push_back(std::make_unique<MenuEntry>(this->text.get(), this->edges.get(), label, glm::vec2 { textX, textY }, textSize, visibleWidth, type, entryStatus, status));
+            this->children.push_back(this->entries.back().get());
+        }
+    }
+
+    GLFWwindow* window;
+    std::unique_ptr<Shader> edges;
+    std::unique_ptr<Shader> text;
+    std::unique_ptr<Shader> stencilShader;
+    std::unique_ptr<MenuBox> box;
+    std::unique_ptr<MenuStencil> stencil;
+    std::vector<std::unique_ptr<MenuEntry>> entries;
+    std::vector<std::unique_ptr<MenuHorizontalRule>> rules;
+    std::vector<Clickable*> children;
+    DrawList drawList;
+};
+
+} // namespace
+
+static void BM_MainMenuFrame(benchmark::State& state)
+{
+    MainMenuScene* scene = MainMenuScene::get();
+    if (scene == nullptr) {
+        state.SkipWithError("could not create a GL context (no display?)");
+        return;
+    }
+    PrimitiveBatch::shared().setEnabled(state.range(0) != 0);
+    Shader::setUniformCacheEnabled(state.range(1) != 0);
+    // Let every object upload its initial state before counting.
+    scene->drawFrame();
+    calls = {};
+    const uint64_t batchDrawsBefore = PrimitiveBatch::totalDrawCalls();
+    for (auto _ : state) {
+        scene->drawFrame();
+    }
+    glFinish();
+    PrimitiveBatch::shared().setEnabled(true);
+    Shader::setUniformCacheEnabled(true);
+    const double frames = static_cast<double>(state.iterations());
+    state.counters["batch_draws_per_frame"] = (PrimitiveBatch::totalDrawCalls() - batchDrawsBefore) / frames;
+    state.counters["program_binds_per_frame"] = calls.programBinds / frames;
+    state.counters["uniform_lookups_per_frame"] = calls.uniformLookups / frames;
+    state.counters["uniform_uploads_per_frame"] = calls.uniformUploads / frames;
+    state.counters["buffer_uploads_per_frame"] = calls.bufferUploads / frames;
+    state.counters["gl_state_calls_per_frame"] = (calls.programBinds + calls.uniformLookups + calls.uniformUploads + calls.bufferUploads) / frames;
+}
+
+BENCHMARK(BM_MainMenuFrame)
+    ->ArgNames({ "batched", "uniform_cache" })
+    ->Args({ 0, 0 })
+    ->Args({ 0, 1 })
+    ->Args({ 1, 1 })
+    ->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,284 @@
+#include "../src/hardware/mmWaveFrameDecoder.h"
+#include <benchmark/benchmark.h>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <fcntl.h>
+#include <iomanip>
+#include <poll.h>
+#include <sstream>
+#include <stdlib.h>
+#include <sys/ioctl.h>
+#include <termios.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+// A fake LD2410 on a pseudo-terminal: a writer thread replays a recorded report stream (normal frames
+// with some line noise and a corrupt frame every 50) into the master side, paced at Arg frames per
+// second (0 = as fast as the pty accepts), and the benchmark thread reads the slave side the way
+// mmWave's reader thread does. frames_per_s is decoded frames over wall time; reader_cpu_us_per_frame
+// is the reader thread's own CPU time. Legacy replays the old readDataFrame: FIONREAD polling with
+// 10 ms sleeps, one read() per byte, a hex string rebuilt on every byte, and the 10 ms loop sleep.
+
+namespace {
+
+constexpr int FRAMES_PER_ITERATION = 100;
+
+// One entry per report as the sensor sends it, with any line noise before it.
+std::vector<std::vector<uint8_t>> recordedStream()
+{
+    std::vector<std::vector<uint8_t>> stream;
+    for (int i = 0; i < 50; i++) {
+        const uint16_t distance = static_cast<uint16_t>(80 + (i * 7) % 300);
+        std::vector<uint8_t> frame = { 0xF4, 0xF3, 0xF2, 0xF1, 13, 0, 0x02, 0xAA, static_cast<uint8_t>(i % 4),
+            static_cast<uint8_t>(distance), static_cast<uint8_t>(distance >> 8), 45,
+            static_cast<uint8_t>(distance + 10), static_cast<uint8_t>((distance + 10) >> 8), 60,
+            static_cast<uint8_t>(distance), static_cast<uint8_t>(distance >> 8), 0x55, 0x00,
+            0xF8, 0xF7, 0xF6, 0xF5 };
+        if (i == 25) {
+            frame[frame.size() - 1] = 0x00;
+        }
+        if (i % 10 == 3) {
+            frame.insert(frame.begin(), { 0x00, 0xF4, 0x7E });
+        }
+        stream.push_back(std::move(frame));
+    }
+    return stream;
+}
+
+struct FakeSensor {
+    int master = -1;
+    int slave = -1;
+    std::jthread writer;
+
+    explicit FakeSensor(int framesPerSecond)
+    {
+        master = posix_openpt(O_RDWR | O_NOCTTY);
+        if (master < 0 || grantpt(master) != 0 || unlockpt(master) != 0) {
+            return;
+        }
+        slave = ::open(ptsname(master), O_RDWR | O_NOCTTY | O_NDELAY);
+        termios options {};
+        tcgetattr(slave, &options);
+        cfmakeraw(&options);
+        options.c_cc[VMIN] = 0;
+        options.c_cc[VTIME] = 0;
+        tcsetattr(slave, TCSANOW, &options);
+
+        writer = std::jthread([this, framesPerSecond](std::stop_token stopToken) {
+            const std::vector<std::vector<uint8_t>> stream = recordedStream();
+            const auto period = framesPerSecond > 0 ? std::chrono::microseconds(1000000 / framesPerSecond) : std::chrono::microseconds(0);
+            auto next = std::chrono::steady_clock::now();
+            size_t report = 0;
+            size_t offset = 0;
+            while (!stopToken.stop_requested()) {
+                const std::vector<uint8_t>& bytes = stream[report];
+                pollfd pfd { master, POLLOUT, 0 };
+                if (::poll(&pfd, 1, 50) <= 0) {
+                    continue;
+                }
+                const ssize_t written = ::write(master, bytes.data() + offset, bytes.size() - offset);
+                if (written > 0) {
+                    offset += static_cast<size_t>(written);
+                }
+                if (offset < bytes.size()) {
+                    continue;
+                }
+                offset = 0;
+                report = (report + 1) % stream.size();
+                if (period.count() > 0) {
+                    next += period;
+                    std::this_thread::sleep_until(next);
+                }
+            }
+        });
+    }
+
+    ~FakeSensor()
+    {
+        writer.request_stop();
+        if (writer.joinable()) {
+            writer.join();
+        }
+        if (slave >= 0) {
+            ::close(slave);
+        }
+        if (master >= 0) {
+            ::close(master);
+        }
+    }
+};
+
+double threadCpuSeconds()
+{
+    timespec ts {};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) * 1e-9;
+}
+
+void sleepMs(int ms)
+{
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+int avail(int fd)
+{
+    int bytes = 0;
+    ioctl(fd, FIONREAD, &bytes);
+    return bytes;
+}
+
+uint8_t getchar1(int fd)
+{
+    uint8_t c = 0;
+    ::read(fd, &c, 1);
+    return c;
+}
+
+// The old Response: every appended byte re-renders the whole hex string.
+struct LegacyResponse {
+    std::vector<uint8_t> data;
+    std::string hexStr;
+    void append(uint8_t byte)
+    {
+        data.push_back(byte);
+        std::ostringstream oss;
+        for (const auto& b : data) {
+            oss << std::hex << std::setw(2) << std::setfill('0') << static_cast<int>(b);
+        }
+        hexStr = oss.str();
+    }
+};
+
+bool legacyReadFrame(int fd, MmWaveReading& reading)
+{
+    LegacyResponse response;
+    response.data = { 0xF4, 0xF3, 0xF2, 0xF1 };
+    int waited = 0;
+    while (avail(fd) == 0 && waited < 1000) {
+        sleepMs(10);
+        waited += 10;
+    }
+    if (waited >= 1000) {
+        return false;
+    }
+    sleepMs(1);
+    size_t headerIndex = 0;
+    sleepMs(1);
+    while (avail(fd) > 0) {
+        const uint8_t c = getchar1(fd);
+        if (c == response.data[headerIndex]) {
+            if (++headerIndex == 4) {
+                break;
+            }
+        } else {
+            headerIndex = 0;
+        }
+    }
+    if (headerIndex != 4) {
+        return false;
+    }
+    sleepMs(1);
+    uint16_t reportSize = getchar1(fd);
+    reportSize |= getchar1(fd) << 8;
+    response.append(reportSize & 0xFF);
+    response.append(reportSize >> 8);
+    if (avail(fd) < reportSize) {
+        return false;
+    }
+    sleepMs(2);
+    for (uint16_t i = 0; i < reportSize + 4; i++) {
+        response.append(getchar1(fd));
+    }
+    const std::vector<uint8_t>& d = response.data;
+    if (d.size() != 23u || d[19] != 0xF8 || d[22] != 0xF5 || d[7] != 0xAA || d[17] != 0x55) {
+        return false;
+    }
+    reading.targetState = d[8];
+    reading.detectionDistance = static_cast<uint16_t>(d[15] | d[16] << 8);
+    return true;
+}
+
+void reportCounters(benchmark::State& state, int64_t frames, double wallSeconds, double cpuSeconds)
+{
+    state.counters["frames_per_s"] = static_cast<double>(frames) / wallSeconds;
+    state.counters["reader_cpu_us_per_frame"] = frames > 0 ? cpuSeconds * 1e6 / static_cast<double>(frames) : 0.0;
+    state.counters["reader_cpu_pct"] = 100.0 * cpuSeconds / wallSeconds;
+}
+
+} // namespace
+
+static void BM_MmWaveReaderLegacy(benchmark::State& state)
+{
+    FakeSensor sensor(static_cast<int>(state.range(0)));
+    if (sensor.slave < 0) {
+        state.SkipWithError("no pty");
+        return;
+    }
+    int64_t frames = 0;
+    double wall = 0.0;
+    double cpu = 0.0;
+    MmWaveReading reading;
+    for (auto _ : state) {
+        const auto start = std::chrono::steady_clock::now();
+        const double cpuStart = threadCpuSeconds();
+        int decoded = 0;
+        int attempts = 0;
+        while (decoded < FRAMES_PER_ITERATION && attempts++ < FRAMES_PER_ITERATION * 4) {
+            if (legacyReadFrame(sensor.slave, reading)) {
+                decoded++;
+            }
+            sleepMs(10);
+        }
+        benchmark::DoNotOptimize(reading);
+        cpu += threadCpuSeconds() - cpuStart;
+        wall += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        frames += decoded;
+    }
+    reportCounters(state, frames, wall, cpu);
+}
+BENCHMARK(BM_MmWaveReaderLegacy)->Arg(0)->Arg(50)->Iterations(1)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+static void BM_MmWaveReaderStreaming(benchmark::State& state)
+{
+    FakeSensor sensor(static_cast<int>(state.range(0)));
+    if (sensor.slave < 0) {
+        state.SkipWithError("no pty");
+        return;
+    }
+    MmWaveFrameDecoder decoder;
+    std::array<uint8_t, 512> buffer {};
+    MmWaveFrame frame;
+    int64_t frames = 0;
+    double wall = 0.0;
+    double cpu = 0.0;
+    for (auto _ : state) {
+        const auto start = std::chrono::steady_clock::now();
+        const double cpuStart = threadCpuSeconds();
+        int decoded = 0;
+        while (decoded < FRAMES_PER_ITERATION) {
+            pollfd pfd { sensor.slave, POLLIN, 0 };
+            if (::poll(&pfd, 1, 100) <= 0) {
+                continue;
+            }
+            const ssize_t bytesRead = ::read(sensor.slave, buffer.data(), buffer.size());
+            if (bytesRead <= 0) {
+                continue;
+            }
+            std::span<const uint8_t> input(buffer.data(), static_cast<size_t>(bytesRead));
+            while (!input.empty()) {
+                if (decoder.decode(input, frame) == MmWaveFrameDecoder::Status::Frame) {
+                    decoded++;
+                }
+            }
+        }
+        benchmark::DoNotOptimize(frame);
+        cpu += threadCpuSeconds() - cpuStart;
+        wall += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        frames += decoded;
+    }
+    reportCounters(state, frames, wall, cpu);
+}
+BENCHMARK(BM_MmWaveReaderStreaming)->Arg(0)->Arg(50)->Unit(benchmark::kMillisecond)->UseRealTime();
@@ -0,0 +1,131 @@
+#include "../src/periodicScheduler.h"
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// Wakeups per second and start lateness of the idle device's periodic loops over a two second window. Both
+// benchmarks run the same three tasks at the same periods (kTasks): the 10 s monitor, the 2 s fan control and
+// the 50 ms interaction poll. Legacy gives each its own thread that sleeps its interval after its work, the
+// way the loops were written before the scheduler. Scheduler runs them as tasks: fan control and the monitor on
+// one housekeeping scheduler with their jitter budgets, interaction polling on its own. Lateness is measured
+// from each run's ideal deadline (the previous deadline plus the interval), so the legacy loops' drift shows
+// up as lateness.
+
+namespace {
+
+using namespace std::chrono_literals;
+using Clock = std::chrono::steady_clock;
+
+constexpr auto kWindow = 2s;
+
+struct BenchTask {
+    const char* name;
+    std::chrono::milliseconds period;
+    std::chrono::milliseconds budget;
+    bool housekeeping;
+};
+
+constexpr BenchTask kTasks[] = {
+    { "monitor", 10000ms, 1000ms, true },
+    { "fan", 2000ms, 250ms, true },
+    { "interaction", 50ms, 0ms, false },
+};
+
+struct LegacyLoop {
+    std::chrono::milliseconds interval;
+    uint64_t wakeups = 0;
+    Metrics::Histogram lateness;
+};
+
+void runLegacyLoop(std::stop_token stopToken, LegacyLoop& loop)
+{
+    std::mutex mutex;
+    std::condition_variable_any wake;
+    auto deadline = Clock::now();
+    while (!stopToken.stop_requested()) {
+        const auto now = Clock::now();
+        loop.lateness.record(static_cast<uint64_t>(std::max<int64_t>(0, std::chrono::duration_cast<std::chrono::microseconds>(now - deadline).count())));
+        deadline += loop.interval;
+        std::unique_lock<std::mutex> lock(mutex);
+        wake.wait_for(lock, stopToken, loop.interval, [] { return false; });
+        loop.wakeups++;
+    }
+}
+
+void BM_IdlePeriodicLoops_Legacy(benchmark::State& state)
+{
+    uint64_t wakeups = 0;
+    uint64_t interactionP99 = 0;
+    uint64_t fanMax = 0;
+    for (auto _ : state) {
+        std::vector<std::unique_ptr<LegacyLoop>> loops;
+        for (const auto& task : kTasks) {
+            loops.push_back(std::make_unique<LegacyLoop>(task.period));
+        }
+        {
+            std::vector<std::jthread> threads;
+            for (auto& loop : loops) {
+                threads.emplace_back([&loop = *loop](std::stop_token stopToken) { runLegacyLoop(stopToken, loop); });
+            }
+            std::this_thread::sleep_for(kWindow);
+        }
+        wakeups = 0;
+        for (size_t index = 0; index < loops.size(); ++index) {
+            wakeups += loops[index]->wakeups;
+            if (std::string_view(kTasks[index].name) == "interaction") {
+                interactionP99 = loops[index]->lateness.snapshot().percentile(0.99);
+            } else if (std::string_view(kTasks[index].name) == "fan") {
+                fanMax = loops[index]->lateness.snapshot().max;
+            }
+        }
+    }
+    state.counters["wakeups_per_s"] = static_cast<double>(wakeups) / std::chrono::duration<double>(kWindow).count();
+    state.counters["interaction_late_p99_us"] = static_cast<double>(interactionP99);
+    state.counters["fan_late_max_us"] = static_cast<double>(fanMax);
+}
+BENCHMARK(BM_IdlePeriodicLoops_Legacy)->Iterations(1)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+void BM_IdlePeriodicLoops_Scheduler(benchmark::State& state)
+{
+    uint64_t wakeups = 0;
+    uint64_t interactionP99 = 0;
+    uint64_t fanMax = 0;
+    for (auto _ : state) {
+        PeriodicScheduler housekeeping("bench-housekeeping");
+        PeriodicScheduler interaction("bench-interaction");
+        std::vector<std::pair<PeriodicScheduler*, PeriodicScheduler::TaskId>> handles;
+        for (const auto& task : kTasks) {
+            PeriodicScheduler& scheduler = task.housekeeping ? housekeeping : interaction;
+            handles.emplace_back(&scheduler, scheduler.add({ task.name, task.period, task.budget }, [] {}));
+        }
+        std::this_thread::sleep_for(kWindow);
+
+        const auto housekeepingStats = housekeeping.stats();
+        const auto interactionStats = interaction.stats();
+        wakeups = housekeepingStats.wakeups + interactionStats.wakeups;
+        for (const auto* stats : { &housekeepingStats, &interactionStats }) {
+            for (const auto& task : stats->tasks) {
+                if (task.name == "interaction") {
+                    interactionP99 = task.lateness.percentile(0.99);
+                } else if (task.name == "fan") {
+                    fanMax = task.lateness.max;
+                }
+            }
+        }
+        for (const auto& [scheduler, handle] : handles) {
+            scheduler->remove(handle);
+        }
+    }
+    state.counters["wakeups_per_s"] = static_cast<double>(wakeups) / std::chrono::duration<double>(kWindow).count();
+    state.counters["interaction_late_p99_us"] = static_cast<double>(interactionP99);
+    state.counters["fan_late_max_us"] = static_cast<double>(fanMax);
+}
+BENCHMARK(BM_IdlePeriodicLoops_Scheduler)->Iterations(1)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+} // namespace
@@ -0,0 +1,165 @@
+#include "../src/hardware/io_bridge/spi.h"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+// SPI throughput in MB/s through a loopback stand-in for the bridge uplink. A bridge thread answers each
+// frame by echoing its tx bytes (MOSI wired to MISO), so every frame pays a real thread handoff each way.
+// The host side keeps up to `window` frames in flight before it waits on responses.
+// Legacy replays the old in-process path: the caller base64-encodes its bytes, SPI decodes them once to
+// validate, wraps them in a JSON request with the handle settings and sends that as one frame regardless
+// of size; the bridge parses the JSON and decodes the base64, and the response comes back base64 encoded.
+// Binary calls SPI::transfer() with spans: frames are cut to the 512-byte MTU and pipelined as one batch.
+
+namespace {
+
+class LoopbackBridgeTransport final : public IIoBridgeTransport {
+public:
+    LoopbackBridgeTransport(size_t mtu, size_t window)
+        : mtu_(mtu)
+        , window_(std::max<size_t>(1, window))
+    {
+        bridge_ = std::jthread([this](std::stop_token stopToken) { serve(stopToken); });
+    }
+
+    std::expected<IoBridgePayload, IoBridgeError> transact(const IoBridgeTransaction& transaction) override
+    {
+        auto responses = transactBatch(std::span<const IoBridgeTransaction>(&transaction, 1));
+        if (!responses) {
+            return std::unexpected(responses.error());
+        }
+        return std::move(responses->front());
+    }
+
+    std::expected<std::vector<IoBridgePayload>, IoBridgeError> transactBatch(std::span<const IoBridgeTransaction> transactions) override
+    {
+        std::vector<IoBridgePayload> responses;
+        responses.reserve(transactions.size());
+        std::unique_lock<std::mutex> lock(mutex_);
+        size_t sent = 0;
+        while (responses.size() < transactions.size()) {
+            while (sent < transactions.size() && sent - responses.size() < window_) {
+                requests_.push_back(&transactions[sent++]);
+            }
+            requestCv_.notify_one();
+            responseCv_.wait(lock, [this] { return !responses_.empty(); });
+            while (!responses_.empty()) {
+                responses.push_back(std::move(responses_.front()));
+                responses_.pop_front();
+            }
+        }
+        return responses;
+    }
+
+    size_t mtu() const override { return mtu_; }
+
+private:
+    static IoBridgePayload answer(const IoBridgePayload& payload)
+    {
+        if (!payload.empty() && payload.front() == '{') {
+            const auto request = nlohmann::json::parse(payload.begin(), payload.end());
+            const auto tx = base64_decode_cube(request["tx"].get<std::string>());
+            IoBridgePayload rx(request["rxLen"].get<size_t>(), 0);
+            std::copy_n(tx.begin(), std::min(rx.size(), tx.size()), rx.begin());
+            return rx;
+        }
+        const auto request = SpixXferRequest::decode(payload);
+        IoBridgePayload rx(request ? request->rxLen : 0, 0);
+        if (request) {
+            std::copy_n(request->tx.begin(), std::min(rx.size(), request->tx.size()), rx.begin());
+        }
+        return rx;
+    }
+
+    void serve(std::stop_token stopToken)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (requestCv_.wait(lock, stopToken, [this] { return !requests_.empty(); })) {
+            const IoBridgeTransaction* transaction = requests_.front();
+            requests_.pop_front();
+            lock.unlock();
+            auto response = answer(transaction->payload);
+            lock.lock();
+            responses_.push_back(std::move(response));
+            responseCv_.notify_one();
+        }
+    }
+
+    size_t mtu_;
+    size_t window_;
+    std::mutex mutex_;
+    std::condition_variable_any requestCv_;
+    std::condition_variable responseCv_;
+    std::deque<const IoBridgeTransaction*> requests_;
+    std::deque<IoBridgePayload> responses_;
+    std::jthread bridge_;
+};
+
+std::vector<uint8_t> pattern(size_t size)
+{
+    std::vector<uint8_t> bytes(size);
+    std::iota(bytes.begin(), bytes.end(), 0);
+    return bytes;
+}
+
+// The removed SPI::transfer(), as an in-process caller used it.
+std::vector<uint8_t> legacyTransfer(IoBridgeSession& session, const std::vector<uint8_t>& tx, size_t rxLen)
+{
+    const base64String txData = base64_encode_cube(tx);
+    base64_decode_cube(txData);
+    const nlohmann::json payloadJson = {
+        { "handle", "flash" },
+        { "mode", 0 },
+        { "speed", 8000000 },
+        { "tx", txData },
+        { "rxLen", rxLen }
+    };
+    const std::string payloadString = payloadJson.dump();
+    IoBridgeTransaction transaction;
+    transaction.endpoint = IoBridgeEndpoint::Spi;
+    transaction.payload = IoBridgePayload(payloadString.begin(), payloadString.end());
+    transaction.expectedResponseLength = rxLen;
+    const auto response = session.transact(transaction);
+    return base64_decode_cube(base64_encode_cube(*response));
+}
+
+void BM_SpiTransfer_LegacyBase64Json(benchmark::State& state)
+{
+    const auto size = static_cast<size_t>(state.range(0));
+    IoBridgeSession session(std::make_shared<LoopbackBridgeTransport>(kIoBridgeDefaultMtu, 1));
+    const auto tx = pattern(size);
+    for (auto _ : state) {
+        auto rx = legacyTransfer(session, tx, size);
+        benchmark::DoNotOptimize(rx.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * size));
+}
+BENCHMARK(BM_SpiTransfer_LegacyBase64Json)->Arg(64)->Arg(4096)->Arg(65536)->UseRealTime();
+
+void BM_SpiTransfer_Binary(benchmark::State& state)
+{
+    Config::set("HARDWARE_SPI_ENABLED", "1");
+    const auto size = static_cast<size_t>(state.range(0));
+    SPI spi(std::make_shared<IoBridgeSession>(std::make_shared<LoopbackBridgeTransport>(kIoBridgeDefaultMtu, static_cast<size_t>(state.range(1)))));
+    spi.registerHandle("flash", 8000000, 0);
+    const auto tx = pattern(size);
+    std::vector<uint8_t> rx(size);
+    for (auto _ : state) {
+        if (!spi.transfer("flash", tx, rx)) {
+            state.SkipWithError("transfer failed");
+            break;
+        }
+        benchmark::DoNotOptimize(rx.data());
+    }
+    state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * size));
+}
+BENCHMARK(BM_SpiTransfer_Binary)->ArgsProduct({ { 64, 4096, 65536 }, { 1, 8 } })->ArgNames({ "bytes", "window" })->UseRealTime();
+
+} // namespace
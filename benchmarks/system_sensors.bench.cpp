@@ -0,0 +1,194 @@
+#include "../src/hardware/systemSensorSampler.h"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdlib>
+#include <filesystem>
+#include <fstream>
+#include <new>
+#include <sstream>
+#include <string>
+#include <unistd.h>
+
+// Cost of one system sensor sample against a fake sysfs/proc root in a temp directory, laid out like a Pi 5:
+// four thermal zones, four cores, and full-length meminfo and self/status files. Legacy replays the readers
+// the sampler replaced: the fan loop scanning thermal zones twice per tick (cpu, then system temperature) and
+// utils reading VmRSS and /proc/stat through ifstream. The old no-arg HardwareInfo calls also queried infoware
+// every time; that part is left out so both sides do the same file work. allocs_per_sample counts operator
+// new calls made by this thread inside the timed loop.
+
+namespace {
+
+std::atomic<bool> countingAllocations { false };
+std::atomic<uint64_t> allocations { 0 };
+
+void writeText(const std::filesystem::path& path, const std::string& value)
+{
+    std::filesystem::create_directories(path.parent_path());
+    std::ofstream file(path);
+    file << value;
+}
+
+std::string fillerLines(const std::string& prefix, int count)
+{
+    std::string text;
+    for (int index = 0; index < count; ++index) {
+        text += prefix + std::to_string(index) + ":\t    " + std::to_string(1000 + index * 37) + " kB\n";
+    }
+    return text;
+}
+
+class FakeRoots {
+public:
+    FakeRoots()
+        : root_(std::filesystem::temp_directory_path() / ("thecube-sensor-bench-" + std::to_string(::getpid())))
+    {
+        const std::array<const char*, 4> zones { "cpu-thermal", "rp1_adc", "gpu-thermal", "board" };
+        for (size_t zone = 0; zone < zones.size(); ++zone) {
+            const auto dir = sys() / "class/thermal" / ("thermal_zone" + std::to_string(zone));
+            writeText(dir / "type", std::string(zones[zone]) + "\n");
+            writeText(dir / "temp", std::to_string(41000 + zone * 1250) + "\n");
+        }
+        std::string stat = "cpu  183472 2201 61234 9812345 4412 0 2231 0 0 0\n";
+        for (int core = 0; core < 4; ++core) {
+            stat += "cpu" + std::to_string(core) + " 45868 550 15308 2453086 1103 0 557 0 0 0\n";
+        }
+        stat += "intr 91827364 0 0 0\nctxt 123456789\nbtime 1760000000\nprocesses 54321\nprocs_running 2\nprocs_blocked 0\n";
+        writeText(proc() / "stat", stat);
+        writeText(proc() / "meminfo",
+            "MemTotal:        8245168 kB\nMemFree:         5123456 kB\nMemAvailable:    7012345 kB\n" + fillerLines("Filler", 52));
+        writeText(proc() / "self/status", "Name:\tCubeCore\nState:\tS (sleeping)\n" + fillerLines("Vm", 18) + "VmRSS:\t  123456 kB\n" + fillerLines("Misc", 34));
+        writeText(proc() / "loadavg", "0.52 0.31 0.12 2/345 6789\n");
+    }
+
+    ~FakeRoots()
+    {
+        std::error_code ec;
+        std::filesystem::remove_all(root_, ec);
+    }
+
+    std::filesystem::path sys() const { return root_ / "sys"; }
+    std::filesystem::path proc() const { return root_ / "proc"; }
+
+private:
+    std::filesystem::path root_;
+};
+
+std::string legacyVmRss(const std::filesystem::path& procRoot)
+{
+    std::ifstream file(procRoot / "self/status");
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.find("VmRSS") != std::string::npos) {
+            std::string rss = line.substr(line.find(":") + 1);
+            rss.erase(std::remove_if(rss.begin(), rss.end(), isspace), rss.end());
+            return rss;
+        }
+    }
+    return "0";
+}
+
+uint64_t legacyCpuBusy(const std::filesystem::path& procRoot)
+{
+    std::ifstream file(procRoot / "stat");
+    std::string line;
+    std::getline(file, line);
+    std::istringstream fields(line.substr(4));
+    uint64_t total = 0;
+    uint64_t idle = 0;
+    uint64_t value = 0;
+    for (int field = 0; field < 8 && fields >> value; ++field) {
+        total += value;
+        idle += (field == 3 || field == 4) ? value : 0;
+    }
+    return total - idle;
+}
+
+uint64_t legacyMemAvailable(const std::filesystem::path& procRoot)
+{
+    std::ifstream file(procRoot / "meminfo");
+    std::string line;
+    while (std::getline(file, line)) {
+        if (line.rfind("MemAvailable:", 0) == 0) {
+            return std::stoull(line.substr(13));
+        }
+    }
+    return 0;
+}
+
+void reportAllocations(benchmark::State& state)
+{
+    state.counters["allocs_per_sample"] = benchmark::Counter(
+        static_cast<double>(allocations.exchange(0)), benchmark::Counter::kAvgIterations);
+}
+
+} // namespace
+
+void* operator new(std::size_t size)
+{
+    if (countingAllocations.load(std::memory_order_relaxed)) {
+        allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (void* memory = std::malloc(size == 0 ? 1 : size)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept
+{
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept
+{
+    std::free(memory);
+}
+
+static void BM_SystemSensorSample_Legacy(benchmark::State& state)
+{
+    FakeRoots roots;
+    allocations = 0;
+    countingAllocations = true;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(HardwareInfo::thermalSensors(roots.sys()));
+        benchmark::DoNotOptimize(HardwareInfo::thermalSensors(roots.sys()));
+        benchmark::DoNotOptimize(legacyVmRss(roots.proc()));
+        benchmark::DoNotOptimize(legacyCpuBusy(roots.proc()));
+        benchmark::DoNotOptimize(legacyMemAvailable(roots.proc()));
+    }
+    countingAllocations = false;
+    reportAllocations(state);
+}
+BENCHMARK(BM_SystemSensorSample_Legacy);
+
+static void BM_SystemSensorSample_Sampler(benchmark::State& state)
+{
+    FakeRoots roots;
+    SystemSensorSampler sampler(roots.sys(), roots.proc());
+    allocations = 0;
+    countingAllocations = true;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sampler.sample());
+    }
+    countingAllocations = false;
+    reportAllocations(state);
+}
+BENCHMARK(BM_SystemSensorSample_Sampler);
+
+// A consumer that finds a snapshot younger than maxAge copies it without touching the files.
+static void BM_SystemSensorSample_LatestReuse(benchmark::State& state)
+{
+    FakeRoots roots;
+    SystemSensorSampler sampler(roots.sys(), roots.proc());
+    sampler.sample();
+    allocations = 0;
+    countingAllocations = true;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(sampler.latest(std::chrono::hours(1)));
+    }
+    countingAllocations = false;
+    reportAllocations(state);
+}
+BENCHMARK(BM_SystemSensorSample_LatestReuse);
@@ -0,0 +1,154 @@
+#include "../src/gui/renderables/textLayout.h"
+#include <benchmark/benchmark.h>
+#include <algorithm>
+#include <chrono>
+#include <filesystem>
+#include <future>
+#include <sstream>
+
+// Opening a 4 KB text box. The Legacy case is what the render thread used to do inside the setup task:
+// wrap on an estimated character width, then load and render every glyph of the text through FreeType
+// on a cold cache. The TextLayout cases split that into what the render thread still does (request()
+// on a miss, and on a hit) and what the worker does. worst_us is the slowest single render-thread call,
+// i.e. the stall the frame that opens the box would see, minus the per-line buffer uploads which need a
+// GL context. Run from the repository root so fonts/ resolves.
+
+namespace {
+
+const char* FONT = "fonts/Roboto/Roboto-Regular.ttf";
+constexpr int PIXEL_SIZE = 32;
+constexpr int WRAP_WIDTH = 700;
+
+std::string transcript(size_t bytes, int seed)
+{
+    static const char* words[] = { "the", "cube", "heard", "you", "say", "weather", "tomorrow", "is", "looking", "mostly", "sunny",
+        "with", "a", "chance", "of", "rain", "after", "noon;", "temperatures", "around", "seventeen", "degrees." };
+    std::string text = std::to_string(seed);
+    size_t i = static_cast<size_t>(seed);
+    while (text.size() < bytes) {
+        text += (i % 40 == 39) ? "\n" : " ";
+        text += words[i % std::size(words)];
+        i = i * 7 + 3;
+    }
+    return text;
+}
+
+bool haveFont(benchmark::State& state)
+{
+    if (!std::filesystem::exists(FONT)) {
+        state.SkipWithError("run from the repository root");
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+static void BM_LegacyOpenTextBox(benchmark::State& state)
+{
+    if (!haveFont(state)) {
+        return;
+    }
+    FT_Library library;
+    FT_Face face;
+    FT_Init_FreeType(&library);
+    FT_New_Face(library, FONT, 0, &face);
+    FT_Set_Pixel_Sizes(face, 0, PIXEL_SIZE);
+    double worst = 0;
+    int seed = 0;
+    for (auto _ : state) {
+        const auto start = std::chrono::steady_clock::now();
+        const std::string text = transcript(4096, seed++);
+        std::vector<std::string> lines;
+        const size_t maxCharsPerLine = static_cast<size_t>((WRAP_WIDTH - 20) / (PIXEL_SIZE * 0.55f));
+        std::istringstream textStream(text);
+        std::string paragraph;
+        while (std::getline(textStream, paragraph)) {
+            std::istringstream wordStream(paragraph);
+            std::string word, current;
+            while (wordStream >> word) {
+                if (current.empty()) {
+                    current = word;
+                } else if (current.size() + 1 + word.size() <= maxCharsPerLine) {
+                    current += " " + word;
+                } else {
+                    lines.push_back(current);
+                    current = word;
+                }
+            }
+            lines.push_back(current);
+        }
+        // Cold glyph cache: every distinct character is loaded and rendered once.
+        bool seen[128] = {};
+        for (unsigned char c : text) {
+            if (c < 128 && !seen[c]) {
+                seen[c] = true;
+                FT_Load_Char(face, c, FT_LOAD_RENDER);
+            }
+        }
+        benchmark::DoNotOptimize(lines.data());
+        worst = std::max(worst, std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+    }
+    state.counters["worst_us"] = worst;
+    FT_Done_Face(face);
+    FT_Done_FreeType(library);
+}
+BENCHMARK(BM_LegacyOpenTextBox);
+
+static void BM_TextLayoutOpenTextBox(benchmark::State& state)
+{
+    if (!haveFont(state)) {
+        return;
+    }
+    TextLayout layout(8);
+    double worst = 0;
+    int seed = 0;
+    for (auto _ : state) {
+        state.PauseTiming();
+        const std::string text = transcript(4096, seed++);
+        std::promise<void> done;
+        state.ResumeTiming();
+        const auto start = std::chrono::steady_clock::now();
+        auto cached = layout.request(FONT, text, PIXEL_SIZE, WRAP_WIDTH, [&done](auto) { done.set_value(); });
+        worst = std::max(worst, std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start).count());
+        state.PauseTiming();
+        if (!cached) {
+            done.get_future().wait();
+        }
+        state.ResumeTiming();
+    }
+    state.counters["worst_us"] = worst;
+}
+BENCHMARK(BM_TextLayoutOpenTextBox)->Iterations(200);
+
+static void BM_TextLayoutCacheHit(benchmark::State& state)
+{
+    if (!haveFont(state)) {
+        return;
+    }
+    TextLayout layout(8);
+    const std::string text = transcript(4096, 1);
+    std::promise<void> done;
+    layout.request(FONT, text, PIXEL_SIZE, WRAP_WIDTH, [&done](auto) { done.set_value(); });
+    done.get_future().wait();
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(layout.request(FONT, text, PIXEL_SIZE, WRAP_WIDTH, nullptr));
+    }
+}
+BENCHMARK(BM_TextLayoutCacheHit);
+
+static void BM_TextLayoutWorker(benchmark::State& state)
+{
+    if (!haveFont(state)) {
+        return;
+    }
+    TextLayout layout(8);
+    int seed = 0;
+    size_t lines = 0;
+    for (auto _ : state) {
+        auto result = layout.layoutNow(FONT, transcript(4096, seed++), PIXEL_SIZE, WRAP_WIDTH);
+        lines = result->lines.size();
+    }
+    state.counters["lines"] = static_cast<double>(lines);
+}
+BENCHMARK(BM_TextLayoutWorker);
@@ -1,2 +1,2 @@
 #pragma once
-#define NUM_INTERFACES 20
\ No newline at end of file
+#define NUM_INTERFACES 21
\ No newline at end of file
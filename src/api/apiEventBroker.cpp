@@ -26,6 +26,46 @@ bool eventMatchesSources(const ApiEvent& event, const std::optional<ApiEventBrok
 
 } // namespace
 
+ApiEventPayload::ApiEventPayload()
+    : ApiEventPayload(nlohmann::json::object())
+{
+}
+
+ApiEventPayload::ApiEventPayload(nlohmann::json value)
+    : state_(std::make_shared<State>())
+{
+    state_->value = std::move(value);
+    state_->built.store(true, std::memory_order_release);
+}
+
+ApiEventPayload ApiEventPayload::deferred(Builder builder)
+{
+    ApiEventPayload payload;
+    payload.state_ = std::make_shared<State>();
+    payload.state_->builder = std::move(builder);
+    return payload;
+}
+
+const nlohmann::json& ApiEventPayload::get() const
+{
+    State& state = *state_;
+    if (!state.built.load(std::memory_order_acquire)) {
+        std::call_once(state.once, [&state]() {
+            if (state.builder) {
+                state.value = state.builder();
+                state.builder = nullptr;
+            }
+            state.built.store(true, std::memory_order_release);
+        });
+    }
+    return state.value;
+}
+
+bool ApiEventPayload::isBuilt() const
+{
+    return state_->built.load(std::memory_order_acquire);
+}
+
 ApiEventBroker::ApiEventBroker(size_t maxHistory)
     : maxHistory_(std::max<size_t>(1, maxHistory))
 {
@@ -74,31 +114,62 @@ uint64_t ApiEventBroker::oldestSequence() const
 ApiEvent ApiEventBroker::publish(
     const std::string& source,
     const std::string& event,
-    nlohmann::json payload,
+    ApiEventPayload payload,
     uint64_t occurredAtEpochMs)
 {
-    std::lock_guard<std::mutex> lock(mutex_);
+    ApiEvent brokerEvent;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
 
-    if (!source.empty()) {
-        knownSources_.insert(source);
-    }
+        if (!source.empty()) {
+            knownSources_.insert(source);
+        }
 
-    ApiEvent brokerEvent;
-    brokerEvent.sequence = nextSequence_++;
-    brokerEvent.occurredAtEpochMs = occurredAtEpochMs;
-    brokerEvent.source = source;
-    brokerEvent.event = event;
-    brokerEvent.payload = std::move(payload);
-
-    history_.push_back(brokerEvent);
-    while (history_.size() > maxHistory_) {
-        history_.pop_front();
+        brokerEvent.sequence = nextSequence_++;
+        brokerEvent.occurredAtEpochMs = occurredAtEpochMs;
+        brokerEvent.source = source;
+        brokerEvent.event = event;
+        brokerEvent.payload = std::move(payload);
+
+        history_.push_back(brokerEvent);
+        while (history_.size() > maxHistory_) {
+            history_.pop_front();
+        }
+
+        eventsAvailableCv_.notify_all();
     }
 
-    eventsAvailableCv_.notify_all();
+    std::vector<std::shared_ptr<Listener>> listeners;
+    {
+        std::lock_guard<std::mutex> lock(listenersMutex_);
+        listeners.reserve(listeners_.size());
+        for (const auto& [handle, listener] : listeners_) {
+            listeners.push_back(listener);
+        }
+    }
+    for (const auto& listener : listeners) {
+        (*listener)(brokerEvent);
+    }
     return brokerEvent;
 }
 
+ApiEventBroker::ListenerHandle ApiEventBroker::addListener(Listener listener)
+{
+    if (!listener) {
+        return 0;
+    }
+    std::lock_guard<std::mutex> lock(listenersMutex_);
+    const auto handle = nextListenerHandle_++;
+    listeners_.emplace(handle, std::make_shared<Listener>(std::move(listener)));
+    return handle;
+}
+
+bool ApiEventBroker::removeListener(ListenerHandle handle)
+{
+    std::lock_guard<std::mutex> lock(listenersMutex_);
+    return listeners_.erase(handle) > 0;
+}
+
 ApiEventPage ApiEventBroker::waitForEvents(
     uint64_t sinceSequence,
     const std::optional<SourceSet>& sources,
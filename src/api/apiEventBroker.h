@@ -17,24 +17,53 @@ Copyright (c) 2026 A-McD Technology LLC
 #ifndef API_EVENT_BROKER_H
 #define API_EVENT_BROKER_H
 
+#include <atomic>
 #include <condition_variable>
 #include <chrono>
 #include <cstdint>
 #include <deque>
+#include <functional>
+#include <memory>
 #include <mutex>
 #include <optional>
 #include <string>
+#include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
 #include <nlohmann/json.hpp>
 
+// An event payload as the broker stores it. Sources that already hold JSON pass it straight in;
+// hot-path sources pass a builder through deferred(), which runs once, on the first get(), so events
+// that no client reads are never serialized. Copies share the built value.
+class ApiEventPayload {
+public:
+    using Builder = std::function<nlohmann::json()>;
+
+    ApiEventPayload();
+    ApiEventPayload(nlohmann::json value);
+    static ApiEventPayload deferred(Builder builder);
+
+    const nlohmann::json& get() const;
+    bool isBuilt() const;
+
+private:
+    struct State {
+        std::once_flag once;
+        std::atomic<bool> built { false };
+        Builder builder;
+        nlohmann::json value;
+    };
+
+    std::shared_ptr<State> state_;
+};
+
 struct ApiEvent {
     uint64_t sequence = 0;
     uint64_t occurredAtEpochMs = 0;
     std::string source;
     std::string event;
-    nlohmann::json payload = nlohmann::json::object();
+    ApiEventPayload payload;
 };
 
 struct ApiEventPage {
@@ -47,6 +76,8 @@ struct ApiEventPage {
 class ApiEventBroker {
 public:
     using SourceSet = std::unordered_set<std::string>;
+    using Listener = std::function<void(const ApiEvent&)>;
+    using ListenerHandle = uint64_t;
 
     explicit ApiEventBroker(size_t maxHistory = 512);
 
@@ -59,7 +90,7 @@ public:
     ApiEvent publish(
         const std::string& source,
         const std::string& event,
-        nlohmann::json payload,
+        ApiEventPayload payload,
         uint64_t occurredAtEpochMs);
 
     ApiEventPage waitForEvents(
@@ -68,6 +99,11 @@ public:
         size_t limit,
         std::chrono::milliseconds waitDuration) const;
 
+    // Push-style delivery for in-process consumers. Listeners run on the publishing thread after
+    // the event is in history, outside the broker lock, so they may publish or query the broker.
+    ListenerHandle addListener(Listener listener);
+    bool removeListener(ListenerHandle handle);
+
 private:
     ApiEventPage collectPageLocked(
         uint64_t sinceSequence,
@@ -80,6 +116,10 @@ private:
     std::deque<ApiEvent> history_;
     uint64_t nextSequence_ = 1;
     SourceSet knownSources_;
+
+    mutable std::mutex listenersMutex_;
+    std::unordered_map<ListenerHandle, std::shared_ptr<Listener>> listeners_;
+    ListenerHandle nextListenerHandle_ = 1;
 };
 
 #endif
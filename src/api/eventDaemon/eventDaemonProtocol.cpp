@@ -34,7 +34,7 @@ nlohmann::json canonicalEventToJson(const ApiEvent& event)
         { "occurredAtEpochMs", event.occurredAtEpochMs },
         { "source", event.source },
         { "event", event.event },
-        { "payload", event.payload },
+        { "payload", event.payload.get() },
     };
 }
 
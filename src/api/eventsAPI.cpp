@@ -117,7 +117,7 @@ nlohmann::json apiEventToJson(const ApiEvent& event)
         { "occurredAtEpochMs", event.occurredAtEpochMs },
         { "source", event.source },
         { "event", event.event },
-        { "payload", event.payload },
+        { "payload", event.payload.get() },
     };
 }
 
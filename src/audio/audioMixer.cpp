@@ -0,0 +1,389 @@
+/*
+ █████╗ ██╗   ██╗██████╗ ██╗ ██████╗ ███╗   ███╗██╗██╗  ██╗███████╗██████╗     ██████╗██████╗ ██████╗
+██╔══██╗██║   ██║██╔══██╗██║██╔═══██╗████╗ ████║██║╚██╗██╔╝██╔════╝██╔══██╗   ██╔════╝██╔══██╗██╔══██╗
+███████║██║   ██║██║  ██║██║██║   ██║██╔████╔██║██║ ╚███╔╝ █████╗  ██████╔╝   ██║     ██████╔╝██████╔╝
+██╔══██║██║   ██║██║  ██║██║██║   ██║██║╚██╔╝██║██║ ██╔██╗ ██╔══╝  ██╔══██╗   ██║     ██╔═══╝ ██╔═══╝
+██║  ██║╚██████╔╝██████╔╝██║╚██████╔╝██║ ╚═╝ ██║██║██╔╝ ██╗███████╗██║  ██║██╗╚██████╗██║     ██║
+╚═╝  ╚═╝ ╚═════╝ ╚═════╝ ╚═╝ ╚═════╝ ╚═╝     ╚═╝╚═╝╚═╝  ╚═╝╚══════╝╚═╝  ╚═╝╚═╝ ╚═════╝╚═╝     ╚═╝
+*/
+
+/*
+MIT License
+
+Copyright (c) 2026 A-McD Technology LLC
+*/
+
+#include "audioMixer.h"
+#ifndef LOGGER_H
+#include <logger.h>
+#endif
+
+#include <algorithm>
+#include <bit>
+
+const char* audioSourceName(AudioSource source)
+{
+    switch (source) {
+    case AudioSource::SPEECH:
+        return "speech";
+    case AudioSource::ALARM:
+        return "alarm";
+    case AudioSource::UI:
+        return "ui";
+    default:
+        return "unknown";
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+SpscSampleRing::SpscSampleRing(size_t capacity)
+    : buffer_(std::bit_ceil(std::max<size_t>(capacity, 2)))
+    , mask_(buffer_.size() - 1)
+{
+}
+
+size_t SpscSampleRing::write(std::span<const float> samples)
+{
+    const size_t head = head_.load(std::memory_order_relaxed);
+    const size_t tail = tail_.load(std::memory_order_acquire);
+    const size_t count = std::min(samples.size(), buffer_.size() - (head - tail));
+    const size_t start = head & mask_;
+    const size_t firstPart = std::min(count, buffer_.size() - start);
+    std::copy_n(samples.begin(), firstPart, buffer_.begin() + start);
+    std::copy_n(samples.begin() + firstPart, count - firstPart, buffer_.begin());
+    head_.store(head + count, std::memory_order_release);
+    return count;
+}
+
+size_t SpscSampleRing::read(std::span<float> out)
+{
+    const size_t tail = tail_.load(std::memory_order_relaxed);
+    const size_t head = head_.load(std::memory_order_acquire);
+    const size_t count = std::min(out.size(), head - tail);
+    const size_t start = tail & mask_;
+    const size_t firstPart = std::min(count, buffer_.size() - start);
+    std::copy_n(buffer_.begin() + start, firstPart, out.begin());
+    std::copy_n(buffer_.begin(), count - firstPart, out.begin() + firstPart);
+    tail_.store(tail + count, std::memory_order_release);
+    return count;
+}
+
+size_t SpscSampleRing::readAvailable() const
+{
+    return head_.load(std::memory_order_acquire) - tail_.load(std::memory_order_acquire);
+}
+
+size_t SpscSampleRing::writeAvailable() const
+{
+    return buffer_.size() - readAvailable();
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+AudioVoice::AudioVoice(AudioSource source, float gain, size_t capacityFrames, AudioClip clip, Clock::time_point requestedAt)
+    : source_(source)
+    , gain_(gain)
+    , clip_(std::move(clip))
+    , openedAt_(requestedAt)
+{
+    if (!clip_) {
+        ring_ = std::make_unique<SpscSampleRing>(capacityFrames * AudioMixer::CHANNELS);
+    }
+}
+
+size_t AudioVoice::write(std::span<const float> interleavedStereo)
+{
+    if (!ring_ || cancelled()) {
+        return 0;
+    }
+    // Only whole frames, so the render side never sees L and R out of step.
+    const size_t writable = std::min(interleavedStereo.size(), ring_->writeAvailable()) & ~size_t { 1 };
+    return ring_->write(interleavedStereo.first(writable)) / AudioMixer::CHANNELS;
+}
+
+bool AudioVoice::writeAll(std::span<const float> interleavedStereo, std::chrono::milliseconds stallTimeout)
+{
+    auto lastProgress = Clock::now();
+    while (!interleavedStereo.empty()) {
+        if (cancelled() || done()) {
+            return false;
+        }
+        const size_t frames = write(interleavedStereo);
+        if (frames > 0) {
+            interleavedStereo = interleavedStereo.subspan(frames * AudioMixer::CHANNELS);
+            lastProgress = Clock::now();
+            continue;
+        }
+        if (Clock::now() - lastProgress > stallTimeout) {
+            CubeLog::warning(std::string("AudioVoice: output stalled, dropping ") + audioSourceName(source_) + " voice");
+            cancel();
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    return true;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+AudioMixer::AudioMixer()
+{
+    for (auto& gain : sourceGains_) {
+        gain.store(1.0f, std::memory_order_relaxed);
+    }
+    auto& registry = Metrics::MetricsRegistry::instance();
+    for (size_t i = 0; i < static_cast<size_t>(AudioSource::COUNT); ++i) {
+        const Metrics::Labels labels = { { "source", audioSourceName(static_cast<AudioSource>(i)) } };
+        underrunCounters_[i] = registry.counter("audio_underruns_total", "Render callbacks in which a started voice ran out of audio", labels);
+        timeToFirstAudio_[i] = registry.histogram("audio_time_to_first_audio_us", "Time from opening a voice to its first rendered frame", labels);
+    }
+    droppedCounter_ = registry.counter("audio_voices_dropped_total", "Voices rejected because every mixer slot was busy");
+}
+
+AudioMixer& AudioMixer::instance()
+{
+    static AudioMixer mixer;
+    return mixer;
+}
+
+std::shared_ptr<AudioVoice> AudioMixer::openVoice(AudioSource source, float gain, size_t capacityFrames, AudioVoice::Clock::time_point requestedAt)
+{
+    return attach(std::shared_ptr<AudioVoice>(new AudioVoice(source, gain, capacityFrames, nullptr, requestedAt)));
+}
+
+std::shared_ptr<AudioVoice> AudioMixer::playClip(AudioSource source, AudioClip clip, float gain)
+{
+    if (!clip || clip->empty()) {
+        return nullptr;
+    }
+    auto voice = attach(std::shared_ptr<AudioVoice>(new AudioVoice(source, gain, 0, std::move(clip), AudioVoice::Clock::now())));
+    if (voice) {
+        voice->finish();
+    }
+    return voice;
+}
+
+std::shared_ptr<AudioVoice> AudioMixer::attach(std::shared_ptr<AudioVoice> voice)
+{
+    std::lock_guard<std::mutex> lock(controlMutex_);
+    reapLocked();
+    for (size_t slot = 0; slot < MAX_VOICES; ++slot) {
+        if (!owners_[slot]) {
+            owners_[slot] = voice;
+            slots_[slot].store(voice.get(), std::memory_order_release);
+            return voice;
+        }
+    }
+    voicesDropped_.fetch_add(1, std::memory_order_relaxed);
+    droppedCounter_->increment();
+    CubeLog::warning(std::string("AudioMixer: no free voice slot for ") + audioSourceName(voice->source()));
+    return nullptr;
+}
+
+// A slot is only reclaimed after the render thread has cleared it, so the render thread never
+// dereferences a voice that has been freed.
+void AudioMixer::reapLocked()
+{
+    for (size_t slot = 0; slot < MAX_VOICES; ++slot) {
+        if (owners_[slot] && slots_[slot].load(std::memory_order_acquire) == nullptr) {
+            owners_[slot].reset();
+        }
+    }
+}
+
+void AudioMixer::retire(size_t slot, AudioVoice* voice)
+{
+    slots_[slot].store(nullptr, std::memory_order_release);
+    voice->retired_.store(true, std::memory_order_release);
+}
+
+void AudioMixer::setSourceGain(AudioSource source, float gain)
+{
+    sourceGains_[static_cast<size_t>(source)].store(std::clamp(gain, 0.0f, 1.0f), std::memory_order_relaxed);
+}
+
+float AudioMixer::sourceGain(AudioSource source) const
+{
+    return sourceGains_[static_cast<size_t>(source)].load(std::memory_order_relaxed);
+}
+
+void AudioMixer::stopSource(AudioSource source)
+{
+    std::lock_guard<std::mutex> lock(controlMutex_);
+    for (const auto& owner : owners_) {
+        if (owner && owner->source() == source) {
+            owner->cancel();
+        }
+    }
+}
+
+void AudioMixer::render(double* out, unsigned int frames)
+{
+    const size_t wanted = static_cast<size_t>(frames) * CHANNELS;
+    renderedFrames_.fetch_add(frames, std::memory_order_relaxed);
+
+    for (size_t slot = 0; slot < MAX_VOICES; ++slot) {
+        AudioVoice* voice = slots_[slot].load(std::memory_order_acquire);
+        if (!voice) {
+            continue;
+        }
+        if (voice->cancelled()) {
+            retire(slot, voice);
+            continue;
+        }
+        const auto sourceIndex = static_cast<size_t>(voice->source_);
+        const float gain = voice->gain_.load(std::memory_order_relaxed) * sourceGains_[sourceIndex].load(std::memory_order_relaxed);
+
+        size_t produced = 0;
+        if (voice->clip_) {
+            const auto& clip = *voice->clip_;
+            produced = std::min(wanted, clip.size() - voice->clipPos_);
+            const float* samples = clip.data() + voice->clipPos_;
+            for (size_t i = 0; i < produced; ++i) {
+                out[i] += samples[i] * gain;
+            }
+            voice->clipPos_ += produced;
+        } else {
+            while (produced < wanted) {
+                const size_t chunk = std::min(SCRATCH_SAMPLES, wanted - produced);
+                const size_t got = voice->ring_->read(std::span<float>(scratch_.data(), chunk));
+                for (size_t i = 0; i < got; ++i) {
+                    out[produced + i] += scratch_[i] * gain;
+                }
+                produced += got;
+                if (got < chunk) {
+                    break;
+                }
+            }
+        }
+
+        if (produced > 0 && !voice->started_.load(std::memory_order_relaxed)) {
+            voice->started_.store(true, std::memory_order_release);
+            voicesStarted_.fetch_add(1, std::memory_order_relaxed);
+            const auto ttfa = std::chrono::duration_cast<std::chrono::microseconds>(AudioVoice::Clock::now() - voice->openedAt_).count();
+            lastTimeToFirstAudioUs_.store(ttfa, std::memory_order_relaxed);
+            timeToFirstAudio_[sourceIndex]->record(static_cast<uint64_t>(std::max<int64_t>(ttfa, 0)));
+        }
+        if (produced < wanted) {
+            if (voice->clip_) {
+                retire(slot, voice);
+            } else if (voice->finished_.load(std::memory_order_acquire) && voice->ring_->readAvailable() == 0) {
+                retire(slot, voice);
+            } else if (voice->started_.load(std::memory_order_relaxed)) {
+                underruns_[sourceIndex].fetch_add(1, std::memory_order_relaxed);
+                underrunCounters_[sourceIndex]->increment();
+            }
+        }
+    }
+
+    for (size_t i = 0; i < wanted; ++i) {
+        out[i] = std::clamp(out[i], -1.0, 1.0);
+    }
+}
+
+AudioMixer::Stats AudioMixer::stats() const
+{
+    Stats stats;
+    stats.renderedFrames = renderedFrames_.load(std::memory_order_relaxed);
+    stats.voicesStarted = voicesStarted_.load(std::memory_order_relaxed);
+    stats.voicesDropped = voicesDropped_.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < stats.underruns.size(); ++i) {
+        stats.underruns[i] = underruns_[i].load(std::memory_order_relaxed);
+    }
+    stats.lastTimeToFirstAudioUs = lastTimeToFirstAudioUs_.load(std::memory_order_relaxed);
+    return stats;
+}
+
+size_t AudioMixer::activeVoices() const
+{
+    size_t count = 0;
+    for (const auto& slot : slots_) {
+        if (slot.load(std::memory_order_relaxed)) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+StereoResampler::StereoResampler(unsigned int sourceRate, unsigned int channels)
+    : step_(static_cast<double>(std::max(sourceRate, 1u)) / static_cast<double>(AudioMixer::SAMPLE_RATE))
+    , channels_(std::max(channels, 1u))
+{
+}
+
+void StereoResampler::push(std::span<const float> interleaved, float gain, std::vector<float>& out)
+{
+    const size_t frames = interleaved.size() / channels_;
+    out.reserve(out.size() + static_cast<size_t>(static_cast<double>(frames) / step_ + 2) * AudioMixer::CHANNELS);
+    for (size_t frame = 0; frame < frames; ++frame) {
+        const float left = interleaved[frame * channels_];
+        const float right = channels_ == 1 ? left : interleaved[frame * channels_ + 1];
+        if (!havePrevious_) {
+            previous_ = { left, right };
+            havePrevious_ = true;
+            continue;
+        }
+        while (phase_ < 1.0) {
+            const auto t = static_cast<float>(phase_);
+            out.push_back((previous_[0] + (left - previous_[0]) * t) * gain);
+            out.push_back((previous_[1] + (right - previous_[1]) * t) * gain);
+            phase_ += step_;
+        }
+        phase_ -= 1.0;
+        previous_ = { left, right };
+    }
+}
+
+void StereoResampler::flush(float gain, std::vector<float>& out)
+{
+    if (havePrevious_ && phase_ < 1.0) {
+        out.push_back(previous_[0] * gain);
+        out.push_back(previous_[1] * gain);
+    }
+    havePrevious_ = false;
+    phase_ = 0.0;
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+NullAudioClock::NullAudioClock(RenderFunction render, unsigned int bufferFrames)
+    : render_(std::move(render))
+    , bufferFrames_(std::max(bufferFrames, 1u))
+{
+}
+
+NullAudioClock::~NullAudioClock()
+{
+    stop();
+}
+
+void NullAudioClock::start()
+{
+    if (thread_.joinable()) {
+        return;
+    }
+    thread_ = std::jthread([this](std::stop_token st) {
+        std::vector<double> buffer(static_cast<size_t>(bufferFrames_) * AudioMixer::CHANNELS);
+        const auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+            std::chrono::duration<double>(static_cast<double>(bufferFrames_) / AudioMixer::SAMPLE_RATE));
+        auto next = std::chrono::steady_clock::now();
+        while (!st.stop_requested()) {
+            std::fill(buffer.begin(), buffer.end(), 0.0);
+            render_(buffer.data(), bufferFrames_);
+            next += period;
+            std::this_thread::sleep_until(next);
+        }
+    });
+}
+
+void NullAudioClock::stop()
+{
+    if (thread_.joinable()) {
+        thread_.request_stop();
+        thread_.join();
+    }
+    thread_ = std::jthread();
+}
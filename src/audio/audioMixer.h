@@ -0,0 +1,217 @@
+/*
+ █████╗ ██╗   ██╗██████╗ ██╗ ██████╗ ███╗   ███╗██╗██╗  ██╗███████╗██████╗    ██╗  ██╗
+██╔══██╗██║   ██║██╔══██╗██║██╔═══██╗████╗ ████║██║╚██╗██╔╝██╔════╝██╔══██╗   ██║  ██║
+███████║██║   ██║██║  ██║██║██║   ██║██╔████╔██║██║ ╚███╔╝ █████╗  ██████╔╝   ███████║
+██╔══██║██║   ██║██║  ██║██║██║   ██║██║╚██╔╝██║██║ ██╔██╗ ██╔══╝  ██╔══██╗   ██╔══██║
+██║  ██║╚██████╔╝██████╔╝██║╚██████╔╝██║ ╚═╝ ██║██║██╔╝ ██╗███████╗██║  ██║██╗██║  ██║
+╚═╝  ╚═╝ ╚═════╝ ╚═════╝ ╚═╝ ╚═════╝ ╚═╝     ╚═╝╚═╝╚═╝  ╚═╝╚══════╝╚═╝  ╚═╝╚═╝╚═╝  ╚═╝
+*/
+
+/*
+MIT License
+
+Copyright (c) 2026 A-McD Technology LLC
+*/
+
+#pragma once
+#ifndef AUDIOMIXER_H
+#define AUDIOMIXER_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <stop_token>
+#include <thread>
+#include <vector>
+
+#include "../telemetry/metrics.h"
+
+/*
+
+The mixer is the only thing the output stream callback talks to. Producers (speech synthesis, alarm
+playback, UI sounds) open a voice on a source, push float stereo 48 kHz frames into it and finish it;
+the callback pulls from every live voice, applies voice gain * source gain and sums.
+
+Nothing on the render path takes a lock or allocates: each streamed voice owns a single-producer /
+single-consumer ring, clip voices read a shared, immutable decoded buffer, and voices are retired by
+the render thread clearing their slot. The control side (openVoice) only reclaims a voice after its slot
+has been cleared, so the render thread never sees a freed voice.
+
+Underruns are counted per source when a voice that has already started playing runs dry before its
+producer called finish(). Time-to-first-audio is measured from the voice's request time (openVoice()
+unless the caller passes an earlier one) to the first rendered frame.
+
+*/
+
+enum class AudioSource : uint8_t {
+    SPEECH,
+    ALARM,
+    UI,
+    COUNT
+};
+
+const char* audioSourceName(AudioSource source);
+
+// Lock-free single-producer / single-consumer ring of float samples. Capacity is rounded up to a power of two.
+class SpscSampleRing {
+public:
+    explicit SpscSampleRing(size_t capacity);
+
+    size_t write(std::span<const float> samples);
+    size_t read(std::span<float> out);
+    size_t readAvailable() const;
+    size_t writeAvailable() const;
+    size_t capacity() const { return buffer_.size(); }
+
+private:
+    std::vector<float> buffer_;
+    size_t mask_ = 0;
+    alignas(64) std::atomic<size_t> head_ { 0 }; // written by the producer
+    alignas(64) std::atomic<size_t> tail_ { 0 }; // written by the consumer
+};
+
+using AudioClip = std::shared_ptr<const std::vector<float>>; // interleaved stereo, 48 kHz
+
+class AudioVoice {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    AudioSource source() const { return source_; }
+    void setGain(float gain) { gain_.store(gain, std::memory_order_relaxed); }
+
+    // Streamed voices only. Non-blocking: returns the number of frames accepted.
+    size_t write(std::span<const float> interleavedStereo);
+    // Waits for ring space while the voice is live. Gives up (and cancels the voice) if nothing has
+    // been consumed for stallTimeout, which means the output stream is not running.
+    bool writeAll(std::span<const float> interleavedStereo, std::chrono::milliseconds stallTimeout = std::chrono::milliseconds(2000));
+    // No more frames will be written; the voice retires once drained.
+    void finish() { finished_.store(true, std::memory_order_release); }
+    void cancel() { cancelled_.store(true, std::memory_order_release); }
+
+    bool cancelled() const { return cancelled_.load(std::memory_order_acquire); }
+    bool started() const { return started_.load(std::memory_order_acquire); }
+    bool done() const { return retired_.load(std::memory_order_acquire); }
+
+private:
+    friend class AudioMixer;
+    AudioVoice(AudioSource source, float gain, size_t capacityFrames, AudioClip clip, Clock::time_point requestedAt);
+
+    AudioSource source_;
+    std::atomic<float> gain_;
+    std::unique_ptr<SpscSampleRing> ring_;
+    AudioClip clip_;
+    size_t clipPos_ = 0; // render thread only
+    Clock::time_point openedAt_;
+    std::atomic<bool> finished_ { false };
+    std::atomic<bool> cancelled_ { false };
+    std::atomic<bool> started_ { false };
+    std::atomic<bool> retired_ { false };
+};
+
+class AudioMixer {
+public:
+    static constexpr unsigned int SAMPLE_RATE = 48000;
+    static constexpr unsigned int CHANNELS = 2;
+    static constexpr size_t MAX_VOICES = 16;
+    static constexpr size_t DEFAULT_STREAM_CAPACITY_FRAMES = SAMPLE_RATE; // one second of lookahead
+
+    struct Stats {
+        uint64_t renderedFrames = 0;
+        uint64_t voicesStarted = 0;
+        uint64_t voicesDropped = 0;
+        std::array<uint64_t, static_cast<size_t>(AudioSource::COUNT)> underruns {};
+        int64_t lastTimeToFirstAudioUs = -1;
+    };
+
+    AudioMixer();
+    static AudioMixer& instance();
+
+    // Returns nullptr when every voice slot is busy. requestedAt is where time-to-first-audio starts; a
+    // producer that queues work before opening its voice passes the time the work was requested.
+    std::shared_ptr<AudioVoice> openVoice(AudioSource source, float gain = 1.0f, size_t capacityFrames = DEFAULT_STREAM_CAPACITY_FRAMES,
+        AudioVoice::Clock::time_point requestedAt = AudioVoice::Clock::now());
+    std::shared_ptr<AudioVoice> playClip(AudioSource source, AudioClip clip, float gain = 1.0f);
+
+    void setSourceGain(AudioSource source, float gain);
+    float sourceGain(AudioSource source) const;
+    void stopSource(AudioSource source);
+
+    // Render thread. Adds the mix of every live voice into `out` (interleaved stereo) and clamps to [-1, 1].
+    void render(double* out, unsigned int frames);
+
+    Stats stats() const;
+    size_t activeVoices() const;
+
+private:
+    std::shared_ptr<AudioVoice> attach(std::shared_ptr<AudioVoice> voice);
+    void reapLocked();
+    void retire(size_t slot, AudioVoice* voice);
+
+    static constexpr size_t SCRATCH_SAMPLES = 4096;
+
+    // Control side: owners of the voices currently referenced from slots_.
+    mutable std::mutex controlMutex_;
+    std::array<std::shared_ptr<AudioVoice>, MAX_VOICES> owners_;
+
+    // Render side.
+    std::array<std::atomic<AudioVoice*>, MAX_VOICES> slots_ {};
+    std::array<std::atomic<float>, static_cast<size_t>(AudioSource::COUNT)> sourceGains_;
+    std::array<float, SCRATCH_SAMPLES> scratch_ {};
+
+    std::atomic<uint64_t> renderedFrames_ { 0 };
+    std::atomic<uint64_t> voicesStarted_ { 0 };
+    std::atomic<uint64_t> voicesDropped_ { 0 };
+    std::array<std::atomic<uint64_t>, static_cast<size_t>(AudioSource::COUNT)> underruns_ {};
+    std::atomic<int64_t> lastTimeToFirstAudioUs_ { -1 };
+
+    std::array<std::shared_ptr<Metrics::Counter>, static_cast<size_t>(AudioSource::COUNT)> underrunCounters_;
+    std::array<std::shared_ptr<Metrics::Histogram>, static_cast<size_t>(AudioSource::COUNT)> timeToFirstAudio_;
+    std::shared_ptr<Metrics::Counter> droppedCounter_;
+};
+
+// Streaming linear-interpolation resampler into the mixer format (stereo, SAMPLE_RATE). Phase is kept
+// across push() calls, so chunked input resamples exactly like the same samples delivered at once.
+class StereoResampler {
+public:
+    StereoResampler(unsigned int sourceRate, unsigned int channels);
+
+    // Appends interleaved stereo frames for `interleaved` (which has `channels` samples per frame) to out.
+    void push(std::span<const float> interleaved, float gain, std::vector<float>& out);
+    // Emits the final input frame.
+    void flush(float gain, std::vector<float>& out);
+
+private:
+    double step_;
+    unsigned int channels_;
+    std::array<float, 2> previous_ {};
+    bool havePrevious_ = false;
+    double phase_ = 0.0;
+};
+
+// Stand-in for an audio device: calls a render function with fixed-size buffers at real-time pace.
+// Used when AUDIO_OUTPUT_BACKEND=null and by tests to measure time-to-first-audio and underruns
+// without hardware.
+class NullAudioClock {
+public:
+    using RenderFunction = std::function<void(double* out, unsigned int frames)>;
+
+    NullAudioClock(RenderFunction render, unsigned int bufferFrames = 256);
+    ~NullAudioClock();
+
+    void start();
+    void stop();
+    bool running() const { return thread_.joinable(); }
+
+private:
+    RenderFunction render_;
+    unsigned int bufferFrames_;
+    std::jthread thread_;
+};
+
+#endif // AUDIOMIXER_H
@@ -42,18 +42,25 @@ SOFTWARE.
 #include "dr_wav.h"
 #include <algorithm>
 #include <cctype>
+#include <condition_variable>
 #include <cstring>
+#include <deque>
 #include <filesystem>
 #include <mutex>
 #include <nlohmann/json.hpp>
+#include <optional>
 #include <thread>
+#include <unordered_map>
 
 /*
 NOTES:
 Because of how the HDMI output works, we will have to have a constant output and modulate the code to change the sound.
 
-There will need to be a class (or something) that can take in sounds (ether buffers or file paths) and play them.
-This class will need to be able to play multiple sounds at once.
+The stream is opened once and never closed while the process runs. Everything audible goes through
+AudioMixer: files and PCM buffers are decoded once into clips (files are cached, so a repeating alarm
+does not decode again), and synthesized speech is written into a voice as the response arrives. With
+REMOTE_TTS_STREAMING=true the server is asked for raw PCM, so playback starts with the first chunk
+instead of after the whole utterance.
 */
 
 // TODO: Local TTS using Piper
@@ -61,23 +68,88 @@ This class will need to be able to play multiple sounds at once.
 UserData AudioOutput::userData = { 0.0, 0.0, false };
 bool AudioOutput::audioStarted = false;
 std::unique_ptr<RtAudio> AudioOutput::dac = nullptr;
+std::unique_ptr<NullAudioClock> AudioOutput::nullClock = nullptr;
 
 namespace {
 
-// Decoded audio clip ready to be mixed into the RtAudio output stream.
-// Samples are float64, stereo interleaved (L, R, L, R, …), 48 kHz.
-// Volume is pre-applied during decoding so the callback only needs to add.
-struct PlaybackClip {
-    std::vector<double> samples;
-    size_t pos = 0; // advances by 2 per frame (L + R)
-};
+constexpr size_t CLIP_CACHE_CAPACITY = 16;
+
+// Serial background lane for work that must not run on the caller's thread (decoding, synthesis
+// requests). Replaces a detached thread per call.
+class AudioJobLane {
+public:
+    using Job = std::function<void(std::stop_token)>;
+
+    AudioJobLane()
+    {
+        // Make sure the mixer outlives the lane's thread during static destruction.
+        AudioMixer::instance();
+        thread = std::jthread([this](std::stop_token st) { run(st); });
+    }
+
+    void post(Job job)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            jobs.push_back(std::move(job));
+        }
+        cv.notify_one();
+    }
+
+private:
+    void run(std::stop_token st)
+    {
+        while (true) {
+            Job job;
+            {
+                std::unique_lock<std::mutex> lock(mutex);
+                if (!cv.wait(lock, st, [this]() { return !jobs.empty(); })) {
+                    return;
+                }
+                job = std::move(jobs.front());
+                jobs.pop_front();
+            }
+            try {
+                job(st);
+            } catch (const std::exception& e) {
+                CubeLog::error(std::string("AudioOutput: background job exception: ") + e.what());
+            } catch (...) {
+                CubeLog::error("AudioOutput: background job unknown exception");
+            }
+        }
+    }
 
-struct AudioMixer {
-    std::vector<PlaybackClip> clips;
     std::mutex mutex;
+    std::condition_variable_any cv;
+    std::deque<Job> jobs;
+    std::jthread thread;
 };
 
-static AudioMixer g_mixer;
+// Speech gets its own lane so a slow synthesis request never delays a UI sound or alarm.
+AudioJobLane& speechLane()
+{
+    static AudioJobLane lane;
+    return lane;
+}
+
+// Bumped by stopSource(SPEECH). Utterances still waiting on the speech lane have no voice for the mixer
+// to cancel yet, so they compare against this before and after opening one.
+std::atomic<uint64_t>& speechStopGeneration()
+{
+    static std::atomic<uint64_t> generation { 0 };
+    return generation;
+}
+
+AudioJobLane& decodeLane()
+{
+    static AudioJobLane lane;
+    return lane;
+}
+
+float volumeToGain(float volume)
+{
+    return std::clamp(volume / 100.0f, 0.0f, 1.0f);
+}
 
 std::string trimTrailingSlash(std::string url)
 {
@@ -167,13 +239,337 @@ bool looksLikeMockAudio(const std::vector<unsigned char>& bytes)
     return std::memcmp(bytes.data(), prefix, sizeof(prefix) - 1) == 0;
 }
 
+AudioClip decodeFileClip(const std::filesystem::path& path)
+{
+    drwav wav;
+    if (!drwav_init_file(&wav, path.string().c_str(), nullptr)) {
+        CubeLog::error("AudioOutput: failed to open audio file: " + path.string());
+        return nullptr;
+    }
+
+    const drwav_uint64 totalFrames = wav.totalPCMFrameCount;
+    const unsigned int channels = wav.channels;
+    const unsigned int srcRate = wav.sampleRate;
+
+    std::vector<float> raw(static_cast<size_t>(totalFrames) * channels);
+    const drwav_uint64 framesRead = drwav_read_pcm_frames_f32(&wav, totalFrames, raw.data());
+    drwav_uninit(&wav);
+
+    if (framesRead == 0) {
+        CubeLog::error("AudioOutput: no frames read from: " + path.string());
+        return nullptr;
+    }
+
+    // Volume is applied as voice gain at playback time so one decoded clip serves every volume.
+    auto samples = std::make_shared<std::vector<float>>();
+    StereoResampler resampler(srcRate, channels);
+    resampler.push(std::span<const float>(raw.data(), static_cast<size_t>(framesRead) * channels), 1.0f, *samples);
+    resampler.flush(1.0f, *samples);
+    return samples;
+}
+
+struct CachedClip {
+    std::filesystem::file_time_type modified;
+    AudioClip clip;
+    uint64_t lastUsed = 0;
+};
+
+std::mutex clipCacheMutex;
+std::unordered_map<std::string, CachedClip> clipCache;
+uint64_t clipCacheClock = 0;
+
+AudioClip findCachedClip(const std::filesystem::path& path)
+{
+    std::error_code ec;
+    const auto modified = std::filesystem::last_write_time(path, ec);
+    if (ec) {
+        return nullptr;
+    }
+    std::lock_guard<std::mutex> lock(clipCacheMutex);
+    auto it = clipCache.find(path.string());
+    if (it == clipCache.end() || it->second.modified != modified) {
+        return nullptr;
+    }
+    it->second.lastUsed = ++clipCacheClock;
+    return it->second.clip;
+}
+
+AudioClip loadFileClip(const std::filesystem::path& path)
+{
+    if (auto cached = findCachedClip(path)) {
+        return cached;
+    }
+    auto clip = decodeFileClip(path);
+    if (!clip) {
+        return nullptr;
+    }
+    std::error_code ec;
+    const auto modified = std::filesystem::last_write_time(path, ec);
+    if (ec) {
+        return clip;
+    }
+    std::lock_guard<std::mutex> lock(clipCacheMutex);
+    if (clipCache.size() >= CLIP_CACHE_CAPACITY && !clipCache.contains(path.string())) {
+        auto oldest = std::min_element(clipCache.begin(), clipCache.end(), [](const auto& a, const auto& b) {
+            return a.second.lastUsed < b.second.lastUsed;
+        });
+        clipCache.erase(oldest);
+    }
+    clipCache[path.string()] = { modified, clip, ++clipCacheClock };
+    return clip;
+}
+
+// Feeds a synthesis response into a voice as it arrives. The server streams raw 16-bit mono PCM
+// when asked for responseMode "stream"; servers that only know the JSON response (base64 audioData)
+// say so with Content-Type application/json and are handled once the body is complete. Only a
+// response without a recognised Content-Type is sniffed, since raw PCM can start with any byte.
+class SpeechStreamDecoder {
+public:
+    SpeechStreamDecoder(unsigned int sampleRateHz, std::shared_ptr<AudioVoice> voice)
+        : resampler(sampleRateHz, 1)
+        , voice(std::move(voice))
+    {
+    }
+
+    // Call from the response handler, before any body bytes arrive.
+    void setContentType(const std::string& contentType)
+    {
+        std::string mediaType = contentType.substr(0, contentType.find(';'));
+        std::erase(mediaType, ' ');
+        std::transform(mediaType.begin(), mediaType.end(), mediaType.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        if (mediaType == "application/json" || mediaType.ends_with("+json")) {
+            mode = Mode::JSON;
+        } else if (mediaType == "application/octet-stream" || mediaType.starts_with("audio/")) {
+            mode = Mode::PCM;
+        }
+    }
+
+    // Returns false to abort the transfer (voice cancelled or output stalled).
+    bool feed(const char* data, size_t length)
+    {
+        switch (mode) {
+        case Mode::UNKNOWN:
+            pending.append(data, length);
+            return classify(false);
+        case Mode::PCM:
+            return pushPcm(reinterpret_cast<const unsigned char*>(data), length);
+        case Mode::JSON:
+            pending.append(data, length);
+            return true;
+        case Mode::MOCK:
+            return true;
+        }
+        return true;
+    }
+
+    void finish()
+    {
+        if (mode == Mode::UNKNOWN) {
+            classify(true);
+        }
+        if (mode == Mode::JSON) {
+            finishJson();
+        } else if (mode == Mode::MOCK) {
+            CubeLog::info("AudioOutput: mock synthesis audio received; skipping playback");
+        }
+        if (mode == Mode::PCM || mode == Mode::JSON) {
+            out.clear();
+            resampler.flush(1.0f, out);
+            voice->writeAll(out);
+        }
+    }
+
+    bool receivedAudio() const { return bytesOfPcm > 0; }
+    const std::string& bufferedBody() const { return pending; }
+
+private:
+    enum class Mode {
+        UNKNOWN,
+        PCM,
+        JSON,
+        MOCK
+    };
+
+    bool classify(bool final)
+    {
+        static constexpr std::string_view mockPrefix = "MOCK_AUDIO:";
+        const auto firstNonSpace = pending.find_first_not_of(" \t\r\n");
+        if (firstNonSpace != std::string::npos && pending[firstNonSpace] == '{') {
+            mode = Mode::JSON;
+            return true;
+        }
+        if (pending.starts_with(mockPrefix)) {
+            mode = Mode::MOCK;
+            return true;
+        }
+        const bool couldBeMock = mockPrefix.starts_with(pending);
+        if (!final && (firstNonSpace == std::string::npos || couldBeMock)) {
+            return true;
+        }
+        mode = Mode::PCM;
+        const std::string bytes = std::move(pending);
+        pending.clear();
+        return pushPcm(reinterpret_cast<const unsigned char*>(bytes.data()), bytes.size());
+    }
+
+    void finishJson()
+    {
+        nlohmann::json json;
+        try {
+            json = nlohmann::json::parse(pending);
+        } catch (const std::exception& e) {
+            CubeLog::error(std::string("AudioOutput: synthesis response was not valid JSON: ") + e.what());
+            return;
+        }
+        if (!json.contains("audioData") || !json["audioData"].is_string()) {
+            CubeLog::error("AudioOutput: synthesis response did not include audioData");
+            return;
+        }
+        const auto bytes = base64_decode_cube(json["audioData"].get<std::string>());
+        if (bytes.empty()) {
+            CubeLog::warning("AudioOutput: synthesis response returned empty audio");
+            return;
+        }
+        if (looksLikeMockAudio(bytes)) {
+            mode = Mode::MOCK;
+            CubeLog::info("AudioOutput: mock synthesis audio received; skipping playback");
+            return;
+        }
+        if ((bytes.size() % sizeof(int16_t)) != 0) {
+            CubeLog::error("AudioOutput: synthesis audio was not aligned to 16-bit PCM");
+            return;
+        }
+        pushPcm(bytes.data(), bytes.size());
+    }
+
+    bool pushPcm(const unsigned char* bytes, size_t length)
+    {
+        constexpr float scale = 1.0f / 32768.0f;
+        samples.clear();
+        size_t i = 0;
+        if (carry && length > 0) {
+            samples.push_back(static_cast<int16_t>(*carry | (bytes[0] << 8)) * scale);
+            carry.reset();
+            i = 1;
+        }
+        for (; i + 1 < length; i += 2) {
+            samples.push_back(static_cast<int16_t>(bytes[i] | (bytes[i + 1] << 8)) * scale);
+        }
+        if (i < length) {
+            carry = bytes[i];
+        }
+        bytesOfPcm += length;
+        out.clear();
+        resampler.push(samples, 1.0f, out);
+        return voice->writeAll(out);
+    }
+
+    Mode mode = Mode::UNKNOWN;
+    std::string pending;
+    std::optional<unsigned char> carry;
+    StereoResampler resampler;
+    std::vector<float> samples;
+    std::vector<float> out;
+    std::shared_ptr<AudioVoice> voice;
+    size_t bytesOfPcm = 0;
+};
+
+unsigned int configuredTtsSampleRate()
+{
+    try {
+        return static_cast<unsigned int>(std::stoul(Config::get("REMOTE_TTS_PCM_SAMPLE_RATE_HZ", "16000")));
+    } catch (...) {
+        return 16000;
+    }
+}
+
 } // namespace
 
+void synthesizeSpeechInto(const std::string& text, const std::shared_ptr<AudioVoice>& voice, std::stop_token st)
+{
+    const std::string configuredBase = Config::get(
+        "REMOTE_SERVER_BASE_URL",
+        Config::get("REMOTE_TRANSCRIPTION_BASE_URL", "https://api.4thecube.com"));
+    const std::string baseUrl = normalizeHttpBaseUrl(configuredBase);
+    if (baseUrl.empty()) {
+        CubeLog::error("AudioOutput: no remote server base URL configured for speech synthesis");
+        return;
+    }
+
+    httplib::Client client(baseUrl);
+    client.set_read_timeout(30, 0);
+    client.set_write_timeout(30, 0);
+    client.set_connection_timeout(5, 0);
+
+    const auto bearerToken = Config::get("REMOTE_SERVER_BEARER_TOKEN", Config::get("REMOTE_AUTH_KEY", ""));
+    const auto apiKey = Config::get(
+        "REMOTE_SERVER_API_KEY",
+        Config::get("REMOTE_TRANSCRIPTION_API_KEY", Config::get("REMOTE_API_KEY", "")));
+    const auto serialNumber = Config::get("REMOTE_SERVER_SERIAL", Config::get("DEVICE_SERIAL_NUMBER", ""));
+    configureHttpAuth(client, bearerToken, apiKey, serialNumber);
+
+    // Streamed responses need server support, so they are opt-in until every deployment has it.
+    const bool streaming = Config::get("REMOTE_TTS_STREAMING", "false") == "true";
+    const nlohmann::json payload = {
+        { "text", text },
+        { "responseMode", streaming ? "stream" : "json" },
+        { "outputFormat", "pcm" }
+    };
+
+    SpeechStreamDecoder decoder(configuredTtsSampleRate(), voice);
+    httplib::Request req;
+    req.method = "POST";
+    req.path = "/API/audio/synthesize";
+    req.body = payload.dump();
+    req.set_header("Content-Type", "application/json");
+    req.set_header("Accept", "application/octet-stream, application/json");
+    // The decoder treats any non-JSON body as PCM, so an error page must never reach it: the status
+    // is checked before the first body byte and the download is aborted on anything but 200.
+    int status = 0;
+    req.response_handler = [&status, &decoder](const httplib::Response& response) {
+        status = response.status;
+        if (status != 200) {
+            return false;
+        }
+        decoder.setContentType(response.get_header_value("Content-Type"));
+        return true;
+    };
+    req.content_receiver = [&](const char* data, size_t length, uint64_t, uint64_t) {
+        return !st.stop_requested() && decoder.feed(data, length);
+    };
+
+    auto res = client.send(req);
+    if (status != 0 && status != 200) {
+        CubeLog::error("AudioOutput: speech synthesis returned status " + std::to_string(status));
+        return;
+    }
+    if (!res) {
+        if (!voice->cancelled() && !st.stop_requested()) {
+            CubeLog::error("AudioOutput: speech synthesis request failed");
+        }
+        return;
+    }
+    decoder.finish();
+}
+
 AudioOutput::AudioOutput()
 {
     // TODO: load all the audio blobs from the DB.
     // TODO: load all the audio files from the filesystem.
     CubeLog::info("Initializing audio output.");
+    userData.data[0] = 0;
+    userData.data[1] = 0;
+    userData.soundOn = false;
+
+    if (Config::get("AUDIO_OUTPUT_BACKEND", "rtaudio") == "null") {
+        // No device: the mixer is driven at real-time pace so playback, time-to-first-audio and
+        // underrun counters behave as they would with hardware.
+        CubeLog::info("Audio output using the null backend; no device will be opened.");
+        nullClock = std::make_unique<NullAudioClock>([](double* out, unsigned int frames) {
+            saw(out, nullptr, frames, 0.0, 0, &userData);
+        }, bufferFrames);
+        return;
+    }
 
     RtAudio::Api api = RtAudio::RtAudio::LINUX_PULSE;
 
@@ -212,13 +608,10 @@ AudioOutput::AudioOutput()
     if (format & RTAUDIO_FLOAT64)
         formatStr += "FLOAT64 ";
     CubeLog::info("Audio device format: " + formatStr);
-    parameters->nChannels = 2;
+    parameters->nChannels = AudioMixer::CHANNELS;
     parameters->firstChannel = 0;
-    userData.data[0] = 0;
-    userData.data[1] = 0;
-    userData.soundOn = false;
 
-    if (dac->openStream(parameters.get(), NULL, RTAUDIO_FLOAT64, 48000, &bufferFrames, &saw, (void*)&userData)) {
+    if (dac->openStream(parameters.get(), NULL, RTAUDIO_FLOAT64, AudioMixer::SAMPLE_RATE, &bufferFrames, &saw, (void*)&userData)) {
         CubeLog::fatal(dac->getErrorText() + " Exiting.");
         exit(1); // problem with device settings
         // TODO: Need to have a way to recover from this error.
@@ -233,6 +626,16 @@ AudioOutput::~AudioOutput()
 
 void AudioOutput::start()
 {
+    if (nullClock) {
+        nullClock->start();
+        audioStarted = true;
+        CubeLog::info("Null audio clock started.");
+        return;
+    }
+    if (dac->isStreamRunning()) {
+        audioStarted = true;
+        return;
+    }
     if (dac->startStream()) {
         std::cout << dac->getErrorText() << std::endl;
         CubeLog::error(dac->getErrorText());
@@ -244,7 +647,9 @@ void AudioOutput::start()
 
 void AudioOutput::stop()
 {
-    if (dac->isStreamRunning()) {
+    if (nullClock) {
+        nullClock->stop();
+    } else if (dac && dac->isStreamRunning()) {
         dac->stopStream();
         CubeLog::info("Audio stream stopped.");
     }
@@ -273,107 +678,58 @@ void AudioOutput::setSound(bool soundOn)
     }
 }
 
-bool AudioOutput::playFileAsync(const std::filesystem::path& filePath, float volume)
+void AudioOutput::setSourceGain(AudioSource source, float gain)
 {
-    const auto resolvedPath = resolveAssetPath(filePath);
-    std::thread([resolvedPath, volume]() {
-        try {
-            drwav wav;
-            if (!drwav_init_file(&wav, resolvedPath.string().c_str(), nullptr)) {
-                CubeLog::error("AudioOutput: failed to open audio file: " + resolvedPath.string());
-                return;
-            }
-
-            const drwav_uint64 totalFrames = wav.totalPCMFrameCount;
-            const unsigned int channels = wav.channels;
-            const unsigned int srcRate = wav.sampleRate;
-
-            std::vector<float> raw(static_cast<size_t>(totalFrames) * channels);
-            const drwav_uint64 framesRead = drwav_read_pcm_frames_f32(&wav, totalFrames, raw.data());
-            drwav_uninit(&wav);
+    AudioMixer::instance().setSourceGain(source, gain);
+}
 
-            if (framesRead == 0) {
-                CubeLog::error("AudioOutput: no frames read from: " + resolvedPath.string());
-                return;
-            }
+void AudioOutput::stopSource(AudioSource source)
+{
+    if (source == AudioSource::SPEECH) {
+        speechStopGeneration().fetch_add(1, std::memory_order_acq_rel);
+    }
+    AudioMixer::instance().stopSource(source);
+}
 
-            // Resample to float64 stereo 48 kHz using linear interpolation
-            constexpr unsigned int dstRate = 48000;
-            const double ratio = static_cast<double>(srcRate) / static_cast<double>(dstRate);
-            const size_t outFrames = static_cast<size_t>(static_cast<double>(framesRead) / ratio) + 1;
-            const double vol = std::clamp(static_cast<double>(volume) / 100.0, 0.0, 1.0);
-
-            std::vector<double> samples;
-            samples.reserve(outFrames * 2);
-
-            for (size_t i = 0; i < outFrames; i++) {
-                const double srcPos = static_cast<double>(i) * ratio;
-                const size_t f0 = static_cast<size_t>(srcPos);
-                const size_t f1 = std::min(f0 + 1, static_cast<size_t>(framesRead) - 1);
-                const double frac = srcPos - static_cast<double>(f0);
-
-                double L, R;
-                if (channels == 1) {
-                    const double s = raw[f0] + (raw[f1] - raw[f0]) * frac;
-                    L = R = s * vol;
-                } else {
-                    L = (raw[f0 * channels + 0] + (raw[f1 * channels + 0] - raw[f0 * channels + 0]) * frac) * vol;
-                    R = (raw[f0 * channels + 1] + (raw[f1 * channels + 1] - raw[f0 * channels + 1]) * frac) * vol;
-                }
-                samples.push_back(L);
-                samples.push_back(R);
-            }
+AudioMixer::Stats AudioOutput::getStats()
+{
+    return AudioMixer::instance().stats();
+}
 
-            std::lock_guard<std::mutex> lock(g_mixer.mutex);
-            g_mixer.clips.push_back({ std::move(samples), 0 });
-        } catch (const std::exception& e) {
-            CubeLog::error(std::string("AudioOutput: playFileAsync exception: ") + e.what());
-        } catch (...) {
-            CubeLog::error("AudioOutput: playFileAsync unknown exception");
+bool AudioOutput::playFileAsync(const std::filesystem::path& filePath, float volume, AudioSource source)
+{
+    const auto resolvedPath = resolveAssetPath(filePath);
+    const float gain = volumeToGain(volume);
+    // Cached clips (repeating alarms, UI sounds) start on the caller's thread without a hop.
+    if (auto clip = findCachedClip(resolvedPath)) {
+        return AudioMixer::instance().playClip(source, std::move(clip), gain) != nullptr;
+    }
+    decodeLane().post([resolvedPath, gain, source](std::stop_token) {
+        if (auto clip = loadFileClip(resolvedPath)) {
+            AudioMixer::instance().playClip(source, std::move(clip), gain);
         }
-    }).detach();
+    });
     return true;
 }
 
-bool AudioOutput::playPcm16MonoAsync(const std::vector<int16_t>& samples, unsigned int sampleRateHz, float volume)
+bool AudioOutput::playPcm16MonoAsync(const std::vector<int16_t>& samples, unsigned int sampleRateHz, float volume, AudioSource source)
 {
     if (samples.empty() || sampleRateHz == 0) {
         return false;
     }
 
-    std::thread([samples, sampleRateHz, volume]() {
-        try {
-            // Resample int16 mono → float64 stereo 48 kHz with linear interpolation
-            constexpr unsigned int dstRate = 48000;
-            const double ratio = static_cast<double>(sampleRateHz) / static_cast<double>(dstRate);
-            const size_t srcFrames = samples.size();
-            const size_t outFrames = static_cast<size_t>(static_cast<double>(srcFrames) / ratio) + 1;
-            const double vol = std::clamp(static_cast<double>(volume) / 100.0, 0.0, 1.0);
-            constexpr double scale = 1.0 / 32768.0;
-
-            std::vector<double> out;
-            out.reserve(outFrames * 2);
-
-            for (size_t i = 0; i < outFrames; i++) {
-                const double srcPos = static_cast<double>(i) * ratio;
-                const size_t idx0 = static_cast<size_t>(srcPos);
-                const size_t idx1 = std::min(idx0 + 1, srcFrames - 1);
-                const double frac = srcPos - static_cast<double>(idx0);
-                const double val = (static_cast<double>(samples[idx0])
-                                       + (static_cast<double>(samples[idx1]) - static_cast<double>(samples[idx0])) * frac)
-                    * scale * vol;
-                out.push_back(val); // L
-                out.push_back(val); // R (mono → stereo)
-            }
-
-            std::lock_guard<std::mutex> lock(g_mixer.mutex);
-            g_mixer.clips.push_back({ std::move(out), 0 });
-        } catch (const std::exception& e) {
-            CubeLog::error(std::string("AudioOutput: playPcm16MonoAsync exception: ") + e.what());
-        } catch (...) {
-            CubeLog::error("AudioOutput: playPcm16MonoAsync unknown exception");
+    decodeLane().post([samples, sampleRateHz, gain = volumeToGain(volume), source](std::stop_token) {
+        constexpr float scale = 1.0f / 32768.0f;
+        std::vector<float> mono(samples.size());
+        std::transform(samples.begin(), samples.end(), mono.begin(), [](int16_t sample) { return sample * scale; });
+        auto clip = std::make_shared<std::vector<float>>();
+        StereoResampler resampler(sampleRateHz, 1);
+        resampler.push(mono, 1.0f, *clip);
+        resampler.flush(1.0f, *clip);
+        if (!AudioMixer::instance().playClip(source, std::move(clip), gain)) {
+            CubeLog::error("AudioOutput: failed to enqueue PCM playback");
         }
-    }).detach();
+    });
     return true;
 }
 
@@ -383,100 +739,43 @@ bool AudioOutput::speakTextAsync(const std::string& text, float volume)
         return false;
     }
 
-    std::thread([text, volume]() {
-        try {
-            const std::string configuredBase = Config::get(
-                "REMOTE_SERVER_BASE_URL",
-                Config::get("REMOTE_TRANSCRIPTION_BASE_URL", "https://api.4thecube.com"));
-            const std::string baseUrl = normalizeHttpBaseUrl(configuredBase);
-            if (baseUrl.empty()) {
-                CubeLog::error("AudioOutput: no remote server base URL configured for speech synthesis");
-                return;
-            }
-
-            httplib::Client client(baseUrl);
-            client.set_read_timeout(30, 0);
-            client.set_write_timeout(30, 0);
-            client.set_connection_timeout(5, 0);
-
-            const auto bearerToken = Config::get("REMOTE_SERVER_BEARER_TOKEN", Config::get("REMOTE_AUTH_KEY", ""));
-            const auto apiKey = Config::get(
-                "REMOTE_SERVER_API_KEY",
-                Config::get("REMOTE_TRANSCRIPTION_API_KEY", Config::get("REMOTE_API_KEY", "")));
-            const auto serialNumber = Config::get("REMOTE_SERVER_SERIAL", Config::get("DEVICE_SERIAL_NUMBER", ""));
-            configureHttpAuth(client, bearerToken, apiKey, serialNumber);
-
-            const nlohmann::json payload = {
-                { "text", text },
-                { "responseMode", "json" },
-                { "outputFormat", "pcm" }
-            };
-
-            auto res = client.Post("/API/audio/synthesize", payload.dump(), "application/json");
-            if (!res) {
-                CubeLog::error("AudioOutput: speech synthesis request failed");
-                return;
-            }
-            if (res->status != 200) {
-                CubeLog::error("AudioOutput: speech synthesis returned status " + std::to_string(res->status));
-                return;
-            }
-
-            auto json = nlohmann::json::parse(res->body);
-            if (!json.contains("audioData") || !json["audioData"].is_string()) {
-                CubeLog::error("AudioOutput: synthesis response did not include audioData");
-                return;
-            }
-
-            const auto bytes = base64_decode_cube(json["audioData"].get<std::string>());
-            if (bytes.empty()) {
-                CubeLog::warning("AudioOutput: synthesis response returned empty audio");
-                return;
-            }
-            if (looksLikeMockAudio(bytes)) {
-                CubeLog::info("AudioOutput: mock synthesis audio received; skipping playback");
-                return;
-            }
-            if ((bytes.size() % sizeof(int16_t)) != 0) {
-                CubeLog::error("AudioOutput: synthesis audio was not aligned to 16-bit PCM");
-                return;
-            }
-
-            unsigned int sampleRateHz = 16000;
-            try {
-                const auto configured = Config::get("REMOTE_TTS_PCM_SAMPLE_RATE_HZ", "16000");
-                sampleRateHz = static_cast<unsigned int>(std::stoul(configured));
-            } catch (...) {
-                sampleRateHz = 16000;
-            }
-
-            std::vector<int16_t> samples(bytes.size() / sizeof(int16_t));
-            std::memcpy(samples.data(), bytes.data(), bytes.size());
-            if (!playPcm16MonoAsync(samples, sampleRateHz, volume)) {
-                CubeLog::error("AudioOutput: failed to enqueue synthesized speech playback");
-            }
-        } catch (const std::exception& e) {
-            CubeLog::error(std::string("AudioOutput: speakTextAsync exception: ") + e.what());
-        } catch (...) {
-            CubeLog::error("AudioOutput: speakTextAsync unknown exception");
+    // The voice is only opened once synthesis starts, so queued utterances don't hold mixer slots; it is
+    // back-dated to now so time-to-first-audio still covers queueing and synthesis.
+    const auto requestedAt = AudioVoice::Clock::now();
+    const uint64_t generation = speechStopGeneration().load(std::memory_order_acquire);
+    speechLane().post([text, gain = volumeToGain(volume), requestedAt, generation](std::stop_token st) {
+        if (speechStopGeneration().load(std::memory_order_acquire) != generation) {
+            return;
         }
-    }).detach();
-
+        auto voice = AudioMixer::instance().openVoice(AudioSource::SPEECH, gain, AudioMixer::DEFAULT_STREAM_CAPACITY_FRAMES, requestedAt);
+        if (!voice) {
+            CubeLog::error("AudioOutput: failed to open a voice for synthesized speech");
+            return;
+        }
+        // A stop that landed while the voice was being opened may have missed it.
+        if (speechStopGeneration().load(std::memory_order_acquire) != generation) {
+            voice->cancel();
+        }
+        synthesizeSpeechInto(text, voice, st);
+        voice->finish();
+    });
     return true;
 }
 
-// TODO: create a function that the output can use to stream data from a ThreadSafeQueue<> to the audio output.
 /////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
 // RtAudio output callback: fills the buffer with the HDMI-keepalive sawtooth
-// (or silence) and additively mixes in any active one-shot playback clips.
+// (or silence) and additively mixes in every live AudioMixer voice.
 int saw(void* outputBuffer, void* inputBuffer, unsigned int nBufferFrames, double streamTime, RtAudioStreamStatus status, void* userData)
 {
+    static const auto streamXruns = Metrics::MetricsRegistry::instance().counter(
+        "audio_stream_xruns_total", "Output callbacks for which the backend reported an underflow");
     double* buffer = (double*)outputBuffer;
     UserData* data = (UserData*)userData;
 
+    // Logging takes locks; count here and let the metrics endpoint report it.
     if (status)
-        CubeLog::error("Stream underflow detected!");
+        streamXruns->increment();
 
     // Fill with sawtooth or silence (keeps HDMI audio clock alive)
     for (unsigned int i = 0; i < nBufferFrames; i++) {
@@ -492,24 +791,6 @@ int saw(void* outputBuffer, void* inputBuffer, unsigned int nBufferFrames, doubl
         }
     }
 
-    // Additively mix active playback clips into the output buffer
-    {
-        std::lock_guard<std::mutex> lock(g_mixer.mutex);
-        for (auto& clip : g_mixer.clips) {
-            const size_t toMix = std::min(
-                static_cast<size_t>(nBufferFrames),
-                (clip.samples.size() - clip.pos) / 2);
-            for (size_t i = 0; i < toMix; i++) {
-                buffer[i * 2 + 0] = std::clamp(buffer[i * 2 + 0] + clip.samples[clip.pos + i * 2], -1.0, 1.0);
-                buffer[i * 2 + 1] = std::clamp(buffer[i * 2 + 1] + clip.samples[clip.pos + i * 2 + 1], -1.0, 1.0);
-            }
-            clip.pos += toMix * 2;
-        }
-        g_mixer.clips.erase(
-            std::remove_if(g_mixer.clips.begin(), g_mixer.clips.end(),
-                [](const PlaybackClip& c) { return c.pos >= c.samples.size(); }),
-            g_mixer.clips.end());
-    }
-
+    AudioMixer::instance().render(buffer, nBufferFrames);
     return 0;
 }
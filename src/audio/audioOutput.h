@@ -34,11 +34,14 @@ SOFTWARE.
 #ifndef AUDIOOUTPUT_H
 #define AUDIOOUTPUT_H
 
+#include "audioMixer.h"
 #include <RtAudio.h>
 #include <cstdint>
 #include <cmath>
 #include <filesystem>
 #include <iostream>
+#include <memory>
+#include <stop_token>
 #include <string>
 #include <vector>
 #include <utils.h>
@@ -56,17 +59,24 @@ public:
     static void stop();
     static void toggleSound();
     static void setSound(bool soundOn);
-    static bool playFileAsync(const std::filesystem::path& filePath, float volume = 100.0f);
-    static bool playPcm16MonoAsync(const std::vector<int16_t>& samples, unsigned int sampleRateHz, float volume = 100.0f);
+    static bool playFileAsync(const std::filesystem::path& filePath, float volume = 100.0f, AudioSource source = AudioSource::UI);
+    static bool playPcm16MonoAsync(const std::vector<int16_t>& samples, unsigned int sampleRateHz, float volume = 100.0f, AudioSource source = AudioSource::SPEECH);
     static bool speakTextAsync(const std::string& text, float volume = 100.0f);
+    static void setSourceGain(AudioSource source, float gain);
+    static void stopSource(AudioSource source);
+    static AudioMixer::Stats getStats();
 private:
     static bool audioStarted;
     static std::unique_ptr<RtAudio> dac;
+    static std::unique_ptr<NullAudioClock> nullClock; // set when AUDIO_OUTPUT_BACKEND=null
     static UserData userData;
     std::unique_ptr<RtAudio::StreamParameters> parameters;
     unsigned int bufferFrames = 256; // 256 sample frames
 };
 
 int saw(void* outputBuffer, void* inputBuffer, unsigned int nBufferFrames, double streamTime, RtAudioStreamStatus status, void* userData);
+// Requests speech for `text` from the remote server and writes the decoded audio into `voice`.
+// Blocks until the response has been consumed; non-200 responses leave the voice silent.
+void synthesizeSpeechInto(const std::string& text, const std::shared_ptr<AudioVoice>& voice, std::stop_token st = {});
 
 #endif// AUDIOOUTPUT_H
@@ -19,15 +19,10 @@ Copyright (c) 2026 A-McD Technology LLC
 
 #include <algorithm>
 #include <cctype>
-#include <cerrno>
 #include <cmath>
 #include <cstdio>
 #include <cstdlib>
-#include <cstring>
 #include <sstream>
-#include <sys/types.h>
-#include <sys/wait.h>
-#include <unistd.h>
 
 namespace {
 
@@ -106,57 +101,6 @@ void MicInputLevelMonitor::finalizeWindow()
     }
 }
 
-CommandResult SystemCommandRunner::run(const std::vector<std::string>& command)
-{
-    if (command.empty()) return {};
-
-    int pipeFds[2] = { -1, -1 };
-    if (pipe(pipeFds) != 0) {
-        return { errno, std::strerror(errno) };
-    }
-
-    pid_t pid = fork();
-    if (pid < 0) {
-        close(pipeFds[0]);
-        close(pipeFds[1]);
-        return { errno, std::strerror(errno) };
-    }
-
-    if (pid == 0) {
-        close(pipeFds[0]);
-        dup2(pipeFds[1], STDOUT_FILENO);
-        dup2(pipeFds[1], STDERR_FILENO);
-        close(pipeFds[1]);
-
-        std::vector<char*> argv;
-        argv.reserve(command.size() + 1);
-        for (const auto& part : command) {
-            argv.push_back(const_cast<char*>(part.c_str()));
-        }
-        argv.push_back(nullptr);
-        execvp(argv.front(), argv.data());
-        _exit(127);
-    }
-
-    close(pipeFds[1]);
-    std::string output;
-    char buffer[512];
-    ssize_t count = 0;
-    while ((count = read(pipeFds[0], buffer, sizeof(buffer))) > 0) {
-        output.append(buffer, static_cast<std::size_t>(count));
-    }
-    close(pipeFds[0]);
-
-    int status = 0;
-    if (waitpid(pid, &status, 0) < 0) {
-        return { errno, output };
-    }
-    if (WIFEXITED(status)) {
-        return { WEXITSTATUS(status), output };
-    }
-    return { -1, output };
-}
-
 MicSourceVolumeController::MicSourceVolumeController(
     MicSourceVolumeControllerConfig config,
     std::shared_ptr<ICommandRunner> runner)
@@ -13,6 +13,8 @@ Copyright (c) 2026 A-McD Technology LLC
 */
 #pragma once
 
+#include "../commandRunner.h"
+
 #include <chrono>
 #include <cstdint>
 #include <functional>
@@ -70,22 +72,6 @@ struct MicSourceVolumeControllerConfig {
     int minPercent = 20;
 };
 
-struct CommandResult {
-    int exitCode = -1;
-    std::string output;
-};
-
-class ICommandRunner {
-public:
-    virtual ~ICommandRunner() = default;
-    virtual CommandResult run(const std::vector<std::string>& command) = 0;
-};
-
-class SystemCommandRunner final : public ICommandRunner {
-public:
-    CommandResult run(const std::vector<std::string>& command) override;
-};
-
 class MicSourceVolumeController {
 public:
     explicit MicSourceVolumeController(
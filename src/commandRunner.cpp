@@ -0,0 +1,186 @@
+/*
+ ██████╗ ██████╗ ███╗   ███╗███╗   ███╗ █████╗ ███╗   ██╗██████╗ ██████╗ ██╗   ██╗███╗   ██╗███╗   ██╗███████╗██████╗     ██████╗██████╗ ██████╗
+██╔════╝██╔═══██╗████╗ ████║████╗ ████║██╔══██╗████╗  ██║██╔══██╗██╔══██╗██║   ██║████╗  ██║████╗  ██║██╔════╝██╔══██╗   ██╔════╝██╔══██╗██╔══██╗
+██║     ██║   ██║██╔████╔██║██╔████╔██║███████║██╔██╗ ██║██║  ██║██████╔╝██║   ██║██╔██╗ ██║██╔██╗ ██║█████╗  ██████╔╝   ██║     ██████╔╝██████╔╝
+██║     ██║   ██║██║╚██╔╝██║██║╚██╔╝██║██╔══██║██║╚██╗██║██║  ██║██╔══██╗██║   ██║██║╚██╗██║██║╚██╗██║██╔══╝  ██╔══██╗   ██║     ██╔═══╝ ██╔═══╝
+╚██████╗╚██████╔╝██║ ╚═╝ ██║██║ ╚═╝ ██║██║  ██║██║ ╚████║██████╔╝██║  ██║╚██████╔╝██║ ╚████║██║ ╚████║███████╗██║  ██║██╗╚██████╗██║     ██║
+ ╚═════╝ ╚═════╝ ╚═╝     ╚═╝╚═╝     ╚═╝╚═╝  ╚═╝╚═╝  ╚═══╝╚═════╝ ╚═╝  ╚═╝ ╚═════╝ ╚═╝  ╚═══╝╚═╝  ╚═══╝╚══════╝╚═╝  ╚═╝╚═╝ ╚═════╝╚═╝     ╚═╝
+*/
+
+/*
+MIT License
+
+Copyright (c) 2026 A-McD Technology LLC
+*/
+
+
+#include "commandRunner.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+
+std::vector<char*> argvFor(const std::vector<std::string>& command)
+{
+    std::vector<char*> argv;
+    argv.reserve(command.size() + 1);
+    for (const auto& part : command) {
+        argv.push_back(const_cast<char*>(part.c_str()));
+    }
+    argv.push_back(nullptr);
+    return argv;
+}
+
+class ProcessLineStream final : public ICommandLineStream {
+public:
+    ProcessLineStream(pid_t pid, int fd)
+        : pid_(pid)
+        , fd_(fd)
+    {
+    }
+
+    ~ProcessLineStream() override
+    {
+        // The child leads its own process group, so anything it spawned stops with it.
+        kill(-pid_, SIGTERM);
+        close(fd_);
+        int status = 0;
+        waitpid(pid_, &status, 0);
+    }
+
+    CommandStreamRead readLine(std::string& line, std::chrono::milliseconds timeout) override
+    {
+        const auto deadline = std::chrono::steady_clock::now() + timeout;
+        while (true) {
+            const size_t newline = pending_.find('\n');
+            if (newline != std::string::npos) {
+                line.assign(pending_, 0, newline);
+                pending_.erase(0, newline + 1);
+                return CommandStreamRead::Line;
+            }
+            if (closed_) {
+                if (pending_.empty()) {
+                    return CommandStreamRead::Closed;
+                }
+                line = std::move(pending_);
+                pending_.clear();
+                return CommandStreamRead::Line;
+            }
+
+            const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+            pollfd descriptor { fd_, POLLIN, 0 };
+            const int ready = poll(&descriptor, 1, static_cast<int>(std::max<std::chrono::milliseconds::rep>(0, remaining.count())));
+            if (ready < 0 && errno == EINTR) {
+                continue;
+            }
+            if (ready == 0) {
+                return CommandStreamRead::Timeout;
+            }
+
+            char buffer[512];
+            const ssize_t count = ready > 0 ? read(fd_, buffer, sizeof(buffer)) : -1;
+            if (count > 0) {
+                pending_.append(buffer, static_cast<size_t>(count));
+            } else if (count < 0 && errno == EINTR) {
+                continue;
+            } else {
+                closed_ = true;
+            }
+        }
+    }
+
+private:
+    pid_t pid_;
+    int fd_;
+    std::string pending_;
+    bool closed_ = false;
+};
+
+} // namespace
+
+CommandResult SystemCommandRunner::run(const std::vector<std::string>& command)
+{
+    if (command.empty()) return {};
+
+    int pipeFds[2] = { -1, -1 };
+    // Close-on-exec, so a stream() child forked while this runs cannot hold the write end open; dup2() clears
+    // the flag on the copies this child gets as stdout and stderr.
+    if (pipe2(pipeFds, O_CLOEXEC) != 0) {
+        return { errno, std::strerror(errno) };
+    }
+
+    pid_t pid = fork();
+    if (pid < 0) {
+        close(pipeFds[0]);
+        close(pipeFds[1]);
+        return { errno, std::strerror(errno) };
+    }
+
+    if (pid == 0) {
+        close(pipeFds[0]);
+        dup2(pipeFds[1], STDOUT_FILENO);
+        dup2(pipeFds[1], STDERR_FILENO);
+        close(pipeFds[1]);
+
+        auto argv = argvFor(command);
+        execvp(argv.front(), argv.data());
+        _exit(127);
+    }
+
+    close(pipeFds[1]);
+    std::string output;
+    char buffer[512];
+    ssize_t count = 0;
+    while ((count = read(pipeFds[0], buffer, sizeof(buffer))) > 0) {
+        output.append(buffer, static_cast<std::size_t>(count));
+    }
+    close(pipeFds[0]);
+
+    int status = 0;
+    if (waitpid(pid, &status, 0) < 0) {
+        return { errno, output };
+    }
+    if (WIFEXITED(status)) {
+        return { WEXITSTATUS(status), output };
+    }
+    return { -1, output };
+}
+
+std::unique_ptr<ICommandLineStream> SystemCommandRunner::stream(const std::vector<std::string>& command)
+{
+    if (command.empty()) return nullptr;
+
+    int pipeFds[2] = { -1, -1 };
+    if (pipe2(pipeFds, O_CLOEXEC) != 0) {
+        return nullptr;
+    }
+
+    pid_t pid = fork();
+    if (pid < 0) {
+        close(pipeFds[0]);
+        close(pipeFds[1]);
+        return nullptr;
+    }
+
+    if (pid == 0) {
+        setpgid(0, 0);
+        dup2(pipeFds[1], STDOUT_FILENO);
+        dup2(pipeFds[1], STDERR_FILENO);
+        auto argv = argvFor(command);
+        execvp(argv.front(), argv.data());
+        _exit(127);
+    }
+
+    // Also set from this side so the group exists before the stream can be destroyed.
+    setpgid(pid, pid);
+    close(pipeFds[1]);
+    return std::make_unique<ProcessLineStream>(pid, pipeFds[0]);
+}
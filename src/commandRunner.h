@@ -0,0 +1,62 @@
+/*
+ ██████╗ ██████╗ ███╗   ███╗███╗   ███╗ █████╗ ███╗   ██╗██████╗ ██████╗ ██╗   ██╗███╗   ██╗███╗   ██╗███████╗██████╗    ██╗  ██╗
+██╔════╝██╔═══██╗████╗ ████║████╗ ████║██╔══██╗████╗  ██║██╔══██╗██╔══██╗██║   ██║████╗  ██║████╗  ██║██╔════╝██╔══██╗   ██║  ██║
+██║     ██║   ██║██╔████╔██║██╔████╔██║███████║██╔██╗ ██║██║  ██║██████╔╝██║   ██║██╔██╗ ██║██╔██╗ ██║█████╗  ██████╔╝   ███████║
+██║     ██║   ██║██║╚██╔╝██║██║╚██╔╝██║██╔══██║██║╚██╗██║██║  ██║██╔══██╗██║   ██║██║╚██╗██║██║╚██╗██║██╔══╝  ██╔══██╗   ██╔══██║
+╚██████╗╚██████╔╝██║ ╚═╝ ██║██║ ╚═╝ ██║██║  ██║██║ ╚████║██████╔╝██║  ██║╚██████╔╝██║ ╚████║██║ ╚████║███████╗██║  ██║██╗██║  ██║
+ ╚═════╝ ╚═════╝ ╚═╝     ╚═╝╚═╝     ╚═╝╚═╝  ╚═╝╚═╝  ╚═══╝╚═════╝ ╚═╝  ╚═╝ ╚═════╝ ╚═╝  ╚═══╝╚═╝  ╚═══╝╚══════╝╚═╝  ╚═╝╚═╝╚═╝  ╚═╝
+*/
+
+/*
+MIT License
+
+Copyright (c) 2026 A-McD Technology LLC
+*/
+
+
+#pragma once
+#ifndef COMMANDRUNNER_H
+#define COMMANDRUNNER_H
+
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+struct CommandResult {
+    int exitCode = -1;
+    std::string output;
+};
+
+enum class CommandStreamRead {
+    Line,
+    Timeout,
+    Closed,
+};
+
+// Output of a command that keeps running, one line at a time. Destroying the stream stops the command.
+class ICommandLineStream {
+public:
+    virtual ~ICommandLineStream() = default;
+    virtual CommandStreamRead readLine(std::string& line, std::chrono::milliseconds timeout) = 0;
+};
+
+class ICommandRunner {
+public:
+    virtual ~ICommandRunner() = default;
+    virtual CommandResult run(const std::vector<std::string>& command) = 0;
+    // Returns nullptr when the runner cannot keep a command running.
+    virtual std::unique_ptr<ICommandLineStream> stream(const std::vector<std::string>& command)
+    {
+        (void)command;
+        return nullptr;
+    }
+};
+
+class SystemCommandRunner final : public ICommandRunner {
+public:
+    CommandResult run(const std::vector<std::string>& command) override;
+    std::unique_ptr<ICommandLineStream> stream(const std::vector<std::string>& command) override;
+};
+
+#endif // COMMANDRUNNER_H
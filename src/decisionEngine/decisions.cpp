@@ -777,6 +777,17 @@ TurnPresentationController& presentationController()
 
 DecisionEngineMain::DecisionEngineMain()
 {
+    auto& metrics = Metrics::MetricsRegistry::instance();
+    for (const auto* stage : { "wake_detected", "listening_ui_shown", "first_partial", "final_transcript", "intent_resolved", "result_presented", "speech_requested" }) {
+        turnStageLatencyHistograms[stage] = metrics.histogram(
+            "voice_turn_stage_since_wake_ms",
+            "Milliseconds from wake word detection to each voice turn stage",
+            { { "stage", stage } });
+    }
+    turnDurationHistogram = metrics.histogram(
+        "voice_turn_duration_ms",
+        "Milliseconds from wake word detection to the end of the voice turn");
+
     audioQueue = std::make_shared<ThreadSafeQueue<std::vector<int16_t>>>();
     remoteServerAPI = std::make_shared<TheCubeServer::TheCubeServerAPI>(audioQueue);
 
@@ -992,6 +1003,13 @@ void DecisionEngineMain::logTurnTimingStage(
         message += ", " + extra;
     }
     CubeLog::info(message);
+
+    const auto histogramIt = turnStageLatencyHistograms.find(stage);
+    if (histogramIt != turnStageLatencyHistograms.end()
+        && snapshot.wakeDetectedEpochMs > 0
+        && stageEpochMs >= snapshot.wakeDetectedEpochMs) {
+        histogramIt->second->record(static_cast<uint64_t>(stageEpochMs - snapshot.wakeDetectedEpochMs));
+    }
 }
 
 void DecisionEngineMain::beginTurnTiming()
@@ -1179,6 +1197,13 @@ void DecisionEngineMain::finalizeTurnTiming(const std::string& reason, const Dec
     }
 
     CubeLog::info(message);
+
+    Metrics::MetricsRegistry::instance()
+        .counter("voice_turns_total", "Voice turns completed, by finalize reason", { { "reason", reason } })
+        ->increment();
+    if (turnDurationHistogram && snapshot.wakeDetectedEpochMs > 0 && summaryEpochMs >= snapshot.wakeDetectedEpochMs) {
+        turnDurationHistogram->record(static_cast<uint64_t>(summaryEpochMs - snapshot.wakeDetectedEpochMs));
+    }
 }
 
 void DecisionEngineMain::hideTurnUi()
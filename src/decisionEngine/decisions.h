@@ -17,6 +17,7 @@ Copyright (c) 2026 A-McD Technology LLC
 #include "../api/autoRegister.h"
 #include "../audio/audioManager.h"
 #include "../database/chatHistoryStore.h"
+#include "../telemetry/metrics.h"
 #include "../threadsafeQueue.h"
 #include "functionRegistry.h"
 #include "intentRegistry.h"
@@ -35,6 +36,7 @@ Copyright (c) 2026 A-McD Technology LLC
 #include <memory>
 #include <mutex>
 #include <string>
+#include <unordered_map>
 
 namespace DecisionEngine {
 
@@ -85,6 +87,7 @@ public:
     void restart();
     void pause();
     void resume();
+    std::shared_ptr<TriggerManager> getTriggerManager() const { return triggerManager; }
 
     HttpEndPointData_t getHttpEndpointData() override;
     std::string getInterfaceName() const override { return "DecisionEngine"; }
@@ -141,6 +144,10 @@ private:
     std::shared_ptr<TheCubeServer::TheCubeServerAPI> remoteServerAPI;
     std::shared_ptr<ChatHistoryStore> chatHistoryStore;
 
+    // Keyed by the turn_timing stage name; recorded alongside the existing log lines.
+    std::unordered_map<std::string, std::shared_ptr<Metrics::Histogram>> turnStageLatencyHistograms;
+    std::shared_ptr<Metrics::Histogram> turnDurationHistogram;
+
     std::shared_ptr<ThreadSafeQueue<std::vector<int16_t>>> audioQueue;
     std::shared_ptr<ThreadSafeQueue<std::string>> transcription;
     std::jthread transcriptionConsumerThread;
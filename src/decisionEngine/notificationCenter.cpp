@@ -559,9 +559,11 @@ NotificationCenter::NotificationCenter()
             });
     };
     presenterCallbacks_.startAlarmSound = []() {
-        AudioOutput::playFileAsync(defaultAlertSoundPath(), static_cast<float>(GlobalSettings::getSettingOfType<int>(GlobalSettings::SettingType::ALARM_SOUND_VOLUME)));
+        AudioOutput::playFileAsync(defaultAlertSoundPath(), static_cast<float>(GlobalSettings::getSettingOfType<int>(GlobalSettings::SettingType::ALARM_SOUND_VOLUME)), AudioSource::ALARM);
+    };
+    presenterCallbacks_.stopAlarmSound = []() {
+        AudioOutput::stopSource(AudioSource::ALARM);
     };
-    presenterCallbacks_.stopAlarmSound = []() {};
     presenterCallbacks_.playReminderSound = []() {
         AudioOutput::playFileAsync(defaultAlertSoundPath(), static_cast<float>(GlobalSettings::getSettingOfType<int>(GlobalSettings::SettingType::NOTIFICATION_SOUND_VOLUME)));
     };
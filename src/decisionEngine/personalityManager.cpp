@@ -37,27 +37,6 @@ using namespace Personality;
 
 int calculateCurrentValue(int startValue, int endValue, TimePoint startTime, TimePoint endTime, TimePoint currentTime, Emotion::TimeTargetType rampType, double exponent = 2.0);
 
-namespace {
-
-void syncEmotionToFixedValue(Emotion& emotion, int value)
-{
-    emotion.currentValue = value;
-    emotion.defaultValue = value;
-    emotion.targetValue = value;
-    emotion.rampStartValue = value;
-    emotion.rampEndValue = value;
-    emotion.timeTargetType = Emotion::TimeTargetType::TARGET_TYPE_NOT_DEFINED;
-    emotion.expirationType = Emotion::TimeTargetType::TARGET_TYPE_NOT_DEFINED;
-    emotion.rampType = Emotion::TimeTargetType::TARGET_TYPE_NOT_DEFINED;
-    emotion.rampStage = Emotion::RampStage::RAMP_COMPLETE;
-    const auto now = std::chrono::system_clock::now();
-    emotion.expirationTime = now;
-    emotion.targetValueTime = now;
-    emotion.rampStartTime = now;
-}
-
-}
-
 Emotion::Emotion(int value, EmotionType name)
 {
     this->name = name;
@@ -225,67 +204,35 @@ TimePoint Emotion::getLastUpdate()
 
 PersonalityManager::PersonalityManager()
 {
-    curiosity = Emotion(80, Emotion::EmotionType::CURIOSITY);
-    playfulness = Emotion(70, Emotion::EmotionType::PLAYFULNESS);
-    empathy = Emotion(85, Emotion::EmotionType::EMPATHY);
-    assertiveness = Emotion(60, Emotion::EmotionType::ASSERTIVENESS);
-    attentiveness = Emotion(90, Emotion::EmotionType::ATTENTIVENESS);
-    caution = Emotion(50, Emotion::EmotionType::CAUTION);
-    annoyance = Emotion(1, Emotion::EmotionType::ANNOYANCE);
-
-    auto curiosityInt = GlobalSettings::getSettingOfType<int>(GlobalSettings::SettingType::EMOTION_CURIOSITY);
-    auto playfulnessInt = GlobalSettings::getSettingOfType<int>(GlobalSettings::SettingType::EMOTION_PLAYFULNESS);
-    auto empathyInt = GlobalSettings::getSettingOfType<int>(GlobalSettings::SettingType::EMOTION_EMPATHY);
-    auto assertivenessInt = GlobalSettings::getSettingOfType<int>(GlobalSettings::SettingType::EMOTION_ASSERTIVENESS);
-    auto attentivenessInt = GlobalSettings::getSettingOfType<int>(GlobalSettings::SettingType::EMOTION_ATTENTIVENESS);
-    auto cautionInt = GlobalSettings::getSettingOfType<int>(GlobalSettings::SettingType::EMOTION_CAUTION);
-    auto annoyanceInt = GlobalSettings::getSettingOfType<int>(GlobalSettings::SettingType::EMOTION_ANNOYANCE);
-
-    syncEmotionToFixedValue(curiosity, curiosityInt);
-    syncEmotionToFixedValue(playfulness, playfulnessInt);
-    syncEmotionToFixedValue(empathy, empathyInt);
-    syncEmotionToFixedValue(assertiveness, assertivenessInt);
-    syncEmotionToFixedValue(attentiveness, attentivenessInt);
-    syncEmotionToFixedValue(caution, cautionInt);
-    syncEmotionToFixedValue(annoyance, annoyanceInt);
+    const std::array<std::pair<Emotion::EmotionType, GlobalSettings::SettingType>, EMOTION_SLOT_COUNT> emotionSettings = { {
+        { Emotion::EmotionType::CURIOSITY, GlobalSettings::SettingType::EMOTION_CURIOSITY },
+        { Emotion::EmotionType::PLAYFULNESS, GlobalSettings::SettingType::EMOTION_PLAYFULNESS },
+        { Emotion::EmotionType::EMPATHY, GlobalSettings::SettingType::EMOTION_EMPATHY },
+        { Emotion::EmotionType::ASSERTIVENESS, GlobalSettings::SettingType::EMOTION_ASSERTIVENESS },
+        { Emotion::EmotionType::ATTENTIVENESS, GlobalSettings::SettingType::EMOTION_ATTENTIVENESS },
+        { Emotion::EmotionType::CAUTION, GlobalSettings::SettingType::EMOTION_CAUTION },
+        { Emotion::EmotionType::ANNOYANCE, GlobalSettings::SettingType::EMOTION_ANNOYANCE },
+    } };
+
+    {
+        std::unique_lock<std::mutex> lock(managerMutex);
+        for (const auto& [emotion, setting] : emotionSettings) {
+            syncToFixedValueLocked(emotionSlot(emotion), GlobalSettings::getSettingOfType<int>(setting));
+        }
+        publishLocked();
+    }
 
     // When the settings are changed, such as in the menu, update the values in the personality manager
-    GlobalSettings::setSettingCB(GlobalSettings::SettingType::EMOTION_CURIOSITY, [&]() {
-        std::unique_lock<std::mutex> lock(managerMutex);
-        syncEmotionToFixedValue(curiosity, GlobalSettings::getSettingOfType<int>(GlobalSettings::SettingType::EMOTION_CURIOSITY));
-    });
-    GlobalSettings::setSettingCB(GlobalSettings::SettingType::EMOTION_PLAYFULNESS, [&]() {
-        std::unique_lock<std::mutex> lock(managerMutex);
-        syncEmotionToFixedValue(playfulness, GlobalSettings::getSettingOfType<int>(GlobalSettings::SettingType::EMOTION_PLAYFULNESS));
-    });
-    GlobalSettings::setSettingCB(GlobalSettings::SettingType::EMOTION_EMPATHY, [&]() {
-        std::unique_lock<std::mutex> lock(managerMutex);
-        syncEmotionToFixedValue(empathy, GlobalSettings::getSettingOfType<int>(GlobalSettings::SettingType::EMOTION_EMPATHY));
-    });
-    GlobalSettings::setSettingCB(GlobalSettings::SettingType::EMOTION_ASSERTIVENESS, [&]() {
-        std::unique_lock<std::mutex> lock(managerMutex);
-        syncEmotionToFixedValue(assertiveness, GlobalSettings::getSettingOfType<int>(GlobalSettings::SettingType::EMOTION_ASSERTIVENESS));
-    });
-    GlobalSettings::setSettingCB(GlobalSettings::SettingType::EMOTION_ATTENTIVENESS, [&]() {
-        std::unique_lock<std::mutex> lock(managerMutex);
-        syncEmotionToFixedValue(attentiveness, GlobalSettings::getSettingOfType<int>(GlobalSettings::SettingType::EMOTION_ATTENTIVENESS));
-    });
-    GlobalSettings::setSettingCB(GlobalSettings::SettingType::EMOTION_CAUTION, [&]() {
-        std::unique_lock<std::mutex> lock(managerMutex);
-        syncEmotionToFixedValue(caution, GlobalSettings::getSettingOfType<int>(GlobalSettings::SettingType::EMOTION_CAUTION));
-    });
-    GlobalSettings::setSettingCB(GlobalSettings::SettingType::EMOTION_ANNOYANCE, [&]() {
-        std::unique_lock<std::mutex> lock(managerMutex);
-        syncEmotionToFixedValue(annoyance, GlobalSettings::getSettingOfType<int>(GlobalSettings::SettingType::EMOTION_ANNOYANCE));
-    });
+    for (const auto& [emotion, setting] : emotionSettings) {
+        GlobalSettings::setSettingCB(setting, [this, slot = emotionSlot(emotion), setting]() {
+            std::unique_lock<std::mutex> lock(managerMutex);
+            syncToFixedValueLocked(slot, GlobalSettings::getSettingOfType<int>(setting));
+            publishLocked();
+            rampStateChanged = true;
+            managerCV.notify_all();
+        });
+    }
 
-    emotions.insert({ Emotion::EmotionType::CURIOSITY, curiosity });
-    emotions.insert({ Emotion::EmotionType::PLAYFULNESS, playfulness });
-    emotions.insert({ Emotion::EmotionType::EMPATHY, empathy });
-    emotions.insert({ Emotion::EmotionType::ASSERTIVENESS, assertiveness });
-    emotions.insert({ Emotion::EmotionType::ATTENTIVENESS, attentiveness });
-    emotions.insert({ Emotion::EmotionType::CAUTION, caution });
-    emotions.insert({ Emotion::EmotionType::ANNOYANCE, annoyance });
     // Start the manager thread
     managerThread = std::jthread([this](std::stop_token st) {
         managerThreadFunction(st);
@@ -300,189 +247,319 @@ PersonalityManager::~PersonalityManager()
     }
 }
 
+void PersonalityManager::syncToFixedValueLocked(size_t slot, int value)
+{
+    const auto now = std::chrono::system_clock::now();
+    table.currentValue[slot] = value;
+    table.defaultValue[slot] = value;
+    table.targetValue[slot] = value;
+    table.rampStartValue[slot] = value;
+    table.rampEndValue[slot] = value;
+    table.timeTargetType[slot] = Emotion::TimeTargetType::TARGET_TYPE_NOT_DEFINED;
+    table.expirationType[slot] = Emotion::TimeTargetType::TARGET_TYPE_NOT_DEFINED;
+    table.rampStage[slot] = Emotion::RampStage::RAMP_COMPLETE;
+    table.expirationTime[slot] = now;
+    table.targetValueTime[slot] = now;
+    table.rampStartTime[slot] = now;
+    table.lastUpdate[slot] = now;
+}
+
+// Same clamping as Emotion::operator=.
+void PersonalityManager::setCurrentValueLocked(size_t slot, int value, TimePoint now)
+{
+    value = std::clamp(value, EMOTION_MIN_VALUE, EMOTION_MAX_VALUE);
+    if (value == table.currentValue[slot])
+        return;
+    table.currentValue[slot] = value;
+    table.lastUpdate[slot] = now;
+}
+
+void PersonalityManager::publishLocked()
+{
+    const auto sequence = snapshotSequence.load(std::memory_order_relaxed);
+    snapshotSequence.store(sequence + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t slot = 0; slot < EMOTION_SLOT_COUNT; ++slot) {
+        snapshotValues[slot].store(table.currentValue[slot], std::memory_order_relaxed);
+    }
+    snapshotSequence.store(sequence + 2, std::memory_order_release);
+}
+
+EmotionSnapshot PersonalityManager::getSnapshot() const
+{
+    EmotionSnapshot snapshot;
+    while (true) {
+        const auto before = snapshotSequence.load(std::memory_order_acquire);
+        if (before & 1) {
+            // A publish is storing seven ints; it will be done almost immediately.
+            std::this_thread::yield();
+            continue;
+        }
+        for (size_t slot = 0; slot < EMOTION_SLOT_COUNT; ++slot) {
+            snapshot.values[slot] = snapshotValues[slot].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (snapshotSequence.load(std::memory_order_relaxed) == before) {
+            snapshot.version = before;
+            return snapshot;
+        }
+    }
+}
+
 const Emotion PersonalityManager::getEmotion(Emotion::EmotionType emotion)
 {
+    if (!isValidEmotion(emotion))
+        throw std::out_of_range("PersonalityManager::getEmotion: unknown emotion");
+    const auto slot = emotionSlot(emotion);
     std::unique_lock<std::mutex> lock(managerMutex);
-    return emotions.at(emotion);
+    Emotion emote(table.currentValue[slot], emotion);
+    emote.defaultValue = table.defaultValue[slot];
+    emote.targetValue = table.targetValue[slot];
+    emote.rampStartValue = table.rampStartValue[slot];
+    emote.rampEndValue = table.rampEndValue[slot];
+    emote.timeTargetType = table.timeTargetType[slot];
+    emote.expirationType = table.expirationType[slot];
+    emote.rampType = table.timeTargetType[slot];
+    emote.rampStage = table.rampStage[slot];
+    emote.expirationTime = table.expirationTime[slot];
+    emote.targetValueTime = table.targetValueTime[slot];
+    emote.rampStartTime = table.rampStartTime[slot];
+    emote.lastUpdate = table.lastUpdate[slot];
+    return emote;
 }
 
 bool PersonalityManager::setEmotion(Emotion::EmotionType emotion, int value)
 {
-    std::unique_lock<std::mutex> lock(managerMutex);
-    if (emotions.find(emotion) == emotions.end())
+    if (!isValidEmotion(emotion))
         return false;
-    emotions.at(emotion) = value;
+    const auto slot = emotionSlot(emotion);
+    std::unique_lock<std::mutex> lock(managerMutex);
+    setCurrentValueLocked(slot, value, std::chrono::system_clock::now());
+    publishLocked();
     return true;
 }
 
 bool PersonalityManager::setEmotion(Emotion::EmotionType emotion, TimePoint expiration, int value)
 {
-    if(expiration <= std::chrono::system_clock::now())
+    const auto now = std::chrono::system_clock::now();
+    if(expiration <= now)
         return false;
-    std::unique_lock<std::mutex> lock(managerMutex);
-    if (emotions.find(emotion) == emotions.end())
+    if (!isValidEmotion(emotion))
         return false;
-    emotions.at(emotion) = value;
-    emotions.at(emotion).expirationTime = expiration;
-    emotions.at(emotion).expirationType = Emotion::TimeTargetType::TARGET_RAMP_STEP;
-    emotions.at(emotion).rampStage = Emotion::RampStage::RAMP_TO_DEFAULT; // Short circuit the ramping process
-    emotions.at(emotion).rampStartTime = std::chrono::system_clock::now();
-    emotions.at(emotion).rampStartValue = value;
-    emotions.at(emotion).rampEndValue = emotions.at(emotion).defaultValue;
+    const auto slot = emotionSlot(emotion);
+    std::unique_lock<std::mutex> lock(managerMutex);
+    setCurrentValueLocked(slot, value, now);
+    table.expirationTime[slot] = expiration;
+    table.expirationType[slot] = Emotion::TimeTargetType::TARGET_RAMP_STEP;
+    table.rampStage[slot] = Emotion::RampStage::RAMP_TO_DEFAULT; // Short circuit the ramping process
+    table.rampStartTime[slot] = now;
+    table.rampStartValue[slot] = table.currentValue[slot];
+    table.rampEndValue[slot] = table.defaultValue[slot];
+    publishLocked();
+    rampStateChanged = true;
+    managerCV.notify_all();
     return true;
 }
 
 bool PersonalityManager::setEmotion(Emotion::EmotionType emotion, TimePoint targetValueTime, int targetValue, Emotion::TimeTargetType rampType)
 {
-    if(targetValueTime <= std::chrono::system_clock::now())
+    const auto now = std::chrono::system_clock::now();
+    if(targetValueTime <= now)
         return false;
-    std::unique_lock<std::mutex> lock(managerMutex);
-    if (emotions.find(emotion) == emotions.end())
+    if (!isValidEmotion(emotion))
         return false;
-    emotions.at(emotion).targetValue = targetValue;
-    emotions.at(emotion).targetValueTime = targetValueTime;
-    emotions.at(emotion).expirationTime = targetValueTime;
-    emotions.at(emotion).timeTargetType = rampType;
-    emotions.at(emotion).rampStage = Emotion::RampStage::RAMP_NOT_STARTED;
-    emotions.at(emotion).rampStartTime = std::chrono::system_clock::now();
+    const auto slot = emotionSlot(emotion);
+    std::unique_lock<std::mutex> lock(managerMutex);
+    table.targetValue[slot] = targetValue;
+    table.targetValueTime[slot] = targetValueTime;
+    table.expirationTime[slot] = targetValueTime;
+    table.timeTargetType[slot] = rampType;
+    table.expirationType[slot] = Emotion::TimeTargetType::TARGET_TYPE_NOT_DEFINED;
+    table.rampStage[slot] = Emotion::RampStage::RAMP_NOT_STARTED;
+    table.rampStartTime[slot] = now;
+    rampStateChanged = true;
+    managerCV.notify_all();
     return true;
 }
 
 bool PersonalityManager::setEmotion(Emotion::EmotionType emotion, TimePoint targetValueTime, int targetValue, TimePoint expiration, Emotion::TimeTargetType rampType)
 {
+    const auto now = std::chrono::system_clock::now();
     if(targetValueTime >= expiration)
         return false;
-    if(expiration <= std::chrono::system_clock::now())
+    if(expiration <= now)
         return false;
-    std::unique_lock<std::mutex> lock(managerMutex);
-    if (emotions.find(emotion) == emotions.end())
+    if (!isValidEmotion(emotion))
         return false;
-    emotions.at(emotion).targetValue = targetValue;
-    emotions.at(emotion).targetValueTime = targetValueTime;
-    emotions.at(emotion).expirationTime = expiration;
-    emotions.at(emotion).timeTargetType = rampType;
-    emotions.at(emotion).rampStage = Emotion::RampStage::RAMP_NOT_STARTED;
-    emotions.at(emotion).rampStartTime = std::chrono::system_clock::now();
+    const auto slot = emotionSlot(emotion);
+    std::unique_lock<std::mutex> lock(managerMutex);
+    table.targetValue[slot] = targetValue;
+    table.targetValueTime[slot] = targetValueTime;
+    table.expirationTime[slot] = expiration;
+    table.timeTargetType[slot] = rampType;
+    table.expirationType[slot] = Emotion::TimeTargetType::TARGET_TYPE_NOT_DEFINED;
+    table.rampStage[slot] = Emotion::RampStage::RAMP_NOT_STARTED;
+    table.rampStartTime[slot] = now;
+    rampStateChanged = true;
+    managerCV.notify_all();
     return true;
 }
 
 int PersonalityManager::getEmotionValue(Emotion::EmotionType emotion)
 {
-    std::unique_lock<std::mutex> lock(managerMutex);
-    if (emotions.find(emotion) == emotions.end())
+    if (!isValidEmotion(emotion))
         return -1;
-    return emotions.at(emotion).currentValue;
+    return getSnapshot().value(emotion);
 }
 
 std::vector<EmotionSimple> PersonalityManager::getAllEmotionsCurrent()
 {
-    std::unique_lock<std::mutex> lock(managerMutex);
+    const auto snapshot = getSnapshot();
     std::vector<EmotionSimple> currentEmotions;
-    for (auto& [name, emote] : emotions) {
-        EmotionSimple simple;
-        simple.emotion = name;
-        simple.value = emote.currentValue;
-        currentEmotions.push_back(simple);
+    currentEmotions.reserve(EMOTION_SLOT_COUNT);
+    for (size_t slot = 0; slot < EMOTION_SLOT_COUNT; ++slot) {
+        currentEmotions.push_back({ emotionAtSlot(slot), snapshot.values[slot] });
     }
     return currentEmotions;
 }
 
-void PersonalityManager::managerThreadFunction(std::stop_token st)
+// Ramp evaluation runs over all emotions at once: stage transitions first, then the progress and
+// interpolation for every active lane as plain array loops, then write-back. Emotions whose ramp is
+// complete are masked out and cost nothing beyond the stage check.
+bool PersonalityManager::evaluateRampsLocked(TimePoint now)
 {
-    while (!st.stop_requested()) {
-        genericSleep(250);
-        std::unique_lock<std::mutex> lock(managerMutex);
-        for (auto& [time, emote] : emotions) {
-            auto now = std::chrono::system_clock::now();
-            switch (emote.rampStage) {
-            case Emotion::RampStage::RAMP_NOT_STARTED:
-                emote.rampStage = Emotion::RampStage::RAMP_TO_TARGET;
-                emote.rampStartTime = now;
-                emote.rampStartValue = emote.currentValue;
-                emote.rampEndValue = emote.targetValue;
-                break;
-            case Emotion::RampStage::RAMP_TO_TARGET:
-                emote.currentValue = calculateCurrentValue(emote.rampStartValue, emote.rampEndValue, emote.rampStartTime, emote.targetValueTime, now, emote.rampType);
-                if (now >= emote.targetValueTime) {
-                    emote.rampStage = Emotion::RampStage::RAMP_TO_DEFAULT;
-                    emote.rampStartTime = now;
-                    emote.rampStartValue = emote.currentValue;
-                    emote.rampEndValue = emote.defaultValue;
-                }
-                break;
-            case Emotion::RampStage::RAMP_TO_DEFAULT:
-                emote.currentValue = calculateCurrentValue(emote.rampEndValue, emote.rampStartValue, emote.rampStartTime, emote.expirationTime, now, emote.rampType);
-                if (now >= emote.expirationTime) {
-                    emote.rampStage = Emotion::RampStage::RAMP_COMPLETE;
-                }
-                break;
-            case Emotion::RampStage::RAMP_COMPLETE:
-                emote.currentValue = emote.defaultValue;
-                break;
-            }
+    std::array<bool, EMOTION_SLOT_COUNT> active {};
+    bool anyActive = false;
+    for (size_t slot = 0; slot < EMOTION_SLOT_COUNT; ++slot) {
+        if (table.rampStage[slot] == Emotion::RampStage::RAMP_NOT_STARTED) {
+            table.rampStage[slot] = Emotion::RampStage::RAMP_TO_TARGET;
+            table.rampStartTime[slot] = now;
+            table.rampStartValue[slot] = table.currentValue[slot];
+            table.rampEndValue[slot] = table.targetValue[slot];
         }
+        active[slot] = table.rampStage[slot] == Emotion::RampStage::RAMP_TO_TARGET
+            || table.rampStage[slot] == Emotion::RampStage::RAMP_TO_DEFAULT;
+        anyActive = anyActive || active[slot];
     }
-}
+    if (!anyActive)
+        return false;
 
-float PersonalityManager::calculateEmotionalMatchScore(std::vector<EmotionRange> emotionRanges)
-{
-    std::unique_lock<std::mutex> lock(managerMutex);
-    // verify that emotionRanges has all emotions. If not, add them with default values.
-    for(auto& emote : emotions) {
-        bool found = false;
-        for(auto& range : emotionRanges) {
-            if(range.emotion == emote.second.name) {
-                found = true;
-                break;
-            }
+    std::array<int, EMOTION_SLOT_COUNT> rampValue {};
+    for (size_t slot = 0; slot < EMOTION_SLOT_COUNT; ++slot) {
+        if (!active[slot])
+            continue;
+        const bool toTarget = table.rampStage[slot] == Emotion::RampStage::RAMP_TO_TARGET;
+        const auto rampType = !toTarget && table.expirationType[slot] != Emotion::TimeTargetType::TARGET_TYPE_NOT_DEFINED
+            ? table.expirationType[slot]
+            : table.timeTargetType[slot];
+        rampValue[slot] = calculateCurrentValue(table.rampStartValue[slot], table.rampEndValue[slot], table.rampStartTime[slot],
+            toTarget ? table.targetValueTime[slot] : table.expirationTime[slot], now, rampType, EXPONENTIAL_RAMP_EXPONENT);
+    }
+
+    bool changed = false;
+    for (size_t slot = 0; slot < EMOTION_SLOT_COUNT; ++slot) {
+        if (!active[slot])
+            continue;
+        const int before = table.currentValue[slot];
+        table.currentValue[slot] = rampValue[slot];
+        if (table.rampStage[slot] == Emotion::RampStage::RAMP_TO_TARGET && now >= table.targetValueTime[slot]) {
+            table.rampStage[slot] = Emotion::RampStage::RAMP_TO_DEFAULT;
+            table.rampStartTime[slot] = now;
+            table.rampStartValue[slot] = table.currentValue[slot];
+            table.rampEndValue[slot] = table.defaultValue[slot];
+        } else if (table.rampStage[slot] == Emotion::RampStage::RAMP_TO_DEFAULT && now >= table.expirationTime[slot]) {
+            table.rampStage[slot] = Emotion::RampStage::RAMP_COMPLETE;
+            table.currentValue[slot] = table.defaultValue[slot];
         }
-        if(!found) {
-            EmotionRange range;
-            range.emotion = emote.second.name;
-            range.min = EMOTION_MIN_VALUE;
-            range.max = EMOTION_MAX_VALUE;
-            range.weight = 1.0f;
-            emotionRanges.push_back(range);
+        if (table.currentValue[slot] != before) {
+            table.lastUpdate[slot] = now;
+            changed = true;
         }
     }
-    // Make sure all the values in the emotionRanges make sense
-    for(size_t i = 0; i < emotionRanges.size(); i++) {
-        // clamp weight to 0.0f to 1.0f
-        if(emotionRanges.at(i).weight < 0.0f)
-            emotionRanges.at(i).weight = 0.0f;
-        if(emotionRanges.at(i).weight > 1.0f)
-            emotionRanges.at(i).weight = 1.0f;
-        if(emotionRanges.at(i).min > emotionRanges.at(i).max)
-            std::swap(emotionRanges.at(i).min, emotionRanges.at(i).max);
-        if(emotionRanges.at(i).min < EMOTION_MIN_VALUE)
-            emotionRanges.at(i).min = std::abs(emotionRanges.at(i).min);
-        if(emotionRanges.at(i).max < EMOTION_MIN_VALUE)
-            emotionRanges.at(i).max = std::abs(emotionRanges.at(i).max);
-        if(emotionRanges.at(i).min > EMOTION_MAX_VALUE)
-            emotionRanges.at(i).min = EMOTION_MAX_VALUE;
-        if(emotionRanges.at(i).max > EMOTION_MAX_VALUE)
-            emotionRanges.at(i).max = EMOTION_MAX_VALUE;
-    }
-    // Also create and populate a vector of current values in the same order as emotionRanges
-    std::vector<float> currentValues;
-    for(auto& range : emotionRanges) {
-        currentValues.push_back(emotions.at(range.emotion).currentValue);
+    return changed;
+}
+
+// Continuous ramps need a tick; step ramps (and ramps whose value cannot change) only need a
+// wake-up at their end time.
+std::optional<TimePoint> PersonalityManager::nextRampDeadlineLocked(TimePoint now) const
+{
+    std::optional<TimePoint> deadline;
+    const auto tick = now + std::chrono::milliseconds(PERSONALITY_RAMP_TICK_MS);
+    for (size_t slot = 0; slot < EMOTION_SLOT_COUNT; ++slot) {
+        TimePoint slotDeadline;
+        switch (table.rampStage[slot]) {
+        case Emotion::RampStage::RAMP_NOT_STARTED:
+            slotDeadline = now;
+            break;
+        case Emotion::RampStage::RAMP_TO_TARGET:
+        case Emotion::RampStage::RAMP_TO_DEFAULT: {
+            const bool toTarget = table.rampStage[slot] == Emotion::RampStage::RAMP_TO_TARGET;
+            const auto end = toTarget ? table.targetValueTime[slot] : table.expirationTime[slot];
+            const auto rampType = !toTarget && table.expirationType[slot] != Emotion::TimeTargetType::TARGET_TYPE_NOT_DEFINED
+                ? table.expirationType[slot]
+                : table.timeTargetType[slot];
+            const bool stepOnly = rampType == Emotion::TimeTargetType::TARGET_RAMP_STEP
+                || table.rampStartValue[slot] == table.rampEndValue[slot];
+            slotDeadline = stepOnly ? end : std::min(end, tick);
+            break;
+        }
+        case Emotion::RampStage::RAMP_COMPLETE:
+            continue;
+        }
+        deadline = deadline ? std::min(*deadline, slotDeadline) : slotDeadline;
     }
-    // Calculate the score
-    std::array<float, 7> distances = {0.0f}; // Array to store distances for each dimension
-    for (size_t i = 0; i < 7; ++i) {
-        if (currentValues[i] < emotionRanges[i].min) {
-            distances[i] = emotionRanges[i].min - currentValues[i]; // Below the range
-        } else if (currentValues[i] > emotionRanges[i].max) {
-            distances[i] = currentValues[i] - emotionRanges[i].max; // Above the range
+    return deadline;
+}
+
+// Ticks every PERSONALITY_RAMP_TICK_MS only while a continuous ramp is running; otherwise sleeps
+// until the next step deadline or until a setter changes the ramp state.
+void PersonalityManager::managerThreadFunction(std::stop_token st)
+{
+    std::unique_lock<std::mutex> lock(managerMutex);
+    while (!st.stop_requested()) {
+        const auto now = std::chrono::system_clock::now();
+        if (evaluateRampsLocked(now))
+            publishLocked();
+        rampStateChanged = false;
+        if (const auto deadline = nextRampDeadlineLocked(now)) {
+            managerCV.wait_until(lock, st, *deadline, [this]() { return rampStateChanged; });
         } else {
-            distances[i] = 0.0f; // Within the range
+            managerCV.wait(lock, st, [this]() { return rampStateChanged; });
         }
     }
-    // Compute the Euclidean distance (length of the distance vector) multiplied by the weight
+}
+
+float PersonalityManager::calculateEmotionalMatchScore(std::vector<EmotionRange> emotionRanges)
+{
+    // Emotions without a range are treated as EMOTION_MIN_VALUE..EMOTION_MAX_VALUE, which every
+    // value satisfies, so only the supplied ranges contribute to the distance.
+    const auto snapshot = getSnapshot();
     float sumOfSquares = 0.0f;
-    for (size_t i = 0; i < 7; ++i) {
-        sumOfSquares += distances[i] * distances[i] * emotionRanges[i].weight;
+    for (auto range : emotionRanges) {
+        if (!isValidEmotion(range.emotion))
+            continue;
+        // Make sure all the values in the range make sense
+        range.weight = std::clamp(range.weight, 0.0f, 1.0f);
+        if (range.min > range.max)
+            std::swap(range.min, range.max);
+        if (range.min < EMOTION_MIN_VALUE)
+            range.min = std::abs(range.min);
+        if (range.max < EMOTION_MIN_VALUE)
+            range.max = std::abs(range.max);
+        if (range.min > EMOTION_MAX_VALUE)
+            range.min = EMOTION_MAX_VALUE;
+        if (range.max > EMOTION_MAX_VALUE)
+            range.max = EMOTION_MAX_VALUE;
+
+        const float current = static_cast<float>(snapshot.value(range.emotion));
+        float distance = 0.0f;
+        if (current < range.min) {
+            distance = range.min - current; // Below the range
+        } else if (current > range.max) {
+            distance = current - range.max; // Above the range
+        }
+        // Euclidean distance (length of the distance vector) with each dimension weighted
+        sumOfSquares += distance * distance * range.weight;
     }
     return std::sqrt(sumOfSquares);
 }
@@ -696,6 +773,8 @@ int calculateCurrentValue(int startValue, int endValue, TimePoint startTime, Tim
     using namespace std::chrono;
     long long totalDuration = duration_cast<milliseconds>(endTime - startTime).count();
     long long elapsedDuration = duration_cast<milliseconds>(currentTime - startTime).count();
+    if (totalDuration <= 0)
+        return endValue;
     elapsedDuration = std::max(0LL, std::min(elapsedDuration, totalDuration));
     double t = static_cast<double>(elapsedDuration) / totalDuration;
     switch (rampType) {
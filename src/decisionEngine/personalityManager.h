@@ -36,16 +36,22 @@ SOFTWARE.
 #define PERSONALITYMANAGER_H
 
 #include "utils.h"
+#include <array>
+#include <atomic>
 #include <chrono>
+#include <condition_variable>
+#include <cstdint>
 #ifndef LOGGER_H
 #include <logger.h>
 #endif
 #include <mutex>
 #include <numbers>
+#include <optional>
 #include <stop_token>
 #include <string>
 #include <thread>
 #include <unordered_map>
+#include <vector>
 #ifndef API_I_H
 #include "../api/api.h"
 #endif
@@ -56,6 +62,7 @@ SOFTWARE.
 #define EXPONENTIAL_RAMP_EXPONENT 2.0
 #define EMOTION_MAX_VALUE 100
 #define EMOTION_MIN_VALUE 1
+#define PERSONALITY_RAMP_TICK_MS 250
 
 namespace Personality {
 
@@ -120,6 +127,7 @@ public:
     TimePoint rampStartTime;
     EmotionType name = EmotionType::EMOTION_NOT_ASSIGNED;
 private:
+    friend class PersonalityManager;
     TimePoint lastUpdate;
 };
 
@@ -136,6 +144,34 @@ struct EmotionRange {
     Emotion::EmotionType emotion;
 };
 
+// Emotions are stored densely by slot; EMOTION_NOT_ASSIGNED has no slot.
+constexpr size_t EMOTION_SLOT_COUNT = static_cast<size_t>(Emotion::EmotionType::EMOTION_COUNT) - 1;
+
+constexpr bool isValidEmotion(Emotion::EmotionType emotion)
+{
+    return emotion > Emotion::EmotionType::EMOTION_NOT_ASSIGNED && emotion < Emotion::EmotionType::EMOTION_COUNT;
+}
+
+constexpr size_t emotionSlot(Emotion::EmotionType emotion)
+{
+    return static_cast<size_t>(emotion) - 1;
+}
+
+constexpr Emotion::EmotionType emotionAtSlot(size_t slot)
+{
+    return static_cast<Emotion::EmotionType>(slot + 1);
+}
+
+// Consistent copy of every emotion's current value, as published by the manager.
+struct EmotionSnapshot {
+    std::array<int, EMOTION_SLOT_COUNT> values {};
+    uint64_t version = 0;
+    int value(Emotion::EmotionType emotion) const
+    {
+        return isValidEmotion(emotion) ? values[emotionSlot(emotion)] : 0;
+    }
+};
+
 const int interpretScore(const float score);
 const std::string emotionToString(const Emotion::EmotionType emotion);
 
@@ -149,27 +185,53 @@ public:
     bool setEmotion(Emotion::EmotionType emotion, TimePoint expiration, int value);
     bool setEmotion(Emotion::EmotionType emotion, TimePoint targetValueTime, int targetValue, Emotion::TimeTargetType rampType);
     bool setEmotion(Emotion::EmotionType emotion, TimePoint targetValueTime, int targetValue, TimePoint expiration, Emotion::TimeTargetType rampType);
-    int getEmotionValue(Emotion::EmotionType emotion);
+    // Readers below use the published snapshot and never take managerMutex.
+    int getEmotionValue(Emotion::EmotionType emotion); // -1 if the emotion is not recognized
     std::vector<EmotionSimple> getAllEmotionsCurrent();
     float calculateEmotionalMatchScore(std::vector<EmotionRange> emotionRanges);
+    EmotionSnapshot getSnapshot() const;
     // API Interface
     HttpEndPointData_t getHttpEndpointData() override;
     std::string getInterfaceName() const override;
 
 private:
+    // Write-side emotion state, one array per field indexed by emotionSlot(), so a ramp tick
+    // walks contiguous data. Guarded by managerMutex.
+    struct EmotionTable {
+        std::array<int, EMOTION_SLOT_COUNT> currentValue {};
+        std::array<int, EMOTION_SLOT_COUNT> defaultValue {};
+        std::array<int, EMOTION_SLOT_COUNT> targetValue {};
+        std::array<int, EMOTION_SLOT_COUNT> rampStartValue {};
+        std::array<int, EMOTION_SLOT_COUNT> rampEndValue {};
+        std::array<Emotion::RampStage, EMOTION_SLOT_COUNT> rampStage {};
+        std::array<Emotion::TimeTargetType, EMOTION_SLOT_COUNT> timeTargetType {};
+        std::array<Emotion::TimeTargetType, EMOTION_SLOT_COUNT> expirationType {};
+        std::array<TimePoint, EMOTION_SLOT_COUNT> expirationTime {};
+        std::array<TimePoint, EMOTION_SLOT_COUNT> targetValueTime {};
+        std::array<TimePoint, EMOTION_SLOT_COUNT> rampStartTime {};
+        std::array<TimePoint, EMOTION_SLOT_COUNT> lastUpdate {};
+    };
+
     void managerThreadFunction(std::stop_token st);
-    Emotion curiosity;
-    Emotion playfulness;
-    Emotion empathy;
-    Emotion assertiveness;
-    Emotion attentiveness;
-    Emotion caution;
-    Emotion annoyance;
+    void syncToFixedValueLocked(size_t slot, int value);
+    void setCurrentValueLocked(size_t slot, int value, TimePoint now);
+    // Advance every active ramp to `now`. Returns true if any current value changed.
+    bool evaluateRampsLocked(TimePoint now);
+    // Earliest time the ramp state needs attention again, or nullopt when nothing is ramping.
+    std::optional<TimePoint> nextRampDeadlineLocked(TimePoint now) const;
+    void publishLocked();
+
+    EmotionTable table;
 
-    std::unordered_map<Emotion::EmotionType, Emotion&> emotions;
+    // Seqlock: publishLocked() (serialised by managerMutex) makes the sequence odd, stores the
+    // values, then makes it even again. Readers retry if they saw an odd or changed sequence.
+    std::atomic<uint64_t> snapshotSequence { 0 };
+    std::array<std::atomic<int>, EMOTION_SLOT_COUNT> snapshotValues {};
 
     std::jthread managerThread;
     std::mutex managerMutex;
+    std::condition_variable_any managerCV;
+    bool rampStateChanged = false;
 };
 
 }; // namespace Personality
@@ -36,6 +36,8 @@ SOFTWARE.
 // their intents when due. Exposes HTTP endpoints for control and CRUD.
 #include "scheduler.h"
 
+#include <algorithm>
+
 namespace DecisionEngine {
 
 std::vector<IntentCTorParams> getSystemSchedule()
@@ -62,7 +64,7 @@ std::vector<IntentCTorParams> getSystemSchedule()
 // This class will need to have a thread that runs in the background to monitor the triggers.
 // This class will also need to implement the API interface so that other apps can interact with it.
 
-ScheduledTask::ScheduledTaskHandle ScheduledTask::nextHandle = 1;
+std::atomic<ScheduledTask::ScheduledTaskHandle> ScheduledTask::nextHandle = 1;
 
 ScheduledTask::ScheduledTask(const std::shared_ptr<Intent>& intent, const TimePoint& time)
 {
@@ -70,6 +72,7 @@ ScheduledTask::ScheduledTask(const std::shared_ptr<Intent>& intent, const TimePo
     this->schedule.time = time;
     this->schedule.repeat = { RepeatInterval::Interval::REPEAT_NONE_ONE_SHOT, 0 };
     this->schedule.endTime = TimePoint();
+    this->anchorTime = time;
     this->handle = nextHandle++;
     this->enabled = true;
 }
@@ -80,6 +83,7 @@ ScheduledTask::ScheduledTask(const std::shared_ptr<Intent>& intent, const TimePo
     this->schedule.time = time;
     this->schedule.repeat = repeat;
     this->schedule.endTime = TimePoint();
+    this->anchorTime = time;
     this->handle = nextHandle++;
     this->enabled = true;
 }
@@ -90,6 +94,7 @@ ScheduledTask::ScheduledTask(const std::shared_ptr<Intent>& intent, const TimePo
     this->schedule.time = time;
     this->schedule.repeat = repeat;
     this->schedule.endTime = endTime;
+    this->anchorTime = time;
     this->handle = nextHandle++;
     this->enabled = true;
 }
@@ -119,6 +124,18 @@ void ScheduledTask::setEnabled(bool enabled)
     this->enabled = enabled;
 }
 
+bool ScheduledTask::isRepeating() const
+{
+    return schedule.repeat.interval != RepeatInterval::Interval::REPEAT_NONE_ONE_SHOT && schedule.repeat.value != 0;
+}
+
+void ScheduledTask::setTime(const TimePoint& time)
+{
+    schedule.time = time;
+    anchorTime = time;
+    occurrence = 0;
+}
+
 void ScheduledTask::executeIntent()
 {
     if (intent) {
@@ -127,15 +144,60 @@ void ScheduledTask::executeIntent()
     repeatCount++;
 }
 
+TimePoint ScheduledTask::nextOccurrence(const TimePoint& anchor, const RepeatInterval& repeat, uint64_t occurrence)
+{
+    using namespace std::chrono;
+    switch (repeat.interval) {
+    case RepeatInterval::Interval::REPEAT_NONE_ONE_SHOT:
+        return anchor;
+    case RepeatInterval::Interval::REPEAT_DAYS:
+    case RepeatInterval::Interval::REPEAT_WEEKS:
+    case RepeatInterval::Interval::REPEAT_CUSTOM:
+        return anchor + seconds(static_cast<int64_t>(repeat.toSeconds()) * static_cast<int64_t>(occurrence));
+    case RepeatInterval::Interval::REPEAT_MONTHS:
+    case RepeatInterval::Interval::REPEAT_YEARS: {
+        const auto anchorDay = floor<days>(anchor);
+        const auto timeOfDay = anchor - anchorDay;
+        const year_month_day anchorDate { anchorDay };
+        const auto step = static_cast<int64_t>(repeat.value) * static_cast<int64_t>(occurrence);
+        const auto shifted = repeat.interval == RepeatInterval::Interval::REPEAT_MONTHS
+            ? anchorDate.year() / anchorDate.month() + months(step)
+            : (anchorDate.year() + years(step)) / anchorDate.month();
+        // Clamp the anchor's day to the target month (Jan 31 + 1 month -> Feb 28/29).
+        const auto lastDay = year_month_day_last(shifted.year(), month_day_last(shifted.month())).day();
+        const year_month_day target { shifted.year(), shifted.month(), std::min(anchorDate.day(), lastDay) };
+        return time_point_cast<TimePoint::duration>(sys_days(target) + timeOfDay);
+    }
+    }
+    return anchor;
+}
+
 bool ScheduledTask::rescheduleAfterExecution()
 {
-    const auto repeatSeconds = schedule.repeat.toSeconds();
-    if (repeatSeconds == 0) {
+    return rescheduleAfterExecution(std::chrono::system_clock::now());
+}
+
+// Advance schedule.time to the first occurrence after `now`. Occurrences are counted from the anchor
+// so repeats neither drift by execution latency nor accumulate month-length rounding.
+bool ScheduledTask::rescheduleAfterExecution(const TimePoint& now)
+{
+    if (!isRepeating()) {
         enabled = false;
         return false;
     }
 
-    schedule.time = std::chrono::system_clock::now() + std::chrono::seconds(repeatSeconds);
+    if (schedule.repeat.interval != RepeatInterval::Interval::REPEAT_MONTHS
+        && schedule.repeat.interval != RepeatInterval::Interval::REPEAT_YEARS
+        && now > anchorTime) {
+        // Fixed-length intervals can jump straight past any missed occurrences.
+        const auto period = std::chrono::seconds(schedule.repeat.toSeconds());
+        occurrence = std::max<uint64_t>(occurrence, static_cast<uint64_t>((now - anchorTime) / period));
+    }
+    do {
+        ++occurrence;
+        schedule.time = nextOccurrence(anchorTime, schedule.repeat, occurrence);
+    } while (schedule.time <= now);
+
     if (schedule.endTime != TimePoint() && schedule.time > schedule.endTime) {
         enabled = false;
         return false;
@@ -148,6 +210,11 @@ bool ScheduledTask::rescheduleAfterExecution()
 // Start a background thread immediately; it idles until start() is called.
 Scheduler::Scheduler()
 {
+    for (size_t i = 0; i < SCHEDULER_WORKER_THREAD_COUNT; ++i) {
+        workerThreads.emplace_back([this](std::stop_token st) {
+            workerThreadFunction(st);
+        });
+    }
     schedulerThread = std::jthread([this](std::stop_token st) {
         schedulerThreadFunction(st);
     });
@@ -165,6 +232,11 @@ Scheduler::~Scheduler()
         schedulerCV.notify_all();
         schedulerThread.join();
     }
+    for (auto& worker : workerThreads) {
+        worker.request_stop();
+    }
+    workerCV.notify_all();
+    workerThreads.clear();
 }
 
 void Scheduler::start()
@@ -232,50 +304,236 @@ void Scheduler::setFunctionRegistry(std::shared_ptr<FunctionRegistry> functionRe
 
 uint32_t Scheduler::addTask(const ScheduledTask& task)
 {
-    std::unique_lock<std::mutex> lock(schedulerMutex);
-    scheduledTasks.push_back(task);
+    {
+        std::unique_lock<std::mutex> lock(schedulerMutex);
+        eraseTaskLocked(task.getHandle());
+        insertTaskLocked(task);
+    }
+    // The new task may be earlier than whatever the thread is currently sleeping towards.
+    schedulerCV.notify_all();
     return task.getHandle();
 }
 
 void Scheduler::removeTask(const std::shared_ptr<Intent>& intent)
 {
     std::unique_lock<std::mutex> lock(schedulerMutex);
-    for (auto it = scheduledTasks.begin(); it != scheduledTasks.end(); it++) {
-        if (it->getIntent() == intent) {
-            scheduledTasks.erase(it);
-            return;
-        }
+    auto it = handlesByIntent.find(intent.get());
+    if (it != handlesByIntent.end() && !it->second.empty()) {
+        eraseTaskLocked(*it->second.begin());
     }
 }
 
 void Scheduler::removeTask(const std::string& intentName)
 {
     std::unique_lock<std::mutex> lock(schedulerMutex);
-    for (auto it = scheduledTasks.begin(); it != scheduledTasks.end(); it++) {
-        if (it->getIntent()->getIntentName() == intentName) {
-            scheduledTasks.erase(it);
-            return;
-        }
+    auto it = handlesByIntentName.find(intentName);
+    if (it != handlesByIntentName.end() && !it->second.empty()) {
+        eraseTaskLocked(*it->second.begin());
     }
 }
 
 void Scheduler::removeTask(uint32_t taskHandle)
 {
     std::unique_lock<std::mutex> lock(schedulerMutex);
-    for (auto it = scheduledTasks.begin(); it != scheduledTasks.end(); it++) {
-        if (it->getHandle() == taskHandle) {
-            scheduledTasks.erase(it);
-            return;
+    eraseTaskLocked(taskHandle);
+}
+
+bool Scheduler::rescheduleTask(uint32_t taskHandle, const TimePoint& time)
+{
+    {
+        std::unique_lock<std::mutex> lock(schedulerMutex);
+        auto it = tasksByHandle.find(taskHandle);
+        if (it == tasksByHandle.end()) {
+            return false;
+        }
+        it->second.task.setTime(time);
+        const auto heapIndex = it->second.heapIndex;
+        if (heapIndex == PARKED_HEAP_INDEX) {
+            pushHeapEntryLocked(taskHandle, time);
+        } else {
+            dueHeap[heapIndex].due = time;
+            siftUpLocked(heapIndex);
+            siftDownLocked(tasksByHandle.at(taskHandle).heapIndex);
+        }
+    }
+    schedulerCV.notify_all();
+    return true;
+}
+
+bool Scheduler::setTaskEnabled(uint32_t taskHandle, bool enabled)
+{
+    {
+        std::unique_lock<std::mutex> lock(schedulerMutex);
+        auto it = tasksByHandle.find(taskHandle);
+        if (it == tasksByHandle.end()) {
+            return false;
+        }
+        it->second.task.setEnabled(enabled);
+        // A parked one-shot goes back on the heap at its original (possibly past) due time.
+        if (enabled && it->second.heapIndex == PARKED_HEAP_INDEX) {
+            pushHeapEntryLocked(taskHandle, it->second.task.getSchedule().time);
+        }
+    }
+    schedulerCV.notify_all();
+    return true;
+}
+
+size_t Scheduler::taskCount()
+{
+    std::unique_lock<std::mutex> lock(schedulerMutex);
+    return tasksByHandle.size();
+}
+
+std::optional<TimePoint> Scheduler::nextDueTime()
+{
+    std::unique_lock<std::mutex> lock(schedulerMutex);
+    if (dueHeap.empty()) {
+        return std::nullopt;
+    }
+    return dueHeap.front().due;
+}
+
+void Scheduler::insertTaskLocked(const ScheduledTask& task)
+{
+    const auto handle = task.getHandle();
+    tasksByHandle[handle] = TaskSlot { task, PARKED_HEAP_INDEX };
+    if (const auto& intent = task.getIntent()) {
+        handlesByIntentName[intent->getIntentName()].insert(handle);
+        handlesByIntent[intent.get()].insert(handle);
+    }
+    pushHeapEntryLocked(handle, task.getSchedule().time);
+}
+
+void Scheduler::pushHeapEntryLocked(ScheduledTask::ScheduledTaskHandle handle, const TimePoint& due)
+{
+    dueHeap.push_back({ due, handle });
+    tasksByHandle.at(handle).heapIndex = dueHeap.size() - 1;
+    siftUpLocked(dueHeap.size() - 1);
+}
+
+void Scheduler::eraseTaskLocked(ScheduledTask::ScheduledTaskHandle handle)
+{
+    auto it = tasksByHandle.find(handle);
+    if (it == tasksByHandle.end()) {
+        return;
+    }
+    if (const auto& intent = it->second.task.getIntent()) {
+        auto nameIt = handlesByIntentName.find(intent->getIntentName());
+        if (nameIt != handlesByIntentName.end()) {
+            nameIt->second.erase(handle);
+            if (nameIt->second.empty()) {
+                handlesByIntentName.erase(nameIt);
+            }
+        }
+        auto ptrIt = handlesByIntent.find(intent.get());
+        if (ptrIt != handlesByIntent.end()) {
+            ptrIt->second.erase(handle);
+            if (ptrIt->second.empty()) {
+                handlesByIntent.erase(ptrIt);
+            }
+        }
+    }
+    const auto heapIndex = it->second.heapIndex;
+    tasksByHandle.erase(it);
+    if (heapIndex != PARKED_HEAP_INDEX) {
+        eraseHeapEntryLocked(heapIndex);
+    }
+}
+
+void Scheduler::eraseHeapEntryLocked(size_t index)
+{
+    const auto last = dueHeap.size() - 1;
+    if (index != last) {
+        swapHeapEntriesLocked(index, last);
+    }
+    dueHeap.pop_back();
+    if (index < dueHeap.size()) {
+        siftUpLocked(index);
+        siftDownLocked(index);
+    }
+}
+
+void Scheduler::swapHeapEntriesLocked(size_t a, size_t b)
+{
+    std::swap(dueHeap[a], dueHeap[b]);
+    // Entries already removed from tasksByHandle (mid-erase) have no slot to update.
+    if (auto it = tasksByHandle.find(dueHeap[a].handle); it != tasksByHandle.end()) {
+        it->second.heapIndex = a;
+    }
+    if (auto it = tasksByHandle.find(dueHeap[b].handle); it != tasksByHandle.end()) {
+        it->second.heapIndex = b;
+    }
+}
+
+void Scheduler::siftUpLocked(size_t index)
+{
+    while (index > 0) {
+        const auto parent = (index - 1) / 2;
+        if (dueHeap[parent].due <= dueHeap[index].due) {
+            break;
+        }
+        swapHeapEntriesLocked(parent, index);
+        index = parent;
+    }
+}
+
+void Scheduler::siftDownLocked(size_t index)
+{
+    const auto size = dueHeap.size();
+    while (true) {
+        const auto left = index * 2 + 1;
+        const auto right = left + 1;
+        auto smallest = index;
+        if (left < size && dueHeap[left].due < dueHeap[smallest].due) {
+            smallest = left;
+        }
+        if (right < size && dueHeap[right].due < dueHeap[smallest].due) {
+            smallest = right;
+        }
+        if (smallest == index) {
+            break;
+        }
+        swapHeapEntriesLocked(index, smallest);
+        index = smallest;
+    }
+}
+
+void Scheduler::dispatchIntent(std::shared_ptr<Intent> intent)
+{
+    {
+        std::lock_guard<std::mutex> lock(workerMutex);
+        pendingIntents.push_back(std::move(intent));
+    }
+    workerCV.notify_one();
+}
+
+void Scheduler::workerThreadFunction(std::stop_token st)
+{
+    while (!st.stop_requested()) {
+        std::shared_ptr<Intent> intent;
+        {
+            std::unique_lock<std::mutex> lock(workerMutex);
+            if (!workerCV.wait(lock, st, [this]() { return !pendingIntents.empty(); })) {
+                break;
+            }
+            intent = std::move(pendingIntents.front());
+            pendingIntents.pop_front();
+        }
+        try {
+            intent->execute();
+        } catch (const std::exception& e) {
+            CubeLog::error("Scheduler: intent " + intent->getIntentName() + " threw: " + e.what());
         }
     }
 }
 
-// Thread loop: waits for start(), then cycles until paused/stopped, executing
-// any due tasks. Repeats are not yet re-enqueued (TODO noted below).
+// Thread loop: waits for start(), then fires every task whose due time has passed and sleeps until
+// the next deadline. Mutations notify schedulerCV so an earlier task or a removal is picked up
+// immediately.
 void Scheduler::schedulerThreadFunction(std::stop_token st)
 {
+    std::unique_lock<std::mutex> lock(schedulerMutex);
     while (!st.stop_requested()) {
-        std::unique_lock<std::mutex> lock(schedulerMutex);
         schedulerCV.wait(lock, [this, &st]() {
             return st.stop_requested() || (schedulerRunning && !schedulerPaused);
         });
@@ -284,32 +542,40 @@ void Scheduler::schedulerThreadFunction(std::stop_token st)
         }
 
         const auto now = std::chrono::system_clock::now();
-        for (auto it = scheduledTasks.begin(); it != scheduledTasks.end();) {
-            if (!it->isEnabled() || it->getSchedule().time > now) {
-                ++it;
+        while (!dueHeap.empty() && dueHeap.front().due <= now) {
+            const auto handle = dueHeap.front().handle;
+            auto& slot = tasksByHandle.at(handle);
+            auto intent = slot.task.getIntent();
+            // Disabled repeating tasks stay scheduled but skip this occurrence. Disabled one-shots are
+            // parked until they are re-enabled, rescheduled or removed.
+            const bool enabled = slot.task.isEnabled();
+            if (!enabled && !slot.task.isRepeating()) {
+                eraseHeapEntryLocked(0);
+                slot.heapIndex = PARKED_HEAP_INDEX;
                 continue;
             }
-
-            auto intent = it->getIntent();
-            const bool repeating = it->rescheduleAfterExecution();
-            if (!repeating) {
-                it = scheduledTasks.erase(it);
+            if (slot.task.rescheduleAfterExecution(now)) {
+                dueHeap.front().due = slot.task.getSchedule().time;
+                siftDownLocked(0);
             } else {
-                ++it;
+                eraseTaskLocked(handle);
             }
-
-            lock.unlock();
-            if (intent) {
-                intent->execute();
+            if (enabled && intent) {
+                dispatchIntent(std::move(intent));
             }
-            lock.lock();
         }
 
-        schedulerCV.wait_for(lock, std::chrono::milliseconds(SCHEDULER_THREAD_SLEEP_MS), [this, &st]() {
-            return st.stop_requested() || !schedulerRunning || schedulerPaused;
-        });
-        if (!schedulerRunning || schedulerPaused) {
-            continue;
+        if (dueHeap.empty()) {
+            schedulerCV.wait(lock, [this, &st]() {
+                return st.stop_requested() || !schedulerRunning || schedulerPaused || !dueHeap.empty();
+            });
+        } else {
+            const auto deadline = dueHeap.front().due;
+            const auto heapSize = dueHeap.size();
+            schedulerCV.wait_until(lock, deadline, [this, &st, deadline, heapSize]() {
+                return st.stop_requested() || !schedulerRunning || schedulerPaused
+                    || dueHeap.empty() || dueHeap.front().due != deadline || dueHeap.size() != heapSize;
+            });
         }
     }
 }
@@ -394,7 +660,16 @@ HttpEndPointData_t Scheduler::getHttpEndpointData()
             // Take a snapshot under mutex; include handle, enable state, due time, repeat interval, and intent name.
             std::scoped_lock lk(this->schedulerMutex);
             nlohmann::json j; j["success"] = true; j["tasks"] = nlohmann::json::array();
-            for (auto& t : scheduledTasks) {
+            std::vector<const ScheduledTask*> ordered;
+            ordered.reserve(tasksByHandle.size());
+            for (const auto& [handle, slot] : tasksByHandle) {
+                ordered.push_back(&slot.task);
+            }
+            std::sort(ordered.begin(), ordered.end(), [](const ScheduledTask* a, const ScheduledTask* b) {
+                return a->getSchedule().time < b->getSchedule().time;
+            });
+            for (const auto* task : ordered) {
+                const auto& t = *task;
                 nlohmann::json tj;
                 auto tp = std::chrono::time_point_cast<std::chrono::milliseconds>(t.getSchedule().time);
                 tj["handle"] = t.getHandle();
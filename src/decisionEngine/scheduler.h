@@ -36,18 +36,24 @@ SOFTWARE.
 //
 // Responsibilities
 // - Persist and manage a set of ScheduledTask entries (one-shot or repeating)
-// - Wake on an internal cadence (SCHEDULER_THREAD_SLEEP_MS) to evaluate due tasks
+// - Keep tasks in an indexed min-heap ordered by next due time; add/remove/reschedule are O(log n)
 // - Execute the bound Intent when a task becomes due
 // - Expose a lightweight HTTP API for control (start/stop/pause/resume) and CRUD on tasks
 //
 // Threading model
-// - A std::jthread runs schedulerThreadFunction, sleeping between evaluations
+// - A std::jthread runs schedulerThreadFunction, sleeping until the earliest deadline or until a
+//   mutation notifies schedulerCV
 // - Public mutators guard shared state with a mutex + condition_variable
-// - Intent execution happens on the scheduler thread; long work should be offloaded by the intent itself
+// - Due intents are handed to a small worker pool (SCHEDULER_WORKER_THREAD_COUNT) so one slow intent
+//   cannot delay the others or the timer thread
 //
 // Time semantics
-// - ScheduleType::time uses system_clock; repeats are expressed in seconds via RepeatInterval::toSeconds
-// - REPEAT_CUSTOM interprets value as seconds from the last start time
+// - ScheduleType::time uses system_clock
+// - Occurrences are computed from the first due time, not from when the previous run finished, so
+//   repeats do not drift. Missed occurrences (e.g. while paused) are skipped, not replayed.
+// - REPEAT_DAYS/WEEKS/CUSTOM add a fixed number of seconds per occurrence
+// - REPEAT_MONTHS/YEARS use calendar arithmetic (UTC). Day-of-month is clamped, so a task anchored on
+//   Jan 31 fires Feb 28/29 and then Mar 31 again.
 #pragma once
 #include "../database/cubeDB.h"
 #include "utils.h"
@@ -60,13 +66,18 @@ SOFTWARE.
 #include "nlohmann/json.hpp"
 #include "remoteServer.h"
 #include <chrono>
+#include <atomic>
 #include <condition_variable>
+#include <cstdint>
+#include <deque>
 #include <functional>
 #include <future>
 #include <iostream>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <regex>
+#include <set>
 #include <signal.h>
 #include <stdexcept>
 #include <string>
@@ -81,7 +92,7 @@ SOFTWARE.
 #include "personalityManager.h"
 #include "intentRegistry.h"
 #include "functionRegistry.h"
-#define SCHEDULER_THREAD_SLEEP_MS 100
+#define SCHEDULER_WORKER_THREAD_COUNT 2
 
 namespace DecisionEngine {
 
@@ -110,7 +121,8 @@ public:
         {
             return !(*this == other);
         }
-        // Convert to seconds. CUSTOM returns value unmodified.
+        // Convert to seconds. CUSTOM returns value unmodified. MONTHS/YEARS are approximate here;
+        // ScheduledTask::nextOccurrence() uses calendar arithmetic for those.
         uint32_t toSeconds() const
         {
             switch (interval) {
@@ -146,7 +158,7 @@ public:
     ScheduledTask(const std::shared_ptr<Intent>& intent, const TimePoint& time, const RepeatInterval& repeat);
     ScheduledTask(const std::shared_ptr<Intent>& intent, const TimePoint& time, const RepeatInterval& repeat, const TimePoint& endTime);
     ScheduledTask(const std::shared_ptr<Intent>& intent, const ScheduleType& schedule) 
-        : intent(intent), schedule(schedule)
+        : schedule(schedule), intent(intent), anchorTime(schedule.time)
     {
         this->handle = nextHandle++;
         this->enabled = true;
@@ -155,26 +167,30 @@ public:
     const std::shared_ptr<Intent>& getIntent() const;// Access bound intent
     bool isEnabled() const;                          // Whether the task is considered by the scheduler
     void setEnabled(bool enabled);                   // Enable/disable without removing from list
+    bool isRepeating() const;                        // False for one-shots (including a zero repeat value)
+    void setTime(const TimePoint& time);             // Move the next due time; repeats re-anchor here
     ScheduledTaskHandle getHandle() const;           // Stable identifier for CRUD operations
     void executeIntent();                            // Invoke the bound intent (increments repeatCount)
     bool rescheduleAfterExecution();                 // Update next due time for repeating tasks
+    bool rescheduleAfterExecution(const TimePoint& now);
+    // Due time of the given occurrence (0 = the first due time) according to the repeat rule.
+    static TimePoint nextOccurrence(const TimePoint& anchor, const RepeatInterval& repeat, uint64_t occurrence);
 
 private:
     ScheduleType schedule = { TimePoint(), { RepeatInterval::Interval::REPEAT_NONE_ONE_SHOT, 0 }, TimePoint() };
     std::shared_ptr<Intent> intent;
     bool enabled = false;
-    static ScheduledTaskHandle nextHandle;
+    static std::atomic<ScheduledTaskHandle> nextHandle;
     ScheduledTaskHandle handle = 0;
     unsigned int repeatCount = 0; // Number of times this task has executed
+    TimePoint anchorTime;         // First due time; repeats are computed from here
+    uint64_t occurrence = 0;      // Index of the occurrence schedule.time currently points at
 };
 
 /////////////////////////////////////////////////////////////////////////////////////
 
 class Scheduler : public AutoRegisterAPI<Scheduler> {
 public:
-    // A vector of scheduled tasks
-    using ScheduledTaskList = std::vector<ScheduledTask>;
-
     // Lifecycle
     Scheduler();
     ~Scheduler();
@@ -191,22 +207,62 @@ public:
     void removeTask(const std::shared_ptr<Intent>& intent);     // Remove by pointer match
     void removeTask(const std::string& intentName);             // Remove by intent name
     void removeTask(uint32_t taskHandle);                       // Remove by handle
+    bool rescheduleTask(uint32_t taskHandle, const TimePoint& time); // Move a task's next due time
+    bool setTaskEnabled(uint32_t taskHandle, bool enabled);         // Enable/disable a task in place
+    size_t taskCount();
+    std::optional<TimePoint> nextDueTime();
 
     // API Interface
     HttpEndPointData_t getHttpEndpointData() override; // Expose control + CRUD endpoints
     std::string getInterfaceName() const override;     // For API discovery
 
 private:
+    // Disabled one-shots that come due leave the heap but keep their slot, so re-enabling or
+    // rescheduling them later still fires them.
+    static constexpr size_t PARKED_HEAP_INDEX = SIZE_MAX;
+    struct TaskSlot {
+        ScheduledTask task;
+        size_t heapIndex = 0;
+    };
+    struct HeapEntry {
+        TimePoint due;
+        ScheduledTask::ScheduledTaskHandle handle = 0;
+    };
+
     std::shared_ptr<I_IntentRecognition> intentRecognition;
     std::weak_ptr<IntentRegistry> intentRegistry;
     std::shared_ptr<FunctionRegistry> functionRegistry;
-    ScheduledTaskList scheduledTasks;
+
+    // Min-heap on due time. Each slot records where its entry lives so removal and rescheduling by
+    // handle do not need a scan. Handles are ordered in the secondary indexes so removal by intent
+    // keeps the old "first added wins" behaviour.
+    std::vector<HeapEntry> dueHeap;
+    std::unordered_map<ScheduledTask::ScheduledTaskHandle, TaskSlot> tasksByHandle;
+    std::unordered_map<std::string, std::set<ScheduledTask::ScheduledTaskHandle>> handlesByIntentName;
+    std::unordered_map<const Intent*, std::set<ScheduledTask::ScheduledTaskHandle>> handlesByIntent;
+
     std::jthread schedulerThread;
     std::mutex schedulerMutex;
     std::condition_variable schedulerCV;
     bool schedulerRunning = false;
     bool schedulerPaused = false;
-    void schedulerThreadFunction(std::stop_token st);  // Main loop; evaluates due tasks and sleeps
+    void schedulerThreadFunction(std::stop_token st);  // Main loop; fires due tasks and sleeps until the next deadline
+
+    // Worker pool that runs due intents off the timer thread.
+    std::vector<std::jthread> workerThreads;
+    std::deque<std::shared_ptr<Intent>> pendingIntents;
+    std::mutex workerMutex;
+    std::condition_variable_any workerCV;
+    void workerThreadFunction(std::stop_token st);
+    void dispatchIntent(std::shared_ptr<Intent> intent);
+
+    void insertTaskLocked(const ScheduledTask& task);
+    void pushHeapEntryLocked(ScheduledTask::ScheduledTaskHandle handle, const TimePoint& due);
+    void eraseTaskLocked(ScheduledTask::ScheduledTaskHandle handle);
+    void eraseHeapEntryLocked(size_t index);
+    void swapHeapEntriesLocked(size_t a, size_t b);
+    void siftUpLocked(size_t index);
+    void siftDownLocked(size_t index);
 };
 
 }
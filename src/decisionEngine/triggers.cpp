@@ -31,23 +31,65 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
 
-// Triggers implementation: time- and event-based fireables plus a manager
-// that polls and exposes HTTP control to create, enable, fire, and list.
+// Triggers implementation: time- and event-based fireables plus a manager that routes events,
+// keeps the shared time/poll deadlines, and exposes HTTP control to create, enable, fire, and list.
 #include "triggers.h"
 
 namespace DecisionEngine {
 
+namespace {
+
+// InteractionEvents are subscribed to directly; the copies InteractionEventBridge forwards to the
+// broker are ignored so each tap or lift is delivered once.
+constexpr const char* kInteractionSource = "interaction";
+constexpr const char* kSettingsSource = "settings";
+
+std::string subscriptionKey(const std::string& source, const std::string& event)
+{
+    return source + '\n' + event;
+}
+
+// Latency histograms count whole microseconds; round up so sub-microsecond work is not recorded as 0.
+uint64_t microsecondsRoundedUp(std::chrono::steady_clock::duration elapsed)
+{
+    return static_cast<uint64_t>(std::chrono::ceil<std::chrono::microseconds>(elapsed).count());
+}
+
+} // namespace
+
 TriggerManager::TriggerHandle TriggerManager::nextHandle = 0;
 
 // I_Trigger base helpers
 bool I_Trigger::isEnabled() const { return enabled; }
-void I_Trigger::setEnabled(bool en) { enabled = en; }
+void I_Trigger::setEnabled(bool en)
+{
+    enabled = en;
+    notifyChanged();
+}
 bool I_Trigger::getTriggerState() const { return triggerState; }
 void I_Trigger::setTriggerFunction(std::function<void()> fn) { triggerFunction = std::move(fn); }
 void I_Trigger::setCheckTrigger(std::function<bool()> fn) { checkTrigger = std::move(fn); }
 bool I_Trigger::hasCheck() const { return (bool)checkTrigger; }
 bool I_Trigger::evaluateCheck() const { return checkTrigger ? checkTrigger() : false; }
 
+void I_Trigger::setChangeListener(std::function<void()> listener)
+{
+    std::scoped_lock lk(changeListenerMutex);
+    changeListener = std::move(listener);
+}
+
+void I_Trigger::notifyChanged()
+{
+    std::function<void()> listener;
+    {
+        std::scoped_lock lk(changeListenerMutex);
+        listener = changeListener;
+    }
+    if (listener) {
+        listener();
+    }
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 // TimeTrigger
 
@@ -85,17 +127,22 @@ void TimeTrigger::trigger()
     bool ok = true;
     if (auto ct = this->checkTrigger)
         ok = ct();
-    if (ok) {
-        triggerState = true;
-        if (triggerFunction)
-            triggerFunction();
-        setEnabled(false);
-    }
+    if (ok)
+        fire();
+}
+
+void TimeTrigger::fire()
+{
+    triggerState = true;
+    if (triggerFunction)
+        triggerFunction();
+    setEnabled(false);
 }
 
 void TimeTrigger::setTime(const TimePoint& t)
 {
     time = t;
+    notifyChanged();
 }
 
 const TimePoint& TimeTrigger::getTime() const { return time; }
@@ -128,11 +175,15 @@ void EventTrigger::trigger()
     bool ok = true;
     if (auto ct = this->checkTrigger)
         ok = ct();
-    if (ok) {
-        triggerState = true;
-        if (triggerFunction)
-            triggerFunction();
-    }
+    if (ok)
+        fire();
+}
+
+void EventTrigger::fire()
+{
+    triggerState = true;
+    if (triggerFunction)
+        triggerFunction();
 }
 
 void EventTrigger::setScheduler(std::shared_ptr<Scheduler> s)
@@ -140,62 +191,500 @@ void EventTrigger::setScheduler(std::shared_ptr<Scheduler> s)
     scheduler = s;
 }
 
+void EventTrigger::subscribe(const std::string& source, const std::string& event)
+{
+    subscriptions.push_back({ source, event });
+}
+
+const std::vector<EventTrigger::Subscription>& EventTrigger::getSubscriptions() const
+{
+    return subscriptions;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 // TriggerManager
 
 TriggerManager::TriggerManager()
 {
+    auto& metrics = Metrics::MetricsRegistry::instance();
+    for (size_t i = 0; i < kindMetrics.size(); ++i) {
+        const Metrics::Labels labels { { "kind", kindToString(static_cast<TriggerKind>(i)) } };
+        kindMetrics[i].evaluations = metrics.counter("trigger_evaluations_total", "Trigger check evaluations", labels);
+        kindMetrics[i].fires = metrics.counter("trigger_fires_total", "Triggers fired", labels);
+        kindMetrics[i].evaluationLatencyUs = metrics.histogram("trigger_evaluation_latency_us", "Microseconds spent evaluating a trigger check", labels);
+    }
+    eventDispatchLatencyUs = metrics.histogram("trigger_event_dispatch_latency_us", "Microseconds from notifyEvent to trigger evaluation");
+    subscribeEventSources();
     ensurePollThreadStarted();
 }
 
 TriggerManager::TriggerManager(const std::shared_ptr<Scheduler>& s)
+    : TriggerManager()
 {
     setScheduler(s);
-    ensurePollThreadStarted();
 }
 
 TriggerManager::~TriggerManager()
 {
     stop();
+    {
+        std::scoped_lock lk(mtx);
+        for (const auto& [key, id] : settingSubscriptions) {
+            GlobalSettings::removeSettingCB(id);
+        }
+        settingSubscriptions.clear();
+    }
+    if (callbackGate) {
+        std::lock_guard<std::mutex> lock(callbackGate->mutex);
+        callbackGate->owner = nullptr;
+    }
+    callbackGate.reset();
+    if (interactionEventsHandle != 0) {
+        InteractionEvents::unsubscribe(interactionEventsHandle);
+    }
+    if (eventBroker && eventBrokerListener != 0) {
+        eventBroker->removeListener(eventBrokerListener);
+    }
     if (pollThread.joinable()) {
         pollThread.request_stop();
         pollThread.join();
     }
 }
 
+void TriggerManager::subscribeEventSources()
+{
+    callbackGate = std::make_shared<CallbackGate>();
+    callbackGate->owner = this;
+    interactionEventsHandle = InteractionEvents::subscribe([this](const InteractionEvent& event) {
+        notifyEvent(kInteractionSource, interactionEventTypeToString(event.type));
+    });
+}
+
+void TriggerManager::attachEventBroker(std::shared_ptr<ApiEventBroker> broker)
+{
+    if (eventBroker && eventBrokerListener != 0) {
+        eventBroker->removeListener(eventBrokerListener);
+        eventBrokerListener = 0;
+    }
+    eventBroker = std::move(broker);
+    if (!eventBroker) {
+        return;
+    }
+    const std::weak_ptr<CallbackGate> weakGate = callbackGate;
+    eventBrokerListener = eventBroker->addListener([weakGate](const ApiEvent& event) {
+        if (event.source == kInteractionSource) {
+            return;
+        }
+        if (auto gate = weakGate.lock()) {
+            std::lock_guard<std::mutex> lock(gate->mutex);
+            if (gate->owner) {
+                gate->owner->notifyEvent(event.source, event.event);
+            }
+        }
+    });
+}
+
 void TriggerManager::ensurePollThreadStarted()
 {
     if (pollThread.joinable()) {
         return;
     }
     pollThread = std::jthread([this](std::stop_token st) {
-        while (!st.stop_requested()) {
-            {
-                std::scoped_lock lk(mtx);
-                if (pollingEnabled) {
-                    for (auto& kv : triggers) {
-                        auto& trig = kv.second;
-                        if (trig && trig->isEnabled() && trig->hasCheck() && trig->evaluateCheck()) {
-                            trig->trigger();
-                        }
-                    }
+        pollLoop(st);
+    });
+}
+
+// Sleep until the earliest queued event, time deadline or poll deadline; evaluate everything that
+// is due outside the lock; repeat. Nothing is evaluated on a fixed tick.
+void TriggerManager::pollLoop(std::stop_token st)
+{
+    std::vector<PendingEvaluation> due;
+    while (!st.stop_requested()) {
+        due.clear();
+        {
+            std::unique_lock<std::mutex> lk(mtx);
+            std::optional<std::chrono::steady_clock::time_point> wakeAt;
+            if (pollingEnabled && pendingEvents.empty()) {
+                if (!pollQueue.empty()) {
+                    wakeAt = pollQueue.begin()->first;
+                }
+                if (!timeQueue.empty()) {
+                    const auto untilTime = timeQueue.begin()->first - std::chrono::system_clock::now();
+                    const auto timeWake = std::chrono::steady_clock::now()
+                        + std::chrono::duration_cast<std::chrono::steady_clock::duration>(untilTime);
+                    wakeAt = wakeAt ? std::min(*wakeAt, timeWake) : timeWake;
                 }
+                if (wakeAt) {
+                    wakeCV.wait_until(lk, st, *wakeAt, [this]() { return wakeRequested; });
+                } else {
+                    wakeCV.wait(lk, st, [this]() { return wakeRequested; });
+                }
+            } else if (!pollingEnabled) {
+                wakeCV.wait(lk, st, [this]() { return wakeRequested; });
+            }
+            wakeRequested = false;
+            if (st.stop_requested()) {
+                break;
+            }
+            if (!pollingEnabled) {
+                pendingEvents.clear();
+                continue;
+            }
+            collectDueLocked(due);
+        }
+        for (const auto& pending : due) {
+            evaluate(pending);
+        }
+    }
+}
+
+void TriggerManager::collectDueLocked(std::vector<PendingEvaluation>& due)
+{
+    const auto steadyNow = std::chrono::steady_clock::now();
+    while (!pendingEvents.empty()) {
+        const auto pendingEvent = std::move(pendingEvents.front());
+        pendingEvents.pop_front();
+        eventDispatchLatencyUs->record(microsecondsRoundedUp(steadyNow - pendingEvent.queuedAt));
+        // A trigger subscribed to both (source, event) and (source, "") is evaluated once per event.
+        const size_t firstForEvent = due.size();
+        for (const auto& key : { subscriptionKey(pendingEvent.source, pendingEvent.event), subscriptionKey(pendingEvent.source, "") }) {
+            auto it = subscribers.find(key);
+            if (it == subscribers.end()) {
+                continue;
+            }
+            for (const auto handle : it->second) {
+                const auto alreadyDue = std::any_of(due.begin() + firstForEvent, due.end(), [handle](const PendingEvaluation& pending) { return pending.handle == handle; });
+                if (alreadyDue) {
+                    continue;
+                }
+                const auto& entry = triggers.at(handle);
+                due.push_back({ handle, entry.trigger, entry.kind, false, entry.lastCheck });
+            }
+        }
+    }
+
+    const auto systemNow = std::chrono::system_clock::now();
+    while (!timeQueue.empty() && timeQueue.begin()->first <= systemNow) {
+        const auto handle = timeQueue.begin()->second;
+        timeQueue.erase(timeQueue.begin());
+        auto& entry = triggers.at(handle);
+        entry.armedTime.reset();
+        due.push_back({ handle, entry.trigger, entry.kind, false, entry.lastCheck });
+    }
+
+    while (!pollQueue.empty() && pollQueue.begin()->first <= steadyNow) {
+        const auto handle = pollQueue.begin()->second;
+        pollQueue.erase(pollQueue.begin());
+        auto& entry = triggers.at(handle);
+        entry.nextPoll.reset();
+        due.push_back({ handle, entry.trigger, entry.kind, true, entry.lastCheck });
+    }
+}
+
+// Evaluate one trigger. Event and time triggers fire whenever their check passes; polled
+// predicates fire only on the false -> true edge so a condition that stays true fires once.
+void TriggerManager::evaluate(const PendingEvaluation& pending)
+{
+    const auto& trig = pending.trigger;
+    if (!trig) {
+        return;
+    }
+    const bool enabled = trig->isEnabled();
+    bool passed = false;
+    bool fired = false;
+    double elapsedUs = 0.0;
+    uint64_t evaluationLatencyUs = 0;
+    if (enabled) {
+        const auto started = std::chrono::steady_clock::now();
+        try {
+            passed = !trig->hasCheck() || trig->evaluateCheck();
+        } catch (const std::exception& e) {
+            CubeLog::error("TriggerManager: check for trigger " + std::to_string(pending.handle) + " threw: " + e.what());
+        }
+        const auto elapsed = std::chrono::steady_clock::now() - started;
+        elapsedUs = std::chrono::duration<double, std::micro>(elapsed).count();
+        evaluationLatencyUs = microsecondsRoundedUp(elapsed);
+        fired = pending.kind == TriggerKind::PREDICATE ? passed && !pending.lastCheck : passed;
+        if (fired) {
+            try {
+                trig->fire();
+            } catch (const std::exception& e) {
+                CubeLog::error("TriggerManager: trigger " + std::to_string(pending.handle) + " threw: " + e.what());
+            }
+        }
+        auto& metrics = kindMetrics[static_cast<size_t>(pending.kind)];
+        metrics.evaluations->increment();
+        metrics.evaluationLatencyUs->record(evaluationLatencyUs);
+        if (fired) {
+            metrics.fires->increment();
+        }
+    }
+
+    std::scoped_lock lk(mtx);
+    auto it = triggers.find(pending.handle);
+    if (it == triggers.end() || it->second.trigger != trig) {
+        return;
+    }
+    auto& entry = it->second;
+    if (enabled) {
+        entry.stats.evaluations++;
+        entry.stats.lastEvaluationUs = elapsedUs;
+        entry.stats.maxEvaluationUs = std::max(entry.stats.maxEvaluationUs, elapsedUs);
+        entry.stats.totalEvaluationUs += elapsedUs;
+        if (fired) {
+            entry.stats.fires++;
+        }
+    }
+    if (entry.kind == TriggerKind::PREDICATE && pending.polled) {
+        // Back off while nothing changes; snap back to the fastest rate on any change. Disabled
+        // predicates keep a slow poll so enabling them directly on the trigger still works.
+        if (!enabled) {
+            entry.pollInterval = std::chrono::milliseconds(TRIGGER_POLL_MAX_INTERVAL_MS);
+        } else if (passed != entry.lastCheck) {
+            entry.pollInterval = std::chrono::milliseconds(TRIGGER_POLL_MIN_INTERVAL_MS);
+        } else {
+            entry.pollInterval = std::min(entry.pollInterval * 2, std::chrono::milliseconds(TRIGGER_POLL_MAX_INTERVAL_MS));
+        }
+        entry.lastCheck = enabled && passed;
+        if (!entry.nextPoll) {
+            entry.nextPoll = std::chrono::steady_clock::now() + entry.pollInterval;
+            pollQueue.insert({ *entry.nextPoll, pending.handle });
+        }
+    } else if (entry.kind == TriggerKind::TIME && enabled && !fired && trig->isEnabled() && !entry.nextPoll) {
+        // A custom check held the time trigger back; keep asking at the fastest poll rate.
+        entry.nextPoll = std::chrono::steady_clock::now() + std::chrono::milliseconds(TRIGGER_POLL_MIN_INTERVAL_MS);
+        pollQueue.insert({ *entry.nextPoll, pending.handle });
+    }
+}
+
+void TriggerManager::armLocked(TriggerHandle handle, TriggerEntry& entry)
+{
+    disarmLocked(handle, entry);
+    switch (entry.kind) {
+    case TriggerKind::TIME:
+        if (auto timeTrigger = std::dynamic_pointer_cast<TimeTrigger>(entry.trigger)) {
+            entry.armedTime = timeTrigger->getTime();
+            timeQueue.insert({ *entry.armedTime, handle });
+        }
+        break;
+    case TriggerKind::PREDICATE:
+        entry.lastCheck = false;
+        entry.pollInterval = std::chrono::milliseconds(TRIGGER_POLL_MIN_INTERVAL_MS);
+        entry.nextPoll = std::chrono::steady_clock::now();
+        pollQueue.insert({ *entry.nextPoll, handle });
+        break;
+    case TriggerKind::EVENT:
+    case TriggerKind::MANUAL:
+    case TriggerKind::COUNT:
+        break;
+    }
+    wakeLocked();
+}
+
+void TriggerManager::disarmLocked(TriggerHandle handle, TriggerEntry& entry)
+{
+    if (entry.armedTime) {
+        timeQueue.erase({ *entry.armedTime, handle });
+        entry.armedTime.reset();
+    }
+    if (entry.nextPoll) {
+        pollQueue.erase({ *entry.nextPoll, handle });
+        entry.nextPoll.reset();
+    }
+}
+
+// Each setting is hooked at most once and unhooked in ~TriggerManager. A callback already running on
+// the settings thread can outlive the removal, so it goes through callbackGate.
+void TriggerManager::subscribeSettingLocked(const std::string& settingName)
+{
+    std::vector<std::pair<std::string, GlobalSettings::SettingType>> settings;
+    if (settingName.empty()) {
+        for (const auto& [name, key] : GlobalSettings::stringSettingTypeMap) {
+            settings.push_back({ name, key });
+        }
+    } else {
+        auto it = GlobalSettings::stringSettingTypeMap.find(settingName);
+        if (it == GlobalSettings::stringSettingTypeMap.end()) {
+            CubeLog::warning("TriggerManager: unknown setting for trigger subscription: " + settingName);
+            return;
+        }
+        settings.push_back({ it->first, it->second });
+    }
+    const std::weak_ptr<CallbackGate> weakGate = callbackGate;
+    for (const auto& [name, key] : settings) {
+        if (settingSubscriptions.contains(key)) {
+            continue;
+        }
+        settingSubscriptions[key] = GlobalSettings::setSettingCB(key, std::function<void()>([weakGate, name]() {
+            if (auto gate = weakGate.lock()) {
+                std::lock_guard<std::mutex> lock(gate->mutex);
+                if (gate->owner) {
+                    gate->owner->notifyEvent(kSettingsSource, name);
+                }
+            }
+        }));
+    }
+}
+
+void TriggerManager::wakeLocked()
+{
+    wakeRequested = true;
+    wakeCV.notify_all();
+}
+
+const char* TriggerManager::kindToString(TriggerKind kind)
+{
+    switch (kind) {
+    case TriggerKind::TIME:
+        return "time";
+    case TriggerKind::EVENT:
+        return "event";
+    case TriggerKind::PREDICATE:
+        return "predicate";
+    case TriggerKind::MANUAL:
+        return "manual";
+    case TriggerKind::COUNT:
+        break;
+    }
+    return "unknown";
+}
+
+TriggerManager::TriggerHandle TriggerManager::addTrigger(std::shared_ptr<I_Trigger> trigger)
+{
+    if (!trigger) {
+        throw std::invalid_argument("TriggerManager::addTrigger: null trigger");
+    }
+    TriggerEntry entry;
+    entry.trigger = trigger;
+    if (std::dynamic_pointer_cast<TimeTrigger>(trigger)) {
+        entry.kind = TriggerKind::TIME;
+    } else if (auto eventTrigger = std::dynamic_pointer_cast<EventTrigger>(trigger); eventTrigger && !eventTrigger->getSubscriptions().empty()) {
+        entry.kind = TriggerKind::EVENT;
+        for (const auto& subscription : eventTrigger->getSubscriptions()) {
+            entry.subscriptionKeys.push_back(subscriptionKey(subscription.source, subscription.event));
+        }
+    } else if (trigger->hasCheck()) {
+        entry.kind = TriggerKind::PREDICATE;
+    } else {
+        entry.kind = TriggerKind::MANUAL;
+    }
+
+    std::scoped_lock lk(mtx);
+    const TriggerHandle handle = ++nextHandle;
+    if (auto eventTrigger = std::dynamic_pointer_cast<EventTrigger>(trigger)) {
+        for (const auto& subscription : eventTrigger->getSubscriptions()) {
+            if (subscription.source == kSettingsSource) {
+                subscribeSettingLocked(subscription.event);
+            }
+            subscribers[subscriptionKey(subscription.source, subscription.event)].push_back(handle);
+            subscribedSources[subscription.source]++;
+        }
+    }
+    auto& stored = triggers[handle] = std::move(entry);
+    armLocked(handle, stored);
+    const std::weak_ptr<CallbackGate> weakGate = callbackGate;
+    trigger->setChangeListener([weakGate, handle]() {
+        if (auto gate = weakGate.lock()) {
+            std::lock_guard<std::mutex> lock(gate->mutex);
+            if (gate->owner) {
+                gate->owner->rearmTrigger(handle);
             }
-            std::this_thread::sleep_for(std::chrono::milliseconds(100));
         }
     });
+    return handle;
+}
+
+bool TriggerManager::removeTrigger(TriggerHandle handle)
+{
+    std::scoped_lock lk(mtx);
+    auto it = triggers.find(handle);
+    if (it == triggers.end()) {
+        return false;
+    }
+    disarmLocked(handle, it->second);
+    it->second.trigger->setChangeListener(nullptr);
+    for (const auto& key : it->second.subscriptionKeys) {
+        auto subIt = subscribers.find(key);
+        if (subIt == subscribers.end()) {
+            continue;
+        }
+        std::erase(subIt->second, handle);
+        if (subIt->second.empty()) {
+            subscribers.erase(subIt);
+        }
+        const auto source = key.substr(0, key.find('\n'));
+        if (auto srcIt = subscribedSources.find(source); srcIt != subscribedSources.end() && --srcIt->second == 0) {
+            subscribedSources.erase(srcIt);
+        }
+    }
+    triggers.erase(it);
+    return true;
+}
+
+bool TriggerManager::setTriggerEnabled(TriggerHandle handle, bool enabled)
+{
+    std::shared_ptr<I_Trigger> trigger;
+    {
+        std::scoped_lock lk(mtx);
+        auto it = triggers.find(handle);
+        if (it == triggers.end()) {
+            return false;
+        }
+        trigger = it->second.trigger;
+    }
+    // The change listener re-arms; call it outside mtx because it takes the lock itself.
+    trigger->setEnabled(enabled);
+    return true;
+}
+
+// Bring the time/poll deadlines in line with the trigger's current enabled state and time.
+void TriggerManager::rearmTrigger(TriggerHandle handle)
+{
+    std::scoped_lock lk(mtx);
+    auto it = triggers.find(handle);
+    if (it == triggers.end()) {
+        return;
+    }
+    if (it->second.trigger->isEnabled()) {
+        armLocked(handle, it->second);
+    } else {
+        disarmLocked(handle, it->second);
+        wakeLocked();
+    }
+}
+
+std::optional<TriggerManager::TriggerStats> TriggerManager::getTriggerStats(TriggerHandle handle)
+{
+    std::scoped_lock lk(mtx);
+    auto it = triggers.find(handle);
+    if (it == triggers.end()) {
+        return std::nullopt;
+    }
+    return it->second.stats;
+}
+
+void TriggerManager::notifyEvent(const std::string& source, const std::string& event)
+{
+    std::scoped_lock lk(mtx);
+    if (!subscribedSources.contains(source)) {
+        return;
+    }
+    pendingEvents.push_back({ source, event, std::chrono::steady_clock::now() });
+    wakeLocked();
 }
 
 void TriggerManager::start()
 {
     std::scoped_lock lk(mtx);
     pollingEnabled = true;
+    wakeLocked();
 }
 
 void TriggerManager::stop()
 {
     std::scoped_lock lk(mtx);
     pollingEnabled = false;
+    wakeLocked();
 }
 
 void TriggerManager::setScheduler(std::shared_ptr<Scheduler> s)
@@ -303,10 +792,8 @@ HttpEndPointData_t TriggerManager::getHttpEndpointData()
                         this->runFunctionAsync(functionName, args, nullptr);
                     });
                 }
-                // Store trigger under a unique handle; return it to the client.
-                std::scoped_lock lk(mtx);
-                TriggerHandle h = ++nextHandle;
-                triggers[h] = trig;
+                // Store trigger under a unique handle (arming its deadline); return it to the client.
+                TriggerHandle h = addTrigger(trig);
                 nlohmann::json out;
                 out["success"] = true;
                 out["handle"] = h;
@@ -331,6 +818,9 @@ HttpEndPointData_t TriggerManager::getHttpEndpointData()
         "Create a one-shot time trigger" });
 
     // POST /createEventTrigger: Create an event trigger with an optional bound intent.
+    // Body: { intentName? | capabilityName? | functionName?, args?: object, source?: string, event?: string }
+    // - source/event subscribe the trigger (e.g. "interaction"/"tap", "presence"/"present",
+    //   "settings"/<setting name>). An empty event matches every event from the source.
     data.push_back({ PRIVATE_ENDPOINT | POST_ENDPOINT,
         [&](const httplib::Request& req, httplib::Response& res) {
             // Validate content type; if intentName is provided and registered, bind it to the trigger action.
@@ -350,9 +840,16 @@ HttpEndPointData_t TriggerManager::getHttpEndpointData()
                 if (j.contains("args") && j["args"].is_object())
                     args = j["args"];
 
+                auto source = j.value("source", std::string(""));
+                auto event = j.value("event", std::string(""));
+
                 auto trig = std::make_shared<EventTrigger>();
                 trig->setEnabled(true);
                 trig->setScheduler(scheduler);
+                // With a source the trigger fires on each matching event; without one it only
+                // fires via /fireTrigger.
+                if (!source.empty())
+                    trig->subscribe(source, event);
 
                 // Priority: explicit intentName -> capabilityName -> functionName
                 if (!intentName.empty()) {
@@ -372,9 +869,7 @@ HttpEndPointData_t TriggerManager::getHttpEndpointData()
                         this->runFunctionAsync(functionName, args, nullptr);
                     });
                 }
-                std::scoped_lock lk(mtx);
-                TriggerHandle h = ++nextHandle;
-                triggers[h] = trig;
+                TriggerHandle h = addTrigger(trig);
                 nlohmann::json out;
                 out["success"] = true;
                 out["handle"] = h;
@@ -390,7 +885,7 @@ HttpEndPointData_t TriggerManager::getHttpEndpointData()
         },
         "createEventTrigger",
         nlohmann::json({ { "type", "object" },
-            { "properties", { { "intentName", { { "type", "string" } } }, { "capabilityName", { { "type", "string" } } }, { "functionName", { { "type", "string" } } }, { "args", { { "type", "object" } } } } },
+            { "properties", { { "intentName", { { "type", "string" } } }, { "capabilityName", { { "type", "string" } } }, { "functionName", { { "type", "string" } } }, { "args", { { "type", "object" } } }, { "source", { { "type", "string" } } }, { "event", { { "type", "string" } } } } },
             { "oneOf", nlohmann::json::array({ nlohmann::json::object({ { "required", nlohmann::json::array({ "intentName" }) } }), nlohmann::json::object({ { "required", nlohmann::json::array({ "capabilityName" }) } }), nlohmann::json::object({ { "required", nlohmann::json::array({ "functionName" }) } }) }) } }),
         "Create an event trigger" });
 
@@ -404,10 +899,8 @@ HttpEndPointData_t TriggerManager::getHttpEndpointData()
                 auto j = nlohmann::json::parse(req.body);
                 auto handle = j.at("handle").get<TriggerHandle>();
                 auto enable = j.value("enable", true);
-                std::scoped_lock lk(mtx);
-                if (!triggers.count(handle))
+                if (!setTriggerEnabled(handle, enable))
                     throw std::runtime_error("Trigger not found");
-                triggers[handle]->setEnabled(enable);
                 nlohmann::json out;
                 out["success"] = true;
                 res.set_content(out.dump(), "application/json");
@@ -443,7 +936,7 @@ HttpEndPointData_t TriggerManager::getHttpEndpointData()
                     std::scoped_lock lk(mtx);
                     if (!triggers.count(handle))
                         throw std::runtime_error("Trigger not found");
-                    trig = triggers[handle];
+                    trig = triggers[handle].trigger;
                 }
                 if (trig)
                     trig->trigger();
@@ -483,7 +976,7 @@ HttpEndPointData_t TriggerManager::getHttpEndpointData()
                     std::scoped_lock lk(mtx);
                     if (!triggers.count(handle))
                         throw std::runtime_error("Trigger not found");
-                    trig = triggers[handle];
+                    trig = triggers[handle].trigger;
                 }
 
                 if (!trig)
@@ -536,17 +1029,32 @@ HttpEndPointData_t TriggerManager::getHttpEndpointData()
         PRIVATE_ENDPOINT | GET_ENDPOINT,
         [&](const httplib::Request& req,
         httplib::Response& res) {
-            // Each entry includes handle, enabled flag, whether a predicate exists, and type (time/event).
+            // Each entry includes handle, enabled flag, whether a predicate exists, type (time/event),
+            // how it is evaluated (kind), and its evaluation counts and latency.
             nlohmann::json j;
             j["success"] = true;
             j["triggers"] = nlohmann::json::array();
             std::scoped_lock lk(mtx);
             for (auto& kv : triggers) {
+                const auto& entry = kv.second;
                 nlohmann::json tj;
                 tj["handle"] = kv.first;
-                tj["enabled"] = kv.second->isEnabled();
-                tj["hasCheck"] = (bool)kv.second->checkTrigger;
-                tj["type"] = dynamic_cast<TimeTrigger*>(kv.second.get()) ? "time" : "event";
+                tj["enabled"] = entry.trigger->isEnabled();
+                tj["hasCheck"] = (bool)entry.trigger->checkTrigger;
+                tj["type"] = dynamic_cast<TimeTrigger*>(entry.trigger.get()) ? "time" : "event";
+                tj["kind"] = kindToString(entry.kind);
+                tj["evaluations"] = entry.stats.evaluations;
+                tj["fires"] = entry.stats.fires;
+                tj["lastEvaluationUs"] = entry.stats.lastEvaluationUs;
+                tj["maxEvaluationUs"] = entry.stats.maxEvaluationUs;
+                tj["meanEvaluationUs"] = entry.stats.evaluations ? entry.stats.totalEvaluationUs / entry.stats.evaluations : 0.0;
+                if (entry.kind == TriggerKind::PREDICATE)
+                    tj["pollIntervalMs"] = entry.pollInterval.count();
+                if (auto eventTrigger = dynamic_cast<EventTrigger*>(entry.trigger.get())) {
+                    tj["subscriptions"] = nlohmann::json::array();
+                    for (const auto& subscription : eventTrigger->getSubscriptions())
+                        tj["subscriptions"].push_back({ { "source", subscription.source }, { "event", subscription.event } });
+                }
                 j["triggers"].push_back(tj);
             }
             res.set_content(j.dump(), "application/json");
@@ -39,17 +39,28 @@ SOFTWARE.
 //   and “what happens when I fire?” (via triggerFunction). It can optionally reference
 //   a Scheduler to enqueue work rather than execute immediately.
 // - TimeTrigger evaluates against a specific TimePoint (or custom check).
-// - EventTrigger fires based on arbitrary external state exposed through checkTrigger.
-// - TriggerManager owns and polls triggers, and exposes HTTP endpoints to create/manage them.
+// - EventTrigger subscribes to (source, event) pairs and is evaluated when a matching event
+//   arrives. An EventTrigger without subscriptions is a plain predicate and is polled.
+// - TriggerManager owns triggers, routes events to them, and exposes HTTP endpoints to
+//   create/manage them.
+//
+// Event sources
+// - InteractionEvents (source "interaction": tap, lift_started, lift_ended)
+// - ApiEventBroker once attached (e.g. "presence": present/absent/delayed_*)
+// - GlobalSettings change callbacks (source "settings", event = setting name)
+// - notifyEvent() for anything else
 //
 // Threading model
-// - TriggerManager runs a polling std::jthread that evaluates each trigger’s check function
-//   and invokes trigger() when conditions pass. Access is guarded by an internal mutex.
+// - TriggerManager runs one std::jthread that sleeps until the earliest of: a queued event, the
+//   next TimeTrigger deadline, or the next predicate poll. Predicate polls back off from
+//   TRIGGER_POLL_MIN_INTERVAL_MS to TRIGGER_POLL_MAX_INTERVAL_MS while the result is unchanged
+//   and fire on the false -> true edge.
+// - Checks and actions run on that thread without holding the manager mutex.
 //
 // Typical flow
 // - Create trigger (time or event), optionally bind to an Intent via IntentRegistry
-// - Enable trigger so the poll loop can consider it
-// - On pass, trigger() sets internal state and invokes triggerFunction (or schedules work)
+// - Add it to the manager and enable it
+// - On pass, the manager invokes fire(), which sets internal state and runs triggerFunction
 #pragma once
 
 #include "../database/cubeDB.h"
@@ -62,22 +73,32 @@ SOFTWARE.
 #endif
 #include "nlohmann/json.hpp"
 #include "remoteServer.h"
+#include <algorithm>
+#include <array>
+#include <atomic>
 #include <chrono>
 #include <condition_variable>
+#include <deque>
 #include <functional>
 #include <future>
 #include <iostream>
+#include <map>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <regex>
+#include <set>
 #include <signal.h>
 #include <stdexcept>
 #include <string>
 #include <thread>
 #include <unordered_map>
 #include <vector>
+#include "../api/apiEventBroker.h"
 #include "../api/autoRegister.h"
 #include "../audio/audioManager.h"
+#include "../hardware/interactionEvents.h"
+#include "../telemetry/metrics.h"
 #include "../threadsafeQueue.h"
 #include "globalSettings.h"
 #include "httplib.h"
@@ -85,6 +106,8 @@ SOFTWARE.
 #include "intentRegistry.h"
 #include "functionRegistry.h"
 #include "scheduler.h"
+#define TRIGGER_POLL_MIN_INTERVAL_MS 50
+#define TRIGGER_POLL_MAX_INTERVAL_MS 800
 
 namespace DecisionEngine {
 
@@ -97,6 +120,9 @@ public:
     // if enabled and if the predicate returns true (or no predicate is set).
     virtual ~I_Trigger() = default;
     virtual void trigger() = 0;
+    // Run the bound action without re-evaluating the check. TriggerManager calls this after it
+    // has evaluated (and timed) the check itself.
+    virtual void fire() = 0;
     bool isEnabled() const;
     void setEnabled(bool enabled);
     bool getTriggerState() const;
@@ -105,13 +131,19 @@ public:
     virtual void setScheduler(std::shared_ptr<Scheduler> scheduler) = 0;
     bool hasCheck() const;
     bool evaluateCheck() const;
+    // Called after setEnabled() (and TimeTrigger::setTime()) so an owning TriggerManager can
+    // re-arm its deadlines. Runs on the caller's thread; TriggerManager installs it in addTrigger().
+    void setChangeListener(std::function<void()> listener);
     std::function<bool()> checkTrigger;
 
 private:
-    bool enabled = false;
+    std::atomic<bool> enabled { false };
     bool schedulerSet = false;
+    std::mutex changeListenerMutex;
+    std::function<void()> changeListener;
 protected:
-    bool triggerState = false;
+    void notifyChanged();
+    std::atomic<bool> triggerState { false };
     std::function<void()> triggerFunction; // Executed when trigger() passes
     std::weak_ptr<Scheduler> scheduler;
 };
@@ -126,6 +158,7 @@ public:
     TimeTrigger(const TimePoint& time, const std::function<void()>& triggerFunction);
     TimeTrigger(const TimePoint& time, const std::function<void()>& triggerFunction, const std::function<bool()>& checkTrigger);
     void trigger() override;
+    void fire() override;
     void setTime(const TimePoint& time);
     const TimePoint& getTime() const;
     void setScheduler(std::shared_ptr<Scheduler> scheduler) override;
@@ -138,20 +171,46 @@ private:
 
 class EventTrigger : public I_Trigger {
 public:
-    // Fires when an arbitrary predicate evaluates true. Useful for sensor/UI events.
+    // A (source, event) pair this trigger reacts to. An empty event matches every event from
+    // the source.
+    struct Subscription {
+        std::string source;
+        std::string event;
+    };
+
+    // Fires when a subscribed event arrives and the optional predicate passes. Without
+    // subscriptions the predicate is polled and the trigger fires when it becomes true.
     EventTrigger();
     EventTrigger(const std::function<void()>& triggerFunction);
     EventTrigger(const std::function<void()>& triggerFunction, const std::function<bool()>& checkTrigger);
     void trigger() override;
+    void fire() override;
     void setScheduler(std::shared_ptr<Scheduler> scheduler) override;
+    // Subscriptions are read when the trigger is added to a TriggerManager.
+    void subscribe(const std::string& source, const std::string& event = "");
+    const std::vector<Subscription>& getSubscriptions() const;
+
+private:
+    std::vector<Subscription> subscriptions;
 };
 
 /////////////////////////////////////////////////////////////////////////////////////
 
 class TriggerManager : public AutoRegisterAPI<TriggerManager> {
 public:
-    // Owns a set of triggers and polls them periodically. Exposes endpoints to
-    // create time/event triggers, enable/disable, fire, and list.
+    using TriggerHandle = uint32_t;
+
+    struct TriggerStats {
+        uint64_t evaluations = 0;
+        uint64_t fires = 0;
+        double lastEvaluationUs = 0.0;
+        double maxEvaluationUs = 0.0;
+        double totalEvaluationUs = 0.0;
+    };
+
+    // Owns a set of triggers and evaluates them when their event arrives, their time comes,
+    // or (for predicates) on an adaptive poll. Exposes endpoints to create time/event
+    // triggers, enable/disable, fire, and list.
     TriggerManager();
     TriggerManager(const std::shared_ptr<Scheduler>& scheduler);
     ~TriggerManager();
@@ -160,6 +219,18 @@ public:
     void setScheduler(std::shared_ptr<Scheduler> scheduler);
     void setIntentRegistry(std::shared_ptr<IntentRegistry> intentRegistry);
     void setFunctionRegistry(std::shared_ptr<FunctionRegistry> registry);
+    // Route every ApiEventBroker event to subscribed EventTriggers.
+    void attachEventBroker(std::shared_ptr<ApiEventBroker> broker);
+
+    // Trigger ownership (thread-safe)
+    TriggerHandle addTrigger(std::shared_ptr<I_Trigger> trigger);
+    bool removeTrigger(TriggerHandle handle);
+    bool setTriggerEnabled(TriggerHandle handle, bool enabled); // Also re-arms time/poll deadlines
+    std::optional<TriggerStats> getTriggerStats(TriggerHandle handle);
+    // Queue an edge for the EventTriggers subscribed to (source, event). Cheap when nothing
+    // is subscribed to the source; safe to call from any thread.
+    void notifyEvent(const std::string& source, const std::string& event);
+
     // Helpers: invoke functions/capabilities via the FunctionRegistry
     void runFunctionAsync(const std::string& functionName,
         const nlohmann::json& args,
@@ -173,16 +244,83 @@ public:
     std::string getInterfaceName() const override;
 
 private:
+    enum class TriggerKind : uint8_t {
+        TIME = 0,
+        EVENT,
+        PREDICATE,
+        MANUAL, // No subscriptions and no check: only fires via /fireTrigger
+        COUNT
+    };
+    struct TriggerEntry {
+        std::shared_ptr<I_Trigger> trigger;
+        TriggerKind kind = TriggerKind::EVENT;
+        TriggerStats stats;
+        std::vector<std::string> subscriptionKeys;
+        std::optional<TimePoint> armedTime;                          // Entry in timeQueue
+        std::optional<std::chrono::steady_clock::time_point> nextPoll; // Entry in pollQueue
+        std::chrono::milliseconds pollInterval { TRIGGER_POLL_MIN_INTERVAL_MS };
+        bool lastCheck = false;
+    };
+    struct PendingEvent {
+        std::string source;
+        std::string event;
+        std::chrono::steady_clock::time_point queuedAt;
+    };
+    struct PendingEvaluation {
+        TriggerHandle handle = 0;
+        std::shared_ptr<I_Trigger> trigger;
+        TriggerKind kind = TriggerKind::EVENT;
+        bool polled = false;
+        bool lastCheck = false;
+    };
+    // Settings and broker callbacks reach the manager through this gate. They hold the mutex while
+    // they run, and the destructor takes it to clear owner, so a call already in flight finishes first.
+    struct CallbackGate {
+        std::mutex mutex;
+        TriggerManager* owner = nullptr;
+    };
+    struct KindMetrics {
+        std::shared_ptr<Metrics::Counter> evaluations;
+        std::shared_ptr<Metrics::Counter> fires;
+        std::shared_ptr<Metrics::Histogram> evaluationLatencyUs;
+    };
+
     std::shared_ptr<Scheduler> scheduler;
     std::weak_ptr<IntentRegistry> intentRegistry;
     std::shared_ptr<FunctionRegistry> functionRegistry;
-    using TriggerHandle = uint32_t;
-    std::unordered_map<TriggerHandle, std::shared_ptr<I_Trigger>> triggers;
+    std::unordered_map<TriggerHandle, TriggerEntry> triggers;
+    std::unordered_map<std::string, std::vector<TriggerHandle>> subscribers; // "source\nevent" -> handles
+    std::unordered_map<std::string, size_t> subscribedSources;              // source -> subscription count
+    std::set<std::pair<TimePoint, TriggerHandle>> timeQueue;
+    std::set<std::pair<std::chrono::steady_clock::time_point, TriggerHandle>> pollQueue;
+    std::deque<PendingEvent> pendingEvents;
+    std::map<GlobalSettings::SettingType, GlobalSettings::SettingCallbackId> settingSubscriptions; // Removed in ~TriggerManager
     std::jthread pollThread;
     std::mutex mtx;
+    std::condition_variable_any wakeCV;
+    bool wakeRequested = false;
     static TriggerHandle nextHandle;
     bool pollingEnabled = true;
+
+    std::shared_ptr<CallbackGate> callbackGate;
+    InteractionEvents::Handle interactionEventsHandle = 0;
+    std::shared_ptr<ApiEventBroker> eventBroker;
+    ApiEventBroker::ListenerHandle eventBrokerListener = 0;
+
+    std::array<KindMetrics, static_cast<size_t>(TriggerKind::COUNT)> kindMetrics;
+    std::shared_ptr<Metrics::Histogram> eventDispatchLatencyUs;
+
     void ensurePollThreadStarted();
+    void subscribeEventSources();
+    void pollLoop(std::stop_token st);
+    void collectDueLocked(std::vector<PendingEvaluation>& due);
+    void evaluate(const PendingEvaluation& pending);
+    void armLocked(TriggerHandle handle, TriggerEntry& entry);
+    void disarmLocked(TriggerHandle handle, TriggerEntry& entry);
+    void subscribeSettingLocked(const std::string& settingName);
+    void rearmTrigger(TriggerHandle handle);
+    void wakeLocked();
+    static const char* kindToString(TriggerKind kind);
 };
 
 }
@@ -0,0 +1,171 @@
+/*
+ █████╗ ███╗   ██╗██╗███╗   ███╗ █████╗ ████████╗██╗ ██████╗ ███╗   ██╗████████╗██████╗  █████╗  ██████╗██╗  ██╗    ██████╗██████╗ ██████╗
+██╔══██╗████╗  ██║██║████╗ ████║██╔══██╗╚══██╔══╝██║██╔═══██╗████╗  ██║╚══██╔══╝██╔══██╗██╔══██╗██╔════╝██║ ██╔╝   ██╔════╝██╔══██╗██╔══██╗
+███████║██╔██╗ ██║██║██╔████╔██║███████║   ██║   ██║██║   ██║██╔██╗ ██║   ██║   ██████╔╝███████║██║     █████╔╝    ██║     ██████╔╝██████╔╝
+██╔══██║██║╚██╗██║██║██║╚██╔╝██║██╔══██║   ██║   ██║██║   ██║██║╚██╗██║   ██║   ██╔══██╗██╔══██║██║     ██╔═██╗    ██║     ██╔═══╝ ██╔═══╝
+██║  ██║██║ ╚████║██║██║ ╚═╝ ██║██║  ██║   ██║   ██║╚██████╔╝██║ ╚████║   ██║   ██║  ██║██║  ██║╚██████╗██║  ██╗██╗╚██████╗██║     ██║
+╚═╝  ╚═╝╚═╝  ╚═══╝╚═╝╚═╝     ╚═╝╚═╝  ╚═╝   ╚═╝   ╚═╝ ╚═════╝ ╚═╝  ╚═══╝   ╚═╝   ╚═╝  ╚═╝╚═╝  ╚═╝ ╚═════╝╚═╝  ╚═╝╚═╝ ╚═════╝╚═╝     ╚═╝
+*/
+
+/*
+MIT License
+
+Copyright (c) 2026 A-McD Technology LLC
+*/
+
+
+#include "animationTrack.h"
+#include <algorithm>
+#include <cmath>
+#include <glm/gtc/matrix_transform.hpp>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+AnimationTrack::AnimationTrack(const std::vector<AnimationKeyframe>& keyframes)
+{
+    for (const auto& keyframe : keyframes) {
+        this->types.push_back(keyframe.type);
+        this->easings.push_back(keyframe.easing);
+        this->values.push_back(keyframe.value);
+        this->starts.push_back(keyframe.timeStart);
+        this->ends.push_back(keyframe.timeEnd);
+        this->axes.push_back(keyframe.axis);
+        this->points.push_back(keyframe.point);
+        if (keyframe.timeStart < keyframe.timeEnd) {
+            this->boundaries.push_back(keyframe.timeStart);
+            this->boundaries.push_back(keyframe.timeEnd);
+        }
+    }
+    std::sort(this->boundaries.begin(), this->boundaries.end());
+    this->boundaries.erase(std::unique(this->boundaries.begin(), this->boundaries.end()), this->boundaries.end());
+    for (size_t k = 0; k + 1 < this->boundaries.size(); k++) {
+        this->segmentOffsets.push_back(static_cast<uint32_t>(this->segmentKeyframes.size()));
+        for (uint32_t i = 0; i < this->starts.size(); i++) {
+            if (this->starts[i] <= this->boundaries[k] && this->ends[i] > this->boundaries[k]) {
+                this->segmentKeyframes.push_back(i);
+            }
+        }
+    }
+    this->segmentOffsets.push_back(static_cast<uint32_t>(this->segmentKeyframes.size()));
+}
+
+double AnimationTrack::ease(Animations::AnimationEasing easing, double t)
+{
+    // the same curves easingFunctionFor() returns
+    switch (easing) {
+    case Animations::AnimationEasing::EASE_IN:
+        return t * t;
+    case Animations::AnimationEasing::EASE_OUT:
+        return t * (2 - t);
+    case Animations::AnimationEasing::EASE_IN_OUT:
+        return 0.5f * (1 - cos(M_PI * t));
+    case Animations::AnimationEasing::LINEAR:
+    default:
+        return t;
+    }
+}
+
+size_t AnimationTrack::segmentFor(unsigned long long frame)
+{
+    const size_t segments = this->segmentOffsets.size() - 1;
+    if (this->boundaries.empty() || frame < this->boundaries.front() || frame >= this->boundaries.back()) {
+        return segments;
+    }
+    for (size_t k = this->cursor; k < segments && k <= this->cursor + 1; k++) {
+        if (this->boundaries[k] <= frame && frame < this->boundaries[k + 1]) {
+            return this->cursor = k;
+        }
+    }
+    auto it = std::upper_bound(this->boundaries.begin(), this->boundaries.end(), frame);
+    return this->cursor = static_cast<size_t>(it - this->boundaries.begin()) - 1;
+}
+
+bool AnimationTrack::evaluate(unsigned long long frame, std::vector<AnimationStep>& steps, std::vector<uint32_t>* live)
+{
+    if (this->empty()) {
+        return false;
+    }
+    const size_t segment = this->segmentFor(frame);
+    if (segment + 1 >= this->segmentOffsets.size()) {
+        return false;
+    }
+    const uint32_t first = this->segmentOffsets[segment];
+    const uint32_t last = this->segmentOffsets[segment + 1];
+    for (uint32_t n = first; n < last; n++) {
+        const uint32_t i = this->segmentKeyframes[n];
+        if (live) {
+            live->push_back(i);
+        }
+        double f = frame;
+        double s = this->starts[i];
+        double e = this->ends[i];
+        double f_normal = (f - s) / (e - s);
+        double f2_normal = (f > 0) ? (f - s - 1) / (e - s) : 0.f;
+        double calcValue = (double)this->values[i] * (ease(this->easings[i], f_normal) - ease(this->easings[i], f2_normal));
+        if (calcValue == 0.0 || this->types[i] == Animations::AnimationType::NOP) {
+            continue;
+        }
+        const glm::vec3& axis = this->axes[i];
+        AnimationStep step = { this->types[i], i, 0.0f, glm::vec3(0.0f), axis, this->points[i], 0.0 };
+        switch (this->types[i]) {
+        case Animations::AnimationType::TRANSLATE:
+            step.amount = glm::vec3(axis.x * calcValue, axis.y * calcValue, axis.z * calcValue);
+            break;
+        case Animations::AnimationType::ROTATE:
+        case Animations::AnimationType::ROTATE_ABOUT:
+            step.angle = calcValue;
+            break;
+        case Animations::AnimationType::SCALE_XYZ:
+            calcValue = calcValue + 1.f;
+            step.amount = glm::vec3((axis.x > 0 ? 1 * calcValue : 1), (axis.y > 0 ? 1 * calcValue : 1), (axis.z > 0 ? 1 * calcValue : 1));
+            break;
+        case Animations::AnimationType::UNIFORM_SCALE:
+            calcValue = calcValue + 1.f;
+            step.amount = glm::vec3(calcValue, calcValue, calcValue);
+            break;
+        case Animations::AnimationType::RETURN_HOME:
+            step.homeWeight = calcValue * (f - s);
+            break;
+        default:
+            continue;
+        }
+        steps.push_back(step);
+    }
+    return true;
+}
+
+size_t AnimationTrack::fold(const std::vector<AnimationStep>& steps, size_t first, AnimationDelta& delta)
+{
+    for (size_t i = first; i < steps.size(); i++) {
+        const AnimationStep& step = steps[i];
+        switch (step.type) {
+        case Animations::AnimationType::TRANSLATE:
+            delta.post = glm::translate(delta.post, step.amount);
+            break;
+        case Animations::AnimationType::ROTATE:
+            delta.post = glm::rotate(delta.post, glm::radians(step.angle), step.axis);
+            break;
+        case Animations::AnimationType::SCALE_XYZ:
+        case Animations::AnimationType::UNIFORM_SCALE:
+            if (step.amount.x == 0.0f || step.amount.y == 0.0f || step.amount.z == 0.0f) {
+                return i;
+            }
+            delta.post = glm::scale(delta.post, step.amount);
+            break;
+        case Animations::AnimationType::ROTATE_ABOUT: {
+            glm::mat4 tempMat = glm::mat4(1.0f);
+            tempMat = glm::translate(tempMat, step.point);
+            tempMat = glm::rotate(tempMat, glm::radians(step.angle), glm::normalize(step.axis));
+            tempMat = glm::translate(tempMat, -step.point);
+            delta.pre = tempMat * delta.pre;
+            break;
+        }
+        default:
+            return i;
+        }
+        delta.empty = false;
+    }
+    return steps.size();
+}
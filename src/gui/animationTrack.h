@@ -0,0 +1,100 @@
+/*
+ █████╗ ███╗   ██╗██╗███╗   ███╗ █████╗ ████████╗██╗ ██████╗ ███╗   ██╗████████╗██████╗  █████╗  ██████╗██╗  ██╗   ██╗  ██╗
+██╔══██╗████╗  ██║██║████╗ ████║██╔══██╗╚══██╔══╝██║██╔═══██╗████╗  ██║╚══██╔══╝██╔══██╗██╔══██╗██╔════╝██║ ██╔╝   ██║  ██║
+███████║██╔██╗ ██║██║██╔████╔██║███████║   ██║   ██║██║   ██║██╔██╗ ██║   ██║   ██████╔╝███████║██║     █████╔╝    ███████║
+██╔══██║██║╚██╗██║██║██║╚██╔╝██║██╔══██║   ██║   ██║██║   ██║██║╚██╗██║   ██║   ██╔══██╗██╔══██║██║     ██╔═██╗    ██╔══██║
+██║  ██║██║ ╚████║██║██║ ╚═╝ ██║██║  ██║   ██║   ██║╚██████╔╝██║ ╚████║   ██║   ██║  ██║██║  ██║╚██████╗██║  ██╗██╗██║  ██║
+╚═╝  ╚═╝╚═╝  ╚═══╝╚═╝╚═╝     ╚═╝╚═╝  ╚═╝   ╚═╝   ╚═╝ ╚═════╝ ╚═╝  ╚═══╝   ╚═╝   ╚═╝  ╚═╝╚═╝  ╚═╝ ╚═════╝╚═╝  ╚═╝╚═╝╚═╝  ╚═╝
+*/
+
+/*
+MIT License
+
+Copyright (c) 2026 A-McD Technology LLC
+*/
+
+
+#pragma once
+#ifndef ANIMATIONTRACK_H
+#define ANIMATIONTRACK_H
+#ifndef MESHLOADER_H
+#include "renderables/meshLoader.h"
+#endif // MESHLOADER_H
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+/*
+
+An animation's (or expression's) keyframes compiled once at load time, so a tick only looks at the
+keyframes that are live on that frame.
+
+The keyframes are kept in source order in parallel arrays, with the easing as an id evaluated in closed
+form instead of through a std::function. The frame axis is cut at every keyframe start and end; each
+segment lists the keyframes live inside it, in source order. Ticks advance one frame at a time, so
+finding the segment is normally a step from the previous one.
+
+evaluate() turns the live keyframes into AnimationSteps: the per-tick delta each keyframe contributes,
+already eased and converted the way Character_generic applies it. fold() then collapses a run of steps
+into one matrix multiplied on each side of the model matrix (rotateAbout() multiplies on the left,
+translate/rotate/scale on the right), so a tick moves each object with one scene graph write instead of
+one virtual call per keyframe. Steps that depend on the object (RETURN_HOME) or that Cube treats
+specially (a scale with a zero component) are not folded; the caller applies those one by one.
+
+A track is not thread safe; each is evaluated from one animation or expression thread.
+
+*/
+
+struct AnimationStep {
+    Animations::AnimationType type;
+    uint32_t keyframe; // index of the source keyframe
+    float angle; // degrees, for ROTATE and ROTATE_ABOUT
+    glm::vec3 amount; // translation or scale factors
+    glm::vec3 axis;
+    glm::vec3 point;
+    double homeWeight; // RETURN_HOME: fraction of the captured-position difference to add
+};
+
+struct AnimationDelta {
+    glm::mat4 pre = glm::mat4(1.0f);
+    glm::mat4 post = glm::mat4(1.0f);
+    bool empty = true;
+};
+
+class AnimationTrack {
+public:
+    AnimationTrack() = default;
+    explicit AnimationTrack(const std::vector<AnimationKeyframe>& keyframes);
+
+    // Appends the steps for frame in source order, and the indices of every live keyframe (moving or
+    // not) to live if given. Returns whether any keyframe is live on frame.
+    bool evaluate(unsigned long long frame, std::vector<AnimationStep>& steps, std::vector<uint32_t>* live = nullptr);
+    // Folds steps[first..] into delta until a step that cannot be folded; returns that step's index
+    // (steps.size() if all were folded).
+    static size_t fold(const std::vector<AnimationStep>& steps, size_t first, AnimationDelta& delta);
+    static double ease(Animations::AnimationEasing easing, double t);
+
+    size_t size() const { return this->starts.size(); }
+    bool empty() const { return this->starts.empty(); }
+
+private:
+    size_t segmentFor(unsigned long long frame);
+
+    std::vector<Animations::AnimationType> types;
+    std::vector<Animations::AnimationEasing> easings;
+    std::vector<float> values;
+    std::vector<uint32_t> starts;
+    std::vector<uint32_t> ends;
+    std::vector<glm::vec3> axes;
+    std::vector<glm::vec3> points;
+
+    // Segment k covers frames [boundaries[k], boundaries[k + 1]); its live keyframes are
+    // segmentKeyframes[segmentOffsets[k]..segmentOffsets[k + 1]).
+    std::vector<uint32_t> boundaries;
+    std::vector<uint32_t> segmentOffsets;
+    std::vector<uint32_t> segmentKeyframes;
+    size_t cursor = 0;
+};
+
+#endif // ANIMATIONTRACK_H
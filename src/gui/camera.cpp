@@ -0,0 +1,75 @@
+/*
+ ██████╗ █████╗ ███╗   ███╗███████╗██████╗  █████╗     ██████╗██████╗ ██████╗
+██╔════╝██╔══██╗████╗ ████║██╔════╝██╔══██╗██╔══██╗   ██╔════╝██╔══██╗██╔══██╗
+██║     ███████║██╔████╔██║█████╗  ██████╔╝███████║   ██║     ██████╔╝██████╔╝
+██║     ██╔══██║██║╚██╔╝██║██╔══╝  ██╔══██╗██╔══██║   ██║     ██╔═══╝ ██╔═══╝
+╚██████╗██║  ██║██║ ╚═╝ ██║███████╗██║  ██║██║  ██║██╗╚██████╗██║     ██║
+ ╚═════╝╚═╝  ╚═╝╚═╝     ╚═╝╚══════╝╚═╝  ╚═╝╚═╝  ╚═╝╚═╝ ╚═════╝╚═╝     ╚═╝
+*/
+
+/*
+MIT License
+
+Copyright (c) 2026 A-McD Technology LLC
+*/
+
+#include "camera.h"
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+
+Camera& Camera::scene()
+{
+    static Camera camera(
+        SCENE_BINDING,
+        glm::perspective(glm::radians(45.0f), 720.0f / 720.0f, 0.1f, 100.0f),
+        glm::lookAt(glm::vec3(0.0f, 0.0f, 6.0f), glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f)));
+    return camera;
+}
+
+Camera& Camera::ui()
+{
+    static Camera camera(UI_BINDING, glm::ortho(0.0f, 720.0f, 0.0f, 720.0f, -1.f, 1.f), glm::mat4(1.0f));
+    return camera;
+}
+
+Camera::Camera(GLuint binding, const glm::mat4& projection, const glm::mat4& view)
+    : bindingPoint(binding)
+{
+    set(projection, view);
+}
+
+void Camera::set(const glm::mat4& projection, const glm::mat4& view)
+{
+    this->projectionMatrix = projection;
+    this->viewMatrix = view;
+    this->inverseViewProjection = glm::inverse(projection * view);
+    this->dirty = true;
+}
+
+void Camera::upload()
+{
+    if (this->buffer == 0) {
+        glGenBuffers(1, &this->buffer);
+        glBindBuffer(GL_UNIFORM_BUFFER, this->buffer);
+        glBufferData(GL_UNIFORM_BUFFER, 2 * sizeof(glm::mat4), nullptr, GL_DYNAMIC_DRAW);
+        glBindBufferBase(GL_UNIFORM_BUFFER, this->bindingPoint, this->buffer);
+        this->dirty = true;
+    }
+    if (!this->dirty) {
+        return;
+    }
+    // std140 lays two mat4s out back to back as 16-float columns, the same as glm.
+    glBindBuffer(GL_UNIFORM_BUFFER, this->buffer);
+    glBufferSubData(GL_UNIFORM_BUFFER, 0, sizeof(glm::mat4), glm::value_ptr(this->projectionMatrix));
+    glBufferSubData(GL_UNIFORM_BUFFER, sizeof(glm::mat4), sizeof(glm::mat4), glm::value_ptr(this->viewMatrix));
+    glBindBuffer(GL_UNIFORM_BUFFER, 0);
+    this->dirty = false;
+}
+
+glm::mat4 Camera::modelFor(const glm::mat4& projection, const glm::mat4& view, const glm::mat4& model) const
+{
+    if (projection == this->projectionMatrix && view == this->viewMatrix) {
+        return model;
+    }
+    return this->inverseViewProjection * projection * view * model;
+}
@@ -0,0 +1,70 @@
+/*
+ ██████╗ █████╗ ███╗   ███╗███████╗██████╗  █████╗    ██╗  ██╗
+██╔════╝██╔══██╗████╗ ████║██╔════╝██╔══██╗██╔══██╗   ██║  ██║
+██║     ███████║██╔████╔██║█████╗  ██████╔╝███████║   ███████║
+██║     ██╔══██║██║╚██╔╝██║██╔══╝  ██╔══██╗██╔══██║   ██╔══██║
+╚██████╗██║  ██║██║ ╚═╝ ██║███████╗██║  ██║██║  ██║██╗██║  ██║
+ ╚═════╝╚═╝  ╚═╝╚═╝     ╚═╝╚══════╝╚═╝  ╚═╝╚═╝  ╚═╝╚═╝╚═╝  ╚═╝
+*/
+
+/*
+MIT License
+
+Copyright (c) 2026 A-McD Technology LLC
+*/
+
+#pragma once
+#ifndef CAMERA_H
+#define CAMERA_H
+#include "GL/glew.h"
+#include <glm/glm.hpp>
+
+/*
+
+Every renderable used to carry its own projection and view matrices and upload both with each draw,
+even though all of them share one of two cameras: the perspective scene camera used by the meshes and
+the 720x720 orthographic camera used by text and textured UI widgets.
+
+A Camera keeps those two matrices in a uniform buffer (std140 block "Camera" in edges.vs and text.vs)
+that the renderer uploads once per frame, and only when they changed. Objects then only send their
+model matrix. An object whose own matrices were changed away from its camera (the character animations
+can tween them) still draws correctly: modelFor() folds the difference into the model matrix.
+
+Cameras are owned by the render thread; set() and upload() must be called from it.
+
+*/
+
+class Camera {
+public:
+    // Uniform buffer binding points; the renderer binds each shader's "Camera" block to one of these.
+    static constexpr GLuint SCENE_BINDING = 0;
+    static constexpr GLuint UI_BINDING = 1;
+    static constexpr const char* BLOCK_NAME = "Camera";
+
+    // Perspective camera at (0, 0, 6) looking at the origin.
+    static Camera& scene();
+    // Orthographic 720x720 UI space with the origin bottom-left.
+    static Camera& ui();
+
+    GLuint binding() const { return this->bindingPoint; }
+    const glm::mat4& projection() const { return this->projectionMatrix; }
+    const glm::mat4& view() const { return this->viewMatrix; }
+
+    void set(const glm::mat4& projection, const glm::mat4& view);
+    // Creates the buffer on first use and re-uploads it if set() changed the matrices.
+    void upload();
+    // Model matrix that, drawn through this camera, gives projection * view * model.
+    glm::mat4 modelFor(const glm::mat4& projection, const glm::mat4& view, const glm::mat4& model) const;
+
+private:
+    Camera(GLuint binding, const glm::mat4& projection, const glm::mat4& view);
+
+    GLuint bindingPoint;
+    GLuint buffer = 0;
+    bool dirty = true;
+    glm::mat4 projectionMatrix;
+    glm::mat4 viewMatrix;
+    glm::mat4 inverseViewProjection;
+};
+
+#endif // CAMERA_H
@@ -32,6 +32,7 @@ SOFTWARE.
 */
 
 #include "characterManager.h"
+#include "renderDamage.h"
 #include <mutex>
 
 // TODO: Character manager needs some static methods that handle changing / triggering animations and expressions.
@@ -257,9 +258,8 @@ Character_generic::Character_generic(Shader* sh, const std::string& folder)
     this->shader = sh;
     this->visible = false;
     this->animationFrame = 0;
+    this->expressionFrame = 0;
     this->currentExpression = Expressions::ExpressionNames_enum::NEUTRAL;
-    this->currentExpressionDef = { Expressions::ExpressionNames_enum::COUNT, "", {}, {} };
-    this->currentAnimation = { Animations::AnimationNames_enum::COUNT, "", {} };
     this->currentAnimationName = Animations::AnimationNames_enum::NEUTRAL;
 
     // Load character.json from the folder. This file should contain the list of objects, animations and expressions to load.
@@ -329,6 +329,12 @@ Character_generic::Character_generic(Shader* sh, const std::string& folder)
 
     this->animationLoader = new AnimationLoader(folder, animationsToLoad);
     this->expressionLoader = new ExpressionLoader(folder, expressionsToLoad);
+    for (auto& [animationName, animation] : this->animationLoader->getAnimations()) {
+        this->animationTracks.emplace(animationName, AnimationTrack(animation.keyframes));
+    }
+    for (auto& [expressionName, expression] : this->expressionLoader->getExpressions()) {
+        this->expressionTracks.emplace(expressionName, this->compileExpression(expression));
+    }
 
     float x, y, z;
     try {
@@ -437,73 +443,13 @@ void Character_generic::animate()
         std::lock_guard<std::mutex> lock(this->nextMutex);
         this->currentAnimation = this->nextAnimation;
         this->currentAnimationName = this->nextAnimationName;
-        this->nextAnimation = { Animations::AnimationNames_enum::COUNT, "", {} };
+        this->nextAnimation = nullptr;
         this->nextAnimationName = Animations::AnimationNames_enum::COUNT;
         this->animationFrame = 0;
     }
-    bool foundKeyframe = false;
-    for (auto keyframe : this->currentAnimation.keyframes) {
-        if (keyframe.timeStart <= this->animationFrame && keyframe.timeEnd > this->animationFrame) {
-            foundKeyframe = true;
-            double f = this->animationFrame;
-            double s = keyframe.timeStart;
-            double e = keyframe.timeEnd;
-            double f_normal = (f - s) / (e - s);
-            double f2_normal = (f > 0) ? (f - s - 1) / (e - s) : 0.f;
-            double fn_eased = keyframe.easingFunction(f_normal);
-            double fn2_eased = keyframe.easingFunction(f2_normal);
-            double calcValue = (double)keyframe.value * (fn_eased - fn2_eased);
-            switch (keyframe.type) {
-            case Animations::AnimationType::TRANSLATE: {
-                this->translate(keyframe.axis.x * calcValue, keyframe.axis.y * calcValue, keyframe.axis.z * calcValue);
-                break;
-            }
-            case Animations::AnimationType::ROTATE: {
-                // TODO: this needs to compensate for the position of the object so that it rotates about its own axiseses
-                this->rotate(calcValue, keyframe.axis.x, keyframe.axis.y, keyframe.axis.z);
-                break;
-            }
-            case Animations::AnimationType::SCALE_XYZ: {
-                // TODO: this needs work. the calculated value needs to be on the range of 0 to infinity.
-                calcValue = calcValue + 1.f;
-                this->scale((keyframe.axis.x > 0 ? 1 * calcValue : 1), (keyframe.axis.y > 0 ? 1 * calcValue : 1), (keyframe.axis.z > 0 ? 1 * calcValue : 1));
-                break;
-            }
-            case Animations::AnimationType::UNIFORM_SCALE: {
-                calcValue = calcValue + 1.f;
-                this->scale(calcValue, calcValue, calcValue);
-                break;
-            }
-            case Animations::AnimationType::ROTATE_ABOUT: {
-                for (auto object : this->objects) {
-                    object->rotateAbout(calcValue, keyframe.axis, keyframe.point);
-                }
-                break;
-            }
-            case Animations::AnimationType::RETURN_HOME: {
-                glm::mat4 modelDiff, projectionDiff, viewDiff;
-                glm::mat4 calcValueMat4 = glm::mat4(calcValue * (f - s)); // TODO: this only works for linear easing. Might need to fix. Might not care.
-                for (auto object : this->objects) {
-                    // get the differences between the current position and the captured position
-                    object->getRestorePositionDiff(&modelDiff, &viewDiff, &projectionDiff);
-                    // apply the differences to the object
-                    auto newModelMatrix = object->getModelMatrix() + (modelDiff * calcValueMat4);
-                    object->setModelMatrix(object->getModelMatrix() + (modelDiff * calcValueMat4));
-                    object->setViewMatrix(object->getViewMatrix() + (viewDiff * calcValueMat4));
-                    object->setProjectionMatrix(object->getProjectionMatrix() + (projectionDiff * calcValueMat4));
-                }
-                break;
-            }
-            case Animations::AnimationType::NOP: {
-                // do nothing
-                break;
-            }
-            default:
-                CubeLog::error("Character_generic::animate: Invalid animation type");
-                break;
-            }
-        }
-    }
+    this->animationSteps.clear();
+    bool foundKeyframe = this->currentAnimation && this->currentAnimation->evaluate(this->animationFrame, this->animationSteps);
+    this->applySteps(this->animationSteps, this->objects, true);
     this->animationFrame++;
     if (!foundKeyframe) {
         this->triggerAnimation(Animations::AnimationNames_enum::NEUTRAL);
@@ -512,151 +458,137 @@ void Character_generic::animate()
             object->restorePosition();
         }
     }
-    // std::chrono::high_resolution_clock::time_point end = std::chrono::high_resolution_clock::now();
-    // std::chrono::duration<double> time_span = std::chrono::duration_cast<std::chrono::duration<double>>(end - start);
-    // CubeLog::info("Character_generic::animate: Animation took " + std::to_string(time_span.count()) + " seconds."); // about 0.000030 seconds
 }
 
 void Character_generic::expression()
 {
-    // TODO: do the stuff that needs to be done to change the expression of the character based on the currentExpression
     std::lock_guard<std::mutex> lock(this->currentMutex);
     if (this->currentExpression == Expressions::ExpressionNames_enum::COUNT || this->nextExpression != Expressions::ExpressionNames_enum::COUNT) {
         CubeLog::info("Character_generic::expression: No current expression. Setting expression to NEUTRAL");
         std::lock_guard<std::mutex> lock(this->nextMutex);
-        this->currentExpressionDef = this->nextExpressionDef;
+        this->currentExpressionTrack = this->nextExpressionTrack;
         this->currentExpression = this->nextExpression;
-        this->nextExpressionDef = { Expressions::ExpressionNames_enum::COUNT, "", {} };
+        this->nextExpressionTrack = nullptr;
         this->nextExpression = Expressions::ExpressionNames_enum::COUNT;
         this->expressionFrame = 0;
     }
+    this->expressionSteps.clear();
+    this->liveKeyframes.clear();
     bool foundKeyframe = false;
-    for (auto i = 0; i < this->currentExpressionDef.animationKeyframes.size(); i++) {
-        auto keyframe = this->currentExpressionDef.animationKeyframes.at(i);
-        if (keyframe.timeStart <= this->expressionFrame && keyframe.timeEnd > this->expressionFrame) {
-            // get the visibility of the objects for this keyframe
-            std::vector<bool> visibility = this->currentExpressionDef.visibility.at(i);
-            if (visibility.size() != this->currentExpressionDef.objects.size()) {
-                CubeLog::error("Character_generic::expression: Visibility vector size does not match objects vector size.");
-                continue;
-            }
-            for (auto j = 0; j < visibility.size(); j++) {
-                auto objName = this->currentExpressionDef.objects.at(j);
-                auto object = this->getPartByName(objName);
-                if (object == nullptr) {
-                    CubeLog::error("Character_generic::expression: Object not found: " + objName);
-                    continue;
+    if (this->currentExpressionTrack) {
+        ExpressionTrack& expression = *this->currentExpressionTrack;
+        foundKeyframe = expression.track.evaluate(this->expressionFrame, this->expressionSteps, &this->liveKeyframes);
+        for (auto keyframe : this->liveKeyframes) {
+            for (auto& [part, visible] : expression.visibility[keyframe]) {
+                for (auto obj : part->objects) {
+                    obj->setVisibility(visible);
                 }
-                if (object != nullptr) {
-                    for (auto obj : object->objects) {
-                        obj->setVisibility(visibility.at(j));
-                    }
-                }
-            }
-            foundKeyframe = true;
-            double f = this->animationFrame;
-            double s = keyframe.timeStart;
-            double e = keyframe.timeEnd;
-            double f_normal = (f - s) / (e - s);
-            double f2_normal = (f > 0) ? (f - s - 1) / (e - s) : 0.f;
-            double fn_eased = keyframe.easingFunction(f_normal);
-            double fn2_eased = keyframe.easingFunction(f2_normal);
-            double calcValue = (double)keyframe.value * (fn_eased - fn2_eased);
-            switch (keyframe.type) {
-            case Animations::AnimationType::TRANSLATE: {
-                for (auto objName : this->currentExpressionDef.objects) {
-                    auto object = this->getPartByName(objName);
-                    if (object != nullptr) {
-                        for (auto obj : object->objects) {
-                            obj->translate(glm::vec3(keyframe.axis.x * calcValue, keyframe.axis.y * calcValue, keyframe.axis.z * calcValue));
-                        }
-                    }
-                }
-                // this->translate(keyframe.axis.x * calcValue, keyframe.axis.y * calcValue, keyframe.axis.z * calcValue);
-                break;
-            }
-            case Animations::AnimationType::ROTATE: {
-                // this->rotate(calcValue, keyframe.axis.x, keyframe.axis.y, keyframe.axis.z);
-                for (auto objName : this->currentExpressionDef.objects) {
-                    auto object = this->getPartByName(objName);
-                    if (object != nullptr) {
-                        for (auto obj : object->objects) {
-                            obj->rotate(calcValue, glm::vec3(keyframe.axis.x, keyframe.axis.y, keyframe.axis.z));
-                        }
-                    }
-                }
-                break;
-            }
-            case Animations::AnimationType::SCALE_XYZ: {
-                calcValue = calcValue + 1.f;
-                // this->scale((keyframe.axis.x > 0 ? 1 * calcValue : 1), (keyframe.axis.y > 0 ? 1 * calcValue : 1), (keyframe.axis.z > 0 ? 1 * calcValue : 1));
-                for (auto objName : this->currentExpressionDef.objects) {
-                    auto object = this->getPartByName(objName);
-                    if (object != nullptr) {
-                        for (auto obj : object->objects) {
-                            obj->scale(glm::vec3((keyframe.axis.x > 0 ? 1 * calcValue : 1), (keyframe.axis.y > 0 ? 1 * calcValue : 1), (keyframe.axis.z > 0 ? 1 * calcValue : 1)));
-                        }
-                    }
-                }
-                break;
-            }
-            case Animations::AnimationType::UNIFORM_SCALE: {
-                calcValue = calcValue + 1.f;
-                // this->scale(calcValue, calcValue, calcValue);
-                for (auto objName : this->currentExpressionDef.objects) {
-                    auto object = this->getPartByName(objName);
-                    if (object != nullptr) {
-                        for (auto obj : object->objects) {
-                            obj->scale(glm::vec3(calcValue, calcValue, calcValue));
-                        }
-                    }
-                }
-                break;
-            }
-            case Animations::AnimationType::ROTATE_ABOUT: {
-                // for (auto object : this->objects) {
-                //     object->rotateAbout(calcValue, keyframe.axis, keyframe.point);
-                // }
-                for (auto objName : this->currentExpressionDef.objects) {
-                    auto object = this->getPartByName(objName);
-                    if (object != nullptr) {
-                        for (auto obj : object->objects) {
-                            obj->rotateAbout(calcValue, keyframe.axis, keyframe.point);
-                        }
-                    }
-                }
-                break;
-            }
-            case Animations::AnimationType::RETURN_HOME: {
-                // glm::mat4 modelDiff, projectionDiff, viewDiff;
-                // glm::mat4 calcValueMat4 = glm::mat4(calcValue);
-                // for (auto object : this->objects) {
-                //     // get the differences between the current position and the captured position
-                //     object->getRestorePositionDiff(&modelDiff, &viewDiff, &projectionDiff);
-                //     // apply the differences to the object
-                //     object->setModelMatrix(object->getModelMatrix() + (modelDiff * calcValueMat4));
-                //     object->setViewMatrix(object->getViewMatrix() + (viewDiff * calcValueMat4));
-                //     object->setProjectionMatrix(object->getProjectionMatrix() + (projectionDiff * calcValueMat4));
-                // }
-                break;
-            }
-            case Animations::AnimationType::NOP: {
-                // do nothing
-                break;
-            }
-            default:
-                CubeLog::error("Character_generic::animate: Invalid animation type");
-                break;
             }
         }
+        // expressions never implemented RETURN_HOME
+        this->applySteps(this->expressionSteps, expression.targets, false);
     }
     this->expressionFrame++;
     if (!foundKeyframe) {
         this->triggerExpression(Expressions::ExpressionNames_enum::NEUTRAL);
         this->expressionFrame = 0;
-        // for (auto object : this->objects) {
-        //     object->restorePosition();
-        // }
+    }
+}
+
+/**
+ * @brief Resolve an expression's object names and visibility rows against this character's parts and
+ * compile its keyframes.
+ */
+Character_generic::ExpressionTrack Character_generic::compileExpression(const ExpressionDefinition& expression)
+{
+    ExpressionTrack compiled;
+    for (auto& objName : expression.objects) {
+        auto part = this->getPartByName(objName);
+        if (part == nullptr) {
+            CubeLog::error("Character_generic::compileExpression: Object not found: " + objName);
+            continue;
+        }
+        compiled.targets.insert(compiled.targets.end(), part->objects.begin(), part->objects.end());
+    }
+    std::vector<AnimationKeyframe> keyframes;
+    for (size_t i = 0; i < expression.animationKeyframes.size(); i++) {
+        if (i >= expression.visibility.size() || expression.visibility[i].size() != expression.objects.size()) {
+            CubeLog::error("Character_generic::compileExpression: Visibility vector size does not match objects vector size.");
+            continue;
+        }
+        std::vector<std::pair<CharacterPart*, bool>> visibility;
+        for (size_t j = 0; j < expression.objects.size(); j++) {
+            auto part = this->getPartByName(expression.objects[j]);
+            if (part != nullptr) {
+                visibility.push_back({ part, expression.visibility[i][j] });
+            }
+        }
+        compiled.visibility.push_back(std::move(visibility));
+        keyframes.push_back(expression.animationKeyframes[i]);
+    }
+    compiled.track = AnimationTrack(keyframes);
+    return compiled;
+}
+
+/**
+ * @brief Apply one tick of steps to targets, folding runs of steps into a single transform per object.
+ */
+void Character_generic::applySteps(const std::vector<AnimationStep>& steps, const std::vector<MeshObject*>& targets, bool returnHome)
+{
+    size_t i = 0;
+    while (i < steps.size()) {
+        AnimationDelta delta;
+        size_t next = AnimationTrack::fold(steps, i, delta);
+        if (!delta.empty) {
+            RenderDamage::invalidate();
+            for (auto object : targets) {
+                object->transformLocal(delta.pre, delta.post);
+            }
+        }
+        if (next < steps.size()) {
+            this->applyStep(steps[next], targets, returnHome);
+            next++;
+        }
+        i = next;
+    }
+}
+
+void Character_generic::applyStep(const AnimationStep& step, const std::vector<MeshObject*>& targets, bool returnHome)
+{
+    for (auto object : targets) {
+        switch (step.type) {
+        case Animations::AnimationType::TRANSLATE:
+            object->translate(step.amount);
+            break;
+        case Animations::AnimationType::ROTATE:
+            // TODO: this needs to compensate for the position of the object so that it rotates about its own axiseses
+            object->rotate(step.angle, step.axis);
+            break;
+        case Animations::AnimationType::SCALE_XYZ:
+        case Animations::AnimationType::UNIFORM_SCALE:
+            // TODO: this needs work. the calculated value needs to be on the range of 0 to infinity.
+            object->scale(step.amount);
+            break;
+        case Animations::AnimationType::ROTATE_ABOUT:
+            object->rotateAbout(step.angle, step.axis, step.point);
+            break;
+        case Animations::AnimationType::RETURN_HOME: {
+            if (!returnHome) {
+                break;
+            }
+            glm::mat4 modelDiff, projectionDiff, viewDiff;
+            glm::mat4 calcValueMat4 = glm::mat4(step.homeWeight); // TODO: this only works for linear easing. Might need to fix. Might not care.
+            // get the differences between the current position and the captured position
+            object->getRestorePositionDiff(&modelDiff, &viewDiff, &projectionDiff);
+            // apply the differences to the object
+            object->setModelMatrix(object->getModelMatrix() + (modelDiff * calcValueMat4));
+            object->setViewMatrix(object->getViewMatrix() + (viewDiff * calcValueMat4));
+            object->setProjectionMatrix(object->getProjectionMatrix() + (projectionDiff * calcValueMat4));
+            break;
+        }
+        default:
+            break;
+        }
     }
 }
 
@@ -680,6 +612,9 @@ bool Character_generic::setVisible(bool visible)
 {
     bool temp = this->visible;
     this->visible = visible;
+    if (temp != visible) {
+        RenderDamage::invalidate();
+    }
     return temp;
 }
 
@@ -703,37 +638,14 @@ std::string Character_generic::getName()
     return this->name;
 }
 
-void Character_generic::rotate(float angle, float x, float y, float z)
-{
-    for (auto object : this->objects) {
-        object->rotate(angle, glm::vec3(x, y, z));
-    }
-}
-
-void Character_generic::translate(float x, float y, float z)
-{
-    for (auto object : this->objects) {
-        object->translate(glm::vec3(x, y, z));
-    }
-}
-
-void Character_generic::scale(float x, float y, float z)
-{
-    for (auto object : this->objects) {
-        object->scale(glm::vec3(x, y, z));
-    }
-}
-
 // TODO: by default, this method will not interrupt the current animation. Need to implement interrupting.
 void Character_generic::triggerAnimation(Animations::AnimationNames_enum name, bool interrupt)
 {
     std::lock_guard<std::mutex> lock(this->nextMutex);
-    for (auto animation : this->animationLoader->getAnimationsVector()) {
-        if (animation.name == name) {
-            this->nextAnimation = this->animationLoader->getAnimationByEnum(name);
-            this->nextAnimationName = name;
-            return;
-        }
+    auto it = this->animationTracks.find(name);
+    if (it != this->animationTracks.end()) {
+        this->nextAnimation = &it->second;
+        this->nextAnimationName = name;
     }
 }
 
@@ -741,12 +653,10 @@ void Character_generic::triggerAnimation(Animations::AnimationNames_enum name, b
 void Character_generic::triggerExpression(Expressions::ExpressionNames_enum e, bool interrupt)
 {
     std::lock_guard<std::mutex> lock(this->nextMutex);
-    for (auto expression : this->expressionLoader->getExpressionsVector()) {
-        if (expression.name == e) {
-            this->nextExpression = e;
-            this->nextExpressionDef = this->expressionLoader->getExpressionByEnum(e);
-            return;
-        }
+    auto it = this->expressionTracks.find(e);
+    if (it != this->expressionTracks.end()) {
+        this->nextExpression = e;
+        this->nextExpressionTrack = &it->second;
     }
 }
 
@@ -40,6 +40,9 @@ SOFTWARE.
 #ifndef MESHLOADER_H
 #include "renderables/meshLoader.h"
 #endif // MESHLOADER_H
+#ifndef ANIMATIONTRACK_H
+#include "animationTrack.h"
+#endif // ANIMATIONTRACK_H
 #ifndef MESHOBJECT_H
 #include "renderables/meshObject.h"
 #endif // MESHOBJECT_H
@@ -102,9 +105,16 @@ struct CharacterPart {
 
 class Character_generic : public Object {
 private:
-    void rotate(float angle, float x, float y, float z);
-    void translate(float x, float y, float z);
-    void scale(float x, float y, float z);
+    // An expression compiled against this character's parts. Keyframes whose visibility row is missing
+    // or the wrong size are dropped at compile time, as expression() used to skip them every tick.
+    struct ExpressionTrack {
+        AnimationTrack track;
+        std::vector<MeshObject*> targets; // the objects of every part the expression names
+        std::vector<std::vector<std::pair<CharacterPart*, bool>>> visibility; // per kept keyframe
+    };
+    ExpressionTrack compileExpression(const ExpressionDefinition& expression);
+    void applySteps(const std::vector<AnimationStep>& steps, const std::vector<MeshObject*>& targets, bool returnHome);
+    void applyStep(const AnimationStep& step, const std::vector<MeshObject*>& targets, bool returnHome);
     std::string name;
     Shader* shader;
     std::vector<MeshObject*> objects;
@@ -115,13 +125,19 @@ private:
     unsigned long long expressionFrame;
     bool visible;
     Expressions::ExpressionNames_enum currentExpression;
-    Expressions::ExpressionNames_enum nextExpression;
+    Expressions::ExpressionNames_enum nextExpression = Expressions::ExpressionNames_enum::COUNT;
     Animations::AnimationNames_enum currentAnimationName;
-    Animations::AnimationNames_enum nextAnimationName;
-    Animation currentAnimation;
-    Animation nextAnimation;
-    ExpressionDefinition currentExpressionDef;
-    ExpressionDefinition nextExpressionDef;
+    Animations::AnimationNames_enum nextAnimationName = Animations::AnimationNames_enum::COUNT;
+    std::map<Animations::AnimationNames_enum, AnimationTrack> animationTracks;
+    std::map<Expressions::ExpressionNames_enum, ExpressionTrack> expressionTracks;
+    AnimationTrack* currentAnimation = nullptr;
+    AnimationTrack* nextAnimation = nullptr;
+    ExpressionTrack* currentExpressionTrack = nullptr;
+    ExpressionTrack* nextExpressionTrack = nullptr;
+    // scratch reused every tick
+    std::vector<AnimationStep> animationSteps;
+    std::vector<AnimationStep> expressionSteps;
+    std::vector<uint32_t> liveKeyframes;
     std::mutex currentMutex;
     std::mutex nextMutex;
 
@@ -0,0 +1,54 @@
+/*
+██████╗ ██████╗  █████╗ ██╗    ██╗██╗     ██╗███████╗████████╗    ██████╗██████╗ ██████╗
+██╔══██╗██╔══██╗██╔══██╗██║    ██║██║     ██║██╔════╝╚══██╔══╝   ██╔════╝██╔══██╗██╔══██╗
+██║  ██║██████╔╝███████║██║ █╗ ██║██║     ██║███████╗   ██║      ██║     ██████╔╝██████╔╝
+██║  ██║██╔══██╗██╔══██║██║███╗██║██║     ██║╚════██║   ██║      ██║     ██╔═══╝ ██╔═══╝
+██████╔╝██║  ██║██║  ██║╚███╔███╔╝███████╗██║███████║   ██║   ██╗╚██████╗██║     ██║
+╚═════╝ ╚═╝  ╚═╝╚═╝  ╚═╝ ╚══╝╚══╝ ╚══════╝╚═╝╚══════╝   ╚═╝   ╚═╝ ╚═════╝╚═╝     ╚═╝
+*/
+
+/*
+MIT License
+
+Copyright (c) 2026 A-McD Technology LLC
+*/
+
+#include "drawList.h"
+#include "objects.h"
+#include "renderables/primitiveBatch.h"
+#include "shader.h"
+#include <algorithm>
+
+uint64_t DrawList::key(const Shader* shader, GLuint texture)
+{
+    const uint64_t program = shader != nullptr ? shader->ID : 0;
+    // 16 bits of layer on top (see add()), then 24 bits each of program and texture name.
+    return ((program & 0xFFFFFF) << 24) | (static_cast<uint64_t>(texture) & 0xFFFFFF);
+}
+
+void DrawList::add(MeshObject* object, uint16_t layer)
+{
+    this->items.push_back({ (static_cast<uint64_t>(layer) << 48) | object->drawKey(), object });
+}
+
+void DrawList::clear()
+{
+    this->items.clear();
+}
+
+void DrawList::draw()
+{
+    std::stable_sort(this->items.begin(), this->items.end(), [](const Item& a, const Item& b) { return a.sortKey < b.sortKey; });
+    // A group of flat primitives (menu rules, for instance) streams into one batch; the next group's
+    // program bind flushes it.
+    PrimitiveBatch::Scope batch;
+    this->stateChanges = 0;
+    uint64_t current = UINT64_MAX;
+    for (const auto& item : this->items) {
+        if (item.sortKey != current) {
+            current = item.sortKey;
+            this->stateChanges++;
+        }
+        item.object->draw();
+    }
+}
@@ -0,0 +1,60 @@
+/*
+██████╗ ██████╗  █████╗ ██╗    ██╗██╗     ██╗███████╗████████╗   ██╗  ██╗
+██╔══██╗██╔══██╗██╔══██╗██║    ██║██║     ██║██╔════╝╚══██╔══╝   ██║  ██║
+██║  ██║██████╔╝███████║██║ █╗ ██║██║     ██║███████╗   ██║      ███████║
+██║  ██║██╔══██╗██╔══██║██║███╗██║██║     ██║╚════██║   ██║      ██╔══██║
+██████╔╝██║  ██║██║  ██║╚███╔███╔╝███████╗██║███████║   ██║   ██╗██║  ██║
+╚═════╝ ╚═╝  ╚═╝╚═╝  ╚═╝ ╚══╝╚══╝ ╚══════╝╚═╝╚══════╝   ╚═╝   ╚═╝╚═╝  ╚═╝
+*/
+
+/*
+MIT License
+
+Copyright (c) 2026 A-McD Technology LLC
+*/
+
+#pragma once
+#ifndef DRAWLIST_H
+#define DRAWLIST_H
+#include "GL/glew.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+class MeshObject;
+class Shader;
+
+/*
+
+Collects the MeshObjects of one compositing scope (a menu's entries, for instance) and draws them
+grouped by program and texture, so consecutive draws share GL state instead of alternating between
+the text atlas and widget textures object by object.
+
+Ordering that matters is kept: entries are sorted by layer first, and the sort is stable, so objects
+with the same layer and state keep the order they were added in. Only add objects whose relative draw
+order within a layer does not matter (non-overlapping UI pieces, or depth-tested ones).
+
+*/
+
+class DrawList {
+public:
+    // Sort key for a program/texture pair; MeshObject::drawKey() implementations build theirs with this.
+    static uint64_t key(const Shader* shader, GLuint texture);
+
+    void add(MeshObject* object, uint16_t layer = 0);
+    void clear();
+    bool empty() const { return this->items.empty(); }
+    void draw();
+    // Number of program/texture switches the last draw() needed; equals the number of groups.
+    size_t lastStateChanges() const { return this->stateChanges; }
+
+private:
+    struct Item {
+        uint64_t sortKey;
+        MeshObject* object;
+    };
+    std::vector<Item> items;
+    size_t stateChanges = 0;
+};
+
+#endif // DRAWLIST_H
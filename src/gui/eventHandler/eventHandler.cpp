@@ -33,6 +33,7 @@ SOFTWARE.
 
 #include "eventHandler.h"
 
+#include <algorithm>
 #include <cmath>
 
 EventHandler::EventHandler()
@@ -83,11 +84,13 @@ CubeEventType EventHandler::getEventType()
 void EventHandler::setEventType(CubeEventType eventType)
 {
     this->eventType = eventType;
+    routingGeneration.fetch_add(1, std::memory_order_relaxed);
 }
 
 void EventHandler::setSpecificEventType(SpecificEventTypes specificEventType)
 {
     this->specificEventType = specificEventType;
+    routingGeneration.fetch_add(1, std::memory_order_relaxed);
 }
 
 SpecificEventTypes EventHandler::getSpecificEventType()
@@ -115,6 +118,7 @@ int EventManager::createEvent(const std::string& eventName)
     EventHandler* event = new EventHandler();
     event->setName(eventName);
     this->events.push_back(event);
+    EventHandler::routingGeneration.fetch_add(1, std::memory_order_relaxed);
     return static_cast<int>(this->events.size() - 1);
 }
 
@@ -124,6 +128,7 @@ bool EventManager::removeEvent(EventHandler* event)
         if (this->events[i] == event) {
             delete this->events[i];
             this->events.erase(this->events.begin() + static_cast<long>(i));
+            EventHandler::routingGeneration.fetch_add(1, std::memory_order_relaxed);
             return true;
         }
     }
@@ -138,6 +143,7 @@ bool EventManager::removeEvent(int index)
     }
     delete this->events[index];
     this->events.erase(this->events.begin() + index);
+    EventHandler::routingGeneration.fetch_add(1, std::memory_order_relaxed);
     return true;
 }
 
@@ -147,6 +153,7 @@ bool EventManager::removeEvent(const std::string& eventName)
         if (this->events[i]->getName() == eventName) {
             delete this->events[i];
             this->events.erase(this->events.begin() + static_cast<long>(i));
+            EventHandler::routingGeneration.fetch_add(1, std::memory_order_relaxed);
             return true;
         }
     }
@@ -215,53 +222,112 @@ bool EventManager::triggerEvent(const std::string& eventName, const CubeEvent& e
     return anyTriggered;
 }
 
-bool EventManager::triggerEvent(CubeEventType eventType, const CubeEvent& event)
+namespace {
+uint64_t routeKey(CubeEventType eventType, SpecificEventTypes specificEventType)
 {
-    bool anyTriggered = false;
-    for (size_t i = 0; i < this->events.size(); i++) {
-        if (this->events[i]->getEventType() == eventType
-            && this->events[i]->getSpecificEventType() == SpecificEventTypes::NULL_EVENT) {
-            anyTriggered = this->events[i]->triggerEvent(event) || anyTriggered;
+    return (static_cast<uint64_t>(eventType) << 32) | static_cast<uint64_t>(specificEventType);
+}
+} // namespace
+
+/**
+ * @brief The dispatch table, rebuilt if handlers were added, removed or retyped since the last event.
+ * Handlers keep their creation order within a key.
+ */
+std::shared_ptr<const EventManager::RouteTable> EventManager::currentRoutes()
+{
+    const uint64_t generation = EventHandler::routingGeneration.load(std::memory_order_relaxed);
+    if (!this->routes || generation != this->routesGeneration) {
+        auto table = std::make_shared<RouteTable>();
+        for (EventHandler* handler : this->events) {
+            (*table)[routeKey(handler->getEventType(), handler->getSpecificEventType())].push_back(handler);
         }
+        this->routes = std::move(table);
+        this->routesGeneration = generation;
     }
-    return anyTriggered;
+    return this->routes;
 }
 
-bool EventManager::triggerEvent(SpecificEventTypes specificEventType, const CubeEvent& event)
+bool EventManager::dispatch(CubeEventType eventType, SpecificEventTypes specificEventType, const CubeEvent& event)
 {
-    if (specificEventType == SpecificEventTypes::NULL_EVENT) {
+    const auto table = this->currentRoutes();
+    const auto it = table->find(routeKey(eventType, specificEventType));
+    if (it == table->end()) {
         return false;
     }
-
     bool anyTriggered = false;
-    for (size_t i = 0; i < this->events.size(); i++) {
-        if (this->events[i]->getSpecificEventType() == specificEventType
-            && this->events[i]->getEventType() == CubeEventType::None) {
-            anyTriggered = this->events[i]->triggerEvent(event) || anyTriggered;
-        }
+    for (EventHandler* handler : it->second) {
+        anyTriggered = handler->triggerEvent(event) || anyTriggered;
     }
     return anyTriggered;
 }
 
-bool EventManager::triggerEvent(SpecificEventTypes specificEventType, CubeEventType eventType, const CubeEvent& event)
+bool EventManager::triggerEvent(CubeEventType eventType, const CubeEvent& event)
+{
+    return dispatch(eventType, SpecificEventTypes::NULL_EVENT, event);
+}
+
+bool EventManager::triggerEvent(SpecificEventTypes specificEventType, const CubeEvent& event)
 {
     if (specificEventType == SpecificEventTypes::NULL_EVENT) {
         return false;
     }
+    return dispatch(CubeEventType::None, specificEventType, event);
+}
 
-    bool anyTriggered = false;
-    for (size_t i = 0; i < this->events.size(); i++) {
-        if (this->events[i]->getEventType() == eventType
-            && this->events[i]->getSpecificEventType() == specificEventType) {
-            anyTriggered = this->events[i]->triggerEvent(event) || anyTriggered;
-        }
+bool EventManager::triggerEvent(SpecificEventTypes specificEventType, CubeEventType eventType, const CubeEvent& event)
+{
+    if (specificEventType == SpecificEventTypes::NULL_EVENT) {
+        return false;
     }
-    return anyTriggered;
+    return dispatch(eventType, specificEventType, event);
 }
 
+/**
+ * @brief Register an area for pointer hit testing. Adding an area that is already registered does nothing.
+ *
+ * @param clickableArea the area to register
+ */
 void EventManager::addClickableArea(ClickableArea* clickableArea)
 {
+    std::lock_guard<std::recursive_mutex> lock(this->clickableAreasMutex);
+    if (std::find(this->clickableAreas.begin(), this->clickableAreas.end(), clickableArea) != this->clickableAreas.end()) {
+        return;
+    }
     this->clickableAreas.push_back(clickableArea);
+    this->hitGridDirty = true;
+}
+
+/**
+ * @brief Stop hit testing an area. Once this returns no event is being dispatched to it, so its owner can be deleted.
+ *
+ * @param clickableArea the area to drop
+ * @return true if the area was registered
+ */
+bool EventManager::removeClickableArea(ClickableArea* clickableArea)
+{
+    std::lock_guard<std::recursive_mutex> lock(this->clickableAreasMutex);
+    auto it = std::find(this->clickableAreas.begin(), this->clickableAreas.end(), clickableArea);
+    if (it == this->clickableAreas.end()) {
+        return false;
+    }
+    this->clickableAreas.erase(it);
+    this->hitGridDirty = true;
+    return true;
+}
+
+/**
+ * @brief The hit-test grid, re-binned if areas were registered, dropped, moved, shown or hidden
+ * since the last click. Must be called with clickableAreasMutex held.
+ */
+const HitGrid& EventManager::currentHitGrid()
+{
+    const uint64_t generation = ClickableArea::generation.load(std::memory_order_relaxed);
+    if (this->hitGridDirty || generation != this->hitGridGeneration) {
+        this->hitGrid.rebuild(this->clickableAreas);
+        this->hitGridDirty = false;
+        this->hitGridGeneration = generation;
+    }
+    return this->hitGrid;
 }
 
 bool EventManager::checkClickableAreas(const CubeEvent& event)
@@ -287,9 +353,12 @@ bool EventManager::checkClickableAreas(const CubeEvent& event)
     const int yChange = event.y - mouseDownY;
     const float distance = std::sqrt(static_cast<float>((xChange * xChange) + (yChange * yChange)));
 
+    std::unique_lock<std::recursive_mutex> areasLock(this->clickableAreasMutex);
     if ((event.type == CubeEventType::MouseButtonPressed || event.type == CubeEventType::MouseButtonReleased) && distance < CLICK_THRESHOLD_PX) {
-        for (ClickableArea* area : this->clickableAreas) {
-            if (area == nullptr || area->clickableObject == nullptr || !area->clickableObject->getIsClickable()) {
+        // Copied because a handler that registers or drops areas marks the grid for a rebuild.
+        const std::vector<ClickableArea*> candidates = this->currentHitGrid().candidates(event.x, event.y);
+        for (ClickableArea* area : candidates) {
+            if (area->clickableObject == nullptr || !area->clickableObject->getIsClickable()) {
                 continue;
             }
 
@@ -313,6 +382,7 @@ bool EventManager::checkClickableAreas(const CubeEvent& event)
             }
         }
     } else if (event.type == CubeEventType::MouseMoved && this->primaryPointerDown) {
+        areasLock.unlock();
         if (std::abs(yChange) > CLICK_THRESHOLD_PX || std::abs(xChange) > CLICK_THRESHOLD_PX) {
             CubeEvent dragEvent = event;
             dragEvent.deltaX = event.x - lastPointerX;
@@ -324,8 +394,9 @@ bool EventManager::checkClickableAreas(const CubeEvent& event)
             }
         }
     } else if (event.type == CubeEventType::MouseButtonReleased) {
-        for (ClickableArea* area : this->clickableAreas) {
-            if (area == nullptr || area->clickableObject == nullptr || !area->clickableObject->getIsClickable()) {
+        const std::vector<ClickableArea*> clickable = this->currentHitGrid().clickable();
+        for (ClickableArea* area : clickable) {
+            if (area->clickableObject == nullptr || !area->clickableObject->getIsClickable()) {
                 continue;
             }
             area->clickableObject->onRelease(event);
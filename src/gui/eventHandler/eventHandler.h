@@ -35,12 +35,17 @@ SOFTWARE.
 
 #include "../objects.h"
 #include "cubeEvent.h"
+#include "hitGrid.h"
+#include <atomic>
 #include <functional>
+#include <memory>
+#include <mutex>
 #ifndef LOGGER_H
 #include <logger.h>
 #endif
 #include <string>
 #include <tuple>
+#include <unordered_map>
 #include <vector>
 
 class EventHandler {
@@ -61,12 +66,32 @@ public:
     void setEventType(CubeEventType eventType);
     void setSpecificEventType(SpecificEventTypes specificEventType);
     SpecificEventTypes getSpecificEventType();
+
+    // Bumped whenever a handler's types change so EventManager rebuilds its dispatch table.
+    inline static std::atomic<uint64_t> routingGeneration { 0 };
 };
 
 class EventManager {
 private:
     std::vector<EventHandler*> events;
     std::vector<ClickableArea*> clickableAreas;
+    // Menus built on demand register and drop their areas from the render thread. Recursive because
+    // click handlers run with it held and may add areas themselves.
+    std::recursive_mutex clickableAreasMutex;
+    HitGrid hitGrid;
+    bool hitGridDirty = true;
+    uint64_t hitGridGeneration = 0;
+    const HitGrid& currentHitGrid();
+
+    // Handlers keyed by (event type, specific type). Dispatch takes a reference to the current
+    // table, so a handler that creates or retypes handlers while running doesn't pull the
+    // vector out from under the loop that called it.
+    using RouteTable = std::unordered_map<uint64_t, std::vector<EventHandler*>>;
+    std::shared_ptr<const RouteTable> routes;
+    uint64_t routesGeneration = 0;
+    std::shared_ptr<const RouteTable> currentRoutes();
+    bool dispatch(CubeEventType eventType, SpecificEventTypes specificEventType, const CubeEvent& event);
+
     bool checkClickableAreas(const CubeEvent& event);
     std::tuple<int, int> mouseDownPosition;
     std::tuple<int, int> lastPointerPosition;
@@ -90,4 +115,5 @@ public:
     bool triggerEvent(SpecificEventTypes specificEventType, CubeEventType eventType, const CubeEvent& event);
     std::vector<EventHandler*> getEvents();
     void addClickableArea(ClickableArea* clickableArea);
+    bool removeClickableArea(ClickableArea* clickableArea);
 };
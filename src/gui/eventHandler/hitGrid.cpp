@@ -0,0 +1,80 @@
+/*
+██╗  ██╗██╗████████╗ ██████╗ ██████╗ ██╗██████╗     ██████╗██████╗ ██████╗
+██║  ██║██║╚══██╔══╝██╔════╝ ██╔══██╗██║██╔══██╗   ██╔════╝██╔══██╗██╔══██╗
+███████║██║   ██║   ██║  ███╗██████╔╝██║██║  ██║   ██║     ██████╔╝██████╔╝
+██╔══██║██║   ██║   ██║   ██║██╔══██╗██║██║  ██║   ██║     ██╔═══╝ ██╔═══╝
+██║  ██║██║   ██║   ╚██████╔╝██║  ██║██║██████╔╝██╗╚██████╗██║     ██║
+╚═╝  ╚═╝╚═╝   ╚═╝    ╚═════╝ ╚═╝  ╚═╝╚═╝╚═════╝ ╚═╝ ╚═════╝╚═╝     ╚═╝
+*/
+
+/*
+MIT License
+
+Copyright (c) 2026 A-McD Technology LLC
+*/
+
+
+#include "hitGrid.h"
+#include <algorithm>
+
+long HitGrid::cellOf(long px)
+{
+    return std::clamp(px / CELL_PX, 0L, CELLS_PER_SIDE - 1);
+}
+
+/**
+ * @brief Re-bin every clickable area. Degenerate rectangles can never contain a point and are left out.
+ *
+ * @param areas the registered areas, in dispatch order
+ */
+void HitGrid::rebuild(const std::vector<ClickableArea*>& areas)
+{
+    for (auto& cell : this->cells) {
+        cell.clear();
+    }
+    this->clickableAreas.clear();
+    for (ClickableArea* area : areas) {
+        if (area == nullptr || area->clickableObject == nullptr || !area->clickableObject->getIsClickable()) {
+            continue;
+        }
+        this->clickableAreas.push_back(area);
+        if (area->xMax <= area->xMin || area->yMax <= area->yMin) {
+            continue;
+        }
+        const long cx0 = cellOf(area->xMin), cx1 = cellOf(area->xMax);
+        const long cy0 = cellOf(area->yMin), cy1 = cellOf(area->yMax);
+        for (long cy = cy0; cy <= cy1; cy++) {
+            for (long cx = cx0; cx <= cx1; cx++) {
+                this->cells[cy * CELLS_PER_SIDE + cx].push_back(area);
+            }
+        }
+    }
+}
+
+/**
+ * @brief The areas that may contain (x, y). Callers still test the rectangle itself.
+ */
+const std::vector<ClickableArea*>& HitGrid::candidates(long x, long y) const
+{
+    return this->cells[cellOf(y) * CELLS_PER_SIDE + cellOf(x)];
+}
+
+/**
+ * @brief Every area that was clickable at the last rebuild, in registration order.
+ */
+const std::vector<ClickableArea*>& HitGrid::clickable() const
+{
+    return this->clickableAreas;
+}
+
+/**
+ * @brief Total number of cell entries, i.e. how much work a full rebuild does.
+ */
+size_t HitGrid::entries() const
+{
+    size_t total = 0;
+    for (const auto& cell : this->cells) {
+        total += cell.size();
+    }
+    return total;
+}
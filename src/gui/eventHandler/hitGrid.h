@@ -0,0 +1,52 @@
+/*
+██╗  ██╗██╗████████╗ ██████╗ ██████╗ ██╗██████╗    ██╗  ██╗
+██║  ██║██║╚══██╔══╝██╔════╝ ██╔══██╗██║██╔══██╗   ██║  ██║
+███████║██║   ██║   ██║  ███╗██████╔╝██║██║  ██║   ███████║
+██╔══██║██║   ██║   ██║   ██║██╔══██╗██║██║  ██║   ██╔══██║
+██║  ██║██║   ██║   ╚██████╔╝██║  ██║██║██████╔╝██╗██║  ██║
+╚═╝  ╚═╝╚═╝   ╚═╝    ╚═════╝ ╚═╝  ╚═╝╚═╝╚═════╝ ╚═╝╚═╝  ╚═╝
+*/
+
+/*
+MIT License
+
+Copyright (c) 2026 A-McD Technology LLC
+*/
+
+
+#pragma once
+#ifndef HITGRID_H
+#define HITGRID_H
+
+#include "../objects.h"
+#include <vector>
+
+/*
+Uniform grid over the 720x720 UI used to hit-test pointer events. Only areas that were clickable
+when the grid was built are binned, so the dozens of menus that share the same screen space while
+hidden cost nothing. Each cell lists the areas whose rectangle overlaps it in registration order,
+which means a click looks at the handful of areas under the pointer and still picks the same one
+a front-to-back scan of every area would. Points and rectangles past the edges are clamped into the
+border cells, keeping that equivalence for areas that extend off screen.
+
+The grid is a snapshot: EventManager rebuilds it whenever ClickableArea::changed() was called, and
+callers still check the rectangle and getIsClickable() on every candidate.
+*/
+class HitGrid {
+public:
+    static constexpr long EXTENT_PX = 720;
+    static constexpr long CELL_PX = 48;
+    static constexpr long CELLS_PER_SIDE = EXTENT_PX / CELL_PX;
+
+    void rebuild(const std::vector<ClickableArea*>& areas);
+    const std::vector<ClickableArea*>& candidates(long x, long y) const;
+    const std::vector<ClickableArea*>& clickable() const;
+    size_t entries() const;
+
+private:
+    static long cellOf(long px);
+    std::vector<ClickableArea*> clickableAreas;
+    std::vector<ClickableArea*> cells[CELLS_PER_SIDE * CELLS_PER_SIDE];
+};
+
+#endif // HITGRID_H
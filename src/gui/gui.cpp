@@ -47,6 +47,7 @@ SOFTWARE.
 
 #include "./gui.h"
 #include "../decisionEngine/notificationCenter.h"
+#include "../telemetry/metrics.h"
 #include <algorithm>
 #include <atomic>
 #include <chrono>
@@ -69,6 +70,48 @@ namespace {
 std::atomic<uint64_t> gNotificationBoxGeneration { 0 };
 std::vector<MENUS::Menu*> gSuspendedMenus;
 
+struct MenuMetrics {
+    std::shared_ptr<Metrics::Gauge> interactive;
+    std::shared_ptr<Metrics::Gauge> resident;
+    std::shared_ptr<Metrics::Gauge> vertexBytes;
+    std::shared_ptr<Metrics::Gauge> atlasBytes;
+    std::shared_ptr<Metrics::Counter> built;
+    std::shared_ptr<Metrics::Counter> evicted;
+
+    static MenuMetrics& get()
+    {
+        static MenuMetrics metrics = []() {
+            auto& registry = Metrics::MetricsRegistry::instance();
+            return MenuMetrics {
+                registry.gauge("gui_boot_interactive_seconds", "Time from renderer creation until menus accept input"),
+                registry.gauge("gui_menus_resident", "Menus currently built"),
+                registry.gauge("gui_menu_vertex_bytes", "Vertex bytes held by built menus"),
+                registry.gauge("gui_glyph_atlas_bytes", "Texture bytes held by the glyph atlas"),
+                registry.counter("gui_menus_built_total", "Menus built from their described content"),
+                registry.counter("gui_menus_evicted_total", "Menus dropped to stay within the resident limit or under memory pressure"),
+            };
+        }();
+        return metrics;
+    }
+};
+
+size_t configSize(const std::string& key, size_t fallback)
+{
+    try {
+        return static_cast<size_t>(std::max(0, std::stoi(Config::get(key, std::to_string(fallback)))));
+    } catch (const std::exception&) {
+        CubeLog::warning("Invalid value for " + key + ", using " + std::to_string(fallback));
+        return fallback;
+    }
+}
+
+bool menuMemoryPressure()
+{
+    static const uint64_t threshold = configSize("GUI_MENU_EVICT_BELOW_MB", 64) * 1024 * 1024;
+    const auto available = MenuResidency::availableMemory();
+    return available.has_value() && *available < threshold;
+}
+
 int clampAndSnapSliderValue(int value, int minValue, int maxValue, int step)
 {
     if (minValue >= maxValue) {
@@ -324,9 +367,10 @@ void GUI::eventLoop(std::stop_token stopToken)
     /// Here we build the menus
     ////////////////////////////////////////
 
-    // this value must be equal to count of "new MENUS::Menu()" calls in this method plus the popup boxes created below.
-    // TODO: make this dynamic
-    CountingLatch countingLatch(44);
+    // Only the main menu and the popup boxes below are built before the UI is interactive; submenus are
+    // described here and built the first time they're opened (see GUI::openMenu()).
+    CountingLatch countingLatch(5);
+    this->menuResidency.setLimit(std::max<size_t>(1, configSize("GUI_MENU_RESIDENT_LIMIT", 12)));
 
 // This ifdef is part of a hack to make intellisense play well with the lambda functions. This is defined in cmakelists.txt so that when we compile, the lambdas are enabled.
 // Intellisense struggles with lots of lambdas, so this is a workaround. Uncomment the define at the top of this file to enable intellisense to see the lambdas.
@@ -355,30 +399,27 @@ void GUI::eventLoop(std::stop_token stopToken)
         menu->setChildrenClickables_isClickable(false);
     };
 
-    // Helper function to add a menu to its parent menu
-    auto addToParent = [](auto* menu) {
-        menu->getParentMenu()->addMenuEntry(
-            menu->getMenuName(),
-            menu->getParentMenu()->getMenuName() + "_" + menu->getMenuName(),
-            MENUS::EntryType::MENUENTRY_TYPE_SUBMENU,
-            [menu](void* data) {
-                CubeLog::info(menu->getMenuName() + " clicked");
-                menu->setVisible(true);
-                menu->setIsClickable(false);
-                menu->setChildrenClickables_isClickable(true);
-                menu->getParentMenu()->setVisible(false);
-                menu->getParentMenu()->setIsClickable(false);
-                menu->getParentMenu()->setChildrenClickables_isClickable(false);
-                return 0;
-            },
-            [](void*) { return 0; },
-            nullptr);
-        menu->getParentMenu()->setChildrenClickables_isClickable(false);
+    // Helper function to add a menu to its parent menu. The link is part of the parent's content, so it is
+    // rebuilt along with the parent.
+    auto addToParent = [this](auto* menu) {
+        menu->getParentMenu()->describe([this, menu]() {
+            menu->getParentMenu()->addMenuEntry(
+                menu->getMenuName(),
+                menu->getParentMenu()->getMenuName() + "_" + menu->getMenuName(),
+                MENUS::EntryType::MENUENTRY_TYPE_SUBMENU,
+                [this, menu](void* data) {
+                    CubeLog::info(menu->getMenuName() + " clicked");
+                    this->openMenu(menu);
+                    return 0;
+                },
+                [](void*) { return 0; },
+                nullptr);
+        });
     };
 
     // Helper function to create a new submenu
     auto createANewSubMenu = [&](const std::string& name, const std::string& u_id, MENUS::Menu* parent) -> MENUS::Menu* {
-        auto m = new MENUS::Menu(this->renderer, countingLatch, 0, 0, 0, 0);
+        auto m = new MENUS::Menu(this->renderer, 0, 0, 0, 0);
         m->setMenuName(name);
         m->setUniqueMenuIdentifier(u_id);
         m->setVisible(false);
@@ -393,6 +434,7 @@ void GUI::eventLoop(std::stop_token stopToken)
             m->draw();
         });
         menus.push_back(m);
+        describedMenus[u_id] = m;
         return m;
     };
 
@@ -402,10 +444,10 @@ void GUI::eventLoop(std::stop_token stopToken)
     mainMenu->setMenuName(_("Main Menu"));
     mainMenu->setUniqueMenuIdentifier("Main Menu");
     menus.push_back(mainMenu);
+    describedMenus["Main Menu"] = mainMenu;
     drag_y_actions.push_back({ [&mainMenu]() { return mainMenu->getVisible(); }, [mainMenu](int y) { mainMenu->scrollVert(y); } });
-    this->renderer->addSetupTask([&mainMenu, addBackButton]() {
+    mainMenu->describe([mainMenu, addBackButton]() {
         addBackButton(mainMenu);
-        mainMenu->setup();
     });
     mainMenu->setOnClick([&](void* data) {
         mainMenu->setVisible(!mainMenu->getVisible());
@@ -444,16 +486,14 @@ void GUI::eventLoop(std::stop_token stopToken)
     /////////
     ///////// Connections Menu /////////
     auto connectionsMenu = createANewSubMenu(_("Connections"), "Connections", mainMenu);
-    this->renderer->addSetupTask([&connectionsMenu, addBackButton, addToParent]() {
+    connectionsMenu->describe([connectionsMenu, addBackButton]() {
         addBackButton(connectionsMenu);
-        connectionsMenu->setup();
-        addToParent(connectionsMenu);
-        connectionsMenu->setChildrenClickables_isClickable(false);
     });
+    addToParent(connectionsMenu);
 
     ///////// Connections Menu - WiFi /////////
     auto wifiMenu = createANewSubMenu(_("WiFi"), "WiFi", connectionsMenu);
-    this->renderer->addSetupTask([&wifiMenu, addBackButton, addToParent]() {
+    wifiMenu->describe([wifiMenu, addBackButton]() {
         addBackButton(wifiMenu);
         ///////// Connections Menu - WiFi - Enable/Disable WiFi /////////
         wifiMenu->addMenuEntry(
@@ -470,61 +510,49 @@ void GUI::eventLoop(std::stop_token stopToken)
             },
             nullptr);
         ///////// Connections Menu - WiFi - Current Network /////////
-        wifiMenu->setup();
-        addToParent(wifiMenu);
-        wifiMenu->setChildrenClickables_isClickable(false);
     });
+    addToParent(wifiMenu);
 
     ///////// Connections Menu - WiFi - WiFi Networks /////////
     auto wifiMenu_Networks = createANewSubMenu(_("WiFi Networks"), "WiFi Networks", wifiMenu);
-    this->renderer->addSetupTask([&wifiMenu_Networks, addBackButton, addToParent]() {
+    wifiMenu_Networks->describe([wifiMenu_Networks, addBackButton]() {
         addBackButton(wifiMenu_Networks);
-        wifiMenu_Networks->setup();
-        addToParent(wifiMenu_Networks);
-        wifiMenu_Networks->setChildrenClickables_isClickable(false);
     });
+    addToParent(wifiMenu_Networks);
 
     ///////// Connections Menu - WiFi - WiFi Networks - Add Network /////////
     auto wifiMenu_Networks_AddNetwork = createANewSubMenu(_("Add Network"), "Add Network", wifiMenu_Networks);
-    this->renderer->addSetupTask([&wifiMenu_Networks_AddNetwork, addBackButton, addToParent]() {
+    wifiMenu_Networks_AddNetwork->describe([wifiMenu_Networks_AddNetwork, addBackButton]() {
         addBackButton(wifiMenu_Networks_AddNetwork);
-        wifiMenu_Networks_AddNetwork->setup();
-        addToParent(wifiMenu_Networks_AddNetwork);
-        wifiMenu_Networks_AddNetwork->setChildrenClickables_isClickable(false);
     });
+    addToParent(wifiMenu_Networks_AddNetwork);
 
     ///////// Connections Menu - WiFi - WiFi Networks - Add Network - SSID /////////
     auto wifiMenu_Networks_AddNetwork_SSID = createANewSubMenu(_("SSID"), "SSID", wifiMenu_Networks_AddNetwork);
-    this->renderer->addSetupTask([&wifiMenu_Networks_AddNetwork_SSID, addBackButton, addToParent]() {
+    wifiMenu_Networks_AddNetwork_SSID->describe([wifiMenu_Networks_AddNetwork_SSID, addBackButton]() {
         addBackButton(wifiMenu_Networks_AddNetwork_SSID);
         // TODO: add a text box to enter the SSID
-        wifiMenu_Networks_AddNetwork_SSID->setup();
-        addToParent(wifiMenu_Networks_AddNetwork_SSID);
-        wifiMenu_Networks_AddNetwork_SSID->setChildrenClickables_isClickable(false);
     });
+    addToParent(wifiMenu_Networks_AddNetwork_SSID);
 
     ///////// Connections Menu - WiFi - WiFi Networks - Add Network - Security Type /////////
     auto wifiMenu_Networks_AddNetwork_SecurityType = createANewSubMenu(_("Security Type"), "Security Type", wifiMenu_Networks_AddNetwork);
-    this->renderer->addSetupTask([&wifiMenu_Networks_AddNetwork_SecurityType, addBackButton, addToParent]() {
+    wifiMenu_Networks_AddNetwork_SecurityType->describe([wifiMenu_Networks_AddNetwork_SecurityType, addBackButton]() {
         addBackButton(wifiMenu_Networks_AddNetwork_SecurityType);
         // TODO: add a dropdown to select the security type
-        wifiMenu_Networks_AddNetwork_SecurityType->setup();
-        addToParent(wifiMenu_Networks_AddNetwork_SecurityType);
-        wifiMenu_Networks_AddNetwork_SecurityType->setChildrenClickables_isClickable(false);
     });
+    addToParent(wifiMenu_Networks_AddNetwork_SecurityType);
 
     ///////// Connections Menu - WiFi - WiFi Networks - Add Network - Password /////////
     auto wifiMenu_Networks_AddNetwork_Password = createANewSubMenu(_("Password"), "Password", wifiMenu_Networks_AddNetwork);
-    this->renderer->addSetupTask([&wifiMenu_Networks_AddNetwork_Password, addBackButton, addToParent]() {
+    wifiMenu_Networks_AddNetwork_Password->describe([wifiMenu_Networks_AddNetwork_Password, addBackButton]() {
         addBackButton(wifiMenu_Networks_AddNetwork_Password);
         // TODO: add a text box to enter the password
-        wifiMenu_Networks_AddNetwork_Password->setup();
-        addToParent(wifiMenu_Networks_AddNetwork_Password);
-        wifiMenu_Networks_AddNetwork_Password->setChildrenClickables_isClickable(false);
     });
+    addToParent(wifiMenu_Networks_AddNetwork_Password);
 
     ///////// Connections Menu - WiFi - WiFi Networks - Add Network - Connect /////////
-    this->renderer->addSetupTask([&wifiMenu_Networks_AddNetwork]() {
+    wifiMenu_Networks_AddNetwork->describe([wifiMenu_Networks_AddNetwork]() {
         wifiMenu_Networks_AddNetwork->addMenuEntry(
             _("Connect"),
             "Connect",
@@ -536,13 +564,11 @@ void GUI::eventLoop(std::stop_token stopToken)
             },
             [](void*) { return 0; },
             nullptr);
-        wifiMenu_Networks_AddNetwork->setup();
-        wifiMenu_Networks_AddNetwork->setChildrenClickables_isClickable(false);
     });
 
     ///////// Connections Menu - WiFi - WiFi Networks - Scan /////////
     auto wifiMenu_Networks_Scan = createANewSubMenu(_("Scan"), "Scan", wifiMenu_Networks);
-    this->renderer->addSetupTask([&wifiMenu_Networks_Scan, addBackButton, addToParent]() {
+    wifiMenu_Networks_Scan->describe([wifiMenu_Networks_Scan, addBackButton]() {
         addBackButton(wifiMenu_Networks_Scan);
         auto entryIndex = std::make_shared<unsigned int>();
         *entryIndex = UINT_MAX;
@@ -565,24 +591,20 @@ void GUI::eventLoop(std::stop_token stopToken)
             },
             nullptr);
         wifiMenu_Networks_Scan->addHorizontalRule();
-        wifiMenu_Networks_Scan->setup();
-        addToParent(wifiMenu_Networks_Scan);
-        wifiMenu_Networks_Scan->setChildrenClickables_isClickable(false);
     });
+    addToParent(wifiMenu_Networks_Scan);
 
     ///////// Connections Menu - WiFi - WiFi Networks - Known networks /////////
     auto wifiMenu_Networks_KnownNetworks = createANewSubMenu(_("Known Networks"), "Known Networks", wifiMenu_Networks);
-    this->renderer->addSetupTask([&wifiMenu_Networks_KnownNetworks, addBackButton, addToParent]() {
+    wifiMenu_Networks_KnownNetworks->describe([wifiMenu_Networks_KnownNetworks, addBackButton]() {
         addBackButton(wifiMenu_Networks_KnownNetworks);
         // TODO: list all the known networks
-        wifiMenu_Networks_KnownNetworks->setup();
-        addToParent(wifiMenu_Networks_KnownNetworks);
-        wifiMenu_Networks_KnownNetworks->setChildrenClickables_isClickable(false);
     });
+    addToParent(wifiMenu_Networks_KnownNetworks);
 
     ///////// Connections Menu - WiFi - About WiFi /////////
     auto wifiMenu_AboutWiFi = createANewSubMenu(_("About WiFi"), "About WiFi", wifiMenu);
-    this->renderer->addSetupTask([&wifiMenu_AboutWiFi, addBackButton, addToParent]() {
+    wifiMenu_AboutWiFi->describe([wifiMenu_AboutWiFi, addBackButton]() {
         addBackButton(wifiMenu_AboutWiFi);
         ///////// Connections Menu - WiFi - About WiFi - MAC Address /////////
         auto entryIndex0 = std::make_shared<unsigned int>();
@@ -844,14 +866,12 @@ void GUI::eventLoop(std::stop_token stopToken)
             },
             [](void*) { return 0; },
             nullptr);
-        wifiMenu_AboutWiFi->setup();
-        addToParent(wifiMenu_AboutWiFi);
-        wifiMenu_AboutWiFi->setChildrenClickables_isClickable(false);
     });
+    addToParent(wifiMenu_AboutWiFi);
 
     ///////// Connections Menu - Bluetooth /////////
     auto bluetoothMenu = createANewSubMenu(_("Bluetooth"), "Bluetooth", connectionsMenu);
-    this->renderer->addSetupTask([&bluetoothMenu, addBackButton, addToParent]() {
+    bluetoothMenu->describe([bluetoothMenu, addBackButton]() {
         addBackButton(bluetoothMenu);
         ///////// Connections Menu - Bluetooth - Enable/Disable Bluetooth /////////
         // Options below should be greyed out and not clickable if bluetooth is disabled
@@ -863,14 +883,12 @@ void GUI::eventLoop(std::stop_token stopToken)
         // TODO: list all the bluetooth devices that have been paired with the cube
 
         ///////// Connections Menu - Bluetooth - About Bluetooth /////////
-        bluetoothMenu->setup();
-        addToParent(bluetoothMenu);
-        bluetoothMenu->setChildrenClickables_isClickable(false);
     });
+    addToParent(bluetoothMenu);
 
     ///////// Connections Menu - NFC /////////
     auto nfcMenu = createANewSubMenu(_("NFC"), "NFC", connectionsMenu);
-    this->renderer->addSetupTask([&nfcMenu, addBackButton, addToParent]() {
+    nfcMenu->describe([nfcMenu, addBackButton]() {
         addBackButton(nfcMenu);
         ///////// Connections Menu - NFC - Enable/Disable NFC /////////
         nfcMenu->addMenuEntry(
@@ -901,14 +919,12 @@ void GUI::eventLoop(std::stop_token stopToken)
             },
             [](void*) { return 0; },
             nullptr);
-        nfcMenu->setup();
-        addToParent(nfcMenu);
-        nfcMenu->setChildrenClickables_isClickable(false);
     });
+    addToParent(nfcMenu);
 
     ///////// Personality Menu /////////
     auto personalityMenu = createANewSubMenu(_("Personality"), "Personality", mainMenu);
-    this->renderer->addSetupTask([&personalityMenu, addBackButton, addToParent]() {
+    personalityMenu->describe([personalityMenu, addBackButton]() {
         addBackButton(personalityMenu);
         ///////// Personality Menu - Enable/Disable Personality /////////
         personalityMenu->addMenuEntry(
@@ -939,17 +955,15 @@ void GUI::eventLoop(std::stop_token stopToken)
             },
             [](void*) { return 0; },
             nullptr);
-        personalityMenu->setup();
-        addToParent(personalityMenu);
-        personalityMenu->setChildrenClickables_isClickable(false);
     });
+    addToParent(personalityMenu);
 
     ///////// Personality Menu - Personality Settings /////////
     auto personalityMenu_PersonalitySettings = createANewSubMenu(
         _("Personality Settings"),
         "Personality Settings",
         personalityMenu);
-    this->renderer->addSetupTask([&, personalityMenu_PersonalitySettings, addBackButton, addToParent]() {
+    personalityMenu_PersonalitySettings->describe([&, personalityMenu_PersonalitySettings, addBackButton]() {
         addBackButton(personalityMenu_PersonalitySettings);
         const auto addEmotionSlider = [this, personalityMenu_PersonalitySettings](const char* label, const char* uniqueID, GlobalSettings::SettingType settingType) {
             this->addPopupSliderMenuEntry(
@@ -977,14 +991,12 @@ void GUI::eventLoop(std::stop_token stopToken)
         addEmotionSlider("Caution", "Caution", GlobalSettings::SettingType::EMOTION_CAUTION);
         addEmotionSlider("Annoyance", "Annoyance", GlobalSettings::SettingType::EMOTION_ANNOYANCE);
 
-        personalityMenu_PersonalitySettings->setup();
-        addToParent(personalityMenu_PersonalitySettings);
-        personalityMenu_PersonalitySettings->setChildrenClickables_isClickable(false);
     });
+    addToParent(personalityMenu_PersonalitySettings);
 
     ///////// Sensors Menu /////////
     auto sensorsMenu = createANewSubMenu(_("Sensors"), "Sensors", mainMenu);
-    this->renderer->addSetupTask([this, &sensorsMenu, addBackButton, addToParent]() {
+    sensorsMenu->describe([this, sensorsMenu, addBackButton]() {
         addBackButton(sensorsMenu);
         ///////// Sensors Menu - Microphone enable/disable /////////
         sensorsMenu->addMenuEntry(
@@ -1033,16 +1045,14 @@ void GUI::eventLoop(std::stop_token stopToken)
             [](int value) {
                 setPresenceAbsentTimeoutSetting(value);
             });
-        sensorsMenu->setup();
-        addToParent(sensorsMenu);
-        sensorsMenu->setChildrenClickables_isClickable(false);
     });
+    addToParent(sensorsMenu);
 
     auto sensorsMenu_PresenceAveragingWindows = createANewSubMenu(
         _("Presence Averaging Windows"),
         "Presence Averaging Windows",
         sensorsMenu);
-    this->renderer->addSetupTask([&, sensorsMenu_PresenceAveragingWindows, addBackButton, addToParent]() {
+    sensorsMenu_PresenceAveragingWindows->describe([&, sensorsMenu_PresenceAveragingWindows, addBackButton]() {
         addBackButton(sensorsMenu_PresenceAveragingWindows);
         this->addPopupSliderMenuEntry(
             sensorsMenu_PresenceAveragingWindows,
@@ -1112,14 +1122,12 @@ void GUI::eventLoop(std::stop_token stopToken)
                     value,
                     "Stationary Energy Window");
             });
-        sensorsMenu_PresenceAveragingWindows->setup();
-        addToParent(sensorsMenu_PresenceAveragingWindows);
-        sensorsMenu_PresenceAveragingWindows->setChildrenClickables_isClickable(false);
     });
+    addToParent(sensorsMenu_PresenceAveragingWindows);
 
     ///////// Sound Menu /////////
     auto soundMenu = createANewSubMenu(_("Sound"), "Sound", mainMenu);
-    this->renderer->addSetupTask([&, soundMenu, addBackButton, addToParent]() {
+    soundMenu->describe([&, soundMenu, addBackButton]() {
         addBackButton(soundMenu);
         ///////// Sound Menu - Volume /////////
         this->addPopupSliderMenuEntry(
@@ -1135,14 +1143,12 @@ void GUI::eventLoop(std::stop_token stopToken)
             [](int value) {
                 setGlobalVolumeSetting(GlobalSettings::SettingType::SYSTEM_VOLUME, value, "Volume");
             });
-        soundMenu->setup();
-        addToParent(soundMenu);
-        soundMenu->setChildrenClickables_isClickable(false);
     });
+    addToParent(soundMenu);
 
     ///////// Sound Menu - Notification Sound /////////
     auto soundMenu_NotificationSound = createANewSubMenu(_("Notification Sound"), "Notification Sound", soundMenu);
-    this->renderer->addSetupTask([&, soundMenu_NotificationSound, addBackButton, addToParent]() {
+    soundMenu_NotificationSound->describe([&, soundMenu_NotificationSound, addBackButton]() {
         addBackButton(soundMenu_NotificationSound);
         ///////// Sound Menu - Notification Sound - Volume /////////
         this->addPopupSliderMenuEntry(
@@ -1158,23 +1164,19 @@ void GUI::eventLoop(std::stop_token stopToken)
             [](int value) {
                 setGlobalVolumeSetting(GlobalSettings::SettingType::NOTIFICATION_SOUND_VOLUME, value, "Notification Sound - Volume");
             });
-        soundMenu_NotificationSound->setup();
-        addToParent(soundMenu_NotificationSound);
-        soundMenu_NotificationSound->setChildrenClickables_isClickable(false);
     });
+    addToParent(soundMenu_NotificationSound);
     ///////// Sound Menu - Notification Sound - Select Sound /////////
     auto soundMenu_NotificationSound_SelectSound = createANewSubMenu(_("Select Sound"), "Select Notification Sound", soundMenu_NotificationSound);
-    this->renderer->addSetupTask([&soundMenu_NotificationSound_SelectSound, addBackButton, addToParent]() {
+    soundMenu_NotificationSound_SelectSound->describe([soundMenu_NotificationSound_SelectSound, addBackButton]() {
         addBackButton(soundMenu_NotificationSound_SelectSound);
         // TODO: list all the notification sounds
-        soundMenu_NotificationSound_SelectSound->setup();
-        addToParent(soundMenu_NotificationSound_SelectSound);
-        soundMenu_NotificationSound_SelectSound->setChildrenClickables_isClickable(false);
     });
+    addToParent(soundMenu_NotificationSound_SelectSound);
 
     ///////// Sound Menu - Alarm Sound /////////
     auto soundMenu_AlarmSound = createANewSubMenu(_("Alarm Sound"), "Alarm Sound", soundMenu);
-    this->renderer->addSetupTask([&, soundMenu_AlarmSound, addBackButton, addToParent]() {
+    soundMenu_AlarmSound->describe([&, soundMenu_AlarmSound, addBackButton]() {
         addBackButton(soundMenu_AlarmSound);
         ///////// Sound Menu - Alarm Sound - Volume /////////
         this->addPopupSliderMenuEntry(
@@ -1190,24 +1192,20 @@ void GUI::eventLoop(std::stop_token stopToken)
             [](int value) {
                 setGlobalVolumeSetting(GlobalSettings::SettingType::ALARM_SOUND_VOLUME, value, "Alarm Sound - Volume");
             });
-        soundMenu_AlarmSound->setup();
-        addToParent(soundMenu_AlarmSound);
-        soundMenu_AlarmSound->setChildrenClickables_isClickable(false);
     });
+    addToParent(soundMenu_AlarmSound);
     ///////// Sound Menu - Alarm Sound - Select Sound /////////
     auto soundMenu_AlarmSound_SelectSound = createANewSubMenu(_("Select Sound"), "Select Alarm Sound", soundMenu_AlarmSound);
-    this->renderer->addSetupTask([&soundMenu_AlarmSound_SelectSound, addBackButton, addToParent]() {
+    soundMenu_AlarmSound_SelectSound->describe([soundMenu_AlarmSound_SelectSound, addBackButton]() {
         addBackButton(soundMenu_AlarmSound_SelectSound);
         // TODO: list all the alarm sounds
         // TODO: add a menu entry here for the alarm snooze time setting.
-        soundMenu_AlarmSound_SelectSound->setup();
-        addToParent(soundMenu_AlarmSound_SelectSound);
-        soundMenu_AlarmSound_SelectSound->setChildrenClickables_isClickable(false);
     });
+    addToParent(soundMenu_AlarmSound_SelectSound);
 
     ///////// Sound Menu - Voice Command Sound /////////
     auto soundMenu_VoiceCommandSound = createANewSubMenu(_("Voice Command Sound"), "Voice Command Sound", soundMenu);
-    this->renderer->addSetupTask([&, soundMenu_VoiceCommandSound, addBackButton, addToParent]() {
+    soundMenu_VoiceCommandSound->describe([&, soundMenu_VoiceCommandSound, addBackButton]() {
         addBackButton(soundMenu_VoiceCommandSound);
         ///////// Sound Menu - Voice Command Sound - Volume /////////
         this->addPopupSliderMenuEntry(
@@ -1223,23 +1221,19 @@ void GUI::eventLoop(std::stop_token stopToken)
             [](int value) {
                 setGlobalVolumeSetting(GlobalSettings::SettingType::VOICE_COMMAND_SOUND_VOLUME, value, "Voice Command Sound - Volume");
             });
-        soundMenu_VoiceCommandSound->setup();
-        addToParent(soundMenu_VoiceCommandSound);
-        soundMenu_VoiceCommandSound->setChildrenClickables_isClickable(false);
     });
+    addToParent(soundMenu_VoiceCommandSound);
     ///////// Sound Menu - Voice Command Sound - Select Sound /////////
     auto soundMenu_VoiceCommandSound_SelectSound = createANewSubMenu(_("Select Sound"), "Select Voice Command Sound", soundMenu_VoiceCommandSound);
-    this->renderer->addSetupTask([&soundMenu_VoiceCommandSound_SelectSound, addBackButton, addToParent]() {
+    soundMenu_VoiceCommandSound_SelectSound->describe([soundMenu_VoiceCommandSound_SelectSound, addBackButton]() {
         addBackButton(soundMenu_VoiceCommandSound_SelectSound);
         // TODO: list all the voice command sounds
-        soundMenu_VoiceCommandSound_SelectSound->setup();
-        addToParent(soundMenu_VoiceCommandSound_SelectSound);
-        soundMenu_VoiceCommandSound_SelectSound->setChildrenClickables_isClickable(false);
     });
+    addToParent(soundMenu_VoiceCommandSound_SelectSound);
 
     ///////// Notifications Menu /////////
     auto notificationsMenu = createANewSubMenu(_("Notifications"), "Notifications", mainMenu);
-    this->renderer->addSetupTask([&notificationsMenu, addBackButton, addToParent]() {
+    notificationsMenu->describe([notificationsMenu, addBackButton]() {
         addBackButton(notificationsMenu);
         ///////// Notifications Menu - Allow Notifications from Network Sources (Other cubes) /////////
         notificationsMenu->addMenuEntry(
@@ -1254,14 +1248,12 @@ void GUI::eventLoop(std::stop_token stopToken)
             },
             [](void*) { return 0; },
             nullptr);
-        notificationsMenu->setup();
-        addToParent(notificationsMenu);
-        notificationsMenu->setChildrenClickables_isClickable(false);
     });
+    addToParent(notificationsMenu);
 
     ///////// Notifications Menu - Recent Notifications /////////
     auto notificationsMenu_RecentNotifications = createANewSubMenu(_("Recent Notifications"), "Recent Notifications", notificationsMenu);
-    this->renderer->addSetupTask([&notificationsMenu_RecentNotifications, addBackButton, addToParent]() {
+    notificationsMenu_RecentNotifications->describe([notificationsMenu_RecentNotifications, addBackButton]() {
         addBackButton(notificationsMenu_RecentNotifications);
         notificationsMenu_RecentNotifications->addMenuEntry(
             _("Open Notification Center"),
@@ -1275,23 +1267,19 @@ void GUI::eventLoop(std::stop_token stopToken)
             },
             [](void*) { return 0; },
             nullptr);
-        notificationsMenu_RecentNotifications->setup();
-        addToParent(notificationsMenu_RecentNotifications);
-        notificationsMenu_RecentNotifications->setChildrenClickables_isClickable(false);
     });
+    addToParent(notificationsMenu_RecentNotifications);
 
     ///////// Display Menu /////////
     auto displayMenu = createANewSubMenu(_("Display"), "Display", mainMenu);
-    this->renderer->addSetupTask([&displayMenu, addBackButton, addToParent]() {
+    displayMenu->describe([displayMenu, addBackButton]() {
         addBackButton(displayMenu);
-        displayMenu->setup();
-        addToParent(displayMenu);
-        displayMenu->setChildrenClickables_isClickable(false);
     });
+    addToParent(displayMenu);
 
     ///////// Display Menu - Animations /////////
     auto displayMenu_Animations = createANewSubMenu(_("Animations"), "Animations", displayMenu);
-    this->renderer->addSetupTask([&displayMenu_Animations, addBackButton, addToParent]() {
+    displayMenu_Animations->describe([displayMenu_Animations, addBackButton]() {
         addBackButton(displayMenu_Animations);
         ///////// Display Menu - Animations - Enable remote animations /////////
         displayMenu_Animations->addMenuEntry(
@@ -1309,23 +1297,19 @@ void GUI::eventLoop(std::stop_token stopToken)
                 return random0or1;
             },
             nullptr);
-        displayMenu_Animations->setup();
-        addToParent(displayMenu_Animations);
-        displayMenu_Animations->setChildrenClickables_isClickable(false);
     });
+    addToParent(displayMenu_Animations);
     ///////// Display Menu - Animations - Select Idle Animation /////////
     auto displayMenu_Animations_SelectIdleAnimation = createANewSubMenu(_("Select Idle Animation"), "Select Idle Animation", displayMenu_Animations);
-    this->renderer->addSetupTask([&displayMenu_Animations_SelectIdleAnimation, addBackButton, addToParent]() {
+    displayMenu_Animations_SelectIdleAnimation->describe([displayMenu_Animations_SelectIdleAnimation, addBackButton]() {
         addBackButton(displayMenu_Animations_SelectIdleAnimation);
         // TODO: list all the idle animations
-        displayMenu_Animations_SelectIdleAnimation->setup();
-        addToParent(displayMenu_Animations_SelectIdleAnimation);
-        displayMenu_Animations_SelectIdleAnimation->setChildrenClickables_isClickable(false);
     });
+    addToParent(displayMenu_Animations_SelectIdleAnimation);
     ///////// Display Menu - Brightness /////////
     auto displayMenu_Brightness = createANewSubMenu(_("Brightness"), "Brightness", displayMenu);
     auto brightnessValue = std::make_shared<int>(50);
-    this->renderer->addSetupTask([&, displayMenu_Brightness, brightnessValue, addBackButton, addToParent]() {
+    displayMenu_Brightness->describe([&, displayMenu_Brightness, brightnessValue, addBackButton]() {
         addBackButton(displayMenu_Brightness);
         ///////// Display Menu - Brightness - Set Brightness /////////
         this->addPopupSliderMenuEntry(
@@ -1342,14 +1326,12 @@ void GUI::eventLoop(std::stop_token stopToken)
                 *brightnessValue = value;
                 CubeLog::info("Brightness set to " + std::to_string(value));
             });
-        displayMenu_Brightness->setup();
-        addToParent(displayMenu_Brightness);
-        displayMenu_Brightness->setChildrenClickables_isClickable(false);
     });
+    addToParent(displayMenu_Brightness);
     ///////// Display Menu - Auto Off En/Disable /////////
     auto displayMenu_AutoOff = createANewSubMenu(_("Auto Off"), "Auto Off", displayMenu);
     auto autoOffTimeValue = std::make_shared<int>(50);
-    this->renderer->addSetupTask([&, displayMenu_AutoOff, autoOffTimeValue, addBackButton, addToParent]() {
+    displayMenu_AutoOff->describe([&, displayMenu_AutoOff, autoOffTimeValue, addBackButton]() {
         addBackButton(displayMenu_AutoOff);
         ///////// Display Menu - Auto Off - Enable/Disable Auto Off /////////
         displayMenu_AutoOff->addMenuEntry(
@@ -1379,31 +1361,25 @@ void GUI::eventLoop(std::stop_token stopToken)
                 *autoOffTimeValue = value;
                 CubeLog::info("Auto Off - Set Time set to " + std::to_string(value));
             });
-        displayMenu_AutoOff->setup();
-        addToParent(displayMenu_AutoOff);
-        displayMenu_AutoOff->setChildrenClickables_isClickable(false);
     });
+    addToParent(displayMenu_AutoOff);
     ///////// Display Menu - Font /////////
     auto displayMenu_Font = createANewSubMenu(_("Font"), "Font", displayMenu);
-    this->renderer->addSetupTask([&displayMenu_Font, addBackButton, addToParent]() {
+    displayMenu_Font->describe([displayMenu_Font, addBackButton]() {
         addBackButton(displayMenu_Font);
         // TODO: list all the available fonts
         // read all the fonts from the fonts directory and store the paths in a vector
         // then create a menu entry for each font and when clicked, set the font in the settings.
         // the settings should have a callback registered (TODO:) with the GlobalSettings class that will set the font when the setting is changed.
-        displayMenu_Font->setup();
-        addToParent(displayMenu_Font);
-        displayMenu_Font->setChildrenClickables_isClickable(false);
     });
+    addToParent(displayMenu_Font);
 
     ///////// Privacy Menu /////////
     auto privacyMenu = createANewSubMenu(_("Privacy"), "Privacy", mainMenu);
-    this->renderer->addSetupTask([&privacyMenu, addBackButton, addToParent]() {
+    privacyMenu->describe([privacyMenu, addBackButton]() {
         addBackButton(privacyMenu);
-        privacyMenu->setup();
-        addToParent(privacyMenu);
-        privacyMenu->setChildrenClickables_isClickable(false);
     });
+    addToParent(privacyMenu);
 
     ///////// Privacy Menu - Privacy Settings /////////
     // TODO: figure out what to put here: list apps that use microphone, presence detection, etc. and allow the user to disable them
@@ -1411,12 +1387,10 @@ void GUI::eventLoop(std::stop_token stopToken)
 
     ///////// Accounts Menu /////////
     auto accountsMenu = createANewSubMenu(_("Accounts"), "Accounts", mainMenu);
-    this->renderer->addSetupTask([&accountsMenu, addBackButton, addToParent]() {
+    accountsMenu->describe([accountsMenu, addBackButton]() {
         addBackButton(accountsMenu);
-        accountsMenu->setup();
-        addToParent(accountsMenu);
-        accountsMenu->setChildrenClickables_isClickable(false);
     });
+    addToParent(accountsMenu);
 
     ///////// Accounts Menu - Account List /////////
     // TODO: list all the accounts that have been added to the system. These are stored in the database.
@@ -1432,12 +1406,10 @@ void GUI::eventLoop(std::stop_token stopToken)
 
     ///////// Apps Menu /////////
     auto appsMenu = createANewSubMenu(_("Apps"), "Apps", mainMenu);
-    this->renderer->addSetupTask([&appsMenu, addBackButton, addToParent]() {
+    appsMenu->describe([appsMenu, addBackButton]() {
         addBackButton(appsMenu);
-        appsMenu->setup();
-        addToParent(appsMenu);
-        appsMenu->setChildrenClickables_isClickable(false);
     });
+    addToParent(appsMenu);
 
     ///////// Apps Menu - Core Apps /////////
     // list all the core apps here and allow the user to enable/disable them
@@ -1461,16 +1433,14 @@ void GUI::eventLoop(std::stop_token stopToken)
 
     ///////// General Settings Menu /////////
     auto generalSettingsMenu = createANewSubMenu(_("General Settings"), "General Settings", mainMenu);
-    this->renderer->addSetupTask([&generalSettingsMenu, addBackButton, addToParent]() {
+    generalSettingsMenu->describe([generalSettingsMenu, addBackButton]() {
         addBackButton(generalSettingsMenu);
-        generalSettingsMenu->setup();
-        addToParent(generalSettingsMenu);
-        generalSettingsMenu->setChildrenClickables_isClickable(false);
     });
+    addToParent(generalSettingsMenu);
 
     ///////// General Settings Menu - Date and Time /////////
     auto generalSettingsDateTimeMenu = createANewSubMenu(_("Date and Time"), "Date and Time", generalSettingsMenu);
-    this->renderer->addSetupTask([&generalSettingsDateTimeMenu, addBackButton, addToParent]() {
+    generalSettingsDateTimeMenu->describe([generalSettingsDateTimeMenu, addBackButton]() {
         addBackButton(generalSettingsDateTimeMenu);
         ///////// General Settings Menu - Date and Time - Set Date and Time /////////
         // generalSettingsDateTimeMenu->addMenuEntry(
@@ -1496,10 +1466,8 @@ void GUI::eventLoop(std::stop_token stopToken)
         ///////// General Settings Menu - Date and Time - Set Time Format ///////// TODO:
         ///////// General Settings Menu - Date and Time - Set Date Format ///////// TODO:
         ///////// General Settings Menu - Date and Time - Enable Automatic Date and Time ///////// TODO:
-        generalSettingsDateTimeMenu->setup();
-        addToParent(generalSettingsDateTimeMenu);
-        generalSettingsDateTimeMenu->setChildrenClickables_isClickable(false);
     });
+    addToParent(generalSettingsDateTimeMenu);
 
     ///////// General Settings Menu - Language /////////
     // TODO:
@@ -1508,19 +1476,17 @@ void GUI::eventLoop(std::stop_token stopToken)
 
     ///////// Accessibility Menu /////////
     auto accessibilityMenu = createANewSubMenu(_("Accessibility"), "Accessibility", mainMenu);
-    this->renderer->addSetupTask([&accessibilityMenu, addBackButton, addToParent]() {
+    accessibilityMenu->describe([accessibilityMenu, addBackButton]() {
         addBackButton(accessibilityMenu);
-        accessibilityMenu->setup();
-        addToParent(accessibilityMenu);
-        accessibilityMenu->setChildrenClickables_isClickable(false);
     });
+    addToParent(accessibilityMenu);
 
     ///////// Accessibility Menu - ??? /////////
     // TODO: figure out what should go here
 
     ///////// Updates Menu /////////
     auto updatesMenu = createANewSubMenu(_("Updates"), "Updates", mainMenu);
-    this->renderer->addSetupTask([&updatesMenu, addBackButton, addToParent]() {
+    updatesMenu->describe([updatesMenu, addBackButton]() {
         addBackButton(updatesMenu);
         ///////// Updates Menu - Check for Updates /////////
         // TODO:
@@ -1530,14 +1496,12 @@ void GUI::eventLoop(std::stop_token stopToken)
         // For example: "Last updated:\nJanuary 1, 1979 at 12:00pm\n \nUpdated:\nTheCube-CORE to version 1.0.0\nJSON library to version 1.0.0\netc."
         ///////// Updates Menu - Auto Update Enable /////////
         // TODO:
-        updatesMenu->setup();
-        addToParent(updatesMenu);
-        updatesMenu->setChildrenClickables_isClickable(false);
     });
+    addToParent(updatesMenu);
 
     ///////// About Menu /////////
     auto aboutMenu = createANewSubMenu(_("About"), "About", mainMenu);
-    this->renderer->addSetupTask([&aboutMenu, addBackButton, addToParent]() {
+    aboutMenu->describe([aboutMenu, addBackButton]() {
         addBackButton(aboutMenu);
         ///////// About Menu - Serial Number /////////
         aboutMenu->addMenuEntry(
@@ -1578,14 +1542,12 @@ void GUI::eventLoop(std::stop_token stopToken)
                 return 0;
             },
             nullptr);
-        aboutMenu->setup();
-        addToParent(aboutMenu);
-        aboutMenu->setChildrenClickables_isClickable(false);
     });
+    addToParent(aboutMenu);
 
     ///////// About Menu - Software Information /////////
     auto aboutSoftwareInformationMenu = createANewSubMenu(_("Software Information"), "Software Information", aboutMenu);
-    this->renderer->addSetupTask([&aboutSoftwareInformationMenu, addBackButton, addToParent]() {
+    aboutSoftwareInformationMenu->describe([aboutSoftwareInformationMenu, addBackButton]() {
         addBackButton(aboutSoftwareInformationMenu);
         ///////// About Menu - Software Information - TheCube-CORE /////////
         // TODO: Show the version, build number, and build date of TheCube-CORE
@@ -1593,10 +1555,8 @@ void GUI::eventLoop(std::stop_token stopToken)
         // TODO: Show the Raspbian version, kernel version, etc
         ///////// About Menu - Software Information - Libraries /////////
         // TODO: Show the versions of all the libraries used in the system
-        aboutSoftwareInformationMenu->setup();
-        addToParent(aboutSoftwareInformationMenu);
-        aboutSoftwareInformationMenu->setChildrenClickables_isClickable(false);
     });
+    addToParent(aboutSoftwareInformationMenu);
 
     ///////// About Menu - Status /////////
     // TODO:
@@ -1645,7 +1605,7 @@ void GUI::eventLoop(std::stop_token stopToken)
 
     ///////// Developer Settings Menu /////////
     auto developerSettingsMenu = createANewSubMenu(_("Developer Settings"), "Developer Settings", mainMenu);
-    this->renderer->addSetupTask([&developerSettingsMenu, addBackButton, addToParent]() {
+    developerSettingsMenu->describe([developerSettingsMenu, addBackButton]() {
         addBackButton(developerSettingsMenu);
         ///////// Developer Settings Menu - Developer Mode Enable /////////
         developerSettingsMenu->addMenuEntry(
@@ -1750,10 +1710,8 @@ void GUI::eventLoop(std::stop_token stopToken)
             ///////// Developer Settings Menu - Send Bug Report /////////
             // TODO:
         }
-        developerSettingsMenu->setup();
-        addToParent(developerSettingsMenu);
-        developerSettingsMenu->setChildrenClickables_isClickable(false);
     });
+    addToParent(developerSettingsMenu);
 
     if (GlobalSettings::getSettingOfType<bool>(GlobalSettings::SettingType::DEVELOPER_MODE_ENABLED)) {
         ///////// Developer Settings Menu - SSH /////////
@@ -1778,6 +1736,11 @@ void GUI::eventLoop(std::stop_token stopToken)
         // TODO:
     }
 
+    // Every link into the main menu has been described by now.
+    this->renderer->addSetupTask([mainMenu]() {
+        mainMenu->materialize();
+    });
+
 #endif // ENABLE_LAMBDAS
 
     ////////////////////////////////////////
@@ -1876,12 +1839,28 @@ void GUI::eventLoop(std::stop_token stopToken)
     if (!this->renderer->isReady() || !this->renderer->getIsRunning())
         CubeLog::error("Renderer is not ready or is not running");
 
-    // Add all the clickable areas to the event manager
+    // Add the clickable areas of the menus built so far to the event manager; the rest register when built.
     for (auto menu : menus) {
+        if (!menu->isReady()) {
+            continue;
+        }
         for (auto area : menu->getClickableAreas()) {
             this->eventManager->addClickableArea(area);
         }
     }
+    const std::chrono::duration<double> interactiveAfter = std::chrono::steady_clock::now() - this->renderer->getCreatedAt();
+    MenuMetrics::get().interactive->set(interactiveAfter.count());
+    CubeLog::info("GUI interactive after " + std::to_string(interactiveAfter.count()) + "s");
+
+    // Build the first level of submenus in idle time so the first tap into one is instant.
+    for (auto menu : menus) {
+        MENUS::Menu* parent = menu->getParentMenu();
+        if (parent != nullptr && parent->getParentMenu() == nullptr && this->describedMenus.contains(menu->getUniqueMenuIdentifier())) {
+            this->renderer->addIdleTask([this, menu]() {
+                this->warmMenu(menu);
+            });
+        }
+    }
 
     CubeLog::info("Starting event handler loop...");
     while (!stopToken.stop_requested()) {
@@ -1991,20 +1970,26 @@ GUI_Error GUI::addMenu(const std::string& menuName, const std::string& thisUniqu
         aNewMenu->setup();
         aNewMenu->setVisible(false);
         aNewMenu->setParentMenu(parentMenuPtr);
-        aNewMenu->getParentMenu()->addMenuEntry(
-            menuName,
-            thisUniqueID,
-            MENUS::EntryType::MENUENTRY_TYPE_ACTION,
-            [aNewMenu](void*) {
-                CubeLog::info("Test Sub Menu clicked");
-                aNewMenu->setVisible(true);
-                aNewMenu->getParentMenu()->setVisible(false);
-                aNewMenu->getParentMenu()->setIsClickable(false);
-                return 0;
-            },
-            [](void*) { return 0; },
-            nullptr);
-        eventManagerPtr->addClickableArea(aNewMenu->getParentMenu()->getClickableAreas().at(aNewMenu->getParentMenu()->getClickableAreas().size() - 1));
+        // Described rather than added so the link survives the parent being evicted and rebuilt.
+        parentMenuPtr->describe([aNewMenu, menuName, thisUniqueID]() {
+            aNewMenu->getParentMenu()->addMenuEntry(
+                menuName,
+                thisUniqueID,
+                MENUS::EntryType::MENUENTRY_TYPE_ACTION,
+                [aNewMenu](void*) {
+                    CubeLog::info("Test Sub Menu clicked");
+                    aNewMenu->setVisible(true);
+                    aNewMenu->getParentMenu()->setVisible(false);
+                    aNewMenu->getParentMenu()->setIsClickable(false);
+                    return 0;
+                },
+                [](void*) { return 0; },
+                nullptr);
+        });
+        // An unbuilt parent registers the link when it's built.
+        if (parentMenuPtr->isReady()) {
+            eventManagerPtr->addClickableArea(parentMenuPtr->getClickableAreas().back());
+        }
         for (auto area : aNewMenu->getClickableAreas()) {
             eventManagerPtr->addClickableArea(area);
         }
@@ -2175,6 +2160,113 @@ void GUI::hideSliderBox()
     setVisibleMenuClickablesEnabled(true);
 }
 
+/**
+ * @brief Show a submenu in place of its parent, building it first if it isn't built. The switch happens on the
+ * renderer thread, which owns the menu's GL objects.
+ *
+ * @param menu the menu to show
+ */
+void GUI::openMenu(MENUS::Menu* menu)
+{
+    MENUS::Menu* parent = menu->getParentMenu();
+    // Stops a second tap landing on the parent before the switch below runs.
+    if (parent != nullptr) {
+        parent->setChildrenClickables_isClickable(false);
+    }
+    this->renderer->addSetupTask([this, menu, parent]() {
+        this->materializeMenu(menu);
+        menu->setVisible(true);
+        menu->setIsClickable(false);
+        menu->setChildrenClickables_isClickable(true);
+        if (parent != nullptr) {
+            parent->setVisible(false);
+            parent->setIsClickable(false);
+            parent->setChildrenClickables_isClickable(false);
+        }
+    });
+}
+
+/**
+ * @brief Build a described menu if needed and register its clickable areas. Renderer thread only.
+ *
+ * @param menu the menu to build
+ * @return true if the menu was built by this call
+ */
+bool GUI::materializeMenu(MENUS::Menu* menu)
+{
+    this->menuResidency.touch(menu->getUniqueMenuIdentifier());
+    if (!menu->materialize()) {
+        return false;
+    }
+    for (auto area : menu->getClickableAreas()) {
+        this->eventManager->addClickableArea(area);
+    }
+    MenuMetrics::get().built->increment();
+    this->evictIdleMenus(menu);
+    this->updateMenuMetrics();
+    return true;
+}
+
+/**
+ * @brief Build a menu ahead of it being opened, as long as that doesn't push another one out. Renderer thread only.
+ */
+void GUI::warmMenu(MENUS::Menu* menu)
+{
+    if (menu->isReady() || this->menuResidency.resident() >= this->menuResidency.limit() || menuMemoryPressure()) {
+        return;
+    }
+    CubeLog::debug("Warming menu: " + menu->getMenuName());
+    this->materializeMenu(menu);
+}
+
+/**
+ * @brief Drop the least recently opened menus past the resident limit, or every idle one when memory is low.
+ * The menu being opened, its ancestors, and anything on screen are kept. Renderer thread only.
+ *
+ * @param opened the menu being opened
+ */
+void GUI::evictIdleMenus(MENUS::Menu* opened)
+{
+    auto pinned = [this, opened](const std::string& id) {
+        MENUS::Menu* menu = this->describedMenus.at(id);
+        if (menu->getVisible()) {
+            return true;
+        }
+        for (MENUS::Menu* m = opened; m != nullptr; m = m->getParentMenu()) {
+            if (m == menu) {
+                return true;
+            }
+        }
+        return false;
+    };
+    for (const auto& id : this->menuResidency.victims(pinned, menuMemoryPressure())) {
+        MENUS::Menu* menu = this->describedMenus.at(id);
+        // Once the areas are gone no event can be dispatched into the entries being deleted.
+        for (auto area : menu->getClickableAreas()) {
+            this->eventManager->removeClickableArea(area);
+        }
+        menu->evict();
+        this->menuResidency.forget(id);
+        MenuMetrics::get().evicted->increment();
+    }
+}
+
+void GUI::updateMenuMetrics()
+{
+    size_t vertexBytes = 0;
+    size_t resident = 0;
+    for (const auto& [id, menu] : this->describedMenus) {
+        if (menu->isReady()) {
+            vertexBytes += menu->residentVertexBytes();
+            resident++;
+        }
+    }
+    auto& metrics = MenuMetrics::get();
+    metrics.resident->set(static_cast<double>(resident));
+    metrics.vertexBytes->set(static_cast<double>(vertexBytes));
+    metrics.atlasBytes->set(static_cast<double>(GlyphAtlas::shared().stats().pagesAllocated * GLYPH_ATLAS_PAGE_SIZE * GLYPH_ATLAS_PAGE_SIZE));
+}
+
 void GUI::setVisibleMenuClickablesEnabled(bool enabled)
 {
     if (GUI::activeGuiInstance == nullptr) {
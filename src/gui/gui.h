@@ -41,6 +41,7 @@ SOFTWARE.
 #ifndef MENU_H
 #include "menu/menu.h"
 #endif
+#include "menu/menuResidency.h"
 #ifndef RENDERER_H
 #include "renderer.h"
 #endif
@@ -57,6 +58,7 @@ SOFTWARE.
 #include <string>
 #include <thread>
 #include <tuple>
+#include <unordered_map>
 #include <vector>
 #ifndef MESSAGEBOX_H
 #include "messageBox/messageBox.h"
@@ -165,6 +167,14 @@ private:
     static CubeNotificaionBox* notificationBox;
     static CubeSliderBox* sliderBox;
     std::vector<MENUS::Menu*> menus;
+    // Menus built from described content, by unique identifier. Filled before the event loop starts.
+    std::unordered_map<std::string, MENUS::Menu*> describedMenus;
+    MenuResidency menuResidency { 12 };
+    void openMenu(MENUS::Menu* menu);
+    bool materializeMenu(MENUS::Menu* menu);
+    void warmMenu(MENUS::Menu* menu);
+    void evictIdleMenus(MENUS::Menu* opened);
+    void updateMenuMetrics();
     std::vector<std::pair<std::function<bool()>, std::function<void(int)>>> drag_y_actions; // bool is visibility. if the item is not visible, do not call the action.
     std::mutex addMenuMutex;
     unsigned int addPopupSliderMenuEntry(
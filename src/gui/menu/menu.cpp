@@ -32,6 +32,8 @@ SOFTWARE.
 */
 
 #include "menu.h"
+#include "../renderDamage.h"
+#include <algorithm>
 
 namespace MENUS {
 float screenRelativeToScreenPx(float screenRelative);
@@ -88,19 +90,20 @@ Menu::Menu(Renderer* renderer, CountingLatch& latch)
 }
 
 /**
- * @brief Construct a new Menu:: Menu object
+ * @brief Construct a new Menu:: Menu object without a CountingLatch. Used for menus that are built on demand
+ * rather than during startup.
  *
  * @param renderer
- * @param latch
  * @param xMin
  * @param xMax
  * @param yMin
  * @param yMax
  */
-Menu::Menu(Renderer* renderer, CountingLatch& latch, unsigned int xMin, unsigned int xMax, unsigned int yMin, unsigned int yMax)
+Menu::Menu(Renderer* renderer, unsigned int xMin, unsigned int xMax, unsigned int yMin, unsigned int yMax)
 {
     CubeLog::info("Creating Menu object with click area size and position of " + std::to_string(xMin) + "x" + std::to_string(yMin) + " to " + std::to_string(xMax) + "x" + std::to_string(yMax));
-    this->latch = &latch;
+    this->latch = nullptr;
+    this->hasLatch = false;
     this->renderer = renderer;
     this->visible = false;
     this->clickArea = ClickableArea();
@@ -117,6 +120,23 @@ Menu::Menu(Renderer* renderer, CountingLatch& latch, unsigned int xMin, unsigned
     CubeLog::info("Menu created");
 }
 
+/**
+ * @brief Construct a new Menu:: Menu object
+ *
+ * @param renderer
+ * @param latch
+ * @param xMin
+ * @param xMax
+ * @param yMin
+ * @param yMax
+ */
+Menu::Menu(Renderer* renderer, CountingLatch& latch, unsigned int xMin, unsigned int xMax, unsigned int yMin, unsigned int yMax)
+    : Menu(renderer, xMin, xMax, yMin, yMax)
+{
+    this->latch = &latch;
+    this->hasLatch = true;
+}
+
 /**
  * @brief Destroy the Menu:: Menu object
  *
@@ -335,6 +355,91 @@ void Menu::setup()
     CubeLog::info("Menu setup done");
 }
 
+/**
+ * @brief Add a piece of this menu's content. Fragments run in the order they were described, on the renderer
+ * thread, each time the menu is materialized. If the menu is already materialized the fragment also runs now,
+ * so this must then be called from the renderer thread.
+ *
+ * @param fragment adds entries to this menu
+ */
+void Menu::describe(std::function<void()> fragment)
+{
+    this->content.push_back(fragment);
+    if (this->isReady()) {
+        this->content.back()();
+    }
+}
+
+/**
+ * @brief Build the menu from its described content: entries, their text meshes, and the menu box. Must be
+ * called from the renderer thread. The menu is left hidden.
+ *
+ * @return true if the menu was built, false if it already was
+ */
+bool Menu::materialize()
+{
+    if (this->isReady()) {
+        return false;
+    }
+    for (auto& fragment : this->content) {
+        fragment();
+    }
+    this->setup();
+    this->setVisible(false);
+    this->setChildrenClickables_isClickable(false);
+    return true;
+}
+
+/**
+ * @brief Drop everything materialize() built, keeping the described content so the menu can be built again.
+ * Must be called from the renderer thread, with the menu hidden and its clickable areas already unregistered.
+ */
+void Menu::evict()
+{
+    if (!this->isReady()) {
+        return;
+    }
+    for (auto clickable : this->childrenClickables) {
+        auto entry = std::find(Menu::allMenuEntries_vec.begin(), Menu::allMenuEntries_vec.end(), clickable);
+        if (entry != Menu::allMenuEntries_vec.end()) {
+            Menu::allMenuEntries_vec.erase(entry);
+        }
+        delete clickable;
+    }
+    this->childrenClickables.clear();
+    for (auto object : this->objects) {
+        delete object;
+    }
+    this->objects.clear();
+    delete this->stencil;
+    this->stencil = nullptr;
+    this->drawList.clear();
+    this->maxScrollY = 0;
+    this->scrollVertPosition = 0;
+    std::lock_guard<std::mutex> lock(this->mutex);
+    this->ready = false;
+    CubeLog::info("Menu evicted: " + this->menuName);
+}
+
+/**
+ * @brief Bytes of vertex data held by this menu's entries. Text is counted by its glyph quads; the glyphs
+ * themselves live in the shared GlyphAtlas.
+ */
+size_t Menu::residentVertexBytes()
+{
+    size_t bytes = 0;
+    for (auto clickable : this->childrenClickables) {
+        for (auto object : clickable->getObjects()) {
+            if (auto text = dynamic_cast<M_Text*>(object)) {
+                bytes += text->vertexBytes();
+            } else {
+                bytes += object->getVertices().size() * sizeof(Vertex);
+            }
+        }
+    }
+    return bytes;
+}
+
 /**
  * @brief Handle the click event
  *
@@ -382,6 +487,10 @@ bool Menu::setVisible(bool visible)
     std::unique_lock<std::mutex> lock(this->menuMutex);
     bool temp = this->visible;
     this->visible = visible;
+    if (temp != visible) {
+        RenderDamage::invalidate();
+        ClickableArea::changed();
+    }
     for (auto clickable : this->childrenClickables) {
         clickable->setVisible(visible);
     }
@@ -396,6 +505,9 @@ bool Menu::setIsClickable(bool isClickable)
 {
     bool temp = this->isClickable;
     this->isClickable = isClickable;
+    if (temp != isClickable) {
+        ClickableArea::changed();
+    }
     return temp;
 }
 
@@ -473,15 +585,36 @@ bool Menu::isReady()
  */
 void Menu::draw()
 {
-    if (!this->visible)
+    if (!this->visible || this->stencil == nullptr)
         return;
-    for (auto object : this->objects) {
-        object->draw();
+    {
+        // The menu box chrome goes out as one batch.
+        PrimitiveBatch::Scope chrome;
+        for (auto object : this->objects) {
+            object->draw();
+        }
     }
+    // Entries are queued on one DrawList so their text and widget textures are drawn grouped by state.
+    // Clickables that can't be queued are drawn in place, after flushing what came before them.
+    auto flush = [this]() {
+        if (this->drawList.empty()) {
+            return;
+        }
+        // Marquee offsets were just advanced by collect().
+        SceneGraph::shared().update();
+        this->drawList.draw();
+        this->drawList.clear();
+    };
     this->stencil->enable();
+    this->drawList.clear();
     for (auto clickable : this->childrenClickables) {
+        if (clickable->collect(this->drawList)) {
+            continue;
+        }
+        flush();
         clickable->draw();
     }
+    flush();
     this->stencil->disable();
 }
 
@@ -641,6 +774,9 @@ bool MenuBox::setVisible(bool visible)
 {
     bool temp = this->visible;
     this->visible = visible;
+    if (temp != visible) {
+        RenderDamage::invalidate();
+    }
     return temp;
 }
 
@@ -682,6 +818,8 @@ MenuEntry::MenuEntry(Shader* t_shader, Shader* m_shader, const std::string& text
         size,
         { 1.f, 1.f, 1.f },
         position);
+    this->scrollNode = SceneGraph::shared().create();
+    this->textObject->setParentNode(this->scrollNode);
     this->scrollObjects.push_back(this->textObject);
     this->allObjects.push_back(this->textObject);
     this->scrollObjects.at(0)->capturePosition();
@@ -756,6 +894,7 @@ MenuEntry::~MenuEntry()
     for (auto object : this->allObjects) {
         delete object;
     }
+    SceneGraph::shared().destroy(this->scrollNode);
     // delete this->textStencil;
     CubeLog::info("MenuEntry destroyed");
 }
@@ -804,6 +943,10 @@ bool MenuEntry::setVisible(bool visible)
 {
     bool temp = this->visible;
     this->visible = visible;
+    if (temp != visible) {
+        RenderDamage::invalidate();
+        ClickableArea::changed();
+    }
     if(!visible){
         for(auto obj : this->fixedObjects){
             obj->setVisibility(false);
@@ -821,6 +964,9 @@ bool MenuEntry::setIsClickable(bool isClickable)
 {
     bool temp = this->isClickable;
     this->isClickable = isClickable;
+    if (temp != isClickable) {
+        ClickableArea::changed();
+    }
     return temp;
 }
 
@@ -890,12 +1036,12 @@ std::vector<MeshObject*> MenuEntry::getObjects()
     return this->allObjects;
 }
 
-void MenuEntry::draw()
+/**
+ * @brief Advance the per-frame state of the entry: widget selection, width changes and the marquee.
+ * Called once per frame by draw() or collect().
+ */
+void MenuEntry::advance()
 {
-    if (!this->visible) {
-        return;
-    }
-
     switch (this->type) {
     case EntryType::MENUENTRY_TYPE_ACTION:
     case EntryType::MENUENTRY_TYPE_SUBMENU: {
@@ -919,33 +1065,40 @@ void MenuEntry::draw()
         this->clickArea.xMax = this->clickArea.xMin + this->size.x;
         this->setVisibleWidth(this->visibleWidth);
     }
+    // The marquee is advanced by draw() itself, so keep frames coming while it runs (including the pause
+    // at either end, which is counted in frames).
+    if (this->scrolling != ScrollingDirection::NOT_SCROLLING) {
+        RenderDamage::invalidate();
+    }
     if (this->scrolling == ScrollingDirection::SCROLL_LEFT && this->scrollWait++ > 60) {
         this->scrollPositionLeft += MENU_ITEM_SCROLL_LEFT_SPEED;
-        for (auto object : this->scrollObjects) {
-            object->translate({ -MENU_ITEM_SCROLL_LEFT_SPEED, 0.f, 0.f });
-        }
+        SceneGraph::shared().translate(this->scrollNode, { -MENU_ITEM_SCROLL_LEFT_SPEED, 0.f, 0.f });
         if (this->scrollPositionLeft >= this->size.x - this->visibleWidth) {
-            for (auto object : this->scrollObjects) {
-                this->scrolling = ScrollingDirection::SCROLL_RIGHT;
-            }
+            this->scrolling = ScrollingDirection::SCROLL_RIGHT;
             this->scrollWait = 0;
         }
     }
     if (this->scrolling == ScrollingDirection::SCROLL_RIGHT && this->scrollWait++ > 60) {
         this->scrollPositionRight += MENU_ITEM_SCROLL_RIGHT_SPEED;
         const float amount = this->scrollPositionRight < this->scrollPositionLeft ? MENU_ITEM_SCROLL_RIGHT_SPEED : MENU_ITEM_SCROLL_RIGHT_SPEED - this->scrollPositionRight + this->scrollPositionLeft;
-        for (auto object : this->scrollObjects) {
-            object->translate({ amount, 0.f, 0.f });
-        }
+        SceneGraph::shared().translate(this->scrollNode, { amount, 0.f, 0.f });
         if (this->scrollPositionRight > this->scrollPositionLeft) {
-            for (auto object : this->scrollObjects) {
-                this->scrolling = ScrollingDirection::SCROLL_LEFT;
-            }
+            this->scrolling = ScrollingDirection::SCROLL_LEFT;
             this->scrollPositionRight = 0;
             this->scrollPositionLeft = 0;
             this->scrollWait = 0;
         }
     }
+}
+
+void MenuEntry::draw()
+{
+    if (!this->visible) {
+        return;
+    }
+    this->advance();
+    // The marquee may have just moved the scroll node.
+    SceneGraph::shared().update();
     for (auto object : this->xFixedObjects) {
         object->draw();
     }
@@ -960,6 +1113,29 @@ void MenuEntry::draw()
     }
 }
 
+/**
+ * @brief Queue the entry's objects on a menu-wide DrawList instead of drawing them.
+ *
+ * @return true; an invisible entry simply adds nothing
+ */
+bool MenuEntry::collect(DrawList& list)
+{
+    if (!this->visible) {
+        return true;
+    }
+    this->advance();
+    // One layer per group keeps draw()'s overlap order (long text scrolls over the widget), while the
+    // same group of every entry in the menu is still drawn together.
+    uint16_t layer = 0;
+    for (auto objects : { &this->xFixedObjects, &this->scrollObjects, &this->yFixedObjects, &this->fixedObjects }) {
+        for (auto object : *objects) {
+            list.add(object, layer);
+        }
+        layer++;
+    }
+    return true;
+}
+
 void MenuEntry::translate(glm::vec2 translation)
 {
     this->position += translation;
@@ -990,6 +1166,7 @@ void MenuEntry::resetScroll()
     this->scrollPositionLeft = 0;
     this->scrollPositionRight = 0;
     this->scrollWait = 0;
+    SceneGraph::shared().setLocal(this->scrollNode, glm::mat4(1.0f));
 }
 
 ClickableArea* MenuEntry::getClickableArea()
@@ -1010,6 +1187,7 @@ void MenuEntry::setClickAreaSize(unsigned int xMin, unsigned int xMax, unsigned
     this->clickArea.xMax = xMax;
     this->clickArea.yMin = yMin;
     this->clickArea.yMax = yMax;
+    ClickableArea::changed();
 }
 
 void MenuEntry::capturePosition()
@@ -1115,7 +1293,7 @@ void MenuStencil::enable()
         glDisable(GL_DEPTH_TEST);
         glDepthMask(GL_FALSE);
         this->shader->use();
-        this->shader->setMat4("projection", projectionMatrix);
+        this->shader->setMat4(ShaderUniform::PROJECTION, projectionMatrix);
         glBindVertexArray(VAO);
         glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
         glBindVertexArray(0);
@@ -1145,9 +1323,9 @@ void MenuStencil::enable()
     glStencilMask(0xFF);
     // Draw the mask
     this->shader->use();
-    this->shader->setMat4("projection", projectionMatrix);
-    this->shader->setMat4("model", modelMatrix);
-    this->shader->setMat4("view", viewMatrix);
+    this->shader->setMat4(ShaderUniform::PROJECTION, projectionMatrix);
+    this->shader->setMat4(ShaderUniform::MODEL, modelMatrix);
+    this->shader->setMat4(ShaderUniform::VIEW, viewMatrix);
     glBindVertexArray(VAO);
     glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
     glBindVertexArray(0);
@@ -1236,10 +1414,24 @@ void MenuHorizontalRule::draw()
     }
 }
 
+bool MenuHorizontalRule::collect(DrawList& list)
+{
+    if (!this->visible) {
+        return true;
+    }
+    for (auto object : this->objects) {
+        list.add(object);
+    }
+    return true;
+}
+
 bool MenuHorizontalRule::setVisible(bool visible)
 {
     bool temp = this->visible;
     this->visible = visible;
+    if (temp != visible) {
+        RenderDamage::invalidate();
+    }
     return temp;
 }
 
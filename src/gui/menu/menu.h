@@ -159,6 +159,9 @@ private:
     int groupID;
     M_Text* textObject;
     bool isClickable = false;
+    // Parent of the scrolling text; the marquee moves this one node instead of every scroll object.
+    SceneNode scrollNode;
+    void advance();
 
 public:
     MenuEntry(Shader* t_shader, Shader* m_shader, const std::string& text, glm::vec2 position, float size, float visibleWidth, EntryType type, std::function<unsigned int(void*)> statusAction, void* statusActionArg);
@@ -176,6 +179,7 @@ public:
     void setOnRightClick(std::function<unsigned int(void*)> action);
     void setStatusAction(std::function<unsigned int(void*)> action);
     void draw();
+    bool collect(DrawList& list);
     void resetScroll();
     ClickableArea* getClickableArea();
     void setClickAreaSize(unsigned int xMin, unsigned int xMax, unsigned int yMin, unsigned int yMax);
@@ -210,7 +214,8 @@ private:
     std::mutex mutex;
     std::vector<Clickable*> childrenClickables;
     ClickableArea clickArea;
-    MenuStencil* stencil;
+    MenuStencil* stencil = nullptr;
+    DrawList drawList;
     float menuItemTextSize = MENU_ITEM_TEXT_SIZE;
     long scrollVertPosition = 0;
     bool onClickEnabled = true;
@@ -226,13 +231,20 @@ private:
     bool isClickable = false;
     static bool mainMenuSet;
     static std::vector<MenuEntry*> allMenuEntries_vec;
+    // Builds the entries, in order, each time the menu is materialized.
+    std::vector<std::function<void()>> content;
 
 public:
     Menu(Renderer* renderer);
+    Menu(Renderer* renderer, unsigned int xMin, unsigned int xMax, unsigned int yMin, unsigned int yMax);
     Menu(Renderer* renderer, CountingLatch& latch);
     Menu(Renderer* renderer, CountingLatch& latch, unsigned int xMin, unsigned int xMax, unsigned int yMin, unsigned int yMax);
     ~Menu();
     void setup();
+    void describe(std::function<void()> fragment);
+    bool materialize();
+    void evict();
+    size_t residentVertexBytes();
     void onClick(const CubeEvent&);
     void onRelease(const CubeEvent&);
     void onMouseDown(const CubeEvent&);
@@ -305,6 +317,7 @@ public:
     void setSize(glm::vec2 size);
     void setSize(float size);
     void draw();
+    bool collect(DrawList& list);
     bool setVisible(bool visible);
     bool getVisible();
     bool setIsClickable(bool isClickable) { return false; }
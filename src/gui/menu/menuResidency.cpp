@@ -0,0 +1,90 @@
+/*
+███╗   ███╗███████╗███╗   ██╗██╗   ██╗██████╗ ███████╗███████╗██╗██████╗ ███████╗███╗   ██╗ ██████╗██╗   ██╗    ██████╗██████╗ ██████╗
+████╗ ████║██╔════╝████╗  ██║██║   ██║██╔══██╗██╔════╝██╔════╝██║██╔══██╗██╔════╝████╗  ██║██╔════╝╚██╗ ██╔╝   ██╔════╝██╔══██╗██╔══██╗
+██╔████╔██║█████╗  ██╔██╗ ██║██║   ██║██████╔╝█████╗  ███████╗██║██║  ██║█████╗  ██╔██╗ ██║██║      ╚████╔╝    ██║     ██████╔╝██████╔╝
+██║╚██╔╝██║██╔══╝  ██║╚██╗██║██║   ██║██╔══██╗██╔══╝  ╚════██║██║██║  ██║██╔══╝  ██║╚██╗██║██║       ╚██╔╝     ██║     ██╔═══╝ ██╔═══╝
+██║ ╚═╝ ██║███████╗██║ ╚████║╚██████╔╝██║  ██║███████╗███████║██║██████╔╝███████╗██║ ╚████║╚██████╗   ██║   ██╗╚██████╗██║     ██║
+╚═╝     ╚═╝╚══════╝╚═╝  ╚═══╝ ╚═════╝ ╚═╝  ╚═╝╚══════╝╚══════╝╚═╝╚═════╝ ╚══════╝╚═╝  ╚═══╝ ╚═════╝   ╚═╝   ╚═╝ ╚═════╝╚═╝     ╚═╝
+*/
+
+/*
+MIT License
+
+Copyright (c) 2026 A-McD Technology LLC
+*/
+
+#include "menuResidency.h"
+
+#include <fstream>
+#include <sstream>
+
+MenuResidency::MenuResidency(size_t limit)
+    : residentLimit(limit)
+{
+}
+
+void MenuResidency::touch(const std::string& id)
+{
+    auto it = this->index.find(id);
+    if (it != this->index.end()) {
+        this->order.splice(this->order.begin(), this->order, it->second);
+        return;
+    }
+    this->order.push_front(id);
+    this->index[id] = this->order.begin();
+}
+
+void MenuResidency::forget(const std::string& id)
+{
+    auto it = this->index.find(id);
+    if (it == this->index.end()) {
+        return;
+    }
+    this->order.erase(it->second);
+    this->index.erase(it);
+}
+
+bool MenuResidency::contains(const std::string& id) const
+{
+    return this->index.contains(id);
+}
+
+std::vector<std::string> MenuResidency::victims(const std::function<bool(const std::string&)>& pinned, bool underPressure) const
+{
+    std::vector<std::string> out;
+    size_t excess = this->order.size() > this->residentLimit ? this->order.size() - this->residentLimit : 0;
+    if (!underPressure && excess == 0) {
+        return out;
+    }
+    for (auto it = this->order.rbegin(); it != this->order.rend(); ++it) {
+        if (!underPressure && out.size() == excess) {
+            break;
+        }
+        if (pinned && pinned(*it)) {
+            continue;
+        }
+        out.push_back(*it);
+    }
+    return out;
+}
+
+std::optional<uint64_t> MenuResidency::availableMemory(const std::string& meminfoPath)
+{
+    std::ifstream file(meminfoPath);
+    if (!file.is_open()) {
+        return std::nullopt;
+    }
+    std::string line;
+    while (std::getline(file, line)) {
+        if (!line.starts_with("MemAvailable:")) {
+            continue;
+        }
+        std::istringstream fields(line.substr(13));
+        uint64_t kib = 0;
+        if (!(fields >> kib)) {
+            return std::nullopt;
+        }
+        return kib * 1024;
+    }
+    return std::nullopt;
+}
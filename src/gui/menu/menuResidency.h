@@ -0,0 +1,61 @@
+/*
+███╗   ███╗███████╗███╗   ██╗██╗   ██╗██████╗ ███████╗███████╗██╗██████╗ ███████╗███╗   ██╗ ██████╗██╗   ██╗   ██╗  ██╗
+████╗ ████║██╔════╝████╗  ██║██║   ██║██╔══██╗██╔════╝██╔════╝██║██╔══██╗██╔════╝████╗  ██║██╔════╝╚██╗ ██╔╝   ██║  ██║
+██╔████╔██║█████╗  ██╔██╗ ██║██║   ██║██████╔╝█████╗  ███████╗██║██║  ██║█████╗  ██╔██╗ ██║██║      ╚████╔╝    ███████║
+██║╚██╔╝██║██╔══╝  ██║╚██╗██║██║   ██║██╔══██╗██╔══╝  ╚════██║██║██║  ██║██╔══╝  ██║╚██╗██║██║       ╚██╔╝     ██╔══██║
+██║ ╚═╝ ██║███████╗██║ ╚████║╚██████╔╝██║  ██║███████╗███████║██║██████╔╝███████╗██║ ╚████║╚██████╗   ██║   ██╗██║  ██║
+╚═╝     ╚═╝╚══════╝╚═╝  ╚═══╝ ╚═════╝ ╚═╝  ╚═╝╚══════╝╚══════╝╚═╝╚═════╝ ╚══════╝╚═╝  ╚═══╝ ╚═════╝   ╚═╝   ╚═╝╚═╝  ╚═╝
+*/
+
+/*
+MIT License
+
+Copyright (c) 2026 A-McD Technology LLC
+*/
+
+#pragma once
+#ifndef MENURESIDENCY_H
+#define MENURESIDENCY_H
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/*
+Submenus are described up front and only built (entries, text meshes, glyphs) the first time they are
+opened. MenuResidency is the bookkeeping for that: which menus are built, in least-recently-opened
+order, and which of them to drop when there are more than `limit` or the system is short on memory.
+Menus are keyed by their unique menu identifier. Pure bookkeeping, no GL.
+*/
+class MenuResidency {
+public:
+    explicit MenuResidency(size_t limit);
+
+    // Marks a menu as built and most recently opened.
+    void touch(const std::string& id);
+    void forget(const std::string& id);
+    bool contains(const std::string& id) const;
+    size_t resident() const { return this->order.size(); }
+    size_t limit() const { return this->residentLimit; }
+    void setLimit(size_t limit) { this->residentLimit = limit; }
+
+    // Menus to drop, least recently opened first. Enough are returned to get back under the limit, or
+    // every one that isn't pinned when under memory pressure. Pinned menus are never returned.
+    std::vector<std::string> victims(const std::function<bool(const std::string&)>& pinned, bool underPressure) const;
+
+    // MemAvailable from a /proc/meminfo style file, in bytes. nullopt if it can't be read.
+    static std::optional<uint64_t> availableMemory(const std::string& meminfoPath = "/proc/meminfo");
+
+private:
+    size_t residentLimit;
+    // Front is the most recently opened.
+    std::list<std::string> order;
+    std::unordered_map<std::string, std::list<std::string>::iterator> index;
+};
+
+#endif // MENURESIDENCY_H
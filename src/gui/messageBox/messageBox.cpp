@@ -37,6 +37,7 @@ SOFTWARE.
 // TODO: disable menu click listener when message box is visible
 
 #include "messageBox.h"
+#include "../renderDamage.h"
 
 /**
  * @brief Construct a new Cube Message Box object
@@ -140,62 +141,47 @@ void CubeMessageBox::setup()
 }
 
 /**
- * @brief Set the text of the message box. This adds a lambda to the renderer's setup tasks to set the text.
+ * @brief Set the text of the message box. The body is wrapped by TextLayout off the render thread;
+ * the text objects are rebuilt in a renderer setup task once the layout is ready.
  *
  * @param text - the text to display
  */
 void CubeMessageBox::setText(const std::string& text, const std::string& title)
 {
-    auto fn = [&, text, title]() {
-        CubeLog::info("Objects size: " + std::to_string(this->objects.size()));
-        CubeLog::info("textObjects size: " + std::to_string(this->textObjects.size()));
-        CubeLog::info("Objects size in memory: " + std::to_string(this->objects.size() * sizeof(MeshObject)));
-        // TODO: Clearing and rebuilding textObjects with manual delete/new is fragile because ownership crosses async renderer tasks; store text objects as std::unique_ptr and replace the vector atomically.
-        for (size_t index = 0; index < this->textObjects.size(); index++) {
-            delete this->textObjects[index];
-        }
-        this->textObjects.clear();
-        auto titleText = new M_Text(textShader, title, (this->messageTextSize * MESSAGEBOX_TITLE_TEXT_MULT), { 1.f, 1.f, 1.f }, { 0.f, 0.f });
-        float titleWidth = titleText->getWidth();
-        float titleX = this->position.x + (this->size.x - titleWidth) / 2.f;
-        float titleY = (this->position.y + this->size.y) - this->messageTextSize - STENCIL_INSET_PX;
-        titleText->setPosition({ titleX, titleY });
-        this->textObjects.push_back(titleText);
-        std::vector<std::string> lines;
-        size_t maxCharsPerLine = (size_t)((this->size.x - (2 * STENCIL_INSET_PX)) / (this->messageTextSize * 0.55f));
-        std::istringstream textStream(text);
-        std::string paragraph;
-        while (std::getline(textStream, paragraph)) {
-            if (paragraph.empty()) {
-                lines.push_back("");
-                continue;
-            }
-            std::istringstream wordStream(paragraph);
-            std::string word;
-            std::string current;
-            while (wordStream >> word) {
-                if (current.empty()) {
-                    current = word;
-                } else if ((current.size() + 1 + word.size()) <= maxCharsPerLine) {
-                    current += " " + word;
-                } else {
-                    lines.push_back(current);
-                    current = word;
-                }
+    const uint64_t request = ++this->textRequest;
+    auto apply = [this, request, title](std::shared_ptr<const TextLayout::Result> layout) {
+        this->renderer->addSetupTask([this, request, title, layout]() {
+            if (request == this->textRequest.load()) {
+                this->applyText(title, *layout);
             }
-            if (!current.empty())
-                lines.push_back(current);
-        }
-        if (lines.size() == 0)
-            lines.push_back(text);
-        for (size_t i = 0; i < lines.size(); i++) {
-            float shiftForPreviousLines = ((float)(i + 1) * this->messageTextSize) + (this->messageTextSize * MESSAGEBOX_TITLE_TEXT_MULT);
-            float shiftForMargin = (float)(i + 1) * MESSAGEBOX_LINE_SPACING * this->messageTextSize;
-            this->textObjects.push_back(new M_Text(textShader, lines[i], this->messageTextSize, { 1.f, 1.f, 1.f }, { this->position.x + STENCIL_INSET_PX, (this->position.y + this->size.y) - STENCIL_INSET_PX - shiftForPreviousLines - shiftForMargin }));
-        }
-        CubeLog::info("TextBox text set");
+        });
     };
-    this->renderer->addSetupTask(fn);
+    const int wrapWidth = static_cast<int>(this->size.x - (2 * STENCIL_INSET_PX));
+    if (auto layout = TextLayout::shared().request(text, static_cast<int>(this->messageTextSize), wrapWidth, apply)) {
+        apply(layout);
+    }
+}
+
+void CubeMessageBox::applyText(const std::string& title, const TextLayout::Result& layout)
+{
+    // TODO: Clearing and rebuilding textObjects with manual delete/new is fragile because ownership crosses async renderer tasks; store text objects as std::unique_ptr and replace the vector atomically.
+    for (size_t index = 0; index < this->textObjects.size(); index++) {
+        delete this->textObjects[index];
+    }
+    this->textObjects.clear();
+    M_Text::preload(layout);
+    auto titleText = new M_Text(textShader, title, (this->messageTextSize * MESSAGEBOX_TITLE_TEXT_MULT), { 1.f, 1.f, 1.f }, { 0.f, 0.f });
+    float titleWidth = titleText->getWidth();
+    float titleX = this->position.x + (this->size.x - titleWidth) / 2.f;
+    float titleY = (this->position.y + this->size.y) - this->messageTextSize - STENCIL_INSET_PX;
+    titleText->setPosition({ titleX, titleY });
+    this->textObjects.push_back(titleText);
+    for (size_t i = 0; i < layout.lines.size(); i++) {
+        float shiftForPreviousLines = ((float)(i + 1) * this->messageTextSize) + (this->messageTextSize * MESSAGEBOX_TITLE_TEXT_MULT);
+        float shiftForMargin = (float)(i + 1) * MESSAGEBOX_LINE_SPACING * this->messageTextSize;
+        this->textObjects.push_back(new M_Text(textShader, layout.lines[i].text, this->messageTextSize, { 1.f, 1.f, 1.f }, { this->position.x + STENCIL_INSET_PX, (this->position.y + this->size.y) - STENCIL_INSET_PX - shiftForPreviousLines - shiftForMargin }));
+    }
+    CubeLog::info("MessageBox text set: " + std::to_string(layout.lines.size()) + " lines");
 }
 
 /**
@@ -209,6 +195,10 @@ bool CubeMessageBox::setVisible(bool visible)
     CubeLog::debug("MessageBox visibility set to " + std::to_string(visible));
     bool temp = this->visible;
     this->visible = visible;
+    if (temp != visible) {
+        RenderDamage::invalidate();
+        ClickableArea::changed();
+    }
     if (this->callback != nullptr)
         if (this->visible)
             this->callback();
@@ -238,11 +228,15 @@ void CubeMessageBox::draw()
         return;
     }
     glDisable(GL_DEPTH_TEST);
-    for (auto object : this->objects) {
-        object->draw();
-    }
-    for (auto object : this->textObjects) {
-        object->draw();
+    {
+        // Chrome goes out as one batch; the text shader bind flushes it first.
+        PrimitiveBatch::Scope chrome;
+        for (auto object : this->objects) {
+            object->draw();
+        }
+        for (auto object : this->textObjects) {
+            object->draw();
+        }
     }
     glEnable(GL_DEPTH_TEST);
 }
@@ -264,6 +258,7 @@ void CubeMessageBox::setPosition(glm::vec2 position)
     this->clickArea.xMax = (unsigned int)(this->position.x + this->size.x);
     this->clickArea.yMin = (unsigned int)this->position.y;
     this->clickArea.yMax = (unsigned int)(this->position.y + this->size.y);
+    ClickableArea::changed();
 }
 
 /**
@@ -283,6 +278,7 @@ void CubeMessageBox::setSize(glm::vec2 size)
     this->clickArea.xMax = (unsigned int)(this->position.x + this->size.x);
     this->clickArea.yMin = (unsigned int)this->position.y;
     this->clickArea.yMax = (unsigned int)(this->position.y + this->size.y);
+    ClickableArea::changed();
 }
 
 /**
@@ -373,6 +369,10 @@ bool CubeTextBox::setVisible(bool visible)
     CubeLog::debug("TextBox visibility set to " + std::to_string(visible));
     bool temp = this->visible;
     this->visible = visible;
+    if (temp != visible) {
+        RenderDamage::invalidate();
+        ClickableArea::changed();
+    }
     if (this->callback != nullptr)
         if (!this->visible)
             this->callback();
@@ -444,33 +444,34 @@ void CubeTextBox::setCallback(std::function<void()> callback)
 
 void CubeTextBox::setText(const std::string& text, const std::string& title)
 {
-    auto fn = [&, text, title]() {
-        CubeLog::info("Objects size: " + std::to_string(this->objects.size()));
-        CubeLog::info("textObjects size: " + std::to_string(this->textObjects.size()));
-        CubeLog::info("Objects size in memory: " + std::to_string(this->objects.size() * sizeof(MeshObject)));
-        for (size_t index = 0; index < this->textObjects.size(); index++) {
-            delete this->textObjects[index];
-        }
-        this->textObjects.clear();
-        this->textObjects.push_back(new M_Text(textShader, title, (this->messageTextSize * MESSAGEBOX_TITLE_TEXT_MULT), { 1.f, 1.f, 1.f }, { this->position.x + STENCIL_INSET_PX, (this->position.y + this->size.y) - this->messageTextSize - STENCIL_INSET_PX }));
-        std::vector<std::string> lines;
-        std::string line;
-        std::istringstream textStream(text);
-        while (std::getline(textStream, line)) {
-            lines.push_back(line);
-        }
-        if (lines.size() == 0)
-            lines.push_back(text);
-        if (lines[0].size() == 0)
-            lines[0] = text;
-        for (size_t i = 0; i < lines.size(); i++) {
-            float shiftForPreviousLines = ((float)(i + 1) * this->messageTextSize) + (this->messageTextSize * MESSAGEBOX_TITLE_TEXT_MULT);
-            float shiftForMargin = (float)(i + 1) * MESSAGEBOX_LINE_SPACING * this->messageTextSize;
-            this->textObjects.push_back(new M_Text(textShader, lines[i], this->messageTextSize, { 1.f, 1.f, 1.f }, { this->position.x + STENCIL_INSET_PX, (this->position.y + this->size.y) - STENCIL_INSET_PX - shiftForPreviousLines - shiftForMargin }));
-        }
-        CubeLog::info("TextBox text set");
+    const uint64_t request = ++this->textRequest;
+    auto apply = [this, request, title](std::shared_ptr<const TextLayout::Result> layout) {
+        this->renderer->addSetupTask([this, request, title, layout]() {
+            if (request == this->textRequest.load()) {
+                this->applyText(title, *layout);
+            }
+        });
     };
-    this->renderer->addSetupTask(fn);
+    const int wrapWidth = static_cast<int>(this->size.x - (2 * STENCIL_INSET_PX));
+    if (auto layout = TextLayout::shared().request(text, static_cast<int>(this->messageTextSize), wrapWidth, apply)) {
+        apply(layout);
+    }
+}
+
+void CubeTextBox::applyText(const std::string& title, const TextLayout::Result& layout)
+{
+    for (size_t index = 0; index < this->textObjects.size(); index++) {
+        delete this->textObjects[index];
+    }
+    this->textObjects.clear();
+    M_Text::preload(layout);
+    this->textObjects.push_back(new M_Text(textShader, title, (this->messageTextSize * MESSAGEBOX_TITLE_TEXT_MULT), { 1.f, 1.f, 1.f }, { this->position.x + STENCIL_INSET_PX, (this->position.y + this->size.y) - this->messageTextSize - STENCIL_INSET_PX }));
+    for (size_t i = 0; i < layout.lines.size(); i++) {
+        float shiftForPreviousLines = ((float)(i + 1) * this->messageTextSize) + (this->messageTextSize * MESSAGEBOX_TITLE_TEXT_MULT);
+        float shiftForMargin = (float)(i + 1) * MESSAGEBOX_LINE_SPACING * this->messageTextSize;
+        this->textObjects.push_back(new M_Text(textShader, layout.lines[i].text, this->messageTextSize, { 1.f, 1.f, 1.f }, { this->position.x + STENCIL_INSET_PX, (this->position.y + this->size.y) - STENCIL_INSET_PX - shiftForPreviousLines - shiftForMargin }));
+    }
+    CubeLog::info("TextBox text set: " + std::to_string(layout.lines.size()) + " lines");
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -589,6 +590,15 @@ void CubeNotificaionBox::appendRoundedButtonOutlineLocked(const Rect& rect, floa
 
 void CubeNotificaionBox::refreshVisualStateLocked()
 {
+    // Keep showing the previous contents until the body has been wrapped; the worker wakes the render
+    // loop when it is done and the next draw() lands here again.
+    const int wrapWidth = static_cast<int>(this->size.x - (2 * STENCIL_INSET_PX));
+    const auto body = TextLayout::shared().request(this->bodyText, static_cast<int>(this->messageTextSize), wrapWidth);
+    if (!body) {
+        return;
+    }
+    M_Text::preload(*body);
+
     updateRectsLocked();
     clearButtonObjects();
     clearTextObjects();
@@ -643,41 +653,11 @@ void CubeNotificaionBox::refreshVisualStateLocked()
         currentBaselineY = secondaryY - (this->messageTextSize * (this->secondaryTextScaleMultiplier + 0.9f));
     }
 
-    std::vector<std::string> lines;
-    const size_t maxCharsPerLine = static_cast<size_t>((this->size.x - (2 * STENCIL_INSET_PX)) / (this->messageTextSize * 0.55f));
-    std::istringstream textStream(this->bodyText);
-    std::string paragraph;
-    while (std::getline(textStream, paragraph)) {
-        if (paragraph.empty()) {
-            lines.push_back("");
-            continue;
-        }
-        std::istringstream wordStream(paragraph);
-        std::string word;
-        std::string current;
-        while (wordStream >> word) {
-            if (current.empty()) {
-                current = word;
-            } else if ((current.size() + 1 + word.size()) <= maxCharsPerLine) {
-                current += " " + word;
-            } else {
-                lines.push_back(current);
-                current = word;
-            }
-        }
-        if (!current.empty()) {
-            lines.push_back(current);
-        }
-    }
-    if (lines.empty()) {
-        lines.push_back(this->bodyText);
-    }
-
-    for (size_t i = 0; i < lines.size(); ++i) {
+    for (size_t i = 0; i < body->lines.size(); ++i) {
         const float lineY = currentBaselineY - static_cast<float>(i) * (this->messageTextSize + (MESSAGEBOX_LINE_SPACING * this->messageTextSize));
         this->textObjects.push_back(new M_Text(
             this->textShader,
-            lines[i],
+            body->lines[i].text,
             this->messageTextSize,
             { 1.f, 1.f, 1.f },
             { this->position.x + STENCIL_INSET_PX, lineY }));
@@ -752,6 +732,10 @@ bool CubeNotificaionBox::setVisible(bool visible)
     CubeLog::debug("NotificationBox visibility set to " + std::to_string(visible));
     bool previous = this->visible;
     this->visible = visible;
+    if (previous != visible) {
+        RenderDamage::invalidate();
+        ClickableArea::changed();
+    }
     this->needsRefresh = true;
     return previous;
 }
@@ -775,14 +759,17 @@ void CubeNotificaionBox::draw()
         return;
     }
     glDisable(GL_DEPTH_TEST);
-    for (auto* object : this->objects) {
-        object->draw();
-    }
-    for (auto* object : this->buttonObjects) {
-        object->draw();
-    }
-    for (auto* object : this->textObjects) {
-        object->draw();
+    {
+        PrimitiveBatch::Scope chrome;
+        for (auto* object : this->objects) {
+            object->draw();
+        }
+        for (auto* object : this->buttonObjects) {
+            object->draw();
+        }
+        for (auto* object : this->textObjects) {
+            object->draw();
+        }
     }
     glEnable(GL_DEPTH_TEST);
 }
@@ -1114,6 +1101,10 @@ bool CubeSliderBox::setVisible(bool visible)
     std::lock_guard<std::mutex> lock(this->mutex);
     bool previous = this->visible;
     this->visible = visible;
+    if (previous != visible) {
+        RenderDamage::invalidate();
+        ClickableArea::changed();
+    }
     this->dragging = false;
     this->needsRefresh = true;
     if (this->sliderObject != nullptr) {
@@ -1141,11 +1132,14 @@ void CubeSliderBox::draw()
         return;
     }
     glDisable(GL_DEPTH_TEST);
-    for (auto* object : this->objects) {
-        object->draw();
-    }
-    for (auto* object : this->textObjects) {
-        object->draw();
+    {
+        PrimitiveBatch::Scope chrome;
+        for (auto* object : this->objects) {
+            object->draw();
+        }
+        for (auto* object : this->textObjects) {
+            object->draw();
+        }
     }
     glEnable(GL_DEPTH_TEST);
 }
@@ -1294,6 +1288,7 @@ void CubeSliderBox::confirmSelection()
         this->visible = false;
         this->dragging = false;
         this->needsRefresh = true;
+        ClickableArea::changed();
         callback = this->confirmCallback;
         value = this->committedValue;
     }
@@ -1311,6 +1306,7 @@ void CubeSliderBox::cancelSelection()
         this->visible = false;
         this->dragging = false;
         this->needsRefresh = true;
+        ClickableArea::changed();
         callback = this->cancelCallback;
     }
     if (callback) {
@@ -87,6 +87,9 @@ private:
     bool hasCountedDown = false;
     glm::vec2 position;
     glm::vec2 size;
+    // Layouts finish out of order; only the newest setText() gets applied.
+    std::atomic<uint64_t> textRequest { 0 };
+    void applyText(const std::string& title, const TextLayout::Result& layout);
 
 public:
     CubeMessageBox(Shader* shader, Shader* textShader, Renderer* renderer, CountingLatch& latch);
@@ -128,6 +131,8 @@ private:
     glm::vec2 position;
     glm::vec2 size;
     int textMeshCount = 0;
+    std::atomic<uint64_t> textRequest { 0 };
+    void applyText(const std::string& title, const TextLayout::Result& layout);
 
 public:
     CubeTextBox(Shader* shader, Shader* textShader, Renderer* renderer, CountingLatch& latch);
@@ -34,14 +34,17 @@ SOFTWARE.
 #ifndef OBJECTS_H
 #define OBJECTS_H
 #include "GL/glew.h"
+#include <atomic>
 #include <functional>
 #include <glm/glm.hpp>
 #ifndef LOGGER_H
 #include <logger.h>
 #endif
 #include <vector>
+#include "sceneGraph.h"
 
 class Clickable;
+class DrawList;
 struct CubeEvent;
 
 struct Vertex {
@@ -68,10 +71,21 @@ struct ClickableArea {
     }
     Clickable* clickableObject;
     long xMin, xMax, yMin, yMax;
+
+    // Anything that moves, resizes, shows or hides an area after it is registered calls changed() so
+    // hit-test indexes know to rebuild before the next click.
+    inline static std::atomic<uint64_t> generation { 0 };
+    static void changed() { generation.fetch_add(1, std::memory_order_relaxed); }
 };
 
 class MeshObject {
 public:
+    MeshObject()
+        : node(SceneGraph::shared().create())
+    {
+    }
+    MeshObject(const MeshObject&) = delete;
+    MeshObject& operator=(const MeshObject&) = delete;
     std::string type = "";
     virtual void draw() = 0;
     virtual void setProjectionMatrix(glm::mat4 projectionMatrix) = 0;
@@ -90,11 +104,27 @@ public:
     virtual glm::vec3 getCenterPoint() = 0;
     virtual std::vector<Vertex> getVertices() = 0;
     virtual float getWidth() = 0;
-    virtual ~MeshObject() {};
+    virtual ~MeshObject() { SceneGraph::shared().destroy(this->node); };
     virtual void capturePosition() = 0;
     virtual void restorePosition() = 0;
     virtual void setVisibility(bool visible) = 0;
     virtual void getRestorePositionDiff(glm::mat4* modelMatrix, glm::mat4* viewMatrix, glm::mat4* projectionMatrix) = 0;
+    // Program/texture key DrawList groups this object by (see DrawList::key()).
+    virtual uint64_t drawKey() { return 0; }
+    SceneNode sceneNode() const { return this->node; }
+    // Draw relative to another node, e.g. a composite widget's scroll offset.
+    void setParentNode(SceneNode parent) { SceneGraph::shared().setParent(this->node, parent); }
+    // Apply a folded run of transforms at once: model = pre * model * post. Does not mark damage.
+    void transformLocal(const glm::mat4& pre, const glm::mat4& post) { SceneGraph::shared().transform(this->node, pre, post); }
+
+protected:
+    // The model matrix is the node's local transform; draws use the world transform.
+    glm::mat4 localMatrix() const { return SceneGraph::shared().local(this->node); }
+    void setLocalMatrix(const glm::mat4& modelMatrix) { SceneGraph::shared().setLocal(this->node, modelMatrix); }
+    glm::mat4 worldMatrix() const { return SceneGraph::shared().world(this->node); }
+
+private:
+    SceneNode node;
 };
 
 class Object {
@@ -132,6 +162,9 @@ public:
     virtual void resetScroll() = 0;
     virtual bool getIsClickable() = 0;
     virtual bool setIsClickable(bool isClickable) = 0;
+    // Queue this clickable's pieces on a shared DrawList instead of drawing them right away. Returns
+    // false if it does not support that, in which case the caller draws it with draw().
+    virtual bool collect(DrawList& list) { return false; }
 };
 
 template <typename T>
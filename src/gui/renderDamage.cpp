@@ -0,0 +1,115 @@
+/*
+██████╗ ███████╗███╗   ██╗██████╗ ███████╗██████╗ ██████╗  █████╗ ███╗   ███╗ █████╗  ██████╗ ███████╗    ██████╗██████╗ ██████╗
+██╔══██╗██╔════╝████╗  ██║██╔══██╗██╔════╝██╔══██╗██╔══██╗██╔══██╗████╗ ████║██╔══██╗██╔════╝ ██╔════╝   ██╔════╝██╔══██╗██╔══██╗
+██████╔╝█████╗  ██╔██╗ ██║██║  ██║█████╗  ██████╔╝██║  ██║███████║██╔████╔██║███████║██║  ███╗█████╗     ██║     ██████╔╝██████╔╝
+██╔══██╗██╔══╝  ██║╚██╗██║██║  ██║██╔══╝  ██╔══██╗██║  ██║██╔══██║██║╚██╔╝██║██╔══██║██║   ██║██╔══╝     ██║     ██╔═══╝ ██╔═══╝
+██║  ██║███████╗██║ ╚████║██████╔╝███████╗██║  ██║██████╔╝██║  ██║██║ ╚═╝ ██║██║  ██║╚██████╔╝███████╗██╗╚██████╗██║     ██║
+╚═╝  ╚═╝╚══════╝╚═╝  ╚═══╝╚═════╝ ╚══════╝╚═╝  ╚═╝╚═════╝ ╚═╝  ╚═╝╚═╝     ╚═╝╚═╝  ╚═╝ ╚═════╝ ╚══════╝╚═╝ ╚═════╝╚═╝     ╚═╝
+*/
+
+/*
+MIT License
+
+Copyright (c) 2026 A-McD Technology LLC
+*/
+
+
+#include "renderDamage.h"
+
+#include <algorithm>
+#include <cmath>
+
+std::atomic<bool> RenderDamage::dirty = false;
+std::atomic<bool> RenderDamage::full = false;
+std::mutex RenderDamage::mutex;
+DamageRect RenderDamage::rect;
+std::function<void()> RenderDamage::wakeHook;
+
+DamageRect DamageRect::united(const DamageRect& other) const
+{
+    if (this->empty()) {
+        return other;
+    }
+    if (other.empty()) {
+        return *this;
+    }
+    const int x0 = std::min(this->x, other.x);
+    const int y0 = std::min(this->y, other.y);
+    const int x1 = std::max(this->x + this->width, other.x + other.width);
+    const int y1 = std::max(this->y + this->height, other.y + other.height);
+    return { x0, y0, x1 - x0, y1 - y0 };
+}
+
+DamageRect DamageRect::covering(float x0, float y0, float x1, float y1)
+{
+    const int left = static_cast<int>(std::floor(std::min(x0, x1))) - 1;
+    const int bottom = static_cast<int>(std::floor(std::min(y0, y1))) - 1;
+    const int right = static_cast<int>(std::ceil(std::max(x0, x1))) + 1;
+    const int top = static_cast<int>(std::ceil(std::max(y0, y1))) + 1;
+    return { left, bottom, right - left, top - bottom };
+}
+
+/**
+ * @brief Mark the whole frame as needing a redraw.
+ */
+void RenderDamage::invalidate()
+{
+    RenderDamage::full.store(true, std::memory_order_relaxed);
+    RenderDamage::markPending();
+}
+
+/**
+ * @brief Mark a region of the frame as needing a redraw.
+ *
+ * @param damaged window pixels, origin bottom-left
+ */
+void RenderDamage::invalidate(const DamageRect& damaged)
+{
+    if (damaged.empty()) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(RenderDamage::mutex);
+        RenderDamage::rect = RenderDamage::rect.united(damaged);
+    }
+    RenderDamage::markPending();
+}
+
+void RenderDamage::markPending()
+{
+    if (RenderDamage::dirty.exchange(true, std::memory_order_acq_rel)) {
+        return;
+    }
+    std::lock_guard<std::mutex> lock(RenderDamage::mutex);
+    if (RenderDamage::wakeHook) {
+        RenderDamage::wakeHook();
+    }
+}
+
+bool RenderDamage::pending()
+{
+    return RenderDamage::dirty.load(std::memory_order_acquire);
+}
+
+RenderDamage::Frame RenderDamage::take()
+{
+    Frame frame;
+    if (!RenderDamage::dirty.exchange(false, std::memory_order_acq_rel)) {
+        return frame;
+    }
+    frame.dirty = true;
+    frame.full = RenderDamage::full.exchange(false, std::memory_order_relaxed);
+    std::lock_guard<std::mutex> lock(RenderDamage::mutex);
+    frame.rect = RenderDamage::rect;
+    RenderDamage::rect = {};
+    if (frame.rect.empty()) {
+        frame.full = true;
+    }
+    return frame;
+}
+
+void RenderDamage::setWakeHook(std::function<void()> hook)
+{
+    std::lock_guard<std::mutex> lock(RenderDamage::mutex);
+    RenderDamage::wakeHook = std::move(hook);
+}
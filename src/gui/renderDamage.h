@@ -0,0 +1,78 @@
+/*
+██████╗ ███████╗███╗   ██╗██████╗ ███████╗██████╗ ██████╗  █████╗ ███╗   ███╗ █████╗  ██████╗ ███████╗   ██╗  ██╗
+██╔══██╗██╔════╝████╗  ██║██╔══██╗██╔════╝██╔══██╗██╔══██╗██╔══██╗████╗ ████║██╔══██╗██╔════╝ ██╔════╝   ██║  ██║
+██████╔╝█████╗  ██╔██╗ ██║██║  ██║█████╗  ██████╔╝██║  ██║███████║██╔████╔██║███████║██║  ███╗█████╗     ███████║
+██╔══██╗██╔══╝  ██║╚██╗██║██║  ██║██╔══╝  ██╔══██╗██║  ██║██╔══██║██║╚██╔╝██║██╔══██║██║   ██║██╔══╝     ██╔══██║
+██║  ██║███████╗██║ ╚████║██████╔╝███████╗██║  ██║██████╔╝██║  ██║██║ ╚═╝ ██║██║  ██║╚██████╔╝███████╗██╗██║  ██║
+╚═╝  ╚═╝╚══════╝╚═╝  ╚═══╝╚═════╝ ╚══════╝╚═╝  ╚═╝╚═════╝ ╚═╝  ╚═╝╚═╝     ╚═╝╚═╝  ╚═╝ ╚═════╝ ╚══════╝╚═╝╚═╝  ╚═╝
+*/
+
+/*
+MIT License
+
+Copyright (c) 2026 A-McD Technology LLC
+*/
+
+
+#pragma once
+#ifndef RENDERDAMAGE_H
+#define RENDERDAMAGE_H
+#include <atomic>
+#include <functional>
+#include <mutex>
+
+/*
+
+Anything that changes what ends up on screen (a mesh transform, a visibility flip, new text) calls
+RenderDamage::invalidate(). The renderer takes the accumulated damage once per frame and skips the
+frame entirely when nothing was invalidated since the last one.
+
+Callers that know exactly which pixels they touched may pass a rectangle instead; the renderer uses
+it to scissor a partial redraw. Any plain invalidate() in the same frame widens it to the full frame.
+
+invalidate() may be called from any thread. Only the first call after take() does more than an
+atomic exchange: it runs the wake hook so a sleeping render loop notices.
+
+*/
+
+// In the 720x720 UI space the 2D shapes are projected with (origin bottom-left); the renderer scales
+// it to framebuffer pixels when scissoring.
+struct DamageRect {
+    int x = 0;
+    int y = 0;
+    int width = 0;
+    int height = 0;
+
+    bool empty() const { return width <= 0 || height <= 0; }
+    DamageRect united(const DamageRect& other) const;
+    // Smallest integer rect covering [x0, x1] x [y0, y1], grown by one unit for antialiased edges.
+    static DamageRect covering(float x0, float y0, float x1, float y1);
+};
+
+class RenderDamage {
+public:
+    struct Frame {
+        bool dirty = false;
+        bool full = false;
+        DamageRect rect; // only meaningful when dirty && !full
+    };
+
+    static void invalidate();
+    static void invalidate(const DamageRect& rect);
+    static bool pending();
+    // Returns everything invalidated since the previous take() and resets the accumulator.
+    static Frame take();
+    // Called (at most once per take()) when damage arrives while nothing is pending.
+    static void setWakeHook(std::function<void()> hook);
+
+private:
+    static void markPending();
+
+    static std::atomic<bool> dirty;
+    static std::atomic<bool> full;
+    static std::mutex mutex;
+    static DamageRect rect;
+    static std::function<void()> wakeHook;
+};
+
+#endif // RENDERDAMAGE_H
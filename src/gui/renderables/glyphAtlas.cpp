@@ -0,0 +1,287 @@
+/*
+ ██████╗ ██╗     ██╗   ██╗██████╗ ██╗  ██╗ █████╗ ████████╗██╗      █████╗ ███████╗    ██████╗██████╗ ██████╗
+██╔════╝ ██║     ╚██╗ ██╔╝██╔══██╗██║  ██║██╔══██╗╚══██╔══╝██║     ██╔══██╗██╔════╝   ██╔════╝██╔══██╗██╔══██╗
+██║  ███╗██║      ╚████╔╝ ██████╔╝███████║███████║   ██║   ██║     ███████║███████╗   ██║     ██████╔╝██████╔╝
+██║   ██║██║       ╚██╔╝  ██╔═══╝ ██╔══██║██╔══██║   ██║   ██║     ██╔══██║╚════██║   ██║     ██╔═══╝ ██╔═══╝
+╚██████╔╝███████╗   ██║   ██║     ██║  ██║██║  ██║   ██║   ███████╗██║  ██║███████║██╗╚██████╗██║     ██║
+ ╚═════╝ ╚══════╝   ╚═╝   ╚═╝     ╚═╝  ╚═╝╚═╝  ╚═╝   ╚═╝   ╚══════╝╚═╝  ╚═╝╚══════╝╚═╝ ╚═════╝╚═╝     ╚═╝
+*/
+
+/*
+MIT License
+
+Copyright (c) 2026 A-McD Technology LLC
+*/
+
+#include "glyphAtlas.h"
+#ifndef LOGGER_H
+#include <logger.h>
+#endif
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+
+SkylinePacker::SkylinePacker(int width, int height)
+    : width_(width)
+    , height_(height)
+{
+    reset();
+}
+
+void SkylinePacker::reset()
+{
+    skyline_.clear();
+    skyline_.push_back({ 0, 0, width_ });
+    usedArea_ = 0;
+}
+
+float SkylinePacker::occupancy() const
+{
+    return static_cast<float>(usedArea_) / static_cast<float>(static_cast<int64_t>(width_) * height_);
+}
+
+int SkylinePacker::fitAt(size_t index, int w, int h) const
+{
+    const int x = skyline_[index].x;
+    if (x + w > width_) {
+        return -1;
+    }
+    int y = 0;
+    int remaining = w;
+    for (size_t i = index; remaining > 0; ++i) {
+        y = std::max(y, skyline_[i].y);
+        if (y + h > height_) {
+            return -1;
+        }
+        remaining -= skyline_[i].width;
+    }
+    return y;
+}
+
+std::optional<glm::ivec2> SkylinePacker::pack(int w, int h)
+{
+    if (w <= 0 || h <= 0 || w > width_ || h > height_) {
+        return std::nullopt;
+    }
+    size_t bestIndex = skyline_.size();
+    int bestTop = std::numeric_limits<int>::max();
+    int bestWidth = std::numeric_limits<int>::max();
+    int bestY = 0;
+    for (size_t i = 0; i < skyline_.size(); ++i) {
+        const int y = fitAt(i, w, h);
+        if (y < 0) {
+            continue;
+        }
+        // Lowest resulting top edge first, then the narrowest segment, to keep the skyline flat.
+        if (y + h < bestTop || (y + h == bestTop && skyline_[i].width < bestWidth)) {
+            bestIndex = i;
+            bestTop = y + h;
+            bestWidth = skyline_[i].width;
+            bestY = y;
+        }
+    }
+    if (bestIndex == skyline_.size()) {
+        return std::nullopt;
+    }
+
+    const int x = skyline_[bestIndex].x;
+    skyline_.insert(skyline_.begin() + static_cast<std::ptrdiff_t>(bestIndex), { x, bestY + h, w });
+
+    // Trim or remove the segments now covered by the new one.
+    for (size_t i = bestIndex + 1; i < skyline_.size();) {
+        const int coveredTo = skyline_[i - 1].x + skyline_[i - 1].width;
+        if (skyline_[i].x >= coveredTo) {
+            break;
+        }
+        const int shrink = coveredTo - skyline_[i].x;
+        if (skyline_[i].width <= shrink) {
+            skyline_.erase(skyline_.begin() + static_cast<std::ptrdiff_t>(i));
+            continue;
+        }
+        skyline_[i].x += shrink;
+        skyline_[i].width -= shrink;
+        break;
+    }
+    // Merge neighbours at the same height.
+    for (size_t i = 0; i + 1 < skyline_.size();) {
+        if (skyline_[i].y == skyline_[i + 1].y) {
+            skyline_[i].width += skyline_[i + 1].width;
+            skyline_.erase(skyline_.begin() + static_cast<std::ptrdiff_t>(i + 1));
+        } else {
+            ++i;
+        }
+    }
+    usedArea_ += static_cast<int64_t>(w) * h;
+    return glm::ivec2(x, bestY);
+}
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+
+GlyphAtlas& GlyphAtlas::shared()
+{
+    static GlyphAtlas atlas;
+    return atlas;
+}
+
+void GlyphAtlas::beginUse()
+{
+    ++useClock_;
+}
+
+const AtlasGlyph* GlyphAtlas::find(uint32_t codepoint, int pixelSize)
+{
+    const auto it = glyphs_.find(key(codepoint, pixelSize));
+    if (it == glyphs_.end()) {
+        return nullptr;
+    }
+    if (it->second.hasBitmap) {
+        pages_[it->second.page].lastUsed = useClock_;
+    }
+    return &it->second;
+}
+
+const AtlasGlyph* GlyphAtlas::insert(uint32_t codepoint, int pixelSize, int width, int height, int pitch, const unsigned char* bitmap,
+    glm::ivec2 bearing, int64_t advance)
+{
+    AtlasGlyph glyph;
+    glyph.size = { width, height };
+    glyph.bearing = bearing;
+    glyph.advance = advance;
+    if (width <= 0 || height <= 0 || bitmap == nullptr) {
+        return &(glyphs_[key(codepoint, pixelSize)] = glyph);
+    }
+
+    const auto slot = allocate(width + GLYPH_ATLAS_PADDING, height + GLYPH_ATLAS_PADDING);
+    if (!slot) {
+        CubeLog::warning("GlyphAtlas: no room for glyph " + std::to_string(codepoint) + " at " + std::to_string(pixelSize) + "px");
+        return nullptr;
+    }
+    const auto [pageIndex, origin] = *slot;
+    Page& page = pages_[pageIndex];
+
+    // The upload wants tightly packed top-down rows; FreeType may pad rows or store them bottom-up.
+    const unsigned char* rows = bitmap;
+    if (pitch != width) {
+        rowScratch_.resize(static_cast<size_t>(width) * height);
+        for (int row = 0; row < height; ++row) {
+            const unsigned char* src = pitch > 0 ? bitmap + static_cast<ptrdiff_t>(row) * pitch
+                                                 : bitmap + static_cast<ptrdiff_t>(height - 1 - row) * -pitch;
+            std::memcpy(rowScratch_.data() + static_cast<size_t>(row) * width, src, static_cast<size_t>(width));
+        }
+        rows = rowScratch_.data();
+    }
+    glBindTexture(GL_TEXTURE_2D, page.texture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, origin.x, origin.y, width, height, GL_RED, GL_UNSIGNED_BYTE, rows);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    ++glyphUploads_;
+
+    constexpr float pageSize = static_cast<float>(GLYPH_ATLAS_PAGE_SIZE);
+    glyph.page = pageIndex;
+    glyph.hasBitmap = true;
+    glyph.uvMin = glm::vec2(static_cast<float>(origin.x) / pageSize, static_cast<float>(origin.y) / pageSize);
+    glyph.uvMax = glm::vec2(static_cast<float>(origin.x + width) / pageSize, static_cast<float>(origin.y + height) / pageSize);
+    const uint64_t glyphKey = key(codepoint, pixelSize);
+    page.keys.push_back(glyphKey);
+    page.lastUsed = useClock_;
+    return &(glyphs_[glyphKey] = glyph);
+}
+
+std::optional<std::pair<uint16_t, glm::ivec2>> GlyphAtlas::allocate(int w, int h)
+{
+    for (size_t i = 0; i < pages_.size(); ++i) {
+        if (const auto origin = pages_[i].packer.pack(w, h)) {
+            return std::make_pair(static_cast<uint16_t>(i), *origin);
+        }
+    }
+    if (pages_.size() < GLYPH_ATLAS_MAX_PAGES) {
+        pages_.emplace_back();
+        createPageTexture(pages_.back());
+        if (const auto origin = pages_.back().packer.pack(w, h)) {
+            return std::make_pair(static_cast<uint16_t>(pages_.size() - 1), *origin);
+        }
+        return std::nullopt;
+    }
+
+    // Every page is full: recycle the least recently used one, but never one the current build uses.
+    std::optional<uint16_t> victim;
+    for (size_t i = 0; i < pages_.size(); ++i) {
+        if (pages_[i].lastUsed == useClock_) {
+            continue;
+        }
+        if (!victim || pages_[i].lastUsed < pages_[*victim].lastUsed) {
+            victim = static_cast<uint16_t>(i);
+        }
+    }
+    if (!victim) {
+        return std::nullopt;
+    }
+    evict(*victim);
+    if (const auto origin = pages_[*victim].packer.pack(w, h)) {
+        return std::make_pair(*victim, *origin);
+    }
+    return std::nullopt;
+}
+
+void GlyphAtlas::createPageTexture(Page& page)
+{
+    const std::vector<unsigned char> zeros(static_cast<size_t>(GLYPH_ATLAS_PAGE_SIZE) * GLYPH_ATLAS_PAGE_SIZE, 0);
+    glGenTextures(1, &page.texture);
+    glBindTexture(GL_TEXTURE_2D, page.texture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, GLYPH_ATLAS_PAGE_SIZE, GLYPH_ATLAS_PAGE_SIZE, 0, GL_RED, GL_UNSIGNED_BYTE, zeros.data());
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    page.lastUsed = useClock_;
+}
+
+void GlyphAtlas::evict(uint16_t pageIndex)
+{
+    Page& page = pages_[pageIndex];
+    for (const auto glyphKey : page.keys) {
+        glyphs_.erase(glyphKey);
+    }
+    page.keys.clear();
+    page.packer.reset();
+    // Clear the texels so linear filtering at glyph edges never picks up a previous occupant.
+    const std::vector<unsigned char> zeros(static_cast<size_t>(GLYPH_ATLAS_PAGE_SIZE) * GLYPH_ATLAS_PAGE_SIZE, 0);
+    glBindTexture(GL_TEXTURE_2D, page.texture);
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, GLYPH_ATLAS_PAGE_SIZE, GLYPH_ATLAS_PAGE_SIZE, GL_RED, GL_UNSIGNED_BYTE, zeros.data());
+    glBindTexture(GL_TEXTURE_2D, 0);
+    ++pageEvictions_;
+    ++epoch_;
+    CubeLog::debug("GlyphAtlas: recycled page " + std::to_string(pageIndex));
+}
+
+GLuint GlyphAtlas::pageTexture(uint16_t page) const
+{
+    return page < pages_.size() ? pages_[page].texture : 0;
+}
+
+void GlyphAtlas::clear()
+{
+    for (auto& page : pages_) {
+        if (page.texture != 0) {
+            glDeleteTextures(1, &page.texture);
+        }
+    }
+    pages_.clear();
+    glyphs_.clear();
+    ++epoch_;
+}
+
+GlyphAtlas::Stats GlyphAtlas::stats() const
+{
+    Stats stats;
+    stats.glyphUploads = glyphUploads_;
+    stats.pageEvictions = pageEvictions_;
+    stats.pagesAllocated = pages_.size();
+    stats.cachedGlyphs = glyphs_.size();
+    return stats;
+}
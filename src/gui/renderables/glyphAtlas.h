@@ -0,0 +1,134 @@
+/*
+ ██████╗ ██╗     ██╗   ██╗██████╗ ██╗  ██╗ █████╗ ████████╗██╗      █████╗ ███████╗   ██╗  ██╗
+██╔════╝ ██║     ╚██╗ ██╔╝██╔══██╗██║  ██║██╔══██╗╚══██╔══╝██║     ██╔══██╗██╔════╝   ██║  ██║
+██║  ███╗██║      ╚████╔╝ ██████╔╝███████║███████║   ██║   ██║     ███████║███████╗   ███████║
+██║   ██║██║       ╚██╔╝  ██╔═══╝ ██╔══██║██╔══██║   ██║   ██║     ██╔══██║╚════██║   ██╔══██║
+╚██████╔╝███████╗   ██║   ██║     ██║  ██║██║  ██║   ██║   ███████╗██║  ██║███████║██╗██║  ██║
+ ╚═════╝ ╚══════╝   ╚═╝   ╚═╝     ╚═╝  ╚═╝╚═╝  ╚═╝   ╚═╝   ╚══════╝╚═╝  ╚═╝╚══════╝╚═╝╚═╝  ╚═╝
+*/
+
+/*
+MIT License
+
+Copyright (c) 2026 A-McD Technology LLC
+*/
+
+#pragma once
+#ifndef GLYPHATLAS_H
+#define GLYPHATLAS_H
+
+#include "GL/glew.h"
+#include <array>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+/*
+
+Glyph bitmaps for every M_Text live in a few shared single-channel atlas pages instead of one texture
+per glyph. Each page is packed with a skyline packer. When all pages are full, the page that was used
+least recently is wiped and repacked; every M_Text checks epoch() before drawing and rebuilds its
+vertices when a page it may reference has been recycled.
+
+All methods must be called on the render thread (they touch GL state).
+
+*/
+
+#define GLYPH_ATLAS_PAGE_SIZE 1024
+#define GLYPH_ATLAS_MAX_PAGES 4
+#define GLYPH_ATLAS_PADDING 1
+
+// Bottom-left skyline rectangle packer. Pure bookkeeping, no GL.
+class SkylinePacker {
+public:
+    SkylinePacker(int width, int height);
+
+    // Returns the top-left corner of a free w x h region, or nullopt if it does not fit.
+    std::optional<glm::ivec2> pack(int w, int h);
+    void reset();
+    int width() const { return width_; }
+    int height() const { return height_; }
+    // Fraction of the page covered by packed rectangles.
+    float occupancy() const;
+
+private:
+    struct Segment {
+        int x;
+        int y;
+        int width;
+    };
+    // Lowest y at which a w x h rectangle can sit starting at segment index; -1 if it does not fit.
+    int fitAt(size_t index, int w, int h) const;
+
+    int width_;
+    int height_;
+    int64_t usedArea_ = 0;
+    std::vector<Segment> skyline_;
+};
+
+struct AtlasGlyph {
+    uint16_t page = 0;
+    glm::vec2 uvMin { 0.f }; // top-left texel of the bitmap, normalised
+    glm::vec2 uvMax { 0.f };
+    glm::ivec2 size { 0 }; // bitmap size in pixels
+    glm::ivec2 bearing { 0 }; // offset from the pen position to the bitmap's left/top
+    int64_t advance = 0; // 26.6 fixed point, as reported by FreeType
+    bool hasBitmap = false;
+};
+
+class GlyphAtlas {
+public:
+    struct Stats {
+        uint64_t glyphUploads = 0;
+        uint64_t pageEvictions = 0;
+        size_t pagesAllocated = 0;
+        size_t cachedGlyphs = 0;
+    };
+
+    static GlyphAtlas& shared();
+
+    // Starts a new use window (one M_Text build). Pages touched during the current window are never
+    // evicted to make room, so every glyph returned while building one string stays valid.
+    void beginUse();
+
+    const AtlasGlyph* find(uint32_t codepoint, int pixelSize);
+    // Stores a rendered 8-bit bitmap (`pitch` bytes per row). Zero-sized bitmaps (spaces) take no
+    // atlas space. Returns nullptr if the glyph cannot be placed.
+    const AtlasGlyph* insert(uint32_t codepoint, int pixelSize, int width, int height, int pitch, const unsigned char* bitmap,
+        glm::ivec2 bearing, int64_t advance);
+
+    GLuint pageTexture(uint16_t page) const;
+    // Changes whenever a page is wiped; cached vertex data built under an older epoch is stale.
+    uint64_t epoch() const { return epoch_; }
+    // Drops every glyph and texture (font change).
+    void clear();
+    Stats stats() const;
+
+private:
+    struct Page {
+        GLuint texture = 0;
+        SkylinePacker packer { GLYPH_ATLAS_PAGE_SIZE, GLYPH_ATLAS_PAGE_SIZE };
+        uint64_t lastUsed = 0;
+        std::vector<uint64_t> keys; // glyphs stored on this page
+    };
+
+    static uint64_t key(uint32_t codepoint, int pixelSize)
+    {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(pixelSize)) << 32) | codepoint;
+    }
+    std::optional<std::pair<uint16_t, glm::ivec2>> allocate(int w, int h);
+    void createPageTexture(Page& page);
+    void evict(uint16_t pageIndex);
+
+    std::vector<Page> pages_;
+    std::unordered_map<uint64_t, AtlasGlyph> glyphs_;
+    uint64_t useClock_ = 0;
+    uint64_t epoch_ = 0;
+    uint64_t glyphUploads_ = 0;
+    uint64_t pageEvictions_ = 0;
+    std::vector<unsigned char> rowScratch_;
+};
+
+#endif // GLYPHATLAS_H
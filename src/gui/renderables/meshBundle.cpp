@@ -0,0 +1,484 @@
+/*
+███╗   ███╗███████╗███████╗██╗  ██╗██████╗ ██╗   ██╗███╗   ██╗██████╗ ██╗     ███████╗    ██████╗██████╗ ██████╗
+████╗ ████║██╔════╝██╔════╝██║  ██║██╔══██╗██║   ██║████╗  ██║██╔══██╗██║     ██╔════╝   ██╔════╝██╔══██╗██╔══██╗
+██╔████╔██║█████╗  ███████╗███████║██████╔╝██║   ██║██╔██╗ ██║██║  ██║██║     █████╗     ██║     ██████╔╝██████╔╝
+██║╚██╔╝██║██╔══╝  ╚════██║██╔══██║██╔══██╗██║   ██║██║╚██╗██║██║  ██║██║     ██╔══╝     ██║     ██╔═══╝ ██╔═══╝
+██║ ╚═╝ ██║███████╗███████║██║  ██║██████╔╝╚██████╔╝██║ ╚████║██████╔╝███████╗███████╗██╗╚██████╗██║     ██║
+╚═╝     ╚═╝╚══════╝╚══════╝╚═╝  ╚═╝╚═════╝  ╚═════╝ ╚═╝  ╚═══╝╚═════╝ ╚══════╝╚══════╝╚═╝ ╚═════╝╚═╝     ╚═╝
+*/
+
+/*
+MIT License
+
+Copyright (c) 2026 A-McD Technology LLC
+*/
+
+
+#include "meshBundle.h"
+#include <cstring>
+#include <fcntl.h>
+#include <filesystem>
+#include <fstream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <unordered_map>
+
+namespace {
+
+constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ull;
+constexpr uint64_t FNV_PRIME = 1099511628211ull;
+
+void putBytes(std::vector<uint8_t>& out, const void* bytes, size_t length)
+{
+    const uint8_t* begin = static_cast<const uint8_t*>(bytes);
+    out.insert(out.end(), begin, begin + length);
+}
+
+template <typename T>
+void put(std::vector<uint8_t>& out, const T& value)
+{
+    putBytes(out, &value, sizeof(T));
+}
+
+void padTo(std::vector<uint8_t>& out, size_t alignment)
+{
+    while (out.size() % alignment != 0) {
+        out.push_back(0);
+    }
+}
+
+void putString(std::vector<uint8_t>& out, const std::string& value)
+{
+    put(out, static_cast<uint32_t>(value.size()));
+    putBytes(out, value.data(), value.size());
+    padTo(out, 4);
+}
+
+void putKeyframes(std::vector<uint8_t>& out, const std::vector<AnimationKeyframe>& keyframes)
+{
+    put(out, static_cast<uint32_t>(keyframes.size()));
+    for (const auto& keyframe : keyframes) {
+        MeshBundleKeyframe record = {
+            static_cast<uint32_t>(keyframe.type),
+            keyframe.value,
+            keyframe.timeStart,
+            keyframe.timeEnd,
+            static_cast<uint32_t>(keyframe.easing),
+            { keyframe.axis.x, keyframe.axis.y, keyframe.axis.z },
+            { keyframe.point.x, keyframe.point.y, keyframe.point.z },
+        };
+        put(out, record);
+    }
+}
+
+// Bounds-checked reads over one entry's payload. Every read after the first failure fails.
+class PayloadReader {
+public:
+    PayloadReader(const uint8_t* begin, size_t length)
+        : cursor(begin)
+        , end(begin + length)
+    {
+    }
+
+    template <typename T>
+    const T* take(size_t count = 1)
+    {
+        if (!this->ok || count > static_cast<size_t>(this->end - this->cursor) / sizeof(T)) {
+            this->ok = false;
+            return nullptr;
+        }
+        const T* result = reinterpret_cast<const T*>(this->cursor);
+        this->cursor += count * sizeof(T);
+        return result;
+    }
+
+    bool readU32(uint32_t& value)
+    {
+        const uint32_t* p = this->take<uint32_t>();
+        if (p)
+            value = *p;
+        return p != nullptr;
+    }
+
+    // Reads a count of records that each take at least minRecordSize bytes, so a corrupt count is
+    // rejected before the caller sizes a container by it.
+    bool readCount(uint32_t& count, size_t minRecordSize)
+    {
+        if (!this->readU32(count))
+            return false;
+        if (count > this->remaining() / minRecordSize) {
+            this->ok = false;
+            return false;
+        }
+        return true;
+    }
+
+    // size bytes followed by padding to the next 4-byte boundary.
+    const uint8_t* takePadded(uint32_t size)
+    {
+        if (!this->ok || size > this->remaining()) {
+            this->ok = false;
+            return nullptr;
+        }
+        return this->take<uint8_t>((static_cast<size_t>(size) + 3) & ~static_cast<size_t>(3));
+    }
+
+    bool readString(std::string& value)
+    {
+        uint32_t size = 0;
+        if (!this->readU32(size))
+            return false;
+        const uint8_t* chars = this->takePadded(size);
+        if (!chars)
+            return false;
+        value.assign(reinterpret_cast<const char*>(chars), size);
+        return true;
+    }
+
+    bool readKeyframes(std::vector<AnimationKeyframe>& keyframes)
+    {
+        uint32_t count = 0;
+        if (!this->readU32(count))
+            return false;
+        const MeshBundleKeyframe* records = this->take<MeshBundleKeyframe>(count);
+        if (!records)
+            return false;
+        keyframes.clear();
+        keyframes.reserve(count);
+        for (uint32_t i = 0; i < count; i++) {
+            const MeshBundleKeyframe& record = records[i];
+            if (record.type > static_cast<uint32_t>(Animations::AnimationType::NOP) || record.easing > static_cast<uint32_t>(Animations::AnimationEasing::EASE_IN_OUT)) {
+                return false;
+            }
+            AnimationKeyframe keyframe;
+            keyframe.type = static_cast<Animations::AnimationType>(record.type);
+            keyframe.value = record.value;
+            keyframe.timeStart = record.timeStart;
+            keyframe.timeEnd = record.timeEnd;
+            keyframe.easing = static_cast<Animations::AnimationEasing>(record.easing);
+            keyframe.easingFunction = easingFunctionFor(keyframe.easing);
+            keyframe.axis = glm::vec3(record.axis[0], record.axis[1], record.axis[2]);
+            keyframe.point = glm::vec3(record.point[0], record.point[1], record.point[2]);
+            keyframes.push_back(keyframe);
+        }
+        return true;
+    }
+
+    bool good() const { return this->ok; }
+    size_t remaining() const { return static_cast<size_t>(this->end - this->cursor); }
+
+private:
+    const uint8_t* cursor;
+    const uint8_t* end;
+    bool ok = true;
+};
+
+} // namespace
+
+MeshBundle::MeshBundle(const std::string& path)
+{
+    int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return;
+    }
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(sizeof(MeshBundleHeader))) {
+        ::close(fd);
+        return;
+    }
+    void* mapped = mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapped == MAP_FAILED) {
+        CubeLog::warning("MeshBundle: Failed to map " + path);
+        return;
+    }
+    this->data = static_cast<const uint8_t*>(mapped);
+    this->length = static_cast<size_t>(info.st_size);
+
+    const MeshBundleHeader* header = reinterpret_cast<const MeshBundleHeader*>(this->data);
+    const size_t tableEnd = sizeof(MeshBundleHeader) + static_cast<size_t>(header->entryCount) * sizeof(MeshBundleEntry);
+    bool valid = std::memcmp(header->magic, MAGIC, sizeof(MAGIC)) == 0
+        && header->version == VERSION
+        && header->vertexSize == sizeof(Vertex)
+        && tableEnd <= this->length;
+    if (valid) {
+        this->entries = { reinterpret_cast<const MeshBundleEntry*>(this->data + sizeof(MeshBundleHeader)), header->entryCount };
+        for (const auto& entry : this->entries) {
+            if (entry.offset % 8 != 0 || entry.offset < tableEnd || entry.offset > this->length || entry.size > this->length - entry.offset || entry.name[sizeof(entry.name) - 1] != '\0') {
+                valid = false;
+                break;
+            }
+        }
+    }
+    if (!valid) {
+        CubeLog::warning("MeshBundle: Ignoring invalid or out of date bundle " + path);
+        munmap(const_cast<uint8_t*>(this->data), this->length);
+        this->data = nullptr;
+        this->length = 0;
+        this->entries = {};
+        return;
+    }
+    CubeLog::info("MeshBundle: Mapped " + std::to_string(this->entries.size()) + " entries from " + path);
+}
+
+MeshBundle::~MeshBundle()
+{
+    if (this->data) {
+        munmap(const_cast<uint8_t*>(this->data), this->length);
+    }
+}
+
+const MeshBundleEntry* MeshBundle::findFresh(const std::string& sourcePath, MeshBundleEntryKind kind) const
+{
+    if (!this->isOpen()) {
+        return nullptr;
+    }
+    const std::string name = std::filesystem::path(sourcePath).filename().string();
+    for (const auto& entry : this->entries) {
+        if (entry.kind != kind || name != entry.name) {
+            continue;
+        }
+        uint64_t sourceHash = 0;
+        if (!hashFile(sourcePath, sourceHash) || sourceHash != entry.sourceHash) {
+            CubeLog::info("MeshBundle: " + name + " changed since it was bundled; parsing the source instead");
+            return nullptr;
+        }
+        return &entry;
+    }
+    return nullptr;
+}
+
+bool MeshBundle::objMesh(const MeshBundleEntry& entry, MeshBundleObjView& view) const
+{
+    PayloadReader reader(this->data + entry.offset, entry.size);
+    const MeshBundleObjHeader* header = reader.take<MeshBundleObjHeader>();
+    if (!header) {
+        return false;
+    }
+    const Vertex* vertices = reader.take<Vertex>(header->vertexCount);
+    const uint32_t* indices = reader.take<uint32_t>(header->indexCount);
+    if (!reader.good()) {
+        return false;
+    }
+    for (uint32_t i = 0; i < header->indexCount; i++) {
+        if (indices[i] >= header->vertexCount) {
+            return false;
+        }
+    }
+    view.header = header;
+    view.vertices = { vertices, header->vertexCount };
+    view.indices = { indices, header->indexCount };
+    return true;
+}
+
+bool MeshBundle::cubes(const MeshBundleEntry& entry, std::span<const MeshBundleCube>& cubes) const
+{
+    PayloadReader reader(this->data + entry.offset, entry.size);
+    uint32_t count = 0;
+    reader.readU32(count);
+    reader.take<uint32_t>(); // padding
+    const MeshBundleCube* records = reader.take<MeshBundleCube>(count);
+    if (!records) {
+        return false;
+    }
+    cubes = { records, count };
+    return true;
+}
+
+bool MeshBundle::animation(const MeshBundleEntry& entry, Animation& animation) const
+{
+    PayloadReader reader(this->data + entry.offset, entry.size);
+    uint32_t name = 0;
+    if (!reader.readU32(name) || name >= static_cast<uint32_t>(Animations::AnimationNames_enum::COUNT)) {
+        return false;
+    }
+    animation.name = static_cast<Animations::AnimationNames_enum>(name);
+    return reader.readString(animation.expression) && reader.readKeyframes(animation.keyframes);
+}
+
+bool MeshBundle::expression(const MeshBundleEntry& entry, ExpressionDefinition& expression) const
+{
+    PayloadReader reader(this->data + entry.offset, entry.size);
+    uint32_t name = 0;
+    if (!reader.readU32(name) || name >= static_cast<uint32_t>(Expressions::ExpressionNames_enum::COUNT)) {
+        return false;
+    }
+    expression.name = static_cast<Expressions::ExpressionNames_enum>(name);
+    if (!reader.readString(expression.expression)) {
+        return false;
+    }
+    // Every object name and visibility row starts with a 4-byte length.
+    uint32_t objectCount = 0;
+    if (!reader.readCount(objectCount, sizeof(uint32_t))) {
+        return false;
+    }
+    expression.objects.resize(objectCount);
+    for (auto& object : expression.objects) {
+        if (!reader.readString(object)) {
+            return false;
+        }
+    }
+    uint32_t rows = 0;
+    if (!reader.readCount(rows, sizeof(uint32_t))) {
+        return false;
+    }
+    expression.visibility.resize(rows);
+    for (auto& row : expression.visibility) {
+        uint32_t count = 0;
+        const uint8_t* flags = reader.readU32(count) ? reader.takePadded(count) : nullptr;
+        if (!flags) {
+            return false;
+        }
+        row.assign(flags, flags + count);
+    }
+    return reader.readKeyframes(expression.animationKeyframes);
+}
+
+std::string MeshBundle::pathFor(const std::string& folderName)
+{
+    return "meshes/" + folderName + "/" + FILE_NAME;
+}
+
+uint64_t MeshBundle::hash(const void* bytes, size_t length)
+{
+    const uint8_t* p = static_cast<const uint8_t*>(bytes);
+    uint64_t h = FNV_OFFSET_BASIS;
+    for (size_t i = 0; i < length; i++) {
+        h ^= p[i];
+        h *= FNV_PRIME;
+    }
+    return h;
+}
+
+bool MeshBundle::hashFile(const std::string& path, uint64_t& hash)
+{
+    std::ifstream file(path, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+    std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+    hash = MeshBundle::hash(contents.data(), contents.size());
+    return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+
+void MeshBundleWriter::addObjMesh(const std::string& name, uint64_t sourceHash, const std::vector<Vertex>& vertices, uint32_t shapeCount)
+{
+    // Vertices are shared by bit pattern, so the indexed mesh draws exactly what the parsed list did.
+    std::unordered_map<std::string, uint32_t> seen;
+    std::vector<Vertex> unique;
+    std::vector<uint32_t> indices;
+    indices.reserve(vertices.size());
+    for (const auto& vertex : vertices) {
+        std::string key(reinterpret_cast<const char*>(&vertex), sizeof(Vertex));
+        auto [it, inserted] = seen.try_emplace(key, static_cast<uint32_t>(unique.size()));
+        if (inserted) {
+            unique.push_back(vertex);
+        }
+        indices.push_back(it->second);
+    }
+    const glm::vec3 center = OBJObject::centerOf(vertices);
+    MeshBundleObjHeader header = {
+        shapeCount,
+        static_cast<uint32_t>(unique.size()),
+        static_cast<uint32_t>(indices.size()),
+        OBJObject::widthOf(vertices),
+        { center.x, center.y, center.z },
+        0,
+    };
+    PendingEntry entry { name, sourceHash, MeshBundleEntryKind::OBJ_MESH, {} };
+    put(entry.payload, header);
+    putBytes(entry.payload, unique.data(), unique.size() * sizeof(Vertex));
+    putBytes(entry.payload, indices.data(), indices.size() * sizeof(uint32_t));
+    this->entries.push_back(std::move(entry));
+}
+
+void MeshBundleWriter::addCubes(const std::string& name, uint64_t sourceHash, const std::vector<glm::vec4>& cubes)
+{
+    PendingEntry entry { name, sourceHash, MeshBundleEntryKind::CUBE_MESH, {} };
+    put(entry.payload, static_cast<uint32_t>(cubes.size()));
+    put(entry.payload, static_cast<uint32_t>(0));
+    for (const auto& cube : cubes) {
+        put(entry.payload, MeshBundleCube { cube.x, cube.y, cube.z, cube.w });
+    }
+    this->entries.push_back(std::move(entry));
+}
+
+void MeshBundleWriter::addAnimation(const std::string& name, uint64_t sourceHash, const Animation& animation)
+{
+    PendingEntry entry { name, sourceHash, MeshBundleEntryKind::ANIMATION, {} };
+    put(entry.payload, static_cast<uint32_t>(animation.name));
+    putString(entry.payload, animation.expression);
+    putKeyframes(entry.payload, animation.keyframes);
+    this->entries.push_back(std::move(entry));
+}
+
+void MeshBundleWriter::addExpression(const std::string& name, uint64_t sourceHash, const ExpressionDefinition& expression)
+{
+    PendingEntry entry { name, sourceHash, MeshBundleEntryKind::EXPRESSION, {} };
+    put(entry.payload, static_cast<uint32_t>(expression.name));
+    putString(entry.payload, expression.expression);
+    put(entry.payload, static_cast<uint32_t>(expression.objects.size()));
+    for (const auto& object : expression.objects) {
+        putString(entry.payload, object);
+    }
+    put(entry.payload, static_cast<uint32_t>(expression.visibility.size()));
+    for (const auto& row : expression.visibility) {
+        put(entry.payload, static_cast<uint32_t>(row.size()));
+        for (bool visible : row) {
+            entry.payload.push_back(visible ? 1 : 0);
+        }
+        padTo(entry.payload, 4);
+    }
+    putKeyframes(entry.payload, expression.animationKeyframes);
+    this->entries.push_back(std::move(entry));
+}
+
+bool MeshBundleWriter::write(const std::string& path) const
+{
+    std::vector<uint8_t> out;
+    MeshBundleHeader header = {};
+    std::memcpy(header.magic, MeshBundle::MAGIC, sizeof(header.magic));
+    header.version = MeshBundle::VERSION;
+    header.entryCount = static_cast<uint32_t>(this->entries.size());
+    header.vertexSize = sizeof(Vertex);
+    put(out, header);
+
+    std::vector<MeshBundleEntry> table(this->entries.size());
+    uint64_t offset = sizeof(MeshBundleHeader) + table.size() * sizeof(MeshBundleEntry);
+    for (size_t i = 0; i < this->entries.size(); i++) {
+        const PendingEntry& pending = this->entries[i];
+        if (pending.name.size() >= sizeof(table[i].name)) {
+            return false;
+        }
+        offset = (offset + 7) & ~uint64_t(7);
+        std::memcpy(table[i].name, pending.name.c_str(), pending.name.size() + 1);
+        table[i].sourceHash = pending.sourceHash;
+        table[i].offset = offset;
+        table[i].size = pending.payload.size();
+        table[i].kind = pending.kind;
+        offset += pending.payload.size();
+    }
+    putBytes(out, table.data(), table.size() * sizeof(MeshBundleEntry));
+    for (const auto& pending : this->entries) {
+        padTo(out, 8);
+        putBytes(out, pending.payload.data(), pending.payload.size());
+    }
+
+    const std::string temporary = path + ".tmp";
+    {
+        std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+        if (!file.is_open()) {
+            return false;
+        }
+        file.write(reinterpret_cast<const char*>(out.data()), static_cast<std::streamsize>(out.size()));
+        if (!file.good()) {
+            return false;
+        }
+    }
+    std::error_code error;
+    std::filesystem::rename(temporary, path, error);
+    return !error;
+}
@@ -0,0 +1,162 @@
+/*
+███╗   ███╗███████╗███████╗██╗  ██╗██████╗ ██╗   ██╗███╗   ██╗██████╗ ██╗     ███████╗   ██╗  ██╗
+████╗ ████║██╔════╝██╔════╝██║  ██║██╔══██╗██║   ██║████╗  ██║██╔══██╗██║     ██╔════╝   ██║  ██║
+██╔████╔██║█████╗  ███████╗███████║██████╔╝██║   ██║██╔██╗ ██║██║  ██║██║     █████╗     ███████║
+██║╚██╔╝██║██╔══╝  ╚════██║██╔══██║██╔══██╗██║   ██║██║╚██╗██║██║  ██║██║     ██╔══╝     ██╔══██║
+██║ ╚═╝ ██║███████╗███████║██║  ██║██████╔╝╚██████╔╝██║ ╚████║██████╔╝███████╗███████╗██╗██║  ██║
+╚═╝     ╚═╝╚══════╝╚══════╝╚═╝  ╚═╝╚═════╝  ╚═════╝ ╚═╝  ╚═══╝╚═════╝ ╚══════╝╚══════╝╚═╝╚═╝  ╚═╝
+*/
+
+/*
+MIT License
+
+Copyright (c) 2026 A-McD Technology LLC
+*/
+
+
+#pragma once
+#ifndef MESHBUNDLE_H
+#define MESHBUNDLE_H
+#ifndef MESHLOADER_H
+#include "meshLoader.h"
+#endif // MESHLOADER_H
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <vector>
+
+/*
+
+A character's meshes, animations and expressions, baked ahead of time into one binary file per mesh
+folder (meshes/<folder>/bundle.cmb) so startup can map it and hand the data straight to GL instead of
+parsing OBJ text and JSON.
+
+The file is a header, a table of entries and the payloads. Each entry is named after the source file it
+was baked from ("OpenEyesSmile.obj", "anim_neutral_1.json") and records the FNV-1a hash of that file's
+bytes. The loaders still enumerate the source files as before; for each one they hash the file, and only
+if the bundle has an entry of the right kind with the same hash do they use it. Anything missing, stale
+or malformed falls back to the text path, so a bundle can never change what gets loaded, only how fast.
+
+Payloads:
+- OBJ meshes: the shape count, the bounds the OBJObject would otherwise compute, then the de-duplicated
+  interleaved Vertex array and a uint32 index buffer that expands back to the parsed vertex order.
+- .mesh files: one {x, y, z, scale} record per cube, already offset and scaled.
+- Animations and expressions: their names and strings, then the keyframes as fixed-size records with
+  the easing stored as an id.
+
+The bundle is written and read on the same machine (native endianness and float layout); the header
+records the Vertex size and a version so a mismatched file is rejected rather than misread.
+
+*/
+
+enum class MeshBundleEntryKind : uint32_t {
+    OBJ_MESH = 1,
+    CUBE_MESH = 2,
+    ANIMATION = 3,
+    EXPRESSION = 4
+};
+
+struct MeshBundleHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t entryCount;
+    uint32_t vertexSize;
+};
+
+struct MeshBundleEntry {
+    char name[64]; // source file name, NUL terminated
+    uint64_t sourceHash;
+    uint64_t offset; // from the start of the file
+    uint64_t size;
+    MeshBundleEntryKind kind;
+    uint32_t reserved;
+};
+
+struct MeshBundleObjHeader {
+    uint32_t shapeCount;
+    uint32_t vertexCount; // unique vertices
+    uint32_t indexCount; // vertices drawn
+    float width;
+    float center[3]; // average of the drawn vertices, in model space
+    uint32_t reserved;
+};
+
+struct MeshBundleCube {
+    float x, y, z;
+    float scale;
+};
+
+struct MeshBundleKeyframe {
+    uint32_t type;
+    float value;
+    uint32_t timeStart;
+    uint32_t timeEnd;
+    uint32_t easing;
+    float axis[3];
+    float point[3];
+};
+
+// Views into a mapped OBJ entry; valid while the MeshBundle is alive.
+struct MeshBundleObjView {
+    const MeshBundleObjHeader* header = nullptr;
+    std::span<const Vertex> vertices;
+    std::span<const uint32_t> indices;
+};
+
+class MeshBundle {
+public:
+    static constexpr char MAGIC[4] = { 'C', 'M', 'B', '1' };
+    static constexpr uint32_t VERSION = 1;
+    static constexpr const char* FILE_NAME = "bundle.cmb";
+
+    // Maps path read-only. A missing or invalid file leaves the bundle closed, which every lookup
+    // treats as a miss.
+    explicit MeshBundle(const std::string& path);
+    ~MeshBundle();
+    MeshBundle(const MeshBundle&) = delete;
+    MeshBundle& operator=(const MeshBundle&) = delete;
+
+    bool isOpen() const { return this->data != nullptr; }
+    // The entry baked from the file at sourcePath, if its kind matches and the file still hashes to
+    // what was baked. Returns nullptr otherwise.
+    const MeshBundleEntry* findFresh(const std::string& sourcePath, MeshBundleEntryKind kind) const;
+
+    bool objMesh(const MeshBundleEntry& entry, MeshBundleObjView& view) const;
+    bool cubes(const MeshBundleEntry& entry, std::span<const MeshBundleCube>& cubes) const;
+    bool animation(const MeshBundleEntry& entry, Animation& animation) const;
+    bool expression(const MeshBundleEntry& entry, ExpressionDefinition& expression) const;
+
+    static std::string pathFor(const std::string& folderName);
+    static uint64_t hash(const void* bytes, size_t length);
+    static bool hashFile(const std::string& path, uint64_t& hash);
+
+private:
+    const uint8_t* data = nullptr;
+    size_t length = 0;
+    std::span<const MeshBundleEntry> entries;
+};
+
+// Builds a bundle in memory; used by the CubeMeshBundler tool.
+class MeshBundleWriter {
+public:
+    // vertices are the OBJ's parsed vertices in draw order, as MeshLoader::parseObj returns them.
+    void addObjMesh(const std::string& name, uint64_t sourceHash, const std::vector<Vertex>& vertices, uint32_t shapeCount);
+    void addCubes(const std::string& name, uint64_t sourceHash, const std::vector<glm::vec4>& cubes);
+    void addAnimation(const std::string& name, uint64_t sourceHash, const Animation& animation);
+    void addExpression(const std::string& name, uint64_t sourceHash, const ExpressionDefinition& expression);
+    size_t size() const { return this->entries.size(); }
+    // Writes to a temporary file next to path and renames it into place.
+    bool write(const std::string& path) const;
+
+private:
+    struct PendingEntry {
+        std::string name;
+        uint64_t sourceHash;
+        MeshBundleEntryKind kind;
+        std::vector<uint8_t> payload;
+    };
+    std::vector<PendingEntry> entries;
+};
+
+#endif // MESHBUNDLE_H
@@ -32,6 +32,7 @@ SOFTWARE.
 */
 
 #include "meshLoader.h"
+#include "meshBundle.h"
 #define TINYOBJLOADER_IMPLEMENTATION
 #include "tiny_obj_loader.h"
 
@@ -45,6 +46,7 @@ MeshLoader::MeshLoader(Shader* shdr, const std::string& folderName, std::vector<
     for (auto name : filenames) {
         CubeLog::info("MeshLoader: Found file: " + name);
     }
+    MeshBundle bundle(MeshBundle::pathFor(this->folderName));
     // load .mesh files
     for (auto filename : filenames) {
         // ensure filetype is .mesh
@@ -61,7 +63,10 @@ MeshLoader::MeshLoader(Shader* shdr, const std::string& folderName, std::vector<
         CubeLog::info("Attempting to load mesh file: " + _filename);
         // concatenate the folder name with the filename
         _filename = "meshes/" + this->folderName + "/" + name + ".mesh";
-        std::vector<MeshObject*> objects = this->loadMesh(_filename);
+        std::vector<MeshObject*> objects;
+        if (!this->loadMeshFromBundle(bundle, _filename, objects)) {
+            objects = this->loadMesh(_filename);
+        }
         CubeLog::info("MeshLoader: Loaded " + std::to_string(objects.size()) + " objects from file: " + _filename);
         this->collections.push_back(new ObjectCollection());
         // collection name is filename minus ".mesh"
@@ -86,70 +91,16 @@ MeshLoader::MeshLoader(Shader* shdr, const std::string& folderName, std::vector<
         CubeLog::info("MeshLoader: Found obj file: " + _filename);
         CubeLog::info("Attempting to load obj file: " + _filename);
 
-        tinyobj::attrib_t attrib;
-        std::vector<tinyobj::shape_t> shapes;
-        std::vector<tinyobj::material_t> mats;
-        std::string warn, err;
-        std::map<int, tinyobj::material_t> materials;
-        std::vector<OBJObject*> objects;
-        std::vector<Vertex> vertices;
-
-        // Load the OBJ file and its materials
-        bool success = tinyobj::LoadObj(&attrib, &shapes, &mats, &warn, &err, _filename.c_str(), nullptr, true);
-
-        if (!warn.empty()) {
-            CubeLog::warning("MeshLoader: " + warn);
-        }
-
-        if (!err.empty()) {
-            CubeLog::error("MeshLoader: Failed to load obj file: " + _filename);
-            CubeLog::error(err);
-            continue;
-        }
-
-        if (!success) {
-            CubeLog::error("MeshLoader: Failed to load obj file: " + _filename);
-            continue;
-        }
-
-        // Store materials in a map for easy access
-        for (size_t i = 0; i < mats.size(); ++i) {
-            materials[i] = mats[i];
-        }
-
-        // Extract vertex positions and colors from the shapes
-        for (const auto& shape : shapes) {
-            for (size_t f = 0; f < shape.mesh.indices.size(); f++) {
-                const tinyobj::index_t& index = shape.mesh.indices[f];
-                Vertex vertex = {
-                    attrib.vertices[3 * index.vertex_index + 2],
-                    attrib.vertices[3 * index.vertex_index + 1],
-                    attrib.vertices[3 * index.vertex_index + 0],
-                    1.0f, 1.0f, 1.0f // Default white color if no material
-                };
-
-                // Get the material ID associated with the face
-                int material_id = shape.mesh.material_ids[f / 3]; // Assumes triangles (3 vertices per face)
-
-                // Check if the material exists
-                if (materials.count(material_id) > 0) {
-                    tinyobj::material_t material = materials[material_id];
-                    // Assign diffuse color from the material
-                    vertex.r = material.diffuse[0];
-                    vertex.g = material.diffuse[1];
-                    vertex.b = material.diffuse[2];
-                }
-
-                vertices.push_back(vertex);
+        std::vector<MeshObject*> objects;
+        if (!this->loadObjFromBundle(bundle, _filename, objects)) {
+            std::vector<Vertex> vertices;
+            size_t shapeCount = 0;
+            if (!MeshLoader::parseObj(_filename, vertices, shapeCount)) {
+                continue;
+            }
+            for (size_t i = 0; i < shapeCount; i++) {
+                objects.push_back(new OBJObject(this->shader, vertices));
             }
-        }
-
-        if (!err.empty()) {
-            CubeLog::info("MeshLoader: " + err);
-        }
-        CubeLog::info("MeshLoader: Loaded " + std::to_string(shapes.size()) + " shapes from obj file: " + _filename);
-        for (auto shape : shapes) {
-            objects.push_back(new OBJObject(this->shader, vertices));
         }
         CubeLog::info("MeshLoader: Loaded " + std::to_string(objects.size()) + " objects from obj file: " + _filename);
         this->collections.push_back(new ObjectCollection());
@@ -203,13 +154,135 @@ std::vector<std::string> MeshLoader::getFileNames()
     return names;
 }
 
+/**
+ * @brief Parse an OBJ file (and its materials) into one triangle list
+ *
+ * @param path - The .obj file
+ * @param vertices - Receives the vertices of every shape, in file order
+ * @param shapeCount - Receives the number of shapes in the file
+ * @return true if the file was parsed
+ */
+bool MeshLoader::parseObj(const std::string& path, std::vector<Vertex>& vertices, size_t& shapeCount)
+{
+    tinyobj::attrib_t attrib;
+    std::vector<tinyobj::shape_t> shapes;
+    std::vector<tinyobj::material_t> mats;
+    std::string warn, err;
+    std::map<int, tinyobj::material_t> materials;
+
+    // Load the OBJ file and its materials
+    bool success = tinyobj::LoadObj(&attrib, &shapes, &mats, &warn, &err, path.c_str(), nullptr, true);
+
+    if (!warn.empty()) {
+        CubeLog::warning("MeshLoader: " + warn);
+    }
+
+    if (!err.empty()) {
+        CubeLog::error("MeshLoader: Failed to load obj file: " + path);
+        CubeLog::error(err);
+        return false;
+    }
+
+    if (!success) {
+        CubeLog::error("MeshLoader: Failed to load obj file: " + path);
+        return false;
+    }
+
+    // Store materials in a map for easy access
+    for (size_t i = 0; i < mats.size(); ++i) {
+        materials[i] = mats[i];
+    }
+
+    // Extract vertex positions and colors from the shapes
+    for (const auto& shape : shapes) {
+        for (size_t f = 0; f < shape.mesh.indices.size(); f++) {
+            const tinyobj::index_t& index = shape.mesh.indices[f];
+            Vertex vertex = {
+                attrib.vertices[3 * index.vertex_index + 2],
+                attrib.vertices[3 * index.vertex_index + 1],
+                attrib.vertices[3 * index.vertex_index + 0],
+                1.0f, 1.0f, 1.0f // Default white color if no material
+            };
+
+            // Get the material ID associated with the face
+            int material_id = shape.mesh.material_ids[f / 3]; // Assumes triangles (3 vertices per face)
+
+            // Check if the material exists
+            if (materials.count(material_id) > 0) {
+                tinyobj::material_t material = materials[material_id];
+                // Assign diffuse color from the material
+                vertex.r = material.diffuse[0];
+                vertex.g = material.diffuse[1];
+                vertex.b = material.diffuse[2];
+            }
+
+            vertices.push_back(vertex);
+        }
+    }
+
+    if (!err.empty()) {
+        CubeLog::info("MeshLoader: " + err);
+    }
+    CubeLog::info("MeshLoader: Loaded " + std::to_string(shapes.size()) + " shapes from obj file: " + path);
+    shapeCount = shapes.size();
+    return true;
+}
+
+bool MeshLoader::loadObjFromBundle(const MeshBundle& bundle, const std::string& path, std::vector<MeshObject*>& objects)
+{
+    const MeshBundleEntry* entry = bundle.findFresh(path, MeshBundleEntryKind::OBJ_MESH);
+    MeshBundleObjView view;
+    if (!entry || !bundle.objMesh(*entry, view)) {
+        return false;
+    }
+    const glm::vec3 center(view.header->center[0], view.header->center[1], view.header->center[2]);
+    for (uint32_t i = 0; i < view.header->shapeCount; i++) {
+        objects.push_back(new OBJObject(this->shader, view.vertices, view.indices, center, view.header->width));
+    }
+    CubeLog::info("MeshLoader: Loaded obj file from bundle: " + path);
+    return true;
+}
+
+bool MeshLoader::loadMeshFromBundle(const MeshBundle& bundle, const std::string& path, std::vector<MeshObject*>& objects)
+{
+    const MeshBundleEntry* entry = bundle.findFresh(path, MeshBundleEntryKind::CUBE_MESH);
+    std::span<const MeshBundleCube> cubes;
+    if (!entry || !bundle.cubes(*entry, cubes)) {
+        return false;
+    }
+    for (const auto& cube : cubes) {
+        objects.push_back(new Cube(this->shader));
+        objects.back()->translate(glm::vec3(cube.x, cube.y, cube.z));
+        objects.back()->uniformScale(0.5f * cube.scale);
+    }
+    CubeLog::info("MeshLoader: Loaded " + std::to_string(cubes.size()) + " cubes from bundle: " + path);
+    return true;
+}
+
 std::vector<MeshObject*> MeshLoader::loadMesh(const std::string& path)
 {
     std::vector<MeshObject*> objects;
+    for (const auto& cube : MeshLoader::parseCubes(path)) {
+        objects.push_back(new Cube(this->shader));
+        objects.back()->translate(glm::vec3(cube.x, cube.y, cube.z));
+        objects.back()->uniformScale(0.5f * cube.w);
+    }
+    return objects;
+}
+
+/**
+ * @brief Parse a .mesh file into cube placements
+ *
+ * @param path - The .mesh file
+ * @return std::vector<glm::vec4> - x, y, z of each cube, already offset and scaled, and the scale in w
+ */
+std::vector<glm::vec4> MeshLoader::parseCubes(const std::string& path)
+{
+    std::vector<glm::vec4> cubes;
     std::ifstream file(path);
     if (!file.is_open()) {
         CubeLog::info("MeshLoader: Failed to open file: " + path);
-        return objects;
+        return cubes;
     }
     float scale = 1.0f;
     std::string line;
@@ -256,9 +329,7 @@ std::vector<MeshObject*> MeshLoader::loadMesh(const std::string& path)
                 x *= scale;
                 y *= scale;
                 z *= scale;
-                objects.push_back(new Cube(this->shader));
-                objects.at(objects.size() - 1)->translate(glm::vec3(x, y, z));
-                objects.at(objects.size() - 1)->uniformScale(0.5f * scale);
+                cubes.push_back(glm::vec4(x, y, z, scale));
                 count++;
             }
             CubeLog::info("MeshLoader: Loaded " + std::to_string(count) + " cubes");
@@ -314,7 +385,7 @@ std::vector<MeshObject*> MeshLoader::loadMesh(const std::string& path)
             }
         }
     }
-    return objects;
+    return cubes;
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -370,9 +441,14 @@ std::vector<std::string> AnimationLoader::getFileNames()
 void AnimationLoader::loadAnimations(std::vector<std::string> fileNames)
 {
     std::vector<Animation> animations;
+    MeshBundle bundle(MeshBundle::pathFor(this->folderName));
     for (auto filename : fileNames) {
         CubeLog::info("AnimationLoader: Loading animation file: " + filename);
-        Animation animation = this->loadAnimation(filename);
+        Animation animation;
+        const MeshBundleEntry* entry = bundle.findFresh(filename, MeshBundleEntryKind::ANIMATION);
+        if (!entry || !bundle.animation(*entry, animation)) {
+            animation = AnimationLoader::loadAnimation(filename);
+        }
         animationsMap[animation.name] = animation;
     }
 }
@@ -536,11 +612,11 @@ AnimationKeyframe loadKeyframe(nlohmann::json keyframe)
         throw AnimationLoaderException("Keyframe missing point");
     }
     newKeyFrame.point = point;
-    static const std::unordered_map<std::string, std::function<double(double)>> easingFunctions = {
-        { "linear", [](double t) { return t; } },
-        { "easeIn", [](double t) { return t * t; } },
-        { "easeOut", [](double t) { return t * (2 - t); } },
-        { "easeInOut", [](double t) { return 0.5f * (1 - cos(M_PI * t)); } },
+    static const std::unordered_map<std::string, Animations::AnimationEasing> nameToEasing = {
+        { "linear", Animations::AnimationEasing::LINEAR },
+        { "easeIn", Animations::AnimationEasing::EASE_IN },
+        { "easeOut", Animations::AnimationEasing::EASE_OUT },
+        { "easeInOut", Animations::AnimationEasing::EASE_IN_OUT },
     };
     std::string easing;
     try {
@@ -548,15 +624,33 @@ AnimationKeyframe loadKeyframe(nlohmann::json keyframe)
     } catch (nlohmann::json::exception& e) {
         throw AnimationLoaderException("Keyframe missing easing");
     }
-    auto easingFunction = easingFunctions.find(easing);
-    if (easingFunction == easingFunctions.end()) {
-        newKeyFrame.easingFunction = [](double t) { return t; }; // default to linear
-    } else {
-        newKeyFrame.easingFunction = easingFunction->second;
-    }
+    auto easingIt = nameToEasing.find(easing);
+    newKeyFrame.easing = easingIt == nameToEasing.end() ? Animations::AnimationEasing::LINEAR : easingIt->second; // default to linear
+    newKeyFrame.easingFunction = easingFunctionFor(newKeyFrame.easing);
     return newKeyFrame;
 }
 
+/**
+ * @brief Get the curve for an easing id
+ *
+ * @param easing - The easing id stored in the keyframe
+ * @return std::function<double(double)> - Maps normalized time to eased progress
+ */
+std::function<double(double)> easingFunctionFor(Animations::AnimationEasing easing)
+{
+    switch (easing) {
+    case Animations::AnimationEasing::EASE_IN:
+        return [](double t) { return t * t; };
+    case Animations::AnimationEasing::EASE_OUT:
+        return [](double t) { return t * (2 - t); };
+    case Animations::AnimationEasing::EASE_IN_OUT:
+        return [](double t) { return 0.5f * (1 - cos(M_PI * t)); };
+    case Animations::AnimationEasing::LINEAR:
+    default:
+        return [](double t) { return t; };
+    }
+}
+
 /**
  * @brief Get the names of all loaded animations
  *
@@ -736,8 +830,13 @@ std::vector<std::string> ExpressionLoader::getFileNames()
 
 void ExpressionLoader::loadExpressions(std::vector<std::string> fileNames)
 {
+    MeshBundle bundle(MeshBundle::pathFor(this->folderName));
     for (auto filename : fileNames) {
-        ExpressionDefinition expression = loadExpression(filename);
+        ExpressionDefinition expression;
+        const MeshBundleEntry* entry = bundle.findFresh(filename, MeshBundleEntryKind::EXPRESSION);
+        if (!entry || !bundle.expression(*entry, expression)) {
+            expression = ExpressionLoader::loadExpression(filename);
+        }
         expressionsMap[expression.name] = expression;
     }
 }
@@ -50,6 +50,8 @@ SOFTWARE.
 #include <string>
 #include <vector>
 
+class MeshBundle;
+
 struct ObjectCollection {
     std::vector<MeshObject*> objects;
     std::string name;
@@ -58,6 +60,8 @@ struct ObjectCollection {
 class MeshLoader {
 private:
     std::string folderName;
+    bool loadObjFromBundle(const MeshBundle& bundle, const std::string& path, std::vector<MeshObject*>& objects);
+    bool loadMeshFromBundle(const MeshBundle& bundle, const std::string& path, std::vector<MeshObject*>& objects);
 
 public:
     std::vector<ObjectCollection*> collections;
@@ -68,6 +72,8 @@ public:
     std::vector<std::string> getFileNames();
     std::vector<MeshObject*> getObjects();
     std::vector<ObjectCollection*> getCollections();
+    static bool parseObj(const std::string& path, std::vector<Vertex>& vertices, size_t& shapeCount);
+    static std::vector<glm::vec4> parseCubes(const std::string& path);
 };
 
 namespace Expressions {
@@ -137,6 +143,13 @@ enum class AnimationType {
     RETURN_HOME, // uses type, and time
     NOP // no operation
 };
+
+enum class AnimationEasing : uint32_t {
+    LINEAR,
+    EASE_IN,
+    EASE_OUT,
+    EASE_IN_OUT
+};
 }
 
 struct AnimationKeyframe {
@@ -144,6 +157,7 @@ struct AnimationKeyframe {
     float value;
     unsigned int timeStart; // in frames
     unsigned int timeEnd; // in frames
+    Animations::AnimationEasing easing = Animations::AnimationEasing::LINEAR;
     std::function<double(double)> easingFunction;
     glm::vec3 axis;
     glm::vec3 point; // relative to the object's center
@@ -160,10 +174,10 @@ private:
     std::map<Animations::AnimationNames_enum, Animation> animationsMap;
     std::vector<std::string> getFileNames();
     void loadAnimations(std::vector<std::string> fileNames);
-    Animation loadAnimation(const std::string& fileName);
     std::string folderName;
 
 public:
+    static Animation loadAnimation(const std::string& fileName);
     AnimationLoader(const std::string& folderName, std::vector<std::string> animationFileNames);
     ~AnimationLoader();
     std::vector<Animation> getAnimationsVector();
@@ -196,10 +210,10 @@ private:
     std::map<Expressions::ExpressionNames_enum, ExpressionDefinition> expressionsMap;
     std::vector<std::string> getFileNames();
     void loadExpressions(std::vector<std::string> fileNames);
-    ExpressionDefinition loadExpression(const std::string& fileName);
     std::string folderName;
 
 public:
+    static ExpressionDefinition loadExpression(const std::string& fileName);
     ExpressionLoader(const std::string& folderName, std::vector<std::string> expressionFileNames);
     ~ExpressionLoader();
     std::vector<ExpressionDefinition> getExpressionsVector();
@@ -209,5 +223,6 @@ public:
 };
 
 AnimationKeyframe loadKeyframe(nlohmann::json keyframe);
+std::function<double(double)> easingFunctionFor(Animations::AnimationEasing easing);
 
 #endif // MESHLOADER_H
\ No newline at end of file
@@ -0,0 +1,179 @@
+/*
+██████╗ ██████╗ ██╗███╗   ███╗██╗████████╗██╗██╗   ██╗███████╗██████╗  █████╗ ████████╗ ██████╗██╗  ██╗    ██████╗██████╗ ██████╗
+██╔══██╗██╔══██╗██║████╗ ████║██║╚══██╔══╝██║██║   ██║██╔════╝██╔══██╗██╔══██╗╚══██╔══╝██╔════╝██║  ██║   ██╔════╝██╔══██╗██╔══██╗
+██████╔╝██████╔╝██║██╔████╔██║██║   ██║   ██║██║   ██║█████╗  ██████╔╝███████║   ██║   ██║     ███████║   ██║     ██████╔╝██████╔╝
+██╔═══╝ ██╔══██╗██║██║╚██╔╝██║██║   ██║   ██║╚██╗ ██╔╝██╔══╝  ██╔══██╗██╔══██║   ██║   ██║     ██╔══██║   ██║     ██╔═══╝ ██╔═══╝
+██║     ██║  ██║██║██║ ╚═╝ ██║██║   ██║   ██║ ╚████╔╝ ███████╗██████╔╝██║  ██║   ██║   ╚██████╗██║  ██║██╗╚██████╗██║     ██║
+╚═╝     ╚═╝  ╚═╝╚═╝╚═╝     ╚═╝╚═╝   ╚═╝   ╚═╝  ╚═══╝  ╚══════╝╚═════╝ ╚═╝  ╚═╝   ╚═╝    ╚═════╝╚═╝  ╚═╝╚═╝ ╚═════╝╚═╝     ╚═╝
+*/
+
+/*
+MIT License
+
+Copyright (c) 2026 A-McD Technology LLC
+*/
+
+#include "primitiveBatch.h"
+#include <atomic>
+
+namespace {
+
+std::atomic<uint64_t> drawCalls { 0 };
+
+Vertex transformed(const glm::mat4& model, const Vertex& vertex)
+{
+    const glm::vec4 p = model * glm::vec4(vertex.x, vertex.y, vertex.z, 1.0f);
+    // Batched vertices are drawn with an identity model, so a projective model has to be resolved
+    // here; dividing by w gives the same point the shader would have produced.
+    const float w = p.w != 0.0f ? p.w : 1.0f;
+    return { p.x / w, p.y / w, p.z / w, vertex.r, vertex.g, vertex.b };
+}
+
+} // namespace
+
+PrimitiveBatch& PrimitiveBatch::shared()
+{
+    static PrimitiveBatch batch;
+    return batch;
+}
+
+PrimitiveBatch::Scope::Scope()
+{
+    PrimitiveBatch& batch = PrimitiveBatch::shared();
+    this->active = batch.batching;
+    if (this->active) {
+        batch.depth++;
+    }
+}
+
+PrimitiveBatch::Scope::~Scope()
+{
+    if (!this->active) {
+        return;
+    }
+    PrimitiveBatch& batch = PrimitiveBatch::shared();
+    if (--batch.depth == 0) {
+        batch.flush();
+    }
+}
+
+bool PrimitiveBatch::appendAsList(GLenum mode, const glm::mat4& model, const std::vector<Vertex>& vertices, std::vector<Vertex>& triangles, std::vector<Vertex>& lines)
+{
+    const size_t n = vertices.size();
+    switch (mode) {
+    case GL_TRIANGLES:
+        for (size_t i = 0; i + 2 < n; i += 3) {
+            triangles.push_back(transformed(model, vertices[i]));
+            triangles.push_back(transformed(model, vertices[i + 1]));
+            triangles.push_back(transformed(model, vertices[i + 2]));
+        }
+        return true;
+    case GL_TRIANGLE_FAN:
+        for (size_t i = 1; i + 1 < n; i++) {
+            triangles.push_back(transformed(model, vertices[0]));
+            triangles.push_back(transformed(model, vertices[i]));
+            triangles.push_back(transformed(model, vertices[i + 1]));
+        }
+        return true;
+    case GL_TRIANGLE_STRIP:
+        // Every other triangle of a strip is wound the other way; swap its first two vertices so the
+        // list keeps the strip's facing (GL_CULL_FACE is on).
+        for (size_t i = 0; i + 2 < n; i++) {
+            const bool odd = (i % 2) == 1;
+            triangles.push_back(transformed(model, vertices[odd ? i + 1 : i]));
+            triangles.push_back(transformed(model, vertices[odd ? i : i + 1]));
+            triangles.push_back(transformed(model, vertices[i + 2]));
+        }
+        return true;
+    case GL_LINES:
+        for (size_t i = 0; i + 1 < n; i += 2) {
+            lines.push_back(transformed(model, vertices[i]));
+            lines.push_back(transformed(model, vertices[i + 1]));
+        }
+        return true;
+    case GL_LINE_STRIP:
+    case GL_LINE_LOOP:
+        for (size_t i = 0; i + 1 < n; i++) {
+            lines.push_back(transformed(model, vertices[i]));
+            lines.push_back(transformed(model, vertices[i + 1]));
+        }
+        if (mode == GL_LINE_LOOP && n > 2) {
+            lines.push_back(transformed(model, vertices[n - 1]));
+            lines.push_back(transformed(model, vertices[0]));
+        }
+        return true;
+    default:
+        return false;
+    }
+}
+
+bool PrimitiveBatch::add(Shader* shader, GLenum mode, const glm::mat4& model, const std::vector<Vertex>& vertices)
+{
+    if (this->shader != shader) {
+        flush();
+        this->shader = shader;
+    }
+    return PrimitiveBatch::appendAsList(mode, model, vertices, this->triangles, this->lines);
+}
+
+/**
+ * @brief Draw everything queued so far: one GL_TRIANGLES and one GL_LINES call from a single buffer.
+ */
+void PrimitiveBatch::flush()
+{
+    if (this->triangles.empty() && this->lines.empty()) {
+        return;
+    }
+    const GLsizei triangleCount = static_cast<GLsizei>(this->triangles.size());
+    const GLsizei lineCount = static_cast<GLsizei>(this->lines.size());
+    this->uploading.swap(this->triangles);
+    this->uploading.insert(this->uploading.end(), this->lines.begin(), this->lines.end());
+    this->triangles.clear();
+    this->lines.clear();
+
+    if (this->VAO == 0) {
+        glGenVertexArrays(1, &this->VAO);
+        glGenBuffers(1, &this->VBO);
+        glBindVertexArray(this->VAO);
+        glBindBuffer(GL_ARRAY_BUFFER, this->VBO);
+        glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)(3 * sizeof(float)));
+        glEnableVertexAttribArray(1);
+    } else {
+        glBindVertexArray(this->VAO);
+        glBindBuffer(GL_ARRAY_BUFFER, this->VBO);
+    }
+    // Orphan and refill: the buffer only grows, so steady frames just stream into the same store.
+    const size_t bytes = this->uploading.size() * sizeof(Vertex);
+    if (bytes > this->capacity) {
+        this->capacity = bytes;
+    }
+    glBufferData(GL_ARRAY_BUFFER, this->capacity, nullptr, GL_STREAM_DRAW);
+    glBufferSubData(GL_ARRAY_BUFFER, 0, bytes, this->uploading.data());
+
+    // Vertices are already in the scene camera's world space.
+    this->shader->use();
+    this->shader->setMat4(ShaderUniform::MODEL, glm::mat4(1.0f));
+    if (triangleCount > 0) {
+        glDrawArrays(GL_TRIANGLES, 0, triangleCount);
+        drawCalls.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (lineCount > 0) {
+        glDrawArrays(GL_LINES, triangleCount, lineCount);
+        drawCalls.fetch_add(1, std::memory_order_relaxed);
+    }
+    glBindVertexArray(0);
+    this->uploading.clear();
+}
+
+void PrimitiveBatch::setEnabled(bool enabled)
+{
+    flush();
+    this->batching = enabled;
+}
+
+uint64_t PrimitiveBatch::totalDrawCalls()
+{
+    return drawCalls.load(std::memory_order_relaxed);
+}
@@ -0,0 +1,95 @@
+/*
+██████╗ ██████╗ ██╗███╗   ███╗██╗████████╗██╗██╗   ██╗███████╗██████╗  █████╗ ████████╗ ██████╗██╗  ██╗   ██╗  ██╗
+██╔══██╗██╔══██╗██║████╗ ████║██║╚══██╔══╝██║██║   ██║██╔════╝██╔══██╗██╔══██╗╚══██╔══╝██╔════╝██║  ██║   ██║  ██║
+██████╔╝██████╔╝██║██╔████╔██║██║   ██║   ██║██║   ██║█████╗  ██████╔╝███████║   ██║   ██║     ███████║   ███████║
+██╔═══╝ ██╔══██╗██║██║╚██╔╝██║██║   ██║   ██║╚██╗ ██╔╝██╔══╝  ██╔══██╗██╔══██║   ██║   ██║     ██╔══██║   ██╔══██║
+██║     ██║  ██║██║██║ ╚═╝ ██║██║   ██║   ██║ ╚████╔╝ ███████╗██████╔╝██║  ██║   ██║   ╚██████╗██║  ██║██╗██║  ██║
+╚═╝     ╚═╝  ╚═╝╚═╝╚═╝     ╚═╝╚═╝   ╚═╝   ╚═╝  ╚═══╝  ╚══════╝╚═════╝ ╚═╝  ╚═╝   ╚═╝    ╚═════╝╚═╝  ╚═╝╚═╝╚═╝  ╚═╝
+*/
+
+/*
+MIT License
+
+Copyright (c) 2026 A-McD Technology LLC
+*/
+
+#pragma once
+#ifndef PRIMITIVEBATCH_H
+#define PRIMITIVEBATCH_H
+
+#include "GL/glew.h"
+#include "../objects.h"
+#include "../shader.h"
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+/*
+
+Streams the flat-coloured UI primitives (M_Rect, M_PartCircle, M_Line, M_Arc) into one shared vertex
+buffer, so a whole menu page of chrome costs a couple of draw calls instead of one or two per piece.
+
+The MeshObject API is unchanged. While a PrimitiveBatch::Scope is open on the render thread, those
+objects' draw() hands their vertices to the batch, already transformed by their model matrix, instead
+of drawing them. Fans and strips become triangle lists and loops and strips become line lists, so
+everything queued for one program goes out as one GL_TRIANGLES and one GL_LINES draw.
+
+The queue is flushed when the outermost scope closes and whenever any Shader is bound (Shader::use()),
+so text, textures and stencil masks drawn in between still land on top of what was queued before them.
+Within one run, fills are drawn before outlines; scopes are meant for chrome whose outlines sit on top
+of its fills. State changed with raw GL calls (depth test, stencil funcs) is not tracked, so close the
+scope before changing it.
+
+All methods must be called on the render thread.
+
+*/
+
+class PrimitiveBatch {
+public:
+    static PrimitiveBatch& shared();
+
+    // Queues eligible draws until the outermost scope closes. Scopes nest.
+    class Scope {
+    public:
+        Scope();
+        ~Scope();
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+    private:
+        bool active;
+    };
+
+    // Whether draw() calls should be queued right now.
+    bool recording() const { return this->depth > 0; }
+    // Queue vertices drawn with mode under model. Returns false (nothing queued) for modes the batch
+    // does not handle.
+    bool add(Shader* shader, GLenum mode, const glm::mat4& model, const std::vector<Vertex>& vertices);
+    void flush();
+    // Turns batching off (scopes become no-ops), for A/B measurements.
+    void setEnabled(bool enabled);
+    bool enabled() const { return this->batching; }
+    // Number of draw calls issued by flush() so far.
+    static uint64_t totalDrawCalls();
+
+    // Convert vertices drawn with mode into a triangle or line list, transformed by model. Returns false
+    // if mode is not a triangle or line topology. No GL.
+    static bool appendAsList(GLenum mode, const glm::mat4& model, const std::vector<Vertex>& vertices, std::vector<Vertex>& triangles, std::vector<Vertex>& lines);
+
+private:
+    PrimitiveBatch() = default;
+
+    unsigned int depth = 0;
+    bool batching = true;
+    Shader* shader = nullptr;
+    std::vector<Vertex> triangles;
+    std::vector<Vertex> lines;
+    // Swapped with the queue on flush so a flush re-entered through Shader::use() sees it empty.
+    std::vector<Vertex> uploading;
+    GLuint VAO = 0;
+    GLuint VBO = 0;
+    size_t capacity = 0;
+};
+
+#endif // PRIMITIVEBATCH_H
@@ -34,96 +34,13 @@ SOFTWARE.
 // TODO: the font is being loaded for each instance of an M_Text object and should be made static so that it only gets loaded once and is shared between all instances of M_Text
 
 #include "shapes.h"
+#include <algorithm>
 #include <iomanip>
+#include <mutex>
 #include <sstream>
 
 namespace {
 
-bool isRenderableTextCodepoint(uint32_t codepoint)
-{
-    if (codepoint == 0 || codepoint == 0xFEFF || codepoint == 0xFFFD) {
-        return false;
-    }
-    if (codepoint < 0x20 || (codepoint >= 0x7F && codepoint <= 0x9F)) {
-        return false;
-    }
-    if ((codepoint >= 0x200B && codepoint <= 0x200F)
-        || (codepoint >= 0x202A && codepoint <= 0x202E)
-        || (codepoint >= 0x2060 && codepoint <= 0x206F)
-        || (codepoint >= 0xFE00 && codepoint <= 0xFE0F)) {
-        return false;
-    }
-    return true;
-}
-
-std::vector<uint32_t> decodeUtf8Codepoints(const std::string& text)
-{
-    std::vector<uint32_t> codepoints;
-    codepoints.reserve(text.size());
-
-    const auto* bytes = reinterpret_cast<const unsigned char*>(text.data());
-    size_t index = 0;
-    while (index < text.size()) {
-        const unsigned char lead = bytes[index];
-        if (lead < 0x80) {
-            codepoints.push_back(static_cast<uint32_t>(lead));
-            ++index;
-            continue;
-        }
-
-        uint32_t codepoint = 0;
-        size_t sequenceLength = 0;
-        uint32_t minValue = 0;
-        if ((lead & 0xE0) == 0xC0) {
-            codepoint = lead & 0x1F;
-            sequenceLength = 2;
-            minValue = 0x80;
-        } else if ((lead & 0xF0) == 0xE0) {
-            codepoint = lead & 0x0F;
-            sequenceLength = 3;
-            minValue = 0x800;
-        } else if ((lead & 0xF8) == 0xF0) {
-            codepoint = lead & 0x07;
-            sequenceLength = 4;
-            minValue = 0x10000;
-        } else {
-            codepoints.push_back(static_cast<uint32_t>('?'));
-            ++index;
-            continue;
-        }
-
-        if (index + sequenceLength > text.size()) {
-            codepoints.push_back(static_cast<uint32_t>('?'));
-            ++index;
-            continue;
-        }
-
-        bool valid = true;
-        for (size_t offset = 1; offset < sequenceLength; ++offset) {
-            const unsigned char continuation = bytes[index + offset];
-            if ((continuation & 0xC0) != 0x80) {
-                valid = false;
-                break;
-            }
-            codepoint = (codepoint << 6) | static_cast<uint32_t>(continuation & 0x3F);
-        }
-
-        if (!valid
-            || codepoint < minValue
-            || codepoint > 0x10FFFF
-            || (codepoint >= 0xD800 && codepoint <= 0xDFFF)) {
-            codepoints.push_back(static_cast<uint32_t>('?'));
-            ++index;
-            continue;
-        }
-
-        codepoints.push_back(codepoint);
-        index += sequenceLength;
-    }
-
-    return codepoints;
-}
-
 std::string formatCodepoint(uint32_t codepoint)
 {
     std::ostringstream stream;
@@ -144,6 +61,10 @@ void checkGLError(const std::string& location)
 FT_Library M_Text::ft;
 FT_Face M_Text::face;
 bool M_Text::faceInitialized = false;
+std::string M_Text::facePath;
+std::atomic<uint64_t> M_Text::selectedFontGeneration { 0 };
+uint64_t M_Text::faceGeneration = 0;
+std::atomic<uint64_t> M_Text::drawCalls { 0 };
 
 M_Text::M_Text(Shader* sh, const std::string& text, float fontSize, glm::vec3 color, glm::vec2 position)
 {
@@ -152,11 +73,19 @@ M_Text::M_Text(Shader* sh, const std::string& text, float fontSize, glm::vec3 co
     this->fontSize = fontSize;
     this->color = color;
     this->position = position;
-    this->projectionMatrix = glm::ortho(0.0f, 720.0f, 0.0f, 720.0f, -1.f, 1.f);
-    this->buildText();
-    GlobalSettings::setSettingCB(GlobalSettings::SettingType::SELECTED_FONT_PATH, [&]() {
-        this->reloadFace = true;
+    this->VAO = 0;
+    this->VBO = 0;
+    this->projectionMatrix = Camera::ui().projection();
+    // One callback for every string rather than one capturing each instance, which would outlive
+    // the strings deleted when a menu is evicted.
+    static std::once_flag fontCallbackRegistered;
+    std::call_once(fontCallbackRegistered, []() {
+        GlobalSettings::setSettingCB(GlobalSettings::SettingType::SELECTED_FONT_PATH, []() {
+            M_Text::selectedFontGeneration++;
+        });
     });
+    this->fontGeneration = M_Text::selectedFontGeneration.load();
+    this->buildText();
     CubeLog::debug("Created Text: " + text);
     CubeLog::debugSilly("Position: " + std::to_string(position.x) + "x" + std::to_string(position.y));
 }
@@ -167,7 +96,8 @@ void M_Text::reloadFont()
     if (M_Text::faceInitialized) {
         FT_Done_Face(M_Text::face);
     }
-    clearGlyphTextures();
+    // Every cached bitmap belongs to the old face.
+    GlyphAtlas::shared().clear();
     this->vertexData.clear();
     this->vertexData.shrink_to_fit();
     this->width = 0;
@@ -184,11 +114,7 @@ void M_Text::buildText()
             CubeLog::error("ERROR::FREETYPE: Could not init FreeType Library");
             return;
         }
-        std::string fontPath = GlobalSettings::getSettingOfType<std::string>(GlobalSettings::SettingType::SELECTED_FONT_PATH);
-        if (!std::filesystem::exists(fontPath)) {
-            CubeLog::error("ERROR::FREETYPE: Font file does not exist");
-            fontPath = "fonts/Roboto/Roboto-Regular.ttf";
-        }
+        const std::string fontPath = TextLayout::fontPath();
         if (FT_New_Face(M_Text::ft, fontPath.c_str(), 0, &M_Text::face)) {
             CubeLog::error("ERROR::FREETYPE: Failed to load font");
             return;
@@ -197,50 +123,90 @@ void M_Text::buildText()
             CubeLog::warning("ERROR::FREETYPE: Failed to select unicode charmap");
         }
         M_Text::faceInitialized = true;
+        M_Text::faceGeneration = M_Text::selectedFontGeneration.load();
+        M_Text::facePath = fontPath;
     }
-    if (FT_Set_Pixel_Sizes(M_Text::face, 0, this->fontSize)) {
+    this->pixelSize = static_cast<int>(this->fontSize);
+
+    this->glyphCodepoints = TextLayout::codepoints(this->text);
+
+    if (this->VAO == 0) {
+        glGenVertexArrays(1, &this->VAO);
+        glGenBuffers(1, &this->VBO);
+        glBindVertexArray(this->VAO);
+        glBindBuffer(GL_ARRAY_BUFFER, this->VBO);
+        glEnableVertexAttribArray(0);
+        glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), 0);
+        glBindVertexArray(0);
+        glBindBuffer(GL_ARRAY_BUFFER, 0);
+        checkGLError("0.6");
+    }
+    this->buildVertices();
+}
+
+// Lays the string out once, relative to its baseline origin, and uploads every quad into the VBO.
+// The position is applied in the vertex shader, so moving the text never touches the buffer.
+void M_Text::buildVertices()
+{
+    GlyphAtlas& atlas = GlyphAtlas::shared();
+    atlas.beginUse();
+    if (FT_Set_Pixel_Sizes(M_Text::face, 0, this->pixelSize)) {
         CubeLog::error("ERROR::FREETYPE: Failed to set pixel size");
     }
-    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-    checkGLError("0.1");
-
-    clearGlyphTextures();
-    this->glyphCodepoints = decodeUtf8Codepoints(this->text);
-    this->glyphCodepoints.erase(
-        std::remove_if(
-            this->glyphCodepoints.begin(),
-            this->glyphCodepoints.end(),
-            [](uint32_t codepoint) {
-                return !isRenderableTextCodepoint(codepoint);
-            }),
-        this->glyphCodepoints.end());
-    this->width = 0.f;
+
+    std::array<std::vector<float>, GLYPH_ATLAS_MAX_PAGES> pageVertices;
+    float pen = 0.f;
+    glm::vec4 extents { 0.f };
+    bool anyBitmap = false;
     for (uint32_t codepoint : this->glyphCodepoints) {
-        if (!loadGlyph(codepoint) && codepoint != static_cast<uint32_t>('?')) {
-            loadGlyph(static_cast<uint32_t>('?'));
+        const AtlasGlyph* glyph = glyphFor(codepoint);
+        if (glyph == nullptr) {
+            continue;
         }
-        const Character* character = findCharacterForCodepoint(codepoint);
-        if (character != nullptr) {
-            this->width += (character->advance >> 6); // Bitshift by 6 to get value in pixels (2^6 = 64)
+        if (glyph->hasBitmap) {
+            const float xpos = pen + glyph->bearing.x;
+            const float ypos = -static_cast<float>(glyph->size.y - glyph->bearing.y);
+            const float w = glyph->size.x;
+            const float h = glyph->size.y;
+            const float quad[6][4] = {
+                // Positions            // Texture Coords
+                { xpos, ypos + h, glyph->uvMin.x, glyph->uvMin.y }, // Top-left
+                { xpos + w, ypos, glyph->uvMax.x, glyph->uvMax.y }, // Bottom-right
+                { xpos, ypos, glyph->uvMin.x, glyph->uvMax.y }, // Bottom-left
+
+                { xpos, ypos + h, glyph->uvMin.x, glyph->uvMin.y }, // Top-left
+                { xpos + w, ypos + h, glyph->uvMax.x, glyph->uvMin.y }, // Top-right
+                { xpos + w, ypos, glyph->uvMax.x, glyph->uvMax.y } // Bottom-right
+            };
+            auto& vertices = pageVertices[glyph->page];
+            vertices.insert(vertices.end(), &quad[0][0], &quad[0][0] + 24);
+            if (!anyBitmap) {
+                extents = { xpos, ypos, xpos + w, ypos + h };
+                anyBitmap = true;
+            }
+            extents = { std::min(extents.x, xpos), std::min(extents.y, ypos), std::max(extents.z, xpos + w), std::max(extents.w, ypos + h) };
         }
+        pen += (glyph->advance >> 6); // Bitshift by 6 to get value in pixels (2^6 = 64)
     }
+    this->width = pen;
+    this->extents = extents;
 
-    glBindTexture(GL_TEXTURE_2D, 0);
-    checkGLError("0.5");
-    glGenVertexArrays(1, &this->VAO);
-    glGenBuffers(1, &this->VBO);
-    glBindVertexArray(this->VAO);
+    std::vector<float> vertices;
+    this->drawRanges.clear();
+    for (size_t page = 0; page < pageVertices.size(); ++page) {
+        if (pageVertices[page].empty()) {
+            continue;
+        }
+        this->drawRanges.push_back({ static_cast<uint16_t>(page),
+            static_cast<GLint>(vertices.size() / 4),
+            static_cast<GLsizei>(pageVertices[page].size() / 4) });
+        vertices.insert(vertices.end(), pageVertices[page].begin(), pageVertices[page].end());
+    }
     glBindBuffer(GL_ARRAY_BUFFER, this->VBO);
-    checkGLError("0.6");
-    glBufferData(GL_ARRAY_BUFFER, sizeof(float) * 6 * 4, NULL, GL_DYNAMIC_DRAW);
-    glEnableVertexAttribArray(0);
-    glVertexAttribPointer(0, 4, GL_FLOAT, GL_FALSE, 4 * sizeof(float), 0);
-    checkGLError("0.7");
+    glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(vertices.size() * sizeof(float)), vertices.empty() ? nullptr : vertices.data(), GL_STATIC_DRAW);
     glBindBuffer(GL_ARRAY_BUFFER, 0);
-    glBindVertexArray(0);
-    // setProjectionMatrix(glm::ortho(0.0f, 720.f, 0.0f, 720.f));
-    checkGLError("0.8");
-    this->reloadFace = false;
+    checkGLError("0.7");
+    this->atlasEpoch = atlas.epoch();
 }
 
 M_Text::~M_Text()
@@ -250,65 +216,79 @@ M_Text::~M_Text()
     // delete all the openGl stuff
     glDeleteVertexArrays(1, &this->VAO);
     glDeleteBuffers(1, &this->VBO);
-    clearGlyphTextures();
     // CubeLog::info("Destroyed Text");
 }
 
 void M_Text::draw()
 {
-    if (this->reloadFace) {
-        reloadFont();
-        this->reloadFace = false;
+    const uint64_t generation = M_Text::selectedFontGeneration.load();
+    if (this->fontGeneration != generation) {
+        // The first string to see a font change reloads the shared face; clearing the atlas makes the
+        // epoch check below rebuild the rest.
+        this->fontGeneration = generation;
+        if (M_Text::faceGeneration != generation) {
+            reloadFont();
+        }
     }
     if (!this->faceInitialized) {
         return;
     }
+    GlyphAtlas& atlas = GlyphAtlas::shared();
+    if (this->atlasEpoch != atlas.epoch()) {
+        // A page this string may use was recycled since the vertices were built.
+        buildVertices();
+    }
+    if (this->drawRanges.empty()) {
+        return;
+    }
     this->shader->use();
-    shader->setVec3("textColor", this->color.x, this->color.y, this->color.z);
-    shader->setMat4("projection", projectionMatrix);
-    shader->setFloat("zindex", 0.0f);
-    shader->setFloat("alpha", 1.0f);
-    shader->setFloat("bg_alpha", 0.0f);
+    shader->setVec3(ShaderUniform::TEXT_COLOR, this->color.x, this->color.y, this->color.z);
+    shader->setMat4(ShaderUniform::LOCAL, Camera::ui().modelFor(projectionMatrix, glm::mat4(1.0f), worldMatrix()));
+    shader->setVec2(ShaderUniform::OFFSET, this->position.x, this->position.y);
+    shader->setFloat(ShaderUniform::ZINDEX, 0.0f);
+    shader->setFloat(ShaderUniform::ALPHA, 1.0f);
+    shader->setFloat(ShaderUniform::BG_ALPHA, 0.0f);
     glActiveTexture(GL_TEXTURE0);
     glBindVertexArray(this->VAO);
-    float xTemp = this->position.x;
-    for (uint32_t codepoint : this->glyphCodepoints) {
-        const Character* character = findCharacterForCodepoint(codepoint);
-        if (character == nullptr) {
-            continue;
-        }
-        const Character& ch = *character;
-        float xpos = xTemp + ch.bearing.x;
-        float ypos = this->position.y - (ch.size.y - ch.bearing.y);
-        float w = ch.size.x;
-        float h = ch.size.y;
-        if (ch.textureID == 0 || w <= 0.0f || h <= 0.0f) {
-            xTemp += (ch.advance >> 6);
-            continue;
-        }
-        float vertices[6][4] = {
-            // Positions            // Texture Coords
-            { xpos, ypos + h, 0.0f, 0.0f }, // Top-left
-            { xpos + w, ypos, 1.0f, 1.0f }, // Bottom-right
-            { xpos, ypos, 0.0f, 1.0f }, // Bottom-left
-
-            { xpos, ypos + h, 0.0f, 0.0f }, // Top-left
-            { xpos + w, ypos + h, 1.0f, 0.0f }, // Top-right
-            { xpos + w, ypos, 1.0f, 1.0f } // Bottom-right
-        };
-        glBindTexture(GL_TEXTURE_2D, ch.textureID);
-        glBindBuffer(GL_ARRAY_BUFFER, this->VBO);
-        glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(vertices), vertices);
-        glBindBuffer(GL_ARRAY_BUFFER, 0);
-        glDrawArrays(GL_TRIANGLES, 0, 6);
-        xTemp += (ch.advance >> 6);
+    for (const auto& range : this->drawRanges) {
+        glBindTexture(GL_TEXTURE_2D, atlas.pageTexture(range.page));
+        glDrawArrays(GL_TRIANGLES, range.first, range.count);
     }
+    M_Text::drawCalls.fetch_add(this->drawRanges.size(), std::memory_order_relaxed);
     glBindVertexArray(0);
     glBindTexture(GL_TEXTURE_2D, 0);
 }
 
+/**
+ * @brief Copy glyphs rendered off-thread by TextLayout into the atlas so strings built from that
+ * layout never rasterize on the render thread. Skipped if the layout was made for a font other than
+ * the loaded one. Render thread only.
+ *
+ * @param layout a finished layout
+ */
+void M_Text::preload(const TextLayout::Result& layout)
+{
+    if (!M_Text::faceInitialized || M_Text::faceGeneration != M_Text::selectedFontGeneration.load() || layout.fontPath != M_Text::facePath) {
+        return;
+    }
+    GlyphAtlas& atlas = GlyphAtlas::shared();
+    atlas.beginUse();
+    for (const auto& glyph : layout.glyphs) {
+        if (atlas.find(glyph.codepoint, layout.pixelSize) != nullptr) {
+            continue;
+        }
+        atlas.insert(glyph.codepoint, layout.pixelSize, glyph.width, glyph.height, glyph.width, glyph.bitmap.data(), glyph.bearing, glyph.advance);
+    }
+}
+
+uint64_t M_Text::totalDrawCalls()
+{
+    return M_Text::drawCalls.load(std::memory_order_relaxed);
+}
+
 void M_Text::setProjectionMatrix(glm::mat4 projectionMatrix)
 {
+    RenderDamage::invalidate();
     this->projectionMatrix = projectionMatrix;
 }
 
@@ -329,8 +309,10 @@ void M_Text::setModelMatrix(glm::mat4 modelMatrix)
 
 void M_Text::translate(glm::vec3 translation)
 {
+    this->damage();
     this->position.x += translation.x;
     this->position.y += translation.y;
+    this->damage();
 }
 
 void M_Text::rotate(float angle, glm::vec3 axis)
@@ -340,6 +322,7 @@ void M_Text::rotate(float angle, glm::vec3 axis)
 
 void M_Text::scale(glm::vec3 scale)
 {
+    RenderDamage::invalidate();
     // normalize scale
     glm::vec3 normalizedScale = glm::normalize(scale);
     // get the average of the scale
@@ -350,17 +333,20 @@ void M_Text::scale(glm::vec3 scale)
 
 void M_Text::uniformScale(float scale)
 {
+    RenderDamage::invalidate();
     this->fontSize *= scale;
 }
 
 void M_Text::rotateAbout(float angle, glm::vec3 point)
 {
+    RenderDamage::invalidate();
     glm::vec3 axis = point - glm::vec3(this->position.x, this->position.y, 0.f);
     rotateAbout(angle, axis, point);
 }
 
 void M_Text::rotateAbout(float angle, glm::vec3 axis, glm::vec3 point)
 {
+    RenderDamage::invalidate();
     glm::mat4 tempMat = glm::mat4(1.0f); // Start with an identity matrix
     tempMat = glm::translate(tempMat, point);
     tempMat = glm::rotate(tempMat, glm::radians(angle), glm::normalize(axis));
@@ -382,20 +368,34 @@ std::vector<Vertex> M_Text::getVertices()
     return vertices;
 }
 
+size_t M_Text::vertexBytes() const
+{
+    size_t vertices = 0;
+    for (const auto& range : this->drawRanges) {
+        vertices += range.count;
+    }
+    return vertices * 4 * sizeof(float);
+}
+
 void M_Text::setPosition(glm::vec2 position)
 {
+    this->damage();
     this->position = position;
+    this->damage();
 }
 
 void M_Text::setText(const std::string& text)
 {
+    this->damage();
     this->text = text;
     this->buildText();
+    this->damage();
 }
 
 void M_Text::setColor(glm::vec3 color)
 {
     this->color = color;
+    this->damage();
 }
 
 float M_Text::getWidth()
@@ -405,7 +405,7 @@ float M_Text::getWidth()
 
 void M_Text::capturePosition()
 {
-    this->capturedModelMatrix = this->modelMatrix;
+    this->capturedModelMatrix = localMatrix();
     this->capturedViewMatrix = this->viewMatrix;
     this->capturedProjectionMatrix = this->projectionMatrix;
     this->capturedPosition = this->position;
@@ -413,102 +413,88 @@ void M_Text::capturePosition()
 
 void M_Text::restorePosition()
 {
-    this->modelMatrix = this->capturedModelMatrix;
+    this->damage();
+    setLocalMatrix(this->capturedModelMatrix);
     this->viewMatrix = this->capturedViewMatrix;
     this->projectionMatrix = this->capturedProjectionMatrix;
     this->position = this->capturedPosition;
+    this->damage();
 }
 
 void M_Text::setVisibility(bool visible)
 {
+    if (this->visible == visible) {
+        return;
+    }
+    this->visible = true;
+    this->damage();
     this->visible = visible;
 }
 
+/**
+ * @brief Report the area this text currently covers as damaged. Text is drawn with the projection,
+ * the offset and any parent scroll node, so its screen bounds are the glyph extents shifted by the
+ * position and the world translation.
+ */
+void M_Text::damage()
+{
+    if (!this->visible || this->extents.z <= this->extents.x) {
+        return;
+    }
+    const glm::mat4 world = worldMatrix();
+    const float x = this->position.x + world[3].x;
+    const float y = this->position.y + world[3].y;
+    RenderDamage::invalidate(DamageRect::covering(x + this->extents.x, y + this->extents.y,
+        x + this->extents.z, y + this->extents.w));
+}
+
 void M_Text::getRestorePositionDiff(glm::mat4* modelMatrix, glm::mat4* viewMatrix, glm::mat4* projectionMatrix)
 {
     this->mutex.lock();
-    *modelMatrix = this->capturedModelMatrix - this->modelMatrix;
+    *modelMatrix = this->capturedModelMatrix - localMatrix();
     *viewMatrix = this->capturedViewMatrix - this->viewMatrix;
     *projectionMatrix = this->capturedProjectionMatrix - this->projectionMatrix;
     this->mutex.unlock();
 }
 
-bool M_Text::loadGlyph(uint32_t codepoint)
+const AtlasGlyph* M_Text::glyphFor(uint32_t codepoint)
 {
-    if (!M_Text::faceInitialized) {
-        return false;
-    }
-    if (this->characters.find(codepoint) != this->characters.end()) {
-        return true;
+    if (const AtlasGlyph* glyph = GlyphAtlas::shared().find(codepoint, this->pixelSize)) {
+        return glyph;
     }
-    if (FT_Load_Char(M_Text::face, static_cast<FT_ULong>(codepoint), FT_LOAD_RENDER)) {
-        CubeLog::warning("ERROR::FREETYPE: Failed to load glyph for codepoint " + formatCodepoint(codepoint));
-        return false;
-    }
-
-    GLuint texture = 0;
-    const auto width = static_cast<int>(M_Text::face->glyph->bitmap.width);
-    const auto height = static_cast<int>(M_Text::face->glyph->bitmap.rows);
-    if (width > 0 && height > 0 && M_Text::face->glyph->bitmap.buffer != nullptr) {
-        glGenTextures(1, &texture);
-        checkGLError("0.2");
-        glBindTexture(GL_TEXTURE_2D, texture);
-        checkGLError("0.3");
-        glTexImage2D(
-            GL_TEXTURE_2D,
-            0,
-            GL_RED,
-            width,
-            height,
-            0,
-            GL_RED,
-            GL_UNSIGNED_BYTE,
-            M_Text::face->glyph->bitmap.buffer);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-        checkGLError("0.4");
-    }
-
-    Character newCharacter = {
-        texture,
-        glm::ivec2(width, height),
-        glm::ivec2(M_Text::face->glyph->bitmap_left, M_Text::face->glyph->bitmap_top),
-        M_Text::face->glyph->advance.x
-    };
-    this->characters.emplace(codepoint, newCharacter);
-    return true;
-}
-
-const Character* M_Text::findCharacterForCodepoint(uint32_t codepoint) const
-{
-    const auto it = this->characters.find(codepoint);
-    if (it != this->characters.end()) {
-        return &it->second;
+    if (const AtlasGlyph* glyph = rasterizeGlyph(codepoint)) {
+        return glyph;
     }
-    const auto fallback = this->characters.find(static_cast<uint32_t>('?'));
-    if (fallback != this->characters.end()) {
-        return &fallback->second;
+    if (codepoint != static_cast<uint32_t>('?')) {
+        return glyphFor(static_cast<uint32_t>('?'));
     }
     return nullptr;
 }
 
-void M_Text::clearGlyphTextures()
+const AtlasGlyph* M_Text::rasterizeGlyph(uint32_t codepoint)
 {
-    for (auto& [codepoint, character] : this->characters) {
-        (void)codepoint;
-        if (character.textureID != 0) {
-            glDeleteTextures(1, &character.textureID);
-        }
+    if (!M_Text::faceInitialized) {
+        return nullptr;
     }
-    this->characters.clear();
-    this->glyphCodepoints.clear();
+    if (FT_Load_Char(M_Text::face, static_cast<FT_ULong>(codepoint), FT_LOAD_RENDER)) {
+        CubeLog::warning("ERROR::FREETYPE: Failed to load glyph for codepoint " + formatCodepoint(codepoint));
+        return nullptr;
+    }
+    const auto& glyph = *M_Text::face->glyph;
+    return GlyphAtlas::shared().insert(
+        codepoint,
+        this->pixelSize,
+        static_cast<int>(glyph.bitmap.width),
+        static_cast<int>(glyph.bitmap.rows),
+        glyph.bitmap.pitch,
+        glyph.bitmap.buffer,
+        glm::ivec2(glyph.bitmap_left, glyph.bitmap_top),
+        glyph.advance.x);
 }
 
 glm::mat4 M_Text::getModelMatrix()
 {
-    return this->modelMatrix;
+    return localMatrix();
 }
 glm::mat4 M_Text::getViewMatrix()
 {
@@ -519,6 +505,14 @@ glm::mat4 M_Text::getProjectionMatrix()
     return this->projectionMatrix;
 }
 
+uint64_t M_Text::drawKey()
+{
+    if (this->drawRanges.empty()) {
+        return DrawList::key(this->shader, 0);
+    }
+    return DrawList::key(this->shader, GlyphAtlas::shared().pageTexture(this->drawRanges.front().page));
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////
 
 M_PartCircle::M_PartCircle(Shader* sh, unsigned int numSegments, float radius, glm::vec3 centerPoint, float startAngle, float endAngle, glm::vec3 fillColor)
@@ -554,8 +548,8 @@ M_PartCircle::M_PartCircle(Shader* sh, unsigned int numSegments, float radius, g
     glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)(3 * sizeof(float)));
     glEnableVertexAttribArray(1);
     glBindVertexArray(0);
-    setProjectionMatrix(glm::perspective(glm::radians(45.0f), 720.0f / 720.0f, 0.1f, 100.0f));
-    setViewMatrix(glm::vec3(0.0f, 0.0f, 6.0f));
+    setProjectionMatrix(Camera::scene().projection());
+    setViewMatrix(Camera::scene().view());
     glm::mat4 modelMatrix = glm::mat4(1.0f);
     modelMatrix = glm::rotate(modelMatrix, glm::radians(0.f), glm::vec3(1.0f, 0.0f, 0.0f));
     modelMatrix = glm::translate(modelMatrix, glm::vec3(0.0f, 0.0f, 0.0f));
@@ -573,10 +567,13 @@ M_PartCircle::~M_PartCircle()
 
 void M_PartCircle::draw()
 {
+    const glm::mat4 model = Camera::scene().modelFor(projectionMatrix, viewMatrix, worldMatrix());
+    if (PrimitiveBatch::shared().recording()) {
+        PrimitiveBatch::shared().add(this->shader, GL_TRIANGLE_FAN, model, this->vertexData);
+        return;
+    }
     this->shader->use();
-    shader->setMat4("model", modelMatrix);
-    shader->setMat4("view", viewMatrix);
-    shader->setMat4("projection", projectionMatrix);
+    shader->setMat4(ShaderUniform::MODEL, model);
     glBindVertexArray(VAO[0]);
     glDrawArrays(GL_TRIANGLE_FAN, 0, this->vertexData.size());
     glBindVertexArray(0);
@@ -584,16 +581,19 @@ void M_PartCircle::draw()
 
 void M_PartCircle::setProjectionMatrix(glm::mat4 projectionMatrix)
 {
+    RenderDamage::invalidate();
     this->projectionMatrix = projectionMatrix;
 }
 
 void M_PartCircle::setViewMatrix(glm::vec3 viewMatrix)
 {
+    RenderDamage::invalidate();
     this->viewMatrix = glm::lookAt(viewMatrix, glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
 }
 
 void M_PartCircle::setViewMatrix(glm::mat4 viewMatrix)
 {
+    RenderDamage::invalidate();
     this->mutex.lock();
     this->viewMatrix = viewMatrix;
     this->mutex.unlock();
@@ -601,16 +601,19 @@ void M_PartCircle::setViewMatrix(glm::mat4 viewMatrix)
 
 void M_PartCircle::setModelMatrix(glm::mat4 modelMatrix)
 {
-    this->modelMatrix = modelMatrix;
+    RenderDamage::invalidate();
+    setLocalMatrix(modelMatrix);
 }
 
 void M_PartCircle::translate(glm::vec3 translation)
 {
-    this->modelMatrix = glm::translate(this->modelMatrix, translation);
+    RenderDamage::invalidate();
+    setLocalMatrix(glm::translate(localMatrix(), translation));
 }
 
 void M_PartCircle::rotate(float angle, glm::vec3 axis)
 {
+    RenderDamage::invalidate();
     glm::mat4 tempMat = glm::mat4(1.0f);
     tempMat = glm::rotate(tempMat, glm::radians(angle), axis);
     for (size_t i = 0; i < this->vertexData.size(); i++) {
@@ -621,6 +624,7 @@ void M_PartCircle::rotate(float angle, glm::vec3 axis)
 
 void M_PartCircle::scale(glm::vec3 scale)
 {
+    RenderDamage::invalidate();
     // normalize scale
     glm::vec3 normalizedScale = glm::normalize(scale);
     // get the average of the scale
@@ -635,6 +639,7 @@ void M_PartCircle::scale(glm::vec3 scale)
 
 void M_PartCircle::uniformScale(float scale)
 {
+    RenderDamage::invalidate();
     for (size_t i = 0; i < this->vertexData.size(); i++) {
         this->vertexData[i].x *= scale;
         this->vertexData[i].y *= scale;
@@ -644,6 +649,7 @@ void M_PartCircle::uniformScale(float scale)
 
 void M_PartCircle::rotateAbout(float angle, glm::vec3 point)
 {
+    RenderDamage::invalidate();
     glm::vec3 axis = point - glm::vec3(this->vertexData[0].x, this->vertexData[0].y, this->vertexData[0].z);
     glm::mat4 tempMat = glm::mat4(1.0f); // Start with an identity matrix
     tempMat = glm::translate(tempMat, point);
@@ -657,6 +663,7 @@ void M_PartCircle::rotateAbout(float angle, glm::vec3 point)
 
 void M_PartCircle::rotateAbout(float angle, glm::vec3 axis, glm::vec3 point)
 {
+    RenderDamage::invalidate();
     glm::mat4 tempMat = glm::mat4(1.0f); // Start with an identity matrix
     tempMat = glm::translate(tempMat, point);
     tempMat = glm::rotate(tempMat, glm::radians(angle), axis);
@@ -684,27 +691,31 @@ float M_PartCircle::getWidth()
 
 void M_PartCircle::capturePosition()
 {
-    this->capturedModelMatrix = this->modelMatrix;
+    this->capturedModelMatrix = localMatrix();
     this->capturedViewMatrix = this->viewMatrix;
     this->capturedProjectionMatrix = this->projectionMatrix;
 }
 
 void M_PartCircle::restorePosition()
 {
-    this->modelMatrix = this->capturedModelMatrix;
+    RenderDamage::invalidate();
+    setLocalMatrix(this->capturedModelMatrix);
     this->viewMatrix = this->capturedViewMatrix;
     this->projectionMatrix = this->capturedProjectionMatrix;
 }
 
 void M_PartCircle::setVisibility(bool visible)
 {
+    if (this->visible != visible) {
+        RenderDamage::invalidate();
+    }
     this->visible = visible;
 }
 
 void M_PartCircle::getRestorePositionDiff(glm::mat4* modelMatrix, glm::mat4* viewMatrix, glm::mat4* projectionMatrix)
 {
     this->mutex.lock();
-    *modelMatrix = this->capturedModelMatrix - this->modelMatrix;
+    *modelMatrix = this->capturedModelMatrix - localMatrix();
     *viewMatrix = this->capturedViewMatrix - this->viewMatrix;
     *projectionMatrix = this->capturedProjectionMatrix - this->projectionMatrix;
     this->mutex.unlock();
@@ -712,7 +723,7 @@ void M_PartCircle::getRestorePositionDiff(glm::mat4* modelMatrix, glm::mat4* vie
 
 glm::mat4 M_PartCircle::getModelMatrix()
 {
-    return this->modelMatrix;
+    return localMatrix();
 }
 glm::mat4 M_PartCircle::getViewMatrix()
 {
@@ -723,6 +734,11 @@ glm::mat4 M_PartCircle::getProjectionMatrix()
     return this->projectionMatrix;
 }
 
+uint64_t M_PartCircle::drawKey()
+{
+    return DrawList::key(this->shader, 0);
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////
 
 unsigned char* createRadioButtonTexture(unsigned int size, unsigned int padding, bool selected)
@@ -809,7 +825,7 @@ M_RadioButtonTexture::M_RadioButtonTexture(Shader* sh, float radioSize, unsigned
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    setProjectionMatrix(glm::ortho(0.0f, 720.f, 0.0f, 720.f, -1.f, 1.f));
+    setProjectionMatrix(Camera::ui().projection());
     glBindTexture(GL_TEXTURE_2D, 0);
     glGenVertexArrays(1, &this->VAO);
     glGenBuffers(1, &this->VBO);
@@ -833,11 +849,11 @@ M_RadioButtonTexture::~M_RadioButtonTexture()
 void M_RadioButtonTexture::draw()
 {
     this->shader->use();
-    shader->setVec3("textColor", this->color.x, this->color.y, this->color.z);
-    shader->setMat4("projection", projectionMatrix);
-    shader->setFloat("zindex", 0.1f);
-    shader->setFloat("alpha", 1.0f);
-    shader->setFloat("bg_alpha", 1.0f);
+    shader->setVec3(ShaderUniform::TEXT_COLOR, this->color.x, this->color.y, this->color.z);
+    shader->setMat4(ShaderUniform::LOCAL, Camera::ui().modelFor(projectionMatrix, glm::mat4(1.0f), worldMatrix()));
+    shader->setFloat(ShaderUniform::ZINDEX, 0.1f);
+    shader->setFloat(ShaderUniform::ALPHA, 1.0f);
+    shader->setFloat(ShaderUniform::BG_ALPHA, 1.0f);
     glActiveTexture(GL_TEXTURE0);
     float xPos = this->position.x;
     float yPos = this->position.y - this->radioSize;
@@ -867,6 +883,7 @@ void M_RadioButtonTexture::draw()
 
 void M_RadioButtonTexture::setProjectionMatrix(glm::mat4 projectionMatrix)
 {
+    RenderDamage::invalidate();
     this->projectionMatrix = projectionMatrix;
 }
 
@@ -887,6 +904,7 @@ void M_RadioButtonTexture::setModelMatrix(glm::mat4 modelMatrix)
 
 void M_RadioButtonTexture::translate(glm::vec3 translation)
 {
+    RenderDamage::invalidate();
     this->position.x += translation.x;
     this->position.y += translation.y;
 }
@@ -898,11 +916,13 @@ void M_RadioButtonTexture::rotate(float angle, glm::vec3 axis)
 
 void M_RadioButtonTexture::scale(glm::vec3 scale)
 {
+    RenderDamage::invalidate();
     this->radioSize = this->radioSize * scale.x;
 }
 
 void M_RadioButtonTexture::uniformScale(float scale)
 {
+    RenderDamage::invalidate();
     this->scale_ *= scale;
 }
 
@@ -929,7 +949,7 @@ std::vector<Vertex> M_RadioButtonTexture::getVertices()
 
 void M_RadioButtonTexture::capturePosition()
 {
-    this->capturedModelMatrix = this->modelMatrix;
+    this->capturedModelMatrix = localMatrix();
     this->capturedViewMatrix = this->viewMatrix;
     this->capturedProjectionMatrix = this->projectionMatrix;
     this->capturedPosition = this->position;
@@ -937,7 +957,8 @@ void M_RadioButtonTexture::capturePosition()
 
 void M_RadioButtonTexture::restorePosition()
 {
-    this->modelMatrix = this->capturedModelMatrix;
+    RenderDamage::invalidate();
+    setLocalMatrix(this->capturedModelMatrix);
     this->viewMatrix = this->capturedViewMatrix;
     this->projectionMatrix = this->capturedProjectionMatrix;
     this->position = this->capturedPosition;
@@ -945,13 +966,16 @@ void M_RadioButtonTexture::restorePosition()
 
 void M_RadioButtonTexture::setVisibility(bool visible)
 {
+    if (this->visible != visible) {
+        RenderDamage::invalidate();
+    }
     this->visible = visible;
 }
 
 void M_RadioButtonTexture::getRestorePositionDiff(glm::mat4* modelMatrix, glm::mat4* viewMatrix, glm::mat4* projectionMatrix)
 {
     this->mutex.lock();
-    *modelMatrix = this->capturedModelMatrix - this->modelMatrix;
+    *modelMatrix = this->capturedModelMatrix - localMatrix();
     *viewMatrix = this->capturedViewMatrix - this->viewMatrix;
     *projectionMatrix = this->capturedProjectionMatrix - this->projectionMatrix;
     this->mutex.unlock();
@@ -959,7 +983,7 @@ void M_RadioButtonTexture::getRestorePositionDiff(glm::mat4* modelMatrix, glm::m
 
 glm::mat4 M_RadioButtonTexture::getModelMatrix()
 {
-    return this->modelMatrix;
+    return localMatrix();
 }
 
 glm::mat4 M_RadioButtonTexture::getViewMatrix()
@@ -972,13 +996,23 @@ glm::mat4 M_RadioButtonTexture::getProjectionMatrix()
     return this->projectionMatrix;
 }
 
+uint64_t M_RadioButtonTexture::drawKey()
+{
+    return DrawList::key(this->shader, this->selected ? this->textureSelected : this->textureUnselected);
+}
+
 void M_RadioButtonTexture::setSelected(bool selected)
 {
+    // MenuEntry::draw() pushes the selection state every frame; only a change is damage.
+    if (this->selected != selected) {
+        RenderDamage::invalidate();
+    }
     this->selected = selected;
 }
 
 void M_RadioButtonTexture::setPosition(glm::vec2 position)
 {
+    RenderDamage::invalidate();
     this->position = position;
 }
 
@@ -1105,7 +1139,7 @@ M_ToggleTexture::M_ToggleTexture(Shader* sh, float toggleWidth, float toggleHeig
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    setProjectionMatrix(glm::ortho(0.0f, 720.f, 0.0f, 720.f, -1.f, 1.f));
+    setProjectionMatrix(Camera::ui().projection());
     glBindTexture(GL_TEXTURE_2D, 0);
     glGenVertexArrays(1, &this->VAO);
     glGenBuffers(1, &this->VBO);
@@ -1129,11 +1163,11 @@ M_ToggleTexture::~M_ToggleTexture()
 void M_ToggleTexture::draw()
 {
     this->shader->use();
-    shader->setVec3("textColor", this->color.x, this->color.y, this->color.z);
-    shader->setMat4("projection", projectionMatrix);
-    shader->setFloat("zindex", 0.1f);
-    shader->setFloat("alpha", 1.0f);
-    shader->setFloat("bg_alpha", 1.0f);
+    shader->setVec3(ShaderUniform::TEXT_COLOR, this->color.x, this->color.y, this->color.z);
+    shader->setMat4(ShaderUniform::LOCAL, Camera::ui().modelFor(projectionMatrix, glm::mat4(1.0f), worldMatrix()));
+    shader->setFloat(ShaderUniform::ZINDEX, 0.1f);
+    shader->setFloat(ShaderUniform::ALPHA, 1.0f);
+    shader->setFloat(ShaderUniform::BG_ALPHA, 1.0f);
     glActiveTexture(GL_TEXTURE0);
     float xPos = this->position.x;
     float yPos = this->position.y - this->toggleHeight;
@@ -1163,6 +1197,7 @@ void M_ToggleTexture::draw()
 
 void M_ToggleTexture::setProjectionMatrix(glm::mat4 projectionMatrix)
 {
+    RenderDamage::invalidate();
     this->projectionMatrix = projectionMatrix;
 }
 
@@ -1183,6 +1218,7 @@ void M_ToggleTexture::setModelMatrix(glm::mat4 modelMatrix)
 
 void M_ToggleTexture::translate(glm::vec3 translation)
 {
+    RenderDamage::invalidate();
     this->position.x += translation.x;
     this->position.y += translation.y;
 }
@@ -1194,12 +1230,14 @@ void M_ToggleTexture::rotate(float angle, glm::vec3 axis)
 
 void M_ToggleTexture::scale(glm::vec3 scale)
 {
+    RenderDamage::invalidate();
     this->toggleWidth = this->toggleWidth * scale.x;
     this->toggleHeight = this->toggleHeight * scale.y;
 }
 
 void M_ToggleTexture::uniformScale(float scale)
 {
+    RenderDamage::invalidate();
     this->scale_ *= scale;
 }
 
@@ -1226,7 +1264,7 @@ std::vector<Vertex> M_ToggleTexture::getVertices()
 
 void M_ToggleTexture::capturePosition()
 {
-    this->capturedModelMatrix = this->modelMatrix;
+    this->capturedModelMatrix = localMatrix();
     this->capturedViewMatrix = this->viewMatrix;
     this->capturedProjectionMatrix = this->projectionMatrix;
     this->capturedPosition = this->position;
@@ -1234,7 +1272,8 @@ void M_ToggleTexture::capturePosition()
 
 void M_ToggleTexture::restorePosition()
 {
-    this->modelMatrix = this->capturedModelMatrix;
+    RenderDamage::invalidate();
+    setLocalMatrix(this->capturedModelMatrix);
     this->viewMatrix = this->capturedViewMatrix;
     this->projectionMatrix = this->capturedProjectionMatrix;
     this->position = this->capturedPosition;
@@ -1242,13 +1281,16 @@ void M_ToggleTexture::restorePosition()
 
 void M_ToggleTexture::setVisibility(bool visible)
 {
+    if (this->visible != visible) {
+        RenderDamage::invalidate();
+    }
     this->visible = visible;
 }
 
 void M_ToggleTexture::getRestorePositionDiff(glm::mat4* modelMatrix, glm::mat4* viewMatrix, glm::mat4* projectionMatrix)
 {
     this->mutex.lock();
-    *modelMatrix = this->capturedModelMatrix - this->modelMatrix;
+    *modelMatrix = this->capturedModelMatrix - localMatrix();
     *viewMatrix = this->capturedViewMatrix - this->viewMatrix;
     *projectionMatrix = this->capturedProjectionMatrix - this->projectionMatrix;
     this->mutex.unlock();
@@ -1256,7 +1298,7 @@ void M_ToggleTexture::getRestorePositionDiff(glm::mat4* modelMatrix, glm::mat4*
 
 glm::mat4 M_ToggleTexture::getModelMatrix()
 {
-    return this->modelMatrix;
+    return localMatrix();
 }
 
 glm::mat4 M_ToggleTexture::getViewMatrix()
@@ -1269,13 +1311,23 @@ glm::mat4 M_ToggleTexture::getProjectionMatrix()
     return this->projectionMatrix;
 }
 
+uint64_t M_ToggleTexture::drawKey()
+{
+    return DrawList::key(this->shader, this->selected ? this->textureSelected : this->textureUnselected);
+}
+
 void M_ToggleTexture::setSelected(bool selected)
 {
+    // MenuEntry::draw() pushes the selection state every frame; only a change is damage.
+    if (this->selected != selected) {
+        RenderDamage::invalidate();
+    }
     this->selected = selected;
 }
 
 void M_ToggleTexture::setPosition(glm::vec2 position)
 {
+    RenderDamage::invalidate();
     this->position = position;
 }
 
@@ -1488,7 +1540,7 @@ M_SliderTexture::M_SliderTexture(Shader* sh, float sliderWidth, float sliderHeig
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-    setProjectionMatrix(glm::ortho(0.0f, 720.f, 0.0f, 720.f, -1.f, 1.f));
+    setProjectionMatrix(Camera::ui().projection());
     glBindTexture(GL_TEXTURE_2D, 0);
     glGenVertexArrays(1, &this->VAO);
     glGenBuffers(1, &this->VBO);
@@ -1521,10 +1573,10 @@ void M_SliderTexture::draw()
         return;
     }
     this->shader->use();
-    shader->setVec3("textColor", this->color.x, this->color.y, this->color.z);
-    shader->setMat4("projection", projectionMatrix);
-    shader->setFloat("alpha", 1.0f);
-    shader->setFloat("bg_alpha", 1.0f);
+    shader->setVec3(ShaderUniform::TEXT_COLOR, this->color.x, this->color.y, this->color.z);
+    shader->setMat4(ShaderUniform::LOCAL, Camera::ui().modelFor(projectionMatrix, glm::mat4(1.0f), worldMatrix()));
+    shader->setFloat(ShaderUniform::ALPHA, 1.0f);
+    shader->setFloat(ShaderUniform::BG_ALPHA, 1.0f);
     glActiveTexture(GL_TEXTURE0);
     float xPos = this->position.x;
     float yPos = this->position.y - this->sliderHeight;
@@ -1538,8 +1590,8 @@ void M_SliderTexture::draw()
         { xPos + this->sliderWidth, yPos + this->sliderHeight, 1.0f, 0.0f }, // Top-right
         { xPos + this->sliderWidth, yPos, 1.0f, 1.0f } // Bottom-right
     };
-    shader->setFloat("zindex", 0.20f);
-    shader->setVec3("textColor", 0.78f, 0.78f, 0.78f);
+    shader->setFloat(ShaderUniform::ZINDEX, 0.20f);
+    shader->setVec3(ShaderUniform::TEXT_COLOR, 0.78f, 0.78f, 0.78f);
     glBindTexture(GL_TEXTURE_2D, this->backgroundTexture);
     glBindVertexArray(this->VAO);
     glBindBuffer(GL_ARRAY_BUFFER, this->VBO);
@@ -1562,9 +1614,9 @@ void M_SliderTexture::draw()
         { dotXPos + this->sliderHeight, dotYPos + this->sliderHeight, 1.0f, 0.0f }, // Top-right
         { dotXPos + this->sliderHeight, dotYPos, 1.0f, 1.0f } // Bottom-right
     };
-    shader->setFloat("bg_alpha", 0.0f);
-    shader->setVec3("textColor", 0.0f, 0.0f, 0.0f);
-    shader->setFloat("zindex", 0.22f);
+    shader->setFloat(ShaderUniform::BG_ALPHA, 0.0f);
+    shader->setVec3(ShaderUniform::TEXT_COLOR, 0.0f, 0.0f, 0.0f);
+    shader->setFloat(ShaderUniform::ZINDEX, 0.22f);
     glBindTexture(GL_TEXTURE_2D, this->thumbFillTexture);
     glBindVertexArray(this->VAO);
     glBindBuffer(GL_ARRAY_BUFFER, this->VBO);
@@ -1572,21 +1624,22 @@ void M_SliderTexture::draw()
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glDrawArrays(GL_TRIANGLES, 0, 6);
 
-    shader->setVec3("textColor", this->color.x, this->color.y, this->color.z);
-    shader->setFloat("zindex", 0.23f);
+    shader->setVec3(ShaderUniform::TEXT_COLOR, this->color.x, this->color.y, this->color.z);
+    shader->setFloat(ShaderUniform::ZINDEX, 0.23f);
     glBindTexture(GL_TEXTURE_2D, this->thumbBorderTexture);
     glBindVertexArray(this->VAO);
     glBindBuffer(GL_ARRAY_BUFFER, this->VBO);
     glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(verticesDot), verticesDot);
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glDrawArrays(GL_TRIANGLES, 0, 6);
-    shader->setFloat("bg_alpha", 1.0f);
+    shader->setFloat(ShaderUniform::BG_ALPHA, 1.0f);
     glBindVertexArray(0);
     glBindTexture(GL_TEXTURE_2D, 0);
 }
 
 void M_SliderTexture::setProjectionMatrix(glm::mat4 projectionMatrix)
 {
+    RenderDamage::invalidate();
     this->projectionMatrix = projectionMatrix;
 }
 
@@ -1607,6 +1660,7 @@ void M_SliderTexture::setModelMatrix(glm::mat4 modelMatrix)
 
 void M_SliderTexture::translate(glm::vec3 translation)
 {
+    RenderDamage::invalidate();
     this->position.x += translation.x;
     this->position.y += translation.y;
 }
@@ -1618,12 +1672,14 @@ void M_SliderTexture::rotate(float angle, glm::vec3 axis)
 
 void M_SliderTexture::scale(glm::vec3 scale)
 {
+    RenderDamage::invalidate();
     this->sliderWidth = this->sliderWidth * scale.x;
     this->sliderHeight = this->sliderHeight * scale.y;
 }
 
 void M_SliderTexture::uniformScale(float scale)
 {
+    RenderDamage::invalidate();
     this->scale_ *= scale;
 }
 
@@ -1650,7 +1706,7 @@ std::vector<Vertex> M_SliderTexture::getVertices()
 
 void M_SliderTexture::capturePosition()
 {
-    this->capturedModelMatrix = this->modelMatrix;
+    this->capturedModelMatrix = localMatrix();
     this->capturedViewMatrix = this->viewMatrix;
     this->capturedProjectionMatrix = this->projectionMatrix;
     this->capturedPosition = this->position;
@@ -1658,7 +1714,8 @@ void M_SliderTexture::capturePosition()
 
 void M_SliderTexture::restorePosition()
 {
-    this->modelMatrix = this->capturedModelMatrix;
+    RenderDamage::invalidate();
+    setLocalMatrix(this->capturedModelMatrix);
     this->viewMatrix = this->capturedViewMatrix;
     this->projectionMatrix = this->capturedProjectionMatrix;
     this->position = this->capturedPosition;
@@ -1666,13 +1723,16 @@ void M_SliderTexture::restorePosition()
 
 void M_SliderTexture::setVisibility(bool visible)
 {
+    if (this->visible != visible) {
+        RenderDamage::invalidate();
+    }
     this->visible = visible;
 }
 
 void M_SliderTexture::getRestorePositionDiff(glm::mat4* modelMatrix, glm::mat4* viewMatrix, glm::mat4* projectionMatrix)
 {
     this->mutex.lock();
-    *modelMatrix = this->capturedModelMatrix - this->modelMatrix;
+    *modelMatrix = this->capturedModelMatrix - localMatrix();
     *viewMatrix = this->capturedViewMatrix - this->viewMatrix;
     *projectionMatrix = this->capturedProjectionMatrix - this->projectionMatrix;
     this->mutex.unlock();
@@ -1680,7 +1740,7 @@ void M_SliderTexture::getRestorePositionDiff(glm::mat4* modelMatrix, glm::mat4*
 
 glm::mat4 M_SliderTexture::getModelMatrix()
 {
-    return this->modelMatrix;
+    return localMatrix();
 }
 
 glm::mat4 M_SliderTexture::getViewMatrix()
@@ -1693,8 +1753,14 @@ glm::mat4 M_SliderTexture::getProjectionMatrix()
     return this->projectionMatrix;
 }
 
+uint64_t M_SliderTexture::drawKey()
+{
+    return DrawList::key(this->shader, 0);
+}
+
 void M_SliderTexture::setPosition(glm::vec2 position)
 {
+    RenderDamage::invalidate();
     this->position = position;
 }
 
@@ -1733,8 +1799,8 @@ M_Rect::M_Rect(Shader* sh, glm::vec3 position, glm::vec2 size, float fillColor,
     glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)(3 * sizeof(float)));
     glEnableVertexAttribArray(1);
     glBindVertexArray(0);
-    setProjectionMatrix(glm::perspective(glm::radians(45.0f), 720.0f / 720.0f, 0.1f, 100.0f));
-    setViewMatrix(glm::vec3(0.0f, 0.0f, 6.0f));
+    setProjectionMatrix(Camera::scene().projection());
+    setViewMatrix(Camera::scene().view());
     glm::mat4 modelMatrix = glm::mat4(1.0f);
     modelMatrix = glm::rotate(modelMatrix, glm::radians(0.f), glm::vec3(1.0f, 0.0f, 0.0f));
     modelMatrix = glm::translate(modelMatrix, glm::vec3(0.0f, 0.0f, 0.0f));
@@ -1746,16 +1812,20 @@ M_Rect::M_Rect(Shader* sh, glm::vec3 position, glm::vec2 size, float fillColor,
 M_Rect::~M_Rect()
 {
     // CubeLog::info("Destroyed Rect");
-    glDeleteVertexArrays(1, VAO);
-    glDeleteBuffers(1, VBO);
+    glDeleteVertexArrays(2, VAO);
+    glDeleteBuffers(2, VBO);
 }
 
 void M_Rect::draw()
 {
+    const glm::mat4 model = Camera::scene().modelFor(projectionMatrix, viewMatrix, worldMatrix());
+    if (PrimitiveBatch::shared().recording()) {
+        PrimitiveBatch::shared().add(this->shader, GL_TRIANGLE_STRIP, model, this->vertexDataFill);
+        PrimitiveBatch::shared().add(this->shader, GL_LINE_LOOP, model, this->vertexDataBorder);
+        return;
+    }
     this->shader->use();
-    shader->setMat4("model", modelMatrix);
-    shader->setMat4("view", viewMatrix);
-    shader->setMat4("projection", projectionMatrix);
+    shader->setMat4(ShaderUniform::MODEL, model);
     glBindVertexArray(VAO[0]);
     glDrawArrays(GL_TRIANGLE_STRIP, 0, this->vertexDataFill.size());
     glBindVertexArray(VAO[1]);
@@ -1765,16 +1835,19 @@ void M_Rect::draw()
 
 void M_Rect::setProjectionMatrix(glm::mat4 projectionMatrix)
 {
+    RenderDamage::invalidate();
     this->projectionMatrix = projectionMatrix;
 }
 
 void M_Rect::setViewMatrix(glm::vec3 viewMatrix)
 {
+    RenderDamage::invalidate();
     this->viewMatrix = glm::lookAt(viewMatrix, glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
 }
 
 void M_Rect::setViewMatrix(glm::mat4 viewMatrix)
 {
+    RenderDamage::invalidate();
     this->mutex.lock();
     this->viewMatrix = viewMatrix;
     this->mutex.unlock();
@@ -1782,11 +1855,13 @@ void M_Rect::setViewMatrix(glm::mat4 viewMatrix)
 
 void M_Rect::setModelMatrix(glm::mat4 modelMatrix)
 {
-    this->modelMatrix = modelMatrix;
+    RenderDamage::invalidate();
+    setLocalMatrix(modelMatrix);
 }
 
 void M_Rect::translate(glm::vec3 translation)
 {
+    RenderDamage::invalidate();
     // for (size_t i = 0; i < 4; i++) {
     //     this->vertexDataFill[i].x += translation.x;
     //     this->vertexDataFill[i].y += translation.y;
@@ -1795,11 +1870,12 @@ void M_Rect::translate(glm::vec3 translation)
     //     this->vertexDataBorder[i].y += translation.y;
     //     this->vertexDataBorder[i].z += translation.z;
     // }
-    this->modelMatrix = glm::translate(this->modelMatrix, translation);
+    setLocalMatrix(glm::translate(localMatrix(), translation));
 }
 
 void M_Rect::rotate(float angle, glm::vec3 axis)
 {
+    RenderDamage::invalidate();
     glm::mat4 tempMat = glm::mat4(1.0f);
     tempMat = glm::rotate(tempMat, glm::radians(angle), axis);
     for (size_t i = 0; i < 4; i++) {
@@ -1812,6 +1888,7 @@ void M_Rect::rotate(float angle, glm::vec3 axis)
 
 void M_Rect::scale(glm::vec3 scale)
 {
+    RenderDamage::invalidate();
     // normalize scale
     glm::vec3 normalizedScale = glm::normalize(scale);
     // get the average of the scale
@@ -1829,6 +1906,7 @@ void M_Rect::scale(glm::vec3 scale)
 
 void M_Rect::uniformScale(float scale)
 {
+    RenderDamage::invalidate();
     for (size_t i = 0; i < 4; i++) {
         this->vertexDataFill[i].x *= scale;
         this->vertexDataFill[i].y *= scale;
@@ -1841,6 +1919,7 @@ void M_Rect::uniformScale(float scale)
 
 void M_Rect::rotateAbout(float angle, glm::vec3 point)
 {
+    RenderDamage::invalidate();
     glm::vec3 axis = point - glm::vec3(this->vertexDataFill[0].x, this->vertexDataFill[0].y, this->vertexDataFill[0].z);
     glm::mat4 tempMat = glm::mat4(1.0f); // Start with an identity matrix
     tempMat = glm::translate(tempMat, point);
@@ -1856,6 +1935,7 @@ void M_Rect::rotateAbout(float angle, glm::vec3 point)
 
 void M_Rect::rotateAbout(float angle, glm::vec3 axis, glm::vec3 point)
 {
+    RenderDamage::invalidate();
     glm::mat4 tempMat = glm::mat4(1.0f); // Start with an identity matrix
     tempMat = glm::translate(tempMat, point);
     tempMat = glm::rotate(tempMat, glm::radians(angle), axis);
@@ -1885,27 +1965,31 @@ float M_Rect::getWidth()
 
 void M_Rect::capturePosition()
 {
-    this->capturedModelMatrix = this->modelMatrix;
+    this->capturedModelMatrix = localMatrix();
     this->capturedViewMatrix = this->viewMatrix;
     this->capturedProjectionMatrix = this->projectionMatrix;
 }
 
 void M_Rect::restorePosition()
 {
-    this->modelMatrix = this->capturedModelMatrix;
+    RenderDamage::invalidate();
+    setLocalMatrix(this->capturedModelMatrix);
     this->viewMatrix = this->capturedViewMatrix;
     this->projectionMatrix = this->capturedProjectionMatrix;
 }
 
 void M_Rect::setVisibility(bool visible)
 {
+    if (this->visible != visible) {
+        RenderDamage::invalidate();
+    }
     this->visible = visible;
 }
 
 void M_Rect::getRestorePositionDiff(glm::mat4* modelMatrix, glm::mat4* viewMatrix, glm::mat4* projectionMatrix)
 {
     this->mutex.lock();
-    *modelMatrix = this->capturedModelMatrix - this->modelMatrix;
+    *modelMatrix = this->capturedModelMatrix - localMatrix();
     *viewMatrix = this->capturedViewMatrix - this->viewMatrix;
     *projectionMatrix = this->capturedProjectionMatrix - this->projectionMatrix;
     this->mutex.unlock();
@@ -1913,7 +1997,7 @@ void M_Rect::getRestorePositionDiff(glm::mat4* modelMatrix, glm::mat4* viewMatri
 
 glm::mat4 M_Rect::getModelMatrix()
 {
-    return this->modelMatrix;
+    return localMatrix();
 }
 glm::mat4 M_Rect::getViewMatrix()
 {
@@ -1924,6 +2008,11 @@ glm::mat4 M_Rect::getProjectionMatrix()
     return this->projectionMatrix;
 }
 
+uint64_t M_Rect::drawKey()
+{
+    return DrawList::key(this->shader, 0);
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////
 
 M_Line::M_Line(Shader* sh, glm::vec3 start, glm::vec3 end)
@@ -1941,8 +2030,8 @@ M_Line::M_Line(Shader* sh, glm::vec3 start, glm::vec3 end)
     glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)(3 * sizeof(float)));
     glEnableVertexAttribArray(1);
     glBindVertexArray(0);
-    setProjectionMatrix(glm::perspective(glm::radians(45.0f), 720.0f / 720.0f, 0.1f, 100.0f));
-    setViewMatrix(glm::vec3(0.0f, 0.0f, 6.0f));
+    setProjectionMatrix(Camera::scene().projection());
+    setViewMatrix(Camera::scene().view());
     glm::mat4 modelMatrix = glm::mat4(1.0f);
     modelMatrix = glm::rotate(modelMatrix, glm::radians(0.f), glm::vec3(1.0f, 0.0f, 0.0f));
     modelMatrix = glm::translate(modelMatrix, glm::vec3(0.0f, 0.0f, 0.0f));
@@ -1960,10 +2049,13 @@ M_Line::~M_Line()
 
 void M_Line::draw()
 {
+    const glm::mat4 model = Camera::scene().modelFor(projectionMatrix, viewMatrix, worldMatrix());
+    if (PrimitiveBatch::shared().recording()) {
+        PrimitiveBatch::shared().add(this->shader, GL_LINES, model, this->vertexData);
+        return;
+    }
     this->shader->use();
-    shader->setMat4("model", modelMatrix);
-    shader->setMat4("view", viewMatrix);
-    shader->setMat4("projection", projectionMatrix);
+    shader->setMat4(ShaderUniform::MODEL, model);
     glBindVertexArray(VAO[0]);
     glDrawArrays(GL_LINES, 0, this->vertexData.size());
     glBindVertexArray(0);
@@ -1971,16 +2063,19 @@ void M_Line::draw()
 
 void M_Line::setProjectionMatrix(glm::mat4 projectionMatrix)
 {
+    RenderDamage::invalidate();
     this->projectionMatrix = projectionMatrix;
 }
 
 void M_Line::setViewMatrix(glm::vec3 viewMatrix)
 {
+    RenderDamage::invalidate();
     this->viewMatrix = glm::lookAt(viewMatrix, glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
 }
 
 void M_Line::setViewMatrix(glm::mat4 viewMatrix)
 {
+    RenderDamage::invalidate();
     this->mutex.lock();
     this->viewMatrix = viewMatrix;
     this->mutex.unlock();
@@ -1988,11 +2083,13 @@ void M_Line::setViewMatrix(glm::mat4 viewMatrix)
 
 void M_Line::setModelMatrix(glm::mat4 modelMatrix)
 {
-    this->modelMatrix = modelMatrix;
+    RenderDamage::invalidate();
+    setLocalMatrix(modelMatrix);
 }
 
 void M_Line::translate(glm::vec3 translation)
 {
+    RenderDamage::invalidate();
     // this->vertexData[0].x += translation.x;
     // this->vertexData[0].y += translation.y;
     // this->vertexData[0].z += translation.z;
@@ -2000,22 +2097,24 @@ void M_Line::translate(glm::vec3 translation)
     // this->vertexData[1].y += translation.y;
     // this->vertexData[1].z += translation.z;
     // update the matrixes
-    this->modelMatrix = glm::translate(this->modelMatrix, translation);
+    setLocalMatrix(glm::translate(localMatrix(), translation));
 }
 
 void M_Line::rotate(float angle, glm::vec3 axis)
 {
+    RenderDamage::invalidate();
     glm::mat4 tempMat = glm::mat4(1.0f);
     tempMat = glm::rotate(tempMat, glm::radians(angle), axis);
     glm::vec4 start = tempMat * glm::vec4(this->vertexData[0].x, this->vertexData[0].y, this->vertexData[0].z, 1.0f);
     glm::vec4 end = tempMat * glm::vec4(this->vertexData[1].x, this->vertexData[1].y, this->vertexData[1].z, 1.0f);
     this->vertexData[0] = { start.x, start.y, start.z, 1.f };
     this->vertexData[1] = { end.x, end.y, end.z, 1.f };
-    this->modelMatrix = glm::rotate(this->modelMatrix, glm::radians(angle), axis);
+    setLocalMatrix(glm::rotate(localMatrix(), glm::radians(angle), axis));
 }
 
 void M_Line::scale(glm::vec3 scale)
 {
+    RenderDamage::invalidate();
     // normalize scale
     glm::vec3 normalizedScale = glm::normalize(scale);
     // get the average of the scale
@@ -2024,19 +2123,21 @@ void M_Line::scale(glm::vec3 scale)
     this->vertexData[1].x *= avgScale;
     this->vertexData[1].y *= avgScale;
     this->vertexData[1].z *= avgScale;
-    this->modelMatrix = glm::scale(this->modelMatrix, scale);
+    setLocalMatrix(glm::scale(localMatrix(), scale));
 }
 
 void M_Line::uniformScale(float scale)
 {
+    RenderDamage::invalidate();
     this->vertexData[1].x *= scale;
     this->vertexData[1].y *= scale;
     this->vertexData[1].z *= scale;
-    this->modelMatrix = glm::scale(this->modelMatrix, glm::vec3(scale, scale, scale));
+    setLocalMatrix(glm::scale(localMatrix(), glm::vec3(scale, scale, scale)));
 }
 
 void M_Line::rotateAbout(float angle, glm::vec3 point)
 {
+    RenderDamage::invalidate();
     glm::vec3 axis = point - glm::vec3(this->vertexData[0].x, this->vertexData[0].y, this->vertexData[0].z);
     glm::mat4 tempMat = glm::mat4(1.0f); // Start with an identity matrix
     tempMat = glm::translate(tempMat, point);
@@ -2046,13 +2147,16 @@ void M_Line::rotateAbout(float angle, glm::vec3 point)
     glm::vec4 end = tempMat * glm::vec4(this->vertexData[1].x, this->vertexData[1].y, this->vertexData[1].z, 1.0f);
     this->vertexData[0] = { start.x, start.y, start.z, 1.f };
     this->vertexData[1] = { end.x, end.y, end.z, 1.f };
-    this->modelMatrix = glm::translate(this->modelMatrix, point);
-    this->modelMatrix = glm::rotate(this->modelMatrix, glm::radians(angle), axis);
-    this->modelMatrix = glm::translate(this->modelMatrix, -point);
+    glm::mat4 model = localMatrix();
+    model = glm::translate(model, point);
+    model = glm::rotate(model, glm::radians(angle), axis);
+    model = glm::translate(model, -point);
+    setLocalMatrix(model);
 }
 
 void M_Line::rotateAbout(float angle, glm::vec3 axis, glm::vec3 point)
 {
+    RenderDamage::invalidate();
     glm::mat4 tempMat = glm::mat4(1.0f); // Start with an identity matrix
     tempMat = glm::translate(tempMat, point);
     tempMat = glm::rotate(tempMat, glm::radians(angle), axis);
@@ -2061,9 +2165,11 @@ void M_Line::rotateAbout(float angle, glm::vec3 axis, glm::vec3 point)
     glm::vec4 end = tempMat * glm::vec4(this->vertexData[1].x, this->vertexData[1].y, this->vertexData[1].z, 1.0f);
     this->vertexData[0] = { start.x, start.y, start.z, 1.f };
     this->vertexData[1] = { end.x, end.y, end.z, 1.f };
-    this->modelMatrix = glm::translate(this->modelMatrix, point);
-    this->modelMatrix = glm::rotate(this->modelMatrix, glm::radians(angle), axis);
-    this->modelMatrix = glm::translate(this->modelMatrix, -point);
+    glm::mat4 model = localMatrix();
+    model = glm::translate(model, point);
+    model = glm::rotate(model, glm::radians(angle), axis);
+    model = glm::translate(model, -point);
+    setLocalMatrix(model);
 }
 
 glm::vec3 M_Line::getCenterPoint()
@@ -2083,27 +2189,31 @@ float M_Line::getWidth()
 
 void M_Line::capturePosition()
 {
-    this->capturedModelMatrix = this->modelMatrix;
+    this->capturedModelMatrix = localMatrix();
     this->capturedViewMatrix = this->viewMatrix;
     this->capturedProjectionMatrix = this->projectionMatrix;
 }
 
 void M_Line::restorePosition()
 {
-    this->modelMatrix = this->capturedModelMatrix;
+    RenderDamage::invalidate();
+    setLocalMatrix(this->capturedModelMatrix);
     this->viewMatrix = this->capturedViewMatrix;
     this->projectionMatrix = this->capturedProjectionMatrix;
 }
 
 void M_Line::setVisibility(bool visibility)
 {
+    if (this->visible != visibility) {
+        RenderDamage::invalidate();
+    }
     this->visible = visibility;
 }
 
 void M_Line::getRestorePositionDiff(glm::mat4* modelMatrix, glm::mat4* viewMatrix, glm::mat4* projectionMatrix)
 {
     this->mutex.lock();
-    *modelMatrix = this->capturedModelMatrix - this->modelMatrix;
+    *modelMatrix = this->capturedModelMatrix - localMatrix();
     *viewMatrix = this->capturedViewMatrix - this->viewMatrix;
     *projectionMatrix = this->capturedProjectionMatrix - this->projectionMatrix;
     this->mutex.unlock();
@@ -2111,7 +2221,7 @@ void M_Line::getRestorePositionDiff(glm::mat4* modelMatrix, glm::mat4* viewMatri
 
 glm::mat4 M_Line::getModelMatrix()
 {
-    return this->modelMatrix;
+    return localMatrix();
 }
 glm::mat4 M_Line::getViewMatrix()
 {
@@ -2122,6 +2232,11 @@ glm::mat4 M_Line::getProjectionMatrix()
     return this->projectionMatrix;
 }
 
+uint64_t M_Line::drawKey()
+{
+    return DrawList::key(this->shader, 0);
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////
 
 M_Arc::M_Arc(Shader* sh, unsigned int numSegments, float radius, float startAngle, float endAngle, glm::vec3 centerPoint, glm::vec3 fillColor)
@@ -2155,8 +2270,8 @@ M_Arc::M_Arc(Shader* sh, unsigned int numSegments, float radius, float startAngl
     glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)(3 * sizeof(float)));
     glEnableVertexAttribArray(1);
     glBindVertexArray(0);
-    setProjectionMatrix(glm::perspective(glm::radians(45.0f), 720.0f / 720.0f, 0.1f, 100.0f));
-    setViewMatrix(glm::vec3(0.0f, 0.0f, 6.0f));
+    setProjectionMatrix(Camera::scene().projection());
+    setViewMatrix(Camera::scene().view());
     glm::mat4 modelMatrix = glm::mat4(1.0f);
     modelMatrix = glm::rotate(modelMatrix, glm::radians(0.f), glm::vec3(1.0f, 0.0f, 0.0f));
     modelMatrix = glm::translate(modelMatrix, glm::vec3(0.0f, 0.0f, 0.0f));
@@ -2174,10 +2289,13 @@ M_Arc::~M_Arc()
 
 void M_Arc::draw()
 {
+    const glm::mat4 model = Camera::scene().modelFor(projectionMatrix, viewMatrix, worldMatrix());
+    if (PrimitiveBatch::shared().recording()) {
+        PrimitiveBatch::shared().add(this->shader, GL_LINE_STRIP, model, this->vertexData);
+        return;
+    }
     this->shader->use();
-    shader->setMat4("model", modelMatrix);
-    shader->setMat4("view", viewMatrix);
-    shader->setMat4("projection", projectionMatrix);
+    shader->setMat4(ShaderUniform::MODEL, model);
     glBindVertexArray(VAO[0]);
     // glDrawElements(GL_LINE_STRIP, this->vertexData.size(), GL_UNSIGNED_INT, 0);
     glDrawArrays(GL_LINE_STRIP, 0, this->vertexData.size());
@@ -2186,15 +2304,18 @@ void M_Arc::draw()
 
 void M_Arc::setProjectionMatrix(glm::mat4 projectionMatrix)
 {
+    RenderDamage::invalidate();
     this->projectionMatrix = projectionMatrix;
 }
 void M_Arc::setViewMatrix(glm::vec3 viewMatrix)
 {
+    RenderDamage::invalidate();
     this->viewMatrix = glm::lookAt(viewMatrix, glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
 }
 
 void M_Arc::setViewMatrix(glm::mat4 viewMatrix)
 {
+    RenderDamage::invalidate();
     this->mutex.lock();
     this->viewMatrix = viewMatrix;
     this->mutex.unlock();
@@ -2202,22 +2323,26 @@ void M_Arc::setViewMatrix(glm::mat4 viewMatrix)
 
 void M_Arc::setModelMatrix(glm::mat4 modelMatrix)
 {
-    this->modelMatrix = modelMatrix;
+    RenderDamage::invalidate();
+    setLocalMatrix(modelMatrix);
 }
 void M_Arc::translate(glm::vec3 translation)
 {
+    RenderDamage::invalidate();
     this->centerPoint += translation;
-    this->modelMatrix = glm::translate(this->modelMatrix, translation);
+    setLocalMatrix(glm::translate(localMatrix(), translation));
 }
 
 void M_Arc::rotate(float angle, glm::vec3 axis)
 {
+    RenderDamage::invalidate();
     this->startAngle += angle;
     this->endAngle += angle;
 }
 
 void M_Arc::scale(glm::vec3 scale)
 {
+    RenderDamage::invalidate();
     // normalize scale
     glm::vec3 normalizedScale = glm::normalize(scale);
     // get the average of the scale
@@ -2228,6 +2353,7 @@ void M_Arc::scale(glm::vec3 scale)
 
 void M_Arc::uniformScale(float scale)
 {
+    RenderDamage::invalidate();
     this->radius *= scale;
 }
 
@@ -2250,27 +2376,31 @@ float M_Arc::getWidth()
 
 void M_Arc::capturePosition()
 {
-    this->capturedModelMatrix = this->modelMatrix;
+    this->capturedModelMatrix = localMatrix();
     this->capturedViewMatrix = this->viewMatrix;
     this->capturedProjectionMatrix = this->projectionMatrix;
 }
 
 void M_Arc::restorePosition()
 {
-    this->modelMatrix = this->capturedModelMatrix;
+    RenderDamage::invalidate();
+    setLocalMatrix(this->capturedModelMatrix);
     this->viewMatrix = this->capturedViewMatrix;
     this->projectionMatrix = this->capturedProjectionMatrix;
 }
 
 void M_Arc::setVisibility(bool visibility)
 {
+    if (this->visible != visibility) {
+        RenderDamage::invalidate();
+    }
     this->visible = visibility;
 }
 
 void M_Arc::getRestorePositionDiff(glm::mat4* modelMatrix, glm::mat4* viewMatrix, glm::mat4* projectionMatrix)
 {
     this->mutex.lock();
-    *modelMatrix = this->capturedModelMatrix - this->modelMatrix;
+    *modelMatrix = this->capturedModelMatrix - localMatrix();
     *viewMatrix = this->capturedViewMatrix - this->viewMatrix;
     *projectionMatrix = this->capturedProjectionMatrix - this->projectionMatrix;
     this->mutex.unlock();
@@ -2278,7 +2408,7 @@ void M_Arc::getRestorePositionDiff(glm::mat4* modelMatrix, glm::mat4* viewMatrix
 
 glm::mat4 M_Arc::getModelMatrix()
 {
-    return this->modelMatrix;
+    return localMatrix();
 }
 glm::mat4 M_Arc::getViewMatrix()
 {
@@ -2289,6 +2419,11 @@ glm::mat4 M_Arc::getProjectionMatrix()
     return this->projectionMatrix;
 }
 
+uint64_t M_Arc::drawKey()
+{
+    return DrawList::key(this->shader, 0);
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////
 
 Cube::Cube(Shader* sh)
@@ -2325,8 +2460,8 @@ Cube::Cube(Shader* sh)
         glEnableVertexAttribArray(1);
         glBindVertexArray(0);
     }
-    setProjectionMatrix(glm::perspective(glm::radians(45.0f), 720.0f / 720.0f, 0.1f, 100.0f));
-    setViewMatrix(glm::vec3(0.0f, 0.0f, 6.0f));
+    setProjectionMatrix(Camera::scene().projection());
+    setViewMatrix(Camera::scene().view());
     glm::mat4 modelMatrix = glm::mat4(1.0f);
     modelMatrix = glm::rotate(modelMatrix, glm::radians(0.f), glm::vec3(1.0f, 0.0f, 0.0f));
     modelMatrix = glm::translate(modelMatrix, glm::vec3(0.0f, 0.0f, 0.0f));
@@ -2337,9 +2472,7 @@ Cube::Cube(Shader* sh)
 void Cube::draw()
 {
     shader->use();
-    shader->setMat4("model", modelMatrix);
-    shader->setMat4("view", viewMatrix);
-    shader->setMat4("projection", projectionMatrix);
+    shader->setMat4(ShaderUniform::MODEL, Camera::scene().modelFor(projectionMatrix, viewMatrix, worldMatrix()));
     // glDepthMask(GL_FALSE);
     glBindVertexArray(VAOs[0]);
     glDrawElements(GL_TRIANGLES, 36, GL_UNSIGNED_INT, 0);
@@ -2353,16 +2486,19 @@ void Cube::draw()
 
 void Cube::setProjectionMatrix(glm::mat4 projection)
 {
+    RenderDamage::invalidate();
     this->projectionMatrix = projection;
 }
 
 void Cube::setViewMatrix(glm::vec3 view)
 {
+    RenderDamage::invalidate();
     this->viewMatrix = glm::lookAt(view, glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
 }
 
 void Cube::setViewMatrix(glm::mat4 viewMatrix)
 {
+    RenderDamage::invalidate();
     this->mutex.lock();
     this->viewMatrix = viewMatrix;
     this->mutex.unlock();
@@ -2370,21 +2506,25 @@ void Cube::setViewMatrix(glm::mat4 viewMatrix)
 
 void Cube::setModelMatrix(glm::mat4 model)
 {
-    this->modelMatrix = model;
+    RenderDamage::invalidate();
+    setLocalMatrix(model);
 }
 
 void Cube::rotate(float angle, glm::vec3 axis)
 {
-    modelMatrix = glm::rotate(modelMatrix, glm::radians(angle), axis);
+    RenderDamage::invalidate();
+    setLocalMatrix(glm::rotate(localMatrix(), glm::radians(angle), axis));
 }
 
 void Cube::translate(glm::vec3 translation)
 {
-    modelMatrix = glm::translate(modelMatrix, translation);
+    RenderDamage::invalidate();
+    setLocalMatrix(glm::translate(localMatrix(), translation));
 }
 
 void Cube::scale(glm::vec3 scale)
 {
+    RenderDamage::invalidate();
     // adjust scale vectors to avoid scaling to zero and modify them to make sure the cube is not deformed
     if (scale.x == 0.0f)
         scale.x = 0.01f;
@@ -2393,7 +2533,7 @@ void Cube::scale(glm::vec3 scale)
     if (scale.z == 0.0f)
         scale.z = 0.01f;
 
-    modelMatrix = glm::scale(modelMatrix, scale);
+    setLocalMatrix(glm::scale(localMatrix(), scale));
 }
 
 Cube::~Cube()
@@ -2405,13 +2545,15 @@ Cube::~Cube()
 
 void Cube::uniformScale(float scale)
 {
+    RenderDamage::invalidate();
     this->scale(glm::vec3(scale, scale, scale));
 }
 
 void Cube::rotateAbout(float angle, glm::vec3 point)
 {
-    glm::mat4 originalModelMatrix = modelMatrix; // Save the original model matrix
-    modelMatrix = glm::mat4(1.0f); // Reset model matrix to identity
+    RenderDamage::invalidate();
+    glm::mat4 originalModelMatrix = localMatrix(); // Save the original model matrix
+    setLocalMatrix(glm::mat4(1.0f)); // Reset model matrix to identity
 
     glm::vec3 axis = glm::normalize(point - getCenterPoint()); // Normalize the axis
     glm::mat4 tempMat = glm::mat4(1.0f); // Start with an identity matrix
@@ -2419,13 +2561,13 @@ void Cube::rotateAbout(float angle, glm::vec3 point)
     tempMat = glm::rotate(tempMat, glm::radians(angle), axis);
     tempMat = glm::translate(tempMat, -point);
 
-    modelMatrix = tempMat * originalModelMatrix; // Apply the rotation to the original matrix
+    setLocalMatrix(tempMat * originalModelMatrix); // Apply the rotation to the original matrix
 }
 
 void Cube::rotateAbout(float angle, glm::vec3 axis, glm::vec3 point)
 {
-    glm::mat4 originalModelMatrix = modelMatrix; // Save the original model matrix
-    modelMatrix = glm::mat4(1.0f); // Reset model matrix to identity
+    RenderDamage::invalidate();
+    glm::mat4 originalModelMatrix = localMatrix(); // Save the original model matrix
 
     glm::vec3 normalizedAxis = glm::normalize(axis); // Normalize the axis
     glm::mat4 tempMat = glm::mat4(1.0f); // Start with an identity matrix
@@ -2433,13 +2575,13 @@ void Cube::rotateAbout(float angle, glm::vec3 axis, glm::vec3 point)
     tempMat = glm::rotate(tempMat, glm::radians(angle), normalizedAxis);
     tempMat = glm::translate(tempMat, -point);
 
-    modelMatrix = tempMat * originalModelMatrix; // Apply the rotation to the original matrix
+    setLocalMatrix(tempMat * originalModelMatrix); // Apply the rotation to the original matrix
 }
 
 glm::vec3 Cube::getCenterPoint()
 {
     // get the center of the cube form the model matrix
-    glm::vec4 center = modelMatrix * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+    glm::vec4 center = localMatrix() * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
     return glm::vec3(center.x, center.y, center.z);
 }
 
@@ -2459,27 +2601,31 @@ float Cube::getWidth()
 
 void Cube::capturePosition()
 {
-    this->capturedModelMatrix = this->modelMatrix;
+    this->capturedModelMatrix = localMatrix();
     this->capturedViewMatrix = this->viewMatrix;
     this->capturedProjectionMatrix = this->projectionMatrix;
 }
 
 void Cube::restorePosition()
 {
-    this->modelMatrix = this->capturedModelMatrix;
+    RenderDamage::invalidate();
+    setLocalMatrix(this->capturedModelMatrix);
     this->viewMatrix = this->capturedViewMatrix;
     this->projectionMatrix = this->capturedProjectionMatrix;
 }
 
 void Cube::setVisibility(bool visible)
 {
+    if (this->visible != visible) {
+        RenderDamage::invalidate();
+    }
     this->visible = visible;
 }
 
 void Cube::getRestorePositionDiff(glm::mat4* modelMatrix, glm::mat4* viewMatrix, glm::mat4* projectionMatrix)
 {
     this->mutex.lock();
-    *modelMatrix = this->capturedModelMatrix - this->modelMatrix;
+    *modelMatrix = this->capturedModelMatrix - localMatrix();
     *viewMatrix = this->capturedViewMatrix - this->viewMatrix;
     *projectionMatrix = this->capturedProjectionMatrix - this->projectionMatrix;
     this->mutex.unlock();
@@ -2487,7 +2633,7 @@ void Cube::getRestorePositionDiff(glm::mat4* modelMatrix, glm::mat4* viewMatrix,
 
 glm::mat4 Cube::getModelMatrix()
 {
-    return this->modelMatrix;
+    return localMatrix();
 }
 glm::mat4 Cube::getViewMatrix()
 {
@@ -2497,12 +2643,19 @@ glm::mat4 Cube::getProjectionMatrix()
 {
     return this->projectionMatrix;
 }
+
+uint64_t Cube::drawKey()
+{
+    return DrawList::key(this->shader, 0);
+}
 //////////////////////////////////////////////////////////////////////////////////////////
 
 OBJObject::OBJObject(Shader* sh, std::vector<Vertex> vertices)
 {
     this->shader = sh;
     this->vertexData = vertices;
+    this->center = centerOf(this->vertexData);
+    this->width = widthOf(this->vertexData);
     glGenVertexArrays(1, &VAO);
     glGenBuffers(1, &VBO);
     glBindVertexArray(VAO);
@@ -2513,8 +2666,8 @@ OBJObject::OBJObject(Shader* sh, std::vector<Vertex> vertices)
     glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)(3 * sizeof(float)));
     glEnableVertexAttribArray(1);
     glBindVertexArray(0);
-    setProjectionMatrix(glm::perspective(glm::radians(45.0f), 720.0f / 720.0f, 0.1f, 100.0f));
-    setViewMatrix(glm::vec3(0.0f, 0.0f, 6.0f));
+    setProjectionMatrix(Camera::scene().projection());
+    setViewMatrix(Camera::scene().view());
     glm::mat4 modelMatrix = glm::mat4(1.0f);
     // modelMatrix = glm::rotate(modelMatrix, glm::radians(0.f), glm::vec3(0.0f, 1.0f, 0.0f));
     modelMatrix = glm::translate(modelMatrix, glm::vec3(0.0f, 0.0f, 0.0f));
@@ -2524,23 +2677,53 @@ OBJObject::OBJObject(Shader* sh, std::vector<Vertex> vertices)
     CubeLog::info("Created OBJObject");
 }
 
+OBJObject::OBJObject(Shader* sh, std::span<const Vertex> vertices, std::span<const uint32_t> indices, glm::vec3 center, float width)
+{
+    this->shader = sh;
+    // keep a copy for getVertices(); the GPU buffers are filled straight from the caller's memory
+    this->vertexData.assign(vertices.begin(), vertices.end());
+    this->faceData.assign(indices.begin(), indices.end());
+    this->center = center;
+    this->width = width;
+    glGenVertexArrays(1, &VAO);
+    glGenBuffers(1, &VBO);
+    glGenBuffers(1, &EBO);
+    glBindVertexArray(VAO);
+    glBindBuffer(GL_ARRAY_BUFFER, VBO);
+    glBufferData(GL_ARRAY_BUFFER, vertices.size_bytes(), vertices.data(), GL_STATIC_DRAW);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, EBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, indices.size_bytes(), indices.data(), GL_STATIC_DRAW);
+    glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, sizeof(Vertex), (void*)(3 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+    glBindVertexArray(0);
+    setProjectionMatrix(Camera::scene().projection());
+    setViewMatrix(Camera::scene().view());
+    setModelMatrix(glm::mat4(1.0f));
+    CubeLog::info("Created OBJObject");
+}
+
 void OBJObject::draw()
 {
     if (!visible)
         return;
     this->mutex.lock();
     shader->use();
-    shader->setMat4("model", modelMatrix);
-    shader->setMat4("view", viewMatrix);
-    shader->setMat4("projection", projectionMatrix);
+    shader->setMat4(ShaderUniform::MODEL, Camera::scene().modelFor(projectionMatrix, viewMatrix, worldMatrix()));
     glBindVertexArray(VAO);
-    glDrawArrays(GL_TRIANGLES, 0, this->vertexData.size());
+    if (EBO) {
+        glDrawElements(GL_TRIANGLES, this->faceData.size(), GL_UNSIGNED_INT, (void*)0);
+    } else {
+        glDrawArrays(GL_TRIANGLES, 0, this->vertexData.size());
+    }
     glBindVertexArray(0);
     this->mutex.unlock();
 }
 
 void OBJObject::setProjectionMatrix(glm::mat4 projection)
 {
+    RenderDamage::invalidate();
     this->mutex.lock();
     this->projectionMatrix = projection;
     this->mutex.unlock();
@@ -2548,6 +2731,7 @@ void OBJObject::setProjectionMatrix(glm::mat4 projection)
 
 void OBJObject::setViewMatrix(glm::vec3 view)
 {
+    RenderDamage::invalidate();
     this->mutex.lock();
     this->viewMatrix = glm::lookAt(view, glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 1.0f, 0.0f));
     this->mutex.unlock();
@@ -2555,6 +2739,7 @@ void OBJObject::setViewMatrix(glm::vec3 view)
 
 void OBJObject::setViewMatrix(glm::mat4 viewMatrix)
 {
+    RenderDamage::invalidate();
     this->mutex.lock();
     this->viewMatrix = viewMatrix;
     this->mutex.unlock();
@@ -2562,29 +2747,33 @@ void OBJObject::setViewMatrix(glm::mat4 viewMatrix)
 
 void OBJObject::setModelMatrix(glm::mat4 model)
 {
+    RenderDamage::invalidate();
     this->mutex.lock();
-    this->modelMatrix = model;
+    setLocalMatrix(model);
     this->mutex.unlock();
 }
 
 void OBJObject::rotate(float angle, glm::vec3 axis)
 {
+    RenderDamage::invalidate();
     this->mutex.lock();
-    modelMatrix = glm::rotate(modelMatrix, glm::radians(angle), axis);
+    setLocalMatrix(glm::rotate(localMatrix(), glm::radians(angle), axis));
     this->mutex.unlock();
 }
 
 void OBJObject::translate(glm::vec3 translation)
 {
+    RenderDamage::invalidate();
     this->mutex.lock();
-    modelMatrix = glm::translate(modelMatrix, translation);
+    setLocalMatrix(glm::translate(localMatrix(), translation));
     this->mutex.unlock();
 }
 
 void OBJObject::scale(glm::vec3 scale)
 {
+    RenderDamage::invalidate();
     this->mutex.lock();
-    modelMatrix = glm::scale(modelMatrix, scale);
+    setLocalMatrix(glm::scale(localMatrix(), scale));
     this->mutex.unlock();
 }
 
@@ -2592,18 +2781,23 @@ OBJObject::~OBJObject()
 {
     glDeleteVertexArrays(1, &VAO);
     glDeleteBuffers(1, &VBO);
+    if (EBO) {
+        glDeleteBuffers(1, &EBO);
+    }
 }
 
 void OBJObject::uniformScale(float scale)
 {
+    RenderDamage::invalidate();
     this->scale(glm::vec3(scale, scale, scale));
 }
 
 void OBJObject::rotateAbout(float angle, glm::vec3 point)
 {
+    RenderDamage::invalidate();
     this->mutex.lock();
-    glm::mat4 originalModelMatrix = modelMatrix; // Save the original model matrix
-    modelMatrix = glm::mat4(1.0f); // Reset model matrix to identity
+    glm::mat4 originalModelMatrix = localMatrix(); // Save the original model matrix
+    setLocalMatrix(glm::mat4(1.0f)); // Reset model matrix to identity
 
     glm::vec3 axis = glm::normalize(point - getCenterPoint()); // Normalize the axis
     glm::mat4 tempMat = glm::mat4(1.0f); // Start with an identity matrix
@@ -2611,15 +2805,15 @@ void OBJObject::rotateAbout(float angle, glm::vec3 point)
     tempMat = glm::rotate(tempMat, glm::radians(angle), axis);
     tempMat = glm::translate(tempMat, -point);
 
-    modelMatrix = tempMat * originalModelMatrix; // Apply the rotation to the original matrix
+    setLocalMatrix(tempMat * originalModelMatrix); // Apply the rotation to the original matrix
     this->mutex.unlock();
 }
 
 void OBJObject::rotateAbout(float angle, glm::vec3 axis, glm::vec3 point)
 {
+    RenderDamage::invalidate();
     this->mutex.lock();
-    glm::mat4 originalModelMatrix = modelMatrix; // Save the original model matrix
-    modelMatrix = glm::mat4(1.0f); // Reset model matrix to identity
+    glm::mat4 originalModelMatrix = localMatrix(); // Save the original model matrix
 
     glm::vec3 normalizedAxis = glm::normalize(axis); // Normalize the axis
     glm::mat4 tempMat = glm::mat4(1.0f); // Start with an identity matrix
@@ -2627,42 +2821,62 @@ void OBJObject::rotateAbout(float angle, glm::vec3 axis, glm::vec3 point)
     tempMat = glm::rotate(tempMat, glm::radians(angle), normalizedAxis);
     tempMat = glm::translate(tempMat, -point);
 
-    modelMatrix = tempMat * originalModelMatrix; // Apply the rotation to the original matrix
+    setLocalMatrix(tempMat * originalModelMatrix); // Apply the rotation to the original matrix
     this->mutex.unlock();
 }
 
-glm::vec3 OBJObject::getCenterPoint()
+glm::vec3 OBJObject::centerOf(const std::vector<Vertex>& vertices)
 {
-    // get the center of the object by parsing the vertex data
+    // get the center of the object by averaging the vertex data
     float x = 0, y = 0, z = 0;
-    for (size_t i = 0; i < this->vertexData.size(); i++) {
-        x += this->vertexData[i].x;
-        y += this->vertexData[i].y;
-        z += this->vertexData[i].z;
+    for (size_t i = 0; i < vertices.size(); i++) {
+        x += vertices[i].x;
+        y += vertices[i].y;
+        z += vertices[i].z;
+    }
+    x /= vertices.size();
+    y /= vertices.size();
+    z /= vertices.size();
+    return glm::vec3(x, y, z);
+}
+
+float OBJObject::widthOf(const std::vector<Vertex>& vertices)
+{
+    if (vertices.size() < 2) {
+        return 0.0f;
     }
-    x /= this->vertexData.size();
-    y /= this->vertexData.size();
-    z /= this->vertexData.size();
+    return vertices[0].x - vertices[1].x;
+}
 
-    // move this point to incorporate the model matrix
-    glm::vec4 center = modelMatrix * glm::vec4(x, y, z, 1.0f);
+glm::vec3 OBJObject::getCenterPoint()
+{
+    // move the model space center to incorporate the model matrix
+    glm::vec4 center = localMatrix() * glm::vec4(this->center, 1.0f);
     return glm::vec3(center.x, center.y, center.z);
 }
 
 std::vector<Vertex> OBJObject::getVertices()
 {
-    return this->vertexData;
+    if (this->faceData.empty()) {
+        return this->vertexData;
+    }
+    std::vector<Vertex> vertices;
+    vertices.reserve(this->faceData.size());
+    for (auto index : this->faceData) {
+        vertices.push_back(this->vertexData[index]);
+    }
+    return vertices;
 }
 
 float OBJObject::getWidth()
 {
-    return this->vertexData[0].x - this->vertexData[1].x;
+    return this->width;
 }
 
 void OBJObject::capturePosition()
 {
     this->mutex.lock();
-    this->capturedModelMatrix = this->modelMatrix;
+    this->capturedModelMatrix = localMatrix();
     this->capturedViewMatrix = this->viewMatrix;
     this->capturedProjectionMatrix = this->projectionMatrix;
     this->mutex.unlock();
@@ -2670,8 +2884,9 @@ void OBJObject::capturePosition()
 
 void OBJObject::restorePosition()
 {
+    RenderDamage::invalidate();
     this->mutex.lock();
-    this->modelMatrix = this->capturedModelMatrix;
+    setLocalMatrix(this->capturedModelMatrix);
     this->viewMatrix = this->capturedViewMatrix;
     this->projectionMatrix = this->capturedProjectionMatrix;
     this->mutex.unlock();
@@ -2679,13 +2894,16 @@ void OBJObject::restorePosition()
 
 void OBJObject::setVisibility(bool visible)
 {
+    if (this->visible != visible) {
+        RenderDamage::invalidate();
+    }
     this->visible = visible;
 }
 
 void OBJObject::getRestorePositionDiff(glm::mat4* modelMatrix, glm::mat4* viewMatrix, glm::mat4* projectionMatrix)
 {
     this->mutex.lock();
-    *modelMatrix = this->capturedModelMatrix - this->modelMatrix;
+    *modelMatrix = this->capturedModelMatrix - localMatrix();
     *viewMatrix = this->capturedViewMatrix - this->viewMatrix;
     *projectionMatrix = this->capturedProjectionMatrix - this->projectionMatrix;
     this->mutex.unlock();
@@ -2693,7 +2911,7 @@ void OBJObject::getRestorePositionDiff(glm::mat4* modelMatrix, glm::mat4* viewMa
 
 glm::mat4 OBJObject::getModelMatrix()
 {
-    return this->modelMatrix;
+    return localMatrix();
 }
 glm::mat4 OBJObject::getViewMatrix()
 {
@@ -2704,4 +2922,9 @@ glm::mat4 OBJObject::getProjectionMatrix()
     return this->projectionMatrix;
 }
 
+uint64_t OBJObject::drawKey()
+{
+    return DrawList::key(this->shader, 0);
+}
+
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -39,20 +39,21 @@ SOFTWARE.
 #ifndef GLOBAL_SETTINGS_H
 #include "settings/globalSettings.h"
 #endif // GLOBAL_SETTINGS_H
+#include "glyphAtlas.h"
+#include "primitiveBatch.h"
+#include "textLayout.h"
+#include "../camera.h"
+#include "../drawList.h"
+#include "../renderDamage.h"
 #include <ft2build.h>
 #include FT_FREETYPE_H
+#include <atomic>
 #include <cstdint>
 #include <map>
+#include <span>
 
 #define STENCIL_INSET_PX 10
 
-struct Character {
-    unsigned int textureID; // ID handle of the glyph texture
-    glm::ivec2 size; // Size of glyph
-    glm::ivec2 bearing; // Offset from baseline to left/top of glyph
-    FT_Pos advance; // Offset to advance to next glyph
-};
-
 class M_Text : public MeshObject {
 private:
     Shader* shader;
@@ -60,24 +61,38 @@ private:
     GLuint VAO, VBO;
     glm::mat4 projectionMatrix;
     glm::mat4 viewMatrix;
-    glm::mat4 modelMatrix;
     std::string text;
     float fontSize;
     glm::vec3 color;
     glm::vec3 centerPoint;
     glm::vec2 position;
     float scale_;
-    std::map<uint32_t, Character> characters;
     std::vector<uint32_t> glyphCodepoints;
     float width = 0.f;
+    // Quads for the whole string live in VBO, grouped by atlas page; normally a single range.
+    struct DrawRange {
+        uint16_t page;
+        GLint first;
+        GLsizei count;
+    };
+    std::vector<DrawRange> drawRanges;
+    int pixelSize = 0;
+    uint64_t atlasEpoch = 0;
+    glm::vec4 extents { 0.f }; // min x, min y, max x, max y of the glyph quads, relative to position
+    void damage();
     void buildText();
-    bool loadGlyph(uint32_t codepoint);
-    const Character* findCharacterForCodepoint(uint32_t codepoint) const;
-    void clearGlyphTextures();
+    void buildVertices();
+    const AtlasGlyph* glyphFor(uint32_t codepoint);
+    const AtlasGlyph* rasterizeGlyph(uint32_t codepoint);
+    static std::atomic<uint64_t> drawCalls;
     static FT_Library ft;
     static FT_Face face;
     static bool faceInitialized;
-    bool reloadFace = false;
+    static std::string facePath;
+    // Bumped by the font setting callback; each string compares it with the generation it was built for.
+    static std::atomic<uint64_t> selectedFontGeneration;
+    static uint64_t faceGeneration;
+    uint64_t fontGeneration = 0;
     glm::mat4 capturedProjectionMatrix;
     glm::mat4 capturedViewMatrix;
     glm::mat4 capturedModelMatrix;
@@ -104,6 +119,8 @@ public:
     void rotateAbout(float angle, glm::vec3 point);
     glm::vec3 getCenterPoint();
     std::vector<Vertex> getVertices();
+    // Size of the glyph quads uploaded for this string.
+    size_t vertexBytes() const;
     void setPosition(glm::vec2 position);
     void setText(const std::string& text);
     float getWidth();
@@ -112,7 +129,11 @@ public:
     void restorePosition();
     void setVisibility(bool visible);
     void getRestorePositionDiff(glm::mat4* modelMatrix, glm::mat4* viewMatrix, glm::mat4* projectionMatrix);
+    uint64_t drawKey();
     void setColor(glm::vec3 color);
+    // Number of glDrawArrays calls issued by all M_Text instances so far.
+    static uint64_t totalDrawCalls();
+    static void preload(const TextLayout::Result& layout);
 };
 
 class M_PartCircle : public MeshObject {
@@ -122,7 +143,6 @@ private:
     GLuint VAO[1], VBO[1];
     glm::mat4 projectionMatrix;
     glm::mat4 viewMatrix;
-    glm::mat4 modelMatrix;
     float radius;
     glm::vec3 centerPoint;
     unsigned int numSegments;
@@ -158,6 +178,7 @@ public:
     void restorePosition();
     void setVisibility(bool visible);
     void getRestorePositionDiff(glm::mat4* modelMatrix, glm::mat4* viewMatrix, glm::mat4* projectionMatrix);
+    uint64_t drawKey();
 };
 
 class M_Rect : public MeshObject {
@@ -170,7 +191,6 @@ private:
     GLuint VAO[2], VBO[2];
     glm::mat4 projectionMatrix;
     glm::mat4 viewMatrix;
-    glm::mat4 modelMatrix;
     glm::mat4 capturedProjectionMatrix;
     glm::mat4 capturedViewMatrix;
     glm::mat4 capturedModelMatrix;
@@ -201,6 +221,7 @@ public:
     void restorePosition();
     void setVisibility(bool visible);
     void getRestorePositionDiff(glm::mat4* modelMatrix, glm::mat4* viewMatrix, glm::mat4* projectionMatrix);
+    uint64_t drawKey();
 };
 
 class M_Line : public MeshObject {
@@ -210,7 +231,6 @@ private:
     GLuint VAO[1], VBO[1];
     glm::mat4 projectionMatrix;
     glm::mat4 viewMatrix;
-    glm::mat4 modelMatrix;
     glm::mat4 capturedProjectionMatrix;
     glm::mat4 capturedViewMatrix;
     glm::mat4 capturedModelMatrix;
@@ -241,6 +261,7 @@ public:
     void restorePosition();
     void setVisibility(bool visible);
     void getRestorePositionDiff(glm::mat4* modelMatrix, glm::mat4* viewMatrix, glm::mat4* projectionMatrix);
+    uint64_t drawKey();
 };
 
 class M_Arc : public MeshObject {
@@ -255,7 +276,6 @@ private:
     GLuint VAO[1], VBO[1];
     glm::mat4 projectionMatrix;
     glm::mat4 viewMatrix;
-    glm::mat4 modelMatrix;
     glm::mat4 capturedProjectionMatrix;
     glm::mat4 capturedViewMatrix;
     glm::mat4 capturedModelMatrix;
@@ -288,6 +308,7 @@ public:
     void restorePosition();
     void setVisibility(bool visible);
     void getRestorePositionDiff(glm::mat4* modelMatrix, glm::mat4* viewMatrix, glm::mat4* projectionMatrix);
+    uint64_t drawKey();
 };
 
 #define RADIOBUTTON_INNER_OUTER_RATIO 0.8f
@@ -301,7 +322,6 @@ private:
     GLuint textureSelected, textureUnselected;
     glm::mat4 projectionMatrix;
     glm::mat4 viewMatrix;
-    glm::mat4 modelMatrix;
     bool selected;
     float radioSize;
     unsigned int padding;
@@ -342,6 +362,7 @@ public:
     void capturePosition();
     void restorePosition();
     void getRestorePositionDiff(glm::mat4* modelMatrix, glm::mat4* viewMatrix, glm::mat4* projectionMatrix);
+    uint64_t drawKey();
     float getWidth();
 };
 
@@ -356,7 +377,6 @@ private:
     GLuint textureSelected, textureUnselected;
     glm::mat4 projectionMatrix;
     glm::mat4 viewMatrix;
-    glm::mat4 modelMatrix;
     bool selected;
     float toggleWidth;
     float toggleHeight;
@@ -398,6 +418,7 @@ public:
     void capturePosition();
     void restorePosition();
     void getRestorePositionDiff(glm::mat4* modelMatrix, glm::mat4* viewMatrix, glm::mat4* projectionMatrix);
+    uint64_t drawKey();
     float getWidth();
 };
 
@@ -411,7 +432,6 @@ private:
     GLuint thumbBorderTexture, thumbFillTexture, lineTexture, backgroundTexture;
     glm::mat4 projectionMatrix;
     glm::mat4 viewMatrix;
-    glm::mat4 modelMatrix;
     float sliderWidth;
     float sliderHeight;
     unsigned int padding;
@@ -451,9 +471,11 @@ public:
     void capturePosition();
     void restorePosition();
     void getRestorePositionDiff(glm::mat4* modelMatrix, glm::mat4* viewMatrix, glm::mat4* projectionMatrix);
+    uint64_t drawKey();
     float getWidth();
     void setSliderPosition(float position)
     {
+        RenderDamage::invalidate();
         if (position < 0.f) {
             this->sliderPosition = 0.f;
         } else if (position > 1.f) {
@@ -546,7 +568,6 @@ public:
     Shader* shader;
     glm::mat4 projectionMatrix;
     glm::mat4 viewMatrix;
-    glm::mat4 modelMatrix;
 
     void draw();
     void setProjectionMatrix(glm::mat4 projectionMatrix);
@@ -569,6 +590,7 @@ public:
     void restorePosition();
     void setVisibility(bool visible);
     void getRestorePositionDiff(glm::mat4* modelMatrix, glm::mat4* viewMatrix, glm::mat4* projectionMatrix);
+    uint64_t drawKey();
 };
 
 // TODO: create a generic object class that can utilize vertex and face data loaded from a file
@@ -577,11 +599,12 @@ class OBJObject : public MeshObject {
 private:
     Shader* shader;
     std::vector<Vertex> vertexData;
-    std::vector<unsigned int> faceData;
-    GLuint VAO, VBO, EBO;
+    std::vector<unsigned int> faceData; // empty unless built from a MeshBundle, then indexes vertexData
+    GLuint VAO, VBO, EBO = 0;
+    glm::vec3 center;
+    float width;
     glm::mat4 projectionMatrix;
     glm::mat4 viewMatrix;
-    glm::mat4 modelMatrix;
     glm::mat4 capturedProjectionMatrix;
     glm::mat4 capturedViewMatrix;
     glm::mat4 capturedModelMatrix;
@@ -590,7 +613,12 @@ private:
 
 public:
     OBJObject(Shader* sh, std::vector<Vertex> vertices);
+    // Uploads an indexed mesh as mapped from a MeshBundle; center and width are the values the
+    // vertex constructor would have computed.
+    OBJObject(Shader* sh, std::span<const Vertex> vertices, std::span<const uint32_t> indices, glm::vec3 center, float width);
     ~OBJObject();
+    static glm::vec3 centerOf(const std::vector<Vertex>& vertices);
+    static float widthOf(const std::vector<Vertex>& vertices);
     void draw();
     void setProjectionMatrix(glm::mat4 projectionMatrix);
     void setViewMatrix(glm::vec3 viewMatrix);
@@ -612,6 +640,7 @@ public:
     void restorePosition();
     void setVisibility(bool visible);
     void getRestorePositionDiff(glm::mat4* modelMatrix, glm::mat4* viewMatrix, glm::mat4* projectionMatrix);
+    uint64_t drawKey();
 };
 
 #endif // SHAPES_H
@@ -0,0 +1,362 @@
+/*
+████████╗███████╗██╗  ██╗████████╗██╗      █████╗ ██╗   ██╗ ██████╗ ██╗   ██╗████████╗    ██████╗██████╗ ██████╗
+╚══██╔══╝██╔════╝╚██╗██╔╝╚══██╔══╝██║     ██╔══██╗╚██╗ ██╔╝██╔═══██╗██║   ██║╚══██╔══╝   ██╔════╝██╔══██╗██╔══██╗
+   ██║   █████╗   ╚███╔╝    ██║   ██║     ███████║ ╚████╔╝ ██║   ██║██║   ██║   ██║      ██║     ██████╔╝██████╔╝
+   ██║   ██╔══╝   ██╔██╗    ██║   ██║     ██╔══██║  ╚██╔╝  ██║   ██║██║   ██║   ██║      ██║     ██╔═══╝ ██╔═══╝
+   ██║   ███████╗██╔╝ ██╗   ██║   ███████╗██║  ██║   ██║   ╚██████╔╝╚██████╔╝   ██║   ██╗╚██████╗██║     ██║
+   ╚═╝   ╚══════╝╚═╝  ╚═╝   ╚═╝   ╚══════╝╚═╝  ╚═╝   ╚═╝    ╚═════╝  ╚═════╝    ╚═╝   ╚═╝ ╚═════╝╚═╝     ╚═╝
+*/
+
+/*
+MIT License
+
+Copyright (c) 2026 A-McD Technology LLC
+*/
+
+
+#include "textLayout.h"
+#include "../renderDamage.h"
+#include <algorithm>
+#include <cctype>
+#include <filesystem>
+#include <logger.h>
+#include <settings/globalSettings.h>
+#include <sstream>
+
+namespace {
+
+bool isRenderableTextCodepoint(uint32_t codepoint)
+{
+    if (codepoint == 0 || codepoint == 0xFEFF || codepoint == 0xFFFD) {
+        return false;
+    }
+    if (codepoint < 0x20 || (codepoint >= 0x7F && codepoint <= 0x9F)) {
+        return false;
+    }
+    if ((codepoint >= 0x200B && codepoint <= 0x200F)
+        || (codepoint >= 0x202A && codepoint <= 0x202E)
+        || (codepoint >= 0x2060 && codepoint <= 0x206F)
+        || (codepoint >= 0xFE00 && codepoint <= 0xFE0F)) {
+        return false;
+    }
+    return true;
+}
+
+} // namespace
+
+TextLayout::TextLayout(size_t capacity, GlyphSource source)
+    : capacity(std::max<size_t>(capacity, 1))
+    , source(std::move(source))
+{
+    if (!this->source) {
+        this->source = [this](const std::string& fontPath, uint32_t codepoint, int pixelSize) {
+            return this->renderWithFreeType(fontPath, codepoint, pixelSize);
+        };
+    }
+    this->worker = std::jthread([this](std::stop_token stop) { this->run(stop); });
+}
+
+TextLayout::~TextLayout()
+{
+    this->worker.request_stop();
+    if (this->worker.joinable()) {
+        this->worker.join();
+    }
+    if (this->ftFace != nullptr) {
+        FT_Done_Face(this->ftFace);
+    }
+    if (this->ftLibrary != nullptr) {
+        FT_Done_FreeType(this->ftLibrary);
+    }
+}
+
+TextLayout& TextLayout::shared()
+{
+    static TextLayout layout;
+    return layout;
+}
+
+std::string TextLayout::fontPath()
+{
+    std::string path = GlobalSettings::getSettingOfType<std::string>(GlobalSettings::SettingType::SELECTED_FONT_PATH);
+    if (!std::filesystem::exists(path)) {
+        path = "fonts/Roboto/Roboto-Regular.ttf";
+    }
+    return path;
+}
+
+std::vector<uint32_t> TextLayout::codepoints(const std::string& text)
+{
+    std::vector<uint32_t> codepoints;
+    codepoints.reserve(text.size());
+
+    const auto* bytes = reinterpret_cast<const unsigned char*>(text.data());
+    size_t index = 0;
+    while (index < text.size()) {
+        const unsigned char lead = bytes[index];
+        uint32_t codepoint = 0;
+        size_t sequenceLength = 0;
+        uint32_t minValue = 0;
+        if (lead < 0x80) {
+            codepoint = lead;
+            sequenceLength = 1;
+        } else if ((lead & 0xE0) == 0xC0) {
+            codepoint = lead & 0x1F;
+            sequenceLength = 2;
+            minValue = 0x80;
+        } else if ((lead & 0xF0) == 0xE0) {
+            codepoint = lead & 0x0F;
+            sequenceLength = 3;
+            minValue = 0x800;
+        } else if ((lead & 0xF8) == 0xF0) {
+            codepoint = lead & 0x07;
+            sequenceLength = 4;
+            minValue = 0x10000;
+        } else {
+            codepoints.push_back(static_cast<uint32_t>('?'));
+            ++index;
+            continue;
+        }
+
+        if (index + sequenceLength > text.size()) {
+            codepoints.push_back(static_cast<uint32_t>('?'));
+            ++index;
+            continue;
+        }
+
+        bool valid = true;
+        for (size_t offset = 1; offset < sequenceLength; ++offset) {
+            const unsigned char continuation = bytes[index + offset];
+            if ((continuation & 0xC0) != 0x80) {
+                valid = false;
+                break;
+            }
+            codepoint = (codepoint << 6) | static_cast<uint32_t>(continuation & 0x3F);
+        }
+
+        if (!valid
+            || codepoint < minValue
+            || codepoint > 0x10FFFF
+            || (codepoint >= 0xD800 && codepoint <= 0xDFFF)) {
+            codepoints.push_back(static_cast<uint32_t>('?'));
+            ++index;
+            continue;
+        }
+
+        if (isRenderableTextCodepoint(codepoint)) {
+            codepoints.push_back(codepoint);
+        }
+        index += sequenceLength;
+    }
+
+    return codepoints;
+}
+
+std::vector<TextLayout::Line> TextLayout::wrap(const std::string& text, float maxWidth, const std::function<float(uint32_t)>& advance)
+{
+    auto measure = [&advance](const std::string& word) {
+        float width = 0.f;
+        for (uint32_t codepoint : codepoints(word)) {
+            width += advance(codepoint);
+        }
+        return width;
+    };
+    const float spaceWidth = advance(static_cast<uint32_t>(' '));
+
+    std::vector<Line> lines;
+    std::istringstream textStream(text);
+    std::string paragraph;
+    while (std::getline(textStream, paragraph)) {
+        if (paragraph.empty()) {
+            lines.push_back({});
+            continue;
+        }
+        std::istringstream wordStream(paragraph);
+        std::string word;
+        Line current;
+        bool started = false;
+        while (wordStream >> word) {
+            const float wordWidth = measure(word);
+            if (!started) {
+                current = { word, wordWidth };
+                started = true;
+            } else if (current.width + spaceWidth + wordWidth <= maxWidth) {
+                current.text += " " + word;
+                current.width += spaceWidth + wordWidth;
+            } else {
+                lines.push_back(std::move(current));
+                current = { word, wordWidth };
+            }
+        }
+        if (started) {
+            lines.push_back(std::move(current));
+        }
+    }
+    if (lines.empty()) {
+        lines.push_back({ text, measure(text) });
+    }
+    return lines;
+}
+
+size_t TextLayout::KeyHash::operator()(const Key& key) const
+{
+    size_t hash = key.textHash;
+    hash ^= std::hash<std::string> {}(key.fontPath) + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+    hash ^= static_cast<size_t>(key.pixelSize) * 0x100000001b3ULL + (hash << 6) + (hash >> 2);
+    hash ^= static_cast<size_t>(key.maxWidth) + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2);
+    return hash;
+}
+
+std::shared_ptr<const TextLayout::Result> TextLayout::request(const std::string& text, int pixelSize, int maxWidth, Ready onReady)
+{
+    return this->request(fontPath(), text, pixelSize, maxWidth, std::move(onReady));
+}
+
+std::shared_ptr<const TextLayout::Result> TextLayout::request(const std::string& fontPath, const std::string& text, int pixelSize, int maxWidth, Ready onReady)
+{
+    Key key { fontPath, pixelSize, maxWidth, std::hash<std::string> {}(text) };
+    std::lock_guard<std::mutex> lock(this->mutex);
+    if (auto cached = this->find(key, text)) {
+        this->counters.hits++;
+        return cached;
+    }
+    this->counters.misses++;
+    // Another box (or the same one, a frame earlier) may already be waiting on this text.
+    for (auto& job : this->jobs) {
+        if (job.key == key && job.text == text) {
+            if (onReady) {
+                job.callbacks.push_back(std::move(onReady));
+            }
+            return nullptr;
+        }
+    }
+    Job job { std::move(key), text, {} };
+    if (onReady) {
+        job.callbacks.push_back(std::move(onReady));
+    }
+    this->jobs.push_back(std::move(job));
+    this->wake.notify_one();
+    return nullptr;
+}
+
+std::shared_ptr<const TextLayout::Result> TextLayout::find(const Key& key, const std::string& text)
+{
+    auto it = this->index.find(key);
+    if (it == this->index.end() || it->second->text != text) {
+        return nullptr;
+    }
+    this->lru.splice(this->lru.begin(), this->lru, it->second);
+    return it->second->result;
+}
+
+std::shared_ptr<const TextLayout::Result> TextLayout::layoutNow(const std::string& fontPath, const std::string& text, int pixelSize, int maxWidth)
+{
+    auto result = std::make_shared<Result>();
+    result->fontPath = fontPath;
+    result->pixelSize = pixelSize;
+
+    // Advance in whole pixels, rounded the way M_Text moves its pen so measured widths match what is
+    // drawn. Anything the font can't render is measured as the '?' M_Text draws in its place.
+    std::unordered_map<uint32_t, std::optional<float>> advances;
+    auto lookup = [&](uint32_t codepoint) -> std::optional<float> {
+        if (auto it = advances.find(codepoint); it != advances.end()) {
+            return it->second;
+        }
+        std::optional<float> pixels;
+        if (auto glyph = this->source(fontPath, codepoint, pixelSize)) {
+            pixels = static_cast<float>(glyph->advance >> 6);
+            result->glyphs.push_back(std::move(*glyph));
+        }
+        advances[codepoint] = pixels;
+        return pixels;
+    };
+    auto advance = [&](uint32_t codepoint) {
+        if (auto pixels = lookup(codepoint)) {
+            return *pixels;
+        }
+        return lookup(static_cast<uint32_t>('?')).value_or(0.f);
+    };
+    result->lines = wrap(text, static_cast<float>(maxWidth), advance);
+    return result;
+}
+
+std::optional<TextLayout::Glyph> TextLayout::renderWithFreeType(const std::string& fontPath, uint32_t codepoint, int pixelSize)
+{
+    if (this->ftLibrary == nullptr && FT_Init_FreeType(&this->ftLibrary)) {
+        CubeLog::error("TextLayout: could not init FreeType");
+        this->ftLibrary = nullptr;
+        return std::nullopt;
+    }
+    if (this->ftFace == nullptr || this->ftFacePath != fontPath) {
+        if (this->ftFace != nullptr) {
+            FT_Done_Face(this->ftFace);
+            this->ftFace = nullptr;
+        }
+        if (FT_New_Face(this->ftLibrary, fontPath.c_str(), 0, &this->ftFace)) {
+            CubeLog::error("TextLayout: failed to load font " + fontPath);
+            this->ftFace = nullptr;
+            return std::nullopt;
+        }
+        FT_Select_Charmap(this->ftFace, FT_ENCODING_UNICODE);
+        this->ftFacePath = fontPath;
+    }
+    if (FT_Set_Pixel_Sizes(this->ftFace, 0, static_cast<FT_UInt>(pixelSize))
+        || FT_Load_Char(this->ftFace, static_cast<FT_ULong>(codepoint), FT_LOAD_RENDER)) {
+        return std::nullopt;
+    }
+    const auto& slot = *this->ftFace->glyph;
+    Glyph glyph;
+    glyph.codepoint = codepoint;
+    glyph.width = static_cast<int>(slot.bitmap.width);
+    glyph.height = static_cast<int>(slot.bitmap.rows);
+    glyph.bearing = { slot.bitmap_left, slot.bitmap_top };
+    glyph.advance = slot.advance.x;
+    glyph.bitmap.resize(static_cast<size_t>(glyph.width) * static_cast<size_t>(glyph.height));
+    for (int row = 0; row < glyph.height; row++) {
+        const unsigned char* src = slot.bitmap.buffer + static_cast<ptrdiff_t>(row) * slot.bitmap.pitch;
+        std::copy_n(src, glyph.width, glyph.bitmap.begin() + static_cast<ptrdiff_t>(row) * glyph.width);
+    }
+    return glyph;
+}
+
+void TextLayout::run(std::stop_token stop)
+{
+    while (!stop.stop_requested()) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(this->mutex);
+            if (!this->wake.wait(lock, stop, [this]() { return !this->jobs.empty(); })) {
+                return;
+            }
+            job = std::move(this->jobs.front());
+            this->jobs.pop_front();
+        }
+        auto result = this->layoutNow(job.key.fontPath, job.text, job.key.pixelSize, job.key.maxWidth);
+        {
+            std::lock_guard<std::mutex> lock(this->mutex);
+            this->counters.built++;
+            if (auto it = this->index.find(job.key); it != this->index.end()) {
+                this->lru.erase(it->second);
+                this->index.erase(it);
+            }
+            this->lru.push_front({ job.key, job.text, result });
+            this->index[job.key] = this->lru.begin();
+            while (this->lru.size() > this->capacity) {
+                this->index.erase(this->lru.back().key);
+                this->lru.pop_back();
+            }
+        }
+        for (auto& callback : job.callbacks) {
+            callback(result);
+        }
+        RenderDamage::invalidate();
+    }
+}
+
+TextLayout::Stats TextLayout::stats()
+{
+    std::lock_guard<std::mutex> lock(this->mutex);
+    Stats stats = this->counters;
+    stats.cached = this->lru.size();
+    return stats;
+}
@@ -0,0 +1,152 @@
+/*
+████████╗███████╗██╗  ██╗████████╗██╗      █████╗ ██╗   ██╗ ██████╗ ██╗   ██╗████████╗   ██╗  ██╗
+╚══██╔══╝██╔════╝╚██╗██╔╝╚══██╔══╝██║     ██╔══██╗╚██╗ ██╔╝██╔═══██╗██║   ██║╚══██╔══╝   ██║  ██║
+   ██║   █████╗   ╚███╔╝    ██║   ██║     ███████║ ╚████╔╝ ██║   ██║██║   ██║   ██║      ███████║
+   ██║   ██╔══╝   ██╔██╗    ██║   ██║     ██╔══██║  ╚██╔╝  ██║   ██║██║   ██║   ██║      ██╔══██║
+   ██║   ███████╗██╔╝ ██╗   ██║   ███████╗██║  ██║   ██║   ╚██████╔╝╚██████╔╝   ██║   ██╗██║  ██║
+   ╚═╝   ╚══════╝╚═╝  ╚═╝   ╚═╝   ╚══════╝╚═╝  ╚═╝   ╚═╝    ╚═════╝  ╚═════╝    ╚═╝   ╚═╝╚═╝  ╚═╝
+*/
+
+/*
+MIT License
+
+Copyright (c) 2026 A-McD Technology LLC
+*/
+
+
+#pragma once
+#ifndef TEXTLAYOUT_H
+#define TEXTLAYOUT_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include <functional>
+#include <glm/glm.hpp>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+/*
+Word-wraps text against real FreeType advances on a worker thread, so showing a long response in a
+message or text box never rasterizes or measures anything on the render thread.
+
+A layout is keyed by (font path, pixel size, wrap width, text) and kept in a small LRU cache. Along
+with the wrapped lines it carries the rendered bitmap of every glyph the text uses; on the render
+thread M_Text::preload() copies those into the glyph atlas, after which building the line strings is
+only vertex assembly and a buffer upload.
+
+request() returns a cached layout straight away. On a miss it queues the work and returns nullptr;
+when the layout is done every callback given for it runs on the worker thread and the render loop is
+woken, so callers either hop back with Renderer::addSetupTask or simply ask again on the next frame.
+
+The worker keeps its own FT_Library and FT_Face: FreeType objects can't be shared with the render
+thread's face.
+*/
+
+class TextLayout {
+public:
+    struct Glyph {
+        uint32_t codepoint = 0;
+        int width = 0;
+        int height = 0;
+        glm::ivec2 bearing { 0 };
+        int64_t advance = 0; // 26.6 fixed point, as reported by FreeType
+        std::vector<unsigned char> bitmap; // width * height bytes, tightly packed
+    };
+
+    struct Line {
+        std::string text;
+        float width = 0.f;
+    };
+
+    struct Result {
+        std::string fontPath;
+        int pixelSize = 0;
+        std::vector<Line> lines;
+        std::vector<Glyph> glyphs;
+    };
+
+    struct Stats {
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t built = 0;
+        size_t cached = 0;
+    };
+
+    using Ready = std::function<void(std::shared_ptr<const Result>)>;
+    // Renders one codepoint of the given font at the given size; nullopt if the font lacks it.
+    using GlyphSource = std::function<std::optional<Glyph>(const std::string& fontPath, uint32_t codepoint, int pixelSize)>;
+
+    // An empty source renders with FreeType.
+    explicit TextLayout(size_t capacity = 32, GlyphSource source = nullptr);
+    ~TextLayout();
+    TextLayout(const TextLayout&) = delete;
+    TextLayout& operator=(const TextLayout&) = delete;
+
+    static TextLayout& shared();
+    // The font M_Text loads: the selected font, or Roboto if that file is missing.
+    static std::string fontPath();
+    // UTF-8 to codepoints; malformed sequences become '?' and control/invisible codepoints are dropped.
+    static std::vector<uint32_t> codepoints(const std::string& text);
+    // Breaks each paragraph at spaces so no line is wider than maxWidth pixels, unless a single word
+    // is. Empty paragraphs are kept as empty lines.
+    static std::vector<Line> wrap(const std::string& text, float maxWidth, const std::function<float(uint32_t)>& advance);
+
+    std::shared_ptr<const Result> request(const std::string& text, int pixelSize, int maxWidth, Ready onReady = nullptr);
+    std::shared_ptr<const Result> request(const std::string& fontPath, const std::string& text, int pixelSize, int maxWidth, Ready onReady);
+    // Lays out on the calling thread, bypassing the cache.
+    std::shared_ptr<const Result> layoutNow(const std::string& fontPath, const std::string& text, int pixelSize, int maxWidth);
+    Stats stats();
+
+private:
+    struct Key {
+        std::string fontPath;
+        int pixelSize;
+        int maxWidth;
+        size_t textHash;
+        bool operator==(const Key&) const = default;
+    };
+    struct KeyHash {
+        size_t operator()(const Key& key) const;
+    };
+    struct Entry {
+        Key key;
+        std::string text;
+        std::shared_ptr<const Result> result;
+    };
+    struct Job {
+        Key key;
+        std::string text;
+        std::vector<Ready> callbacks;
+    };
+
+    std::shared_ptr<const Result> find(const Key& key, const std::string& text);
+    void run(std::stop_token stop);
+    std::optional<Glyph> renderWithFreeType(const std::string& fontPath, uint32_t codepoint, int pixelSize);
+
+    size_t capacity;
+    GlyphSource source;
+    std::mutex mutex;
+    std::condition_variable_any wake;
+    std::list<Entry> lru; // most recently used first
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index;
+    std::deque<Job> jobs;
+    Stats counters;
+
+    // Worker-only FreeType state.
+    FT_Library ftLibrary = nullptr;
+    FT_Face ftFace = nullptr;
+    std::string ftFacePath;
+
+    std::jthread worker;
+};
+
+#endif // TEXTLAYOUT_H
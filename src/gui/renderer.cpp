@@ -32,18 +32,127 @@ SOFTWARE.
 */
 
 #include "renderer.h"
+#include "../telemetry/metrics.h"
+#include "camera.h"
+#include "renderDamage.h"
+#include "sceneGraph.h"
 
 #include <GLFW/glfw3.h>
 
+#include <algorithm>
 #include <chrono>
 #include <cmath>
 #include <cstdlib>
+#include <ctime>
 #include <iostream>
+#include <sys/resource.h>
 
 namespace {
 
 // Aim for 30 FPS with a 5% buffer to avoid going over
 constexpr auto kTargetFrameDuration = std::chrono::duration<double>(1.0 / 30.0 * .95); 
+const auto kFrameBudget = std::chrono::duration_cast<std::chrono::steady_clock::duration>(kTargetFrameDuration);
+// Longest the on-demand loop sleeps with nothing scheduled; bounds how late a new screen message shows up.
+constexpr auto kIdleHeartbeat = std::chrono::milliseconds(250);
+// Keep drawing briefly after input so state changed by handlers that report no damage still lands.
+constexpr auto kInputGracePeriod = std::chrono::milliseconds(300);
+constexpr auto kMetricsWindow = std::chrono::seconds(10);
+
+double threadCpuSeconds()
+{
+    timespec ts {};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return static_cast<double>(ts.tv_sec) + static_cast<double>(ts.tv_nsec) / 1e9;
+}
+
+double processCpuSeconds()
+{
+    rusage usage {};
+    getrusage(RUSAGE_SELF, &usage);
+    return static_cast<double>(usage.ru_utime.tv_sec + usage.ru_stime.tv_sec)
+        + static_cast<double>(usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+}
+
+// Frame counters, plus rates and CPU load sampled over kMetricsWindow so the idle cost is visible.
+class RenderLoopMetrics {
+public:
+    explicit RenderLoopMetrics(std::chrono::steady_clock::time_point createdAt)
+        : createdAt(createdAt)
+    {
+        auto& metrics = Metrics::MetricsRegistry::instance();
+        this->firstFrame = metrics.gauge("gui_boot_first_frame_seconds", "Time from renderer creation to the first presented frame");
+        this->framesRendered = metrics.counter("renderer_frames_rendered_total", "Frames drawn and presented");
+        this->framesPartial = metrics.counter("renderer_frames_partial_total", "Frames redrawn through a scissor rect");
+        this->framesSkipped = metrics.counter("renderer_frames_skipped_total", "Animation ticks that changed nothing on screen");
+        this->framesPerMinute = metrics.gauge("renderer_frames_per_minute", "Frames presented per minute over the last sampling window");
+        this->rendererCpu = metrics.gauge("renderer_cpu_percent", "Render thread CPU time as a percentage of one core");
+        this->processCpu = metrics.gauge("process_cpu_percent", "Process CPU time as a percentage of one core");
+        this->windowStart = std::chrono::steady_clock::now();
+        this->windowThreadCpu = threadCpuSeconds();
+        this->windowProcessCpu = processCpuSeconds();
+    }
+
+    void rendered(bool partial)
+    {
+        if (!this->presented) {
+            this->presented = true;
+            const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - this->createdAt;
+            this->firstFrame->set(elapsed.count());
+            CubeLog::info("First frame presented after " + std::to_string(elapsed.count()) + "s");
+        }
+        this->framesRendered->increment();
+        if (partial) {
+            this->framesPartial->increment();
+        }
+        this->windowFrames++;
+    }
+
+    void skipped() { this->framesSkipped->increment(); }
+
+    void sample(std::chrono::steady_clock::time_point now)
+    {
+        const std::chrono::duration<double> wall = now - this->windowStart;
+        if (wall < kMetricsWindow) {
+            return;
+        }
+        const double threadCpu = threadCpuSeconds();
+        const double processCpu = processCpuSeconds();
+        this->framesPerMinute->set(static_cast<double>(this->windowFrames) * 60.0 / wall.count());
+        this->rendererCpu->set((threadCpu - this->windowThreadCpu) * 100.0 / wall.count());
+        this->processCpu->set((processCpu - this->windowProcessCpu) * 100.0 / wall.count());
+        this->windowStart = now;
+        this->windowThreadCpu = threadCpu;
+        this->windowProcessCpu = processCpu;
+        this->windowFrames = 0;
+    }
+
+private:
+    std::shared_ptr<Metrics::Counter> framesRendered;
+    std::shared_ptr<Metrics::Counter> framesPartial;
+    std::shared_ptr<Metrics::Counter> framesSkipped;
+    std::shared_ptr<Metrics::Gauge> framesPerMinute;
+    std::shared_ptr<Metrics::Gauge> rendererCpu;
+    std::shared_ptr<Metrics::Gauge> processCpu;
+    std::shared_ptr<Metrics::Gauge> firstFrame;
+    std::chrono::steady_clock::time_point createdAt;
+    bool presented = false;
+    std::chrono::steady_clock::time_point windowStart;
+    double windowThreadCpu = 0;
+    double windowProcessCpu = 0;
+    uint64_t windowFrames = 0;
+};
+
+// DamageRect is in the 720x720 UI space; scale it to framebuffer pixels.
+void scissorTo(const DamageRect& rect, int framebufferWidth, int framebufferHeight)
+{
+    const float sx = static_cast<float>(framebufferWidth) / 720.f;
+    const float sy = static_cast<float>(framebufferHeight) / 720.f;
+    const int x0 = std::clamp(static_cast<int>(std::floor(rect.x * sx)), 0, framebufferWidth);
+    const int y0 = std::clamp(static_cast<int>(std::floor(rect.y * sy)), 0, framebufferHeight);
+    const int x1 = std::clamp(static_cast<int>(std::ceil((rect.x + rect.width) * sx)), 0, framebufferWidth);
+    const int y1 = std::clamp(static_cast<int>(std::ceil((rect.y + rect.height) * sy)), 0, framebufferHeight);
+    glScissor(x0, y0, x1 - x0, y1 - y0);
+}
 
 void glfwErrorCallback(int error, const char* description)
 {
@@ -103,6 +212,7 @@ std::optional<CubeEvent> Renderer::popEvent()
 
 void Renderer::pushEvent(const CubeEvent& event)
 {
+    this->lastInput = std::chrono::steady_clock::now();
     this->eventQueue.push(event);
 }
 
@@ -116,6 +226,7 @@ void Renderer::framebufferSizeCallback(GLFWwindow* window, int width, int height
     renderer->framebufferWidth = width;
     renderer->framebufferHeight = height;
     glViewport(0, 0, width, height);
+    RenderDamage::invalidate();
 }
 
 void Renderer::windowCloseCallback(GLFWwindow* window)
@@ -287,6 +398,8 @@ int Renderer::thread()
     this->meshShader = &edgesShader;
     this->textShader = &textureShader;
     this->stencilShader = &stencilShader;
+    edgesShader.bindUniformBlock(Camera::BLOCK_NAME, Camera::scene().binding());
+    textureShader.bindUniformBlock(Camera::BLOCK_NAME, Camera::ui().binding());
 
     auto characterManager = std::make_shared<CharacterManager>(&edgesShader);
     characterManager->registerInterface();
@@ -301,10 +414,32 @@ int Renderer::thread()
     }
 
     auto screenMessage = new M_Text(this->textShader, "", 12, { 0, 1, 0 }, { 2, 2 });
+    uint64_t screenMessageVersion = ~uint64_t { 0 };
+    bool showScreenMessage = false;
+
+    // On-demand mode only draws when something reported damage (or input just arrived); animation ticks
+    // keep their 30 Hz cadence either way. RENDERER_ON_DEMAND=false restores drawing every tick.
+    const bool onDemand = Config::get("RENDERER_ON_DEMAND", "true") == "true";
+    // Scissored redraws assume the back buffer holds the frame before last (double buffering), so the
+    // area redrawn is this frame's damage plus the previous one's.
+    const bool partialRedraw = onDemand && Config::get("RENDERER_PARTIAL_REDRAW", "false") == "true";
+    if (onDemand) {
+        RenderDamage::setWakeHook([]() { glfwPostEmptyEvent(); });
+    }
+    RenderDamage::invalidate();
+    RenderDamage::Frame previousDamage { true, true, {} };
+    RenderLoopMetrics loopMetrics(this->createdAt);
+    auto nextTick = std::chrono::steady_clock::now();
+    auto lastFrame = std::chrono::steady_clock::time_point {};
 
     while (this->running.load()) {
         const auto frameStart = std::chrono::steady_clock::now();
-        glfwPollEvents();
+        const bool animating = characterManager->getCharacter() != nullptr;
+        if (onDemand) {
+            this->waitForWork(animating, nextTick, lastFrame);
+        } else {
+            glfwPollEvents();
+        }
 
         if (!this->running.load() || glfwWindowShouldClose(this->window)) {
             break;
@@ -312,38 +447,102 @@ int Renderer::thread()
 
         this->setupTasksRun();
 
-        glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
-        glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+        const auto now = std::chrono::steady_clock::now();
+        const bool tick = animating && (!onDemand || now >= nextTick);
+        if (tick) {
+            nextTick += kFrameBudget;
+            if (nextTick < now) {
+                nextTick = now + kFrameBudget;
+            }
+        }
 
-        if (characterManager->getCharacter() != nullptr) {
-            std::unique_lock<std::mutex> animationLock(characterManager->animationMutex);
-            std::unique_lock<std::mutex> expressionLock(characterManager->expressionMutex);
-            animationLock.unlock();
-            expressionLock.unlock();
-            characterManager->getCharacter()->draw();
-            characterManager->triggerAnimationAndExpressionThreads();
+        const uint64_t messageVersion = CubeLog::getScreenMessageVersion();
+        if (messageVersion != screenMessageVersion) {
+            screenMessageVersion = messageVersion;
+            const std::string message = CubeLog::getScreenMessage();
+            showScreenMessage = !message.empty();
+            screenMessage->setText(message);
         }
 
-        if (this->running.load()) {
-            this->loopTasksRun();
+        // With a character on screen frames stay locked to animation ticks; otherwise damage is drawn as
+        // soon as the frame budget allows.
+        const bool frameDue = !onDemand || (animating ? tick : now >= lastFrame + kFrameBudget);
+        RenderDamage::Frame damage;
+        if (frameDue) {
+            damage = RenderDamage::take();
+            if (!onDemand || now - this->lastInput < kInputGracePeriod) {
+                damage.dirty = true;
+                damage.full = true;
+            }
         }
 
-        {
-            std::lock_guard<std::mutex> lock(this->mutex);
-            for (auto object : this->objects) {
-                object->draw();
+        if (damage.dirty) {
+            const bool partial = partialRedraw && !damage.full && !previousDamage.full;
+            if (partial) {
+                glEnable(GL_SCISSOR_TEST);
+                scissorTo(damage.rect.united(previousDamage.rect), this->framebufferWidth, this->framebufferHeight);
+            }
+
+            glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+            glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT | GL_STENCIL_BUFFER_BIT);
+            Camera::scene().upload();
+            Camera::ui().upload();
+
+            // Waits for an in-flight animation/expression step before taking the frame lock below.
+            if (animating) {
+                std::unique_lock<std::mutex> animationLock(characterManager->animationMutex);
+                std::unique_lock<std::mutex> expressionLock(characterManager->expressionMutex);
+            }
+            {
+                // One lock for the whole frame: transforms written by other threads land before or after
+                // it, and world matrices are only recomputed for the subtrees that changed.
+                auto sceneLock = SceneGraph::shared().lockFrame();
+                SceneGraph::shared().update();
+                if (animating) {
+                    characterManager->getCharacter()->draw();
+                }
+
+                if (this->running.load()) {
+                    this->loopTasksRun();
+                    SceneGraph::shared().update();
+                }
+
+                std::lock_guard<std::mutex> lock(this->mutex);
+                for (auto object : this->objects) {
+                    object->draw();
+                }
+            }
+
+            if (showScreenMessage) {
+                screenMessage->draw();
+            }
+
+            if (partial) {
+                glDisable(GL_SCISSOR_TEST);
             }
+            glfwSwapBuffers(this->window);
+            lastFrame = now;
+            previousDamage = damage;
+            loopMetrics.rendered(partial);
+        } else if (tick) {
+            loopMetrics.skipped();
         }
 
-        if (CubeLog::getScreenMessage() != "") {
-            screenMessage->setText(CubeLog::getScreenMessage());
-            screenMessage->draw();
+        if (tick) {
+            characterManager->triggerAnimationAndExpressionThreads();
+        }
+        // Idle work (warming menus) goes after the frame so it never delays one, and waits out input.
+        if (this->idleQueue.size() > 0 && now - this->lastInput >= kInputGracePeriod) {
+            this->idleQueue.shift()();
         }
+        loopMetrics.sample(now);
 
-        glfwSwapBuffers(this->window);
-        std::this_thread::sleep_until(frameStart + kTargetFrameDuration);
+        if (!onDemand) {
+            std::this_thread::sleep_until(frameStart + kTargetFrameDuration);
+        }
     }
 
+    RenderDamage::setWakeHook(nullptr);
     delete screenMessage;
 
     if (this->window != nullptr) {
@@ -358,6 +557,26 @@ int Renderer::thread()
     return EXIT_SUCCESS;
 }
 
+void Renderer::waitForWork(bool animating, std::chrono::steady_clock::time_point nextTick, std::chrono::steady_clock::time_point lastFrame)
+{
+    const auto now = std::chrono::steady_clock::now();
+    auto wakeAt = now + kIdleHeartbeat;
+    if (animating) {
+        wakeAt = std::min(wakeAt, nextTick);
+    } else if (RenderDamage::pending() || now - this->lastInput < kInputGracePeriod) {
+        wakeAt = std::min(wakeAt, lastFrame + kFrameBudget);
+    }
+    if (this->idleQueue.size() > 0) {
+        wakeAt = std::min(wakeAt, std::max(lastFrame + kFrameBudget, this->lastInput + kInputGracePeriod));
+    }
+    if (wakeAt <= now) {
+        glfwPollEvents();
+        return;
+    }
+    // Input, glfwPostEmptyEvent() from the damage wake hook, or the timeout ends the wait.
+    glfwWaitEventsTimeout(std::chrono::duration<double>(wakeAt - now).count());
+}
+
 bool Renderer::getIsRunning()
 {
     return this->running.load() && this->stillRunning.load();
@@ -367,6 +586,7 @@ void Renderer::addObject(Object* object)
 {
     std::lock_guard<std::mutex> lock(this->mutex);
     this->objects.push_back(object);
+    RenderDamage::invalidate();
 }
 
 Shader* Renderer::getMeshShader()
@@ -387,11 +607,20 @@ Shader* Renderer::getTextShader()
 void Renderer::addLoopTask(std::function<void()> task)
 {
     this->loopQueue.push(task);
+    RenderDamage::invalidate();
 }
 
 void Renderer::addSetupTask(std::function<void()> task)
 {
     this->setupQueue.push(task);
+    // Also wakes an idle render loop so the task runs promptly.
+    RenderDamage::invalidate();
+}
+
+void Renderer::addIdleTask(std::function<void()> task)
+{
+    // No wake needed: the next wait is shortened while idle work is queued.
+    this->idleQueue.push(task);
 }
 
 void Renderer::setupTasksRun()
@@ -49,6 +49,7 @@ SOFTWARE.
 #include "characterManager.h"
 #endif
 #include <atomic>
+#include <chrono>
 #include <functional>
 #include <latch>
 #include <optional>
@@ -69,6 +70,8 @@ private:
     static void scrollCallback(GLFWwindow* window, double xoffset, double yoffset);
     void pushEvent(const CubeEvent& event);
     int thread();
+    // Blocks in glfwWaitEventsTimeout until input, damage or the next animation tick is due.
+    void waitForWork(bool animating, std::chrono::steady_clock::time_point nextTick, std::chrono::steady_clock::time_point lastFrame);
     std::mutex mutex;
     std::thread t;
     std::atomic<bool> running = true;
@@ -81,10 +84,14 @@ private:
     Shader* stencilShader = nullptr;
     TaskQueue<std::function<void()>> setupQueue;
     TaskQueue<std::function<void()>> loopQueue;
+    // Run one per loop pass, after the frame and only once input has settled.
+    TaskQueue<std::function<void()>> idleQueue;
     std::atomic<bool> ready = false;
     std::latch* latch = nullptr;
     int framebufferWidth = 720;
     int framebufferHeight = 720;
+    std::chrono::steady_clock::time_point lastInput {};
+    std::chrono::steady_clock::time_point createdAt = std::chrono::steady_clock::now();
 
 public:
     Renderer() { };
@@ -100,9 +107,11 @@ public:
     Shader* getStencilShader();
     void addSetupTask(std::function<void()> task);
     void addLoopTask(std::function<void()> task);
+    void addIdleTask(std::function<void()> task);
     void setupTasksRun();
     void loopTasksRun();
     bool isReady();
+    std::chrono::steady_clock::time_point getCreatedAt() const { return this->createdAt; }
 };
 
 #endif // RENDERER_H
@@ -0,0 +1,233 @@
+/*
+███████╗ ██████╗███████╗███╗   ██╗███████╗ ██████╗ ██████╗  █████╗ ██████╗ ██╗  ██╗    ██████╗██████╗ ██████╗
+██╔════╝██╔════╝██╔════╝████╗  ██║██╔════╝██╔════╝ ██╔══██╗██╔══██╗██╔══██╗██║  ██║   ██╔════╝██╔══██╗██╔══██╗
+███████╗██║     █████╗  ██╔██╗ ██║█████╗  ██║  ███╗██████╔╝███████║██████╔╝███████║   ██║     ██████╔╝██████╔╝
+╚════██║██║     ██╔══╝  ██║╚██╗██║██╔══╝  ██║   ██║██╔══██╗██╔══██║██╔═══╝ ██╔══██║   ██║     ██╔═══╝ ██╔═══╝
+███████║╚██████╗███████╗██║ ╚████║███████╗╚██████╔╝██║  ██║██║  ██║██║     ██║  ██║██╗╚██████╗██║     ██║
+╚══════╝ ╚═════╝╚══════╝╚═╝  ╚═══╝╚══════╝ ╚═════╝ ╚═╝  ╚═╝╚═╝  ╚═╝╚═╝     ╚═╝  ╚═╝╚═╝ ╚═════╝╚═╝     ╚═╝
+*/
+
+/*
+MIT License
+
+Copyright (c) 2026 A-McD Technology LLC
+*/
+
+#include "sceneGraph.h"
+
+SceneGraph& SceneGraph::shared()
+{
+    static SceneGraph graph;
+    return graph;
+}
+
+SceneNode SceneGraph::create(SceneNode parent)
+{
+    std::lock_guard<std::recursive_mutex> lock(this->mutex);
+    SceneNode node;
+    if (!this->freeNodes.empty()) {
+        node = this->freeNodes.back();
+        this->freeNodes.pop_back();
+        this->locals[node] = glm::mat4(1.0f);
+        this->worlds[node] = glm::mat4(1.0f);
+        this->parents[node] = INVALID_SCENE_NODE;
+        this->firstChildren[node] = INVALID_SCENE_NODE;
+        this->nextSiblings[node] = INVALID_SCENE_NODE;
+        this->flags[node] = ALIVE;
+    } else {
+        node = static_cast<SceneNode>(this->locals.size());
+        this->locals.emplace_back(1.0f);
+        this->worlds.emplace_back(1.0f);
+        this->parents.push_back(INVALID_SCENE_NODE);
+        this->firstChildren.push_back(INVALID_SCENE_NODE);
+        this->nextSiblings.push_back(INVALID_SCENE_NODE);
+        this->flags.push_back(ALIVE);
+    }
+    if (valid(parent)) {
+        attach(node, parent);
+    }
+    markDirty(node);
+    return node;
+}
+
+void SceneGraph::destroy(SceneNode node)
+{
+    std::lock_guard<std::recursive_mutex> lock(this->mutex);
+    if (!valid(node)) {
+        return;
+    }
+    detach(node);
+    SceneNode child = this->firstChildren[node];
+    while (child != INVALID_SCENE_NODE) {
+        const SceneNode next = this->nextSiblings[child];
+        this->parents[child] = INVALID_SCENE_NODE;
+        this->nextSiblings[child] = INVALID_SCENE_NODE;
+        markDirty(child);
+        child = next;
+    }
+    this->firstChildren[node] = INVALID_SCENE_NODE;
+    this->flags[node] = 0;
+    this->freeNodes.push_back(node);
+}
+
+void SceneGraph::setParent(SceneNode node, SceneNode parent)
+{
+    std::lock_guard<std::recursive_mutex> lock(this->mutex);
+    if (!valid(node) || this->parents[node] == parent) {
+        return;
+    }
+    // Refuse to create a cycle.
+    for (SceneNode p = parent; p != INVALID_SCENE_NODE; p = this->parents[p]) {
+        if (p == node) {
+            return;
+        }
+    }
+    detach(node);
+    if (valid(parent)) {
+        attach(node, parent);
+    }
+    markDirty(node);
+}
+
+SceneNode SceneGraph::parent(SceneNode node) const
+{
+    std::lock_guard<std::recursive_mutex> lock(this->mutex);
+    return valid(node) ? this->parents[node] : INVALID_SCENE_NODE;
+}
+
+void SceneGraph::setLocal(SceneNode node, const glm::mat4& local)
+{
+    std::lock_guard<std::recursive_mutex> lock(this->mutex);
+    if (!valid(node)) {
+        return;
+    }
+    this->locals[node] = local;
+    markDirty(node);
+}
+
+void SceneGraph::translate(SceneNode node, const glm::vec3& translation)
+{
+    std::lock_guard<std::recursive_mutex> lock(this->mutex);
+    if (!valid(node)) {
+        return;
+    }
+    // Same as glm::translate(local, translation): the offset is expressed in the node's local axes.
+    glm::mat4& local = this->locals[node];
+    local[3] = local[0] * translation.x + local[1] * translation.y + local[2] * translation.z + local[3];
+    markDirty(node);
+}
+
+void SceneGraph::transform(SceneNode node, const glm::mat4& pre, const glm::mat4& post)
+{
+    std::lock_guard<std::recursive_mutex> lock(this->mutex);
+    if (!valid(node)) {
+        return;
+    }
+    this->locals[node] = pre * this->locals[node] * post;
+    markDirty(node);
+}
+
+glm::mat4 SceneGraph::local(SceneNode node) const
+{
+    std::lock_guard<std::recursive_mutex> lock(this->mutex);
+    return valid(node) ? this->locals[node] : glm::mat4(1.0f);
+}
+
+glm::mat4 SceneGraph::world(SceneNode node) const
+{
+    std::lock_guard<std::recursive_mutex> lock(this->mutex);
+    return valid(node) ? this->worlds[node] : glm::mat4(1.0f);
+}
+
+size_t SceneGraph::update()
+{
+    std::lock_guard<std::recursive_mutex> lock(this->mutex);
+    size_t recomputed = 0;
+    for (const SceneNode node : this->dirtyNodes) {
+        // Already handled as part of a dirty ancestor's subtree, or destroyed since it was marked.
+        if (!valid(node) || !(this->flags[node] & DIRTY) || hasDirtyAncestor(node)) {
+            continue;
+        }
+        recomputed += updateSubtree(node);
+    }
+    this->dirtyNodes.clear();
+    return recomputed;
+}
+
+std::unique_lock<std::recursive_mutex> SceneGraph::lockFrame()
+{
+    return std::unique_lock<std::recursive_mutex>(this->mutex);
+}
+
+size_t SceneGraph::liveNodes() const
+{
+    std::lock_guard<std::recursive_mutex> lock(this->mutex);
+    return this->locals.size() - this->freeNodes.size();
+}
+
+bool SceneGraph::valid(SceneNode node) const
+{
+    return node < this->flags.size() && (this->flags[node] & ALIVE);
+}
+
+void SceneGraph::markDirty(SceneNode node)
+{
+    if (this->flags[node] & DIRTY) {
+        return;
+    }
+    this->flags[node] |= DIRTY;
+    this->dirtyNodes.push_back(node);
+}
+
+void SceneGraph::attach(SceneNode node, SceneNode parent)
+{
+    this->parents[node] = parent;
+    this->nextSiblings[node] = this->firstChildren[parent];
+    this->firstChildren[parent] = node;
+}
+
+void SceneGraph::detach(SceneNode node)
+{
+    const SceneNode parent = this->parents[node];
+    if (parent == INVALID_SCENE_NODE) {
+        return;
+    }
+    SceneNode* link = &this->firstChildren[parent];
+    while (*link != INVALID_SCENE_NODE && *link != node) {
+        link = &this->nextSiblings[*link];
+    }
+    if (*link == node) {
+        *link = this->nextSiblings[node];
+    }
+    this->parents[node] = INVALID_SCENE_NODE;
+    this->nextSiblings[node] = INVALID_SCENE_NODE;
+}
+
+bool SceneGraph::hasDirtyAncestor(SceneNode node) const
+{
+    for (SceneNode p = this->parents[node]; p != INVALID_SCENE_NODE; p = this->parents[p]) {
+        if (this->flags[p] & DIRTY) {
+            return true;
+        }
+    }
+    return false;
+}
+
+size_t SceneGraph::updateSubtree(SceneNode root)
+{
+    size_t count = 0;
+    this->walkStack.clear();
+    this->walkStack.push_back(root);
+    while (!this->walkStack.empty()) {
+        const SceneNode node = this->walkStack.back();
+        this->walkStack.pop_back();
+        const SceneNode parent = this->parents[node];
+        this->worlds[node] = parent == INVALID_SCENE_NODE ? this->locals[node] : this->worlds[parent] * this->locals[node];
+        this->flags[node] &= static_cast<uint8_t>(~DIRTY);
+        count++;
+        for (SceneNode child = this->firstChildren[node]; child != INVALID_SCENE_NODE; child = this->nextSiblings[child]) {
+            this->walkStack.push_back(child);
+        }
+    }
+    return count;
+}
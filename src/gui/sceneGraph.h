@@ -0,0 +1,94 @@
+/*
+███████╗ ██████╗███████╗███╗   ██╗███████╗ ██████╗ ██████╗  █████╗ ██████╗ ██╗  ██╗   ██╗  ██╗
+██╔════╝██╔════╝██╔════╝████╗  ██║██╔════╝██╔════╝ ██╔══██╗██╔══██╗██╔══██╗██║  ██║   ██║  ██║
+███████╗██║     █████╗  ██╔██╗ ██║█████╗  ██║  ███╗██████╔╝███████║██████╔╝███████║   ███████║
+╚════██║██║     ██╔══╝  ██║╚██╗██║██╔══╝  ██║   ██║██╔══██╗██╔══██║██╔═══╝ ██╔══██║   ██╔══██║
+███████║╚██████╗███████╗██║ ╚████║███████╗╚██████╔╝██║  ██║██║  ██║██║     ██║  ██║██╗██║  ██║
+╚══════╝ ╚═════╝╚══════╝╚═╝  ╚═══╝╚══════╝ ╚═════╝ ╚═╝  ╚═╝╚═╝  ╚═╝╚═╝     ╚═╝  ╚═╝╚═╝╚═╝  ╚═╝
+*/
+
+/*
+MIT License
+
+Copyright (c) 2026 A-McD Technology LLC
+*/
+
+#pragma once
+#ifndef SCENEGRAPH_H
+#define SCENEGRAPH_H
+#include <cstddef>
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <mutex>
+#include <vector>
+
+/*
+
+Every MeshObject owns a node in the shared SceneGraph; its model matrix is the node's local transform
+and what it draws with is the node's world transform (parent world * local). Composite widgets make a
+node of their own and parent their pieces to it, so moving the composite is one local-matrix write
+instead of a translate() per piece.
+
+Transforms live in parallel arrays indexed by node id (locals, worlds, parent / first-child / sibling
+links, flags), so update() walks contiguous memory. Writing a local transform only marks the node
+dirty; update() recomputes the world matrices of dirty subtrees and leaves everything else alone.
+
+The renderer holds lockFrame() from the first update() of a frame until the last draw, so the
+per-object world() reads re-enter a lock the render thread already owns instead of contending for it.
+The mutex is recursive because draw code may itself move nodes (MenuEntry's marquee, for instance);
+writers on other threads (the character animation threads) wait for the frame to finish.
+
+*/
+
+using SceneNode = uint32_t;
+constexpr SceneNode INVALID_SCENE_NODE = UINT32_MAX;
+
+class SceneGraph {
+public:
+    static SceneGraph& shared();
+
+    SceneNode create(SceneNode parent = INVALID_SCENE_NODE);
+    // Children of a destroyed node become roots and keep their local transforms.
+    void destroy(SceneNode node);
+    void setParent(SceneNode node, SceneNode parent);
+    SceneNode parent(SceneNode node) const;
+
+    void setLocal(SceneNode node, const glm::mat4& local);
+    void translate(SceneNode node, const glm::vec3& translation);
+    // local = pre * local * post, in one write.
+    void transform(SceneNode node, const glm::mat4& pre, const glm::mat4& post);
+    glm::mat4 local(SceneNode node) const;
+    // World transform as of the last update(). Call with the frame lock held (or from the render thread).
+    glm::mat4 world(SceneNode node) const;
+
+    // Recompute the world matrices of every subtree whose root changed. Returns the number of nodes
+    // recomputed.
+    size_t update();
+    std::unique_lock<std::recursive_mutex> lockFrame();
+    size_t liveNodes() const;
+
+private:
+    enum Flags : uint8_t {
+        ALIVE = 1 << 0,
+        DIRTY = 1 << 1,
+    };
+    bool valid(SceneNode node) const;
+    void markDirty(SceneNode node);
+    void attach(SceneNode node, SceneNode parent);
+    void detach(SceneNode node);
+    bool hasDirtyAncestor(SceneNode node) const;
+    size_t updateSubtree(SceneNode root);
+
+    mutable std::recursive_mutex mutex;
+    std::vector<glm::mat4> locals;
+    std::vector<glm::mat4> worlds;
+    std::vector<SceneNode> parents;
+    std::vector<SceneNode> firstChildren;
+    std::vector<SceneNode> nextSiblings;
+    std::vector<uint8_t> flags;
+    std::vector<SceneNode> dirtyNodes;
+    std::vector<SceneNode> freeNodes;
+    std::vector<SceneNode> walkStack;
+};
+
+#endif // SCENEGRAPH_H
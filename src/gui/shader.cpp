@@ -32,6 +32,38 @@ SOFTWARE.
 */
 
 #include "shader.h"
+#include "renderables/primitiveBatch.h"
+
+#include <cstring>
+
+const char* shaderUniformName(ShaderUniform uniform)
+{
+    switch (uniform) {
+    case ShaderUniform::MODEL:
+        return "model";
+    case ShaderUniform::VIEW:
+        return "view";
+    case ShaderUniform::PROJECTION:
+        return "projection";
+    case ShaderUniform::LOCAL:
+        return "local";
+    case ShaderUniform::TEXT_COLOR:
+        return "textColor";
+    case ShaderUniform::OFFSET:
+        return "offset";
+    case ShaderUniform::ZINDEX:
+        return "zindex";
+    case ShaderUniform::ALPHA:
+        return "alpha";
+    case ShaderUniform::BG_ALPHA:
+        return "bg_alpha";
+    case ShaderUniform::COUNT:
+        break;
+    }
+    return "";
+}
+
+std::atomic<bool> Shader::uniformCacheEnabled { true };
 
 Shader::Shader(const std::string& vertexShaderPath, const std::string& fragmentShaderPath)
 {
@@ -76,6 +108,7 @@ Shader::Shader(const std::string& vertexShaderPath, const std::string& fragmentS
 
     glDeleteShader(vertex);
     glDeleteShader(fragment);
+    reflectUniforms();
     CubeLog::info("Shader loaded successfully");
 }
 
@@ -86,40 +119,235 @@ Shader::~Shader()
 
 void Shader::use()
 {
+    // Queued UI primitives were submitted before whatever is about to draw with this program.
+    PrimitiveBatch::shared().flush();
     std::lock_guard<std::mutex> lock(this->mutex);
     glUseProgram(ID);
 }
 
+/**
+ * @brief Record the location of every active default-block uniform. Uniforms inside blocks report
+ * location -1 and are skipped; they are fed through bindUniformBlock() instead.
+ */
+void Shader::reflectUniforms()
+{
+    this->knownSlots.fill(-1);
+    GLint count = 0;
+    GLint maxLength = 0;
+    glGetProgramiv(this->ID, GL_ACTIVE_UNIFORMS, &count);
+    glGetProgramiv(this->ID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
+    std::vector<char> nameBuffer(static_cast<size_t>(std::max(maxLength, 1)));
+    for (GLint i = 0; i < count; i++) {
+        GLsizei length = 0;
+        GLint size = 0;
+        GLenum type = 0;
+        glGetActiveUniform(this->ID, static_cast<GLuint>(i), static_cast<GLsizei>(nameBuffer.size()), &length, &size, &type, nameBuffer.data());
+        const GLint location = glGetUniformLocation(this->ID, nameBuffer.data());
+        if (location < 0) {
+            continue;
+        }
+        std::string name(nameBuffer.data(), static_cast<size_t>(length));
+        // Arrays are reported as "name[0]"; register them under the bare name, which is what callers pass.
+        if (name.size() > 3 && name.ends_with("[0]")) {
+            name.resize(name.size() - 3);
+        }
+        this->slotsByName[name] = this->slots.size();
+        this->slots.push_back({ location });
+    }
+    for (size_t i = 0; i < this->knownSlots.size(); i++) {
+        auto it = this->slotsByName.find(shaderUniformName(static_cast<ShaderUniform>(i)));
+        if (it != this->slotsByName.end()) {
+            this->knownSlots[i] = static_cast<int>(it->second);
+        }
+    }
+}
+
+Shader::UniformSlot* Shader::slotFor(ShaderUniform uniform) const
+{
+    const int index = this->knownSlots[static_cast<size_t>(uniform)];
+    if (index < 0 || static_cast<size_t>(index) >= this->slots.size()) {
+        return nullptr;
+    }
+    UniformSlot* slot = &this->slots[static_cast<size_t>(index)];
+    if (!uniformCacheEnabled.load(std::memory_order_relaxed)) {
+        slot->location = glGetUniformLocation(this->ID, shaderUniformName(uniform));
+    }
+    return slot;
+}
+
+Shader::UniformSlot* Shader::slotFor(const std::string& name) const
+{
+    auto it = this->slotsByName.find(name);
+    if (it == this->slotsByName.end()) {
+        return nullptr;
+    }
+    UniformSlot* slot = &this->slots[it->second];
+    if (!uniformCacheEnabled.load(std::memory_order_relaxed)) {
+        slot->location = glGetUniformLocation(this->ID, name.c_str());
+    }
+    return slot;
+}
+
+void Shader::setUniformCacheEnabled(bool enabled)
+{
+    uniformCacheEnabled.store(enabled, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Compare against and update the cached value of a uniform.
+ *
+ * @return true if the uniform already holds this value and the upload can be skipped
+ */
+bool Shader::unchanged(UniformSlot* slot, const float* value, size_t count)
+{
+    if (!uniformCacheEnabled.load(std::memory_order_relaxed)) {
+        slot->valid = false;
+        return false;
+    }
+    if (slot->valid && std::memcmp(slot->value.data(), value, count * sizeof(float)) == 0) {
+        return true;
+    }
+    std::memcpy(slot->value.data(), value, count * sizeof(float));
+    slot->valid = true;
+    return false;
+}
+
+bool Shader::hasUniform(ShaderUniform uniform) const
+{
+    return slotFor(uniform) != nullptr;
+}
+
+bool Shader::bindUniformBlock(const std::string& blockName, GLuint binding)
+{
+    const GLuint index = glGetUniformBlockIndex(this->ID, blockName.c_str());
+    if (index == GL_INVALID_INDEX) {
+        return false;
+    }
+    glUniformBlockBinding(this->ID, index, binding);
+    return true;
+}
+
+void Shader::setInt(ShaderUniform uniform, int value) const
+{
+    UniformSlot* slot = slotFor(uniform);
+    float bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    if (slot == nullptr || unchanged(slot, &bits, 1)) {
+        return;
+    }
+    glUniform1i(slot->location, value);
+}
+
+void Shader::setFloat(ShaderUniform uniform, float value) const
+{
+    UniformSlot* slot = slotFor(uniform);
+    if (slot == nullptr || unchanged(slot, &value, 1)) {
+        return;
+    }
+    glUniform1f(slot->location, value);
+}
+
+void Shader::setVec2(ShaderUniform uniform, float x, float y) const
+{
+    UniformSlot* slot = slotFor(uniform);
+    const float value[2] = { x, y };
+    if (slot == nullptr || unchanged(slot, value, 2)) {
+        return;
+    }
+    glUniform2f(slot->location, x, y);
+}
+
+void Shader::setVec3(ShaderUniform uniform, float x, float y, float z) const
+{
+    UniformSlot* slot = slotFor(uniform);
+    const float value[3] = { x, y, z };
+    if (slot == nullptr || unchanged(slot, value, 3)) {
+        return;
+    }
+    glUniform3f(slot->location, x, y, z);
+}
+
+void Shader::setVec4(ShaderUniform uniform, float x, float y, float z, float w) const
+{
+    UniformSlot* slot = slotFor(uniform);
+    const float value[4] = { x, y, z, w };
+    if (slot == nullptr || unchanged(slot, value, 4)) {
+        return;
+    }
+    glUniform4f(slot->location, x, y, z, w);
+}
+
+void Shader::setMat4(ShaderUniform uniform, const glm::mat4& value) const
+{
+    UniformSlot* slot = slotFor(uniform);
+    if (slot == nullptr || unchanged(slot, glm::value_ptr(value), 16)) {
+        return;
+    }
+    glUniformMatrix4fv(slot->location, 1, GL_FALSE, glm::value_ptr(value));
+}
+
 void Shader::setBool(const std::string& name, bool value) const
 {
-    glUniform1i(glGetUniformLocation(ID, name.c_str()), (int)value);
+    setInt(name, static_cast<int>(value));
 }
 
 void Shader::setInt(const std::string& name, int value) const
 {
-    glUniform1i(glGetUniformLocation(ID, name.c_str()), value);
+    UniformSlot* slot = slotFor(name);
+    float bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    if (slot == nullptr || unchanged(slot, &bits, 1)) {
+        return;
+    }
+    glUniform1i(slot->location, value);
 }
 
 void Shader::setFloat(const std::string& name, float value) const
 {
-    glUniform1f(glGetUniformLocation(ID, name.c_str()), value);
+    UniformSlot* slot = slotFor(name);
+    if (slot == nullptr || unchanged(slot, &value, 1)) {
+        return;
+    }
+    glUniform1f(slot->location, value);
 }
 
 void Shader::setVec2(const std::string& name, float x, float y) const
 {
-    glUniform2f(glGetUniformLocation(ID, name.c_str()), x, y);
+    UniformSlot* slot = slotFor(name);
+    const float value[2] = { x, y };
+    if (slot == nullptr || unchanged(slot, value, 2)) {
+        return;
+    }
+    glUniform2f(slot->location, x, y);
 }
+
 void Shader::setVec3(const std::string& name, float x, float y, float z) const
 {
-    glUniform3f(glGetUniformLocation(ID, name.c_str()), x, y, z);
+    UniformSlot* slot = slotFor(name);
+    const float value[3] = { x, y, z };
+    if (slot == nullptr || unchanged(slot, value, 3)) {
+        return;
+    }
+    glUniform3f(slot->location, x, y, z);
 }
+
 void Shader::setVec4(const std::string& name, float x, float y, float z, float w) const
 {
-    glUniform4f(glGetUniformLocation(ID, name.c_str()), x, y, z, w);
+    UniformSlot* slot = slotFor(name);
+    const float value[4] = { x, y, z, w };
+    if (slot == nullptr || unchanged(slot, value, 4)) {
+        return;
+    }
+    glUniform4f(slot->location, x, y, z, w);
 }
+
 void Shader::setMat4(const std::string& name, glm::mat4 value) const
 {
-    glUniformMatrix4fv(glGetUniformLocation(this->ID, name.c_str()), 1, GL_FALSE, glm::value_ptr(value));
+    UniformSlot* slot = slotFor(name);
+    if (slot == nullptr || unchanged(slot, glm::value_ptr(value), 16)) {
+        return;
+    }
+    glUniformMatrix4fv(slot->location, 1, GL_FALSE, glm::value_ptr(value));
 }
 
 std::string Shader::readShader(const std::string& path)
@@ -43,15 +43,52 @@ SOFTWARE.
 #ifndef LOGGER_H
 #include <logger.h>
 #endif
+#include <array>
+#include <atomic>
+#include <cstdint>
 #include <mutex>
 #include <string>
+#include <unordered_map>
+#include <vector>
+
+// Uniforms used by the built-in shaders. Their locations are resolved once when the program links,
+// so per-draw setters index an array instead of asking the driver to look a name up.
+enum class ShaderUniform : uint8_t {
+    MODEL,
+    VIEW,
+    PROJECTION,
+    LOCAL,
+    TEXT_COLOR,
+    OFFSET,
+    ZINDEX,
+    ALPHA,
+    BG_ALPHA,
+    COUNT
+};
+
+const char* shaderUniformName(ShaderUniform uniform);
 
 class Shader {
 private:
+    // One active uniform of the linked program plus the last value uploaded to it. Uniform values are
+    // program state, so an upload that matches the cached value can be skipped.
+    struct UniformSlot {
+        GLint location = -1;
+        bool valid = false;
+        std::array<float, 16> value {};
+    };
     std::string vertexShader;
     std::string fragmentShader;
     std::string readShader(const std::string& path);
+    void reflectUniforms();
+    UniformSlot* slotFor(ShaderUniform uniform) const;
+    UniformSlot* slotFor(const std::string& name) const;
+    static bool unchanged(UniformSlot* slot, const float* value, size_t count);
+    static std::atomic<bool> uniformCacheEnabled;
     std::mutex mutex;
+    mutable std::vector<UniformSlot> slots;
+    std::unordered_map<std::string, size_t> slotsByName;
+    std::array<int, static_cast<size_t>(ShaderUniform::COUNT)> knownSlots {};
 
 public:
     unsigned int ID;
@@ -59,6 +96,19 @@ public:
     Shader(const std::string& vertexShaderPath, const std::string& fragmentShaderPath);
     ~Shader();
     void use();
+    bool hasUniform(ShaderUniform uniform) const;
+    // With the cache off every setter asks the driver for the location and uploads unconditionally,
+    // which is how uniforms were set before the cache existed. Only benchmarks turn it off.
+    static void setUniformCacheEnabled(bool enabled);
+    // Points the named uniform block at a buffer binding index. Returns false if the program has no such block.
+    bool bindUniformBlock(const std::string& blockName, GLuint binding);
+    void setInt(ShaderUniform uniform, int value) const;
+    void setFloat(ShaderUniform uniform, float value) const;
+    void setVec2(ShaderUniform uniform, float x, float y) const;
+    void setVec3(ShaderUniform uniform, float x, float y, float z) const;
+    void setVec4(ShaderUniform uniform, float x, float y, float z, float w) const;
+    void setMat4(ShaderUniform uniform, const glm::mat4& value) const;
+    // Name-based setters for uniforms outside ShaderUniform; a hash lookup, never a driver query.
     void setBool(const std::string& name, bool value) const;
     void setInt(const std::string& name, int value) const;
     void setFloat(const std::string& name, float value) const;
@@ -6,9 +6,12 @@ layout(location = 1) in float aColor; // Correct use: specifies the location of
 
 out vec3 vertexColor; // Pass color to fragment shader
 
+// Shared by every mesh; uploaded once per frame by the renderer (see camera.h).
+layout(std140) uniform Camera {
+    mat4 projection;
+    mat4 view;
+};
 uniform mat4 model;
-uniform mat4 view;
-uniform mat4 projection;
 
 void main() {
     gl_Position = projection * view * model * vec4(aPos, 1.0);
@@ -5,10 +5,18 @@ out vec2 TexCoords;
 
 uniform float zindex;
 
-uniform mat4 projection;
+// Shared UI camera; uploaded once per frame by the renderer (see camera.h).
+layout(std140) uniform Camera {
+    mat4 projection;
+    mat4 view;
+};
+// Object-to-world transform (e.g. a menu entry scroll offset), rebased if the object has its own projection.
+uniform mat4 local;
+// Baseline origin of the string; glyph quads are laid out relative to it.
+uniform vec2 offset;
 
 void main()
 {
-    gl_Position = projection * vec4(vertex.xy, zindex, 1.0);
+    gl_Position = projection * view * local * vec4(vertex.xy + offset, zindex, 1.0);
     TexCoords = vertex.zw;
 }
@@ -37,19 +37,58 @@ SOFTWARE.
 #include <logger.h>
 #endif
 
+#include <algorithm>
+#include <array>
 #include <cmath>
+#include <limits>
 #include <string>
+#include <thread>
+#include <utility>
 
 namespace {
 
 constexpr uint8_t kBmi270RegisterChipId = 0x00;
 constexpr uint8_t kBmi270ExpectedChipId = 0x24;
 constexpr uint8_t kBmi270RegisterAccelXLSB = 0x0C;
+constexpr uint8_t kBmi270RegisterFifoLength0 = 0x24;
+constexpr uint8_t kBmi270RegisterFifoData = 0x26;
+constexpr uint8_t kBmi270RegisterAccConf = 0x40;
+constexpr uint8_t kBmi270RegisterAccRange = 0x41;
+constexpr uint8_t kBmi270RegisterFifoWatermark0 = 0x46;
+constexpr uint8_t kBmi270RegisterFifoWatermark1 = 0x47;
+constexpr uint8_t kBmi270RegisterFifoConfig0 = 0x48;
+constexpr uint8_t kBmi270RegisterFifoConfig1 = 0x49;
+constexpr uint8_t kBmi270RegisterInt1IoCtrl = 0x53;
+constexpr uint8_t kBmi270RegisterIntLatch = 0x55;
+constexpr uint8_t kBmi270RegisterIntMapData = 0x58;
+constexpr uint8_t kBmi270RegisterPwrConf = 0x7C;
+constexpr uint8_t kBmi270RegisterPwrCtrl = 0x7D;
+constexpr uint8_t kBmi270RegisterCmd = 0x7E;
+constexpr uint8_t kBmi270AccConfPerformanceNormalBandwidth = 0xA0; // acc_filter_perf=1, acc_bwp=normal.
+constexpr uint8_t kBmi270AccRangeFourG = 0x01;
+constexpr uint8_t kBmi270FifoConfig0StreamMode = 0x00; // Overwrite the oldest samples, no sensortime frames.
+constexpr uint8_t kBmi270FifoConfig1AccelHeaderless = 0x40;
+constexpr uint8_t kBmi270Int1PushPullActiveHigh = 0x0A;
+constexpr uint8_t kBmi270IntNonLatched = 0x00;
+constexpr uint8_t kBmi270IntMapFifoWatermarkToInt1 = 0x02;
+constexpr uint8_t kBmi270PwrConfAdvancedPowerSaveOff = 0x00;
+constexpr uint8_t kBmi270PwrCtrlAccelEnable = 0x04;
+constexpr uint8_t kBmi270CmdFifoFlush = 0xB0;
+constexpr auto kBmi270PowerModeSettle = std::chrono::microseconds(450);
 constexpr size_t kBmi270AccelerationPayloadLength = 6;
+constexpr uint16_t kBmi270FifoLengthMask = 0x3FFF;
+constexpr int16_t kBmi270FifoEmptyAxis = std::numeric_limits<int16_t>::min(); // Headerless frames read past the end are 0x8000 on every axis.
+constexpr uint16_t kMaxFifoWatermarkSamples = 256;
+constexpr size_t kMaxFifoBatchSamples = 256;
 constexpr float kBmi270LsbPerG = 8192.0f; // +/-4g full-scale.
 constexpr float kRestMagnitudeTargetG = 1.0f;
 constexpr float kNoMotionScaleFactor = 0.35f;
 constexpr float kMinimumNoMotionThresholdG = 0.05f;
+// The tap and lift thresholds were tuned on deltas between 50 ms polls. FIFO samples arrive every ODR period,
+// so deltas are taken against a sample at least this much older to keep the thresholds meaningful. It is a
+// little under 50 ms so a poll that fires slightly early still compares against the poll before it.
+constexpr auto kInteractionDeltaSpan = std::chrono::milliseconds(45);
+constexpr size_t kMaxRecentSamples = 64;
 
 std::expected<void, I2CError> ensureBus(const std::shared_ptr<ILocalI2CBus>& bus)
 {
@@ -77,6 +116,32 @@ int16_t decodeLittleEndianI16(const I2CBytes& payload, size_t offset)
         | (static_cast<uint16_t>(payload[offset + 1]) << 8));
 }
 
+std::optional<uint8_t> accelOdrCode(uint16_t outputDataRateHz)
+{
+    constexpr std::array<std::pair<uint16_t, uint8_t>, 7> kRates { {
+        { 25, 0x06 },
+        { 50, 0x07 },
+        { 100, 0x08 },
+        { 200, 0x09 },
+        { 400, 0x0A },
+        { 800, 0x0B },
+        { 1600, 0x0C },
+    } };
+    for (const auto& [hz, code] : kRates) {
+        if (hz == outputDataRateHz) {
+            return code;
+        }
+    }
+    return std::nullopt;
+}
+
+void packRawStatus(Bmi270InterruptStatus& status)
+{
+    status.rawStatus = static_cast<uint16_t>((status.tapDetected ? 0x0001U : 0U)
+        | (status.motionDetected ? 0x0002U : 0U)
+        | (status.noMotionDetected ? 0x0004U : 0U));
+}
+
 float sampleMagnitude(const Bmi270AccelerationSample& sample)
 {
     return std::sqrt((sample.xG * sample.xG) + (sample.yG * sample.yG) + (sample.zG * sample.zG));
@@ -147,9 +212,102 @@ std::expected<void, Bmi270Error> Bmi270Accelerometer::initialize()
         return std::unexpected(Bmi270Error::UnexpectedChipId);
     }
 
+    std::optional<Bmi270FifoConfig> fifoConfig;
+    {
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        fifoConfig = fifoConfig_;
+    }
+    bool fifoEnabled = false;
+    if (fifoConfig) {
+        if (auto fifoResult = enableFifo(*fifoConfig); fifoResult) {
+            fifoEnabled = true;
+        } else {
+            CubeLog::warning("Bmi270Accelerometer: failed to configure the FIFO, falling back to polling single samples.");
+        }
+    }
+
     std::lock_guard<std::mutex> lock(stateMutex_);
     initialized_ = true;
     unavailable_ = false;
+    fifoEnabled_ = fifoEnabled;
+    return { };
+}
+
+std::expected<void, Bmi270Error> Bmi270Accelerometer::setFifoConfig(const Bmi270FifoConfig& config)
+{
+    if (!accelOdrCode(config.outputDataRateHz)
+        || config.watermarkSamples == 0
+        || config.watermarkSamples > kMaxFifoWatermarkSamples) {
+        return std::unexpected(Bmi270Error::InvalidConfig);
+    }
+
+    bool initialized = false;
+    {
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        fifoConfig_ = config;
+        previousSample_.reset();
+        recentSamples_.clear();
+        lastTapAt_.reset();
+        initialized = initialized_;
+    }
+    if (!initialized) {
+        return { };
+    }
+
+    const auto fifoResult = enableFifo(config);
+    std::lock_guard<std::mutex> lock(stateMutex_);
+    fifoEnabled_ = fifoResult.has_value();
+    return fifoResult;
+}
+
+bool Bmi270Accelerometer::isFifoEnabled() const
+{
+    std::lock_guard<std::mutex> lock(stateMutex_);
+    return fifoEnabled_;
+}
+
+void Bmi270Accelerometer::setMonotonicNowReader(MonotonicNowReader reader)
+{
+    std::lock_guard<std::mutex> lock(stateMutex_);
+    monotonicNowReader_ = std::move(reader);
+}
+
+std::expected<void, Bmi270Error> Bmi270Accelerometer::enableFifo(const Bmi270FifoConfig& config)
+{
+    // Advanced power save has to be off, and settled, before the configuration registers accept writes.
+    if (auto result = writeRegister(kBmi270RegisterPwrConf, kBmi270PwrConfAdvancedPowerSaveOff); !result) {
+        return std::unexpected(toBmi270Error(result.error()));
+    }
+    std::this_thread::sleep_for(kBmi270PowerModeSettle);
+
+    const uint16_t watermarkBytes = static_cast<uint16_t>(config.watermarkSamples * kBmi270AccelerationPayloadLength);
+    const std::array<std::pair<uint8_t, uint8_t>, 10> writes { {
+        { kBmi270RegisterAccConf, static_cast<uint8_t>(kBmi270AccConfPerformanceNormalBandwidth | *accelOdrCode(config.outputDataRateHz)) },
+        { kBmi270RegisterAccRange, kBmi270AccRangeFourG },
+        { kBmi270RegisterFifoWatermark0, static_cast<uint8_t>(watermarkBytes & 0xFF) },
+        { kBmi270RegisterFifoWatermark1, static_cast<uint8_t>((watermarkBytes >> 8) & 0x1F) },
+        { kBmi270RegisterFifoConfig0, kBmi270FifoConfig0StreamMode },
+        { kBmi270RegisterFifoConfig1, kBmi270FifoConfig1AccelHeaderless },
+        { kBmi270RegisterInt1IoCtrl, kBmi270Int1PushPullActiveHigh },
+        { kBmi270RegisterIntLatch, kBmi270IntNonLatched },
+        { kBmi270RegisterIntMapData, kBmi270IntMapFifoWatermarkToInt1 },
+        { kBmi270RegisterPwrCtrl, kBmi270PwrCtrlAccelEnable },
+    } };
+    // One combined transfer: every register write, then the FIFO flush, each as its own segment.
+    I2CTransaction transaction;
+    for (const auto& [reg, value] : writes) {
+        transaction.write(address_, I2CBytes { reg, value }, tenBitAddress_);
+    }
+    transaction.write(address_, I2CBytes { kBmi270RegisterCmd, kBmi270CmdFifoFlush }, tenBitAddress_);
+    if (auto busReady = ensureBus(bus_); !busReady) {
+        return std::unexpected(toBmi270Error(busReady.error()));
+    }
+    if (auto result = bus_->transfer(transaction); !result) {
+        return std::unexpected(toBmi270Error(result.error()));
+    }
+
+    CubeLog::info("Bmi270Accelerometer: FIFO enabled at " + std::to_string(config.outputDataRateHz)
+        + " Hz with a " + std::to_string(config.watermarkSamples) + " sample watermark.");
     return { };
 }
 
@@ -215,6 +373,7 @@ std::expected<void, Bmi270Error> Bmi270Accelerometer::configureInteractionDetect
     interactionConfigured_ = config.tapDetectionEnabled || config.liftDetectionEnabled;
     if (configChanged) {
         previousSample_.reset();
+        recentSamples_.clear();
         lastTapAt_.reset();
     }
     return { };
@@ -232,6 +391,23 @@ std::expected<Bmi270InterruptStatus, Bmi270Error> Bmi270Accelerometer::readInter
 
 std::expected<Bmi270InteractionStatus, Bmi270Error> Bmi270Accelerometer::pollInteractionStatus()
 {
+    if (isFifoEnabled()) {
+        const auto samples = readFifoSamples();
+        if (!samples) {
+            return std::unexpected(samples.error());
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(stateMutex_);
+            if (!interactionConfigured_) {
+                interactionConfig_ = Bmi270InteractionConfig {};
+                interactionConfigured_ = true;
+            }
+        }
+
+        return classifyBatch(*samples);
+    }
+
     const auto sample = readAcceleration();
     if (!sample) {
         return std::unexpected(sample.error());
@@ -245,10 +421,95 @@ std::expected<Bmi270InteractionStatus, Bmi270Error> Bmi270Accelerometer::pollInt
         }
     }
 
-    return classifyInteraction(*sample);
+    auto status = classifyInteraction(*sample, now());
+    status.sampleCount = 1;
+    return status;
+}
+
+std::expected<std::vector<Bmi270AccelerationSample>, Bmi270Error> Bmi270Accelerometer::readFifoSamples()
+{
+    // One read for the fill level and one burst read for every whole frame buffered since the last drain.
+    const auto lengthResponse = readRegisters(kBmi270RegisterFifoLength0, 2);
+    if (!lengthResponse) {
+        return std::unexpected(toBmi270Error(lengthResponse.error()));
+    }
+    if (lengthResponse->size() != 2) {
+        CubeLog::error("Bmi270Accelerometer FIFO length read returned an unexpected payload length.");
+        return std::unexpected(Bmi270Error::InvalidResponse);
+    }
+
+    const uint16_t fifoBytes = static_cast<uint16_t>(decodeLittleEndianI16(*lengthResponse, 0)) & kBmi270FifoLengthMask;
+    const size_t frameCount = std::min<size_t>(fifoBytes / kBmi270AccelerationPayloadLength, kMaxFifoBatchSamples);
+    std::vector<Bmi270AccelerationSample> samples;
+    if (frameCount == 0) {
+        return samples;
+    }
+
+    const size_t payloadLength = frameCount * kBmi270AccelerationPayloadLength;
+    const auto payload = readRegisters(kBmi270RegisterFifoData, payloadLength);
+    if (!payload) {
+        return std::unexpected(toBmi270Error(payload.error()));
+    }
+    if (payload->size() != payloadLength) {
+        CubeLog::error("Bmi270Accelerometer FIFO data read returned an unexpected payload length.");
+        return std::unexpected(Bmi270Error::InvalidResponse);
+    }
+
+    samples.reserve(frameCount);
+    for (size_t offset = 0; offset < payloadLength; offset += kBmi270AccelerationPayloadLength) {
+        const int16_t rawX = decodeLittleEndianI16(*payload, offset);
+        const int16_t rawY = decodeLittleEndianI16(*payload, offset + 2);
+        const int16_t rawZ = decodeLittleEndianI16(*payload, offset + 4);
+        if (rawX == kBmi270FifoEmptyAxis && rawY == kBmi270FifoEmptyAxis && rawZ == kBmi270FifoEmptyAxis) {
+            continue;
+        }
+        samples.push_back(Bmi270AccelerationSample {
+            .xG = static_cast<float>(rawX) / kBmi270LsbPerG,
+            .yG = static_cast<float>(rawY) / kBmi270LsbPerG,
+            .zG = static_cast<float>(rawZ) / kBmi270LsbPerG,
+        });
+    }
+    return samples;
+}
+
+Bmi270InteractionStatus Bmi270Accelerometer::classifyBatch(const std::vector<Bmi270AccelerationSample>& samples)
+{
+    Bmi270InteractionStatus batch;
+    batch.sampleCount = samples.size();
+
+    uint16_t outputDataRateHz = Bmi270FifoConfig {}.outputDataRateHz;
+    {
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        if (samples.empty()) {
+            batch.latestSample = previousSample_;
+            return batch;
+        }
+        if (fifoConfig_) {
+            outputDataRateHz = fifoConfig_->outputDataRateHz;
+        }
+    }
+
+    // The newest frame was sampled roughly now; older frames are spaced one ODR period apart before it, which
+    // keeps the tap debounce in sensor time however late the batch is drained.
+    const auto samplePeriod = std::chrono::microseconds(1'000'000 / outputDataRateHz);
+    const auto batchEnd = now();
+    bool everySampleStill = true;
+    for (size_t index = 0; index < samples.size(); ++index) {
+        const auto sampledAt = batchEnd - samplePeriod * static_cast<int64_t>(samples.size() - 1 - index);
+        const auto status = classifyInteraction(samples[index], sampledAt);
+        batch.interruptStatus.tapDetected = batch.interruptStatus.tapDetected || status.interruptStatus.tapDetected;
+        batch.interruptStatus.motionDetected = batch.interruptStatus.motionDetected || status.interruptStatus.motionDetected;
+        everySampleStill = everySampleStill && status.interruptStatus.noMotionDetected;
+    }
+    batch.interruptStatus.noMotionDetected = everySampleStill;
+    packRawStatus(batch.interruptStatus);
+    batch.latestSample = samples.back();
+    return batch;
 }
 
-Bmi270InteractionStatus Bmi270Accelerometer::classifyInteraction(const Bmi270AccelerationSample& sample)
+Bmi270InteractionStatus Bmi270Accelerometer::classifyInteraction(
+    const Bmi270AccelerationSample& sample,
+    std::chrono::steady_clock::time_point sampledAt)
 {
     Bmi270InteractionStatus status;
     status.latestSample = sample;
@@ -257,8 +518,9 @@ Bmi270InteractionStatus Bmi270Accelerometer::classifyInteraction(const Bmi270Acc
 
     const float magnitude = sampleMagnitude(sample);
     const float restDelta = std::fabs(magnitude - kRestMagnitudeTargetG);
-    const float deltaFromPrevious = previousSample_.has_value()
-        ? sampleDistance(sample, *previousSample_)
+    const auto reference = deltaReferenceFor(sampledAt);
+    const float deltaFromPrevious = reference.has_value()
+        ? sampleDistance(sample, *reference)
         : 0.0f;
 
     if (interactionConfig_.liftDetectionEnabled) {
@@ -269,26 +531,48 @@ Bmi270InteractionStatus Bmi270Accelerometer::classifyInteraction(const Bmi270Acc
     }
 
     if (interactionConfig_.tapDetectionEnabled) {
-        const auto now = std::chrono::steady_clock::now();
         const bool debounceExpired = !lastTapAt_.has_value()
-            || std::chrono::duration_cast<std::chrono::milliseconds>(now - *lastTapAt_).count() >= interactionConfig_.tapDebounceMs;
+            || std::chrono::duration_cast<std::chrono::milliseconds>(sampledAt - *lastTapAt_).count() >= interactionConfig_.tapDebounceMs;
 
         if (debounceExpired
             && (restDelta + deltaFromPrevious) >= interactionConfig_.tapPeakThresholdG) {
             status.interruptStatus.tapDetected = true;
-            lastTapAt_ = now;
+            lastTapAt_ = sampledAt;
         }
     }
 
-    status.interruptStatus.rawStatus
-        = static_cast<uint16_t>((status.interruptStatus.tapDetected ? 0x0001U : 0U)
-            | (status.interruptStatus.motionDetected ? 0x0002U : 0U)
-            | (status.interruptStatus.noMotionDetected ? 0x0004U : 0U));
+    packRawStatus(status.interruptStatus);
 
     previousSample_ = sample;
+    recentSamples_.push_back(TimedSample { .sampledAt = sampledAt, .sample = sample });
+    if (recentSamples_.size() > kMaxRecentSamples) {
+        recentSamples_.pop_front();
+    }
     return status;
 }
 
+/**
+ * @brief Pick the sample a delta is measured against: the newest one at least kInteractionDeltaSpan older than
+ * sampledAt, or the oldest one kept while less history than that exists. Polled every 50 ms or slower this
+ * is simply the previous sample; drained from a 100 Hz FIFO it is the sample five frames back. Expects stateMutex_ to be held.
+ */
+std::optional<Bmi270AccelerationSample> Bmi270Accelerometer::deltaReferenceFor(std::chrono::steady_clock::time_point sampledAt)
+{
+    while (recentSamples_.size() >= 2 && sampledAt - recentSamples_[1].sampledAt >= kInteractionDeltaSpan) {
+        recentSamples_.pop_front();
+    }
+    if (recentSamples_.empty()) {
+        return std::nullopt;
+    }
+    return recentSamples_.front().sample;
+}
+
+std::chrono::steady_clock::time_point Bmi270Accelerometer::now() const
+{
+    std::lock_guard<std::mutex> lock(stateMutex_);
+    return monotonicNowReader_ ? monotonicNowReader_() : std::chrono::steady_clock::now();
+}
+
 std::expected<void, I2CError> Bmi270Accelerometer::writeRegister(uint8_t reg, uint8_t value) const
 {
     if (auto busReady = ensureBus(bus_); !busReady) {
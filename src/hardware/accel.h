@@ -46,10 +46,13 @@ the official support package, but this wrapper keeps the rest of CORE isolated f
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
+#include <deque>
 #include <expected>
+#include <functional>
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <vector>
 
 enum class Bmi270Error : uint8_t {
     NotInitialized = 0,
@@ -87,13 +90,24 @@ struct Bmi270InteractionConfig {
     uint16_t tapDebounceMs = 120;
 };
 
+// FIFO mode streams every sample into the sensor's FIFO and raises INT1 once watermarkSamples are buffered,
+// so the host reads a whole batch per wake-up instead of one register snapshot per poll.
+struct Bmi270FifoConfig {
+    uint16_t outputDataRateHz = 100;
+    uint16_t watermarkSamples = 16;
+};
+
 struct Bmi270InteractionStatus {
     Bmi270InterruptStatus interruptStatus;
     std::optional<Bmi270AccelerationSample> latestSample;
+    // Samples classified for this status: 1 when polled, the batch size when draining the FIFO.
+    size_t sampleCount = 0;
 };
 
 class Bmi270Accelerometer {
 public:
+    using MonotonicNowReader = std::function<std::chrono::steady_clock::time_point()>;
+
     Bmi270Accelerometer(std::shared_ptr<ILocalI2CBus> bus, uint16_t address = 0x68, bool tenBitAddress = false);
     virtual ~Bmi270Accelerometer() = default;
 
@@ -109,12 +123,30 @@ public:
     virtual std::expected<void, Bmi270Error> configureInteractionDetection(const Bmi270InteractionConfig& config);
     virtual std::expected<Bmi270InteractionStatus, Bmi270Error> pollInteractionStatus();
 
+    // Requests FIFO mode; it is applied by initialize(). If the FIFO cannot be configured the driver logs it
+    // and keeps polling single samples.
+    virtual std::expected<void, Bmi270Error> setFifoConfig(const Bmi270FifoConfig& config);
+    virtual bool isFifoEnabled() const;
+    void setMonotonicNowReader(MonotonicNowReader reader);
+
 protected:
     std::expected<void, I2CError> writeRegister(uint8_t reg, uint8_t value) const;
     std::expected<I2CBytes, I2CError> readRegisters(uint8_t reg, size_t length) const;
 
 private:
-    Bmi270InteractionStatus classifyInteraction(const Bmi270AccelerationSample& sample);
+    std::expected<void, Bmi270Error> enableFifo(const Bmi270FifoConfig& config);
+    std::expected<std::vector<Bmi270AccelerationSample>, Bmi270Error> readFifoSamples();
+    Bmi270InteractionStatus classifyBatch(const std::vector<Bmi270AccelerationSample>& samples);
+    Bmi270InteractionStatus classifyInteraction(
+        const Bmi270AccelerationSample& sample,
+        std::chrono::steady_clock::time_point sampledAt);
+    std::chrono::steady_clock::time_point now() const;
+    std::optional<Bmi270AccelerationSample> deltaReferenceFor(std::chrono::steady_clock::time_point sampledAt);
+
+    struct TimedSample {
+        std::chrono::steady_clock::time_point sampledAt;
+        Bmi270AccelerationSample sample;
+    };
 
     std::shared_ptr<ILocalI2CBus> bus_;
     uint16_t address_ = 0;
@@ -126,7 +158,11 @@ private:
     bool interactionConfigured_ = false;
     Bmi270InteractionConfig interactionConfig_ {};
     std::optional<Bmi270AccelerationSample> previousSample_ {};
+    std::deque<TimedSample> recentSamples_ {};
     std::optional<std::chrono::steady_clock::time_point> lastTapAt_ {};
+    std::optional<Bmi270FifoConfig> fifoConfig_ {};
+    bool fifoEnabled_ = false;
+    MonotonicNowReader monotonicNowReader_;
 };
 
 #endif
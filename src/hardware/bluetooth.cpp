@@ -47,7 +47,9 @@ TODO: since the BT_Manager app is far from complete, we should just mock the blu
 #include "bluetooth.h"
 
 
-void startMock(std::stop_token st);
+#ifndef PRODUCTION_BUILD
+std::unique_ptr<BtBridgeStandIn> startMock();
+#endif
 bool launchProcess(const std::string& execPath, const std::string& execArgs);
 bool launchProcess(const std::string& execPath, const std::string& execArgs, std::string& result);
 
@@ -63,25 +65,64 @@ bool launchProcess(const std::string& execPath, const std::string& execArgs, std
 /**
  *
  *  TODO: In order to comply with Qt licensing, we will have to have all the code that interfaces
- * with the Qt bluetooth module in a separate application. This app will then use http over unix sockets
+ * with the Qt bluetooth module in a separate application. This app will then talk to the main application over a framed unix socket
  * to communicate with the main application.
  */
 
-BTControl::BTControl(uuids::uuid authUUID)
+namespace {
+
+std::string stringField(const nlohmann::json& object, const char* key)
 {
-    this->authUUID = authUUID;
-    // First thing to do is see if the BTManager is running
-    // If it is, we will connect to it and get the client_id
-    // If it is not, we will start it and then connect to it
-#ifndef PRODUCTION_BUILD
-    // TODO: Heap-allocating std::jthread/HTTP server/client objects here is fragile because destruction depends on matching manual delete/join paths; make them direct members or std::unique_ptr-owned resources.
-    mockThread = new std::jthread(startMock);
-#endif
-    this->server = new httplib::Server();
-    unlink("/tmp/cube/bt_control.sock");
-    this->address = "/tmp/cube/bt_control.sock";
-    this->port = 0;
+    const auto it = object.find(key);
+    if (it == object.end()) {
+        return "";
+    }
+    return it->is_string() ? it->get<std::string>() : it->dump();
+}
+
+bool boolField(const nlohmann::json& object, const char* key)
+{
+    const auto it = object.find(key);
+    return it != object.end() && (it->is_boolean() ? it->get<bool>() : stringField(object, key) == "true");
+}
+
+// Device payloads use "name" in lists and "device" in events.
+BTDevice btDeviceFromJson(const nlohmann::json& object)
+{
+    BTDevice dev {};
+    dev.mac = stringField(object, "mac");
+    dev.name = object.contains("name") ? stringField(object, "name") : stringField(object, "device");
+    dev.alias = stringField(object, "alias");
+    dev.rssi = stringField(object, "rssi");
+    dev.manufacturer = stringField(object, "manufacturer");
+    dev.paired = boolField(object, "paired");
+    dev.connected = boolField(object, "connected");
+    dev.trusted = boolField(object, "trusted");
+    dev.blocked = boolField(object, "blocked");
+    return dev;
+}
+
+void eraseByMac(std::vector<BTDevice>& devices, const std::string& mac)
+{
+    std::erase_if(devices, [&mac](const BTDevice& device) { return device.mac == mac; });
+}
+
+bool callSucceeded(BtBridgeClient& bridge, const std::string& method, const nlohmann::json& params = nlohmann::json::object())
+{
+    const auto result = bridge.call(method, params);
+    if (!result) {
+        CubeLog::error("Bluetooth helper " + method + " failed: " + btBridgeErrorToString(result.error()));
+        return false;
+    }
+    CubeLog::info("Bluetooth helper " + method + ": " + result->dump());
+    return true;
+}
 
+} // namespace
+
+BTControl::BTControl(std::shared_ptr<BtBridgeClient> bridge)
+    : bridge(std::move(bridge))
+{
     nlohmann::json config;
     std::filesystem::path configPath = std::filesystem::current_path() / "data" / "bt_control.json";
     std::ifstream file(configPath);
@@ -89,388 +130,70 @@ BTControl::BTControl(uuids::uuid authUUID)
         file >> config;
     } else {
         CubeLog::error("Error opening file: " + configPath.string());
-        file.close();
         // TODO: create a default config for basic functionality in the event the file is not found
     }
     file.close();
-    config["CB_baseAddress"] = this->address;
-    config["CB_port"] = this->port;
 
-    // here is where we call the setup function in the BTManager
-    this->client = new httplib::Client(BT_MANAGER_ADDRESS);
     this->client_id = "none";
-    this->client->set_default_headers({
-        {"Authorization", "Bearer " + uuids::to_string(this->authUUID)}
+    // Registered once; the bridge repeats the setup whenever it reconnects to the helper.
+    this->bridge->registerClient(config, [this](const std::string& clientId) {
+        std::lock_guard<std::mutex> lock(this->m);
+        this->client_id = clientId;
     });
-    httplib::Result res = this->client->Post("/setup", config.dump(), "application/json");
-    if (!res) {
-        CubeLog::error("Error getting response: " + std::string(BT_MANAGER_ADDRESS) + "/setup");
-    } else if (res->status != 200) {
-        CubeLog::error("Response code: " + std::to_string(res->status));
-    } else {
-        CubeLog::info("Response: " + res->body + "From: " + std::string(BT_MANAGER_ADDRESS) + "/setup");
-        nlohmann::json j = nlohmann::json::parse(res->body);
-        if (j.contains("client_id")) {
-            this->client_id = j["client_id"];
-        }else{
-            CubeLog::error("Error getting client_id from response: " + std::string(BT_MANAGER_ADDRESS) + "/setup");
-        }
-    }
-
-    // TODO: Setup all the callback endpoints
-    this->server->Get("/device_connected", [&](const httplib::Request& req, httplib::Response& res) {
-        if (!req.has_param("mac")) {
-            res.set_content("Missing parameter", "text/plain");
-            CubeLog::error("device_connected called: missing parameter.");
-            return;
-        }
-        std::string mac = req.get_param_value("mac");
-        std::string device = "";
-        if (req.has_param("device")) {
-            device = req.get_param_value("device");
-        }
-        bool paired = false;
-        if (req.has_param("paired")) {
-            paired = req.get_param_value("paired") == "true";
-        }
-        std::string rssi = "";
-        if (req.has_param("rssi")) {
-            rssi = req.get_param_value("rssi");
-        }
-        std::string alias = "";
-        if (req.has_param("alias")) {
-            alias = req.get_param_value("alias");
-        }
-        std::string manufacturer = "";
-        if (req.has_param("manufacturer")) {
-            manufacturer = req.get_param_value("manufacturer");
-        }
-        bool connected = false;
-        if (req.has_param("connected")) {
-            connected = req.get_param_value("connected") == "true";
-        }
-        bool trusted = false;
-        if (req.has_param("trusted")) {
-            trusted = req.get_param_value("trusted") == "true";
-        }
-        bool blocked = false;
-        if (req.has_param("blocked")) {
-            blocked = req.get_param_value("blocked") == "true";
-        }
-        BTDevice dev;
-        dev.name = device;
-        dev.mac = mac;
-        dev.paired = paired;
-        dev.rssi = rssi;
-        dev.alias = alias;
-        dev.manufacturer = manufacturer;
-        dev.connected = connected;
-        dev.trusted = trusted;
-        dev.blocked = blocked;
-        // verify that the device is not already in the list
-        for (auto d : this->devices) {
-            if (d.mac == dev.mac) {
-                return;
-            }
-        }
-        this->devices.push_back(dev);
-        if (dev.connected) {
-            this->connectedDevices.push_back(dev);
-        }
-        if (dev.paired) {
-            this->pairedDevices.push_back(dev);
-        }
-        if (dev.connected && dev.paired) {
-            this->availableDevices.push_back(dev);
-        }
-        std::string response = "Device added to devices list. ";
-        if (dev.connected) {
-            response += "Device added to connected list. ";
-        }
-        if (dev.paired) {
-            response += "Device added to paired list. ";
-        }
-        if (dev.connected && dev.paired) {
-            response += "Device added to available list. ";
-        }
-        res.set_content(response, "text/plain");
+    this->bridge->addNotificationHandler([this](const std::string& event, const nlohmann::json& payload) {
+        this->handleNotification(event, payload);
     });
 
-    this->server->Get("/device_disconnected", [&](const httplib::Request& req, httplib::Response& res) {
-        if (!req.has_param("mac")) {
-            res.set_content("Missing parameter", "text/plain");
-            CubeLog::error("device_connected called: missing parameter.");
-            return;
-        }
-        std::string mac = req.get_param_value("mac");
-        std::string device = "";
-        if (req.has_param("device")) {
-            device = req.get_param_value("device");
-        }
-        bool paired = false;
-        if (req.has_param("paired")) {
-            paired = req.get_param_value("paired") == "true";
-        }
-        std::string rssi = "";
-        if (req.has_param("rssi")) {
-            rssi = req.get_param_value("rssi");
-        }
-        std::string alias = "";
-        if (req.has_param("alias")) {
-            alias = req.get_param_value("alias");
-        }
-        std::string manufacturer = "";
-        if (req.has_param("manufacturer")) {
-            manufacturer = req.get_param_value("manufacturer");
-        }
-        bool connected = false;
-        if (req.has_param("connected")) {
-            connected = req.get_param_value("connected") == "true";
-        }
-        bool trusted = false;
-        if (req.has_param("trusted")) {
-            trusted = req.get_param_value("trusted") == "true";
-        }
-        bool blocked = false;
-        if (req.has_param("blocked")) {
-            blocked = req.get_param_value("blocked") == "true";
-        }
-        BTDevice dev;
-        dev.name = device;
-        dev.mac = mac;
-        dev.paired = paired;
-        dev.rssi = rssi;
-        dev.alias = alias;
-        dev.manufacturer = manufacturer;
-        dev.connected = connected;
-        dev.trusted = trusted;
-        dev.blocked = blocked;
-        // verify that the device is not already in the list
-        bool found = false;
-        for (auto d : this->devices) {
-            if (d.mac == dev.mac) {
-                found = true;
-            }
-        }
-        if (!found)
-            this->devices.push_back(dev);
-        std::string response = "Device added to devices list. ";
-        if (!dev.connected) {
-            // remove the device from the connected list
-            for (auto it = this->connectedDevices.begin(); it != this->connectedDevices.end(); it++) {
-                if (it->mac == dev.mac) {
-                    this->connectedDevices.erase(it);
-                    break;
-                }
-            }
-        }
-        res.set_content(response, "text/plain");
-    });
-
-    this->server->Get("/device_paired", [&](const httplib::Request& req, httplib::Response& res) {
-        if (!req.has_param("mac")) {
-            res.set_content("Missing parameter", "text/plain");
-            CubeLog::error("device_connected called: missing parameter.");
-            return;
-        }
-        std::string mac = req.get_param_value("mac");
-        std::string device = "";
-        if (req.has_param("device")) {
-            device = req.get_param_value("device");
-        }
-        bool paired = false;
-        if (req.has_param("paired")) {
-            paired = req.get_param_value("paired") == "true";
-        }
-        std::string rssi = "";
-        if (req.has_param("rssi")) {
-            rssi = req.get_param_value("rssi");
-        }
-        std::string alias = "";
-        if (req.has_param("alias")) {
-            alias = req.get_param_value("alias");
-        }
-        std::string manufacturer = "";
-        if (req.has_param("manufacturer")) {
-            manufacturer = req.get_param_value("manufacturer");
-        }
-        bool connected = false;
-        if (req.has_param("connected")) {
-            connected = req.get_param_value("connected") == "true";
-        }
-        bool trusted = false;
-        if (req.has_param("trusted")) {
-            trusted = req.get_param_value("trusted") == "true";
-        }
-        bool blocked = false;
-        if (req.has_param("blocked")) {
-            blocked = req.get_param_value("blocked") == "true";
-        }
-        BTDevice dev;
-        dev.name = device;
-        dev.mac = mac;
-        dev.paired = paired;
-        dev.rssi = rssi;
-        dev.alias = alias;
-        dev.manufacturer = manufacturer;
-        dev.connected = connected;
-        dev.trusted = trusted;
-        dev.blocked = blocked;
-        // verify that the device is not already in the list
-        bool found = false;
-        for (auto d : this->devices) {
-            if (d.mac == dev.mac) {
-                found = true;
-            }
-        }
-        if (!found)
-            this->devices.push_back(dev);
-        std::string response = "Device added to devices list. ";
-        if (!dev.paired) {
-            // remove the device from the paired list
-            for (auto it = this->pairedDevices.begin(); it != this->pairedDevices.end(); it++) {
-                if (it->mac == dev.mac) {
-                    this->pairedDevices.erase(it);
-                    break;
-                }
-            }
-        } else {
-            // add the device to the paired list
-            this->pairedDevices.push_back(dev);
-        }
-        res.set_content(response, "text/plain");
-    });
+    // TODO: register the callbacks with the GlobalSettings class so that the enabled/disable/etc actions get called when the setting is changed.
+}
 
-    this->server->Get("/device_unpaired", [&](const httplib::Request& req, httplib::Response& res) {
-        if (!req.has_param("mac")) {
-            res.set_content("Missing parameter", "text/plain");
-            CubeLog::error("device_connected called: missing parameter.");
-            return;
-        }
-        std::string mac = req.get_param_value("mac");
-        std::string device = "";
-        if (req.has_param("device")) {
-            device = req.get_param_value("device");
-        }
-        bool paired = false;
-        if (req.has_param("paired")) {
-            paired = req.get_param_value("paired") == "true";
-        }
-        std::string rssi = "";
-        if (req.has_param("rssi")) {
-            rssi = req.get_param_value("rssi");
-        }
-        std::string alias = "";
-        if (req.has_param("alias")) {
-            alias = req.get_param_value("alias");
-        }
-        std::string manufacturer = "";
-        if (req.has_param("manufacturer")) {
-            manufacturer = req.get_param_value("manufacturer");
-        }
-        bool connected = false;
-        if (req.has_param("connected")) {
-            connected = req.get_param_value("connected") == "true";
-        }
-        bool trusted = false;
-        if (req.has_param("trusted")) {
-            trusted = req.get_param_value("trusted") == "true";
-        }
-        bool blocked = false;
-        if (req.has_param("blocked")) {
-            blocked = req.get_param_value("blocked") == "true";
-        }
-        BTDevice dev;
-        dev.name = device;
-        dev.mac = mac;
-        dev.paired = paired;
-        dev.rssi = rssi;
-        dev.alias = alias;
-        dev.manufacturer = manufacturer;
-        dev.connected = connected;
-        dev.trusted = trusted;
-        dev.blocked = blocked;
-        // verify that the device is not already in the list
-        bool found = false;
-        for (auto d : this->devices) {
-            if (d.mac == dev.mac) {
-                found = true;
-            }
+void BTControl::handleNotification(const std::string& event, const nlohmann::json& payload)
+{
+    if (event == "connection_error") {
+        CubeLog::error("Connection error: " + stringField(payload, "error"));
+        return;
+    }
+    if (event == "pairing_request") {
+        CubeLog::info("Pairing request from: " + stringField(payload, "device") + " with mac: " + stringField(payload, "mac"));
+        if (payload.contains("passkey")) {
+            CubeLog::info("Passkey: " + stringField(payload, "passkey"));
         }
-        if (!found)
-            this->devices.push_back(dev);
-        std::string response = "Device added to devices list. ";
-        if (!dev.paired) {
-            // remove the device from the paired list
-            for (auto it = this->pairedDevices.begin(); it != this->pairedDevices.end(); it++) {
-                if (it->mac == dev.mac) {
-                    this->pairedDevices.erase(it);
-                    break;
-                }
-            }
+        if (payload.contains("pin")) {
+            CubeLog::info("Pin: " + stringField(payload, "pin"));
         }
-        res.set_content(response, "text/plain");
-    });
+        // TODO: need to prompt the user to accept the pairing request. This will require a call to the appropriate GUI function.
+        // Once the user has accepted the pairing request, we will need to call the appropriate function in the BTManager to accept the pairing request.
+        return;
+    }
+    if (event == "pairing_success" || event == "pairing_failure") {
+        CubeLog::info(std::string(event == "pairing_success" ? "Pairing success" : "Pairing failure") + " from: " + stringField(payload, "device") + " with mac: " + stringField(payload, "mac"));
+        // TODO: notify the user
+        return;
+    }
+    if (event == "bluetooth_enabled" || event == "bluetooth_disabled") {
+        CubeLog::info(event == "bluetooth_enabled" ? "Bluetooth enabled" : "Bluetooth disabled");
+        // TODO: update the Global setting for bluetooth enabled
+        return;
+    }
+    if (event != "device_connected" && event != "device_disconnected" && event != "device_paired"
+        && event != "device_unpaired" && event != "device_discovered") {
+        return;
+    }
+    if (!payload.contains("mac")) {
+        CubeLog::error(event + " notification: missing mac.");
+        return;
+    }
 
-    this->server->Get("/device_discovered", [&](const httplib::Request& req, httplib::Response& res) {
-        if (!req.has_param("mac")) {
-            res.set_content("Missing parameter", "text/plain");
-            CubeLog::error("device_connected called: missing parameter.");
+    const BTDevice dev = btDeviceFromJson(payload);
+    std::lock_guard<std::mutex> lock(this->m);
+    const bool known = std::any_of(this->devices.begin(), this->devices.end(), [&dev](const BTDevice& d) { return d.mac == dev.mac; });
+    if (!known) {
+        this->devices.push_back(dev);
+    }
+    if (event == "device_connected" || event == "device_discovered") {
+        if (event == "device_connected" && known) {
             return;
         }
-        std::string mac = req.get_param_value("mac");
-        std::string device = "";
-        if (req.has_param("device")) {
-            device = req.get_param_value("device");
-        }
-        bool paired = false;
-        if (req.has_param("paired")) {
-            paired = req.get_param_value("paired") == "true";
-        }
-        std::string rssi = "";
-        if (req.has_param("rssi")) {
-            rssi = req.get_param_value("rssi");
-        }
-        std::string alias = "";
-        if (req.has_param("alias")) {
-            alias = req.get_param_value("alias");
-        }
-        std::string manufacturer = "";
-        if (req.has_param("manufacturer")) {
-            manufacturer = req.get_param_value("manufacturer");
-        }
-        bool connected = false;
-        if (req.has_param("connected")) {
-            connected = req.get_param_value("connected") == "true";
-        }
-        bool trusted = false;
-        if (req.has_param("trusted")) {
-            trusted = req.get_param_value("trusted") == "true";
-        }
-        bool blocked = false;
-        if (req.has_param("blocked")) {
-            blocked = req.get_param_value("blocked") == "true";
-        }
-        BTDevice dev;
-        dev.name = device;
-        dev.mac = mac;
-        dev.paired = paired;
-        dev.rssi = rssi;
-        dev.alias = alias;
-        dev.manufacturer = manufacturer;
-        dev.connected = connected;
-        dev.trusted = trusted;
-        dev.blocked = blocked;
-        // verify that the device is not already in the list
-        bool found = false;
-        for (auto d : this->devices) {
-            if (d.mac == dev.mac) {
-                found = true;
-            }
-        }
-        if (!found)
-            this->devices.push_back(dev);
-        std::string response = "Device added to devices list. ";
         if (dev.connected) {
             this->connectedDevices.push_back(dev);
         }
@@ -480,472 +203,150 @@ BTControl::BTControl(uuids::uuid authUUID)
         if (dev.connected && dev.paired) {
             this->availableDevices.push_back(dev);
         }
-        res.set_content(response, "text/plain");
-    });
-
-    this->server->Get("/connection_error", [&](const httplib::Request& req, httplib::Response& res) {
-        if (!req.has_param("error")) {
-            res.set_content("Missing parameter", "text/plain");
-            CubeLog::error("device_connected called: missing parameter.");
-            return;
-        }
-        std::string error = req.get_param_value("error");
-        CubeLog::error("Connection error: " + error);
-        res.set_content("ok", "text/plain");
-    });
-
-    this->server->Get("/pairing_request", [&](const httplib::Request& req, httplib::Response& res) {
-        if (!req.has_param("mac") || !req.has_param("device")) {
-            res.set_content("Missing parameter", "text/plain");
-            CubeLog::error("device_connected called: missing parameter.");
-            return;
-        }
-        std::string device = req.get_param_value("device");
-        std::string mac = req.get_param_value("mac");
-
-        std::string passkey = "";
-        if (req.has_param("passkey")) {
-            passkey = req.get_param_value("passkey");
-        }
-        std::string pin = "";
-        if (req.has_param("pin")) {
-            pin = req.get_param_value("pin");
-        }
-
-        CubeLog::info("Pairing request from: " + device + " with mac: " + mac);
-        if (!passkey.empty()) {
-            CubeLog::info("Passkey: " + passkey);
-        }
-        if (!pin.empty()) {
-            CubeLog::info("Pin: " + pin);
-        }
-        // TODO: need to prompt the user to accept the pairing request. This will require a call to the appropriate GUI function.
-        // Once the user has accepted the pairing request, we will need to call the appropriate function in the BTManager to accept the pairing request.
-        res.set_content("ok", "text/plain");
-    });
-
-    this->server->Get("/pairing_success", [&](const httplib::Request& req, httplib::Response& res) {
-        if (!req.has_param("mac") || !req.has_param("device")) {
-            res.set_content("Missing parameter", "text/plain");
-            CubeLog::error("device_connected called: missing parameter.");
-            return;
-        }
-        std::string device = req.get_param_value("device");
-        std::string mac = req.get_param_value("mac");
-
-        CubeLog::info("Pairing success from: " + device + " with mac: " + mac);
-        // TODO: notify the user
-        res.set_content("ok", "text/plain");
-    });
-
-    this->server->Get("/pairing_failure", [&](const httplib::Request& req, httplib::Response& res) {
-        if (!req.has_param("mac") || !req.has_param("device")) {
-            res.set_content("Missing parameter", "text/plain");
-            CubeLog::error("device_connected called: missing parameter.");
-            return;
+    } else if (event == "device_disconnected") {
+        if (!dev.connected) {
+            eraseByMac(this->connectedDevices, dev.mac);
         }
-        std::string device = req.get_param_value("device");
-        std::string mac = req.get_param_value("mac");
-
-        CubeLog::info("Pairing failure from: " + device + " with mac: " + mac);
-        // TODO: notify the user
-        res.set_content("ok", "text/plain");
-    });
-
-    this->server->Get("/bluetooth_enabled", [&](const httplib::Request& req, httplib::Response& res) {
-        CubeLog::info("Bluetooth enabled");
-        // TODO: update the Global setting for bluetooth enabled
-        res.set_content("ok", "text/plain");
-    });
-
-    this->server->Get("/bluetooth_disabled", [&](const httplib::Request& req, httplib::Response& res) {
-        CubeLog::info("Bluetooth disabled");
-        // TODO: update the Global setting for bluetooth enabled
-        res.set_content("ok", "text/plain");
-    });
-
-    // this->server->Get("/scan_started") // TODO:
-    // this->server->Get("/scan_stopped")
-    // this->server->Get("/bonding_started")
-    // this->server->Get("/bonding_completed")
-    // this->server->Get("/bonding_failed")
-
-    // TODO: register the callbacks with the GlobalSettings class so that the enabled/disable/etc actions get called when the setting is changed.
-
-    // Start the server
-    // TODO: These worker threads are manually heap-managed, which makes shutdown ordering easy to break; store std::jthread directly so stop/join happen through normal object lifetime.
-    this->serverThread = new std::jthread([&] {
-        this->server->set_address_family(AF_UNIX).listen(this->address, 80);
-    });
-
-    // Start the heartbeat thread
-    this->heartbeatThread = new std::jthread([&, config](std::stop_token st) {
-        nlohmann::json j;
-        unsigned long counter = 0;
-        while (!st.stop_requested()) {
-            genericSleep(100);
-            counter++;
-            if (counter % 100 != 0) {
-                continue;
-            }
-            if (this->client_id == "none") {
-                CubeLog::info("Client id not set. Attempting to get client id.");
-                httplib::Result res = this->client->Post("/setup", config.dump(), "application/json");
-                if (!res) {
-                    continue;
-                }
-                if (res->status != 200) {
-                    continue;
-                }
-                nlohmann::json j = nlohmann::json::parse(res->body);
-                if (j.contains("client_id")) {
-                    this->client_id = j["client_id"];
-                }
-                continue;
-            }
-            j["status"] = "alive";
-            j["client_id"] = this->client_id;
-            httplib::Result res = this->client->Post("/heartbeat", j.dump(), "application/json");
-            if (!res) {
-                CubeLog::error("Error getting response: " + std::string(BT_MANAGER_ADDRESS) + "/heartbeat");
-                this->client_id = "none";
-                continue;
-            }
-            if (res->status != 200) {
-                CubeLog::error("Response code: " + std::to_string(res->status));
-                this->client_id = "none";
-                continue;
-            }
-            if (res->body != "ok") {
-                CubeLog::error("Heartbeat failed: " + res->body);
-                this->client_id = "none";
-            }
+    } else if (event == "device_paired") {
+        if (dev.paired) {
+            this->pairedDevices.push_back(dev);
+        } else {
+            eraseByMac(this->pairedDevices, dev.mac);
         }
-        j["status"] = "shutdown";
-        j["client_id"] = this->client_id;
-        this->client->Post("/heartbeat", j.dump(), "application/json");
-    });
-}
-
-BTControl::~BTControl()
-{
-#ifndef PRODUCTION_BUILD
-    this->mockThread->request_stop();
-    this->mockThread->join();
-#endif
-    // TODO: Destructor cleanup is doing manual stop/delete/join across several heap-owned resources; replace with RAII members so shutdown cannot leak or double-delete on partial construction.
-    if(this->server != nullptr){
-        this->server->stop();
-        delete this->server;
+    } else if (!dev.paired) {
+        eraseByMac(this->pairedDevices, dev.mac);
     }
-    delete this->serverThread;
-    delete this->heartbeatThread;
 }
 
 bool BTControl::scanForDevices()
 {
-    httplib::Result res = this->client->Get("/scan");
-    if (!res) {
-        CubeLog::error("Error getting response: " + std::string(BT_MANAGER_ADDRESS) + "/scan");
-        return false;
-    }
-    if (res->status != 200) {
-        CubeLog::error("Response code: " + std::to_string(res->status));
-        return false;
-    }
-    CubeLog::info("Response: " + res->body + "From: " + "/scan");
-    if (res->body == "ok") {
-        return true;
-    }
-    return false;
+    return callSucceeded(*this->bridge, "scan");
 }
 
 bool BTControl::stopScanning()
 {
-    httplib::Result res = this->client->Get("/stop_scan");
-    if (!res) {
-        CubeLog::error("Error getting response: " + std::string(BT_MANAGER_ADDRESS) + "/stop_scan");
-        return false;
-    }
-    if (res->status != 200) {
-        CubeLog::error("Response code: " + std::to_string(res->status));
-        return false;
-    }
-    CubeLog::info("Response: " + res->body + "From: " + std::string(BT_MANAGER_ADDRESS) + "/stop_scan");
-    if (res->body == "ok") {
-        return true;
-    }
-    return false;
+    return callSucceeded(*this->bridge, "stop_scan");
 }
 
 bool BTControl::makeVisible(bool visible)
 {
-    httplib::Result res = this->client->Get("/set_visible?visible=" + std::string((visible ? "true" : "false")));
-    if (!res) {
-        CubeLog::error("Error getting response: " + std::string(BT_MANAGER_ADDRESS) + "/set_visible");
-        return false;
-    }
-    if (res->status != 200) {
-        CubeLog::error("Response code: " + std::to_string(res->status));
-        return false;
-    }
-    CubeLog::info("Response: " + res->body + "From: " + std::string(BT_MANAGER_ADDRESS) + "/set_visible");
-    if (res->body == "ok") {
-        return true;
-    }
-    return false;
+    return callSucceeded(*this->bridge, "set_visible", { { "visible", visible } });
 }
 
 bool BTControl::connectToDevice(BTDevice& device)
 {
-    httplib::Result res = this->client->Post("/connect", device.mac, "text/plain");
-    if (!res) {
-        CubeLog::error("Error getting response: " + std::string(BT_MANAGER_ADDRESS) + "/connect");
-        return false;
-    }
-    if (res->status != 200) {
-        CubeLog::error("Response code: " + std::to_string(res->status));
-        return false;
-    }
-    CubeLog::info("Response: " + res->body + "From: " + std::string(BT_MANAGER_ADDRESS) + "/connect");
-    if (res->body == "ok") {
-        return true;
-    }
-    return false;
+    return callSucceeded(*this->bridge, "connect", { { "mac", device.mac } });
 }
 
 bool BTControl::disconnectFromDevice(BTDevice& device)
 {
-    httplib::Result res = this->client->Post("/disconnect", device.mac, "text/plain");
-    if (!res) {
-        CubeLog::error("Error getting response: " + std::string(BT_MANAGER_ADDRESS) + "/disconnect");
-        return false;
-    }
-    if (res->status != 200) {
-        CubeLog::error("Response code: " + std::to_string(res->status));
-        return false;
-    }
-    CubeLog::info("Response: " + res->body + "From: " + std::string(BT_MANAGER_ADDRESS) + "/disconnect");
-    if (res->body == "ok") {
-        return true;
-    }
-    return false;
+    return callSucceeded(*this->bridge, "disconnect", { { "mac", device.mac } });
 }
 
 bool BTControl::pairWithDevice(BTDevice& device)
 {
-    httplib::Result res = this->client->Post("/pair", device.mac, "text/plain");
-    if (!res) {
-        CubeLog::error("Error getting response: " + std::string(BT_MANAGER_ADDRESS) + "/pair");
-        return false;
-    }
-    if (res->status != 200) {
-        CubeLog::error("Response code: " + std::to_string(res->status));
-        return false;
-    }
-    CubeLog::info("Response: " + res->body + "From: " + std::string(BT_MANAGER_ADDRESS) + "/pair");
-    if (res->body == "ok") {
-        return true;
-    }
-    return false;
+    return callSucceeded(*this->bridge, "pair", { { "mac", device.mac } });
 }
 
-std::vector<BTDevice> BTControl::getDevices()
+std::vector<BTDevice> BTControl::fetchDevices(const std::string& method)
 {
-    httplib::Result res = this->client->Get("/devices");
-    if (!res) {
-        CubeLog::error("Error getting response: " + std::string(BT_MANAGER_ADDRESS) + "/devices");
+    const auto result = this->bridge->call(method);
+    if (!result) {
+        CubeLog::error("Bluetooth helper " + method + " failed: " + btBridgeErrorToString(result.error()));
         return std::vector<BTDevice>();
     }
-    if (res->status != 200) {
-        CubeLog::error("Response code: " + std::to_string(res->status));
-        return std::vector<BTDevice>();
-    }
-    nlohmann::json resJson = nlohmann::json::parse(res->body);
     std::vector<BTDevice> devices;
-    for (auto d : resJson) {
-        BTDevice dev;
-        if(d.contains("name"))
-            dev.name = d["name"];
-        if(d.contains("mac"))
-            dev.mac = d["mac"];
-        if(d.contains("paired"))
-            dev.paired = d["paired"];
-        if(d.contains("rssi"))
-            dev.rssi = d["rssi"];
-        if(d.contains("alias"))
-            dev.alias = d["alias"];
-        if(d.contains("manufacturer"))
-            dev.manufacturer = d["manufacturer"];
-        if(d.contains("connected"))
-            dev.connected = d["connected"];
-        if(d.contains("trusted"))
-            dev.trusted = d["trusted"];
-        if(d.contains("blocked"))
-            dev.blocked = d["blocked"];
-        devices.push_back(dev);
+    if (!result->is_array()) {
+        CubeLog::error("Bluetooth helper " + method + " returned a non-array result.");
+        return devices;
+    }
+    for (const auto& d : *result) {
+        devices.push_back(btDeviceFromJson(d));
     }
     return devices;
 }
 
+std::vector<BTDevice> BTControl::getDevices()
+{
+    return this->fetchDevices("devices");
+}
+
 std::vector<BTDevice> BTControl::getPairedDevices()
 {
-    httplib::Result res = this->client->Get("/paired_devices");
-    if (!res) {
-        CubeLog::error("Error getting response: " + std::string(BT_MANAGER_ADDRESS) + "/paired_devices");
-        return std::vector<BTDevice>();
-    }
-    if (res->status != 200) {
-        CubeLog::error("Response code: " + std::to_string(res->status));
-        return std::vector<BTDevice>();
-    }
-    nlohmann::json resJson = nlohmann::json::parse(res->body);
-    std::vector<BTDevice> devices;
-    for (auto d : resJson) {
-        BTDevice dev;
-        if(d.contains("name"))
-            dev.name = d["name"];
-        if(d.contains("mac"))
-            dev.mac = d["mac"];
-        if(d.contains("paired"))
-            dev.paired = d["paired"];
-        if(d.contains("rssi"))
-            dev.rssi = d["rssi"];
-        if(d.contains("alias"))
-            dev.alias = d["alias"];
-        if(d.contains("manufacturer"))
-            dev.manufacturer = d["manufacturer"];
-        if(d.contains("connected"))
-            dev.connected = d["connected"];
-        if(d.contains("trusted"))
-            dev.trusted = d["trusted"];
-        if(d.contains("blocked"))
-            dev.blocked = d["blocked"];
-        devices.push_back(dev);
-    }
-    return devices;
+    return this->fetchDevices("paired_devices");
 }
 
 std::vector<BTDevice> BTControl::getConnectedDevices()
 {
-    httplib::Result res = this->client->Get("/connected_devices");
-    if (!res) {
-        CubeLog::error("Error getting response: " + std::string(BT_MANAGER_ADDRESS) + "/connected_devices");
-        return std::vector<BTDevice>();
-    }
-    if (res->status != 200) {
-        CubeLog::error("Response code: " + std::to_string(res->status));
-        return std::vector<BTDevice>();
-    }
-    nlohmann::json resJson = nlohmann::json::parse(res->body);
-    std::vector<BTDevice> devices;
-    for (auto d : resJson) {
-        BTDevice dev;
-        if(d.contains("name"))
-            dev.name = d["name"];
-        if(d.contains("mac"))
-            dev.mac = d["mac"];
-        if(d.contains("paired"))
-            dev.paired = d["paired"];
-        if(d.contains("rssi"))
-            dev.rssi = d["rssi"];
-        if(d.contains("alias"))
-            dev.alias = d["alias"];
-        if(d.contains("manufacturer"))
-            dev.manufacturer = d["manufacturer"];
-        if(d.contains("connected"))
-            dev.connected = d["connected"];
-        if(d.contains("trusted"))
-            dev.trusted = d["trusted"];
-        if(d.contains("blocked"))
-            dev.blocked = d["blocked"];
-        devices.push_back(dev);
-    }
-    return devices;
+    return this->fetchDevices("connected_devices");
 }
 
 std::vector<BTDevice> BTControl::getAvailableDevices()
 {
-    httplib::Result res = this->client->Get("/available_devices");
-    if (!res) {
-        CubeLog::error("Error getting response: " + std::string(BT_MANAGER_ADDRESS) + "/available_devices");
-        return std::vector<BTDevice>();
-    }
-    if (res->status != 200) {
-        CubeLog::error("Response code: " + std::to_string(res->status));
-        return std::vector<BTDevice>();
-    }
-    nlohmann::json resJson = nlohmann::json::parse(res->body);
-    std::vector<BTDevice> devices;
-    for (auto d : resJson) {
-        BTDevice dev;
-        if(d.contains("name"))
-            dev.name = d["name"];
-        if(d.contains("mac"))
-            dev.mac = d["mac"];
-        if(d.contains("paired"))
-            dev.paired = d["paired"];
-        if(d.contains("rssi"))
-            dev.rssi = d["rssi"];
-        if(d.contains("alias"))
-            dev.alias = d["alias"];
-        if(d.contains("manufacturer"))
-            dev.manufacturer = d["manufacturer"];
-        if(d.contains("connected"))
-            dev.connected = d["connected"];
-        if(d.contains("trusted"))
-            dev.trusted = d["trusted"];
-        if(d.contains("blocked"))
-            dev.blocked = d["blocked"];
-        devices.push_back(dev);
-    }
-    return devices;
+    return this->fetchDevices("available_devices");
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-BTService::BTService(const nlohmann::json& config, httplib::Server* server, uuids::uuid authUUID)
+BTService::BTService(const nlohmann::json& config, std::shared_ptr<BtBridgeClient> bridge)
+    : bridge(std::move(bridge))
 {
-    this->authUUID = authUUID;
     this->config = config;
-    this->server = server;
-    this->client = new httplib::Client(BT_MANAGER_ADDRESS);
-    this->client->set_default_headers({
-        {"Authorization", "Bearer " + uuids::to_string(this->authUUID)}
-    });
-    this->client_id = "none";
+    this->client_id = std::make_shared<ClientIdSlot>();
 }
 
 BTService::~BTService()
 {
-    delete this->client;
+    if (this->registration) {
+        this->bridge->unregisterClient(*this->registration);
+    }
+    for (auto* characteristic : this->characteristics) {
+        delete characteristic;
+    }
 }
 
 // To be called once all the characteristics have been added
 bool BTService::start()
 {
     this->characteristicsLocked = true;
-    httplib::Result res = this->client->Post("/setup", this->config.dump(), "application/json");
-    if (!res) {
-        CubeLog::error("Error getting response: " + std::string(BT_MANAGER_ADDRESS) + "/setup");
-        return false;
-    }
-    if (res->status != 200) {
-        CubeLog::error("Response code: " + std::to_string(res->status));
-        return false;
-    }
-    CubeLog::info("Response: " + res->body + "From: " + std::string(BT_MANAGER_ADDRESS) + "/setup");
-    nlohmann::json j = nlohmann::json::parse(res->body);
-    if (j.contains("client_id")) {
-        this->client_id = j["client_id"];
-    }
-    if(this->client_id == "none"){
-        CubeLog::error("Client id not set. Cannot create service.");
-        return false;
+    if (this->registration) {
+        return true;
     }
+    // Registered rather than sent once, so the bridge repeats the setup and refreshes the id after a reconnect.
+    this->registration = this->bridge->registerClient(this->config, [slot = this->client_id](const std::string& clientId) {
+        std::lock_guard<std::mutex> lock(slot->m);
+        slot->value = clientId;
+    });
     return true;
 }
 
+std::string BTService::getClientId()
+{
+    std::lock_guard<std::mutex> lock(this->client_id->m);
+    return this->client_id->value;
+}
+
+void BTService::handleGattWrite(const std::string& characteristic, const std::string& value)
+{
+    for (auto* c : this->characteristics) {
+        if (c->name != characteristic) {
+            continue;
+        }
+        switch (c->cbType) {
+        case BTCharacteristic::CBType::VOID_STRING:
+            c->callback_void_string(value);
+            return;
+        case BTCharacteristic::CBType::STRING_STRING:
+            c->callback_string_string(value);
+            return;
+        default:
+            CubeLog::error("Characteristic " + characteristic + " does not accept writes.");
+            return;
+        }
+    }
+    CubeLog::error("GATT write for unknown characteristic: " + characteristic);
+}
+
 void BTService::addCharacteristic(const std::string& name, uuids::uuid uuid, std::function<void(std::string)> callback)
 {
     if (this->characteristicsLocked) {
@@ -958,6 +359,7 @@ void BTService::addCharacteristic(const std::string& name, uuids::uuid uuid, std
     characteristic->uuid = uuid;
     characteristic->callback_void_string = callback;
     characteristic->cbType = BTCharacteristic::CBType::VOID_STRING;
+    this->characteristics.push_back(characteristic);
 }
 
 //////////////////////////////////////////////////////////////////////////////////
@@ -1011,130 +413,77 @@ BTManager::BTManager()
         // authServer.stop(); // stop the server now that we have the auth key
     }
 
-    // This class will handle the server for all the BTService class instances
-    // It will also handle the heartbeat for the BTManager
-
-    this->control = new BTControl(this->authUUID);
-    this->server = new httplib::Server();
-    this->client = new httplib::Client(BT_MANAGER_ADDRESS);
+    // This class owns the bridge that BTControl and every BTService share. Keepalives on the bridge
+    // replace the old heartbeat threads, and callbacks from the helper arrive as notifications on it.
+#ifndef PRODUCTION_BUILD
+    this->mock = startMock();
+#endif
+    BtBridgeOptions options;
+    options.socketPath = BT_MANAGER_ADDRESS;
+    options.authToken = uuids::to_string(this->authUUID);
+    this->bridge = std::make_shared<BtBridgeClient>(options);
     this->client_id = "none";
 
     this->config = nlohmann::json::object();
     this->config["name"] = "BTManager";
-    this->config["address"] = "localhost";
-    this->config["port"] = 80;
     this->config["characteristics_client_ids"] = nlohmann::json::array();
-    
 
     // TODO: add all the services that we want to use
     // This should probably be a member function of this class since we'll want to be able to add services via the API.
     // We should also define all the services in a json file that will use the same format that apps can use via the API.
     // Then all we have to do is load the json file and create the services.
-    // BTService service1(config, this->server);
+    // BTService service1(config, this->bridge);
     // this->config["characteristics_client_ids"].push_back("service1_client_id");
 
-    // TODO: this->client_id needs a mutex. When this class is destroyed, we need to make sure we can get a lock on that mutex
-    // so that we don't destroy the client_id while the heartbeat thread is still using it.
-
-    this->heartbeatThread = new std::jthread([&](std::stop_token st) {
-        nlohmann::json j;
-        while (!st.stop_requested()) {
-            genericSleep(10 * 1000);
-            if(st.stop_requested()){
-                break;
-            }
-            if (this->client_id == "none") {
-                CubeLog::info("Client id not set. Attempting to get client id.");
-                httplib::Result res = this->client->Post("/setup", this->config.dump(), "application/json");
-                if (!res) {
-                    continue;
-                }
-                if (res->status != 200) {
-                    continue;
-                }
-                this->client_id = res->body;
-                continue;
-            }
-            j["status"] = "alive";
-            j["client_id"] = this->client_id;
-            httplib::Result res = this->client->Post("/heartbeat", j.dump(), "application/json");
-            if (!res) {
-                CubeLog::error("Error getting response: " + std::string(BT_MANAGER_ADDRESS) + "/heartbeat");
-                this->client_id = "none";
-                continue;
-            }
-            if (res->status != 200) {
-                CubeLog::error("Response code: " + std::to_string(res->status));
-                this->client_id = "none";
-                continue;
-            }
-            if (res->body != "ok") {
-                CubeLog::error("Heartbeat failed: " + res->body);
-                this->client_id = "none";
+    this->bridge->registerClient(this->config, [this](const std::string& clientId) {
+        std::lock_guard<std::mutex> lock(this->m);
+        this->client_id = clientId;
+    });
+    // GATT writes are addressed to a service by its client id.
+    this->bridge->addNotificationHandler([this](const std::string& event, const nlohmann::json& payload) {
+        if (event != "gatt_write") {
+            return;
+        }
+        const std::string serviceId = stringField(payload, "client_id");
+        std::lock_guard<std::mutex> lock(this->m);
+        for (auto* service : this->services) {
+            if (service->getClientId() == serviceId) {
+                service->handleGattWrite(stringField(payload, "characteristic"), stringField(payload, "value"));
+                return;
             }
         }
-        j["status"] = "shutdown";
-        j["client_id"] = this->client_id;
-        this->client->Post("/heartbeat", j.dump(), "application/json");
-    });
-
-    // TODO: The server will need to listen for any incoming requests from the BTManager application and handle them.
-    // Requests can be either GET or POST and the address will have to be parsed to determine the action to take.
-    // Addresses will be in the form of /<client_id>/<action>?<params>
-    // <client_id> will be the client_id of one of the BTService instances stored in the services vector.
-    // Iterating through the services vector and checking the getClientId() function will allow us to determine the service to use.
-    // <action> will be the name of action to take on the BTService instance and are stored as 
-    // std::vector<BTCharacteristic*> characteristics in the BTService instance.
-    // <params> will be the parameters to pass to the action. These will be in the form of key=value pairs and are only applicable to
-    // GET requests. POST requests will have the parameters in the body of the request as JSON.
-    // for(auto c : service.getCharacteristics()){
-    //     if(c->getName() == action){
-    //         // do action. Actions may be any of BTCharacteristic::CBType and we will need to call the appropriate function
-    //         // on the BTService instance. Parameters will be parsed from either the address or the body of the request.
-    //     }
-    // }
-    // this->server->GET("/:client_id/:action", [&](const httplib::Request& req, httplib::Response& res) {
-    //     std::string client_id = req.path_params.at("client_id");
-    //     std::string action = req.path_params.at("action");
-    //     std::string params = req.params;
-    //     for(auto s : this->services){
-    //         if(s.getClientId() == client_id){
-    //             for(auto c : s.getCharacteristics()){
-    //                 if(c->getName() == action){
-    //                     // do action // Probably should break this part out to a function that will parse the params and call the appropriate function.
-    //                 }
-    //             }
-    //         }
-    //     }
-    //     res.set_content("ok", "text/plain"); // This will need to be changed to an appropriate response based on the action taken.
-    // });
-    // this->server->POST("/:client_id/:action", [&](const httplib::Request& req, httplib::Response& res) {
-    //     std::string client_id = req.path_params.at("client_id");
-    //     std::string action = req.path_params.at("action");
-    //     nlohmann::json j = nlohmann::json::parse(req.body);
-    //     for(auto s : this->services){
-    //         if(s.getClientId() == client_id){
-    //             for(auto c : s.getCharacteristics()){
-    //                 if(c->getName() == action){
-    //                     // do action // Probably should break this part out to a function that will parse the params and call the appropriate function.
-    //                 }
-    //             }
-    //         }
-    //     }
-    //     res.set_content("ok", "text/plain"); // This will need to be changed to an appropriate response based on the action taken.
-    // });
-
-    this->serverThread = new std::jthread([&] {
-
-        //this->server->set_address_family(AF_UNIX).listen(this->config["address"], this->config["port"]);
+        CubeLog::error("GATT write for unknown service: " + serviceId);
     });
+    this->control = std::make_unique<BTControl>(this->bridge);
+    this->bridge->start();
 }
 
 BTManager::~BTManager()
 {
-    delete this->control;
+    // Stop notifications before the objects they are delivered to go away.
+    this->bridge->stop();
+    this->control.reset();
+}
+
+void BTManager::addService(BTService* service)
+{
+    std::lock_guard<std::mutex> lock(this->m);
+    this->services.push_back(service);
+}
+
+void BTManager::removeService(BTService* service)
+{
+    std::lock_guard<std::mutex> lock(this->m);
+    std::erase(this->services, service);
 }
 
+std::string BTManager::getClientId()
+{
+    std::lock_guard<std::mutex> lock(this->m);
+    return this->client_id;
+}
+
+
 HttpEndPointData_t BTManager::getHttpEndpointData()
 {
     HttpEndPointData_t data;
@@ -1145,7 +494,7 @@ HttpEndPointData_t BTManager::getHttpEndpointData()
         httplib::Response& res) {
             // TODO: This should shutdown the BTManager class enough to allow adding new BT Services.
             nlohmann::json j;
-            j["client_id"] = this->client_id;
+            j["client_id"] = this->getClientId();
             res.set_content(j.dump(), "application/json");
             return EndpointError(EndpointError::ERROR_TYPES::ENDPOINT_NO_ERROR , "");
         },
@@ -1159,7 +508,7 @@ HttpEndPointData_t BTManager::getHttpEndpointData()
         httplib::Response& res) {
             // TODO: This should start the BTManager class after it has been stopped.
             nlohmann::json j;
-            j["client_id"] = this->client_id;
+            j["client_id"] = this->getClientId();
             res.set_content(j.dump(), "application/json");
             return EndpointError(EndpointError::ERROR_TYPES::ENDPOINT_NO_ERROR , "");
         },
@@ -1173,7 +522,7 @@ HttpEndPointData_t BTManager::getHttpEndpointData()
         httplib::Response& res) {
             // TODO: This should provide a way to add a new BT Service to the BTManager.
             nlohmann::json j;
-            j["client_id"] = this->client_id;
+            j["client_id"] = this->getClientId();
             res.set_content(j.dump(), "application/json");
             return EndpointError(EndpointError::ERROR_TYPES::ENDPOINT_NO_ERROR , "");
             /*
@@ -1197,101 +546,38 @@ std::string BTManager::getInterfaceName() const
     return "Bluetooth";
 }
 
-//////////////////////////////////////////////////////////////////////////////////
-
-void startMock(std::stop_token st){
-    httplib::Server server;
-    server.Get("/setup", [](const httplib::Request& req, httplib::Response& res) {
-        nlohmann::json j;
-        j["client_id"] = "mock";
-        res.set_content(j.dump(), "application/json");
-    });
-
-    server.Post("/setup", [](const httplib::Request& req, httplib::Response& res) {
-        nlohmann::json j;
-        j["client_id"] = "mock";
-        res.set_content(j.dump(), "application/json");
-    });
-
-    server.Get("/heartbeat", [](const httplib::Request& req, httplib::Response& res) {
-        res.set_content("ok", "text/plain");
-    });
-
-    server.Post("/heartbeat", [](const httplib::Request& req, httplib::Response& res) {
-        res.set_content("ok", "text/plain");
-    });
 
-    server.Get("/scan", [](const httplib::Request& req, httplib::Response& res) {
-        nlohmann::json j;
-        j["status"] = "ok";
-        res.set_content(j.dump(), "application/json");
-    });
-
-    server.Get("/stop_scan", [](const httplib::Request& req, httplib::Response& res) {
-        nlohmann::json j;
-        j["status"] = "ok";
-        res.set_content(j.dump(), "application/json");
-    });
-
-    server.Get("/make_visible", [](const httplib::Request& req, httplib::Response& res) {
-        nlohmann::json j;
-        j["status"] = "ok";
-        res.set_content(j.dump(), "application/json");
-    });
-
-    server.Post("/connect", [](const httplib::Request& req, httplib::Response& res) {
-        nlohmann::json j;
-        j["status"] = "ok";
-        res.set_content(j.dump(), "application/json");
-    });
-
-    server.Post("/disconnect", [](const httplib::Request& req, httplib::Response& res) {
-        nlohmann::json j;
-        j["status"] = "ok";
-        res.set_content(j.dump(), "application/json");
-    });
-
-    server.Post("/pair", [](const httplib::Request& req, httplib::Response& res) {
-        nlohmann::json j;
-        j["status"] = "ok";
-        res.set_content(j.dump(), "application/json");
-    });
-
-    server.Get("/devices", [](const httplib::Request& req, httplib::Response& res) {
-        nlohmann::json j;
-        j.push_back({{"name", "device1"}, {"mac", "00:00:00:00:00:00"}, {"paired", true}, {"rssi", "-50"}, {"alias", "device1"}, {"manufacturer", "manufacturer1"}, {"connected", true}, {"trusted", true}, {"blocked", false}});
-        j.push_back({{"name", "device2"}, {"mac", "00:00:00:00:00:01"}, {"paired", false}, {"rssi", "-60"}, {"alias", "device2"}, {"manufacturer", "manufacturer2"}, {"connected", false}, {"trusted", false}, {"blocked", false}});
-        j.push_back({{"name", "device3"}, {"mac", "00:00:00:00:00:02"}, {"paired", true}, {"rssi", "-70"}, {"alias", "device3"}, {"manufacturer", "manufacturer3"}, {"connected", false}, {"trusted", true}, {"blocked", false}});
-        res.set_content(j.dump(), "application/json");
-    });
-
-    server.Get("/paired_devices", [](const httplib::Request& req, httplib::Response& res) {
-        nlohmann::json j;
-        j.push_back({{"name", "device1"}, {"mac", "00:00:00:00:00:00"}, {"paired", true}, {"rssi", "-50"}, {"alias", "device1"}, {"manufacturer", "manufacturer1"}, {"connected", true}, {"trusted", true}, {"blocked", false}});
-        j.push_back({{"name", "device3"}, {"mac", "00:00:00:00:00:02"}, {"paired", true}, {"rssi", "-70"}, {"alias", "device3"}, {"manufacturer", "manufacturer3"}, {"connected", false}, {"trusted", true}, {"blocked", false}});
-        res.set_content(j.dump(), "application/json");
-    });
-
-    server.Get("/connected_devices", [](const httplib::Request& req, httplib::Response& res) {
-        nlohmann::json j;
-        j.push_back({{"name", "device1"}, {"mac", "00:00:00:00:00:00"}, {"paired", true}, {"rssi", "-50"}, {"alias", "device1"}, {"manufacturer", "manufacturer1"}, {"connected", true}, {"trusted", true}, {"blocked", false}});
-        res.set_content(j.dump(), "application/json");
-    });
-
-    server.Get("/available_devices", [](const httplib::Request& req, httplib::Response& res) {
-        nlohmann::json j;
-        j.push_back({{"name", "device1"}, {"mac", "00:00:00:00:00:00"}, {"paired", true}, {"rssi", "-50"}, {"alias", "device1"}, {"manufacturer", "manufacturer1"}, {"connected", true}, {"trusted", true}, {"blocked", false}});
-        res.set_content(j.dump(), "application/json");
-    });
+//////////////////////////////////////////////////////////////////////////////////
 
-    std::jthread t = std::jthread([&]{
-        server.listen("localhost", 55290);
-    });
-    while(!st.stop_requested()){
-        genericSleep(500);
-    }
-    server.stop();
+#ifndef PRODUCTION_BUILD
+std::unique_ptr<BtBridgeStandIn> startMock()
+{
+    auto mock = std::make_unique<BtBridgeStandIn>(BT_MANAGER_ADDRESS);
+    const auto ok = [](const nlohmann::json&) -> std::expected<nlohmann::json, std::string> {
+        return nlohmann::json { { "status", "ok" } };
+    };
+    for (const char* method : { "scan", "stop_scan", "set_visible", "connect", "disconnect", "pair" }) {
+        mock->handle(method, ok);
+    }
+
+    const nlohmann::json device1 = { { "name", "device1" }, { "mac", "00:00:00:00:00:00" }, { "paired", true }, { "rssi", "-50" }, { "alias", "device1" }, { "manufacturer", "manufacturer1" }, { "connected", true }, { "trusted", true }, { "blocked", false } };
+    const nlohmann::json device2 = { { "name", "device2" }, { "mac", "00:00:00:00:00:01" }, { "paired", false }, { "rssi", "-60" }, { "alias", "device2" }, { "manufacturer", "manufacturer2" }, { "connected", false }, { "trusted", false }, { "blocked", false } };
+    const nlohmann::json device3 = { { "name", "device3" }, { "mac", "00:00:00:00:00:02" }, { "paired", true }, { "rssi", "-70" }, { "alias", "device3" }, { "manufacturer", "manufacturer3" }, { "connected", false }, { "trusted", true }, { "blocked", false } };
+    const auto devices = [](nlohmann::json list) {
+        return [list](const nlohmann::json&) -> std::expected<nlohmann::json, std::string> { return list; };
+    };
+    mock->handle("devices", devices(nlohmann::json::array({ device1, device2, device3 })));
+    mock->handle("paired_devices", devices(nlohmann::json::array({ device1, device3 })));
+    mock->handle("connected_devices", devices(nlohmann::json::array({ device1 })));
+    mock->handle("available_devices", devices(nlohmann::json::array({ device1 })));
+
+    if (!mock->start()) {
+        return nullptr;
+    }
+    return mock;
 }
+#endif
+
 
 bool launchProcess(const std::string& execPath, const std::string& execArgs, std::string& result)
 {
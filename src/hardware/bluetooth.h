@@ -45,14 +45,11 @@ SOFTWARE.
 #endif
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <stdexcept>
 #include <string>
 #include <thread>
 #include <vector>
-#ifndef HTTPLIB_INCLUDED
-#define HTTPLIB_INCLUDED
-#include <httplib.h>
-#endif
 #include <cstdlib>
 #include <dirent.h>
 #include <iostream>
@@ -63,10 +60,11 @@ SOFTWARE.
 #ifdef PRODUCTION_BUILD
 #define BT_MANAGER_ADDRESS "/tmp/cube/bt_manager.sock"
 #else
-#define BT_MANAGER_ADDRESS "http://localhost:55290"
+#define BT_MANAGER_ADDRESS "/tmp/cube/bt_manager_mock.sock"
 #endif
 #define BT_MANAGER_EXECUTABLE "bt_manager"
 #include "../api/api.h"
+#include "btBridge.h"
 #include "nlohmann/json.hpp"
 #include "utils.h"
 #include "uuid.h"
@@ -96,23 +94,15 @@ class BTControl {
     std::vector<BTDevice> pairedDevices; // maintains a list of paired devices
     std::vector<BTDevice> connectedDevices; // maintains a list of connected devices
     std::vector<BTDevice> availableDevices; // maintains a list of available devices (paired and connected)
-    httplib::Server* server;
-    httplib::Client* client;
+    std::shared_ptr<BtBridgeClient> bridge;
     std::string client_id;
-    std::string address;
-    int port;
-    std::jthread* serverThread;
-    std::jthread* heartbeatThread;
     std::mutex m;
-    std::condition_variable cv;
-    uuids::uuid authUUID;
-#ifndef PRODUCTION_BUILD
-    std::jthread* mockThread;
-#endif
+
+    void handleNotification(const std::string& event, const nlohmann::json& payload);
+    std::vector<BTDevice> fetchDevices(const std::string& method);
 
 public:
-    BTControl(uuids::uuid authUUID);
-    ~BTControl();
+    explicit BTControl(std::shared_ptr<BtBridgeClient> bridge);
     bool scanForDevices();
     bool stopScanning();
     bool makeVisible(bool visible);
@@ -151,16 +141,20 @@ struct BTCharacteristic {
  *
  */
 class BTService {
-    httplib::Client* client;
-    httplib::Server* server;
+    // Written by the bridge thread whenever the helper (re)assigns the id, so it outlives the service.
+    struct ClientIdSlot {
+        std::mutex m;
+        std::string value = "none";
+    };
+    std::shared_ptr<BtBridgeClient> bridge;
     std::vector<BTCharacteristic*> characteristics;
     bool characteristicsLocked = false;
-    std::string client_id = "";
+    std::shared_ptr<ClientIdSlot> client_id;
+    std::optional<BtBridgeClient::RegistrationId> registration;
     nlohmann::json config;
-    uuids::uuid authUUID;
 
 public:
-    BTService(const nlohmann::json& config, httplib::Server* server, uuids::uuid authUUID);
+    BTService(const nlohmann::json& config, std::shared_ptr<BtBridgeClient> bridge);
     ~BTService();
     void addCharacteristic(const std::string& name, uuids::uuid uuid, std::function<void(std::string)> callback);
     void addCharacteristic(const std::string& name, uuids::uuid uuid, std::function<std::string()> callback);
@@ -169,8 +163,12 @@ public:
     void addCharacteristic(const std::string& name, uuids::uuid uuid, std::function<std::string(std::vector<std::string>)> callback);
     void addCharacteristic(const std::string& name, uuids::uuid uuid, std::function<std::vector<std::string>(std::string)> callback);
     void addCharacteristic(const std::string& name, uuids::uuid uuid, std::function<std::vector<std::string>(std::vector<std::string>)> callback);
+    // Registers the service with the helper. The client id is filled in when the helper answers and again after
+    // every reconnect; until then getClientId() returns "none".
     bool start();
     std::string getClientId();
+    // Called for "gatt_write" notifications addressed to this service's client id.
+    void handleGattWrite(const std::string& characteristic, const std::string& value);
 };
 
 /**
@@ -178,16 +176,20 @@ public:
  *
  */
 class BTManager : public AutoRegisterAPI<BTManager> {
-    httplib::Client* client;
-    httplib::Server* server;
-    std::jthread* serverThread;
-    std::jthread* heartbeatThread;
-    BTControl* control;
+#ifndef PRODUCTION_BUILD
+    std::unique_ptr<BtBridgeStandIn> mock;
+#endif
+    // One connection to the helper carries requests and notifications for every BT object.
+    std::shared_ptr<BtBridgeClient> bridge;
+    std::unique_ptr<BTControl> control;
+    std::mutex m;
     std::vector<BTService*> services;
     std::string client_id;
     nlohmann::json config;
     uuids::uuid authUUID;
 
+    std::string getClientId();
+
 public:
     BTManager();
     ~BTManager();
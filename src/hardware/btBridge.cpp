@@ -0,0 +1,645 @@
+/*
+██████╗ ████████╗██████╗ ██████╗ ██╗██████╗  ██████╗ ███████╗    ██████╗██████╗ ██████╗
+██╔══██╗╚══██╔══╝██╔══██╗██╔══██╗██║██╔══██╗██╔════╝ ██╔════╝   ██╔════╝██╔══██╗██╔══██╗
+██████╔╝   ██║   ██████╔╝██████╔╝██║██║  ██║██║  ███╗█████╗     ██║     ██████╔╝██████╔╝
+██╔══██╗   ██║   ██╔══██╗██╔══██╗██║██║  ██║██║   ██║██╔══╝     ██║     ██╔═══╝ ██╔═══╝
+██████╔╝   ██║   ██████╔╝██║  ██║██║██████╔╝╚██████╔╝███████╗██╗╚██████╗██║     ██║
+╚═════╝    ╚═╝   ╚═════╝ ╚═╝  ╚═╝╚═╝╚═════╝  ╚═════╝ ╚══════╝╚═╝ ╚═════╝╚═╝     ╚═╝
+*/
+
+/*
+MIT License
+
+Copyright (c) 2026 A-McD Technology LLC
+*/
+
+
+#include "btBridge.h"
+
+#include <logger.h>
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+#include <filesystem>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace {
+
+std::optional<sockaddr_un> unixSocketAddress(const std::string& path)
+{
+    sockaddr_un address {};
+    if (path.empty() || path.size() >= sizeof(address.sun_path)) {
+        return std::nullopt;
+    }
+    address.sun_family = AF_UNIX;
+    std::memcpy(address.sun_path, path.c_str(), path.size() + 1);
+    return address;
+}
+
+int connectUnixSocket(const std::string& path)
+{
+    const auto address = unixSocketAddress(path);
+    if (!address) {
+        return -1;
+    }
+    const int fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (fd < 0) {
+        return -1;
+    }
+    if (::connect(fd, reinterpret_cast<const sockaddr*>(&*address), sizeof(*address)) != 0) {
+        ::close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+bool sendAll(int fd, const std::string& bytes)
+{
+    size_t sent = 0;
+    while (sent < bytes.size()) {
+        const ssize_t written = ::send(fd, bytes.data() + sent, bytes.size() - sent, MSG_NOSIGNAL);
+        if (written < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return false;
+        }
+        sent += static_cast<size_t>(written);
+    }
+    return true;
+}
+
+void signalEventFd(int fd)
+{
+    if (fd >= 0) {
+        const uint64_t one = 1;
+        [[maybe_unused]] const auto written = ::write(fd, &one, sizeof(one));
+    }
+}
+
+void drainEventFd(int fd)
+{
+    uint64_t value = 0;
+    [[maybe_unused]] const auto bytesRead = ::read(fd, &value, sizeof(value));
+}
+
+nlohmann::json responseFrame(uint64_t id, const std::expected<nlohmann::json, std::string>& result)
+{
+    if (result) {
+        return { { "type", "response" }, { "id", id }, { "ok", true }, { "result", *result } };
+    }
+    return { { "type", "response" }, { "id", id }, { "ok", false }, { "error", result.error() } };
+}
+
+} // namespace
+
+std::string BtBridgeFrame::encode(const nlohmann::json& frame)
+{
+    const std::string payload = frame.dump();
+    const auto size = static_cast<uint32_t>(payload.size());
+    std::string bytes;
+    bytes.reserve(kHeaderBytes + payload.size());
+    bytes.push_back(static_cast<char>((size >> 24) & 0xFF));
+    bytes.push_back(static_cast<char>((size >> 16) & 0xFF));
+    bytes.push_back(static_cast<char>((size >> 8) & 0xFF));
+    bytes.push_back(static_cast<char>(size & 0xFF));
+    bytes += payload;
+    return bytes;
+}
+
+void BtBridgeFrameReader::append(const char* data, size_t size)
+{
+    // Compact once the consumed prefix dominates so the buffer doesn't grow with connection lifetime.
+    if (offset_ > 0 && offset_ >= buffer_.size() / 2) {
+        buffer_.erase(0, offset_);
+        offset_ = 0;
+    }
+    buffer_.append(data, size);
+}
+
+BtBridgeFrameReader::Status BtBridgeFrameReader::next(nlohmann::json& frame)
+{
+    const size_t available = buffer_.size() - offset_;
+    if (available < BtBridgeFrame::kHeaderBytes) {
+        return Status::NeedMore;
+    }
+    const auto* header = reinterpret_cast<const unsigned char*>(buffer_.data() + offset_);
+    const size_t length = (size_t { header[0] } << 24) | (size_t { header[1] } << 16) | (size_t { header[2] } << 8) | size_t { header[3] };
+    if (length > BtBridgeFrame::kMaxPayloadBytes) {
+        return Status::Invalid;
+    }
+    if (available < BtBridgeFrame::kHeaderBytes + length) {
+        return Status::NeedMore;
+    }
+    const char* payload = buffer_.data() + offset_ + BtBridgeFrame::kHeaderBytes;
+    offset_ += BtBridgeFrame::kHeaderBytes + length;
+    frame = nlohmann::json::parse(payload, payload + length, nullptr, false);
+    if (frame.is_discarded() || !frame.is_object()) {
+        return Status::Invalid;
+    }
+    return Status::Frame;
+}
+
+void BtBridgeFrameReader::clear()
+{
+    buffer_.clear();
+    offset_ = 0;
+}
+
+const char* btBridgeErrorToString(BtBridgeError error)
+{
+    switch (error) {
+    case BtBridgeError::NOT_CONNECTED:
+        return "not connected";
+    case BtBridgeError::TIMEOUT:
+        return "timed out";
+    case BtBridgeError::REMOTE_ERROR:
+        return "helper returned an error";
+    case BtBridgeError::CLOSED:
+        return "connection closed";
+    }
+    return "unknown";
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+BtBridgeClient::BtBridgeClient(BtBridgeOptions options)
+    : options_(std::move(options))
+    , wakeFd_(::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK))
+{
+}
+
+BtBridgeClient::~BtBridgeClient()
+{
+    stop();
+    if (wakeFd_ >= 0) {
+        ::close(wakeFd_);
+    }
+}
+
+void BtBridgeClient::start()
+{
+    if (thread_.joinable()) {
+        return;
+    }
+    thread_ = std::jthread([this](std::stop_token stopToken) { run(stopToken); });
+}
+
+void BtBridgeClient::stop()
+{
+    if (!thread_.joinable()) {
+        return;
+    }
+    thread_.request_stop();
+    signalEventFd(wakeFd_);
+    thread_.join();
+}
+
+std::expected<nlohmann::json, BtBridgeError> BtBridgeClient::call(
+    const std::string& method,
+    const nlohmann::json& params,
+    std::optional<std::chrono::milliseconds> timeout)
+{
+    auto pending = std::make_shared<PendingCall>();
+    uint64_t id = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (!connected_) {
+            return std::unexpected(BtBridgeError::NOT_CONNECTED);
+        }
+        id = nextId_++;
+        pending_.emplace(id, pending);
+    }
+
+    if (!send({ { "type", "request" }, { "id", id }, { "method", method }, { "params", params } })) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        pending_.erase(id);
+        return std::unexpected(BtBridgeError::NOT_CONNECTED);
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    responseCv_.wait_for(lock, timeout.value_or(options_.requestTimeout), [&pending]() { return pending->done; });
+    pending_.erase(id);
+    if (!pending->done) {
+        CubeLog::warning("BtBridge: " + method + " timed out");
+        return std::unexpected(BtBridgeError::TIMEOUT);
+    }
+    if (pending->closed) {
+        return std::unexpected(BtBridgeError::CLOSED);
+    }
+    if (!pending->ok) {
+        CubeLog::error("BtBridge: " + method + " failed: " + pending->error);
+        return std::unexpected(BtBridgeError::REMOTE_ERROR);
+    }
+    return std::move(pending->result);
+}
+
+BtBridgeClient::RegistrationId BtBridgeClient::registerClient(nlohmann::json config, ClientIdHandler onClientId)
+{
+    nlohmann::json frame;
+    RegistrationId registration = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        registration = nextRegistrationId_++;
+        registrations_.emplace(registration, Registration { config, std::move(onClientId) });
+        if (!connected_) {
+            return registration;
+        }
+        const uint64_t id = nextId_++;
+        registrationRequests_.emplace(id, registration);
+        frame = { { "type", "request" }, { "id", id }, { "method", "setup" }, { "params", std::move(config) } };
+    }
+    send(frame);
+    return registration;
+}
+
+void BtBridgeClient::unregisterClient(RegistrationId registration)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    registrations_.erase(registration);
+    std::erase_if(registrationRequests_, [registration](const auto& request) { return request.second == registration; });
+}
+
+void BtBridgeClient::addNotificationHandler(NotificationHandler handler)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    notificationHandlers_.push_back(std::move(handler));
+}
+
+bool BtBridgeClient::isConnected() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return connected_;
+}
+
+uint64_t BtBridgeClient::connectCount() const
+{
+    return connectCount_.load();
+}
+
+bool BtBridgeClient::send(const nlohmann::json& frame)
+{
+    const std::string bytes = BtBridgeFrame::encode(frame);
+    std::lock_guard<std::mutex> lock(writeMutex_);
+    if (fd_ < 0) {
+        return false;
+    }
+    if (!sendAll(fd_, bytes)) {
+        // Let the reader notice and reconnect.
+        ::shutdown(fd_, SHUT_RDWR);
+        return false;
+    }
+    return true;
+}
+
+void BtBridgeClient::run(std::stop_token stopToken)
+{
+    bool loggedUnavailable = false;
+    while (!stopToken.stop_requested()) {
+        const int fd = connectUnixSocket(options_.socketPath);
+        if (fd < 0) {
+            if (!loggedUnavailable) {
+                CubeLog::warning("BtBridge: helper not reachable at " + options_.socketPath + ", retrying.");
+                loggedUnavailable = true;
+            }
+            std::unique_lock<std::mutex> lock(mutex_);
+            reconnectCv_.wait_for(lock, stopToken, options_.reconnectDelay, []() { return false; });
+            continue;
+        }
+        loggedUnavailable = false;
+        {
+            std::lock_guard<std::mutex> lock(writeMutex_);
+            fd_ = fd;
+        }
+
+        std::vector<nlohmann::json> setups;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            for (const auto& [registration, entry] : registrations_) {
+                const uint64_t id = nextId_++;
+                registrationRequests_.emplace(id, registration);
+                setups.push_back({ { "type", "request" }, { "id", id }, { "method", "setup" }, { "params", entry.config } });
+            }
+        }
+        bool ready = send({ { "type", "hello" }, { "auth", options_.authToken } });
+        for (const auto& setup : setups) {
+            ready = ready && send(setup);
+        }
+        if (ready) {
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                connected_ = true;
+            }
+            connectCount_++;
+            CubeLog::info("BtBridge: connected to " + options_.socketPath);
+            readLoop(fd, stopToken);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(writeMutex_);
+            fd_ = -1;
+        }
+        ::close(fd);
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            connected_ = false;
+            registrationRequests_.clear();
+            for (auto& [id, pending] : pending_) {
+                pending->done = true;
+                pending->closed = true;
+            }
+        }
+        responseCv_.notify_all();
+        if (!stopToken.stop_requested()) {
+            CubeLog::warning("BtBridge: connection to " + options_.socketPath + " lost, reconnecting.");
+        }
+    }
+}
+
+void BtBridgeClient::readLoop(int fd, std::stop_token stopToken)
+{
+    using Clock = std::chrono::steady_clock;
+    BtBridgeFrameReader reader;
+    auto lastReceived = Clock::now();
+    std::optional<Clock::time_point> pingSentAt;
+    std::array<char, 16384> buffer;
+
+    while (!stopToken.stop_requested()) {
+        const auto now = Clock::now();
+        if (pingSentAt && now - *pingSentAt >= options_.keepaliveInterval) {
+            CubeLog::warning("BtBridge: keepalive unanswered, dropping connection.");
+            return;
+        }
+        if (!pingSentAt && now - lastReceived >= options_.keepaliveInterval) {
+            if (!send({ { "type", "ping" } })) {
+                return;
+            }
+            pingSentAt = now;
+        }
+        const auto nextCheck = (pingSentAt ? *pingSentAt : lastReceived) + options_.keepaliveInterval;
+        const auto waitMs = std::max<int64_t>(0, std::chrono::ceil<std::chrono::milliseconds>(nextCheck - Clock::now()).count());
+
+        pollfd fds[2] = { { fd, POLLIN, 0 }, { wakeFd_, POLLIN, 0 } };
+        const int ready = ::poll(fds, 2, static_cast<int>(std::min<int64_t>(waitMs, 60000)));
+        if (ready < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return;
+        }
+        if (fds[1].revents & POLLIN) {
+            drainEventFd(wakeFd_);
+            continue;
+        }
+        if (fds[0].revents == 0) {
+            continue;
+        }
+        const ssize_t received = ::recv(fd, buffer.data(), buffer.size(), 0);
+        if (received < 0 && (errno == EINTR || errno == EAGAIN)) {
+            continue;
+        }
+        if (received <= 0) {
+            return;
+        }
+        lastReceived = Clock::now();
+        pingSentAt.reset();
+        reader.append(buffer.data(), static_cast<size_t>(received));
+        nlohmann::json frame;
+        BtBridgeFrameReader::Status status;
+        while ((status = reader.next(frame)) == BtBridgeFrameReader::Status::Frame) {
+            dispatch(frame);
+        }
+        if (status == BtBridgeFrameReader::Status::Invalid) {
+            CubeLog::error("BtBridge: malformed frame from helper, dropping connection.");
+            return;
+        }
+    }
+}
+
+void BtBridgeClient::dispatch(const nlohmann::json& frame)
+{
+    const std::string type = frame.value("type", "");
+    if (type == "response") {
+        const uint64_t id = frame.value("id", uint64_t { 0 });
+        const bool ok = frame.value("ok", false);
+        ClientIdHandler onClientId;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (const auto request = registrationRequests_.find(id); request != registrationRequests_.end()) {
+                if (const auto registration = registrations_.find(request->second); registration != registrations_.end()) {
+                    onClientId = registration->second.onClientId;
+                }
+                registrationRequests_.erase(request);
+            } else if (const auto pending = pending_.find(id); pending != pending_.end()) {
+                pending->second->done = true;
+                pending->second->ok = ok;
+                if (ok) {
+                    pending->second->result = frame.contains("result") ? frame["result"] : nlohmann::json();
+                } else {
+                    pending->second->error = frame.value("error", "");
+                }
+            }
+        }
+        if (onClientId) {
+            const auto result = frame.contains("result") ? frame["result"] : nlohmann::json();
+            if (ok && result.is_object() && result.contains("client_id") && result["client_id"].is_string()) {
+                onClientId(result["client_id"].get<std::string>());
+            } else {
+                CubeLog::error("BtBridge: setup rejected: " + frame.value("error", std::string("missing client_id")));
+            }
+            return;
+        }
+        responseCv_.notify_all();
+        return;
+    }
+    if (type == "notify") {
+        std::vector<NotificationHandler> handlers;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            handlers = notificationHandlers_;
+        }
+        const std::string event = frame.value("event", "");
+        const auto payload = frame.contains("payload") ? frame["payload"] : nlohmann::json::object();
+        for (const auto& handler : handlers) {
+            handler(event, payload);
+        }
+        return;
+    }
+    if (type == "ping") {
+        send({ { "type", "pong" } });
+    }
+}
+
+////////////////////////////////////////////////////////////////////////////////////////////////////
+
+BtBridgeStandIn::BtBridgeStandIn(std::string socketPath)
+    : socketPath_(std::move(socketPath))
+    , wakeFd_(::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK))
+{
+}
+
+BtBridgeStandIn::~BtBridgeStandIn()
+{
+    stop();
+    if (wakeFd_ >= 0) {
+        ::close(wakeFd_);
+    }
+}
+
+void BtBridgeStandIn::handle(const std::string& method, Method handler)
+{
+    methods_[method] = std::move(handler);
+}
+
+bool BtBridgeStandIn::start()
+{
+    if (thread_.joinable()) {
+        return true;
+    }
+    const auto address = unixSocketAddress(socketPath_);
+    if (!address) {
+        CubeLog::error("BtBridgeStandIn: invalid socket path: " + socketPath_);
+        return false;
+    }
+    std::error_code error;
+    std::filesystem::create_directories(std::filesystem::path(socketPath_).parent_path(), error);
+    ::unlink(socketPath_.c_str());
+    listenFd_ = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listenFd_ < 0
+        || ::bind(listenFd_, reinterpret_cast<const sockaddr*>(&*address), sizeof(*address)) != 0
+        || ::listen(listenFd_, 8) != 0) {
+        CubeLog::error("BtBridgeStandIn: could not listen on " + socketPath_ + ": " + std::strerror(errno));
+        if (listenFd_ >= 0) {
+            ::close(listenFd_);
+            listenFd_ = -1;
+        }
+        return false;
+    }
+    thread_ = std::jthread([this](std::stop_token stopToken) { run(stopToken); });
+    return true;
+}
+
+void BtBridgeStandIn::stop()
+{
+    if (thread_.joinable()) {
+        thread_.request_stop();
+        signalEventFd(wakeFd_);
+        thread_.join();
+    }
+    // Stop listening first so clients that see their connection drop can't reconnect into the backlog.
+    if (listenFd_ >= 0) {
+        ::close(listenFd_);
+        listenFd_ = -1;
+        ::unlink(socketPath_.c_str());
+    }
+    std::lock_guard<std::mutex> lock(clientsMutex_);
+    for (const int fd : clients_) {
+        ::close(fd);
+    }
+    clients_.clear();
+}
+
+void BtBridgeStandIn::notify(const std::string& event, const nlohmann::json& payload)
+{
+    const std::string bytes = BtBridgeFrame::encode({ { "type", "notify" }, { "event", event }, { "payload", payload } });
+    std::lock_guard<std::mutex> lock(clientsMutex_);
+    for (const int fd : clients_) {
+        sendAll(fd, bytes);
+    }
+}
+
+size_t BtBridgeStandIn::clientCount() const
+{
+    std::lock_guard<std::mutex> lock(clientsMutex_);
+    return clients_.size();
+}
+
+uint64_t BtBridgeStandIn::pingsReceived() const
+{
+    return pingsReceived_.load();
+}
+
+void BtBridgeStandIn::reply(int fd, const nlohmann::json& frame)
+{
+    const std::string bytes = BtBridgeFrame::encode(frame);
+    std::lock_guard<std::mutex> lock(clientsMutex_);
+    sendAll(fd, bytes);
+}
+
+void BtBridgeStandIn::run(std::stop_token stopToken)
+{
+    std::map<int, BtBridgeFrameReader> readers;
+    std::array<char, 16384> buffer;
+    std::vector<pollfd> fds;
+
+    while (!stopToken.stop_requested()) {
+        fds.clear();
+        fds.push_back({ wakeFd_, POLLIN, 0 });
+        fds.push_back({ listenFd_, POLLIN, 0 });
+        for (const auto& [fd, reader] : readers) {
+            fds.push_back({ fd, POLLIN, 0 });
+        }
+        if (::poll(fds.data(), fds.size(), -1) < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            break;
+        }
+        if (fds[0].revents & POLLIN) {
+            drainEventFd(wakeFd_);
+            continue;
+        }
+        if (fds[1].revents & POLLIN) {
+            const int client = ::accept4(listenFd_, nullptr, nullptr, SOCK_CLOEXEC);
+            if (client >= 0) {
+                readers.emplace(client, BtBridgeFrameReader {});
+                std::lock_guard<std::mutex> lock(clientsMutex_);
+                clients_.push_back(client);
+            }
+        }
+        for (size_t index = 2; index < fds.size(); index++) {
+            if (fds[index].revents == 0) {
+                continue;
+            }
+            const int fd = fds[index].fd;
+            const ssize_t received = ::recv(fd, buffer.data(), buffer.size(), 0);
+            bool drop = received <= 0 && !(received < 0 && (errno == EINTR || errno == EAGAIN));
+            if (received > 0) {
+                auto& reader = readers[fd];
+                reader.append(buffer.data(), static_cast<size_t>(received));
+                nlohmann::json frame;
+                BtBridgeFrameReader::Status status;
+                while ((status = reader.next(frame)) == BtBridgeFrameReader::Status::Frame) {
+                    const std::string type = frame.value("type", "");
+                    if (type == "ping") {
+                        pingsReceived_++;
+                        reply(fd, { { "type", "pong" } });
+                    } else if (type == "request") {
+                        const uint64_t id = frame.value("id", uint64_t { 0 });
+                        const std::string method = frame.value("method", "");
+                        const auto params = frame.contains("params") ? frame["params"] : nlohmann::json::object();
+                        if (const auto handler = methods_.find(method); handler != methods_.end()) {
+                            reply(fd, responseFrame(id, handler->second(params)));
+                        } else if (method == "setup") {
+                            reply(fd, responseFrame(id, nlohmann::json { { "client_id", "standin-" + std::to_string(nextClientId_++) } }));
+                        } else {
+                            reply(fd, responseFrame(id, std::unexpected("unknown method: " + method)));
+                        }
+                    }
+                }
+                drop = status == BtBridgeFrameReader::Status::Invalid;
+            }
+            if (drop) {
+                readers.erase(fd);
+                std::lock_guard<std::mutex> lock(clientsMutex_);
+                std::erase(clients_, fd);
+                ::close(fd);
+            }
+        }
+    }
+}
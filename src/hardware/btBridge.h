@@ -0,0 +1,212 @@
+/*
+██████╗ ████████╗██████╗ ██████╗ ██╗██████╗  ██████╗ ███████╗   ██╗  ██╗
+██╔══██╗╚══██╔══╝██╔══██╗██╔══██╗██║██╔══██╗██╔════╝ ██╔════╝   ██║  ██║
+██████╔╝   ██║   ██████╔╝██████╔╝██║██║  ██║██║  ███╗█████╗     ███████║
+██╔══██╗   ██║   ██╔══██╗██╔══██╗██║██║  ██║██║   ██║██╔══╝     ██╔══██║
+██████╔╝   ██║   ██████╔╝██║  ██║██║██████╔╝╚██████╔╝███████╗██╗██║  ██║
+╚═════╝    ╚═╝   ╚═════╝ ╚═╝  ╚═╝╚═╝╚═════╝  ╚═════╝ ╚══════╝╚═╝╚═╝  ╚═╝
+*/
+
+/*
+MIT License
+
+Copyright (c) 2026 A-McD Technology LLC
+*/
+
+
+#pragma once
+#ifndef BTBRIDGE_H
+#define BTBRIDGE_H
+
+#include "nlohmann/json.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <expected>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+/*
+
+Transport between CORE and the Bluetooth helper process (bt_manager).
+
+Everything travels over one long-lived unix-domain stream socket. Each frame is a 4-byte big-endian payload
+length followed by a JSON object whose "type" is one of:
+
+    hello     client -> helper, first frame on every connection: { "auth": <token> }
+    request   { "id": N, "method": "...", "params": {...} }
+    response  { "id": N, "ok": true, "result": ... } or { "id": N, "ok": false, "error": "..." }
+    notify    helper -> client, unsolicited: { "event": "...", "payload": {...} }
+    ping/pong keepalive, either direction
+
+Requests are matched to responses by id, so any number of callers can have requests in flight on the same
+connection. Pairing, device and GATT events arrive as notify frames instead of the helper calling back into
+an HTTP server of ours. A connection that has been quiet for a keepalive interval gets a ping, and if nothing
+comes back within another interval the client reconnects; that replaces the per-object heartbeat threads.
+Client registrations ("setup") are replayed after every reconnect so a restarted helper relearns its clients.
+
+BtBridgeStandIn is a minimal helper-side implementation of the same protocol, used by dev builds in place of
+bt_manager and by tests and benchmarks.
+
+*/
+
+namespace BtBridgeFrame {
+
+constexpr size_t kHeaderBytes = 4;
+constexpr size_t kMaxPayloadBytes = 1024 * 1024;
+
+std::string encode(const nlohmann::json& frame);
+
+} // namespace BtBridgeFrame
+
+// Reassembles frames from whatever chunks recv() hands back.
+class BtBridgeFrameReader {
+public:
+    enum class Status {
+        Frame,
+        NeedMore,
+        Invalid
+    };
+
+    void append(const char* data, size_t size);
+    Status next(nlohmann::json& frame);
+    void clear();
+
+private:
+    std::string buffer_;
+    size_t offset_ = 0;
+};
+
+enum class BtBridgeError {
+    NOT_CONNECTED,
+    TIMEOUT,
+    REMOTE_ERROR,
+    CLOSED
+};
+
+const char* btBridgeErrorToString(BtBridgeError error);
+
+struct BtBridgeOptions {
+    std::string socketPath;
+    // Sent in the hello frame; stands in for the bearer token the HTTP bridge used.
+    std::string authToken;
+    std::chrono::milliseconds requestTimeout { 5000 };
+    std::chrono::milliseconds keepaliveInterval { 10000 };
+    std::chrono::milliseconds reconnectDelay { 1000 };
+};
+
+class BtBridgeClient {
+public:
+    // Runs on the bridge thread; keep it short and don't call() from it.
+    using NotificationHandler = std::function<void(const std::string& event, const nlohmann::json& payload)>;
+    using ClientIdHandler = std::function<void(const std::string& clientId)>;
+    using RegistrationId = uint64_t;
+
+    explicit BtBridgeClient(BtBridgeOptions options);
+    ~BtBridgeClient();
+
+    BtBridgeClient(const BtBridgeClient&) = delete;
+    BtBridgeClient& operator=(const BtBridgeClient&) = delete;
+
+    void start();
+    void stop();
+
+    std::expected<nlohmann::json, BtBridgeError> call(
+        const std::string& method,
+        const nlohmann::json& params = nlohmann::json::object(),
+        std::optional<std::chrono::milliseconds> timeout = std::nullopt);
+
+    // Sends "setup" with `config` now if connected and again after every reconnect, until unregistered.
+    RegistrationId registerClient(nlohmann::json config, ClientIdHandler onClientId);
+    // Stops replaying the setup. A client id already being delivered may still reach the handler.
+    void unregisterClient(RegistrationId registration);
+    void addNotificationHandler(NotificationHandler handler);
+
+    bool isConnected() const;
+    uint64_t connectCount() const;
+
+private:
+    struct PendingCall {
+        bool done = false;
+        bool ok = false;
+        bool closed = false;
+        nlohmann::json result;
+        std::string error;
+    };
+
+    struct Registration {
+        nlohmann::json config;
+        ClientIdHandler onClientId;
+    };
+
+    void run(std::stop_token stopToken);
+    void readLoop(int fd, std::stop_token stopToken);
+    void dispatch(const nlohmann::json& frame);
+    bool send(const nlohmann::json& frame);
+
+    const BtBridgeOptions options_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable responseCv_;
+    std::condition_variable_any reconnectCv_;
+    std::map<uint64_t, std::shared_ptr<PendingCall>> pending_;
+    std::map<RegistrationId, Registration> registrations_;
+    std::map<uint64_t, RegistrationId> registrationRequests_;
+    RegistrationId nextRegistrationId_ = 1;
+    std::vector<NotificationHandler> notificationHandlers_;
+    uint64_t nextId_ = 1;
+    bool connected_ = false;
+    std::atomic<uint64_t> connectCount_ { 0 };
+
+    // Held for every write so frames from different callers never interleave.
+    std::mutex writeMutex_;
+    int fd_ = -1;
+    int wakeFd_ = -1;
+    std::jthread thread_;
+};
+
+class BtBridgeStandIn {
+public:
+    using Method = std::function<std::expected<nlohmann::json, std::string>(const nlohmann::json& params)>;
+
+    explicit BtBridgeStandIn(std::string socketPath);
+    ~BtBridgeStandIn();
+
+    BtBridgeStandIn(const BtBridgeStandIn&) = delete;
+    BtBridgeStandIn& operator=(const BtBridgeStandIn&) = delete;
+
+    // Register methods before start(). "setup" answers with a fresh client_id unless overridden.
+    void handle(const std::string& method, Method handler);
+    bool start();
+    void stop();
+
+    // Pushes a notify frame to every connected client.
+    void notify(const std::string& event, const nlohmann::json& payload);
+
+    size_t clientCount() const;
+    uint64_t pingsReceived() const;
+
+private:
+    void run(std::stop_token stopToken);
+    void reply(int fd, const nlohmann::json& frame);
+
+    const std::string socketPath_;
+    std::map<std::string, Method> methods_;
+    int listenFd_ = -1;
+    int wakeFd_ = -1;
+    mutable std::mutex clientsMutex_;
+    std::vector<int> clients_;
+    std::atomic<uint64_t> pingsReceived_ { 0 };
+    uint64_t nextClientId_ = 1;
+    std::jthread thread_;
+};
+
+#endif // BTBRIDGE_H
@@ -0,0 +1,178 @@
+/*
+ ██████╗ ██████╗ ██╗ ██████╗ ██╗███╗   ██╗████████╗███████╗██████╗ ██████╗ ██╗   ██╗██████╗ ████████╗██╗     ██╗███╗   ██╗███████╗    ██████╗██████╗ ██████╗
+██╔════╝ ██╔══██╗██║██╔═══██╗██║████╗  ██║╚══██╔══╝██╔════╝██╔══██╗██╔══██╗██║   ██║██╔══██╗╚══██╔══╝██║     ██║████╗  ██║██╔════╝   ██╔════╝██╔══██╗██╔══██╗
+██║  ███╗██████╔╝██║██║   ██║██║██╔██╗ ██║   ██║   █████╗  ██████╔╝██████╔╝██║   ██║██████╔╝   ██║   ██║     ██║██╔██╗ ██║█████╗     ██║     ██████╔╝██████╔╝
+██║   ██║██╔═══╝ ██║██║   ██║██║██║╚██╗██║   ██║   ██╔══╝  ██╔══██╗██╔══██╗██║   ██║██╔═══╝    ██║   ██║     ██║██║╚██╗██║██╔══╝     ██║     ██╔═══╝ ██╔═══╝
+╚██████╔╝██║     ██║╚██████╔╝██║██║ ╚████║   ██║   ███████╗██║  ██║██║  ██║╚██████╔╝██║        ██║   ███████╗██║██║ ╚████║███████╗██╗╚██████╗██║     ██║
+ ╚═════╝ ╚═╝     ╚═╝ ╚═════╝ ╚═╝╚═╝  ╚═══╝   ╚═╝   ╚══════╝╚═╝  ╚═╝╚═╝  ╚═╝ ╚═════╝ ╚═╝        ╚═╝   ╚══════╝╚═╝╚═╝  ╚═══╝╚══════╝╚═╝ ╚═════╝╚═╝     ╚═╝
+*/
+
+/*
+MIT License
+
+Copyright (c) 2026 A-McD Technology LLC
+*/
+
+
+#include "gpioInterruptLine.h"
+
+#ifndef LOGGER_H
+#include <logger.h>
+#endif
+
+#include <array>
+#include <cerrno>
+#include <cstring>
+
+#include <fcntl.h>
+#include <linux/gpio.h>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr char kGpioConsumerLabel[] = "cube-core";
+constexpr size_t kEdgeEventDrainBatch = 16;
+
+uint64_t edgeFlags(LinuxGpioInterruptLine::Edge edge)
+{
+    switch (edge) {
+    case LinuxGpioInterruptLine::Edge::Falling:
+        return GPIO_V2_LINE_FLAG_EDGE_FALLING;
+    case LinuxGpioInterruptLine::Edge::Both:
+        return GPIO_V2_LINE_FLAG_EDGE_RISING | GPIO_V2_LINE_FLAG_EDGE_FALLING;
+    case LinuxGpioInterruptLine::Edge::Rising:
+    default:
+        return GPIO_V2_LINE_FLAG_EDGE_RISING;
+    }
+}
+
+} // namespace
+
+LinuxGpioInterruptLine::LinuxGpioInterruptLine(std::string chipPath, unsigned int lineOffset, Edge edge)
+    : chipPath_(std::move(chipPath))
+    , lineOffset_(lineOffset)
+    , edge_(edge)
+{
+}
+
+LinuxGpioInterruptLine::~LinuxGpioInterruptLine()
+{
+    close();
+}
+
+std::expected<void, GpioError> LinuxGpioInterruptLine::open()
+{
+    std::lock_guard<std::mutex> lock(fdMutex_);
+    if (lineFd_ >= 0) {
+        return { };
+    }
+
+    const int chipFd = ::open(chipPath_.c_str(), O_RDONLY | O_CLOEXEC);
+    if (chipFd < 0) {
+        CubeLog::error("LinuxGpioInterruptLine: failed to open " + chipPath_ + ": " + std::strerror(errno));
+        return std::unexpected(GpioError::OpenFailed);
+    }
+
+    gpio_v2_line_request request {};
+    request.offsets[0] = lineOffset_;
+    request.num_lines = 1;
+    request.config.flags = GPIO_V2_LINE_FLAG_INPUT | edgeFlags(edge_);
+    std::strncpy(request.consumer, kGpioConsumerLabel, sizeof(request.consumer) - 1);
+
+    const int requestResult = ::ioctl(chipFd, GPIO_V2_GET_LINE_IOCTL, &request);
+    const int requestErrno = errno;
+    ::close(chipFd);
+    if (requestResult < 0) {
+        CubeLog::error("LinuxGpioInterruptLine: failed to request line " + std::to_string(lineOffset_)
+            + " on " + chipPath_ + ": " + std::strerror(requestErrno));
+        return std::unexpected(GpioError::RequestFailed);
+    }
+
+    const int cancelFd = ::eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (cancelFd < 0) {
+        CubeLog::error(std::string("LinuxGpioInterruptLine: failed to create eventfd: ") + std::strerror(errno));
+        ::close(request.fd);
+        return std::unexpected(GpioError::OpenFailed);
+    }
+
+    lineFd_ = request.fd;
+    cancelFd_ = cancelFd;
+    CubeLog::info("LinuxGpioInterruptLine: waiting for edges on " + chipPath_ + " line " + std::to_string(lineOffset_) + ".");
+    return { };
+}
+
+bool LinuxGpioInterruptLine::isOpen() const
+{
+    std::lock_guard<std::mutex> lock(fdMutex_);
+    return lineFd_ >= 0;
+}
+
+std::expected<bool, GpioError> LinuxGpioInterruptLine::wait(std::chrono::milliseconds timeout)
+{
+    int lineFd = -1;
+    int cancelFd = -1;
+    {
+        std::lock_guard<std::mutex> lock(fdMutex_);
+        lineFd = lineFd_;
+        cancelFd = cancelFd_;
+    }
+    if (lineFd < 0) {
+        return std::unexpected(GpioError::NotOpen);
+    }
+
+    std::array<pollfd, 2> fds { {
+        { lineFd, POLLIN, 0 },
+        { cancelFd, POLLIN, 0 },
+    } };
+    int result = 0;
+    do {
+        result = ::poll(fds.data(), fds.size(), static_cast<int>(timeout.count()));
+    } while (result < 0 && errno == EINTR);
+    if (result < 0) {
+        CubeLog::error(std::string("LinuxGpioInterruptLine: poll failed: ") + std::strerror(errno));
+        return std::unexpected(GpioError::WaitFailed);
+    }
+
+    if (fds[1].revents & POLLIN) {
+        uint64_t ignored = 0;
+        (void)::read(cancelFd, &ignored, sizeof(ignored));
+    }
+    if (!(fds[0].revents & POLLIN)) {
+        return false;
+    }
+
+    // Drain every queued edge so a burst of interrupts wakes the caller once.
+    std::array<gpio_v2_line_event, kEdgeEventDrainBatch> events {};
+    const ssize_t drained = ::read(lineFd, events.data(), sizeof(events));
+    if (drained < 0 && errno != EAGAIN) {
+        CubeLog::error(std::string("LinuxGpioInterruptLine: failed to read edge events: ") + std::strerror(errno));
+        return std::unexpected(GpioError::WaitFailed);
+    }
+    return true;
+}
+
+void LinuxGpioInterruptLine::cancelWait()
+{
+    std::lock_guard<std::mutex> lock(fdMutex_);
+    if (cancelFd_ < 0) {
+        return;
+    }
+    const uint64_t one = 1;
+    (void)::write(cancelFd_, &one, sizeof(one));
+}
+
+void LinuxGpioInterruptLine::close()
+{
+    std::lock_guard<std::mutex> lock(fdMutex_);
+    if (lineFd_ >= 0) {
+        ::close(lineFd_);
+        lineFd_ = -1;
+    }
+    if (cancelFd_ >= 0) {
+        ::close(cancelFd_);
+        cancelFd_ = -1;
+    }
+}
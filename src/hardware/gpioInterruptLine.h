@@ -0,0 +1,83 @@
+/*
+ ██████╗ ██████╗ ██╗ ██████╗ ██╗███╗   ██╗████████╗███████╗██████╗ ██████╗ ██╗   ██╗██████╗ ████████╗██╗     ██╗███╗   ██╗███████╗   ██╗  ██╗
+██╔════╝ ██╔══██╗██║██╔═══██╗██║████╗  ██║╚══██╔══╝██╔════╝██╔══██╗██╔══██╗██║   ██║██╔══██╗╚══██╔══╝██║     ██║████╗  ██║██╔════╝   ██║  ██║
+██║  ███╗██████╔╝██║██║   ██║██║██╔██╗ ██║   ██║   █████╗  ██████╔╝██████╔╝██║   ██║██████╔╝   ██║   ██║     ██║██╔██╗ ██║█████╗     ███████║
+██║   ██║██╔═══╝ ██║██║   ██║██║██║╚██╗██║   ██║   ██╔══╝  ██╔══██╗██╔══██╗██║   ██║██╔═══╝    ██║   ██║     ██║██║╚██╗██║██╔══╝     ██╔══██║
+╚██████╔╝██║     ██║╚██████╔╝██║██║ ╚████║   ██║   ███████╗██║  ██║██║  ██║╚██████╔╝██║        ██║   ███████╗██║██║ ╚████║███████╗██╗██║  ██║
+ ╚═════╝ ╚═╝     ╚═╝ ╚═════╝ ╚═╝╚═╝  ╚═══╝   ╚═╝   ╚══════╝╚═╝  ╚═╝╚═╝  ╚═╝ ╚═════╝ ╚═╝        ╚═╝   ╚══════╝╚═╝╚═╝  ╚═══╝╚══════╝╚═╝╚═╝  ╚═╝
+*/
+
+/*
+MIT License
+
+Copyright (c) 2026 A-McD Technology LLC
+*/
+
+
+/*
+This file defines an edge-triggered GPIO input used as an interrupt line for peripherals wired directly to the
+Raspberry Pi, such as the BMI270 INT1 pin. The IO bridge has no bridge-to-host interrupt line, so these lines
+are requested from the Linux GPIO character device and waited on with poll() instead of a timer.
+*/
+
+#pragma once
+#ifndef GPIOINTERRUPTLINE_H
+#define GPIOINTERRUPTLINE_H
+
+#include <chrono>
+#include <cstdint>
+#include <expected>
+#include <mutex>
+#include <string>
+
+enum class GpioError : uint8_t {
+    NotOpen = 0,
+    OpenFailed,
+    RequestFailed,
+    WaitFailed,
+};
+
+class IGpioInterruptLine {
+public:
+    virtual ~IGpioInterruptLine() = default;
+
+    // Returns true once an edge has been seen, false when the timeout passed or cancelWait() was called.
+    virtual std::expected<bool, GpioError> wait(std::chrono::milliseconds timeout) = 0;
+
+    // Makes the current (or next) wait() return false promptly. Safe to call from any thread.
+    virtual void cancelWait() = 0;
+};
+
+class LinuxGpioInterruptLine final : public IGpioInterruptLine {
+public:
+    enum class Edge : uint8_t {
+        Rising = 0,
+        Falling,
+        Both,
+    };
+
+    LinuxGpioInterruptLine(std::string chipPath, unsigned int lineOffset, Edge edge = Edge::Rising);
+    ~LinuxGpioInterruptLine() override;
+
+    LinuxGpioInterruptLine(const LinuxGpioInterruptLine&) = delete;
+    LinuxGpioInterruptLine& operator=(const LinuxGpioInterruptLine&) = delete;
+
+    std::expected<void, GpioError> open();
+    bool isOpen() const;
+
+    std::expected<bool, GpioError> wait(std::chrono::milliseconds timeout) override;
+    void cancelWait() override;
+
+private:
+    void close();
+
+    std::string chipPath_;
+    unsigned int lineOffset_ = 0;
+    Edge edge_ = Edge::Rising;
+
+    mutable std::mutex fdMutex_;
+    int lineFd_ = -1;
+    int cancelFd_ = -1;
+};
+
+#endif
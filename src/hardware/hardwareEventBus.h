@@ -0,0 +1,400 @@
+/*
+██╗  ██╗ █████╗ ██████╗ ██████╗ ██╗    ██╗ █████╗ ██████╗ ███████╗███████╗██╗   ██╗███████╗███╗   ██╗████████╗██████╗ ██╗   ██╗███████╗   ██╗  ██╗
+██║  ██║██╔══██╗██╔══██╗██╔══██╗██║    ██║██╔══██╗██╔══██╗██╔════╝██╔════╝██║   ██║██╔════╝████╗  ██║╚══██╔══╝██╔══██╗██║   ██║██╔════╝   ██║  ██║
+███████║███████║██████╔╝██║  ██║██║ █╗ ██║███████║██████╔╝█████╗  █████╗  ██║   ██║█████╗  ██╔██╗ ██║   ██║   ██████╔╝██║   ██║███████╗   ███████║
+██╔══██║██╔══██║██╔══██╗██║  ██║██║███╗██║██╔══██║██╔══██╗██╔══╝  ██╔══╝  ╚██╗ ██╔╝██╔══╝  ██║╚██╗██║   ██║   ██╔══██╗██║   ██║╚════██║   ██╔══██║
+██║  ██║██║  ██║██║  ██║██████╔╝╚███╔███╔╝██║  ██║██║  ██║███████╗███████╗ ╚████╔╝ ███████╗██║ ╚████║   ██║   ██████╔╝╚██████╔╝███████║██╗██║  ██║
+╚═╝  ╚═╝╚═╝  ╚═╝╚═╝  ╚═╝╚═════╝  ╚══╝╚══╝ ╚═╝  ╚═╝╚═╝  ╚═╝╚══════╝╚══════╝  ╚═══╝  ╚══════╝╚═╝  ╚═══╝   ╚═╝   ╚═════╝  ╚═════╝ ╚══════╝╚═╝╚═╝  ╚═╝
+*/
+
+/*
+MIT License
+
+Copyright (c) 2026 A-McD Technology LLC
+*/
+
+#pragma once
+#ifndef HARDWARE_EVENT_BUS_H
+#define HARDWARE_EVENT_BUS_H
+
+#include "../telemetry/metrics.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <optional>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/*
+
+Typed fan-out from sensor threads to subscribers that each run on their own executor thread.
+
+publish() loads the current subscriber list and pushes a copy of the event into each subscriber's
+bounded queue, waking the executor only if it is asleep. A full queue drops the event for that
+subscriber and counts the drop, so a slow subscriber can never hold up the sensor loop or the other
+subscribers. subscribe() and unsubscribe() are rare and swap in a new subscriber list under a
+registration mutex. publish() never takes that mutex, but it is not lock-free: libstdc++ implements
+std::atomic<std::shared_ptr> with a spin lock, so loading the list can briefly spin against a swap.
+The queue pushes themselves are lock-free.
+
+An executor drains everything queued for it as one batch. When the subscriber supplied a coalesce
+function, consecutive events in the batch that it folds together are delivered as one, so a subscriber
+that falls behind catches up on a burst instead of replaying it. unsubscribe() delivers what is already
+queued before it returns, and the destructor joins every executor, including those of subscribers
+that unsubscribed from their own callback. The bus must not be destroyed from one of its callbacks.
+
+A subscriber can ask for inline delivery instead: its callback runs inside publish() on the publishing
+thread, so it sees every event in order with nothing queued or coalesced. That is meant for cheap
+hand-offs to another queue, such as the API event bridge.
+
+Each bus records, under hardware_event_bus_* with a "bus" label, deliveries, coalesced and dropped
+events, and the microseconds from publish() to the start of the subscriber's callback.
+
+*/
+
+// Bounded multi-producer queue (Vyukov). Push and pop are a CAS on a position counter plus a sequence
+// stamp per cell; a full queue rejects the push instead of waiting.
+template <typename T>
+class BoundedEventQueue {
+public:
+    explicit BoundedEventQueue(size_t capacity)
+    {
+        size_t rounded = 2;
+        while (rounded < capacity) {
+            rounded <<= 1;
+        }
+        cells_ = std::make_unique<Cell[]>(rounded);
+        mask_ = rounded - 1;
+        for (size_t i = 0; i < rounded; i++) {
+            cells_[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    size_t capacity() const { return mask_ + 1; }
+
+    bool tryPush(const T& value)
+    {
+        size_t pos = enqueuePos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & mask_];
+            const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+            if (diff == 0) {
+                if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    cell.value = value;
+                    cell.sequence.store(pos + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = enqueuePos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    bool tryPop(T& out)
+    {
+        size_t pos = dequeuePos_.load(std::memory_order_relaxed);
+        for (;;) {
+            Cell& cell = cells_[pos & mask_];
+            const size_t sequence = cell.sequence.load(std::memory_order_acquire);
+            const auto diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1);
+            if (diff == 0) {
+                if (dequeuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    out = std::move(cell.value);
+                    cell.sequence.store(pos + mask_ + 1, std::memory_order_release);
+                    return true;
+                }
+            } else if (diff < 0) {
+                return false;
+            } else {
+                pos = dequeuePos_.load(std::memory_order_relaxed);
+            }
+        }
+    }
+
+    // True when the next pop would succeed.
+    bool readable() const
+    {
+        const size_t pos = dequeuePos_.load(std::memory_order_relaxed);
+        return cells_[pos & mask_].sequence.load(std::memory_order_acquire) == pos + 1;
+    }
+
+private:
+    struct Cell {
+        std::atomic<size_t> sequence { 0 };
+        T value {};
+    };
+
+    std::unique_ptr<Cell[]> cells_;
+    size_t mask_ = 0;
+    alignas(64) std::atomic<size_t> enqueuePos_ { 0 };
+    alignas(64) std::atomic<size_t> dequeuePos_ { 0 };
+};
+
+struct HardwareEventSubscriberStats {
+    uint64_t delivered = 0;
+    uint64_t coalesced = 0;
+    uint64_t dropped = 0;
+};
+
+template <typename Event>
+class HardwareEventBus {
+public:
+    using Handle = size_t;
+    using Callback = std::function<void(const Event&)>;
+    // Folds `next` into `pending` and returns true when the two may be delivered as one event.
+    using Coalesce = std::function<bool(Event& pending, const Event& next)>;
+
+    struct SubscribeOptions {
+        size_t queueCapacity = 256;
+        Coalesce coalesce;
+        // Run the callback on the publishing thread, in publish order, instead of on an executor. Only
+        // for cheap hand-offs that never block; queueCapacity and coalesce are ignored.
+        bool inlineDelivery = false;
+    };
+
+    explicit HardwareEventBus(std::string name)
+        : name_(std::move(name))
+        , subscribers_(std::make_shared<const SubscriberList>())
+    {
+        auto& registry = Metrics::MetricsRegistry::instance();
+        const Metrics::Labels labels { { "bus", name_ } };
+        delivered_ = registry.counter("hardware_event_bus_delivered_total", "Events handed to hardware event bus subscribers.", labels);
+        coalesced_ = registry.counter("hardware_event_bus_coalesced_total", "Events folded into a neighbouring event before delivery.", labels);
+        dropped_ = registry.counter("hardware_event_bus_dropped_total", "Events dropped because a subscriber queue was full.", labels);
+        latency_ = registry.histogram("hardware_event_bus_delivery_latency_us", "Microseconds from publish to the start of the subscriber callback.", labels);
+    }
+
+    HardwareEventBus(const HardwareEventBus&) = delete;
+    HardwareEventBus& operator=(const HardwareEventBus&) = delete;
+
+    ~HardwareEventBus()
+    {
+        std::vector<Handle> handles;
+        {
+            std::lock_guard<std::mutex> lock(registrationMutex_);
+            for (const auto& subscriber : *subscribers_.load()) {
+                handles.push_back(subscriber->handle);
+            }
+        }
+        for (const Handle handle : handles) {
+            unsubscribe(handle);
+        }
+        // Executors that unsubscribed themselves still touch the bus's metrics on their way out.
+        std::vector<std::jthread> retired;
+        {
+            std::lock_guard<std::mutex> lock(registrationMutex_);
+            retired.swap(retiredExecutors_);
+        }
+        for (auto& executor : retired) {
+            executor.join();
+        }
+    }
+
+    Handle subscribe(Callback callback)
+    {
+        return subscribe(std::move(callback), SubscribeOptions {});
+    }
+
+    Handle subscribe(Callback callback, SubscribeOptions options)
+    {
+        auto subscriber = std::make_shared<Subscriber>(options.inlineDelivery ? 1 : std::max<size_t>(1, options.queueCapacity));
+        subscriber->callback = std::move(callback);
+        subscriber->coalesce = std::move(options.coalesce);
+        subscriber->inlineDelivery = options.inlineDelivery;
+
+        std::lock_guard<std::mutex> lock(registrationMutex_);
+        subscriber->handle = nextHandle_++;
+        auto next = std::make_shared<SubscriberList>(*subscribers_.load());
+        next->push_back(subscriber);
+        subscribers_.store(std::move(next));
+        if (!subscriber->inlineDelivery) {
+            executors_.emplace(subscriber->handle, std::jthread([this, subscriber]() { runExecutor(*subscriber); }));
+        }
+        return subscriber->handle;
+    }
+
+    // Delivers the events already queued for the subscriber, then stops its executor. May be called
+    // from the subscriber's own callback, in which case the executor exits after the current batch and
+    // is joined by the destructor.
+    // An inline subscriber has no queue; a publish() that is already running may still call it once
+    // after this returns.
+    bool unsubscribe(Handle handle)
+    {
+        std::shared_ptr<Subscriber> subscriber;
+        std::jthread executor;
+        {
+            std::lock_guard<std::mutex> lock(registrationMutex_);
+            auto next = std::make_shared<SubscriberList>(*subscribers_.load());
+            const auto it = std::find_if(next->begin(), next->end(), [handle](const auto& s) { return s->handle == handle; });
+            if (it == next->end()) {
+                return false;
+            }
+            subscriber = *it;
+            next->erase(it);
+            subscribers_.store(std::move(next));
+            if (subscriber->inlineDelivery) {
+                return true;
+            }
+            executor = std::move(executors_.at(handle));
+            executors_.erase(handle);
+        }
+        subscriber->stopping.store(true, std::memory_order_release);
+        wake(*subscriber);
+        if (executor.get_id() == std::this_thread::get_id()) {
+            std::lock_guard<std::mutex> lock(registrationMutex_);
+            retiredExecutors_.push_back(std::move(executor));
+        } else {
+            executor.join();
+        }
+        return true;
+    }
+
+    void publish(const Event& event)
+    {
+        const auto subscribers = subscribers_.load();
+        if (subscribers->empty()) {
+            return;
+        }
+        const Envelope envelope { event, std::chrono::steady_clock::now() };
+        for (const auto& subscriber : *subscribers) {
+            if (subscriber->inlineDelivery) {
+                try {
+                    subscriber->callback(event);
+                } catch (...) {
+                }
+                subscriber->delivered.fetch_add(1, std::memory_order_relaxed);
+                delivered_->increment();
+                continue;
+            }
+            if (!subscriber->queue.tryPush(envelope)) {
+                subscriber->dropped.fetch_add(1, std::memory_order_relaxed);
+                dropped_->increment();
+                continue;
+            }
+            // Pairs with the fence in runExecutor(): either the executor sees the event before it
+            // sleeps or this thread sees it asleep and wakes it.
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (subscriber->sleeping.load(std::memory_order_relaxed)) {
+                wake(*subscriber);
+            }
+        }
+    }
+
+    std::optional<HardwareEventSubscriberStats> stats(Handle handle) const
+    {
+        const auto subscribers = subscribers_.load();
+        for (const auto& subscriber : *subscribers) {
+            if (subscriber->handle == handle) {
+                return HardwareEventSubscriberStats {
+                    subscriber->delivered.load(std::memory_order_relaxed),
+                    subscriber->coalesced.load(std::memory_order_relaxed),
+                    subscriber->dropped.load(std::memory_order_relaxed),
+                };
+            }
+        }
+        return std::nullopt;
+    }
+
+private:
+    struct Envelope {
+        Event event {};
+        std::chrono::steady_clock::time_point publishedAt {};
+    };
+
+    struct Subscriber {
+        explicit Subscriber(size_t capacity)
+            : queue(capacity)
+        {
+        }
+
+        Handle handle = 0;
+        Callback callback;
+        Coalesce coalesce;
+        bool inlineDelivery = false;
+        BoundedEventQueue<Envelope> queue;
+        std::atomic<uint32_t> wakeups { 0 };
+        std::atomic<bool> sleeping { false };
+        std::atomic<bool> stopping { false };
+        std::atomic<uint64_t> delivered { 0 };
+        std::atomic<uint64_t> coalesced { 0 };
+        std::atomic<uint64_t> dropped { 0 };
+    };
+
+    using SubscriberList = std::vector<std::shared_ptr<Subscriber>>;
+
+    static void wake(Subscriber& subscriber)
+    {
+        subscriber.wakeups.fetch_add(1, std::memory_order_release);
+        subscriber.wakeups.notify_one();
+    }
+
+    void runExecutor(Subscriber& subscriber)
+    {
+        std::vector<Envelope> batch;
+        batch.reserve(subscriber.queue.capacity());
+        for (;;) {
+            const uint32_t ticket = subscriber.wakeups.load(std::memory_order_acquire);
+            Envelope envelope;
+            while (batch.size() < subscriber.queue.capacity() && subscriber.queue.tryPop(envelope)) {
+                if (!batch.empty() && subscriber.coalesce && subscriber.coalesce(batch.back().event, envelope.event)) {
+                    subscriber.coalesced.fetch_add(1, std::memory_order_relaxed);
+                    coalesced_->increment();
+                    continue;
+                }
+                batch.push_back(std::move(envelope));
+            }
+
+            if (batch.empty()) {
+                if (subscriber.stopping.load(std::memory_order_acquire)) {
+                    return;
+                }
+                subscriber.sleeping.store(true, std::memory_order_relaxed);
+                std::atomic_thread_fence(std::memory_order_seq_cst);
+                if (!subscriber.queue.readable() && !subscriber.stopping.load(std::memory_order_acquire)) {
+                    subscriber.wakeups.wait(ticket, std::memory_order_acquire);
+                }
+                subscriber.sleeping.store(false, std::memory_order_relaxed);
+                continue;
+            }
+
+            for (const auto& queued : batch) {
+                // Coalesced events report the latency of the oldest event they absorbed.
+                latency_->record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - queued.publishedAt).count()));
+                try {
+                    subscriber.callback(queued.event);
+                } catch (...) {
+                }
+            }
+            subscriber.delivered.fetch_add(batch.size(), std::memory_order_relaxed);
+            delivered_->increment(batch.size());
+            batch.clear();
+        }
+    }
+
+    std::string name_;
+    std::mutex registrationMutex_;
+    std::atomic<std::shared_ptr<const SubscriberList>> subscribers_;
+    std::unordered_map<Handle, std::jthread> executors_;
+    std::vector<std::jthread> retiredExecutors_;
+    Handle nextHandle_ = 1;
+
+    std::shared_ptr<Metrics::Counter> delivered_;
+    std::shared_ptr<Metrics::Counter> coalesced_;
+    std::shared_ptr<Metrics::Counter> dropped_;
+    std::shared_ptr<Metrics::Histogram> latency_;
+};
+
+#endif
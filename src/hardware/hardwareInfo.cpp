@@ -32,6 +32,7 @@ SOFTWARE.
 */
 
 #include "hardwareInfo.h"
+#include "systemSensorSampler.h"
 
 #include <algorithm>
 #include <cctype>
@@ -237,44 +238,55 @@ std::optional<double> maxTemperatureForPredicate(
     return maxValue;
 }
 
+HardwareInfoSnapshot infowareSnapshot()
+{
+    HardwareInfoSnapshot info;
+    info.infowareVersion = std::string(iware::version);
+    info.osInfo = iware::system::OS_info();
+    info.kernelInfo = iware::system::kernel_info();
+    info.cpuArchitecture = iware::cpu::architecture();
+    info.cpuEndianness = iware::cpu::endianness();
+    info.cpuVendor = iware::cpu::vendor();
+    info.cpuVendorId = iware::cpu::vendor_id();
+    info.cpuModelName = iware::cpu::model_name();
+    info.cpuFrequencyHz = iware::cpu::frequency();
+    info.cpuQuantities = iware::cpu::quantities();
+    info.memory = iware::system::memory();
+    return info;
+}
+
 } // namespace
 
 HardwareInfoSnapshot HardwareInfo::snapshot()
 {
-    return snapshot("/sys");
+    const SystemSensorSnapshot sensors = SystemSensorSampler::shared().latest();
+    HardwareInfoSnapshot info = infowareSnapshot();
+    info.thermalSensors = sensors.temperatureReadings();
+    info.cpuTemperatureC = sensors.cpuTemperatureC;
+    info.systemTemperatureC = sensors.systemTemperatureC;
+    return info;
 }
 
 std::vector<HardwareTemperatureReading> HardwareInfo::thermalSensors()
 {
-    return thermalSensors("/sys");
+    return SystemSensorSampler::shared().latest().temperatureReadings();
 }
 
 std::optional<double> HardwareInfo::cpuTemperatureCelsius()
 {
-    return cpuTemperatureCelsius("/sys");
+    return SystemSensorSampler::shared().latest().cpuTemperatureC;
 }
 
 std::optional<double> HardwareInfo::systemTemperatureCelsius()
 {
-    return systemTemperatureCelsius("/sys");
+    return SystemSensorSampler::shared().latest().systemTemperatureC;
 }
 
 HardwareInfoSnapshot HardwareInfo::snapshot(
     const std::filesystem::path& sysRoot,
     FileReader fileReader)
 {
-    HardwareInfoSnapshot info;
-    info.infowareVersion = std::string(iware::version);
-    info.osInfo = iware::system::OS_info();
-    info.kernelInfo = iware::system::kernel_info();
-    info.cpuArchitecture = iware::cpu::architecture();
-    info.cpuEndianness = iware::cpu::endianness();
-    info.cpuVendor = iware::cpu::vendor();
-    info.cpuVendorId = iware::cpu::vendor_id();
-    info.cpuModelName = iware::cpu::model_name();
-    info.cpuFrequencyHz = iware::cpu::frequency();
-    info.cpuQuantities = iware::cpu::quantities();
-    info.memory = iware::system::memory();
+    HardwareInfoSnapshot info = infowareSnapshot();
     info.thermalSensors = thermalSensors(sysRoot, std::move(fileReader));
     info.cpuTemperatureC = maxTemperatureForPredicate(info.thermalSensors, [](const HardwareTemperatureReading& sensor) {
         return sensor.cpuLike;
@@ -74,6 +74,7 @@ class HardwareInfo {
 public:
     using FileReader = std::function<std::optional<std::string>(const std::filesystem::path&)>;
 
+    // Temperatures come from SystemSensorSampler::shared() and may be up to its default max age old.
     static HardwareInfoSnapshot snapshot();
     static std::vector<HardwareTemperatureReading> thermalSensors();
     static std::optional<double> cpuTemperatureCelsius();
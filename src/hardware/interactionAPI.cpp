@@ -36,16 +36,17 @@ nlohmann::json accelerationSampleToJson(const std::optional<Bmi270AccelerationSa
 
 nlohmann::json canonicalInteractionEventToJson(const ApiEvent& event)
 {
+    const nlohmann::json& payload = event.payload.get();
     nlohmann::json sample = nullptr;
-    if (event.payload.contains("sample")) {
-        sample = event.payload["sample"];
+    if (payload.contains("sample")) {
+        sample = payload["sample"];
     }
 
     return nlohmann::json {
         { "sequence", event.sequence },
         { "type", event.event },
         { "occurredAtEpochMs", event.occurredAtEpochMs },
-        { "liftStateAfter", event.payload.value("liftStateAfter", "unknown") },
+        { "liftStateAfter", payload.value("liftStateAfter", "unknown") },
         { "sample", sample },
     };
 }
@@ -40,20 +40,28 @@ InteractionEventBridge::InteractionEventBridge(std::shared_ptr<ApiEventBroker> b
     }
 
     broker_->registerSource("interaction");
-    handle_ = InteractionEvents::subscribe([broker = broker_](const InteractionEvent& event) {
-        if (!broker) {
-            return;
-        }
+    // Every interaction event becomes exactly one broker event, in order, so this runs inline on the
+    // publishing thread. The hand-off is a broker append; the payload is only built when a client reads it.
+    InteractionEvents::Bus::SubscribeOptions options;
+    options.inlineDelivery = true;
+    handle_ = InteractionEvents::subscribe(
+        [broker = broker_](const InteractionEvent& event) {
+            if (!broker) {
+                return;
+            }
 
-        broker->publish(
-            "interaction",
-            interactionEventTypeToString(event.type),
-            nlohmann::json {
-                { "liftStateAfter", interactionLiftStateToString(event.liftStateAfter) },
-                { "sample", accelerationSampleToJson(event.sample) },
-            },
-            event.occurredAtEpochMs);
-    });
+            broker->publish(
+                "interaction",
+                interactionEventTypeToString(event.type),
+                ApiEventPayload::deferred([event]() {
+                    return nlohmann::json {
+                        { "liftStateAfter", interactionLiftStateToString(event.liftStateAfter) },
+                        { "sample", accelerationSampleToJson(event.sample) },
+                    };
+                }),
+                event.occurredAtEpochMs);
+        },
+        std::move(options));
 }
 
 InteractionEventBridge::~InteractionEventBridge()
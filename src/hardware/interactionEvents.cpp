@@ -15,10 +15,6 @@ Copyright (c) 2026 A-McD Technology LLC
 
 #include "interactionEvents.h"
 
-std::mutex InteractionEvents::mutex_;
-std::unordered_map<InteractionEvents::Handle, InteractionEvents::Callback> InteractionEvents::callbacks_;
-std::atomic<InteractionEvents::Handle> InteractionEvents::nextHandle_ { 1 };
-
 const char* interactionEventTypeToString(InteractionEventType type)
 {
     switch (type) {
@@ -46,33 +42,39 @@ const char* interactionLiftStateToString(Bmi270LiftState state)
     }
 }
 
+bool coalesceRepeatedTaps(InteractionEvent& pending, const InteractionEvent& next)
+{
+    if (pending.type != InteractionEventType::Tap || next.type != InteractionEventType::Tap) {
+        return false;
+    }
+    const uint32_t count = pending.count + next.count;
+    pending = next;
+    pending.count = count;
+    return true;
+}
+
+InteractionEvents::Bus& InteractionEvents::bus()
+{
+    static Bus bus("interaction");
+    return bus;
+}
+
 InteractionEvents::Handle InteractionEvents::subscribe(Callback cb)
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-    const Handle handle = nextHandle_++;
-    callbacks_[handle] = std::move(cb);
-    return handle;
+    return bus().subscribe(std::move(cb));
+}
+
+InteractionEvents::Handle InteractionEvents::subscribe(Callback cb, Bus::SubscribeOptions options)
+{
+    return bus().subscribe(std::move(cb), std::move(options));
 }
 
 bool InteractionEvents::unsubscribe(Handle handle)
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-    return callbacks_.erase(handle) > 0;
+    return bus().unsubscribe(handle);
 }
 
 void InteractionEvents::publish(const InteractionEvent& event)
 {
-    std::unordered_map<Handle, Callback> callbacksCopy;
-    {
-        std::lock_guard<std::mutex> lock(mutex_);
-        callbacksCopy = callbacks_;
-    }
-
-    for (const auto& [handle, callback] : callbacksCopy) {
-        (void)handle;
-        try {
-            callback(event);
-        } catch (...) {
-        }
-    }
+    bus().publish(event);
 }
@@ -36,13 +36,10 @@ SOFTWARE.
 #define INTERACTION_EVENTS_H
 
 #include "accel.h"
+#include "hardwareEventBus.h"
 
-#include <atomic>
 #include <cstdint>
-#include <functional>
-#include <mutex>
 #include <optional>
-#include <unordered_map>
 #include <vector>
 
 enum class InteractionEventType : uint8_t {
@@ -57,6 +54,8 @@ struct InteractionEvent {
     uint64_t occurredAtEpochMs = 0;
     Bmi270LiftState liftStateAfter = Bmi270LiftState::Unknown;
     std::optional<Bmi270AccelerationSample> sample;
+    // Number of published events this one stands for after coalescing; 1 unless merged.
+    uint32_t count = 1;
 };
 
 struct InteractionEventPage {
@@ -68,19 +67,23 @@ struct InteractionEventPage {
 const char* interactionEventTypeToString(InteractionEventType type);
 const char* interactionLiftStateToString(Bmi270LiftState state);
 
+// Coalesce function for subscribers that only need the latest of a run of taps: a tap that directly
+// follows another tap is folded into it, keeping the newer sequence, time and sample and summing count.
+bool coalesceRepeatedTaps(InteractionEvent& pending, const InteractionEvent& next);
+
+// Process-wide interaction event bus. Callbacks run on each subscriber's own executor thread (see
+// hardwareEventBus.h), so the interaction loop only pays for the queue pushes in publish().
 class InteractionEvents {
 public:
-    using Handle = size_t;
-    using Callback = std::function<void(const InteractionEvent&)>;
+    using Bus = HardwareEventBus<InteractionEvent>;
+    using Handle = Bus::Handle;
+    using Callback = Bus::Callback;
 
     static Handle subscribe(Callback cb);
+    static Handle subscribe(Callback cb, Bus::SubscribeOptions options);
     static bool unsubscribe(Handle handle);
     static void publish(const InteractionEvent& event);
-
-private:
-    static std::mutex mutex_;
-    static std::unordered_map<Handle, Callback> callbacks_;
-    static std::atomic<Handle> nextHandle_;
+    static Bus& bus();
 };
 
 #endif
@@ -38,6 +38,20 @@ IoBridgeSession centralizes access to the underlying bridge transport so SPI, I2
 
 #include "ioBridge.h"
 
+std::expected<std::vector<IoBridgePayload>, IoBridgeError> IIoBridgeTransport::transactBatch(std::span<const IoBridgeTransaction> transactions)
+{
+    std::vector<IoBridgePayload> responses;
+    responses.reserve(transactions.size());
+    for (const auto& transaction : transactions) {
+        auto response = transact(transaction);
+        if (!response) {
+            return std::unexpected(response.error());
+        }
+        responses.push_back(std::move(*response));
+    }
+    return responses;
+}
+
 IoBridgeSession::IoBridgeSession(std::shared_ptr<IIoBridgeTransport> transport)
     : transport_(std::move(transport))
 {
@@ -69,3 +83,24 @@ std::expected<IoBridgePayload, IoBridgeError> IoBridgeSession::transact(const Io
 
     return transport->transact(transaction);
 }
+
+std::expected<std::vector<IoBridgePayload>, IoBridgeError> IoBridgeSession::transactBatch(std::span<const IoBridgeTransaction> transactions) const
+{
+    std::shared_ptr<IIoBridgeTransport> transport;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        transport = transport_;
+    }
+
+    if (!transport) {
+        return std::unexpected(IoBridgeError::NOT_CONNECTED);
+    }
+
+    return transport->transactBatch(transactions);
+}
+
+size_t IoBridgeSession::mtu() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return transport_ ? transport_->mtu() : kIoBridgeDefaultMtu;
+}
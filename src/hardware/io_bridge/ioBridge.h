@@ -45,6 +45,7 @@ IIoBridgeTransport is the low-level transport seam, and IoBridgeSession is the s
 #include <expected>
 #include <memory>
 #include <mutex>
+#include <span>
 #include <vector>
 
 enum class IoBridgeEndpoint : uint8_t {
@@ -70,6 +71,9 @@ enum class IoBridgeError {
 
 using IoBridgePayload = std::vector<unsigned char>;
 
+// Frame payload limit for the SPI uplink until HELLO negotiates one (ioBridge.md, section 2).
+constexpr size_t kIoBridgeDefaultMtu = 512;
+
 struct IoBridgeTransaction {
     IoBridgeEndpoint endpoint = IoBridgeEndpoint::Management;
     IoBridgePayload payload;
@@ -80,6 +84,11 @@ class IIoBridgeTransport {
 public:
     virtual ~IIoBridgeTransport() = default;
     virtual std::expected<IoBridgePayload, IoBridgeError> transact(const IoBridgeTransaction& transaction) = 0;
+    // Runs the transactions in order as one exchange and returns their responses in the same order.
+    // Transports with a sliding window send ahead of the responses; the default runs them one by one.
+    virtual std::expected<std::vector<IoBridgePayload>, IoBridgeError> transactBatch(std::span<const IoBridgeTransaction> transactions);
+    // Largest payload a single frame may carry, as negotiated at HELLO.
+    virtual size_t mtu() const { return kIoBridgeDefaultMtu; }
 };
 
 class IoBridgeSession {
@@ -90,6 +99,9 @@ public:
     void attachTransport(std::shared_ptr<IIoBridgeTransport> transport);
     bool isAttached() const;
     std::expected<IoBridgePayload, IoBridgeError> transact(const IoBridgeTransaction& transaction) const;
+    std::expected<std::vector<IoBridgePayload>, IoBridgeError> transactBatch(std::span<const IoBridgeTransaction> transactions) const;
+    // The attached transport's MTU, or kIoBridgeDefaultMtu while detached.
+    size_t mtu() const;
 
 private:
     mutable std::mutex mutex_;
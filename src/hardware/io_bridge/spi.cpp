@@ -38,6 +38,76 @@ SPI stores bridge-managed endpoint settings and forwards transfers through IoBri
 
 #include "spi.h"
 
+#include <algorithm>
+
+namespace {
+
+void putLe16(IoBridgePayload& out, uint16_t value)
+{
+    out.push_back(static_cast<uint8_t>(value & 0xFF));
+    out.push_back(static_cast<uint8_t>(value >> 8));
+}
+
+uint16_t getLe16(std::span<const uint8_t> bytes, size_t offset)
+{
+    return static_cast<uint16_t>(bytes[offset] | (bytes[offset + 1] << 8));
+}
+
+SPIError spiErrorFromBridge(IoBridgeError error)
+{
+    switch (error) {
+    case IoBridgeError::NOT_CONNECTED:
+        return SPIError::SPI_DEVICE_NOT_CONNECTED;
+    case IoBridgeError::TIMEOUT:
+        return SPIError::TIMEOUT;
+    case IoBridgeError::INVALID_RESPONSE:
+        return SPIError::SPI_INVALID_RESPONSE;
+    case IoBridgeError::INVALID_ARGUMENT:
+        return SPIError::INVALID_ARGUMENT;
+    case IoBridgeError::TRANSPORT_ERROR:
+    default:
+        return SPIError::TRANSFER_FAILED;
+    }
+}
+
+} // namespace
+
+void SpixXferRequest::encodeTo(IoBridgePayload& out) const
+{
+    out.reserve(out.size() + headerBytes(handle.size()) + tx.size());
+    out.push_back(kOpXfer);
+    out.push_back(kPortAny);
+    putLe16(out, txn);
+    out.push_back(mode);
+    out.push_back(flags);
+    putLe16(out, static_cast<uint16_t>(speedHz & 0xFFFF));
+    putLe16(out, static_cast<uint16_t>(speedHz >> 16));
+    putLe16(out, rxLen);
+    out.push_back(static_cast<uint8_t>(handle.size()));
+    out.insert(out.end(), handle.begin(), handle.end());
+    out.insert(out.end(), tx.begin(), tx.end());
+}
+
+std::optional<SpixXferRequest> SpixXferRequest::decode(std::span<const uint8_t> payload)
+{
+    if (payload.size() < kFixedHeaderBytes || payload[0] != kOpXfer) {
+        return std::nullopt;
+    }
+    SpixXferRequest request;
+    request.txn = getLe16(payload, 2);
+    request.mode = payload[4];
+    request.flags = payload[5];
+    request.speedHz = static_cast<uint32_t>(getLe16(payload, 6)) | (static_cast<uint32_t>(getLe16(payload, 8)) << 16);
+    request.rxLen = getLe16(payload, 10);
+    const size_t handleLength = payload[12];
+    if (payload.size() < headerBytes(handleLength)) {
+        return std::nullopt;
+    }
+    request.handle.assign(payload.begin() + kFixedHeaderBytes, payload.begin() + kFixedHeaderBytes + handleLength);
+    request.tx = payload.subspan(headerBytes(handleLength));
+    return request;
+}
+
 SPI::SPI()
 {
     CubeLog::info("Bridge SPI endpoint wrapper initialized");
@@ -97,7 +167,7 @@ std::expected<int, SPIError> SPI::registerHandle(const std::string& handle, int
 
 std::optional<base64String> SPI::transferTxRx(const std::string& handle, const base64String& txData, size_t rxLen)
 {
-    return transfer(handle, txData, rxLen);
+    return transferBase64(handle, txData, rxLen);
 }
 
 nlohmann::json SPI::getSettings(const std::string& handle)
@@ -118,66 +188,126 @@ std::vector<std::string> SPI::getRegisteredHandles()
 
 std::optional<base64String> SPI::transferTx(const std::string& handle, const std::string& txData)
 {
-    return transfer(handle, txData, 0);
+    return transferBase64(handle, txData, 0);
+}
+
+std::expected<void, SPIError> SPI::transfer(const std::string& handle, std::span<const uint8_t> tx, std::span<uint8_t> rx)
+{
+    const SPITransferSegment segment { tx, rx };
+    return transfer(handle, std::span<const SPITransferSegment>(&segment, 1));
 }
 
-std::optional<base64String> SPI::transfer(const std::string& handle, const base64String& txData, size_t rxLen)
+std::expected<void, SPIError> SPI::transfer(const std::string& handle, std::span<const SPITransferSegment> segments)
 {
     if (!Config::getBool("HARDWARE_SPI_ENABLED", true)) {
         CubeLog::warning("SPI transfer blocked by HARDWARE_SPI_ENABLED=0.");
-        return std::nullopt;
+        return std::unexpected(SPIError::SPI_DEVICE_NOT_AVAILABLE);
     }
 
     std::shared_ptr<IoBridgeSession> bridgeSession;
-    nlohmann::json handleSettings;
+    SpixXferRequest request;
     {
         std::lock_guard<std::mutex> lock(spiMutex);
         if (!isHandleRegistered(handle)) {
             CubeLog::error("SPI handle not registered: " + handle);
-            return std::nullopt;
+            return std::unexpected(SPIError::HANDLE_NOT_FOUND);
         }
 
         bridgeSession = bridgeSession_;
-        handleSettings = spiHandles[handle];
+        const auto& settings = spiHandles[handle];
+        request.mode = settings["mode"].get<uint8_t>();
+        request.speedHz = settings["speed"].get<uint32_t>();
     }
 
     if (!bridgeSession) {
         CubeLog::error("Bridge SPI transfer requested without an attached bridge session.");
-        return std::nullopt;
+        return std::unexpected(SPIError::NOT_INITIALIZED);
+    }
+    if (handle.size() > UINT8_MAX) {
+        CubeLog::error("SPI handle too long for a bridge frame: " + handle);
+        return std::unexpected(SPIError::INVALID_HANDLE);
+    }
+
+    // Each frame carries the header plus at most `chunk` clocked bytes, so neither the request nor
+    // its response exceeds the negotiated MTU.
+    const size_t mtu = bridgeSession->mtu();
+    const size_t header = SpixXferRequest::headerBytes(handle.size());
+    if (mtu <= header) {
+        CubeLog::error("Bridge MTU " + std::to_string(mtu) + " leaves no room for SPI data.");
+        return std::unexpected(SPIError::INVALID_ARGUMENT);
+    }
+    const size_t chunk = std::min<size_t>(mtu - header, UINT16_MAX);
+
+    size_t frames = 0;
+    for (const auto& segment : segments) {
+        frames += (std::max(segment.tx.size(), segment.rx.size()) + chunk - 1) / chunk;
+    }
+    if (frames == 0) {
+        return {};
+    }
+
+    request.txn = nextTxn_.fetch_add(1, std::memory_order_relaxed);
+    request.handle = handle;
+    std::vector<IoBridgeTransaction> transactions;
+    std::vector<std::span<uint8_t>> rxTargets;
+    transactions.reserve(frames);
+    rxTargets.reserve(frames);
+    for (const auto& segment : segments) {
+        const size_t clocked = std::max(segment.tx.size(), segment.rx.size());
+        for (size_t offset = 0; offset < clocked; offset += chunk) {
+            const size_t length = std::min(chunk, clocked - offset);
+            const size_t txOffset = std::min(offset, segment.tx.size());
+            const size_t rxOffset = std::min(offset, segment.rx.size());
+            request.tx = segment.tx.subspan(txOffset, std::min(length, segment.tx.size() - txOffset));
+            const auto rx = segment.rx.subspan(rxOffset, std::min(length, segment.rx.size() - rxOffset));
+            request.rxLen = static_cast<uint16_t>(rx.size());
+            // Chip select stays asserted until the last frame of the list.
+            request.flags = transactions.size() + 1 < frames ? SpixXferRequest::kFlagHoldChipSelect : 0;
+
+            IoBridgeTransaction transaction;
+            transaction.endpoint = IoBridgeEndpoint::Spi;
+            transaction.expectedResponseLength = rx.size();
+            request.encodeTo(transaction.payload);
+            transactions.push_back(std::move(transaction));
+            rxTargets.push_back(rx);
+        }
     }
 
+    auto responses = bridgeSession->transactBatch(transactions);
+    if (!responses) {
+        CubeLog::error("Bridge SPI transfer failed for handle: " + handle);
+        return std::unexpected(spiErrorFromBridge(responses.error()));
+    }
+    if (responses->size() != transactions.size()) {
+        CubeLog::error("Bridge SPI transfer returned " + std::to_string(responses->size()) + " responses for " + std::to_string(transactions.size()) + " frames.");
+        return std::unexpected(SPIError::SPI_INVALID_RESPONSE);
+    }
+    for (size_t i = 0; i < rxTargets.size(); i++) {
+        const auto& response = (*responses)[i];
+        if (response.size() < rxTargets[i].size()) {
+            CubeLog::error("Bridge SPI transfer returned a short response for handle: " + handle);
+            return std::unexpected(SPIError::SPI_INVALID_RESPONSE);
+        }
+        std::copy_n(response.begin(), rxTargets[i].size(), rxTargets[i].begin());
+    }
+    return {};
+}
+
+std::optional<base64String> SPI::transferBase64(const std::string& handle, const base64String& txData, size_t rxLen)
+{
+    IoBridgePayload tx;
     try {
-        cppcodec::base64_rfc4648::decode(txData);
+        tx = base64_decode_cube(txData);
     } catch (const std::exception& e) {
         CubeLog::error("Failed to decode base64 txData: " + std::string(e.what()));
         return std::nullopt;
     }
 
-    nlohmann::json payloadJson = {
-        { "handle", handle },
-        { "mode", handleSettings["mode"] },
-        { "speed", handleSettings["speed"] },
-        { "tx", txData },
-        { "rxLen", rxLen }
-    };
-    const std::string payloadString = payloadJson.dump();
-
-    IoBridgeTransaction transaction;
-    transaction.endpoint = IoBridgeEndpoint::Spi;
-    transaction.payload = IoBridgePayload(payloadString.begin(), payloadString.end());
-    transaction.expectedResponseLength = rxLen;
-
-    auto bridgeResponse = bridgeSession->transact(transaction);
-    if (!bridgeResponse) {
-        CubeLog::error("Bridge SPI transfer failed for handle: " + handle);
+    IoBridgePayload rx(rxLen);
+    if (!transfer(handle, tx, rx)) {
         return std::nullopt;
     }
-
-    if (rxLen == 0) {
-        return base64_encode_cube(IoBridgePayload { });
-    }
-
-    return base64_encode_cube(*bridgeResponse);
+    return base64_encode_cube(rx);
 }
 
 nlohmann::json SPI::getHandleSettings(const std::string& handle)
@@ -40,11 +40,13 @@ SPI represents bridge SPI endpoint access, not Linux host SPI device access, and
 #ifndef SPI_H
 #define SPI_H
 
+#include <atomic>
 #include <cstdint>
 #include <expected>
 #include <memory>
 #include <mutex>
 #include <optional>
+#include <span>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -107,6 +109,42 @@ enum class SPIError {
     SPI_DEVICE_NOT_READY_FOR_CONFIG,
 };
 
+/**
+ * @brief One SPIX XFER frame on the bridge link (IO_Bridge_Specification.md sections 12 and 13.4).
+ * Little-endian layout: EPHeader { op, port, txn } | mode u8 | flags u8 | speedHz u32 | rxLen u16 |
+ * handleLen u8 | handle | tx bytes. Every frame of one transfer list shares a txn, and all but the last
+ * frame set kFlagHoldChipSelect so the bridge keeps CS asserted between them.
+ */
+struct SpixXferRequest {
+    static constexpr uint8_t kOpXfer = 0x02;
+    static constexpr uint8_t kPortAny = 0xFF;
+    static constexpr uint8_t kFlagHoldChipSelect = 0x01;
+    static constexpr size_t kFixedHeaderBytes = 4 + 1 + 1 + 4 + 2 + 1;
+
+    uint16_t txn = 0;
+    uint8_t mode = 0;
+    uint8_t flags = 0;
+    uint32_t speedHz = 0;
+    uint16_t rxLen = 0;
+    std::string handle;
+    // Points into the payload that was decoded, or at the caller's buffer when encoding.
+    std::span<const uint8_t> tx;
+
+    static size_t headerBytes(size_t handleLength) { return kFixedHeaderBytes + handleLength; }
+    void encodeTo(IoBridgePayload& out) const;
+    static std::optional<SpixXferRequest> decode(std::span<const uint8_t> payload);
+};
+
+/**
+ * @brief One segment of a scatter-gather SPI transfer.
+ * The bridge clocks max(tx.size(), rx.size()) bytes: tx is shifted out (zero padded) and the first
+ * rx.size() bytes shifted in are written to rx.
+ */
+struct SPITransferSegment {
+    std::span<const uint8_t> tx;
+    std::span<uint8_t> rx;
+};
+
 /**
  * @brief Bridge-backed SPI endpoint wrapper for app-facing expansion devices.
  * This class stores per-handle SPI settings and forwards transfers through the shared IoBridgeSession.
@@ -127,7 +165,23 @@ public:
      */
     std::expected<int, SPIError> registerHandle(const std::string& handle, int speed, int mode);
     /**
-     * @brief Transfer data over SPI.
+     * @brief Transfer raw bytes over bridge-backed SPI in one chip-select window.
+     * @param handle The handle of the bridge SPI endpoint.
+     * @param tx The bytes to send.
+     * @param rx Caller-provided buffer that receives rx.size() bytes; may be empty.
+     * @return Nothing on success, or the reason the transfer failed.
+     */
+    std::expected<void, SPIError> transfer(const std::string& handle, std::span<const uint8_t> tx, std::span<uint8_t> rx);
+    /**
+     * @brief Run a scatter-gather list of segments back to back with chip select held across them.
+     * The whole list is split into MTU-sized frames and sent to the bridge as one batch.
+     * @param handle The handle of the bridge SPI endpoint.
+     * @param segments The segments to run, in order.
+     * @return Nothing on success, or the reason the transfer failed.
+     */
+    std::expected<void, SPIError> transfer(const std::string& handle, std::span<const SPITransferSegment> segments);
+    /**
+     * @brief Transfer data over SPI. Base64 wrapper over transfer() for the HTTP API.
      * @param handle The handle of the SPI device to communicate with.
      * @param txData The data to send (as a base64 encoded string).
      * @param rxLen The length of the expected response.
@@ -146,7 +200,7 @@ public:
      */
     std::vector<std::string> getRegisteredHandles();
     /**
-     * @brief Transfer data over bridge-backed SPI without expecting a response.
+     * @brief Transfer data over bridge-backed SPI without expecting a response. Base64 wrapper for the HTTP API.
      * @param handle The handle of the bridge SPI endpoint to communicate with.
      * @param txData The data to send (as a base64 encoded string).
      * @return true if the transfer was successful, false otherwise.
@@ -155,13 +209,15 @@ public:
 
 private:
     /**
-     * @brief Internal method to perform the bridge SPI transfer.
+     * @brief Internal method to decode base64 tx data, run the binary transfer and encode the response.
      * @param handle The handle of the bridge SPI endpoint.
      * @param txData The data to send (as a base64 encoded string).
      * @param rxLen The length of the expected response.
      * @return std::optional<std::string> The response data as a base64 encoded string, or an empty optional if the transfer failed.
      */
-    std::optional<base64String> transfer(const std::string& handle, const base64String& txData, size_t rxLen);
+    std::optional<base64String> transferBase64(const std::string& handle, const base64String& txData, size_t rxLen);
+    // Transaction id shared by the frames of one transfer list
+    std::atomic<uint16_t> nextTxn_ { 1 };
     // Mutex for thread safety
     std::mutex spiMutex;
     // Map to store registered SPI handles and their settings
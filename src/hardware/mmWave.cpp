@@ -35,18 +35,22 @@ SOFTWARE.
 #include "mmWaveSerialLifecycle.h"
 #include <algorithm>
 #include <array>
+#include <cerrno>
 #include <chrono>
+#include <iomanip>
+#include <span>
 #include <sstream>
 #ifdef __linux__
 #include <asm/termbits.h>
+#include <poll.h>
 #endif
 
 #define CONNECTION_FAILURE_THRESHOLD 5
 #define CONNECTION_FAILURE_RECONNECT_DELAY_MULTIPLIER 100
 
 // Serial helpers are implemented later under platform ifdefs.
-static int serialDataAvail(int fd);
-static uint8_t serialGetchar(int fd);
+static int serialWait(int fd, int timeoutMs);
+static ssize_t serialRead(int fd, uint8_t* data, size_t len);
 
 namespace {
 constexpr int MMWAVE_BAUD_PREFERRED = 115200;
@@ -64,8 +68,12 @@ constexpr std::array<int, 7> MMWAVE_BAUD_CANDIDATES = {
 };
 
 constexpr auto MMWAVE_RECONNECT_DELAY = std::chrono::milliseconds(500);
+// No valid frame for this long counts as a lost connection.
+constexpr auto MMWAVE_FRAME_TIMEOUT = std::chrono::milliseconds(1000);
+// Longest single wait on the port, so a stop request is noticed promptly.
+constexpr int MMWAVE_POLL_SLICE_MS = 100;
 
-std::string bytesToHexPreview(const std::vector<uint8_t>& bytes, size_t maxBytes = 64)
+std::string bytesToHexPreview(std::span<const uint8_t> bytes, size_t maxBytes = 64)
 {
     std::ostringstream oss;
     const size_t limit = std::min(bytes.size(), maxBytes);
@@ -82,13 +90,6 @@ std::string bytesToHexPreview(const std::vector<uint8_t>& bytes, size_t maxBytes
     return oss.str();
 }
 
-std::string byteToHex(uint8_t value)
-{
-    std::ostringstream oss;
-    oss << std::hex << std::setfill('0') << std::setw(2) << static_cast<int>(value);
-    return oss.str();
-}
-
 const char* presenceStateToString(MmWavePresenceState state)
 {
     switch (state) {
@@ -188,28 +189,47 @@ bool probeSerialStreamSignature(int fd, int timeoutMs)
 {
     const auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
     std::vector<uint8_t> captured;
-    captured.reserve(256);
-
-    while (std::chrono::steady_clock::now() < deadline) {
-        while (::serialDataAvail(fd) > 0) {
-            captured.push_back(::serialGetchar(fd));
-            if (captured.size() >= 256) {
-                if (hasLikelyFrameSignature(captured)) {
-                    return true;
-                }
-                captured.erase(captured.begin(), captured.begin() + 128);
-            }
-        }
+    captured.reserve(512);
+    std::array<uint8_t, 256> chunk {};
 
-        if (!captured.empty() && hasLikelyFrameSignature(captured)) {
+    while (true) {
+        const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+        if (remaining.count() <= 0) {
+            break;
+        }
+        const int ready = ::serialWait(fd, static_cast<int>(remaining.count()));
+        if (ready < 0) {
+            break;
+        }
+        if (ready == 0) {
+            continue;
+        }
+        const ssize_t bytesRead = ::serialRead(fd, chunk.data(), chunk.size());
+        if (bytesRead <= 0) {
+            continue;
+        }
+        captured.insert(captured.end(), chunk.begin(), chunk.begin() + bytesRead);
+        if (hasLikelyFrameSignature(captured)) {
             return true;
         }
-        genericSleep(10);
+        // Keep enough of the tail that a header split across reads is still found.
+        if (captured.size() > 256) {
+            captured.erase(captured.begin(), captured.end() - 3);
+        }
     }
 
     CubeLog::debugSilly("mmWave probe: no known frame signature in sample: " + bytesToHexPreview(captured));
     return false;
 }
+
+void logRejectedFrame(const MmWaveFrameDecoder& decoder)
+{
+    CubeLog::error("mmWave: dropped data frame: " + std::string(mmWaveFrameErrorToString(decoder.lastError())));
+    // Formatting the payload is only worth it when someone will read it.
+    if (CubeLog::isLevelEnabled(Logger::LogLevel::LOGGER_DEBUG)) {
+        CubeLog::debug("mmWave: rejected payload: " + bytesToHexPreview(decoder.rejected()));
+    }
+}
 }
 
 #ifdef __linux__
@@ -246,17 +266,29 @@ static int serialOpen(const char* port, int baud)
     ioctl(fd, TCFLSH, TCIFLUSH);
     return fd;
 }
-static int serialDataAvail(int fd)
+// 1 when readable, 0 on timeout, -1 when the port has gone away.
+static int serialWait(int fd, int timeoutMs)
 {
-    int bytes = 0;
-    ioctl(fd, FIONREAD, &bytes);
-    return bytes;
+    struct pollfd pfd { fd, POLLIN, 0 };
+    const int result = ::poll(&pfd, 1, timeoutMs);
+    if (result < 0) {
+        return errno == EINTR ? 0 : -1;
+    }
+    if (result == 0) {
+        return 0;
+    }
+    if (pfd.revents & POLLIN) {
+        return 1;
+    }
+    return -1;
 }
-static uint8_t serialGetchar(int fd)
+static ssize_t serialRead(int fd, uint8_t* data, size_t len)
 {
-    uint8_t c = 0;
-    ::read(fd, &c, 1);
-    return c;
+    const ssize_t bytesRead = ::read(fd, data, len);
+    if (bytesRead < 0 && (errno == EAGAIN || errno == EINTR)) {
+        return 0;
+    }
+    return bytesRead;
 }
 static void serialWrite(int fd, const uint8_t* data, size_t len)
 {
@@ -274,8 +306,8 @@ static unsigned long millis()
 }
 #else
 static int serialOpen(const char*, int) { return -1; }
-static int serialDataAvail(int) { return 0; }
-static uint8_t serialGetchar(int) { return 0; }
+static int serialWait(int, int) { return -1; }
+static ssize_t serialRead(int, uint8_t*, size_t) { return -1; }
 static void serialWrite(int, const uint8_t*, size_t) { }
 static void serialClose(int) { }
 static unsigned long millis() { return 0; }
@@ -313,7 +345,7 @@ void mmWave::readerLoop(std::stop_token stopToken)
             connectionFailureCount = 0;
         }
         bool newlyReady = false;
-        bool hasConnection = false;
+        int fd = -1;
         {
             std::lock_guard<std::mutex> serialLock(serialMutex);
             if (serialPort_h < 0) {
@@ -321,29 +353,28 @@ void mmWave::readerLoop(std::stop_token stopToken)
                     MMWAVE_BAUD_CANDIDATES.begin(), MMWAVE_BAUD_CANDIDATES.end());
                 newlyReady = connectWithCandidatesLocked(paths, bauds, 500);
             }
-            hasConnection = (serialPort_h >= 0);
+            fd = serialPort_h;
         }
 
         if (newlyReady) {
+            frameDecoder_.reset();
             invokeOnReadyCallback();
             lastPrintTime = millis();
             continue;
         }
 
-        if (!hasConnection) {
+        if (fd < 0) {
             genericSleep(static_cast<int>(MMWAVE_RECONNECT_DELAY.count()));
             continue;
         }
 
-        Response response = readDataFrame();
-        if (!response.success) {
-            markDisconnected("read-loop comms failure: " + response.errorReason);
+        std::string failureReason;
+        if (!readFrames(fd, stopToken, failureReason)) {
+            markDisconnected("read-loop comms failure: " + failureReason);
             genericSleep(static_cast<int>(MMWAVE_RECONNECT_DELAY.count()));
             continue;
         }
 
-        decodeDataFrame(response);
-
         if (millis() - lastPrintTime > 2000) {
             MmWaveReading r = getReading();
             MmWavePresenceDecision decision = getPresenceDecision();
@@ -378,8 +409,6 @@ void mmWave::readerLoop(std::stop_token stopToken)
                 + " stationary=" + std::to_string(decision.absentStationaryDistanceThresholdCm));
             lastPrintTime = millis();
         }
-
-        genericSleep(10);
     }
 }
 
@@ -511,251 +540,84 @@ mmWave::~mmWave()
     resetPresenceStateLocked();
 }
 
-Response mmWave::readDataFrame()
-{
-    std::lock_guard<std::mutex> lock(serialMutex);
-    Response response;
-    if (this->serialPort_h < 0) {
-        response.success = false;
-        response.errorReason = "serial port unavailable";
-        return response;
-    }
-    response.data = REPORT_HEADER;
-    response = true;
-    const size_t headerSize = response.size();
-    uint16_t waitTime = 0;
-    while (serialDataAvail(this->serialPort_h) == 0 && waitTime < 1000) {
-        genericSleep(10);
-        waitTime += 10;
-    }
-    if (waitTime >= 1000) {
-        CubeLog::error("Timeout trying to get data frame. waitedMs=" + std::to_string(waitTime)
-            + ", availNow=" + std::to_string(serialDataAvail(this->serialPort_h)));
-        response = false;
-        response.errorReason = "data frame timeout";
-        return response;
-    }
-    genericSleep(1);
-    if (serialDataAvail(this->serialPort_h) == 0) {
-        CubeLog::error("No data available.");
-        response = false;
-        response.errorReason = "no data available";
-        return response;
-    }
-    int headerIndex = 0;
-    std::vector<uint8_t> headerScanPreview;
-    headerScanPreview.reserve(32);
-    genericSleep(1);
-    while (serialDataAvail(this->serialPort_h) > 0) {
-        uint8_t c = serialGetchar(this->serialPort_h);
-        if (headerScanPreview.size() < 32) {
-            headerScanPreview.push_back(c);
+/**
+ * @brief Block on the port until at least one valid frame has been decoded and published. Reads whatever
+ * the driver has buffered in one call and decodes it in place; a frame split across reads is carried over
+ * by the decoder. Does not hold serialMutex: see frameDecoder_.
+ *
+ * @return false, with failureReason set, if the port failed or no valid frame arrived within
+ * MMWAVE_FRAME_TIMEOUT.
+ */
+bool mmWave::readFrames(int fd, std::stop_token stopToken, std::string& failureReason)
+{
+    const auto deadline = std::chrono::steady_clock::now() + MMWAVE_FRAME_TIMEOUT;
+    bool receivedBytes = false;
+    MmWaveFrame frame;
+    while (!stopToken.stop_requested()) {
+        const auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+        if (remaining.count() <= 0) {
+            failureReason = receivedBytes ? "no valid data frame" : "data frame timeout";
+            return false;
+        }
+        const int ready = serialWait(fd, static_cast<int>(std::min<int64_t>(remaining.count(), MMWAVE_POLL_SLICE_MS)));
+        if (ready < 0) {
+            failureReason = "serial port error";
+            return false;
+        }
+        if (ready == 0) {
+            continue;
+        }
+        const ssize_t bytesRead = serialRead(fd, readBuffer_.data(), readBuffer_.size());
+        if (bytesRead < 0) {
+            failureReason = "serial read failed";
+            return false;
         }
-        if (c == response[headerIndex]) {
-            headerIndex++;
-            if (headerIndex == response.size()) {
+        if (bytesRead == 0) {
+            continue;
+        }
+        receivedBytes = true;
+
+        bool decodedFrame = false;
+        std::span<const uint8_t> input(readBuffer_.data(), static_cast<size_t>(bytesRead));
+        while (!input.empty()) {
+            switch (frameDecoder_.decode(input, frame)) {
+            case MmWaveFrameDecoder::Status::Frame:
+                publishReading(frame.reading);
+                decodedFrame = true;
+                break;
+            case MmWaveFrameDecoder::Status::Error:
+                logRejectedFrame(frameDecoder_);
+                break;
+            case MmWaveFrameDecoder::Status::NeedMore:
                 break;
             }
-        } else {
-            headerIndex = 0;
         }
-    }
-    if (headerIndex != response.size()) {
-        CubeLog::error("Failed to find report header. scannedPrefix=" + bytesToHexPreview(headerScanPreview)
-            + ", availAfterScan=" + std::to_string(serialDataAvail(this->serialPort_h)));
-        response = false;
-        response.errorReason = "missing report header";
-        return response;
-    }
-
-    genericSleep(1);
-    uint16_t reportSize = 0;
-    reportSize = serialGetchar(this->serialPort_h);
-    reportSize |= serialGetchar(this->serialPort_h) << 8;
-
-    response += reportSize & 0xFF;
-    response += (reportSize >> 8) & 0xFF;
-
-    if (serialDataAvail(this->serialPort_h) < reportSize) {
-        CubeLog::error("Report size does not match data available. reportSize=" + std::to_string(reportSize)
-            + ", avail=" + std::to_string(serialDataAvail(this->serialPort_h)));
-        response = false;
-        response.errorReason = "report size mismatch";
-        return response;
-    }
-
-    genericSleep(2);
-    std::vector<uint8_t> tail = REPORT_TAIL;
-    for (uint16_t i = 0; i < reportSize + tail.size(); i++) {
-        response += serialGetchar(this->serialPort_h);
-    }
-
-    if (response.size() != reportSize + tail.size() + headerSize + 2) { // 2 for the size bytes
-        CubeLog::error("Failed to get full report. expectedBytes="
-            + std::to_string(reportSize + tail.size() + headerSize + 2)
-            + ", actualBytes=" + std::to_string(response.size())
-            + ", framePrefix=" + bytesToHexPreview(response.data));
-        response = false;
-        response.errorReason = "short report";
-        return response;
-    }
-
-    for (uint16_t i = 1; i <= tail.size(); i++) {
-        if (response[response.size() - i] != tail[tail.size() - i]) {
-            CubeLog::error("Failed to find report tail. expectedTail=" + bytesToHexPreview(tail)
-                + ", frameSuffix="
-                + bytesToHexPreview(std::vector<uint8_t>(response.data.end() - tail.size(), response.data.end())));
-            response = false;
-            response.errorReason = "invalid report tail";
-            return response;
+        if (decodedFrame) {
+            return true;
         }
     }
-
-    return response;
+    return true;
 }
 
-void mmWave::decodeDataFrame(Response response)
+void mmWave::publishReading(const MmWaveReading& reading)
 {
-    if (!response.success) {
-        CubeLog::error("Failed to decode data frame.");
-        return;
-    }
-    // CubeLog::debugSilly("Encoded frame: " + response.hexStr);
-    std::vector<uint8_t> data = response.getData();
-
-    // datalength, two bytes, little endian
-    uint16_t dataLength = data[0] | data[1] << 8;
-
-    // Data type, Normal or Engineering
-    uint8_t dataType = data[2];
-
-    // Head
-    uint8_t head = data[3];
-
-    if (head != 0xaa) {
-        CubeLog::error("Failed to find head. got=0x" + byteToHex(head)
-            + ", frame=" + bytesToHexPreview(data));
-        return;
-    }
-
-    // Tail
-    uint8_t tail = data.at(data.size() - 2);
-
-    if (tail != 0x55) {
-        CubeLog::error("Failed to find tail. got=0x" + byteToHex(tail)
-            + ", frame=" + bytesToHexPreview(data));
-        return;
-    }
-
-    // check
-    uint8_t check = data.at(data.size() - 1);
-
-    if (dataType == 0x02) {
-        // CubeLog::info("Normal data frame.");
-        if (data.size() != 15) {
-            CubeLog::error("Data size does not match. type=normal, size=" + std::to_string(data.size())
-                + ", dataLengthField=" + std::to_string(dataLength)
-                + ", frame=" + bytesToHexPreview(data));
-            return;
-        }
-        MmWavePresenceDecision decision;
-        MmWavePresenceDecision previousDecision;
-        bool shouldPublishDecision = false;
-        MmWaveReading previousReading;
-        MmWaveReading updatedReading;
-        {
-            std::lock_guard<std::mutex> lock(readingMutex);
-            previousReading = currentReading;
-            previousDecision = presenceEstimator_.decision();
-            // target state, 1 byte
-            currentReading.targetState = data[4];
-            // moving target distance, 2 bytes, cm
-            currentReading.movingTargetDistance = data[5] | data[6] << 8;
-            // Exercise target energy value, 1 byte
-            currentReading.movingTargetEnergy = data[7];
-            // Stationary target distance, 2 byte, cm
-            currentReading.stationaryTargetDistance = data[8] | data[9] << 8;
-            // Stationary target energy, 1 byte
-            currentReading.stationaryTargetEnergy = data[10];
-            // Detection Distance, 2 byte, cm
-            currentReading.detectionDistance = data[11] | data[12] << 8;
-            updatedReading = currentReading;
-            if (presenceDetectionEnabled_) {
-                decision = presenceEstimator_.update(currentReading, std::chrono::steady_clock::now());
-                shouldPublishDecision = true;
-            }
-        }
-        if (shouldPublishDecision) {
-            logPresenceTransition(previousReading, previousDecision, updatedReading, decision);
-            invokePresenceUpdateCallback(decision);
-        }
-    } else if (dataType == 0x01) {
-        CubeLog::info("Engineering data frame.");
-        // Need at least 15 bytes to safely read gate counts at data[13] and data[14]
-        if (data.size() < 15) {
-            CubeLog::error("Engineering data frame too short. size=" + std::to_string(data.size())
-                + ", frame=" + bytesToHexPreview(data));
-            return;
-        }
-        // target state, 1 byte
-        MmWavePresenceDecision decision;
-        MmWavePresenceDecision previousDecision;
-        bool shouldPublishDecision = false;
-        MmWaveReading previousReading;
-        MmWaveReading updatedReading;
-        {
-            std::lock_guard<std::mutex> lock(readingMutex);
-            previousReading = currentReading;
-            previousDecision = presenceEstimator_.decision();
-            currentReading.targetState = data[4];
-            // Moving target distance, 2 bytes, cm
-            currentReading.movingTargetDistance = data[5] | data[6] << 8;
-            // Moving target energy value, 1 byte
-            currentReading.movingTargetEnergy = data[7];
-            // Stationary target distance, 2 byte, cm
-            currentReading.stationaryTargetDistance = data[8] | data[9] << 8;
-            // Stationary target energy, 1 byte
-            currentReading.stationaryTargetEnergy = data[10];
-            // Detection Distance, 2 byte, cm
-            currentReading.detectionDistance = data[11] | data[12] << 8;
-            updatedReading = currentReading;
-            if (presenceDetectionEnabled_) {
-                decision = presenceEstimator_.update(currentReading, std::chrono::steady_clock::now());
-                shouldPublishDecision = true;
-            }
-        }
-        if (shouldPublishDecision) {
-            logPresenceTransition(previousReading, previousDecision, updatedReading, decision);
-            invokePresenceUpdateCallback(decision);
-        }
-        // Max moving/stationary gate INDEX N means gates 0..N (N+1 energy values each)
-        uint8_t maxMovingDistanceGateNumber = data[13];
-        uint8_t maxStationaryDistanceGateNumber = data[14];
-        // Expected getData() size: 2 (length bytes) + 13 (fixed fields) +
-        // (N_m+1) moving gate energies + (N_s+1) stat gate energies +
-        // 1 (photosensitive) + 1 (OUT pin) + 1 (tail 0x55) + 1 (cal 0x00) = 21 + N_m + N_s
-        size_t expectedSize = 21 + maxMovingDistanceGateNumber + maxStationaryDistanceGateNumber;
-        if (data.size() != expectedSize) {
-            CubeLog::error("Engineering data size does not match. size=" + std::to_string(data.size())
-                + ", expected=" + std::to_string(expectedSize)
-                + ", dataLengthField=" + std::to_string(dataLength)
-                + ", frame=" + bytesToHexPreview(data));
-            return;
-        }
-        std::vector<uint8_t> movingDistanceGateEnergy;
-        movingDistanceGateEnergy.reserve(maxMovingDistanceGateNumber + 1);
-        for (size_t i = 0; i <= maxMovingDistanceGateNumber; i++) {
-            movingDistanceGateEnergy.push_back(data[15 + i]);
-        }
-        std::vector<uint8_t> stationaryDistanceGateEnergy;
-        stationaryDistanceGateEnergy.reserve(maxStationaryDistanceGateNumber + 1);
-        for (size_t i = 0; i <= maxStationaryDistanceGateNumber; i++) {
-            stationaryDistanceGateEnergy.push_back(data[16 + maxMovingDistanceGateNumber + i]);
+    MmWavePresenceDecision decision;
+    MmWavePresenceDecision previousDecision;
+    bool shouldPublishDecision = false;
+    MmWaveReading previousReading;
+    {
+        std::lock_guard<std::mutex> lock(readingMutex);
+        previousReading = currentReading;
+        previousDecision = presenceEstimator_.decision();
+        currentReading = reading;
+        if (presenceDetectionEnabled_) {
+            decision = presenceEstimator_.update(currentReading, std::chrono::steady_clock::now());
+            shouldPublishDecision = true;
         }
-    } else {
-        CubeLog::error("Unknown data type. dataType=0x" + byteToHex(dataType)
-            + ", frame=" + bytesToHexPreview(data));
-        return;
+    }
+    if (shouldPublishDecision) {
+        logPresenceTransition(previousReading, previousDecision, reading, decision);
+        invokePresenceUpdateCallback(decision);
     }
 }
 
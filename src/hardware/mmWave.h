@@ -32,14 +32,14 @@ SOFTWARE.
 */
 
 #pragma once
+#include "mmWaveFrameDecoder.h"
 #include "mmWavePresenceEstimator.h"
+#include <array>
 #include <atomic>
 #include <chrono>
 #include <functional>
-#include <iomanip>
 #include <memory>
 #include <mutex>
-#include <sstream>
 #include <string>
 #include <vector>
 #ifndef LOGGER_H
@@ -58,149 +58,6 @@ SOFTWARE.
 #define REPORT_HEADER { 0xF4, 0xF3, 0xF2, 0xF1 }
 #define REPORT_TAIL { 0xF8, 0xF7, 0xF6, 0xF5 }
 
-class Response {
-public:
-    bool success = false;
-    std::vector<uint8_t> data = {};
-    std::string hexStr = "";
-    std::string errorReason = "";
-
-    std::vector<uint8_t> getHeader()
-    {
-        return { data[0], data[1], data[2], data[3] };
-    }
-
-    std::vector<uint8_t> getTail()
-    {
-        return { data[data.size() - 4], data[data.size() - 3], data[data.size() - 2], data[data.size() - 1] };
-    }
-
-    std::vector<uint8_t> getData()
-    {
-        return { data.begin() + 4, data.end() - 4 };
-    }
-
-    Response() = default;
-
-    size_t size()
-    {
-        return data.size();
-    }
-
-    uint8_t operator[](const size_t& index)
-    {
-        if (index < data.size()) {
-            return data.at(index);
-        }
-        return 0;
-    }
-
-    bool operator==(const std::vector<uint8_t>& other)
-    {
-        bool equal = false;
-        if (data.size() == other.size()) {
-            equal = true;
-            for (size_t i = 0; i < data.size(); i++) {
-                if (data[i] != other[i]) {
-                    equal = false;
-                    break;
-                }
-            }
-        }
-        return equal;
-    }
-
-    bool operator!=(const std::vector<uint8_t>& other)
-    {
-        return !(*this == other);
-    }
-
-    bool operator==(const bool& other)
-    {
-        return success == other;
-    }
-
-    Response& operator=(const bool& newSuccess)
-    {
-        success = newSuccess;
-        return *this;
-    }
-
-    Response& operator=(const std::vector<uint8_t>& newData)
-    {
-        data = newData;
-        updateHexStr();
-        return *this;
-    }
-
-    Response& operator+=(const uint8_t& extraData)
-    {
-        data.push_back(extraData);
-        updateHexStr();
-        return *this;
-    }
-
-    Response& operator+=(const char& extraData)
-    {
-        data.push_back(static_cast<uint8_t>(extraData));
-        updateHexStr();
-        return *this;
-    }
-
-    // Addition operator
-    Response& operator+=(const std::vector<uint8_t>& extraData)
-    {
-        data.insert(data.end(), extraData.begin(), extraData.end());
-        updateHexStr();
-        return *this;
-    }
-
-    // Addition operator for adding two Response objects' data together
-    Response& operator+=(const Response& other)
-    {
-        data.insert(data.end(), other.data.begin(), other.data.end());
-        updateHexStr();
-        success = success && other.success;
-        return *this;
-    }
-
-    Response& operator+=(const int& extraData)
-    {
-        data.push_back(static_cast<uint8_t>(extraData));
-        updateHexStr();
-        return *this;
-    }
-
-    // Addition operator for creating a new Response object as the sum of two others
-    Response operator+(const Response& other) const
-    {
-        Response result = *this;
-        result += other;
-        result.success = success && other.success;
-        return result;
-    }
-
-private:
-    // Helper function to convert vector data to hex string
-    void updateHexStr()
-    {
-        std::ostringstream oss;
-        for (const auto& byte : data) {
-            oss << std::hex << std::setw(2) << std::setfill('0') << static_cast<int>(byte);
-        }
-        hexStr = oss.str();
-    }
-};
-
-struct MmWaveReading {
-    uint8_t targetState = 0;
-    uint16_t movingTargetDistance = 0;
-    uint8_t movingTargetEnergy = 0;
-    uint16_t stationaryTargetDistance = 0;
-    uint8_t stationaryTargetEnergy = 0;
-    uint16_t detectionDistance = 0;
-};
-
 class mmWave {
     // Current reading protected by readingMutex
     std::mutex readingMutex;
@@ -221,8 +78,13 @@ class mmWave {
     std::string connectedSerialPath_;
     int connectedBaud_ = -1;
 
-    Response readDataFrame();
-    void decodeDataFrame(Response response);
+    // Reader thread only. The fd is never closed while the reader is blocked on it: only the reader
+    // thread and the destructor (after joining it) close the port.
+    MmWaveFrameDecoder frameDecoder_;
+    std::array<uint8_t, 512> readBuffer_ {};
+
+    bool readFrames(int fd, std::stop_token stopToken, std::string& failureReason);
+    void publishReading(const MmWaveReading& reading);
     void readerLoop(std::stop_token stopToken);
     void closeSerialPortLocked();
     bool connectWithCandidatesLocked(const std::vector<std::string>& paths, const std::vector<int>& baudCandidates, int probeTimeoutMs);
@@ -0,0 +1,210 @@
+/*
+███╗   ███╗███╗   ███╗██╗    ██╗ █████╗ ██╗   ██╗███████╗███████╗██████╗  █████╗ ███╗   ███╗███████╗██████╗ ███████╗ ██████╗ ██████╗ ██████╗ ███████╗██████╗     ██████╗██████╗ ██████╗
+████╗ ████║████╗ ████║██║    ██║██╔══██╗██║   ██║██╔════╝██╔════╝██╔══██╗██╔══██╗████╗ ████║██╔════╝██╔══██╗██╔════╝██╔════╝██╔═══██╗██╔══██╗██╔════╝██╔══██╗   ██╔════╝██╔══██╗██╔══██╗
+██╔████╔██║██╔████╔██║██║ █╗ ██║███████║██║   ██║█████╗  █████╗  ██████╔╝███████║██╔████╔██║█████╗  ██║  ██║█████╗  ██║     ██║   ██║██║  ██║█████╗  ██████╔╝   ██║     ██████╔╝██████╔╝
+██║╚██╔╝██║██║╚██╔╝██║██║███╗██║██╔══██║╚██╗ ██╔╝██╔══╝  ██╔══╝  ██╔══██╗██╔══██║██║╚██╔╝██║██╔══╝  ██║  ██║██╔══╝  ██║     ██║   ██║██║  ██║██╔══╝  ██╔══██╗   ██║     ██╔═══╝ ██╔═══╝
+██║ ╚═╝ ██║██║ ╚═╝ ██║╚███╔███╔╝██║  ██║ ╚████╔╝ ███████╗██║     ██║  ██║██║  ██║██║ ╚═╝ ██║███████╗██████╔╝███████╗╚██████╗╚██████╔╝██████╔╝███████╗██║  ██║██╗╚██████╗██║     ██║
+╚═╝     ╚═╝╚═╝     ╚═╝ ╚══╝╚══╝ ╚═╝  ╚═╝  ╚═══╝  ╚══════╝╚═╝     ╚═╝  ╚═╝╚═╝  ╚═╝╚═╝     ╚═╝╚══════╝╚═════╝ ╚══════╝ ╚═════╝ ╚═════╝ ╚═════╝ ╚══════╝╚═╝  ╚═╝╚═╝ ╚═════╝╚═╝     ╚═╝
+*/
+
+/*
+MIT License
+
+Copyright (c) 2026 A-McD Technology LLC
+*/
+
+#include "mmWaveFrameDecoder.h"
+#include <algorithm>
+#include <cstring>
+
+namespace {
+constexpr std::array<uint8_t, 4> FRAME_HEADER = { 0xF4, 0xF3, 0xF2, 0xF1 };
+constexpr std::array<uint8_t, 4> FRAME_TAIL = { 0xF8, 0xF7, 0xF6, 0xF5 };
+constexpr uint8_t PAYLOAD_HEAD = 0xAA;
+constexpr uint8_t PAYLOAD_END = 0x55;
+// type, head, end marker, check
+constexpr size_t MIN_PAYLOAD = 4;
+// type, head, 9 bytes of target fields, end marker, check
+constexpr size_t NORMAL_PAYLOAD = 13;
+
+uint16_t le16(const uint8_t* bytes)
+{
+    return static_cast<uint16_t>(bytes[0] | bytes[1] << 8);
+}
+
+// Target fields are at the same offsets in normal and engineering frames.
+MmWaveReading readTarget(const uint8_t* payload)
+{
+    MmWaveReading reading;
+    reading.targetState = payload[2];
+    reading.movingTargetDistance = le16(payload + 3);
+    reading.movingTargetEnergy = payload[5];
+    reading.stationaryTargetDistance = le16(payload + 6);
+    reading.stationaryTargetEnergy = payload[8];
+    reading.detectionDistance = le16(payload + 9);
+    return reading;
+}
+}
+
+const char* mmWaveFrameErrorToString(MmWaveFrameError error)
+{
+    switch (error) {
+    case MmWaveFrameError::None:
+        return "none";
+    case MmWaveFrameError::BadLength:
+        return "report length out of range";
+    case MmWaveFrameError::BadTail:
+        return "invalid report tail";
+    case MmWaveFrameError::BadHead:
+        return "invalid payload head";
+    case MmWaveFrameError::BadEndMarker:
+        return "invalid payload end marker";
+    case MmWaveFrameError::BadSize:
+        return "payload size does not match frame type";
+    case MmWaveFrameError::UnknownType:
+    default:
+        return "unknown data type";
+    }
+}
+
+void MmWaveFrameDecoder::reset()
+{
+    state_ = State::Header;
+    matched_ = 0;
+    length_ = 0;
+    received_ = 0;
+    error_ = MmWaveFrameError::None;
+}
+
+MmWaveFrameDecoder::Status MmWaveFrameDecoder::fail(MmWaveFrameError error)
+{
+    error_ = error;
+    stats_.errors++;
+    state_ = State::Header;
+    matched_ = 0;
+    return Status::Error;
+}
+
+MmWaveFrameDecoder::Status MmWaveFrameDecoder::decode(std::span<const uint8_t>& input, MmWaveFrame& out)
+{
+    while (!input.empty()) {
+        switch (state_) {
+        case State::Header: {
+            if (matched_ == 0) {
+                // Skip line noise in bulk rather than byte by byte.
+                const void* start = std::memchr(input.data(), FRAME_HEADER[0], input.size());
+                if (start == nullptr) {
+                    stats_.skippedBytes += input.size();
+                    input = input.subspan(input.size());
+                    return Status::NeedMore;
+                }
+                const size_t skipped = static_cast<size_t>(static_cast<const uint8_t*>(start) - input.data());
+                stats_.skippedBytes += skipped;
+                input = input.subspan(skipped + 1);
+                matched_ = 1;
+                break;
+            }
+            const uint8_t byte = input.front();
+            input = input.subspan(1);
+            if (byte == FRAME_HEADER[matched_]) {
+                if (++matched_ == FRAME_HEADER.size()) {
+                    state_ = State::Length;
+                    matched_ = 0;
+                }
+            } else if (byte == FRAME_HEADER[0]) {
+                stats_.skippedBytes += matched_;
+                matched_ = 1;
+            } else {
+                stats_.skippedBytes += matched_ + 1;
+                matched_ = 0;
+            }
+            break;
+        }
+        case State::Length:
+            length_ = static_cast<uint16_t>(length_ | input.front() << (8 * matched_));
+            input = input.subspan(1);
+            if (++matched_ == 2) {
+                matched_ = 0;
+                received_ = 0;
+                if (length_ < MIN_PAYLOAD || length_ > MAX_PAYLOAD) {
+                    length_ = 0;
+                    return fail(MmWaveFrameError::BadLength);
+                }
+                state_ = State::Payload;
+            }
+            break;
+        case State::Payload: {
+            const size_t take = std::min(input.size(), static_cast<size_t>(length_) - received_);
+            std::memcpy(payload_.data() + received_, input.data(), take);
+            received_ += take;
+            input = input.subspan(take);
+            if (received_ == length_) {
+                state_ = State::Tail;
+            }
+            break;
+        }
+        case State::Tail:
+            // A mismatched byte is left in input: it may start the next header.
+            if (input.front() != FRAME_TAIL[matched_]) {
+                length_ = 0;
+                return fail(MmWaveFrameError::BadTail);
+            }
+            input = input.subspan(1);
+            if (++matched_ == FRAME_TAIL.size()) {
+                return finish(out);
+            }
+            break;
+        }
+    }
+    return Status::NeedMore;
+}
+
+MmWaveFrameDecoder::Status MmWaveFrameDecoder::finish(MmWaveFrame& out)
+{
+    const size_t length = length_;
+    length_ = 0;
+    state_ = State::Header;
+    matched_ = 0;
+
+    const uint8_t* payload = payload_.data();
+    if (payload[1] != PAYLOAD_HEAD) {
+        return fail(MmWaveFrameError::BadHead);
+    }
+    if (payload[length - 2] != PAYLOAD_END) {
+        return fail(MmWaveFrameError::BadEndMarker);
+    }
+
+    const uint8_t dataType = payload[0];
+    if (dataType == DATA_TYPE_NORMAL) {
+        if (length != NORMAL_PAYLOAD) {
+            return fail(MmWaveFrameError::BadSize);
+        }
+        out.movingGateCount = 0;
+        out.stationaryGateCount = 0;
+    } else if (dataType == DATA_TYPE_ENGINEERING) {
+        // Gate counts follow the target fields as max gate indexes N_m and N_s, then N_m + 1 moving
+        // energies, N_s + 1 stationary energies, photosensitive, OUT pin, end marker and check:
+        // 19 + N_m + N_s bytes.
+        if (length < NORMAL_PAYLOAD) {
+            return fail(MmWaveFrameError::BadSize);
+        }
+        const size_t movingGates = static_cast<size_t>(payload[11]) + 1;
+        const size_t stationaryGates = static_cast<size_t>(payload[12]) + 1;
+        if (length != 17 + movingGates + stationaryGates
+            || movingGates > MmWaveFrame::MAX_GATES || stationaryGates > MmWaveFrame::MAX_GATES) {
+            return fail(MmWaveFrameError::BadSize);
+        }
+        out.movingGateCount = static_cast<uint8_t>(movingGates);
+        out.stationaryGateCount = static_cast<uint8_t>(stationaryGates);
+        std::memcpy(out.movingGateEnergy.data(), payload + 13, movingGates);
+        std::memcpy(out.stationaryGateEnergy.data(), payload + 13 + movingGates, stationaryGates);
+    } else {
+        return fail(MmWaveFrameError::UnknownType);
+    }
+
+    out.dataType = dataType;
+    out.reading = readTarget(payload);
+    error_ = MmWaveFrameError::None;
+    stats_.frames++;
+    return Status::Frame;
+}
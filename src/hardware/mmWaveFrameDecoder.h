@@ -0,0 +1,116 @@
+/*
+███╗   ███╗███╗   ███╗██╗    ██╗ █████╗ ██╗   ██╗███████╗███████╗██████╗  █████╗ ███╗   ███╗███████╗██████╗ ███████╗ ██████╗ ██████╗ ██████╗ ███████╗██████╗    ██╗  ██╗
+████╗ ████║████╗ ████║██║    ██║██╔══██╗██║   ██║██╔════╝██╔════╝██╔══██╗██╔══██╗████╗ ████║██╔════╝██╔══██╗██╔════╝██╔════╝██╔═══██╗██╔══██╗██╔════╝██╔══██╗   ██║  ██║
+██╔████╔██║██╔████╔██║██║ █╗ ██║███████║██║   ██║█████╗  █████╗  ██████╔╝███████║██╔████╔██║█████╗  ██║  ██║█████╗  ██║     ██║   ██║██║  ██║█████╗  ██████╔╝   ███████║
+██║╚██╔╝██║██║╚██╔╝██║██║███╗██║██╔══██║╚██╗ ██╔╝██╔══╝  ██╔══╝  ██╔══██╗██╔══██║██║╚██╔╝██║██╔══╝  ██║  ██║██╔══╝  ██║     ██║   ██║██║  ██║██╔══╝  ██╔══██╗   ██╔══██║
+██║ ╚═╝ ██║██║ ╚═╝ ██║╚███╔███╔╝██║  ██║ ╚████╔╝ ███████╗██║     ██║  ██║██║  ██║██║ ╚═╝ ██║███████╗██████╔╝███████╗╚██████╗╚██████╔╝██████╔╝███████╗██║  ██║██╗██║  ██║
+╚═╝     ╚═╝╚═╝     ╚═╝ ╚══╝╚══╝ ╚═╝  ╚═╝  ╚═══╝  ╚══════╝╚═╝     ╚═╝  ╚═╝╚═╝  ╚═╝╚═╝     ╚═╝╚══════╝╚═════╝ ╚══════╝ ╚═════╝ ╚═════╝ ╚═════╝ ╚══════╝╚═╝  ╚═╝╚═╝╚═╝  ╚═╝
+*/
+
+/*
+MIT License
+
+Copyright (c) 2026 A-McD Technology LLC
+*/
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+/*
+Incremental decoder for the LD2410 report stream. Bytes are pushed in whatever chunks read() returned and
+the decoder walks header -> length -> payload -> tail, keeping a partial frame in a fixed buffer between
+calls, so a frame split across reads costs nothing extra and nothing on the hot path allocates.
+
+Report layout on the wire:
+    F4 F3 F2 F1 | len (LE u16) | payload[len] | F8 F7 F6 F5
+payload:
+    type (0x02 normal, 0x01 engineering) | 0xAA | fields... | 0x55 | check
+*/
+
+struct MmWaveReading {
+    uint8_t targetState = 0;
+    uint16_t movingTargetDistance = 0;
+    uint8_t movingTargetEnergy = 0;
+    uint16_t stationaryTargetDistance = 0;
+    uint8_t stationaryTargetEnergy = 0;
+    uint16_t detectionDistance = 0;
+};
+
+struct MmWaveFrame {
+    static constexpr size_t MAX_GATES = 32;
+
+    uint8_t dataType = 0;
+    MmWaveReading reading;
+    // Engineering frames only; counts are gates (max gate index + 1).
+    uint8_t movingGateCount = 0;
+    uint8_t stationaryGateCount = 0;
+    std::array<uint8_t, MAX_GATES> movingGateEnergy {};
+    std::array<uint8_t, MAX_GATES> stationaryGateEnergy {};
+};
+
+enum class MmWaveFrameError : uint8_t {
+    None = 0,
+    BadLength,
+    BadTail,
+    BadHead,
+    BadEndMarker,
+    BadSize,
+    UnknownType
+};
+
+const char* mmWaveFrameErrorToString(MmWaveFrameError error);
+
+class MmWaveFrameDecoder {
+public:
+    static constexpr size_t MAX_PAYLOAD = 64;
+    static constexpr uint8_t DATA_TYPE_ENGINEERING = 0x01;
+    static constexpr uint8_t DATA_TYPE_NORMAL = 0x02;
+
+    enum class Status : uint8_t {
+        NeedMore,
+        Frame,
+        Error
+    };
+
+    struct Stats {
+        uint64_t frames = 0;
+        uint64_t errors = 0;
+        uint64_t skippedBytes = 0;
+    };
+
+    // Consumes bytes from the front of input until a frame completes, a frame is rejected, or input runs
+    // out. On Frame the result is in out; on Error see lastError() and rejected(). input is advanced past
+    // everything consumed, so call again with the same span until it returns NeedMore.
+    Status decode(std::span<const uint8_t>& input, MmWaveFrame& out);
+
+    // Drop any partial frame, e.g. after reconnecting.
+    void reset();
+
+    MmWaveFrameError lastError() const { return error_; }
+    // Payload bytes of the last rejected frame (as much as was received). Only valid until the next decode().
+    std::span<const uint8_t> rejected() const { return { payload_.data(), received_ }; }
+    const Stats& stats() const { return stats_; }
+
+private:
+    enum class State : uint8_t {
+        Header,
+        Length,
+        Payload,
+        Tail
+    };
+
+    Status fail(MmWaveFrameError error);
+    Status finish(MmWaveFrame& out);
+
+    State state_ = State::Header;
+    size_t matched_ = 0;
+    uint16_t length_ = 0;
+    size_t received_ = 0;
+    std::array<uint8_t, MAX_PAYLOAD> payload_ {};
+    MmWaveFrameError error_ = MmWaveFrameError::None;
+    Stats stats_;
+};
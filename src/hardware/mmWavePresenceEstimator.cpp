@@ -32,10 +32,10 @@ SOFTWARE.
 */
 
 #include "mmWavePresenceEstimator.h"
-#include "mmWave.h"
+#include "mmWaveFrameDecoder.h"
 #include <algorithm>
 #include <optional>
-#include <vector>
+#include <span>
 
 namespace {
 
@@ -51,41 +51,24 @@ constexpr float MMWAVE_LOW_STATIONARY_ENERGY_ABSENT_REDUCTION = 0.10f;
 constexpr float MMWAVE_LOW_STATIONARY_ENERGY_THRESHOLD = 75.0f;
 constexpr float MMWAVE_MIN_ABSENT_THRESHOLD_MULTIPLIER = 0.5f;
 
+// Room for the longest window at ~8 frames/s before the ring has to grow.
+constexpr size_t MMWAVE_INITIAL_RING_CAPACITY = 256;
+
 struct AveragedMetric {
     std::optional<float> average;
     size_t sampleCount = 0;
 };
 
-template <typename Accessor>
-AveragedMetric averageMetric(
-    const auto& samples,
-    std::chrono::steady_clock::time_point latestTimestamp,
-    int windowSeconds,
-    Accessor accessor)
+// Sums are kept as integers so adding and removing samples is exact. Dividing once at the end gives the
+// same float the old per-update loop did (it summed floats in order, which is exact while the window total
+// stays below 2^24 - e.g. 256 samples at the sensor's maximum range) and the true mean beyond that.
+AveragedMetric averageOf(uint64_t total, size_t count)
 {
-    if (samples.empty()) {
-        return {};
-    }
-
-    const auto cutoff = latestTimestamp - std::chrono::seconds(windowSeconds);
-    float total = 0.0f;
-    size_t count = 0;
-
-    for (const auto& sample : samples) {
-        if (sample.timestamp < cutoff) {
-            continue;
-        }
-
-        total += accessor(sample);
-        ++count;
-    }
-
     if (count == 0) {
         return {};
     }
-
     return {
-        .average = total / static_cast<float>(count),
+        .average = static_cast<float>(total) / static_cast<float>(count),
         .sampleCount = count
     };
 }
@@ -129,9 +112,9 @@ void MmWavePresenceEstimator::setConfig(const MmWavePresenceConfig& config)
 {
     config_ = normalizeConfig(config);
 
-    if (!samples_.empty()) {
-        const auto latestTimestamp = samples_.back().timestamp;
-        pruneSamples(latestTimestamp);
+    if (nextSequence_ != firstSequence_) {
+        const auto latestTimestamp = sample(nextSequence_ - 1).timestamp;
+        rebuildWindows(latestTimestamp);
         recomputeDecision(latestTimestamp);
     }
 }
@@ -143,7 +126,9 @@ const MmWavePresenceConfig& MmWavePresenceEstimator::getConfig() const
 
 void MmWavePresenceEstimator::reset()
 {
-    samples_.clear();
+    firstSequence_ = 0;
+    nextSequence_ = 0;
+    windows_ = {};
     state_ = MmWavePresenceState::Unknown;
     lastDecision_ = {};
 }
@@ -152,7 +137,7 @@ MmWavePresenceDecision MmWavePresenceEstimator::update(
     const MmWaveReading& reading,
     std::chrono::steady_clock::time_point now)
 {
-    samples_.push_back({
+    const BufferedReading buffered {
         reading.targetState,
         reading.movingTargetDistance,
         reading.movingTargetEnergy,
@@ -160,8 +145,13 @@ MmWavePresenceDecision MmWavePresenceEstimator::update(
         reading.stationaryTargetEnergy,
         reading.detectionDistance,
         now
-    });
-    pruneSamples(now);
+    };
+    pushSample(buffered);
+    for (size_t metric = 0; metric < MetricCount; ++metric) {
+        windows_[metric].total += metricValue(buffered, metric);
+        ++windows_[metric].count;
+    }
+    slideWindows(now);
     recomputeDecision(now);
     return lastDecision_;
 }
@@ -186,70 +176,115 @@ int MmWavePresenceEstimator::clampWindowSeconds(int value)
     return std::clamp(value, MMWAVE_MIN_AVERAGE_WINDOW_SECS, MMWAVE_MAX_AVERAGE_WINDOW_SECS);
 }
 
-void MmWavePresenceEstimator::pruneSamples(std::chrono::steady_clock::time_point latestTimestamp)
+uint32_t MmWavePresenceEstimator::metricValue(const BufferedReading& reading, size_t metric)
 {
-    if (samples_.empty()) {
-        return;
+    switch (metric) {
+    case DetectionDistance:
+        return reading.detectionDistance;
+    case MovingDistance:
+        return reading.movingTargetDistance;
+    case StationaryDistance:
+        return reading.stationaryTargetDistance;
+    case StationaryEnergy:
+    default:
+        return reading.stationaryTargetEnergy;
     }
+}
 
-    const auto cutoff = latestTimestamp - std::chrono::seconds(maxAverageWindowSeconds());
-    while (!samples_.empty() && samples_.front().timestamp < cutoff) {
-        samples_.pop_front();
+int MmWavePresenceEstimator::windowSeconds(size_t metric) const
+{
+    switch (metric) {
+    case DetectionDistance:
+        return clampWindowSeconds(config_.detectionDistanceAverageWindowSecs);
+    case MovingDistance:
+        return clampWindowSeconds(config_.movingDistanceAverageWindowSecs);
+    case StationaryDistance:
+        return clampWindowSeconds(config_.stationaryDistanceAverageWindowSecs);
+    case StationaryEnergy:
+    default:
+        return clampWindowSeconds(config_.stationaryEnergyAverageWindowSecs);
     }
 }
 
+const MmWavePresenceEstimator::BufferedReading& MmWavePresenceEstimator::sample(uint64_t sequence) const
+{
+    return ring_[sequence & (ring_.size() - 1)];
+}
+
+void MmWavePresenceEstimator::pushSample(const BufferedReading& reading)
+{
+    if (ring_.empty()) {
+        ring_.resize(MMWAVE_INITIAL_RING_CAPACITY);
+    } else if (nextSequence_ - firstSequence_ == ring_.size()) {
+        std::vector<BufferedReading> grown(ring_.size() * 2);
+        for (uint64_t sequence = firstSequence_; sequence < nextSequence_; ++sequence) {
+            grown[sequence & (grown.size() - 1)] = sample(sequence);
+        }
+        ring_.swap(grown);
+    }
+    ring_[nextSequence_ & (ring_.size() - 1)] = reading;
+    ++nextSequence_;
+}
+
+void MmWavePresenceEstimator::slideWindows(std::chrono::steady_clock::time_point latestTimestamp)
+{
+    uint64_t oldestNeeded = nextSequence_;
+    for (size_t metric = 0; metric < MetricCount; ++metric) {
+        WindowSum& window = windows_[metric];
+        const auto cutoff = latestTimestamp - std::chrono::seconds(windowSeconds(metric));
+        while (window.first < nextSequence_ && sample(window.first).timestamp < cutoff) {
+            window.total -= metricValue(sample(window.first), metric);
+            --window.count;
+            ++window.first;
+        }
+        oldestNeeded = std::min(oldestNeeded, window.first);
+    }
+    firstSequence_ = oldestNeeded;
+}
+
+// Window lengths changed: start every window over from the oldest retained sample. Samples that already
+// fell out of the longest old window are gone, as before.
+void MmWavePresenceEstimator::rebuildWindows(std::chrono::steady_clock::time_point latestTimestamp)
+{
+    for (size_t metric = 0; metric < MetricCount; ++metric) {
+        WindowSum& window = windows_[metric];
+        window = { .first = firstSequence_ };
+        for (uint64_t sequence = firstSequence_; sequence < nextSequence_; ++sequence) {
+            window.total += metricValue(sample(sequence), metric);
+            ++window.count;
+        }
+    }
+    slideWindows(latestTimestamp);
+}
+
 void MmWavePresenceEstimator::recomputeDecision(std::chrono::steady_clock::time_point latestTimestamp)
 {
     MmWavePresenceDecision nextDecision;
     nextDecision.state = state_;
     nextDecision.timestamp = latestTimestamp;
 
-    if (samples_.empty()) {
+    if (nextSequence_ == firstSequence_) {
         lastDecision_ = nextDecision;
         return;
     }
 
-    const BufferedReading& latestReading = samples_.back();
+    const BufferedReading& latestReading = sample(nextSequence_ - 1);
     const uint8_t latestTargetState = latestReading.targetState & 0x03u;
     nextDecision.latestTargetState = latestTargetState;
 
-    const AveragedMetric detectionDistanceAverage = averageMetric(
-        samples_,
-        latestTimestamp,
-        config_.detectionDistanceAverageWindowSecs,
-        [](const BufferedReading& reading) {
-            return static_cast<float>(reading.detectionDistance);
-        });
+    const AveragedMetric detectionDistanceAverage = averageOf(windows_[DetectionDistance].total, windows_[DetectionDistance].count);
     nextDecision.detectionDistanceAverageCm = detectionDistanceAverage.average;
     nextDecision.detectionDistanceAverageSampleCount = detectionDistanceAverage.sampleCount;
 
-    const AveragedMetric movingTargetDistanceAverage = averageMetric(
-        samples_,
-        latestTimestamp,
-        config_.movingDistanceAverageWindowSecs,
-        [](const BufferedReading& reading) {
-            return static_cast<float>(reading.movingTargetDistance);
-        });
+    const AveragedMetric movingTargetDistanceAverage = averageOf(windows_[MovingDistance].total, windows_[MovingDistance].count);
     nextDecision.movingTargetDistanceAverageCm = movingTargetDistanceAverage.average;
     nextDecision.movingTargetDistanceAverageSampleCount = movingTargetDistanceAverage.sampleCount;
 
-    const AveragedMetric stationaryTargetDistanceAverage = averageMetric(
-        samples_,
-        latestTimestamp,
-        config_.stationaryDistanceAverageWindowSecs,
-        [](const BufferedReading& reading) {
-            return static_cast<float>(reading.stationaryTargetDistance);
-        });
+    const AveragedMetric stationaryTargetDistanceAverage = averageOf(windows_[StationaryDistance].total, windows_[StationaryDistance].count);
     nextDecision.stationaryTargetDistanceAverageCm = stationaryTargetDistanceAverage.average;
     nextDecision.stationaryTargetDistanceAverageSampleCount = stationaryTargetDistanceAverage.sampleCount;
 
-    const AveragedMetric stationaryTargetEnergyAverage = averageMetric(
-        samples_,
-        latestTimestamp,
-        config_.stationaryEnergyAverageWindowSecs,
-        [](const BufferedReading& reading) {
-            return static_cast<float>(reading.stationaryTargetEnergy);
-        });
+    const AveragedMetric stationaryTargetEnergyAverage = averageOf(windows_[StationaryEnergy].total, windows_[StationaryEnergy].count);
     nextDecision.stationaryTargetEnergyAverage = stationaryTargetEnergyAverage.average;
     nextDecision.stationaryTargetEnergyAverageSampleCount = stationaryTargetEnergyAverage.sampleCount;
 
@@ -267,29 +302,30 @@ void MmWavePresenceEstimator::recomputeDecision(std::chrono::steady_clock::time_
     nextDecision.absentMovingDistanceThresholdCm = MMWAVE_BASE_ABSENT_MOVING_DISTANCE_CM * multiplier;
     nextDecision.absentStationaryDistanceThresholdCm = MMWAVE_BASE_ABSENT_STATIONARY_DISTANCE_CM * multiplier;
 
-    std::vector<MetricComparison> activeMetrics;
-    activeMetrics.reserve(3);
-    activeMetrics.push_back({
+    std::array<MetricComparison, 3> metrics;
+    size_t activeCount = 0;
+    metrics[activeCount++] = {
         nextDecision.detectionDistanceAverageCm,
         nextDecision.absentDetectionDistanceThresholdCm,
         MMWAVE_PRESENT_DISTANCE_CM
-    });
+    };
 
     if (latestTargetState == 1u || latestTargetState == 3u) {
-        activeMetrics.push_back({
+        metrics[activeCount++] = {
             nextDecision.movingTargetDistanceAverageCm,
             nextDecision.absentMovingDistanceThresholdCm,
             MMWAVE_PRESENT_DISTANCE_CM
-        });
+        };
     }
 
     if (latestTargetState == 2u || latestTargetState == 3u) {
-        activeMetrics.push_back({
+        metrics[activeCount++] = {
             nextDecision.stationaryTargetDistanceAverageCm,
             nextDecision.absentStationaryDistanceThresholdCm,
             MMWAVE_PRESENT_DISTANCE_CM
-        });
+        };
     }
+    const auto activeMetrics = std::span<const MetricComparison>(metrics.data(), activeCount);
 
     const bool hasAllAverages = std::all_of(
         activeMetrics.begin(),
@@ -319,13 +355,3 @@ void MmWavePresenceEstimator::recomputeDecision(std::chrono::steady_clock::time_
     nextDecision.state = state_;
     lastDecision_ = nextDecision;
 }
-
-int MmWavePresenceEstimator::maxAverageWindowSeconds() const
-{
-    return std::max({
-        clampWindowSeconds(config_.detectionDistanceAverageWindowSecs),
-        clampWindowSeconds(config_.movingDistanceAverageWindowSecs),
-        clampWindowSeconds(config_.stationaryDistanceAverageWindowSecs),
-        clampWindowSeconds(config_.stationaryEnergyAverageWindowSecs)
-    });
-}
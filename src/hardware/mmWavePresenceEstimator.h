@@ -33,14 +33,23 @@ SOFTWARE.
 
 #pragma once
 
+#include <array>
 #include <chrono>
 #include <cstddef>
 #include <cstdint>
-#include <deque>
 #include <optional>
+#include <vector>
 
 struct MmWaveReading;
 
+/*
+Rolling-window presence classifier. Each averaged metric has its own window; every window keeps a running
+integer sum and count over the shared sample ring and slides forward as samples age out, so update() costs
+O(number of windows) however long the windows are. Timestamps passed to update() must be non-decreasing
+(steady_clock). The ring only holds samples inside the longest window and grows by doubling when a higher
+frame rate needs more room, then stays that size.
+*/
+
 struct MmWavePresenceConfig {
     int detectionDistanceAverageWindowSecs = 10;
     int movingDistanceAverageWindowSecs = 10;
@@ -96,14 +105,37 @@ private:
         std::chrono::steady_clock::time_point timestamp {};
     };
 
+    enum Metric : size_t {
+        DetectionDistance = 0,
+        MovingDistance,
+        StationaryDistance,
+        StationaryEnergy,
+        MetricCount
+    };
+
+    // Samples [first, nextSequence_) are inside the window.
+    struct WindowSum {
+        uint64_t first = 0;
+        uint64_t total = 0;
+        size_t count = 0;
+    };
+
     static int clampWindowSeconds(int value);
+    static uint32_t metricValue(const BufferedReading& reading, size_t metric);
 
-    void pruneSamples(std::chrono::steady_clock::time_point latestTimestamp);
+    int windowSeconds(size_t metric) const;
+    const BufferedReading& sample(uint64_t sequence) const;
+    void pushSample(const BufferedReading& reading);
+    void slideWindows(std::chrono::steady_clock::time_point latestTimestamp);
+    void rebuildWindows(std::chrono::steady_clock::time_point latestTimestamp);
     void recomputeDecision(std::chrono::steady_clock::time_point latestTimestamp);
-    int maxAverageWindowSeconds() const;
 
     MmWavePresenceConfig config_ {};
-    std::deque<BufferedReading> samples_;
+    // Indexed by sequence number modulo its (power of two) size.
+    std::vector<BufferedReading> ring_;
+    uint64_t firstSequence_ = 0;
+    uint64_t nextSequence_ = 0;
+    std::array<WindowSum, MetricCount> windows_ {};
     MmWavePresenceState state_ = MmWavePresenceState::Unknown;
     MmWavePresenceDecision lastDecision_ {};
 };
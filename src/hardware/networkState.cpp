@@ -0,0 +1,508 @@
+/*
+███╗   ██╗███████╗████████╗██╗    ██╗ ██████╗ ██████╗ ██╗  ██╗███████╗████████╗ █████╗ ████████╗███████╗    ██████╗██████╗ ██████╗
+████╗  ██║██╔════╝╚══██╔══╝██║    ██║██╔═══██╗██╔══██╗██║ ██╔╝██╔════╝╚══██╔══╝██╔══██╗╚══██╔══╝██╔════╝   ██╔════╝██╔══██╗██╔══██╗
+██╔██╗ ██║█████╗     ██║   ██║ █╗ ██║██║   ██║██████╔╝█████╔╝ ███████╗   ██║   ███████║   ██║   █████╗     ██║     ██████╔╝██████╔╝
+██║╚██╗██║██╔══╝     ██║   ██║███╗██║██║   ██║██╔══██╗██╔═██╗ ╚════██║   ██║   ██╔══██║   ██║   ██╔══╝     ██║     ██╔═══╝ ██╔═══╝
+██║ ╚████║███████╗   ██║   ╚███╔███╔╝╚██████╔╝██║  ██║██║  ██╗███████║   ██║   ██║  ██║   ██║   ███████╗██╗╚██████╗██║     ██║
+╚═╝  ╚═══╝╚══════╝   ╚═╝    ╚══╝╚══╝  ╚═════╝ ╚═╝  ╚═╝╚═╝  ╚═╝╚══════╝   ╚═╝   ╚═╝  ╚═╝   ╚═╝   ╚══════╝╚═╝ ╚═════╝╚═╝     ╚═╝
+*/
+
+/*
+MIT License
+
+Copyright (c) 2026 A-McD Technology LLC
+*/
+
+
+#include "networkState.h"
+
+#include <logger.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cstdlib>
+#include <optional>
+
+namespace {
+
+constexpr auto kMonitorIdleSlice = std::chrono::milliseconds(250);
+// A burst that keeps arriving (e.g. a long association) is still applied at least this often.
+constexpr auto kMaxEventDebounce = std::chrono::milliseconds(1000);
+
+const std::vector<std::string> kAccessPointFields { "IN-USE", "SSID", "BSSID", "SIGNAL", "SECURITY", "FREQ", "CHAN", "RATE" };
+
+std::string trimmed(const std::string& value)
+{
+    const size_t start = value.find_first_not_of(" \t\r\n");
+    if (start == std::string::npos) {
+        return "";
+    }
+    const size_t end = value.find_last_not_of(" \t\r\n");
+    return value.substr(start, end - start + 1);
+}
+
+std::string lowercase(std::string value)
+{
+    std::transform(value.begin(), value.end(), value.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return value;
+}
+
+// nmcli prints "--" for an empty value.
+std::string valueOrEmpty(const std::string& value)
+{
+    return value == "--" ? "" : value;
+}
+
+std::vector<std::string> nonEmptyLines(const std::string& text)
+{
+    std::vector<std::string> lines;
+    size_t start = 0;
+    while (start < text.size()) {
+        size_t end = text.find('\n', start);
+        if (end == std::string::npos) {
+            end = text.size();
+        }
+        std::string line = text.substr(start, end - start);
+        if (!line.empty() && line.back() == '\r') {
+            line.pop_back();
+        }
+        if (!line.empty()) {
+            lines.push_back(std::move(line));
+        }
+        start = end + 1;
+    }
+    return lines;
+}
+
+// Terse (-t) output separates fields with ':' and escapes ':' and '\' inside values with '\'.
+std::vector<std::string> splitTerse(const std::string& line)
+{
+    std::vector<std::string> fields(1);
+    for (size_t index = 0; index < line.size(); ++index) {
+        if (line[index] == '\\' && index + 1 < line.size()) {
+            fields.back() += line[++index];
+        } else if (line[index] == ':') {
+            fields.emplace_back();
+        } else {
+            fields.back() += line[index];
+        }
+    }
+    return fields;
+}
+
+std::string joinFields(const std::vector<std::string>& fields)
+{
+    std::string joined;
+    for (const auto& field : fields) {
+        joined += (joined.empty() ? "" : ",") + field;
+    }
+    return joined;
+}
+
+std::vector<std::string> accessPointListCommand(bool rescan)
+{
+    return { "nmcli", "-t", "-f", joinFields(kAccessPointFields), "device", "wifi", "list", "--rescan", rescan ? "yes" : "no" };
+}
+
+std::vector<WifiInfo> parseAccessPoints(const std::string& output)
+{
+    std::vector<WifiInfo> accessPoints;
+    for (const auto& line : nonEmptyLines(output)) {
+        const auto fields = splitTerse(line);
+        if (fields.size() < kAccessPointFields.size()) {
+            continue;
+        }
+        WifiInfo accessPoint;
+        accessPoint.connected = trimmed(fields[0]) == "*";
+        accessPoint.ssid = valueOrEmpty(fields[1]);
+        accessPoint.mac = fields[2];
+        accessPoint.signalStrength = fields[3];
+        accessPoint.securityType = valueOrEmpty(fields[4]);
+        accessPoint.frequency = fields[5];
+        accessPoint.channel = fields[6];
+        accessPoint.bitrate = fields[7];
+        accessPoints.push_back(std::move(accessPoint));
+    }
+    return accessPoints;
+}
+
+std::vector<NetworkDeviceState> parseDevices(const std::string& output)
+{
+    std::vector<NetworkDeviceState> devices;
+    for (const auto& line : nonEmptyLines(output)) {
+        const auto fields = splitTerse(line);
+        if (fields.size() < 4) {
+            continue;
+        }
+        devices.push_back({ fields[0], fields[1], fields[2], valueOrEmpty(fields[3]) });
+    }
+    return devices;
+}
+
+std::string wifiDeviceName(const std::vector<NetworkDeviceState>& devices)
+{
+    const auto wifi = std::find_if(devices.begin(), devices.end(), [](const NetworkDeviceState& device) {
+        return device.type == "wifi";
+    });
+    return wifi == devices.end() ? "" : wifi->name;
+}
+
+struct DeviceAddressing {
+    std::string hardwareAddress;
+    IP_Address ip;
+    CIDR_Subnet subnet;
+    IP_Address gateway;
+    std::vector<IP_Address> dns;
+    IP_Address dhcp;
+    unsigned long dhcpLease = 0;
+};
+
+// `nmcli -t device show` prints one "KEY[n]:value" per line; DHCP options read "name = value".
+DeviceAddressing parseDeviceShow(const std::string& output)
+{
+    DeviceAddressing addressing;
+    for (const auto& line : nonEmptyLines(output)) {
+        const size_t colon = line.find(':');
+        if (colon == std::string::npos) {
+            continue;
+        }
+        const std::string key = line.substr(0, colon);
+        const auto valueFields = splitTerse(line.substr(colon + 1));
+        std::string value = valueFields[0];
+        for (size_t index = 1; index < valueFields.size(); ++index) {
+            value += ":" + valueFields[index];
+        }
+        value = valueOrEmpty(trimmed(value));
+
+        if (key == "GENERAL.HWADDR") {
+            addressing.hardwareAddress = value;
+        } else if (key.starts_with("IP4.ADDRESS") && addressing.ip.ip.empty()) {
+            const size_t slash = value.find('/');
+            addressing.ip = IP_Address(value.substr(0, slash));
+            if (slash != std::string::npos) {
+                addressing.subnet = CIDR_Subnet(static_cast<uint8_t>(std::strtoul(value.c_str() + slash + 1, nullptr, 10)));
+            }
+        } else if (key == "IP4.GATEWAY") {
+            addressing.gateway = IP_Address(value);
+        } else if (key.starts_with("IP4.DNS") && !value.empty()) {
+            addressing.dns.emplace_back(value);
+        } else if (key.starts_with("DHCP4.OPTION")) {
+            const size_t equals = value.find(" = ");
+            if (equals == std::string::npos) {
+                continue;
+            }
+            const std::string option = value.substr(0, equals);
+            const std::string optionValue = value.substr(equals + 3);
+            if (option == "dhcp_server_identifier") {
+                addressing.dhcp = IP_Address(optionValue);
+            } else if (option == "lease_time") {
+                addressing.dhcpLease = std::strtoul(optionValue.c_str(), nullptr, 10);
+            }
+        }
+    }
+    return addressing;
+}
+
+void applyAccessPoints(NetworkStateSnapshot& state, std::vector<WifiInfo> accessPoints)
+{
+    const auto inUse = std::find_if(accessPoints.begin(), accessPoints.end(), [](const WifiInfo& accessPoint) {
+        return accessPoint.connected;
+    });
+    WifiInfo& active = state.active;
+    const WifiInfo source = inUse == accessPoints.end() ? WifiInfo() : *inUse;
+    active.ssid = source.ssid;
+    active.mac = source.mac;
+    active.signalStrength = source.signalStrength;
+    active.securityType = source.securityType;
+    active.frequency = source.frequency;
+    active.channel = source.channel;
+    active.bitrate = source.bitrate;
+    state.accessPoints = std::move(accessPoints);
+}
+
+void applyAddressing(NetworkStateSnapshot& state, const DeviceAddressing& addressing)
+{
+    WifiInfo& active = state.active;
+    state.localMac = addressing.hardwareAddress;
+    active.ip = addressing.ip;
+    active.subnet = addressing.subnet;
+    active.gateway = addressing.gateway;
+    active.dns1 = addressing.dns.size() > 0 ? addressing.dns[0] : IP_Address();
+    active.dns2 = addressing.dns.size() > 1 ? addressing.dns[1] : IP_Address();
+    active.dns3 = addressing.dns.size() > 2 ? addressing.dns[2] : IP_Address();
+    active.dhcp = addressing.dhcp;
+    active.dhcpLease = addressing.dhcpLease;
+}
+
+} // namespace
+
+NetworkStateService::NetworkStateService(
+    std::shared_ptr<ICommandRunner> runner,
+    NetworkStateOptions options,
+    MonotonicNowReader monotonicNowReader)
+    : runner_(runner ? std::move(runner) : std::make_shared<SystemCommandRunner>())
+    , options_(options)
+    , monotonicNowReader_(monotonicNowReader ? std::move(monotonicNowReader) : MonotonicNowReader([]() {
+        return std::chrono::steady_clock::now();
+    }))
+    , state_(std::make_shared<const NetworkStateSnapshot>())
+{
+}
+
+NetworkStateService::~NetworkStateService()
+{
+    stop();
+}
+
+void NetworkStateService::start()
+{
+    std::lock_guard<std::mutex> lock(lifecycleMutex_);
+    if (started_) {
+        return;
+    }
+    started_ = true;
+    refresh(NETWORK_REFRESH_ALL);
+    monitorThread_ = std::jthread([this](std::stop_token stopToken) {
+        monitorLoop(stopToken);
+    });
+}
+
+void NetworkStateService::stop()
+{
+    std::lock_guard<std::mutex> lock(lifecycleMutex_);
+    if (monitorThread_.joinable()) {
+        monitorThread_.request_stop();
+        monitorThread_.join();
+    }
+    started_ = false;
+}
+
+std::shared_ptr<const NetworkStateSnapshot> NetworkStateService::snapshot() const
+{
+    std::lock_guard<std::mutex> lock(stateMutex_);
+    return state_;
+}
+
+std::shared_ptr<const NetworkStateSnapshot> NetworkStateService::waitForChange(uint64_t generation, std::chrono::milliseconds timeout) const
+{
+    std::unique_lock<std::mutex> lock(stateMutex_);
+    stateChanged_.wait_for(lock, timeout, [this, generation]() {
+        return state_->generation > generation;
+    });
+    return state_;
+}
+
+bool NetworkStateService::scan(bool force)
+{
+    std::unique_lock<std::mutex> lock(scanMutex_);
+    if (scanInFlight_) {
+        scanFinished_.wait(lock, [this]() { return !scanInFlight_; });
+        return lastScanSucceeded_;
+    }
+    const auto lastScan = snapshot()->lastScan;
+    if (!force && lastScan != std::chrono::steady_clock::time_point {} && now() - lastScan < options_.minScanInterval) {
+        return true;
+    }
+    scanInFlight_ = true;
+    lock.unlock();
+
+    const CommandResult result = runCommand(accessPointListCommand(true));
+    const bool succeeded = result.exitCode == 0;
+    if (succeeded) {
+        auto accessPoints = parseAccessPoints(result.output);
+        const auto scannedAt = now();
+        publish([&](NetworkStateSnapshot& state) {
+            applyAccessPoints(state, std::move(accessPoints));
+            state.lastScan = scannedAt;
+        });
+    } else {
+        CubeLog::warning("NetworkStateService: wifi scan failed: " + trimmed(result.output));
+    }
+
+    lock.lock();
+    scanInFlight_ = false;
+    lastScanSucceeded_ = succeeded;
+    scanFinished_.notify_all();
+    return succeeded;
+}
+
+void NetworkStateService::refresh(unsigned parts)
+{
+    std::lock_guard<std::mutex> lock(refreshMutex_);
+    std::optional<bool> radioEnabled;
+    std::optional<std::vector<NetworkDeviceState>> devices;
+    std::optional<DeviceAddressing> addressing;
+    std::optional<std::vector<WifiInfo>> accessPoints;
+
+    if (parts & NETWORK_REFRESH_RADIO) {
+        const auto result = runCommand({ "nmcli", "-t", "radio", "wifi" });
+        if (result.exitCode == 0) {
+            radioEnabled = trimmed(result.output) == "enabled";
+        }
+    }
+    if (parts & NETWORK_REFRESH_DEVICES) {
+        const auto result = runCommand({ "nmcli", "-t", "-f", "DEVICE,TYPE,STATE,CONNECTION", "device", "status" });
+        if (result.exitCode == 0) {
+            devices = parseDevices(result.output);
+        }
+    }
+    const std::string wifiDevice = devices ? wifiDeviceName(*devices) : snapshot()->wifiDevice;
+    if ((parts & NETWORK_REFRESH_ADDRESSES) && !wifiDevice.empty()) {
+        const auto result = runCommand({ "nmcli", "-t", "-f", "GENERAL.HWADDR,IP4.ADDRESS,IP4.GATEWAY,IP4.DNS,DHCP4.OPTION", "device", "show", wifiDevice });
+        if (result.exitCode == 0) {
+            addressing = parseDeviceShow(result.output);
+        }
+    }
+    if (parts & NETWORK_REFRESH_ACCESS_POINTS) {
+        const auto result = runCommand(accessPointListCommand(false));
+        lastAccessPointRead_ = now();
+        if (result.exitCode == 0) {
+            accessPoints = parseAccessPoints(result.output);
+        }
+    }
+
+    publish([&](NetworkStateSnapshot& state) {
+        if (radioEnabled) {
+            state.radioEnabled = *radioEnabled;
+        }
+        if (devices) {
+            state.devices = std::move(*devices);
+            state.wifiDevice = wifiDevice;
+            const auto wifi = std::find_if(state.devices.begin(), state.devices.end(), [&wifiDevice](const NetworkDeviceState& device) {
+                return device.name == wifiDevice;
+            });
+            state.connected = wifi != state.devices.end() && wifi->state == "connected";
+            state.active.connected = state.connected;
+        }
+        if (addressing) {
+            applyAddressing(state, *addressing);
+        }
+        if (accessPoints) {
+            applyAccessPoints(state, std::move(*accessPoints));
+        }
+    });
+}
+
+CommandResult NetworkStateService::run(const std::vector<std::string>& command, unsigned parts)
+{
+    CommandResult result = runCommand(command);
+    if (parts != 0) {
+        refresh(parts);
+    }
+    return result;
+}
+
+uint64_t NetworkStateService::commandsStarted() const
+{
+    return commandsStarted_.load();
+}
+
+void NetworkStateService::monitorLoop(std::stop_token stopToken)
+{
+    std::mutex sleepMutex;
+    std::condition_variable_any sleepCondition;
+    auto sleepFor = [&](std::chrono::milliseconds delay) {
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        sleepCondition.wait_for(lock, stopToken, delay, []() { return false; });
+    };
+    auto accessPointsDue = [this]() {
+        std::lock_guard<std::mutex> lock(refreshMutex_);
+        return now() - lastAccessPointRead_ >= options_.accessPointRefreshInterval;
+    };
+
+    while (!stopToken.stop_requested()) {
+        commandsStarted_++;
+        auto monitor = runner_->stream({ "nmcli", "monitor" });
+        if (!monitor) {
+            CubeLog::warning("NetworkStateService: could not start nmcli monitor, re-reading network state on a timer.");
+            sleepFor(options_.monitorRetryDelay);
+            refresh(NETWORK_REFRESH_ALL);
+            continue;
+        }
+
+        unsigned dirty = 0;
+        auto dirtySince = std::chrono::steady_clock::time_point {};
+        while (!stopToken.stop_requested()) {
+            std::string line;
+            const auto read = monitor->readLine(line, dirty ? options_.eventDebounce : kMonitorIdleSlice);
+            if (read == CommandStreamRead::Closed) {
+                break;
+            }
+            if (read == CommandStreamRead::Line) {
+                CubeLog::debugSilly("NetworkStateService: " + line);
+                if (dirty == 0) {
+                    dirtySince = std::chrono::steady_clock::now();
+                }
+                dirty |= partsForEvent(line);
+                if (dirty == 0 || std::chrono::steady_clock::now() - dirtySince < kMaxEventDebounce) {
+                    continue;
+                }
+            }
+            if (dirty != 0) {
+                refresh(dirty);
+                dirty = 0;
+            } else if (accessPointsDue()) {
+                refresh(NETWORK_REFRESH_ACCESS_POINTS);
+            }
+        }
+
+        if (!stopToken.stop_requested()) {
+            CubeLog::warning("NetworkStateService: nmcli monitor exited, restarting.");
+            sleepFor(options_.monitorRetryDelay);
+            // Anything that changed while the monitor was down was missed.
+            refresh(NETWORK_REFRESH_ALL);
+        }
+    }
+}
+
+unsigned NetworkStateService::partsForEvent(const std::string& line) const
+{
+    const std::string lower = lowercase(line);
+    const bool aboutRadio = lower.find("wi-fi") != std::string::npos || lower.find("wifi") != std::string::npos
+        || lower.find("wireless") != std::string::npos;
+    if (aboutRadio && (lower.find("enabled") != std::string::npos || lower.find("disabled") != std::string::npos)) {
+        return NETWORK_REFRESH_RADIO | NETWORK_REFRESH_DEVICES | NETWORK_REFRESH_ACCESS_POINTS;
+    }
+    if (lower.find("primary connection") != std::string::npos) {
+        return NETWORK_REFRESH_DEVICES | NETWORK_REFRESH_ADDRESSES;
+    }
+
+    // Device events read "<device>: <event>"; overall state and connectivity lines repeat what those say.
+    const size_t separator = line.find(": ");
+    if (separator == std::string::npos) {
+        return 0;
+    }
+    const std::string device = line.substr(0, separator);
+    const std::string event = lower.substr(separator + 2);
+    if (event.starts_with("device created") || event.starts_with("device removed")) {
+        return NETWORK_REFRESH_DEVICES | NETWORK_REFRESH_ADDRESSES | NETWORK_REFRESH_ACCESS_POINTS;
+    }
+    if (device != snapshot()->wifiDevice) {
+        return NETWORK_REFRESH_DEVICES;
+    }
+    if (event.starts_with("connecting") || event.starts_with("deactivating")) {
+        return NETWORK_REFRESH_DEVICES;
+    }
+    return NETWORK_REFRESH_DEVICES | NETWORK_REFRESH_ADDRESSES | NETWORK_REFRESH_ACCESS_POINTS;
+}
+
+CommandResult NetworkStateService::runCommand(const std::vector<std::string>& command)
+{
+    commandsStarted_++;
+    return runner_->run(command);
+}
+
+void NetworkStateService::publish(const std::function<void(NetworkStateSnapshot&)>& update)
+{
+    std::lock_guard<std::mutex> lock(stateMutex_);
+    auto next = std::make_shared<NetworkStateSnapshot>(*state_);
+    update(*next);
+    next->generation = state_->generation + 1;
+    state_ = std::move(next);
+    stateChanged_.notify_all();
+}
+
+std::chrono::steady_clock::time_point NetworkStateService::now() const
+{
+    return monotonicNowReader_();
+}
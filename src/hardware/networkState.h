@@ -0,0 +1,135 @@
+/*
+███╗   ██╗███████╗████████╗██╗    ██╗ ██████╗ ██████╗ ██╗  ██╗███████╗████████╗ █████╗ ████████╗███████╗   ██╗  ██╗
+████╗  ██║██╔════╝╚══██╔══╝██║    ██║██╔═══██╗██╔══██╗██║ ██╔╝██╔════╝╚══██╔══╝██╔══██╗╚══██╔══╝██╔════╝   ██║  ██║
+██╔██╗ ██║█████╗     ██║   ██║ █╗ ██║██║   ██║██████╔╝█████╔╝ ███████╗   ██║   ███████║   ██║   █████╗     ███████║
+██║╚██╗██║██╔══╝     ██║   ██║███╗██║██║   ██║██╔══██╗██╔═██╗ ╚════██║   ██║   ██╔══██║   ██║   ██╔══╝     ██╔══██║
+██║ ╚████║███████╗   ██║   ╚███╔███╔╝╚██████╔╝██║  ██║██║  ██╗███████║   ██║   ██║  ██║   ██║   ███████╗██╗██║  ██║
+╚═╝  ╚═══╝╚══════╝   ╚═╝    ╚══╝╚══╝  ╚═════╝ ╚═╝  ╚═╝╚═╝  ╚═╝╚══════╝   ╚═╝   ╚═╝  ╚═╝   ╚═╝   ╚══════╝╚═╝╚═╝  ╚═╝
+*/
+
+/*
+MIT License
+
+Copyright (c) 2026 A-McD Technology LLC
+*/
+
+
+#pragma once
+#ifndef NETWORKSTATE_H
+#define NETWORKSTATE_H
+
+#include "../commandRunner.h"
+#include "wifi.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct NetworkDeviceState {
+    std::string name;
+    std::string type;
+    std::string state;
+    std::string connection;
+};
+
+struct NetworkStateSnapshot {
+    uint64_t generation = 0;
+    bool radioEnabled = false;
+    std::vector<NetworkDeviceState> devices;
+    std::string wifiDevice;
+    std::string localMac;
+    bool connected = false;
+    // Access point fields come from the in-use row of the AP list, addressing from `device show`.
+    WifiInfo active;
+    std::vector<WifiInfo> accessPoints;
+    std::chrono::steady_clock::time_point lastScan {};
+};
+
+enum NetworkRefresh : unsigned {
+    NETWORK_REFRESH_RADIO = 1u << 0,
+    NETWORK_REFRESH_DEVICES = 1u << 1,
+    NETWORK_REFRESH_ADDRESSES = 1u << 2,
+    NETWORK_REFRESH_ACCESS_POINTS = 1u << 3,
+    NETWORK_REFRESH_ALL = 0xFu,
+};
+
+struct NetworkStateOptions {
+    // Rescans requested sooner than this after the last one return the cached list.
+    std::chrono::milliseconds minScanInterval { 10000 };
+    // nmcli monitor does not report signal changes, so the AP list (without a rescan) is re-read this often.
+    std::chrono::milliseconds accessPointRefreshInterval { 60000 };
+    // Events arriving within this window of each other are applied with one refresh.
+    std::chrono::milliseconds eventDebounce { 150 };
+    std::chrono::milliseconds monitorRetryDelay { 5000 };
+};
+
+/**
+ * @brief In-memory model of NetworkManager state, kept current by one long-lived `nmcli monitor`.
+ *
+ * Queries read the published snapshot and never start a process. Monitor events mark parts of the
+ * model dirty and each part is re-read with a single terse nmcli command once the burst settles.
+ */
+class NetworkStateService {
+public:
+    using MonotonicNowReader = std::function<std::chrono::steady_clock::time_point()>;
+
+    explicit NetworkStateService(
+        std::shared_ptr<ICommandRunner> runner = std::make_shared<SystemCommandRunner>(),
+        NetworkStateOptions options = {},
+        MonotonicNowReader monotonicNowReader = {});
+    ~NetworkStateService();
+
+    // Reads the full state once, then follows the monitor on a background thread. Safe to call again.
+    void start();
+    void stop();
+
+    std::shared_ptr<const NetworkStateSnapshot> snapshot() const;
+    // Returns once the generation is past `generation` or the timeout expires, whichever is first.
+    std::shared_ptr<const NetworkStateSnapshot> waitForChange(uint64_t generation, std::chrono::milliseconds timeout) const;
+
+    // Callers that arrive while a scan is running wait for it instead of starting another.
+    bool scan(bool force = false);
+    void refresh(unsigned parts = NETWORK_REFRESH_ALL);
+    // Runs a command that changes NetworkManager state, then re-reads `parts`.
+    CommandResult run(const std::vector<std::string>& command, unsigned parts);
+
+    uint64_t commandsStarted() const;
+
+private:
+    void monitorLoop(std::stop_token stopToken);
+    unsigned partsForEvent(const std::string& line) const;
+    CommandResult runCommand(const std::vector<std::string>& command);
+    void publish(const std::function<void(NetworkStateSnapshot&)>& update);
+    std::chrono::steady_clock::time_point now() const;
+
+    std::shared_ptr<ICommandRunner> runner_;
+    NetworkStateOptions options_;
+    MonotonicNowReader monotonicNowReader_;
+    std::atomic<uint64_t> commandsStarted_ { 0 };
+
+    mutable std::mutex stateMutex_;
+    mutable std::condition_variable stateChanged_;
+    std::shared_ptr<const NetworkStateSnapshot> state_;
+
+    std::mutex refreshMutex_;
+    std::chrono::steady_clock::time_point lastAccessPointRead_ {};
+
+    std::mutex scanMutex_;
+    std::condition_variable scanFinished_;
+    bool scanInFlight_ = false;
+    bool lastScanSucceeded_ = false;
+
+    std::mutex lifecycleMutex_;
+    bool started_ = false;
+    std::jthread monitorThread_;
+};
+
+#endif // NETWORKSTATE_H
@@ -48,6 +48,10 @@ constexpr int kDefaultInteractionTapDebounceMs = 120;
 constexpr int kDefaultInteractionLiftConfirmMs = 150;
 constexpr int kDefaultInteractionRestStableMs = 500;
 constexpr int kDefaultInteractionLiftDeltaThresholdMg = 200;
+// Fan control shares wakeups with other housekeeping tasks; a quarter second is nothing next to the heatsink's time constant.
+constexpr auto kThermalControlJitterBudget = std::chrono::milliseconds(250);
+// Only matters when an edge is missed; the FIFO watermark interrupt normally wakes the loop long before this.
+constexpr auto kInteractionInterruptBackstop = std::chrono::milliseconds(1000);
 constexpr float kRestMagnitudeToleranceG = 0.25f;
 constexpr float kMinimumStillDeltaG = 0.05f;
 
@@ -313,13 +317,16 @@ std::unique_ptr<FanController> createFanControllerFromConfig()
             return nullptr;
         }
 
-        auto bus = std::make_shared<PiI2CBus>();
-        if (!bus->setI2cDevicePath(devicePath)) {
+        auto bus = PiI2CBus::forDevice(devicePath);
+        if (!bus) {
             CubeLog::warning("PeripheralManager: invalid fan controller I2C device path: " + devicePath);
             return nullptr;
         }
 
-        return std::make_unique<FanController>(bus, static_cast<uint16_t>(rawAddress), tenBitAddress);
+        return std::make_unique<FanController>(
+            std::make_shared<PiI2CBusView>(bus, I2CPriority::Periodic),
+            static_cast<uint16_t>(rawAddress),
+            tenBitAddress);
     } catch (...) {
         CubeLog::warning("PeripheralManager: failed to parse fan controller I2C address: " + addressString);
         return nullptr;
@@ -345,19 +352,107 @@ std::unique_ptr<Bmi270Accelerometer> createAccelerometerFromConfig()
             return nullptr;
         }
 
-        auto bus = std::make_shared<PiI2CBus>();
-        if (!bus->setI2cDevicePath(devicePath)) {
+        auto bus = PiI2CBus::forDevice(devicePath);
+        if (!bus) {
             CubeLog::warning("PeripheralManager: invalid accelerometer I2C device path: " + devicePath);
             return nullptr;
         }
 
-        return std::make_unique<Bmi270Accelerometer>(bus, static_cast<uint16_t>(rawAddress), tenBitAddress);
+        auto accelerometer = std::make_unique<Bmi270Accelerometer>(
+            std::make_shared<PiI2CBusView>(bus, I2CPriority::Periodic),
+            static_cast<uint16_t>(rawAddress),
+            tenBitAddress);
+        if (Config::getBool("ACCEL_FIFO_ENABLED", true)) {
+            Bmi270FifoConfig fifoConfig;
+            const std::string outputDataRateString = Config::get("ACCEL_FIFO_ODR_HZ", "100");
+            const std::string watermarkString = Config::get("ACCEL_FIFO_WATERMARK", "16");
+            try {
+                fifoConfig.outputDataRateHz = static_cast<uint16_t>(std::stoul(outputDataRateString));
+                fifoConfig.watermarkSamples = static_cast<uint16_t>(std::stoul(watermarkString));
+            } catch (...) {
+                CubeLog::warning("PeripheralManager: failed to parse accelerometer FIFO settings, using defaults.");
+                fifoConfig = Bmi270FifoConfig {};
+            }
+            if (!accelerometer->setFifoConfig(fifoConfig)) {
+                CubeLog::warning("PeripheralManager: unsupported accelerometer FIFO settings (ODR "
+                    + outputDataRateString + " Hz, watermark " + watermarkString + "), polling single samples.");
+            }
+        }
+        return accelerometer;
     } catch (...) {
         CubeLog::warning("PeripheralManager: failed to parse accelerometer I2C address: " + addressString);
         return nullptr;
     }
 }
 
+std::unique_ptr<IGpioInterruptLine> createAccelerometerInterruptFromConfig()
+{
+    const std::string lineString = Config::get("ACCEL_INT_GPIO_LINE", "");
+    if (lineString.empty()) {
+        return nullptr;
+    }
+    const std::string chipPath = Config::get("ACCEL_INT_GPIO_CHIP", "/dev/gpiochip0");
+
+    try {
+        auto line = std::make_unique<LinuxGpioInterruptLine>(chipPath, static_cast<unsigned int>(std::stoul(lineString, nullptr, 0)));
+        if (!line->open()) {
+            CubeLog::warning("PeripheralManager: accelerometer interrupt unavailable, draining the FIFO on a timer.");
+            return nullptr;
+        }
+        return line;
+    } catch (...) {
+        CubeLog::warning("PeripheralManager: failed to parse accelerometer interrupt GPIO line: " + lineString);
+        return nullptr;
+    }
+}
+
+SchedulerThreadOptions interactionLoopThreadOptionsFromConfig()
+{
+    const std::string priorityString = Config::get("INTERACTION_LOOP_RT_PRIORITY", "0");
+    const std::string cpuString = Config::get("INTERACTION_LOOP_CPU", "-1");
+    try {
+        SchedulerThreadOptions options;
+        options.realtimePriority = std::stoi(priorityString);
+        options.cpu = std::stoi(cpuString);
+        return options;
+    } catch (...) {
+        CubeLog::warning("PeripheralManager: failed to parse interaction loop scheduling (priority " + priorityString + ", CPU " + cpuString + "), using defaults.");
+        return {};
+    }
+}
+
+template <typename T>
+nlohmann::json optionalToJson(const std::optional<T>& value)
+{
+    return value ? nlohmann::json(*value) : nlohmann::json(nullptr);
+}
+
+nlohmann::json systemSensorSnapshotToJson(const SystemSensorSnapshot& snapshot)
+{
+    nlohmann::json temperatures = nlohmann::json::array();
+    for (const auto& reading : snapshot.temperatureReadings()) {
+        temperatures.push_back({ { "name", reading.name }, { "celsius", reading.celsius }, { "cpuLike", reading.cpuLike } });
+    }
+    nlohmann::json coreUsage = nlohmann::json::array();
+    const size_t coreCount = snapshot.layout ? snapshot.layout->cpuCoreCount : 0;
+    for (size_t core = 0; core < coreCount; ++core) {
+        const double usage = snapshot.coreUsagePercent[core];
+        coreUsage.push_back(std::isnan(usage) ? nlohmann::json(nullptr) : nlohmann::json(usage));
+    }
+    return {
+        { "sequence", snapshot.sequence },
+        { "temperatures", std::move(temperatures) },
+        { "cpuTemperatureC", optionalToJson(snapshot.cpuTemperatureC) },
+        { "systemTemperatureC", optionalToJson(snapshot.systemTemperatureC) },
+        { "cpuUsagePercent", optionalToJson(snapshot.cpuUsagePercent) },
+        { "coreUsagePercent", std::move(coreUsage) },
+        { "memoryTotalKb", optionalToJson(snapshot.memoryTotalKb) },
+        { "memoryAvailableKb", optionalToJson(snapshot.memoryAvailableKb) },
+        { "processRssKb", optionalToJson(snapshot.processRssKb) },
+        { "loadAverage", optionalToJson(snapshot.loadAverage) }
+    };
+}
+
 } // namespace
 
 DelayedPresenceTracker::DelayedPresenceTracker(int absentTimeoutSecs)
@@ -494,11 +589,12 @@ PeripheralManager::PeripheralManager(
     : mmWaveSensor_(std::move(mmWaveSensorOverride))
     , fanController_(fanControllerOverride ? std::move(fanControllerOverride) : createFanControllerFromConfig())
     , accelerometer_(accelerometerOverride ? std::move(accelerometerOverride) : createAccelerometerFromConfig())
+    , accelerometerInterrupt_(accelerometer_ ? createAccelerometerInterruptFromConfig() : nullptr)
     , cpuTemperatureReader_(cpuTemperatureReader ? std::move(cpuTemperatureReader) : TemperatureReader([]() {
-        return HardwareInfo::cpuTemperatureCelsius();
+        return SystemSensorSampler::shared().latest().cpuTemperatureC;
     }))
     , systemTemperatureReader_(systemTemperatureReader ? std::move(systemTemperatureReader) : TemperatureReader([]() {
-        return HardwareInfo::systemTemperatureCelsius();
+        return SystemSensorSampler::shared().latest().systemTemperatureC;
     }))
     , monotonicNowReader_(monotonicNowReader ? std::move(monotonicNowReader) : MonotonicNowReader([]() {
         return std::chrono::steady_clock::now();
@@ -515,6 +611,7 @@ PeripheralManager::PeripheralManager(
     interactionStatus_.enabled = loadInteractionDetectionEnabledFromSettings();
     interactionStatus_.available = accelerometer_ && accelerometer_->isConfigured() && accelerometer_->isAvailable();
     interactionStatus_.initialized = accelerometer_ && accelerometer_->isInitialized();
+    interactionPollIntervalMs_ = loadInteractionPollIntervalMsFromSettings();
 
     syncPresenceConfigFromSettings();
     syncPresenceAbsentTimeoutFromSettings();
@@ -541,20 +638,25 @@ PeripheralManager::PeripheralManager(
 
 PeripheralManager::~PeripheralManager()
 {
+    for (const auto id : settingsCallbackIds_) {
+        GlobalSettings::removeSettingCB(id);
+    }
+    settingsCallbackIds_.clear();
     if (settingsCallbackGate_) {
-        settingsCallbackGate_->owner = nullptr;
+        {
+            std::lock_guard<std::mutex> lock(settingsCallbackGate_->mutex);
+            settingsCallbackGate_->owner = nullptr;
+        }
         settingsCallbackGate_.reset();
     }
 
-    if (thermalControlThread_.joinable()) {
-        thermalControlThread_.request_stop();
-        {
-            std::lock_guard<std::mutex> lock(thermalControlWakeMutex_);
-            thermalControlWakeRequested_ = true;
-        }
-        thermalControlWakeCv_.notify_all();
+    if (const auto task = thermalControlTask_.exchange(0)) {
+        PeriodicScheduler::shared().remove(task);
     }
 
+    interactionControlTask_ = 0;
+    interactionScheduler_.reset();
+
     if (interactionControlThread_.joinable()) {
         interactionControlThread_.request_stop();
         {
@@ -577,49 +679,60 @@ void PeripheralManager::registerSettingsCallbacks()
 
     const auto makeGuardedCallback = [weakGate](auto callback) {
         return [weakGate, callback]() mutable {
-            if (auto gate = weakGate.lock(); gate && gate->owner) {
-                callback(*gate->owner);
+            if (auto gate = weakGate.lock()) {
+                std::lock_guard<std::mutex> lock(gate->mutex);
+                if (gate->owner) {
+                    callback(*gate->owner);
+                }
             }
         };
     };
 
-    const auto registerConfigCallback = [&makeGuardedCallback](GlobalSettings::SettingType settingType) {
-        GlobalSettings::setSettingCB(settingType, makeGuardedCallback([](PeripheralManager& owner) {
+    const auto subscribe = [this, &makeGuardedCallback](GlobalSettings::SettingType settingType, auto callback) {
+        settingsCallbackIds_.push_back(GlobalSettings::setSettingCB(settingType, makeGuardedCallback(callback)));
+    };
+
+    const auto registerConfigCallback = [&subscribe](GlobalSettings::SettingType settingType) {
+        subscribe(settingType, [](PeripheralManager& owner) {
             owner.syncPresenceConfigFromSettings();
-        }));
+        });
     };
 
     registerConfigCallback(GlobalSettings::SettingType::MMWAVE_DETECTION_DISTANCE_AVERAGE_WINDOW_SECS);
     registerConfigCallback(GlobalSettings::SettingType::MMWAVE_MOVING_DISTANCE_AVERAGE_WINDOW_SECS);
     registerConfigCallback(GlobalSettings::SettingType::MMWAVE_STATIONARY_DISTANCE_AVERAGE_WINDOW_SECS);
     registerConfigCallback(GlobalSettings::SettingType::MMWAVE_STATIONARY_ENERGY_AVERAGE_WINDOW_SECS);
-    GlobalSettings::setSettingCB(GlobalSettings::SettingType::PRESENCE_DETECTION_ENABLED, makeGuardedCallback([](PeripheralManager& owner) {
+    subscribe(GlobalSettings::SettingType::PRESENCE_DETECTION_ENABLED, [](PeripheralManager& owner) {
         owner.syncPresenceDetectionEnabledFromSettings();
-    }));
-    GlobalSettings::setSettingCB(GlobalSettings::SettingType::PRESENCE_ABSENT_TIMEOUT_SECS, makeGuardedCallback([](PeripheralManager& owner) {
+    });
+    subscribe(GlobalSettings::SettingType::PRESENCE_ABSENT_TIMEOUT_SECS, [](PeripheralManager& owner) {
         owner.syncPresenceAbsentTimeoutFromSettings();
-    }));
+    });
 
-    const auto registerThermalCallback = [&makeGuardedCallback](GlobalSettings::SettingType settingType) {
-        GlobalSettings::setSettingCB(settingType, makeGuardedCallback([](PeripheralManager& owner) {
+    const auto registerThermalCallback = [&subscribe](GlobalSettings::SettingType settingType) {
+        subscribe(settingType, [](PeripheralManager& owner) {
             owner.requestThermalControlWake();
-        }));
+        });
     };
 
     registerThermalCallback(GlobalSettings::SettingType::FAN_CONTROL_ENABLED);
-    registerThermalCallback(GlobalSettings::SettingType::FAN_CONTROL_POLL_INTERVAL_MS);
+    subscribe(GlobalSettings::SettingType::FAN_CONTROL_POLL_INTERVAL_MS, [](PeripheralManager& owner) {
+        owner.applyThermalControlPollIntervalFromSettings();
+    });
     registerThermalCallback(GlobalSettings::SettingType::FAN_CONTROL_HYSTERESIS_C);
     registerThermalCallback(GlobalSettings::SettingType::FAN_CONTROL_FAILSAFE_PERCENT);
     registerThermalCallback(GlobalSettings::SettingType::FAN_CONTROL_CURVE_POINTS);
 
-    const auto registerInteractionCallback = [&makeGuardedCallback](GlobalSettings::SettingType settingType) {
-        GlobalSettings::setSettingCB(settingType, makeGuardedCallback([](PeripheralManager& owner) {
+    const auto registerInteractionCallback = [&subscribe](GlobalSettings::SettingType settingType) {
+        subscribe(settingType, [](PeripheralManager& owner) {
             owner.requestInteractionControlWake();
-        }));
+        });
     };
 
     registerInteractionCallback(GlobalSettings::SettingType::INTERACTION_DETECTION_ENABLED);
-    registerInteractionCallback(GlobalSettings::SettingType::INTERACTION_POLL_INTERVAL_MS);
+    subscribe(GlobalSettings::SettingType::INTERACTION_POLL_INTERVAL_MS, [](PeripheralManager& owner) {
+        owner.applyInteractionPollIntervalFromSettings();
+    });
     registerInteractionCallback(GlobalSettings::SettingType::INTERACTION_EVENT_HISTORY_SIZE);
     registerInteractionCallback(GlobalSettings::SettingType::INTERACTION_TAP_DEBOUNCE_MS);
     registerInteractionCallback(GlobalSettings::SettingType::INTERACTION_LIFT_CONFIRM_MS);
@@ -629,38 +742,28 @@ void PeripheralManager::registerSettingsCallbacks()
 
 void PeripheralManager::startThermalControlLoop()
 {
-    if (thermalControlThread_.joinable()) {
+    if (thermalControlTask_) {
         return;
     }
 
-    thermalControlThread_ = std::jthread([this](std::stop_token stopToken) {
-        thermalControlLoop(stopToken);
-    });
+    thermalControlTask_ = PeriodicScheduler::shared().add(
+        { "fanControl", std::chrono::milliseconds(loadFanControlPollIntervalMsFromSettings()), kThermalControlJitterBudget },
+        [this]() { runThermalControlIteration(); });
 }
 
-void PeripheralManager::thermalControlLoop(std::stop_token stopToken)
+void PeripheralManager::applyThermalControlPollIntervalFromSettings()
 {
-    while (!stopToken.stop_requested()) {
-        runThermalControlIteration();
-
-        std::unique_lock<std::mutex> lock(thermalControlWakeMutex_);
-        thermalControlWakeCv_.wait_for(
-            lock,
-            std::chrono::milliseconds(loadFanControlPollIntervalMsFromSettings()),
-            [this, &stopToken]() {
-                return stopToken.stop_requested() || thermalControlWakeRequested_;
-            });
-        thermalControlWakeRequested_ = false;
+    if (const auto task = thermalControlTask_.load()) {
+        PeriodicScheduler::shared().setPeriod(task, std::chrono::milliseconds(loadFanControlPollIntervalMsFromSettings()));
     }
+    requestThermalControlWake();
 }
 
 void PeripheralManager::requestThermalControlWake()
 {
-    {
-        std::lock_guard<std::mutex> lock(thermalControlWakeMutex_);
-        thermalControlWakeRequested_ = true;
+    if (const auto task = thermalControlTask_.load()) {
+        PeriodicScheduler::shared().wake(task);
     }
-    thermalControlWakeCv_.notify_all();
 }
 
 void PeripheralManager::setThermalStatusSnapshot(
@@ -785,24 +888,61 @@ void PeripheralManager::runThermalControlIteration()
 
 void PeripheralManager::startInteractionControlLoop()
 {
-    if (interactionControlThread_.joinable()) {
+    if (interactionControlThread_.joinable() || interactionControlTask_) {
         return;
     }
 
-    interactionControlThread_ = std::jthread([this](std::stop_token stopToken) {
-        interactionControlLoop(stopToken);
-    });
+    if (accelerometerInterrupt_) {
+        interactionControlThread_ = std::jthread([this](std::stop_token stopToken) {
+            interactionControlLoop(stopToken);
+        });
+        return;
+    }
+
+    interactionScheduler_ = std::make_unique<PeriodicScheduler>("interaction", interactionLoopThreadOptionsFromConfig());
+    interactionControlTask_ = interactionScheduler_->add(
+        { "interactionPoll", std::chrono::milliseconds(interactionPollIntervalMs_.load()), std::chrono::milliseconds(0) },
+        [this]() { runInteractionControlIteration(); });
+}
+
+void PeripheralManager::applyInteractionPollIntervalFromSettings()
+{
+    interactionPollIntervalMs_ = loadInteractionPollIntervalMsFromSettings();
+    if (const auto task = interactionControlTask_.load()) {
+        interactionScheduler_->setPeriod(task, std::chrono::milliseconds(interactionPollIntervalMs_.load()));
+    }
+    requestInteractionControlWake();
 }
 
 void PeripheralManager::interactionControlLoop(std::stop_token stopToken)
 {
+    std::stop_callback cancelInterruptWait(stopToken, [this]() {
+        if (accelerometerInterrupt_) {
+            accelerometerInterrupt_->cancelWait();
+        }
+    });
+    bool interruptUsable = static_cast<bool>(accelerometerInterrupt_);
+    applySchedulerThreadOptions("PeripheralManager interaction loop", interactionLoopThreadOptionsFromConfig());
+
     while (!stopToken.stop_requested()) {
         runInteractionControlIteration();
 
+        // With the FIFO filling in the background the watermark interrupt paces the loop, so each wake-up
+        // drains a whole batch; settings changes and shutdown cancel the wait like they notify the timer.
+        if (interruptUsable && accelerometer_->isFifoEnabled()) {
+            if (auto woke = accelerometerInterrupt_->wait(kInteractionInterruptBackstop); !woke) {
+                CubeLog::warning("PeripheralManager: accelerometer interrupt wait failed, draining the FIFO on a timer.");
+                interruptUsable = false;
+            }
+            std::lock_guard<std::mutex> lock(interactionControlWakeMutex_);
+            interactionControlWakeRequested_ = false;
+            continue;
+        }
+
         std::unique_lock<std::mutex> lock(interactionControlWakeMutex_);
         interactionControlWakeCv_.wait_for(
             lock,
-            std::chrono::milliseconds(loadInteractionPollIntervalMsFromSettings()),
+            std::chrono::milliseconds(interactionPollIntervalMs_.load()),
             [this, &stopToken]() {
                 return stopToken.stop_requested() || interactionControlWakeRequested_;
             });
@@ -812,11 +952,18 @@ void PeripheralManager::interactionControlLoop(std::stop_token stopToken)
 
 void PeripheralManager::requestInteractionControlWake()
 {
+    if (const auto task = interactionControlTask_.load()) {
+        interactionScheduler_->wake(task);
+        return;
+    }
     {
         std::lock_guard<std::mutex> lock(interactionControlWakeMutex_);
         interactionControlWakeRequested_ = true;
     }
     interactionControlWakeCv_.notify_all();
+    if (accelerometerInterrupt_) {
+        accelerometerInterrupt_->cancelWait();
+    }
 }
 
 void PeripheralManager::setInteractionStatusSnapshot(const InteractionStatusSnapshot& status)
@@ -1012,6 +1159,18 @@ HttpEndPointData_t PeripheralManager::getHttpEndpointData()
         nlohmann::json({ { "type", "object" }, { "properties", nlohmann::json::object() } }),
         "Get immediate and delayed presence state"
     });
+    data.push_back({
+        PUBLIC_ENDPOINT | GET_ENDPOINT,
+        [](const httplib::Request& req, httplib::Response& res) {
+            (void)req;
+            res.status = 200;
+            res.set_content(systemSensorSnapshotToJson(SystemSensorSampler::shared().latest()).dump(), "application/json");
+            return EndpointError(EndpointError::ERROR_TYPES::ENDPOINT_NO_ERROR, "");
+        },
+        "systemSensors",
+        nlohmann::json({ { "type", "object" }, { "properties", nlohmann::json::object() } }),
+        "Get the latest temperature, CPU, memory and load sample"
+    });
     return data;
 }
 
@@ -1052,11 +1211,57 @@ void PeripheralManager::handleImmediatePresenceDecision(const MmWavePresenceDeci
         ? std::chrono::steady_clock::now()
         : decision.timestamp;
 
-    std::lock_guard<std::mutex> lock(presenceStatusMutex_);
-    if (!presenceDetectionEnabled_) {
+    PresenceStatusSnapshot previous;
+    PresenceStatusSnapshot current;
+    {
+        std::lock_guard<std::mutex> lock(presenceStatusMutex_);
+        if (!presenceDetectionEnabled_) {
+            return;
+        }
+        previous = delayedPresenceTracker_.snapshot(now);
+        current = delayedPresenceTracker_.updateImmediateState(decision.state, now);
+    }
+    publishPresenceChange(previous, current);
+}
+
+void PeripheralManager::setEventBroker(std::shared_ptr<ApiEventBroker> broker)
+{
+    if (broker) {
+        broker->registerSource("presence");
+    }
+    std::lock_guard<std::mutex> lock(eventBrokerMutex_);
+    eventBroker_ = std::move(broker);
+}
+
+// Event names are the new state ("present"/"absent"/"unknown"), prefixed with "delayed_" for the
+// debounced state, so a trigger can subscribe to exactly the edge it cares about.
+void PeripheralManager::publishPresenceChange(const PresenceStatusSnapshot& previous, const PresenceStatusSnapshot& current)
+{
+    if (previous.immediateState == current.immediateState && previous.delayedState == current.delayedState) {
         return;
     }
-    delayedPresenceTracker_.updateImmediateState(decision.state, now);
+    std::shared_ptr<ApiEventBroker> broker;
+    {
+        std::lock_guard<std::mutex> lock(eventBrokerMutex_);
+        broker = eventBroker_;
+    }
+    if (!broker) {
+        return;
+    }
+
+    const nlohmann::json payload = {
+        { "immediateState", presenceStateToString(current.immediateState) },
+        { "delayedState", presenceStateToString(current.delayedState) },
+        { "previousImmediateState", presenceStateToString(previous.immediateState) },
+        { "previousDelayedState", presenceStateToString(previous.delayedState) },
+    };
+    const auto occurredAtEpochMs = epochMsReader_();
+    if (previous.immediateState != current.immediateState) {
+        broker->publish("presence", presenceStateToString(current.immediateState), payload, occurredAtEpochMs);
+    }
+    if (previous.delayedState != current.delayedState) {
+        broker->publish("presence", std::string("delayed_") + presenceStateToString(current.delayedState), payload, occurredAtEpochMs);
+    }
 }
 
 bool PeripheralManager::isMmWavePresent()
@@ -36,13 +36,18 @@ SOFTWARE.
 #define PERIPHERALMANAGER_H
 
 #include "../api/api.h"
+#include "../api/apiEventBroker.h"
+#include "../periodicScheduler.h"
+#include "../settings/globalSettings.h"
 #include "accel.h"
 #include "fanCtrl.h"
+#include "gpioInterruptLine.h"
 #include "hardwareInfo.h"
 #include "interactionEvents.h"
 #include "io_bridge/ioBridge.h"
 #include "mmWave.h"
 #include "nfc.h"
+#include "systemSensorSampler.h"
 
 #include <chrono>
 #include <condition_variable>
@@ -111,13 +116,18 @@ public:
     using EpochMsReader = std::function<uint64_t()>;
 
 private:
+    // Settings callbacks are removed by the destructor, but one GlobalSettings has already copied out may still
+    // run, so they reach the manager through this gate. A callback holds the mutex while it runs; the destructor
+    // takes it to clear owner, so no callback is still using the schedulers when they are torn down.
     struct SettingsCallbackGate {
+        std::mutex mutex;
         PeripheralManager* owner = nullptr;
     };
 
     std::unique_ptr<mmWave> mmWaveSensor_;
     std::unique_ptr<FanController> fanController_;
     std::unique_ptr<Bmi270Accelerometer> accelerometer_;
+    std::unique_ptr<IGpioInterruptLine> accelerometerInterrupt_;
 
     TemperatureReader cpuTemperatureReader_;
     TemperatureReader systemTemperatureReader_;
@@ -138,29 +148,39 @@ private:
     std::optional<std::chrono::steady_clock::time_point> stableSince_;
     std::optional<std::chrono::steady_clock::time_point> liftCandidateSince_;
 
-    std::jthread thermalControlThread_;
-    std::condition_variable thermalControlWakeCv_;
-    std::mutex thermalControlWakeMutex_;
-    bool thermalControlWakeRequested_ = false;
+    // Fan control is a housekeeping task on the shared scheduler; the interval is pushed by its settings callback.
+    std::atomic<PeriodicScheduler::TaskId> thermalControlTask_ { 0 };
 
+    // Timer-paced interaction polling runs on its own scheduler so it can be given SCHED_FIFO/a CPU without
+    // dragging the housekeeping tasks along. The interrupt-driven FIFO path keeps a dedicated thread because it
+    // blocks on the GPIO line.
+    std::unique_ptr<PeriodicScheduler> interactionScheduler_;
+    std::atomic<PeriodicScheduler::TaskId> interactionControlTask_ { 0 };
+    std::atomic<int> interactionPollIntervalMs_ { 50 };
     std::jthread interactionControlThread_;
     std::condition_variable interactionControlWakeCv_;
     std::mutex interactionControlWakeMutex_;
     bool interactionControlWakeRequested_ = false;
 
     std::shared_ptr<SettingsCallbackGate> settingsCallbackGate_;
+    std::vector<GlobalSettings::SettingCallbackId> settingsCallbackIds_;
+
+    mutable std::mutex eventBrokerMutex_;
+    std::shared_ptr<ApiEventBroker> eventBroker_;
+    void publishPresenceChange(const PresenceStatusSnapshot& previous, const PresenceStatusSnapshot& current);
 
     void syncPresenceConfigFromSettings();
     void syncPresenceAbsentTimeoutFromSettings();
     void registerSettingsCallbacks();
 
     void startThermalControlLoop();
-    void thermalControlLoop(std::stop_token stopToken);
+    void applyThermalControlPollIntervalFromSettings();
     void setThermalStatusSnapshot(const ThermalStatusSnapshot& status, std::optional<double> appliedDutyTemperatureC = std::nullopt);
     std::expected<void, I2CError> applyFanDutyPercent(uint8_t dutyPercent);
 
     void startInteractionControlLoop();
     void interactionControlLoop(std::stop_token stopToken);
+    void applyInteractionPollIntervalFromSettings();
     void setInteractionStatusSnapshot(const InteractionStatusSnapshot& status);
     InteractionEvent recordInteractionEvent(
         InteractionEventType type,
@@ -209,6 +229,10 @@ public:
     PresenceStatusSnapshot getPresenceStatus();
     ThermalStatusSnapshot getThermalStatus() const;
     InteractionStatusSnapshot getInteractionStatus() const;
+
+    // Publish presence transitions on the "presence" source so event triggers and API clients
+    // can react on the edge instead of polling getPresenceStatus().
+    void setEventBroker(std::shared_ptr<ApiEventBroker> broker);
 };
 
 #endif // PERIPHERALMANAGER_H
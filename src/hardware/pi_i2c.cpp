@@ -39,15 +39,161 @@ PiI2CBus performs Linux I2C transactions against /dev/i2c-* and is intended to b
 #include "pi_i2c.h"
 #include <utils.h>
 
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <map>
+#include <utility>
+
 namespace {
 
+constexpr size_t kMaxI2CMessageLength = 0xFFFF;
+
 bool hardwareI2cEnabled()
 {
     return Config::getBool("HARDWARE_I2C_ENABLED", true);
 }
 
+size_t priorityIndex(I2CPriority priority)
+{
+    return static_cast<size_t>(priority);
+}
+
 } // namespace
 
+I2CTransaction& I2CTransaction::write(uint16_t address, I2CBytes data, bool tenBit)
+{
+    segments_.push_back({ .address = address, .tenBit = tenBit, .read = false, .data = std::move(data) });
+    return *this;
+}
+
+I2CTransaction& I2CTransaction::read(uint16_t address, size_t length, bool tenBit)
+{
+    segments_.push_back({ .address = address, .tenBit = tenBit, .read = true, .length = length });
+    return *this;
+}
+
+I2CTransaction& I2CTransaction::writeRead(uint16_t address, I2CBytes txData, size_t rxLen, bool tenBit)
+{
+    if (!txData.empty()) {
+        write(address, std::move(txData), tenBit);
+    }
+    if (rxLen > 0) {
+        read(address, rxLen, tenBit);
+    }
+    return *this;
+}
+
+const std::vector<I2CSegment>& I2CTransaction::segments() const
+{
+    return segments_;
+}
+
+size_t I2CTransaction::readCount() const
+{
+    size_t count = 0;
+    for (const auto& segment : segments_) {
+        count += segment.read ? 1 : 0;
+    }
+    return count;
+}
+
+bool I2CTransaction::empty() const
+{
+    return segments_.empty();
+}
+
+std::expected<std::vector<I2CBytes>, I2CError> ILocalI2CBus::transfer(const I2CTransaction& transaction)
+{
+    const auto& segments = transaction.segments();
+    std::vector<I2CBytes> reads;
+    reads.reserve(transaction.readCount());
+
+    for (size_t index = 0; index < segments.size(); ++index) {
+        const I2CSegment& segment = segments[index];
+        if (segment.read) {
+            auto rxData = writeRead(segment.address, I2CBytes {}, segment.length, segment.tenBit);
+            if (!rxData) {
+                return std::unexpected(rxData.error());
+            }
+            reads.push_back(std::move(*rxData));
+            continue;
+        }
+
+        const I2CSegment* next = index + 1 < segments.size() ? &segments[index + 1] : nullptr;
+        if (next && next->read && next->address == segment.address && next->tenBit == segment.tenBit) {
+            auto rxData = writeRead(segment.address, segment.data, next->length, segment.tenBit);
+            if (!rxData) {
+                return std::unexpected(rxData.error());
+            }
+            reads.push_back(std::move(*rxData));
+            ++index;
+            continue;
+        }
+
+        if (auto result = write(segment.address, segment.data, segment.tenBit); !result) {
+            return std::unexpected(result.error());
+        }
+    }
+
+    return reads;
+}
+
+I2CBusArbiter::Grant::Grant(I2CBusArbiter* arbiter, I2CPriority priority)
+    : arbiter_(arbiter)
+    , priority_(priority)
+{
+}
+
+I2CBusArbiter::Grant::Grant(Grant&& other) noexcept
+    : arbiter_(std::exchange(other.arbiter_, nullptr))
+    , priority_(other.priority_)
+{
+}
+
+I2CBusArbiter::Grant::~Grant()
+{
+    if (arbiter_) {
+        arbiter_->release(priority_);
+    }
+}
+
+I2CBusArbiter::Grant I2CBusArbiter::acquire(I2CPriority priority)
+{
+    const size_t index = priorityIndex(priority);
+    const size_t interactive = priorityIndex(I2CPriority::Interactive);
+    std::unique_lock<std::mutex> lock(mutex_);
+    const uint64_t ticket = issued_[index]++;
+    cv_.wait(lock, [&]() {
+        if (busy_ || served_[index] != ticket) {
+            return false;
+        }
+        return priority == I2CPriority::Interactive || issued_[interactive] == served_[interactive];
+    });
+    busy_ = true;
+    holder_ = priority;
+    return Grant(this, priority);
+}
+
+size_t I2CBusArbiter::waiting(I2CPriority priority) const
+{
+    const size_t index = priorityIndex(priority);
+    std::lock_guard<std::mutex> lock(mutex_);
+    // The caller holding the bus still has an unserved ticket until it releases.
+    const uint64_t queued = issued_[index] - served_[index];
+    return static_cast<size_t>(busy_ && queued > 0 && holder_ == priority ? queued - 1 : queued);
+}
+
+void I2CBusArbiter::release(I2CPriority priority)
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        busy_ = false;
+        served_[priorityIndex(priority)]++;
+    }
+    cv_.notify_all();
+}
+
 PiI2CBus::PiI2CBus(const std::string& devicePath)
     : i2cDevicePath_(devicePath)
 {
@@ -56,9 +202,30 @@ PiI2CBus::PiI2CBus(const std::string& devicePath)
 
 PiI2CBus::~PiI2CBus()
 {
+    std::lock_guard<std::mutex> lock(mutex_);
+    closeLocked();
     CubeLog::info("PiI2CBus destroyed");
 }
 
+std::shared_ptr<PiI2CBus> PiI2CBus::forDevice(const std::string& path)
+{
+    static std::mutex registryMutex;
+    static std::map<std::string, std::weak_ptr<PiI2CBus>> registry;
+
+    std::lock_guard<std::mutex> lock(registryMutex);
+    if (auto existing = registry[path].lock()) {
+        return existing;
+    }
+
+    auto bus = std::make_shared<PiI2CBus>();
+    if (!bus->setI2cDevicePath(path)) {
+        registry.erase(path);
+        return nullptr;
+    }
+    registry[path] = bus;
+    return bus;
+}
+
 bool PiI2CBus::setI2cDevicePath(const std::string& path)
 {
     std::lock_guard<std::mutex> lock(mutex_);
@@ -71,6 +238,9 @@ bool PiI2CBus::setI2cDevicePath(const std::string& path)
         CubeLog::error("I2C device path is not a character device: " + path);
         return false;
     }
+    if (path != i2cDevicePath_) {
+        closeLocked();
+    }
     i2cDevicePath_ = path;
     CubeLog::info("I2C device path set to: " + path);
     return true;
@@ -83,42 +253,11 @@ const std::string& PiI2CBus::getI2cDevicePath() const
 
 std::expected<void, I2CError> PiI2CBus::write(uint16_t address, const I2CBytes& txData, bool tenBit)
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-    if (!hardwareI2cEnabled()) {
-        CubeLog::warning("I2C write blocked by HARDWARE_I2C_ENABLED=0.");
-        return std::unexpected(I2CError::DISABLED_BY_CONFIG);
-    }
-    if (!validateAddress(address, tenBit)) {
-        CubeLog::error("Invalid I2C address: " + std::to_string(address));
-        return std::unexpected(I2CError::INVALID_ADDRESS);
+    I2CTransaction transaction;
+    transaction.write(address, txData, tenBit);
+    if (auto result = transfer(transaction, I2CPriority::Interactive); !result) {
+        return std::unexpected(result.error());
     }
-    if (i2cDevicePath_.empty()) {
-        CubeLog::error("I2C device path is not set.");
-        return std::unexpected(I2CError::NOT_INITIALIZED);
-    }
-    if (txData.empty()) {
-        return { };
-    }
-
-    const int fd = openDevice();
-    if (fd < 0) {
-        CubeLog::error("Failed to open I2C device: " + i2cDevicePath_);
-        return std::unexpected(I2CError::OPEN_FAILED);
-    }
-
-    if (!bindAddress(fd, address, tenBit)) {
-        close(fd);
-        return std::unexpected(I2CError::IOCTL_FAILED);
-    }
-
-    const ssize_t bytesWritten = ::write(fd, txData.data(), txData.size());
-    close(fd);
-
-    if (bytesWritten < 0 || static_cast<size_t>(bytesWritten) != txData.size()) {
-        CubeLog::error("I2C write() failed");
-        return std::unexpected(I2CError::IO_FAILED);
-    }
-
     return { };
 }
 
@@ -127,65 +266,147 @@ std::expected<I2CBytes, I2CError> PiI2CBus::writeRead(
     const I2CBytes& txData,
     size_t rxLen,
     bool tenBit)
+{
+    I2CTransaction transaction;
+    transaction.writeRead(address, txData, rxLen, tenBit);
+    auto result = transfer(transaction, I2CPriority::Interactive);
+    if (!result) {
+        return std::unexpected(result.error());
+    }
+    return result->empty() ? I2CBytes {} : std::move(result->front());
+}
+
+std::expected<std::vector<I2CBytes>, I2CError> PiI2CBus::transfer(const I2CTransaction& transaction)
+{
+    return transfer(transaction, I2CPriority::Interactive);
+}
+
+std::expected<std::vector<I2CBytes>, I2CError> PiI2CBus::transfer(const I2CTransaction& transaction, I2CPriority priority)
+{
+    const auto grant = arbiter_.acquire(priority);
+    std::lock_guard<std::mutex> lock(mutex_);
+    return transferLocked(transaction);
+}
+
+PiI2CBusStats PiI2CBus::stats() const
 {
     std::lock_guard<std::mutex> lock(mutex_);
+    return stats_;
+}
+
+void PiI2CBus::setIoctlCall(IoctlCall call)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    ioctlCall_ = std::move(call);
+}
+
+std::expected<std::vector<I2CBytes>, I2CError> PiI2CBus::transferLocked(const I2CTransaction& transaction)
+{
     if (!hardwareI2cEnabled()) {
-        CubeLog::warning("I2C writeRead blocked by HARDWARE_I2C_ENABLED=0.");
+        CubeLog::warning("I2C transfer blocked by HARDWARE_I2C_ENABLED=0.");
         return std::unexpected(I2CError::DISABLED_BY_CONFIG);
     }
-    if (!validateAddress(address, tenBit)) {
-        CubeLog::error("Invalid I2C address: " + std::to_string(address));
-        return std::unexpected(I2CError::INVALID_ADDRESS);
+    for (const auto& segment : transaction.segments()) {
+        if (!validateAddress(segment.address, segment.tenBit)) {
+            CubeLog::error("Invalid I2C address: " + std::to_string(segment.address));
+            return std::unexpected(I2CError::INVALID_ADDRESS);
+        }
+        if ((segment.read ? segment.length : segment.data.size()) > kMaxI2CMessageLength) {
+            CubeLog::error("I2C segment is longer than a single message can carry.");
+            return std::unexpected(I2CError::INVALID_ARGUMENT);
+        }
     }
     if (i2cDevicePath_.empty()) {
         CubeLog::error("I2C device path is not set.");
         return std::unexpected(I2CError::NOT_INITIALIZED);
     }
 
-    I2CBytes rxData(rxLen, 0);
+    std::vector<const I2CSegment*> active;
+    active.reserve(transaction.segments().size());
+    for (const auto& segment : transaction.segments()) {
+        if (segment.read || !segment.data.empty()) {
+            active.push_back(&segment);
+        }
+    }
+    std::vector<I2CBytes> reads;
+    if (active.empty()) {
+        return reads;
+    }
 
-    const int fd = openDevice();
-    if (fd < 0) {
+    if (!ensureOpenLocked()) {
         CubeLog::error("Failed to open I2C device: " + i2cDevicePath_);
         return std::unexpected(I2CError::OPEN_FAILED);
     }
-
-    if (!bindAddress(fd, address, tenBit)) {
-        close(fd);
-        return std::unexpected(I2CError::IOCTL_FAILED);
+    stats_.transactions++;
+
+    if (!combinedTransfersSupported_) {
+        for (const I2CSegment* segment : active) {
+            if (segment->read) {
+                CubeLog::error("I2C adapter " + i2cDevicePath_ + " does not support combined read transfers.");
+                return std::unexpected(I2CError::IOCTL_FAILED);
+            }
+            if (auto result = writeWithSlaveLocked(*segment); !result) {
+                return std::unexpected(result.error());
+            }
+        }
+        return reads;
     }
 
-    struct i2c_rdwr_ioctl_data rdwr { };
-    std::vector<i2c_msg> messages((txData.empty() ? 0 : 1) + (rxLen > 0 ? 1 : 0));
-
-    size_t messageIndex = 0;
-    if (!txData.empty()) {
-        messages[messageIndex].addr = address;
-        messages[messageIndex].flags = tenBit ? I2C_M_TEN : 0;
-        messages[messageIndex].len = static_cast<__u16>(txData.size());
-        messages[messageIndex].buf = const_cast<__u8*>(reinterpret_cast<const __u8*>(txData.data()));
-        messageIndex++;
-    }
-    if (rxLen > 0) {
-        messages[messageIndex].addr = address;
-        messages[messageIndex].flags = (tenBit ? I2C_M_TEN : 0) | I2C_M_RD;
-        messages[messageIndex].len = static_cast<__u16>(rxLen);
-        messages[messageIndex].buf = reinterpret_cast<__u8*>(rxData.data());
-        messageIndex++;
+    // Read buffers are sized up front so the message pointers stay valid for the ioctl.
+    reads.reserve(transaction.readCount());
+    std::vector<i2c_msg> messages(active.size());
+    for (size_t index = 0; index < active.size(); ++index) {
+        const I2CSegment& segment = *active[index];
+        i2c_msg& message = messages[index];
+        message.addr = segment.address;
+        message.flags = static_cast<__u16>((segment.tenBit ? I2C_M_TEN : 0) | (segment.read ? I2C_M_RD : 0));
+        if (segment.read) {
+            reads.emplace_back(segment.length, 0);
+            message.len = static_cast<__u16>(segment.length);
+            message.buf = reinterpret_cast<__u8*>(reads.back().data());
+        } else {
+            message.len = static_cast<__u16>(segment.data.size());
+            message.buf = const_cast<__u8*>(reinterpret_cast<const __u8*>(segment.data.data()));
+        }
     }
 
-    rdwr.msgs = messages.data();
-    rdwr.nmsgs = static_cast<__u32>(messages.size());
+    // The kernel caps one I2C_RDWR at I2C_RDWR_IOCTL_MAX_MSGS segments; longer batches keep the bus but not
+    // the repeated start between chunks.
+    for (size_t offset = 0; offset < messages.size(); offset += I2C_RDWR_IOCTL_MAX_MSGS) {
+        const size_t count = std::min<size_t>(I2C_RDWR_IOCTL_MAX_MSGS, messages.size() - offset);
+        struct i2c_rdwr_ioctl_data rdwr { };
+        rdwr.msgs = messages.data() + offset;
+        rdwr.nmsgs = static_cast<__u32>(count);
+
+        stats_.syscalls++;
+        if (ioctlLocked(I2C_RDWR, reinterpret_cast<unsigned long>(&rdwr)) < 0) {
+            const int error = errno;
+            CubeLog::error(std::string("ioctl(I2C_RDWR) failed: ") + std::strerror(error));
+            dropDeviceOnFatalError(error);
+            return std::unexpected(I2CError::IOCTL_FAILED);
+        }
+        stats_.messages += count;
+    }
 
-    const int result = ioctl(fd, I2C_RDWR, &rdwr);
-    close(fd);
+    return reads;
+}
 
-    if (result < 0) {
-        CubeLog::error("ioctl(I2C_RDWR) failed");
+std::expected<void, I2CError> PiI2CBus::writeWithSlaveLocked(const I2CSegment& segment)
+{
+    if (!bindAddressLocked(segment.address, segment.tenBit)) {
         return std::unexpected(I2CError::IOCTL_FAILED);
     }
 
-    return rxData;
+    stats_.syscalls++;
+    const ssize_t bytesWritten = ::write(fd_, segment.data.data(), segment.data.size());
+    if (bytesWritten < 0 || static_cast<size_t>(bytesWritten) != segment.data.size()) {
+        const int error = bytesWritten < 0 ? errno : 0;
+        CubeLog::error("I2C write() failed");
+        dropDeviceOnFatalError(error);
+        return std::unexpected(I2CError::IO_FAILED);
+    }
+    stats_.messages++;
+    return { };
 }
 
 bool PiI2CBus::validateAddress(uint16_t address, bool tenBit) const
@@ -193,20 +414,103 @@ bool PiI2CBus::validateAddress(uint16_t address, bool tenBit) const
     return tenBit ? address <= 0x03FF : address <= 0x007F;
 }
 
-bool PiI2CBus::bindAddress(int fd, uint16_t address, bool tenBit) const
+bool PiI2CBus::bindAddressLocked(uint16_t address, bool tenBit)
 {
-    if (ioctl(fd, I2C_TENBIT, tenBit ? 1 : 0) < 0) {
+    if (boundSlave_ == std::pair { address, tenBit }) {
+        return true;
+    }
+
+    boundSlave_.reset();
+    stats_.syscalls += 2;
+    if (ioctlLocked(I2C_TENBIT, tenBit ? 1 : 0) < 0) {
         CubeLog::error("I2C_TENBIT failed");
         return false;
     }
-    if (ioctl(fd, I2C_SLAVE, address) < 0) {
+    if (ioctlLocked(I2C_SLAVE, address) < 0) {
         CubeLog::error("I2C_SLAVE failed");
         return false;
     }
+    boundSlave_ = std::pair { address, tenBit };
     return true;
 }
 
-int PiI2CBus::openDevice() const
+bool PiI2CBus::ensureOpenLocked()
+{
+    if (fd_ >= 0) {
+        return true;
+    }
+
+    stats_.syscalls++;
+    fd_ = open(i2cDevicePath_.c_str(), O_RDWR | O_CLOEXEC);
+    if (fd_ < 0) {
+        return false;
+    }
+    stats_.deviceOpens++;
+    boundSlave_.reset();
+
+    // Adapters without plain I2C support (SMBus-only controllers) cannot take I2C_RDWR; writes then go
+    // through write() with a cached I2C_SLAVE binding. If the query itself fails, assume a full adapter.
+    unsigned long functionality = 0;
+    stats_.syscalls++;
+    combinedTransfersSupported_ = ioctlLocked(I2C_FUNCS, reinterpret_cast<unsigned long>(&functionality)) < 0 || (functionality & I2C_FUNC_I2C) != 0;
+    return true;
+}
+
+void PiI2CBus::closeLocked()
+{
+    if (fd_ >= 0) {
+        close(fd_);
+        fd_ = -1;
+    }
+    boundSlave_.reset();
+}
+
+int PiI2CBus::ioctlLocked(unsigned long request, unsigned long argument)
+{
+    return ioctlCall_ ? ioctlCall_(fd_, request, argument) : ioctl(fd_, request, argument);
+}
+
+void PiI2CBus::dropDeviceOnFatalError(int error)
+{
+    // NAKs and timeouts leave the adapter usable; a vanished or invalid fd has to be reopened.
+    if (error == ENODEV || error == EBADF) {
+        CubeLog::warning("I2C device " + i2cDevicePath_ + " went away, reopening on the next transfer.");
+        closeLocked();
+    }
+}
+
+PiI2CBusView::PiI2CBusView(std::shared_ptr<PiI2CBus> bus, I2CPriority priority)
+    : bus_(std::move(bus))
+    , priority_(priority)
+{
+}
+
+std::expected<void, I2CError> PiI2CBusView::write(uint16_t address, const I2CBytes& txData, bool tenBit)
+{
+    I2CTransaction transaction;
+    transaction.write(address, txData, tenBit);
+    if (auto result = bus_->transfer(transaction, priority_); !result) {
+        return std::unexpected(result.error());
+    }
+    return { };
+}
+
+std::expected<I2CBytes, I2CError> PiI2CBusView::writeRead(
+    uint16_t address,
+    const I2CBytes& txData,
+    size_t rxLen,
+    bool tenBit)
+{
+    I2CTransaction transaction;
+    transaction.writeRead(address, txData, rxLen, tenBit);
+    auto result = bus_->transfer(transaction, priority_);
+    if (!result) {
+        return std::unexpected(result.error());
+    }
+    return result->empty() ? I2CBytes {} : std::move(result->front());
+}
+
+std::expected<std::vector<I2CBytes>, I2CError> PiI2CBusView::transfer(const I2CTransaction& transaction)
 {
-    return open(i2cDevicePath_.c_str(), O_RDWR | O_CLOEXEC);
+    return bus_->transfer(transaction, priority_);
 }
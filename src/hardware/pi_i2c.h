@@ -33,19 +33,26 @@ SOFTWARE.
 
 /*
 This file defines the local I2C abstraction used by internal hardware drivers.
-ILocalI2CBus is the test seam for NFC, EEPROM, and fan-control logic.
-PiI2CBus is the concrete Linux /dev/i2c-* implementation for devices wired directly to the Raspberry Pi.
+ILocalI2CBus is the test seam for NFC, EEPROM, accelerometer, and fan-control logic.
+PiI2CBus is the concrete Linux /dev/i2c-* implementation for devices wired directly to the Raspberry Pi. One
+instance per adapter keeps the device open, sends each transaction as a single I2C_RDWR ioctl, and arbitrates
+between periodic sensor reads and interactive requests.
 */
 
 #pragma once
 #ifndef PI_I2C_H
 #define PI_I2C_H
 
+#include <condition_variable>
+#include <cstdint>
 #include <expected>
 #include <fcntl.h>
+#include <functional>
 #include <linux/i2c-dev.h>
 #include <linux/i2c.h>
+#include <memory>
 #include <mutex>
+#include <optional>
 #include <string>
 #include <sys/ioctl.h>
 #include <sys/stat.h>
@@ -69,6 +76,36 @@ enum class I2CError {
     IO_FAILED
 };
 
+// Periodic sensor polling yields to interactive requests (API calls, NFC, EEPROM) queued on the same bus.
+enum class I2CPriority : uint8_t {
+    Periodic = 0,
+    Interactive,
+};
+
+struct I2CSegment {
+    uint16_t address = 0;
+    bool tenBit = false;
+    bool read = false;
+    I2CBytes data; // Write payload.
+    size_t length = 0; // Read length.
+};
+
+// Segments sent back to back with repeated starts, e.g. a register write followed by a burst read, or several
+// register writes. Reads come back in the order they were added.
+class I2CTransaction {
+public:
+    I2CTransaction& write(uint16_t address, I2CBytes data, bool tenBit = false);
+    I2CTransaction& read(uint16_t address, size_t length, bool tenBit = false);
+    I2CTransaction& writeRead(uint16_t address, I2CBytes txData, size_t rxLen, bool tenBit = false);
+
+    const std::vector<I2CSegment>& segments() const;
+    size_t readCount() const;
+    bool empty() const;
+
+private:
+    std::vector<I2CSegment> segments_;
+};
+
 class ILocalI2CBus {
 public:
     virtual ~ILocalI2CBus() = default;
@@ -79,30 +116,119 @@ public:
         const I2CBytes& txData,
         size_t rxLen,
         bool tenBit = false) = 0;
+
+    // Buses that cannot combine segments run them one by one through write() and writeRead(), pairing a write
+    // with the read that follows it on the same device.
+    virtual std::expected<std::vector<I2CBytes>, I2CError> transfer(const I2CTransaction& transaction);
+};
+
+// Serialises access to one bus. A waiting interactive caller goes ahead of every waiting periodic caller;
+// within a priority callers are served in arrival order.
+class I2CBusArbiter {
+public:
+    class Grant {
+    public:
+        Grant(Grant&& other) noexcept;
+        Grant& operator=(Grant&&) = delete;
+        Grant(const Grant&) = delete;
+        Grant& operator=(const Grant&) = delete;
+        ~Grant();
+
+    private:
+        friend class I2CBusArbiter;
+        Grant(I2CBusArbiter* arbiter, I2CPriority priority);
+
+        I2CBusArbiter* arbiter_ = nullptr;
+        I2CPriority priority_ = I2CPriority::Interactive;
+    };
+
+    Grant acquire(I2CPriority priority);
+    size_t waiting(I2CPriority priority) const;
+
+private:
+    void release(I2CPriority priority);
+
+    mutable std::mutex mutex_;
+    std::condition_variable cv_;
+    bool busy_ = false;
+    I2CPriority holder_ = I2CPriority::Interactive;
+    uint64_t issued_[2] = { 0, 0 };
+    uint64_t served_[2] = { 0, 0 };
+};
+
+struct PiI2CBusStats {
+    uint64_t transactions = 0;
+    uint64_t messages = 0;
+    uint64_t syscalls = 0;
+    uint64_t deviceOpens = 0;
 };
 
 class PiI2CBus final : public ILocalI2CBus {
 public:
+    // Issues one i2c-dev ioctl (I2C_FUNCS, I2C_TENBIT, I2C_SLAVE, I2C_RDWR) on the open adapter fd.
+    using IoctlCall = std::function<int(int fd, unsigned long request, unsigned long argument)>;
+
     explicit PiI2CBus(const std::string& devicePath = "");
     ~PiI2CBus();
 
+    // Shared bus for an adapter path, so every driver on /dev/i2c-1 uses one fd and one arbiter. Returns nullptr
+    // if the path is not a character device.
+    static std::shared_ptr<PiI2CBus> forDevice(const std::string& path);
+
     bool setI2cDevicePath(const std::string& path);
     const std::string& getI2cDevicePath() const;
 
+    // Direct calls are treated as interactive; drivers polling on a timer should go through a PiI2CBusView.
     std::expected<void, I2CError> write(uint16_t address, const I2CBytes& txData, bool tenBit = false) override;
     std::expected<I2CBytes, I2CError> writeRead(
         uint16_t address,
         const I2CBytes& txData,
         size_t rxLen,
         bool tenBit = false) override;
+    std::expected<std::vector<I2CBytes>, I2CError> transfer(const I2CTransaction& transaction) override;
+    std::expected<std::vector<I2CBytes>, I2CError> transfer(const I2CTransaction& transaction, I2CPriority priority);
+
+    PiI2CBusStats stats() const;
+    // Replaces ::ioctl() for the requests above, so a benchmark or test can emulate an adapter behind any fd.
+    void setIoctlCall(IoctlCall call);
 
 private:
+    std::expected<std::vector<I2CBytes>, I2CError> transferLocked(const I2CTransaction& transaction);
+    std::expected<void, I2CError> writeWithSlaveLocked(const I2CSegment& segment);
     bool validateAddress(uint16_t address, bool tenBit) const;
-    bool bindAddress(int fd, uint16_t address, bool tenBit) const;
-    int openDevice() const;
+    bool bindAddressLocked(uint16_t address, bool tenBit);
+    bool ensureOpenLocked();
+    void closeLocked();
+    void dropDeviceOnFatalError(int error);
+    int ioctlLocked(unsigned long request, unsigned long argument);
 
+    I2CBusArbiter arbiter_;
     mutable std::mutex mutex_;
     std::string i2cDevicePath_;
+    int fd_ = -1;
+    bool combinedTransfersSupported_ = true;
+    std::optional<std::pair<uint16_t, bool>> boundSlave_;
+    PiI2CBusStats stats_;
+    IoctlCall ioctlCall_;
+};
+
+// ILocalI2CBus handle that submits everything to a shared PiI2CBus at one priority, so drivers stay unaware
+// of arbitration.
+class PiI2CBusView final : public ILocalI2CBus {
+public:
+    PiI2CBusView(std::shared_ptr<PiI2CBus> bus, I2CPriority priority);
+
+    std::expected<void, I2CError> write(uint16_t address, const I2CBytes& txData, bool tenBit = false) override;
+    std::expected<I2CBytes, I2CError> writeRead(
+        uint16_t address,
+        const I2CBytes& txData,
+        size_t rxLen,
+        bool tenBit = false) override;
+    std::expected<std::vector<I2CBytes>, I2CError> transfer(const I2CTransaction& transaction) override;
+
+private:
+    std::shared_ptr<PiI2CBus> bus_;
+    I2CPriority priority_ = I2CPriority::Interactive;
 };
 
 using I2C = PiI2CBus;
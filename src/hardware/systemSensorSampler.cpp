@@ -0,0 +1,352 @@
+/*
+███████╗██╗   ██╗███████╗████████╗███████╗███╗   ███╗███████╗███████╗███╗   ██╗███████╗ ██████╗ ██████╗ ███████╗ █████╗ ███╗   ███╗██████╗ ██╗     ███████╗██████╗     ██████╗██████╗ ██████╗
+██╔════╝╚██╗ ██╔╝██╔════╝╚══██╔══╝██╔════╝████╗ ████║██╔════╝██╔════╝████╗  ██║██╔════╝██╔═══██╗██╔══██╗██╔════╝██╔══██╗████╗ ████║██╔══██╗██║     ██╔════╝██╔══██╗   ██╔════╝██╔══██╗██╔══██╗
+███████╗ ╚████╔╝ ███████╗   ██║   █████╗  ██╔████╔██║███████╗█████╗  ██╔██╗ ██║███████╗██║   ██║██████╔╝███████╗███████║██╔████╔██║██████╔╝██║     █████╗  ██████╔╝   ██║     ██████╔╝██████╔╝
+╚════██║  ╚██╔╝  ╚════██║   ██║   ██╔══╝  ██║╚██╔╝██║╚════██║██╔══╝  ██║╚██╗██║╚════██║██║   ██║██╔══██╗╚════██║██╔══██║██║╚██╔╝██║██╔═══╝ ██║     ██╔══╝  ██╔══██╗   ██║     ██╔═══╝ ██╔═══╝
+███████║   ██║   ███████║   ██║   ███████╗██║ ╚═╝ ██║███████║███████╗██║ ╚████║███████║╚██████╔╝██║  ██║███████║██║  ██║██║ ╚═╝ ██║██║     ███████╗███████╗██║  ██║██╗╚██████╗██║     ██║
+╚══════╝   ╚═╝   ╚══════╝   ╚═╝   ╚══════╝╚═╝     ╚═╝╚══════╝╚══════╝╚═╝  ╚═══╝╚══════╝ ╚═════╝ ╚═╝  ╚═╝╚══════╝╚═╝  ╚═╝╚═╝     ╚═╝╚═╝     ╚══════╝╚══════╝╚═╝  ╚═╝╚═╝ ╚═════╝╚═╝     ╚═╝
+*/
+
+/*
+MIT License
+
+Copyright (c) 2026 A-McD Technology LLC
+*/
+
+
+#include "systemSensorSampler.h"
+
+#include <logger.h>
+
+#include <algorithm>
+#include <charconv>
+#include <cmath>
+#include <limits>
+#include <string_view>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr double kMissingReading = std::numeric_limits<double>::quiet_NaN();
+constexpr size_t kProcStatTimeFields = 8; // user nice system idle iowait irq softirq steal
+
+int openReadOnly(const std::filesystem::path& path)
+{
+    return ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+}
+
+void closeIfOpen(int& fd)
+{
+    if (fd >= 0) {
+        ::close(fd);
+        fd = -1;
+    }
+}
+
+std::string_view skipBlanks(std::string_view text)
+{
+    const size_t start = text.find_first_not_of(" \t");
+    return start == std::string_view::npos ? std::string_view {} : text.substr(start);
+}
+
+template <typename T>
+std::optional<T> parseLeading(std::string_view& text)
+{
+    text = skipBlanks(text);
+    T value {};
+    const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (error != std::errc {}) {
+        return std::nullopt;
+    }
+    text.remove_prefix(static_cast<size_t>(end - text.data()));
+    return value;
+}
+
+// The number after "Key:" on the line that starts with key, e.g. "MemAvailable:   524288 kB".
+std::optional<uint64_t> valueForKey(std::string_view text, std::string_view key)
+{
+    size_t lineStart = 0;
+    while (lineStart < text.size()) {
+        std::string_view line = text.substr(lineStart);
+        if (line.starts_with(key)) {
+            line.remove_prefix(key.size());
+            return parseLeading<uint64_t>(line);
+        }
+        const size_t nextLine = text.find('\n', lineStart);
+        if (nextLine == std::string_view::npos) {
+            break;
+        }
+        lineStart = nextLine + 1;
+    }
+    return std::nullopt;
+}
+
+// Calls visit(slot, total, idle) for each "cpu" line of /proc/stat: slot 0 is the aggregate, N + 1 is cpuN.
+template <typename Visitor>
+void forEachCpuLine(std::string_view text, Visitor&& visit)
+{
+    while (text.starts_with("cpu")) {
+        const size_t lineEnd = std::min(text.find('\n'), text.size());
+        std::string_view line = text.substr(3, lineEnd - 3);
+        size_t slot = 0;
+        if (!line.starts_with(' ')) {
+            const auto core = parseLeading<size_t>(line);
+            if (!core) {
+                return;
+            }
+            slot = *core + 1;
+        }
+
+        uint64_t total = 0;
+        uint64_t idle = 0;
+        for (size_t field = 0; field < kProcStatTimeFields; ++field) {
+            const auto value = parseLeading<uint64_t>(line);
+            if (!value) {
+                break;
+            }
+            total += *value;
+            if (field == 3 || field == 4) {
+                idle += *value;
+            }
+        }
+        visit(slot, total, idle);
+
+        if (lineEnd + 1 >= text.size()) {
+            return;
+        }
+        text.remove_prefix(lineEnd + 1);
+    }
+}
+
+double celsiusFromRaw(double raw)
+{
+    // Same rule as HardwareInfo: sysfs reports millidegrees, a few drivers report degrees.
+    return (raw > 200.0 || raw < -100.0) ? raw / 1000.0 : raw;
+}
+
+} // namespace
+
+std::vector<HardwareTemperatureReading> SystemSensorSnapshot::temperatureReadings() const
+{
+    std::vector<HardwareTemperatureReading> readings;
+    if (!layout) {
+        return readings;
+    }
+    readings.reserve(layout->temperatureSensors.size());
+    for (size_t index = 0; index < layout->temperatureSensors.size(); ++index) {
+        if (std::isnan(temperaturesC[index])) {
+            continue;
+        }
+        HardwareTemperatureReading reading = layout->temperatureSensors[index];
+        reading.celsius = temperaturesC[index];
+        readings.push_back(std::move(reading));
+    }
+    return readings;
+}
+
+SystemSensorSampler::SystemSensorSampler(std::filesystem::path sysRoot, std::filesystem::path procRoot)
+    : sysRoot_(std::move(sysRoot))
+    , procRoot_(std::move(procRoot))
+{
+    discover();
+}
+
+SystemSensorSampler::~SystemSensorSampler()
+{
+    for (int& fd : temperatureFds_) {
+        closeIfOpen(fd);
+    }
+    closeIfOpen(procStatFd_);
+    closeIfOpen(meminfoFd_);
+    closeIfOpen(selfStatusFd_);
+    closeIfOpen(loadavgFd_);
+}
+
+SystemSensorSampler& SystemSensorSampler::shared()
+{
+    static SystemSensorSampler sampler;
+    return sampler;
+}
+
+void SystemSensorSampler::discover()
+{
+    auto layout = std::make_shared<SystemSensorLayout>();
+    layout->temperatureSensors = HardwareInfo::thermalSensors(sysRoot_);
+    if (layout->temperatureSensors.size() > kMaxSystemTemperatureSensors) {
+        CubeLog::warning("SystemSensorSampler: sampling the first " + std::to_string(kMaxSystemTemperatureSensors)
+            + " of " + std::to_string(layout->temperatureSensors.size()) + " temperature sensors.");
+        layout->temperatureSensors.resize(kMaxSystemTemperatureSensors);
+    }
+    for (const auto& sensor : layout->temperatureSensors) {
+        temperatureFds_.push_back(openReadOnly(sensor.sourcePath));
+    }
+
+    procStatFd_ = openReadOnly(procRoot_ / "stat");
+    meminfoFd_ = openReadOnly(procRoot_ / "meminfo");
+    selfStatusFd_ = openReadOnly(procRoot_ / "self" / "status");
+    loadavgFd_ = openReadOnly(procRoot_ / "loadavg");
+
+    if (const auto length = readInto(procStatFd_)) {
+        forEachCpuLine(std::string_view(buffer_.data(), *length), [&layout](size_t slot, uint64_t, uint64_t) {
+            if (slot > 0) {
+                layout->cpuCoreCount = std::max(layout->cpuCoreCount, std::min(slot, kMaxSystemCpuCores));
+            }
+        });
+    }
+
+    layout_ = std::move(layout);
+    CubeLog::info("SystemSensorSampler: " + std::to_string(layout_->temperatureSensors.size()) + " temperature sensors, "
+        + std::to_string(layout_->cpuCoreCount) + " CPU cores.");
+}
+
+SystemSensorSnapshot SystemSensorSampler::sample()
+{
+    std::lock_guard<std::mutex> lock(sampleMutex_);
+    return sampleLocked();
+}
+
+SystemSensorSnapshot SystemSensorSampler::latest(std::chrono::milliseconds maxAge)
+{
+    std::lock_guard<std::mutex> lock(sampleMutex_);
+    {
+        std::lock_guard<std::mutex> publishLock(publishMutex_);
+        if (published_.sequence != 0 && std::chrono::steady_clock::now() - published_.sampledAt < maxAge) {
+            return published_;
+        }
+    }
+    return sampleLocked();
+}
+
+SystemSensorSnapshot SystemSensorSampler::published() const
+{
+    std::lock_guard<std::mutex> lock(publishMutex_);
+    return published_;
+}
+
+size_t SystemSensorSampler::openHandleCount() const
+{
+    size_t count = 0;
+    for (int fd : { procStatFd_, meminfoFd_, selfStatusFd_, loadavgFd_ }) {
+        count += fd >= 0 ? 1 : 0;
+    }
+    for (int fd : temperatureFds_) {
+        count += fd >= 0 ? 1 : 0;
+    }
+    return count;
+}
+
+SystemSensorSnapshot SystemSensorSampler::sampleLocked()
+{
+    SystemSensorSnapshot snapshot;
+    snapshot.layout = layout_;
+    readTemperatures(snapshot);
+    readCpuUsage(snapshot);
+    readMemory(snapshot);
+    readLoadAverage(snapshot);
+    snapshot.sequence = nextSequence_++;
+    snapshot.sampledAt = std::chrono::steady_clock::now();
+
+    std::lock_guard<std::mutex> lock(publishMutex_);
+    published_ = snapshot;
+    return snapshot;
+}
+
+void SystemSensorSampler::readTemperatures(SystemSensorSnapshot& snapshot)
+{
+    snapshot.temperaturesC.fill(kMissingReading);
+    for (size_t index = 0; index < temperatureFds_.size(); ++index) {
+        const auto length = readInto(temperatureFds_[index]);
+        if (!length) {
+            continue;
+        }
+        std::string_view text(buffer_.data(), *length);
+        const auto raw = parseLeading<double>(text);
+        if (!raw) {
+            continue;
+        }
+
+        const double celsius = celsiusFromRaw(*raw);
+        snapshot.temperaturesC[index] = celsius;
+        if (!snapshot.systemTemperatureC || celsius > *snapshot.systemTemperatureC) {
+            snapshot.systemTemperatureC = celsius;
+        }
+        if (layout_->temperatureSensors[index].cpuLike
+            && (!snapshot.cpuTemperatureC || celsius > *snapshot.cpuTemperatureC)) {
+            snapshot.cpuTemperatureC = celsius;
+        }
+    }
+}
+
+void SystemSensorSampler::readCpuUsage(SystemSensorSnapshot& snapshot)
+{
+    snapshot.coreUsagePercent.fill(kMissingReading);
+    const auto length = readInto(procStatFd_);
+    if (!length) {
+        return;
+    }
+
+    const bool havePrevious = havePreviousCpuTimes_;
+    forEachCpuLine(std::string_view(buffer_.data(), *length), [&](size_t slot, uint64_t total, uint64_t idle) {
+        if (slot > kMaxSystemCpuCores) {
+            return;
+        }
+        const uint64_t totalDelta = total - previousCpuTotal_[slot];
+        const uint64_t idleDelta = idle - previousCpuIdle_[slot];
+        if (havePrevious && total > previousCpuTotal_[slot] && idle >= previousCpuIdle_[slot]) {
+            const double busyPercent = 100.0 * (1.0 - static_cast<double>(idleDelta) / static_cast<double>(totalDelta));
+            if (slot == 0) {
+                snapshot.cpuUsagePercent = busyPercent;
+            } else {
+                snapshot.coreUsagePercent[slot - 1] = busyPercent;
+            }
+        }
+        previousCpuTotal_[slot] = total;
+        previousCpuIdle_[slot] = idle;
+    });
+    havePreviousCpuTimes_ = true;
+}
+
+void SystemSensorSampler::readMemory(SystemSensorSnapshot& snapshot)
+{
+    if (const auto length = readInto(meminfoFd_)) {
+        const std::string_view text(buffer_.data(), *length);
+        snapshot.memoryTotalKb = valueForKey(text, "MemTotal:");
+        snapshot.memoryAvailableKb = valueForKey(text, "MemAvailable:");
+    }
+    if (const auto length = readInto(selfStatusFd_)) {
+        snapshot.processRssKb = valueForKey(std::string_view(buffer_.data(), *length), "VmRSS:");
+    }
+}
+
+void SystemSensorSampler::readLoadAverage(SystemSensorSnapshot& snapshot)
+{
+    const auto length = readInto(loadavgFd_);
+    if (!length) {
+        return;
+    }
+    std::string_view text(buffer_.data(), *length);
+    std::array<double, 3> load {};
+    for (double& value : load) {
+        const auto parsed = parseLeading<double>(text);
+        if (!parsed) {
+            return;
+        }
+        value = *parsed;
+    }
+    snapshot.loadAverage = load;
+}
+
+std::optional<size_t> SystemSensorSampler::readInto(int fd)
+{
+    if (fd < 0) {
+        return std::nullopt;
+    }
+    // sysfs and seq_file-backed procfs files regenerate their contents on a read at offset 0.
+    const ssize_t length = ::pread(fd, buffer_.data(), buffer_.size(), 0);
+    if (length <= 0) {
+        return std::nullopt;
+    }
+    return static_cast<size_t>(length);
+}
@@ -0,0 +1,125 @@
+/*
+███████╗██╗   ██╗███████╗████████╗███████╗███╗   ███╗███████╗███████╗███╗   ██╗███████╗ ██████╗ ██████╗ ███████╗ █████╗ ███╗   ███╗██████╗ ██╗     ███████╗██████╗    ██╗  ██╗
+██╔════╝╚██╗ ██╔╝██╔════╝╚══██╔══╝██╔════╝████╗ ████║██╔════╝██╔════╝████╗  ██║██╔════╝██╔═══██╗██╔══██╗██╔════╝██╔══██╗████╗ ████║██╔══██╗██║     ██╔════╝██╔══██╗   ██║  ██║
+███████╗ ╚████╔╝ ███████╗   ██║   █████╗  ██╔████╔██║███████╗█████╗  ██╔██╗ ██║███████╗██║   ██║██████╔╝███████╗███████║██╔████╔██║██████╔╝██║     █████╗  ██████╔╝   ███████║
+╚════██║  ╚██╔╝  ╚════██║   ██║   ██╔══╝  ██║╚██╔╝██║╚════██║██╔══╝  ██║╚██╗██║╚════██║██║   ██║██╔══██╗╚════██║██╔══██║██║╚██╔╝██║██╔═══╝ ██║     ██╔══╝  ██╔══██╗   ██╔══██║
+███████║   ██║   ███████║   ██║   ███████╗██║ ╚═╝ ██║███████║███████╗██║ ╚████║███████║╚██████╔╝██║  ██║███████║██║  ██║██║ ╚═╝ ██║██║     ███████╗███████╗██║  ██║██╗██║  ██║
+╚══════╝   ╚═╝   ╚══════╝   ╚═╝   ╚══════╝╚═╝     ╚═╝╚══════╝╚══════╝╚═╝  ╚═══╝╚══════╝ ╚═════╝ ╚═╝  ╚═╝╚══════╝╚═╝  ╚═╝╚═╝     ╚═╝╚═╝     ╚══════╝╚══════╝╚═╝  ╚═╝╚═╝╚═╝  ╚═╝
+*/
+
+/*
+MIT License
+
+Copyright (c) 2026 A-McD Technology LLC
+*/
+
+
+/*
+This file defines the shared sampler for host health sensors: thermal zones (or hwmon inputs), per-core CPU
+usage, memory, and load average. Sensors are discovered once and kept open; every sample pread()s them into
+a fixed buffer and parses in place, then publishes one timestamped snapshot that the fan loop, hardware info,
+the API, and the CPU/memory monitor all read instead of walking /sys and /proc themselves.
+*/
+
+#pragma once
+#ifndef SYSTEMSENSORSAMPLER_H
+#define SYSTEMSENSORSAMPLER_H
+
+#include "hardwareInfo.h"
+
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+constexpr size_t kMaxSystemTemperatureSensors = 16;
+constexpr size_t kMaxSystemCpuCores = 16;
+
+// Fixed at discovery and shared by every snapshot, so snapshots copy without allocating.
+struct SystemSensorLayout {
+    std::vector<HardwareTemperatureReading> temperatureSensors;
+    size_t cpuCoreCount = 0;
+};
+
+struct SystemSensorSnapshot {
+    uint64_t sequence = 0;
+    std::chrono::steady_clock::time_point sampledAt {};
+    std::shared_ptr<const SystemSensorLayout> layout;
+
+    // Indexed like layout->temperatureSensors; NaN when a sensor could not be read this time.
+    std::array<double, kMaxSystemTemperatureSensors> temperaturesC {};
+    std::optional<double> cpuTemperatureC;
+    std::optional<double> systemTemperatureC;
+
+    // Busy share since the previous sample; empty/NaN on the first sample.
+    std::optional<double> cpuUsagePercent;
+    std::array<double, kMaxSystemCpuCores> coreUsagePercent {};
+
+    std::optional<uint64_t> memoryTotalKb;
+    std::optional<uint64_t> memoryAvailableKb;
+    std::optional<uint64_t> processRssKb;
+    std::optional<std::array<double, 3>> loadAverage;
+
+    std::vector<HardwareTemperatureReading> temperatureReadings() const;
+};
+
+class SystemSensorSampler {
+public:
+    // Snapshots younger than this are reused by latest(); consumers polling less often than this all share one read.
+    static constexpr std::chrono::milliseconds kDefaultMaxAge { 500 };
+
+    explicit SystemSensorSampler(
+        std::filesystem::path sysRoot = "/sys",
+        std::filesystem::path procRoot = "/proc");
+    ~SystemSensorSampler();
+
+    SystemSensorSampler(const SystemSensorSampler&) = delete;
+    SystemSensorSampler& operator=(const SystemSensorSampler&) = delete;
+
+    // Process-wide sampler over the real /sys and /proc.
+    static SystemSensorSampler& shared();
+
+    // Reads every sensor now and publishes the result.
+    SystemSensorSnapshot sample();
+    // The published snapshot, sampled first if it is missing or older than maxAge.
+    SystemSensorSnapshot latest(std::chrono::milliseconds maxAge = kDefaultMaxAge);
+    // The published snapshot as is (sequence 0 before the first sample).
+    SystemSensorSnapshot published() const;
+
+    size_t openHandleCount() const;
+
+private:
+    void discover();
+    SystemSensorSnapshot sampleLocked();
+    void readTemperatures(SystemSensorSnapshot& snapshot);
+    void readCpuUsage(SystemSensorSnapshot& snapshot);
+    void readMemory(SystemSensorSnapshot& snapshot);
+    void readLoadAverage(SystemSensorSnapshot& snapshot);
+    std::optional<size_t> readInto(int fd);
+
+    std::filesystem::path sysRoot_;
+    std::filesystem::path procRoot_;
+
+    std::mutex sampleMutex_;
+    std::shared_ptr<const SystemSensorLayout> layout_;
+    std::vector<int> temperatureFds_;
+    int procStatFd_ = -1;
+    int meminfoFd_ = -1;
+    int selfStatusFd_ = -1;
+    int loadavgFd_ = -1;
+    std::array<char, 4096> buffer_ {};
+    bool havePreviousCpuTimes_ = false;
+    std::array<uint64_t, kMaxSystemCpuCores + 1> previousCpuTotal_ {};
+    std::array<uint64_t, kMaxSystemCpuCores + 1> previousCpuIdle_ {};
+    uint64_t nextSequence_ = 1;
+
+    mutable std::mutex publishMutex_;
+    SystemSensorSnapshot published_;
+};
+
+#endif
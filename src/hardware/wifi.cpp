@@ -31,37 +31,24 @@ OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
 SOFTWARE.
 */
 
-// TODO: all of te nmcli commands can use the -t flag to get a terse version of the output. This is easier to parse and has fewer spaces. This should make it faster(?).
-// TODO: refactor all the nmcli commands so that the function that use it can have a more reusable version.
-
 #include "wifi.h"
+#include "networkState.h"
+
+namespace {
+
+constexpr unsigned kConnectionParts = NETWORK_REFRESH_DEVICES | NETWORK_REFRESH_ADDRESSES | NETWORK_REFRESH_ACCESS_POINTS;
+
+} // namespace
+
+std::mutex WifiManager::lifecycleMutex;
+bool WifiManager::stopped = false;
 
-static std::string get_nmcliField_deviceList(const std::string& field);
-static std::string get_nmcliField_deviceShow(const std::string& field, const std::string& device);
-static std::string get_nmcliField_deviceShow_find(const std::string& field, const std::string& searchString, const std::string& device);
-static std::string get_nmcliField_deviceListActive(const std::string& field, const std::string& device);
-static std::string get_nmcliField_deviceShow(const std::vector<std::string>& fields, const std::string& device);
-static std::string get_nmcliField_deviceListActive(const std::vector<std::string>& fields, const std::string& device);
-static std::vector<std::string> get_nmcliField_deviceListAll(const std::string& field);
-static std::vector<std::string> get_nmcliField_deviceListAll(const std::vector<std::string>& fields);
-static std::string stringTrim(std::string& str);
-static std::string executeCommand(const std::string& command);
-static std::string sanitizeInput(const std::string& input);
-static std::string findDevice();
-std::string replaceAll(std::string& str, const std::string& from, const std::string& to);
-
-std::vector<WifiInfo> WifiManager::networks = std::vector<WifiInfo>();
-std::jthread WifiManager::loopThread;
-std::mutex WifiManager::mutex;
-bool WifiManager::running = true;
-WifiInfo WifiManager::currentNetwork = WifiInfo();
-std::string WifiManager::devName = "";
-std::mutex WifiManager::commandMutex;
-
-// TODO: finish implementing the WifiManager class
 WifiManager::WifiManager()
 {
-    // GlobalSettings::setSetting(GlobalSettings::SettingType::WIFI_ENABLED,
+    {
+        std::lock_guard<std::mutex> lock(lifecycleMutex);
+        stopped = false;
+    }
     GlobalSettings::setSettingCB(GlobalSettings::SettingType::WIFI_ENABLED, [](const nlohmann::json& value) {
         if (value.get<bool>()) {
             WifiManager::enable();
@@ -69,34 +56,40 @@ WifiManager::WifiManager()
             WifiManager::disable();
         }
     });
-    devName = findDevice();
-    loopThread = std::jthread([&]() {
-        while (true) {
-            genericSleep(100); // Sleep first so that the mutex doesn't cause a deadlock
-            // Do stuff
-            if (WifiManager::networks.size() == 0) {
-                WifiManager::getNetworks(true);
-                for (auto n : getSavedNetworks()) {
-                    CubeLog::debugSilly("Saved network: " + n.ssid);
-                }
-
-                for(auto n: networks){
-                    CubeLog::debugSilly("Available Network: " + n.ssid + (n.connected ? " (Connected)" : ""));
-                }
-            }
-            std::unique_lock<std::mutex> lock(mutex);
-            if (!running)
-                break;
-        }
-    });
+    const auto state = networkState().snapshot();
+    for (const auto& network : getSavedNetworks()) {
+        CubeLog::debugSilly("Saved network: " + network.ssid);
+    }
+    for (const auto& network : state->accessPoints) {
+        CubeLog::debugSilly("Available Network: " + network.ssid + (network.connected ? " (Connected)" : ""));
+    }
 }
 
 WifiManager::~WifiManager()
 {
-    std::unique_lock<std::mutex> lock(mutex);
-    running = false;
-    lock.unlock();
-    loopThread.join();
+    std::lock_guard<std::mutex> lock(lifecycleMutex);
+    stopped = true;
+    service().stop();
+}
+
+NetworkStateService& WifiManager::service()
+{
+    static NetworkStateService service;
+    return service;
+}
+
+NetworkStateService& WifiManager::networkState()
+{
+    std::lock_guard<std::mutex> lock(lifecycleMutex);
+    if (!stopped) {
+        service().start();
+    }
+    return service();
+}
+
+std::string WifiManager::wifiDevice()
+{
+    return networkState().snapshot()->wifiDevice;
 }
 
 /**
@@ -106,8 +99,8 @@ WifiManager::~WifiManager()
  */
 bool WifiManager::enable()
 {
-    std::string result = executeCommand("nmcli radio wifi on 2>&1");
-    return result.empty();
+    const auto result = networkState().run({ "nmcli", "radio", "wifi", "on" }, NETWORK_REFRESH_RADIO | kConnectionParts);
+    return result.exitCode == 0;
 }
 
 /**
@@ -117,238 +110,120 @@ bool WifiManager::enable()
  */
 bool WifiManager::disable()
 {
-    std::string result = executeCommand("nmcli radio wifi off 2>&1");
-    return result.empty();
+    const auto result = networkState().run({ "nmcli", "radio", "wifi", "off" }, NETWORK_REFRESH_RADIO | kConnectionParts);
+    return result.exitCode == 0;
 }
 
+/**
+ * @brief Rescan for access points. Rescans are rate limited and concurrent callers share one scan.
+ *
+ * @return true if the cached access point list is current
+ */
 bool WifiManager::scan()
 {
-    if (WifiManager::devName.empty() || WifiManager::devName == "") {
-        devName = findDevice();
-    }
-    if (WifiManager::devName.empty() || WifiManager::devName == "") {
+    if (wifiDevice().empty()) {
         return false;
     }
-    networks.clear();
-    executeCommand("nmcli device wifi rescan 2>&1");
-    std::vector<std::string> fieldsToGet = { "SSID", "SIGNAL", "SECURITY", "BSSID", "FREQ", "CHAN", "RATE", "IN-USE" };
-    std::vector<std::string> output = get_nmcliField_deviceListAll(fieldsToGet);
-    std::map<std::string, std::string> columnToData;
-    for (auto line : output) {
-        if (line.empty())
-            continue;
-        WifiInfo network;
-        std::istringstream iss(line);
-        std::string field;
-        for (auto c : fieldsToGet) {
-            if(c == "BSSID"){
-                std::string mac;
-                std::getline(iss, mac, ':');
-                mac += ":";
-                std::getline(iss, field, ':');
-                mac += field + ":";
-                std::getline(iss, field, ':');
-                mac += field + ":";
-                std::getline(iss, field, ':');
-                mac += field + ":";
-                std::getline(iss, field, ':');
-                mac += field + ":";
-                std::getline(iss, field, ':');
-                mac += field;
-                replaceAll(mac, "\\:", ":");
-                columnToData[c] = mac;
-            }else{
-                std::getline(iss, field, ':');
-                columnToData[c] = stringTrim(field);
-            }
-        }
-        network.ssid = columnToData["SSID"];
-        network.signalStrength = columnToData["SIGNAL"];
-        network.securityType = columnToData["SECURITY"];
-        network.mac = columnToData["BSSID"];
-        network.frequency = columnToData["FREQ"];
-        network.channel = columnToData["CHAN"];
-        network.bitrate = columnToData["RATE"];
-        network.connected = columnToData["IN-USE"] == "*";
-
-        if (network.connected) {
-            std::string returnString = get_nmcliField_deviceShow("IP4.ADDRESS", devName);
-            network.ip = returnString.substr(0, returnString.find("/"));
-            // convert the int subnet to ip
-            network.subnet = strtol(returnString.substr(returnString.find("/") + 1).c_str(), NULL, 10);
-            network.gateway = get_nmcliField_deviceShow("IP4.GATEWAY", devName);
-            stringTrim(network.gateway.ip);
-            network.dns1 = get_nmcliField_deviceShow_find("IP4.DNS", "DNS[1]", devName);
-            network.dns2 = get_nmcliField_deviceShow_find("IP4.DNS", "DNS[2]", devName);
-            network.dns3 = get_nmcliField_deviceShow_find("IP4.DNS", "DNS[3]", devName);
-            network.dhcp = get_nmcliField_deviceShow_find("DHCP4.OPTION", "dhcp_server_identifier", devName);
-            returnString = get_nmcliField_deviceShow_find("DHCP4.OPTION", "lease_time", devName);
-            network.dhcpLease = strtol(returnString.substr(returnString.find("=") + 2).c_str(), NULL, 10);
-        }
-        networks.push_back(network);
-    }
-    return true;
+    return networkState().scan();
 }
 
 std::vector<std::string> WifiManager::getNetworks(bool refresh)
 {
     if (refresh) {
-        networks.clear();
         scan();
     }
     std::vector<std::string> networkList;
-    for (auto& network : networks) {
+    for (const auto& network : networkState().snapshot()->accessPoints) {
         networkList.push_back(network.ssid);
     }
     return networkList;
 }
 
+// Arguments go to nmcli as argv entries without a shell, so SSIDs and passwords need no quoting.
 bool WifiManager::connect(const std::string& network, const std::string& password)
 {
-    sanitizeInput(network);
-    sanitizeInput(password);
-    std::string result = executeCommand("nmcli device wifi connect \"" + network + "\" password \"" + password + "\" 2>&1");
-    return result.empty();
+    const auto result = networkState().run({ "nmcli", "device", "wifi", "connect", network, "password", password }, kConnectionParts);
+    return result.exitCode == 0;
 }
 
 bool WifiManager::forgetNetwork(const std::string& network)
 {
-    sanitizeInput(network);
-    std::string result = executeCommand("nmcli connection delete \"" + network + "\" 2>&1");
-    return result.empty();
+    const auto result = networkState().run({ "nmcli", "connection", "delete", network }, kConnectionParts);
+    return result.exitCode == 0;
 }
 
 bool WifiManager::disconnect()
 {
-    std::string result = executeCommand("nmcli device disconnect wlan0 2>&1");
-    return result.empty();
+    const std::string device = wifiDevice();
+    const auto result = networkState().run({ "nmcli", "device", "disconnect", device.empty() ? "wlan0" : device }, kConnectionParts);
+    return result.exitCode == 0;
 }
 
 bool WifiManager::isConnected()
 {
-    std::string output = get_nmcliField_deviceListActive("IN-USE", devName);
-    return output.find("*") != std::string::npos;
+    return networkState().snapshot()->connected;
 }
 
-// TODO: many of the functions below use the same boilerplate code, consider refactoring.
-
 IP_Address WifiManager::getIP()
 {
-    if (WifiManager::devName.empty() || WifiManager::devName == "")
-        devName = findDevice();
-    if (WifiManager::devName.empty() || WifiManager::devName == "")
-        return false;
-    std::string output = get_nmcliField_deviceShow("IP4.ADDRESS", devName);
-    return IP_Address(stringTrim(output));
+    return networkState().snapshot()->active.ip;
 }
 
 CIDR_Subnet WifiManager::getSubnet()
 {
-    if (WifiManager::devName.empty() || WifiManager::devName == "")
-        devName = findDevice();
-    if (WifiManager::devName.empty() || WifiManager::devName == "")
-        return false;
-    std::string output = get_nmcliField_deviceShow("IP4.ADDRESS", devName);
-    output = output.substr(output.find("/") + 1);
-    return CIDR_Subnet(strtol(stringTrim(output).c_str(), NULL, 10));
+    return networkState().snapshot()->active.subnet;
 }
 
 IP_Address WifiManager::getGateway()
 {
-    if (WifiManager::devName.empty() || WifiManager::devName == "")
-        devName = findDevice();
-    if (WifiManager::devName.empty() || WifiManager::devName == "")
-        return false;
-    std::string output = get_nmcliField_deviceShow("IP4.GATEWAY", devName);
-    return IP_Address(stringTrim(output));
+    return networkState().snapshot()->active.gateway;
 }
 
 std::vector<IP_Address> WifiManager::getDNS()
 {
-    if (WifiManager::devName.empty() || WifiManager::devName == "")
-        devName = findDevice();
-    if (WifiManager::devName.empty() || WifiManager::devName == "")
-        return std::vector<IP_Address>();
-    std::string output = get_nmcliField_deviceShow_find("IP4.DNS", "DNS[1]", devName);
+    const auto state = networkState().snapshot();
     std::vector<IP_Address> dnsList;
-    dnsList.push_back(IP_Address(stringTrim(output)));
-    output = get_nmcliField_deviceShow_find("IP4.DNS", "DNS[2]", devName);
-    if (output.length() > 1)
-        dnsList.push_back(IP_Address(stringTrim(output)));
-    output = get_nmcliField_deviceShow_find("IP4.DNS", "DNS[3]", devName);
-    if (output.length() > 1)
-        dnsList.push_back(IP_Address(stringTrim(output)));
+    for (const auto& dns : { state->active.dns1, state->active.dns2, state->active.dns3 }) {
+        if (!dns.ip.empty()) {
+            dnsList.push_back(dns);
+        }
+    }
     return dnsList;
 }
 
 std::string WifiManager::getAP_MAC()
 {
-    if (WifiManager::devName.empty() || WifiManager::devName == "")
-        devName = findDevice();
-    if (WifiManager::devName.empty() || WifiManager::devName == "")
-        return "";
-    std::string output = get_nmcliField_deviceListActive("BSSID", devName);
-    return stringTrim(output);
+    return networkState().snapshot()->active.mac;
 }
 
 std::string WifiManager::getLocalMAC()
 {
-    if (WifiManager::devName.empty() || WifiManager::devName == "")
-        devName = findDevice();
-    if (WifiManager::devName.empty() || WifiManager::devName == "")
-        return "";
-    std::string output = get_nmcliField_deviceShow("GENERAL.HWADDR", devName);
-    return stringTrim(output);
+    return networkState().snapshot()->localMac;
 }
 
 std::string WifiManager::getSSID()
 {
-    if (WifiManager::devName.empty() || WifiManager::devName == "")
-        devName = findDevice();
-    if (WifiManager::devName.empty() || WifiManager::devName == "")
-        return "";
-    std::string output = get_nmcliField_deviceListActive("SSID", devName);
-    return stringTrim(output);
+    return networkState().snapshot()->active.ssid;
 }
 
 std::string WifiManager::getSignalStrength()
 {
-    if (WifiManager::devName.empty() || WifiManager::devName == "")
-        devName = findDevice();
-    if (WifiManager::devName.empty() || WifiManager::devName == "")
-        return "";
-    std::string output = get_nmcliField_deviceListActive("SIGNAL", devName);
-    return stringTrim(output);
+    return networkState().snapshot()->active.signalStrength;
 }
 
 std::string WifiManager::getSecurityType()
 {
-    if (WifiManager::devName.empty() || WifiManager::devName == "")
-        devName = findDevice();
-    if (WifiManager::devName.empty() || WifiManager::devName == "")
-        return "";
-    std::string output = get_nmcliField_deviceListActive("SECURITY", devName);
-    return stringTrim(output);
+    return networkState().snapshot()->active.securityType;
 }
 
 std::string WifiManager::getFrequency()
 {
-    if (WifiManager::devName.empty() || WifiManager::devName == "")
-        devName = findDevice();
-    if (WifiManager::devName.empty() || WifiManager::devName == "")
-        return "";
-    std::string output = get_nmcliField_deviceListActive("FREQ", devName);
-    return stringTrim(output);
+    return networkState().snapshot()->active.frequency;
 }
 
 std::string WifiManager::getChannel()
 {
-    if (WifiManager::devName.empty() || WifiManager::devName == "")
-        devName = findDevice();
-    if (WifiManager::devName.empty() || WifiManager::devName == "")
-        return "";
-    std::string output = get_nmcliField_deviceListActive("CHAN", devName);
-    return stringTrim(output);
+    return networkState().snapshot()->active.channel;
 }
 
 bool WifiManager::setProxy(const IP_Address& ip, const std::string& port)
@@ -358,263 +233,83 @@ bool WifiManager::setProxy(const IP_Address& ip, const std::string& port)
 
 bool WifiManager::setDNS(const IP_Address& dns)
 {
-    if (WifiManager::devName.empty() || WifiManager::devName == "")
-        devName = findDevice();
-    if (WifiManager::devName.empty() || WifiManager::devName == "")
+    const std::string device = wifiDevice();
+    if (device.empty())
         return false;
-    std::string result = executeCommand("nmcli connection modify " + devName + " ipv4.dns \"" + dns.ip + "\" 2>&1");
-    return result.empty();
+    const auto result = networkState().run({ "nmcli", "connection", "modify", device, "ipv4.dns", dns.ip }, NETWORK_REFRESH_ADDRESSES);
+    return result.exitCode == 0;
 }
 
 bool WifiManager::setIP(const IP_Address& ip, const IP_Address& subnet, const IP_Address& gateway)
 {
-    if (WifiManager::devName.empty() || WifiManager::devName == "")
-        devName = findDevice();
-    if (WifiManager::devName.empty() || WifiManager::devName == "")
+    const std::string device = wifiDevice();
+    if (device.empty())
         return false;
-    std::string result = executeCommand("nmcli connection modify " + devName + " ipv4.method manual ipv4.addresses \"" + ip.ip + "/" + subnet.ip + "\" ipv4.gateway \"" + gateway.ip + "\" 2>&1");
-    return result.empty();
+    const auto result = networkState().run(
+        { "nmcli", "connection", "modify", device, "ipv4.method", "manual", "ipv4.addresses", ip.ip + "/" + subnet.ip, "ipv4.gateway", gateway.ip },
+        NETWORK_REFRESH_ADDRESSES);
+    return result.exitCode == 0;
 }
 
 bool WifiManager::setHostname(const std::string& hostname)
 {
-    if (WifiManager::devName.empty() || WifiManager::devName == "")
-        devName = findDevice();
-    if (WifiManager::devName.empty() || WifiManager::devName == "")
+    const std::string device = wifiDevice();
+    if (device.empty())
         return false;
-    std::string result = executeCommand("nmcli connection modify " + devName + " connection.autoconnect-priority 0 2>&1");
-    return result.empty();
+    const auto result = networkState().run({ "nmcli", "connection", "modify", device, "connection.autoconnect-priority", "0" }, 0);
+    return result.exitCode == 0;
 }
 
 bool WifiManager::setDHCP(bool enable)
 {
-    if (WifiManager::devName.empty() || WifiManager::devName == "")
-        devName = findDevice();
-    if (WifiManager::devName.empty() || WifiManager::devName == "")
+    const std::string device = wifiDevice();
+    if (device.empty())
         return false;
-    std::string result = executeCommand("nmcli connection modify " + devName + " connection.autoconnect-priority 0 2>&1");
-    return result.empty();
+    const auto result = networkState().run({ "nmcli", "connection", "modify", device, "connection.autoconnect-priority", "0" }, 0);
+    return result.exitCode == 0;
 }
 
 bool WifiManager::setDNS(const IP_Address& dns1, const IP_Address& dns2)
 {
-    if (WifiManager::devName.empty() || WifiManager::devName == "")
-        devName = findDevice();
-    if (WifiManager::devName.empty() || WifiManager::devName == "")
+    const std::string device = wifiDevice();
+    if (device.empty())
         return false;
-    std::string result = executeCommand("nmcli connection modify " + devName + " ipv4.dns \"" + dns1.ip + " " + dns2.ip + "\" 2>&1");
-    return result.empty();
+    const auto result = networkState().run({ "nmcli", "connection", "modify", device, "ipv4.dns", dns1.ip + " " + dns2.ip }, NETWORK_REFRESH_ADDRESSES);
+    return result.exitCode == 0;
 }
 
 bool WifiManager::setVPN(const IP_Address& ip, const std::string& port, const std::string& user, const std::string& pass)
 {
-    if (WifiManager::devName.empty() || WifiManager::devName == "")
-        devName = findDevice();
-    if (WifiManager::devName.empty() || WifiManager::devName == "")
+    const std::string device = wifiDevice();
+    if (device.empty())
         return false;
-    std::string result = executeCommand("nmcli connection modify " + devName + " vpn.data \"gateway=" + ip.ip + " port=" + port + " user=" + user + " password=" + pass + "\" 2>&1");
-    return result.empty();
+    const auto result = networkState().run(
+        { "nmcli", "connection", "modify", device, "vpn.data", "gateway=" + ip.ip + " port=" + port + " user=" + user + " password=" + pass },
+        0);
+    return result.exitCode == 0;
 }
 
+// Saved connections are not part of the monitored state, so this still asks nmcli each time.
 std::vector<WifiInfo> WifiManager::getSavedNetworks()
 {
     std::vector<WifiInfo> networks;
-    std::string output = executeCommand("nmcli c 2>&1");
-    std::istringstream iss(output);
-    std::string line;
-    std::getline(iss, line);
-    int UUID_index = line.find("UUID");
-    while (std::getline(iss, line)) {
-        if (line.empty())
-            continue;
-        if (line.find("wifi") != std::string::npos) {
-            WifiInfo network;
-            auto str = line.substr(0, UUID_index);
-            ;
-            network.ssid = stringTrim(str);
-            networks.push_back(network);
-        }
-    }
-    return networks;
-}
-
-////////////////////////////////////////////////////////////////////////////////////////
-
-
-static std::string executeCommand(const std::string& command)
-{
-    std::unique_lock<std::mutex> lock(WifiManager::commandMutex); // Prevent concurrent execution
-    std::array<char, 256> buffer;
-    std::string result;
-
-    // Open pipe to file
-    std::shared_ptr<FILE> pipe(popen(command.c_str(), "r"), pclose);
-    if (!pipe) {
-        std::cerr << "popen() failed!" << std::endl;
-        return "";
-    }
-
-    // Read till end of process
-    while (!feof(pipe.get())) {
-        if (fgets(buffer.data(), buffer.size(), pipe.get()) != nullptr) {
-            result += buffer.data();
-        }
-    }
-
-    return result;
-}
-
-
-static std::string sanitizeInput(const std::string& input)
-{
-    std::string sanitized = input;
-
-    // Remove any character that is not alphanumeric or a common safe character
-    sanitized.erase(std::remove_if(sanitized.begin(), sanitized.end(),
-                        [](char c) {
-                            return !(std::isalnum(c) || c == ' ' || c == '_' || c == '-' || c == '.' || c == '/');
-                        }),
-        sanitized.end());
-
-    return sanitized;
-}
-
-static std::string stringTrim(std::string& str)
-{
-    str.erase(str.begin(), std::find_if(str.begin(), str.end(), [](int ch) {
-        return !std::isspace(ch);
-    }));
-    str.erase(std::find_if(str.rbegin(), str.rend(), [](int ch) {
-        return !std::isspace(ch);
-    }).base(),
-        str.end());
-    return str;
-}
-
-static std::string findDevice()
-{
-    std::string output = executeCommand("nmcli device show 2>&1");
-    std::istringstream iss(output);
+    const auto result = networkState().run({ "nmcli", "-t", "-f", "TYPE,NAME", "connection", "show" }, 0);
+    std::istringstream iss(result.output);
     std::string line;
-    std::string dev;
     while (std::getline(iss, line)) {
-        if (line.empty())
+        // TYPE never contains ':', so everything after the first one is the (escaped) name.
+        const size_t colon = line.find(':');
+        if (colon == std::string::npos || line.substr(0, colon) != "802-11-wireless") {
             continue;
-        if (line.find("GENERAL.DEVICE") != std::string::npos) {
-            dev = line.substr(line.find(":") + 1);
-            stringTrim(dev);
         }
-        std::string devType;
-        if (line.find("GENERAL.TYPE") != std::string::npos && line.find("wifi") != std::string::npos) {
-            return dev;
-        }
-    }
-    return "";
-}
-
-static std::string get_nmcliField_deviceShow(const std::string& field, const std::string& device)
-{
-    std::string commandReturned = executeCommand("nmcli -t -f " + field + " device show " + device + " 2>&1");
-    return commandReturned.substr(commandReturned.find(":") + 1);
-}
-
-static std::string get_nmcliField_deviceShow_find(const std::string& field, const std::string& searchString, const std::string& device)
-{
-    std::string commandReturned = executeCommand("nmcli -t -f " + field + " device show " + device + " 2>&1");
-    std::istringstream iss(commandReturned);
-    std::string line;
-    while (std::getline(iss, line)) {
-        if (line.empty())
-            continue;
-        if (line.find(searchString) != std::string::npos) {
-            return line.substr(line.find(":") + 1);
-        }
-    }
-    return "";
-}
-
-static std::string get_nmcliField_deviceListActive(const std::string& field, const std::string& device)
-{
-    std::string commandReturned = executeCommand("nmcli -t -f IN-USE," + field + " device wifi list 2>&1");
-
-    std::istringstream iss(commandReturned);
-    std::string line;
-    while (std::getline(iss, line)) {
-        if (line.empty())
-            continue;
-        if (line.find("*") != std::string::npos) {
-            return line.substr(line.find(":") + 1);
-        }
-    }
-    return "";
-}
-
-static std::vector<std::string> get_nmcliField_deviceListAll(const std::string& field)
-{
-    std::string commandReturned = executeCommand("nmcli -t -f " + field + " device wifi list 2>&1");
-    std::vector<std::string> returnVals;
-    std::istringstream iss(commandReturned);
-    std::string line;
-    while (std::getline(iss, line)) {
-        if (line.empty())
-            continue;
-        returnVals.push_back(line);
-    }
-    return returnVals;
-}
-
-static std::string get_nmcliField_deviceShow(const std::vector<std::string>& fields, const std::string& device)
-{
-    std::string fieldsConcat = "";
-    for (auto f : fields) {
-        fieldsConcat += f + ",";
-    }
-    std::string commandReturned = executeCommand("nmcli -t -f " + fieldsConcat + " device show " + device + " 2>&1");
-    return commandReturned.substr(commandReturned.find(":") + 1);
-}
-
-static std::string get_nmcliField_deviceListActive(const std::vector<std::string>& fields, const std::string& device)
-{
-    std::string fieldsConcat = "";
-    for (auto f : fields) {
-        fieldsConcat += f + ",";
-    }
-    std::string commandReturned = executeCommand("nmcli -t -f IN-USE," + fieldsConcat + " device wifi list 2>&1");
-    std::istringstream iss(commandReturned);
-    std::string line;
-    while (std::getline(iss, line)) {
-        if (line.empty())
-            continue;
-        if (line.find("*") != std::string::npos) {
-            return line.substr(line.find(":") + 1);
+        WifiInfo network;
+        for (size_t index = colon + 1; index < line.size(); ++index) {
+            if (line[index] == '\\' && index + 1 < line.size()) {
+                ++index;
+            }
+            network.ssid += line[index];
         }
+        networks.push_back(network);
     }
-    return "";
-}
-
-static std::vector<std::string> get_nmcliField_deviceListAll(const std::vector<std::string>& fields)
-{
-    std::string fieldsConcat = "";
-    for (auto f : fields) {
-        fieldsConcat += f + ",";
-    }
-    std::string commandReturned = executeCommand("nmcli -t -f " + fieldsConcat + " device wifi list 2>&1");
-    std::vector<std::string> returnVals;
-    std::istringstream iss(commandReturned);
-    std::string line;
-    while (std::getline(iss, line)) {
-        if (line.empty())
-            continue;
-        returnVals.push_back(line);
-    }
-    return returnVals;
-}
-
-std::string replaceAll(std::string& str, const std::string& from, const std::string& to) { 
-    size_t start_pos = 0; 
-    while ((start_pos = str.find(from, start_pos)) != std::string::npos) { 
-        str.replace(start_pos, from.length(), to); 
-        start_pos += to.length(); // Move past the replaced part 
-    }
-    return str;
+    return networks;
 }
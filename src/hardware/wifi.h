@@ -38,6 +38,7 @@ SOFTWARE.
 #include <functional>
 #include <iostream>
 #include <list>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <utils.h>
@@ -167,6 +168,8 @@ struct WifiInfo {
     };
 };
 
+class NetworkStateService;
+
 class WifiManager {
 public:
     WifiManager();
@@ -198,15 +201,16 @@ public:
     static bool setDNS(const IP_Address& dns1, const IP_Address& dns2);
     static bool setVPN(const IP_Address& ip, const std::string& port, const std::string& user, const std::string& pass);
     static std::vector<WifiInfo> getSavedNetworks();
-    static std::mutex commandMutex;
 
 private:
-    static std::vector<WifiInfo> networks;
-    static std::jthread loopThread;
-    static std::mutex mutex;
-    static bool running;
-    static WifiInfo currentNetwork;
-    static std::string devName;
+    // Shared cache of NetworkManager state; started on first use, but never again once the manager
+    // has stopped it. After that, queries read the last snapshot.
+    static NetworkStateService& networkState();
+    // The cache without starting it.
+    static NetworkStateService& service();
+    static std::mutex lifecycleMutex;
+    static bool stopped;
+    static std::string wifiDevice();
 };
 
 #endif // WIFI_H
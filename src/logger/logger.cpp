@@ -158,6 +158,7 @@ bool CubeLog::hasUnreadLogs_b = false;
 std::vector<unsigned int> CubeLog::readErrorIDs;
 std::vector<unsigned int> CubeLog::readLogIDs;
 std::string CubeLog::screenMessage = "";
+std::atomic<uint64_t> CubeLog::screenMessageVersion = 0;
 int CubeLog::advancedColorsEnabled = 0;
 bool CubeLog::shutdown = false;
 // spdlog file logger instance
@@ -303,6 +304,7 @@ void CubeLog::screen(const std::string& message, Logger::LogLevel level, CustomS
     CubeLog::log("Screen Message: " + message, true, level, location);
     CubeLog::screenMessage = message;
     CubeLog::lastScreenMessageTime = std::chrono::system_clock::now();
+    CubeLog::screenMessageVersion.fetch_add(1, std::memory_order_release);
 }
 
 /**
@@ -316,6 +318,17 @@ std::string CubeLog::getScreenMessage()
     return CubeLog::screenMessage;
 }
 
+/**
+ * @brief Get a counter that changes every time the screen message is set. Lets the renderer poll for a
+ * new message without taking the log mutex.
+ *
+ * @return uint64_t
+ */
+uint64_t CubeLog::getScreenMessageVersion()
+{
+    return CubeLog::screenMessageVersion.load(std::memory_order_acquire);
+}
+
 /**
  * @brief Log a debug message
  *
@@ -472,7 +485,9 @@ CubeLog::CubeLog(int advancedColorsEnabled, Logger::LogVerbosity verbosity, Logg
             std::chrono::duration<double> duration = end.time_since_epoch() - CubeLog::lastScreenMessageTime.time_since_epoch();
             // if the duration is greater than 3 seconds, clear the screen message
             if (duration.count() > 3 && CubeLog::screenMessage.length() > 0) {
-                CubeLog::screen("");
+                // screen() takes logMutex itself; clear in place while we already hold it
+                CubeLog::screenMessage = "";
+                CubeLog::screenMessageVersion.fetch_add(1, std::memory_order_release);
             }
             lock.unlock();
             std::this_thread::sleep_for(std::chrono::milliseconds(1000));
@@ -616,6 +631,51 @@ std::string getFileNameFromPath(const std::string& path)
     return p.filename().string();
 }
 
+/**
+ * @brief Check whether a message at the given level would be printed or written to the log file
+ *
+ * @param level The log level to check
+ * @return true if the console or the file logger would emit it
+ */
+bool CubeLog::isLevelEnabled(Logger::LogLevel level)
+{
+    if (level == Logger::LogLevel::LOGGER_OFF) {
+        return false;
+    }
+    if (CubeLog::consoleLoggingEnabled && level >= CubeLog::staticPrintLevel) {
+        return true;
+    }
+    if (!CubeLog::fileLogger) {
+        return false;
+    }
+    spdlog::level::level_enum spd_level = spdlog::level::info;
+    switch (level) {
+#ifdef LOGGER_TRACE_ENABLED
+    case Logger::LogLevel::LOGGER_TRACE:
+        spd_level = spdlog::level::trace;
+        break;
+#endif
+    case Logger::LogLevel::LOGGER_DEBUG_SILLY:
+    case Logger::LogLevel::LOGGER_DEBUG:
+        spd_level = spdlog::level::debug;
+        break;
+    case Logger::LogLevel::LOGGER_WARNING:
+        spd_level = spdlog::level::warn;
+        break;
+    case Logger::LogLevel::LOGGER_ERROR:
+        spd_level = spdlog::level::err;
+        break;
+    case Logger::LogLevel::LOGGER_CRITICAL:
+    case Logger::LogLevel::LOGGER_FATAL:
+        spd_level = spdlog::level::critical;
+        break;
+    default:
+        spd_level = spdlog::level::info;
+        break;
+    }
+    return CubeLog::fileLogger->should_log(spd_level);
+}
+
 /**
  * @brief Set the log level for printing to the console and writing to the log file
  *
@@ -38,6 +38,7 @@ SOFTWARE.
 #include "../api/api.h"
 #endif
 #include <algorithm>
+#include <atomic>
 #include <chrono>
 #include <filesystem>
 #include <fstream>
@@ -166,6 +167,7 @@ private:
     void purgeOldLogs();
     static bool hasUnreadErrors_b, hasUnreadLogs_b;
     static std::string screenMessage;
+    static std::atomic<uint64_t> screenMessageVersion;
     static std::vector<unsigned int> readErrorIDs, readLogIDs;
     static void log(const std::string& message, bool print, Logger::LogLevel level = Logger::LogLevel::LOGGER_INFO, CustomSourceLocation location = CustomSourceLocation::current());
     std::jthread* resetThread;
@@ -191,6 +193,9 @@ public:
     void setVerbosity(Logger::LogVerbosity verbosity);
     void setLogLevel(Logger::LogLevel printLevel, Logger::LogLevel fileLevel);
     static void setConsoleLoggingEnabled(bool enabled);
+    // True if a message at this level would reach the console or the log file. Lets callers skip
+    // formatting expensive debug output nobody will see.
+    static bool isLevelEnabled(Logger::LogLevel level);
     static CUBE_LOG_ENTRY getLatestError();
     static CUBE_LOG_ENTRY getLatestLog();
     static CUBE_LOG_ENTRY getLatestEntry();
@@ -198,6 +203,7 @@ public:
     static bool hasUnreadLogs();
     static bool hasUnreadEntries();
     static std::string getScreenMessage();
+    static uint64_t getScreenMessageVersion();
     static std::string getSizeOfCubeLog();
     // API Interface
     std::string getInterfaceName() const override;
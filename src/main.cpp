@@ -214,17 +214,12 @@ int main(int argc, char* argv[])
     CubeLog::info("Settings loaded.");
 
     /////////////////////////////////////////////////////////////////
-    // CPU and memory monitor thread
+    // CPU and memory monitor
     /////////////////////////////////////////////////////////////////
 #ifndef PRODUCTION_BUILD
-    std::jthread cpuAndMemoryThread([](std::stop_token st) {
-        unsigned long loopCount = 0;
-        while (!st.stop_requested()) {
-            if (loopCount++ % 100 == 0)
-                monitorMemoryAndCPU();
-            genericSleep(100);
-        }
-    });
+    const auto cpuAndMemoryTask = PeriodicScheduler::shared().add(
+        { "cpuAndMemoryMonitor", std::chrono::seconds(10), std::chrono::seconds(1) },
+        []() { monitorMemoryAndCPU(); });
 #endif
     /////////////////////////////////////////////////////////////////
     // Logger test
@@ -276,7 +271,12 @@ int main(int argc, char* argv[])
         auto interactionEventBridge = std::make_shared<InteractionEventBridge>(apiEventBroker);
         auto interactionApi = std::make_shared<InteractionAPI>(peripherals, apiEventBroker);
         auto eventsApi = std::make_shared<EventsAPI>(api);
+        auto metricsApi = std::make_shared<MetricsAPI>();
         auto decisions = std::make_shared<DecisionEngine::DecisionEngineMain>();
+        peripherals->setEventBroker(apiEventBroker);
+        if (auto triggerManager = decisions->getTriggerManager()) {
+            triggerManager->attachEventBroker(apiEventBroker);
+        }
 
         API_Builder api_builder(api);
         gui->registerInterface();
@@ -288,6 +288,7 @@ int main(int argc, char* argv[])
         peripherals->registerInterface();
         interactionApi->registerInterface();
         eventsApi->registerInterface();
+        metricsApi->registerInterface();
         decisions->registerInterface();
         // btManager->registerInterface();
         api_builder.start();
@@ -311,7 +312,7 @@ int main(int argc, char* argv[])
         CubeLog::info("Exited main loop...");
         CubeLog::info("CubeLog reference count: " + std::to_string(logger.use_count()));
 #ifndef PRODUCTION_BUILD
-        cpuAndMemoryThread.request_stop();
+        PeriodicScheduler::shared().remove(cpuAndMemoryTask);
 #endif
         appsManager.shutdown();
         CubeLog::info("Stopping GUI...");
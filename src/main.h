@@ -54,6 +54,8 @@ SOFTWARE.
 #include "hardware/peripheralManager.h"
 #include "hardware/wifi.h"
 #include "decisionEngine/decisions.h"
+#include "telemetry/metricsAPI.h"
+#include "periodicScheduler.h"
 #include "settings/loader.h"
 #include <chrono>
 #include <cmath>
@@ -0,0 +1,294 @@
+/*
+██████╗ ███████╗██████╗ ██╗ ██████╗ ██████╗ ██╗ ██████╗███████╗ ██████╗██╗  ██╗███████╗██████╗ ██╗   ██╗██╗     ███████╗██████╗     ██████╗██████╗ ██████╗
+██╔══██╗██╔════╝██╔══██╗██║██╔═══██╗██╔══██╗██║██╔════╝██╔════╝██╔════╝██║  ██║██╔════╝██╔══██╗██║   ██║██║     ██╔════╝██╔══██╗   ██╔════╝██╔══██╗██╔══██╗
+██████╔╝█████╗  ██████╔╝██║██║   ██║██║  ██║██║██║     ███████╗██║     ███████║█████╗  ██║  ██║██║   ██║██║     █████╗  ██████╔╝   ██║     ██████╔╝██████╔╝
+██╔═══╝ ██╔══╝  ██╔══██╗██║██║   ██║██║  ██║██║██║     ╚════██║██║     ██╔══██║██╔══╝  ██║  ██║██║   ██║██║     ██╔══╝  ██╔══██╗   ██║     ██╔═══╝ ██╔═══╝
+██║     ███████╗██║  ██║██║╚██████╔╝██████╔╝██║╚██████╗███████║╚██████╗██║  ██║███████╗██████╔╝╚██████╔╝███████╗███████╗██║  ██║██╗╚██████╗██║     ██║
+╚═╝     ╚══════╝╚═╝  ╚═╝╚═╝ ╚═════╝ ╚═════╝ ╚═╝ ╚═════╝╚══════╝ ╚═════╝╚═╝  ╚═╝╚══════╝╚═════╝  ╚═════╝ ╚══════╝╚══════╝╚═╝  ╚═╝╚═╝ ╚═════╝╚═╝     ╚═╝
+*/
+
+/*
+MIT License
+
+Copyright (c) 2026 A-McD Technology LLC
+*/
+
+
+#include "periodicScheduler.h"
+
+#include <logger.h>
+
+#include <algorithm>
+#include <cstring>
+#include <pthread.h>
+#include <sched.h>
+
+namespace {
+
+std::mutex& schedulersMutex()
+{
+    static std::mutex mutex;
+    return mutex;
+}
+
+std::vector<PeriodicScheduler*>& schedulers()
+{
+    static std::vector<PeriodicScheduler*> instances;
+    return instances;
+}
+
+} // namespace
+
+bool applySchedulerThreadOptions(const std::string& threadName, const SchedulerThreadOptions& options)
+{
+    bool applied = true;
+    if (options.realtimePriority > 0) {
+        sched_param param {};
+        param.sched_priority = std::clamp(options.realtimePriority, sched_get_priority_min(SCHED_FIFO), sched_get_priority_max(SCHED_FIFO));
+        const int result = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+        if (result != 0) {
+            CubeLog::warning(threadName + ": could not switch to SCHED_FIFO priority " + std::to_string(param.sched_priority) + ": " + std::strerror(result));
+            applied = false;
+        } else {
+            CubeLog::info(threadName + ": running SCHED_FIFO at priority " + std::to_string(param.sched_priority));
+        }
+    }
+    if (options.cpu >= 0) {
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(options.cpu, &set);
+        const int result = pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+        if (result != 0) {
+            CubeLog::warning(threadName + ": could not pin to CPU " + std::to_string(options.cpu) + ": " + std::strerror(result));
+            applied = false;
+        } else {
+            CubeLog::info(threadName + ": pinned to CPU " + std::to_string(options.cpu));
+        }
+    }
+    return applied;
+}
+
+double PeriodicSchedulerStats::wakeupsPerSecond() const
+{
+    const double seconds = std::chrono::duration<double>(uptime).count();
+    return seconds > 0.0 ? static_cast<double>(wakeups) / seconds : 0.0;
+}
+
+PeriodicScheduler::PeriodicScheduler(std::string name, SchedulerThreadOptions threadOptions)
+    : name_(std::move(name))
+    , threadOptions_(threadOptions)
+    , startedAt_(Clock::now())
+{
+    auto& registry = Metrics::MetricsRegistry::instance();
+    wakeups_ = registry.counter("scheduler_wakeups_total", "Times a periodic scheduler thread woke up.", { { "scheduler", name_ } });
+    wakeupsPerSecond_ = registry.gauge("scheduler_wakeups_per_second", "Average wakeups per second since the scheduler started.", { { "scheduler", name_ } });
+    {
+        std::lock_guard<std::mutex> lock(schedulersMutex());
+        schedulers().push_back(this);
+    }
+    thread_ = std::jthread([this](std::stop_token stopToken) { run(stopToken); });
+}
+
+PeriodicScheduler::~PeriodicScheduler()
+{
+    {
+        std::lock_guard<std::mutex> lock(schedulersMutex());
+        std::erase(schedulers(), this);
+    }
+    thread_.request_stop();
+    if (thread_.joinable()) {
+        thread_.join();
+    }
+}
+
+PeriodicScheduler& PeriodicScheduler::shared()
+{
+    static PeriodicScheduler scheduler("shared");
+    return scheduler;
+}
+
+std::vector<PeriodicSchedulerStats> PeriodicScheduler::allStats()
+{
+    std::lock_guard<std::mutex> lock(schedulersMutex());
+    std::vector<PeriodicSchedulerStats> result;
+    result.reserve(schedulers().size());
+    for (const auto* scheduler : schedulers()) {
+        result.push_back(scheduler->stats());
+    }
+    return result;
+}
+
+PeriodicScheduler::TaskId PeriodicScheduler::add(PeriodicTaskOptions options, Task task)
+{
+    options.period = std::max(options.period, std::chrono::milliseconds(1));
+    options.jitterBudget = std::max(options.jitterBudget, std::chrono::milliseconds(0));
+    auto& registry = Metrics::MetricsRegistry::instance();
+    const Metrics::Labels labels { { "scheduler", name_ }, { "task", options.name } };
+    Entry entry;
+    entry.runs = registry.counter("scheduler_task_runs_total", "Runs of a periodic task.", labels);
+    entry.lateness = registry.histogram("scheduler_task_lateness_us", "Microseconds between a periodic task's deadline and the start of its run.", labels);
+    entry.options = std::move(options);
+    entry.task = std::move(task);
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    const TaskId id = nextId_++;
+    auto& stored = entries_.emplace(id, std::move(entry)).first->second;
+    scheduleLocked(id, stored, Clock::now());
+    return id;
+}
+
+void PeriodicScheduler::remove(TaskId id)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto it = entries_.find(id);
+    if (it == entries_.end()) {
+        return;
+    }
+    if (!it->second.running) {
+        unscheduleLocked(id, it->second);
+        entries_.erase(it);
+        return;
+    }
+    // The scheduler thread erases it once the current run returns.
+    it->second.removed = true;
+    if (std::this_thread::get_id() != threadId_) {
+        taskIdle_.wait(lock, [this, id] { return !entries_.contains(id); });
+    }
+}
+
+void PeriodicScheduler::setPeriod(TaskId id, std::chrono::milliseconds period)
+{
+    period = std::max(period, std::chrono::milliseconds(1));
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(id);
+    if (it == entries_.end() || it->second.removed || it->second.options.period == period) {
+        return;
+    }
+    Entry& entry = it->second;
+    const auto previousPeriod = entry.options.period;
+    entry.options.period = period;
+    if (entry.running || entry.runs->value() == 0 || entry.urgent) {
+        return;
+    }
+    unscheduleLocked(id, entry);
+    scheduleLocked(id, entry, std::max(entry.deadline - previousPeriod + period, Clock::now()));
+}
+
+void PeriodicScheduler::wake(TaskId id)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = entries_.find(id);
+    if (it == entries_.end() || it->second.removed) {
+        return;
+    }
+    Entry& entry = it->second;
+    entry.urgent = true;
+    if (!entry.running) {
+        unscheduleLocked(id, entry);
+        scheduleLocked(id, entry, std::min(entry.deadline, Clock::now()));
+    }
+}
+
+PeriodicSchedulerStats PeriodicScheduler::stats() const
+{
+    PeriodicSchedulerStats result;
+    result.name = name_;
+    result.uptime = Clock::now() - startedAt_;
+    std::lock_guard<std::mutex> lock(mutex_);
+    result.wakeups = localWakeups_;
+    for (const auto& [id, entry] : entries_) {
+        if (entry.removed) {
+            continue;
+        }
+        result.tasks.push_back({ entry.options.name, entry.options.period, entry.options.jitterBudget, entry.runs->value(), entry.lateness->snapshot() });
+    }
+    return result;
+}
+
+void PeriodicScheduler::scheduleLocked(TaskId id, Entry& entry, Clock::time_point deadline)
+{
+    entry.deadline = deadline;
+    queue_.emplace(deadline, id);
+    rescheduleRequested_ = true;
+    changed_.notify_one();
+}
+
+void PeriodicScheduler::unscheduleLocked(TaskId id, const Entry& entry)
+{
+    queue_.erase({ entry.deadline, id });
+}
+
+PeriodicScheduler::Clock::time_point PeriodicScheduler::wakeTimeLocked() const
+{
+    // A task may run anywhere between its deadline and the end of its budget, so the thread has to be
+    // up by the earliest budget end. Entries are in deadline order, so nothing past that point can be earlier.
+    auto wakeAt = Clock::time_point::max();
+    for (const auto& [deadline, id] : queue_) {
+        if (deadline >= wakeAt) {
+            break;
+        }
+        const Entry& entry = entries_.at(id);
+        wakeAt = std::min(wakeAt, entry.urgent ? deadline : deadline + entry.options.jitterBudget);
+    }
+    return wakeAt;
+}
+
+void PeriodicScheduler::run(std::stop_token stopToken)
+{
+    applySchedulerThreadOptions("PeriodicScheduler[" + name_ + "]", threadOptions_);
+    std::unique_lock<std::mutex> lock(mutex_);
+    threadId_ = std::this_thread::get_id();
+    while (!stopToken.stop_requested()) {
+        const auto wakeAt = wakeTimeLocked();
+        if (Clock::now() < wakeAt) {
+            rescheduleRequested_ = false;
+            if (wakeAt == Clock::time_point::max()) {
+                changed_.wait(lock, stopToken, [this] { return rescheduleRequested_; });
+            } else {
+                changed_.wait_until(lock, stopToken, wakeAt, [this] { return rescheduleRequested_; });
+            }
+            localWakeups_++;
+            wakeups_->increment();
+            wakeupsPerSecond_->set(static_cast<double>(localWakeups_) / std::max(std::chrono::duration<double>(Clock::now() - startedAt_).count(), 1e-3));
+            continue;
+        }
+
+        // Run everything that is due, not just the task whose budget ran out: that is the coalescing.
+        const auto now = Clock::now();
+        while (!queue_.empty() && queue_.begin()->first <= now && !stopToken.stop_requested()) {
+            const TaskId id = queue_.begin()->second;
+            queue_.erase(queue_.begin());
+            Entry& entry = entries_.at(id);
+            entry.running = true;
+            entry.urgent = false;
+            const auto deadline = entry.deadline;
+
+            lock.unlock();
+            const auto startedAt = Clock::now();
+            entry.lateness->record(static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(startedAt - deadline).count()));
+            entry.runs->increment();
+            try {
+                entry.task();
+            } catch (const std::exception& e) {
+                CubeLog::error("PeriodicScheduler[" + name_ + "]: task " + entry.options.name + " threw: " + e.what());
+            }
+            lock.lock();
+
+            entry.running = false;
+            if (entry.removed) {
+                entries_.erase(id);
+                taskIdle_.notify_all();
+                continue;
+            }
+            // Advance by whole periods so late runs don't drift the schedule; skip periods that were missed outright.
+            auto next = deadline + entry.options.period;
+            const auto afterRun = Clock::now();
+            if (entry.urgent) {
+                next = afterRun;
+            } else if (next <= afterRun) {
+                next = afterRun + entry.options.period;
+            }
+            scheduleLocked(id, entry, next);
+        }
+    }
+}
@@ -0,0 +1,155 @@
+/*
+██████╗ ███████╗██████╗ ██╗ ██████╗ ██████╗ ██╗ ██████╗███████╗ ██████╗██╗  ██╗███████╗██████╗ ██╗   ██╗██╗     ███████╗██████╗    ██╗  ██╗
+██╔══██╗██╔════╝██╔══██╗██║██╔═══██╗██╔══██╗██║██╔════╝██╔════╝██╔════╝██║  ██║██╔════╝██╔══██╗██║   ██║██║     ██╔════╝██╔══██╗   ██║  ██║
+██████╔╝█████╗  ██████╔╝██║██║   ██║██║  ██║██║██║     ███████╗██║     ███████║█████╗  ██║  ██║██║   ██║██║     █████╗  ██████╔╝   ███████║
+██╔═══╝ ██╔══╝  ██╔══██╗██║██║   ██║██║  ██║██║██║     ╚════██║██║     ██╔══██║██╔══╝  ██║  ██║██║   ██║██║     ██╔══╝  ██╔══██╗   ██╔══██║
+██║     ███████╗██║  ██║██║╚██████╔╝██████╔╝██║╚██████╗███████║╚██████╗██║  ██║███████╗██████╔╝╚██████╔╝███████╗███████╗██║  ██║██╗██║  ██║
+╚═╝     ╚══════╝╚═╝  ╚═╝╚═╝ ╚═════╝ ╚═════╝ ╚═╝ ╚═════╝╚══════╝ ╚═════╝╚═╝  ╚═╝╚══════╝╚═════╝  ╚═════╝ ╚══════╝╚══════╝╚═╝  ╚═╝╚═╝╚═╝  ╚═╝
+*/
+
+/*
+MIT License
+
+Copyright (c) 2026 A-McD Technology LLC
+*/
+
+
+#pragma once
+#ifndef PERIODICSCHEDULER_H
+#define PERIODICSCHEDULER_H
+
+#include "telemetry/metrics.h"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <stop_token>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/*
+
+One thread runs every periodic task registered with a scheduler, sleeping until the next deadline.
+
+Each task may start up to its jitter budget late. The scheduler sleeps until the earliest point where
+some task's budget would run out and then runs every task that is due by then, so tasks with
+compatible periods share one wakeup instead of each waking the CPU on its own. Deadlines advance by
+whole periods from the previous deadline, so a late run does not drift the schedule; periods that
+were missed entirely are skipped rather than replayed.
+
+Tasks run one at a time on the scheduler thread and must not block. Loops that wait on hardware
+(interrupt lines, serial reads) keep their own threads and can still use applySchedulerThreadOptions().
+
+PeriodicScheduler::shared() is the device-wide scheduler for housekeeping loops. Latency-critical loops
+get their own instance, optionally with SCHED_FIFO and CPU affinity. Every scheduler records wakeups and
+per-task start lateness in the metrics registry under scheduler_* with a "scheduler" label.
+
+*/
+
+struct SchedulerThreadOptions {
+    // SCHED_FIFO priority (1-99); 0 keeps the default time-sharing policy.
+    int realtimePriority = 0;
+    // CPU to pin the thread to; -1 leaves it unpinned.
+    int cpu = -1;
+};
+
+// Applies `options` to the calling thread. Returns false (and logs) if the kernel refused, e.g. without CAP_SYS_NICE.
+bool applySchedulerThreadOptions(const std::string& threadName, const SchedulerThreadOptions& options);
+
+struct PeriodicTaskOptions {
+    std::string name;
+    std::chrono::milliseconds period { 1000 };
+    // How late a run may start so it can share a wakeup with other tasks.
+    std::chrono::milliseconds jitterBudget { 0 };
+};
+
+struct PeriodicTaskStats {
+    std::string name;
+    std::chrono::milliseconds period { 0 };
+    std::chrono::milliseconds jitterBudget { 0 };
+    uint64_t runs = 0;
+    // Microseconds between a run's deadline and its start.
+    Metrics::HistogramSnapshot lateness;
+};
+
+struct PeriodicSchedulerStats {
+    std::string name;
+    uint64_t wakeups = 0;
+    std::chrono::steady_clock::duration uptime {};
+    std::vector<PeriodicTaskStats> tasks;
+
+    double wakeupsPerSecond() const;
+};
+
+class PeriodicScheduler {
+public:
+    using TaskId = uint64_t;
+    using Task = std::function<void()>;
+
+    explicit PeriodicScheduler(std::string name, SchedulerThreadOptions threadOptions = {});
+    ~PeriodicScheduler();
+
+    PeriodicScheduler(const PeriodicScheduler&) = delete;
+    PeriodicScheduler& operator=(const PeriodicScheduler&) = delete;
+
+    static PeriodicScheduler& shared();
+    // Stats for every live scheduler, for a device-wide view.
+    static std::vector<PeriodicSchedulerStats> allStats();
+
+    // The first run is due immediately.
+    TaskId add(PeriodicTaskOptions options, Task task);
+    // Waits for a run in progress to finish unless called from the task itself.
+    void remove(TaskId id);
+    // The next run is due one new period after the previous run's deadline.
+    void setPeriod(TaskId id, std::chrono::milliseconds period);
+    // Runs the task as soon as the scheduler thread is free, without waiting for its budget.
+    void wake(TaskId id);
+
+    PeriodicSchedulerStats stats() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Entry {
+        PeriodicTaskOptions options;
+        Task task;
+        Clock::time_point deadline;
+        bool urgent = false;
+        bool running = false;
+        bool removed = false;
+        std::shared_ptr<Metrics::Counter> runs;
+        std::shared_ptr<Metrics::Histogram> lateness;
+    };
+
+    void run(std::stop_token stopToken);
+    void scheduleLocked(TaskId id, Entry& entry, Clock::time_point deadline);
+    void unscheduleLocked(TaskId id, const Entry& entry);
+    Clock::time_point wakeTimeLocked() const;
+
+    const std::string name_;
+    const SchedulerThreadOptions threadOptions_;
+    const Clock::time_point startedAt_;
+    std::shared_ptr<Metrics::Counter> wakeups_;
+    std::shared_ptr<Metrics::Gauge> wakeupsPerSecond_;
+    uint64_t localWakeups_ = 0;
+
+    mutable std::mutex mutex_;
+    std::condition_variable_any changed_;
+    std::condition_variable taskIdle_;
+    bool rescheduleRequested_ = false;
+    TaskId nextId_ = 1;
+    std::map<TaskId, Entry> entries_;
+    // Deadline order; the scheduler only looks at the front of this.
+    std::set<std::pair<Clock::time_point, TaskId>> queue_;
+    std::thread::id threadId_;
+    std::jthread thread_;
+};
+
+#endif // PERIODICSCHEDULER_H
@@ -33,7 +33,9 @@ SOFTWARE.
 
 #include <globalSettings.h>
 
-std::vector<std::pair<GlobalSettings::SettingType, std::function<void()>>> GlobalSettings::settingChangeCallbacks = {};
+std::vector<GlobalSettings::SettingCallback> GlobalSettings::settingChangeCallbacks = {};
+std::mutex GlobalSettings::settingCallbackMutex;
+GlobalSettings::SettingCallbackId GlobalSettings::nextSettingCallbackId = 1;
 std::mutex GlobalSettings::settingChangeMutex;
 nlohmann::json GlobalSettings::settings = nlohmann::json();
 bool GlobalSettings::settingsInitialized = false;
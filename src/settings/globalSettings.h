@@ -38,7 +38,9 @@ SOFTWARE.
 #include "utils.h"
 #endif
 #include <algorithm>
+#include <cstdint>
 #include <filesystem>
+#include <functional>
 #ifndef LOGGER_H
 #include <logger.h>
 #endif
@@ -140,24 +142,52 @@ struct GlobalSettings {
         populateDefaultSettingsLocked();
     }
 
-    static void setSettingCB(SettingType key, std::function<void()> callback)
+    using SettingCallbackId = uint64_t;
+
+    /**
+     * @brief Register a callback for changes to a setting. Safe to call from any thread, including
+     * from inside another setting callback. Returns an id for removeSettingCB().
+     */
+    static SettingCallbackId setSettingCB(SettingType key, std::function<void()> callback)
+    {
+        std::unique_lock<std::mutex> lock(settingCallbackMutex);
+        const SettingCallbackId id = nextSettingCallbackId++;
+        settingChangeCallbacks.push_back({ id, key, std::move(callback) });
+        return id;
+    }
+
+    static SettingCallbackId setSettingCB(SettingType key, std::function<void(const nlohmann::json&)> callback)
     {
-        settingChangeCallbacks.push_back({ key, callback });
+        return setSettingCB(key, std::function<void()>([callback, key]() { callback(GlobalSettings::getSetting(key)); }));
     }
 
-    static void setSettingCB(SettingType key, std::function<void(const nlohmann::json&)> callback)
+    /**
+     * @brief Remove a callback registered with setSettingCB(). A callSettingCB() that is already
+     * running on another thread may still invoke it once after this returns.
+     */
+    static bool removeSettingCB(SettingCallbackId id)
     {
-        settingChangeCallbacks.push_back({ key, [callback, key]() { callback(GlobalSettings::getSetting(key)); } });
+        std::unique_lock<std::mutex> lock(settingCallbackMutex);
+        return std::erase_if(settingChangeCallbacks, [id](const SettingCallback& entry) { return entry.id == id; }) > 0;
     }
 
     static void callSettingCB(SettingType key)
     {
         CubeLog::debug("Calling setting change callback for " + std::to_string((int)key));
-        for (auto& [settingKey, cb] : settingChangeCallbacks) {
-            if (settingKey == key) {
-                cb();
+        // Invoke a copy so callbacks can register or remove callbacks, and so registration on
+        // another thread never reallocates the list mid-iteration.
+        std::vector<std::function<void()>> callbacks;
+        {
+            std::unique_lock<std::mutex> lock(settingCallbackMutex);
+            for (const auto& entry : settingChangeCallbacks) {
+                if (entry.key == key) {
+                    callbacks.push_back(entry.callback);
+                }
             }
         }
+        for (auto& cb : callbacks) {
+            cb();
+        }
     }
 
     static bool setSetting(SettingType key, nlohmann::json::value_type value)
@@ -400,7 +430,14 @@ struct GlobalSettings {
     }
 
 private:
-    static std::vector<std::pair<SettingType, std::function<void()>>> settingChangeCallbacks;
+    struct SettingCallback {
+        SettingCallbackId id;
+        SettingType key;
+        std::function<void()> callback;
+    };
+    static std::vector<SettingCallback> settingChangeCallbacks;
+    static std::mutex settingCallbackMutex;
+    static SettingCallbackId nextSettingCallbackId;
     static std::mutex settingChangeMutex;
     static nlohmann::json settings;
     static bool settingsInitialized;
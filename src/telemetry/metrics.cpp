@@ -0,0 +1,335 @@
+/*
+███╗   ███╗███████╗████████╗██████╗ ██╗ ██████╗███████╗    ██████╗██████╗ ██████╗
+████╗ ████║██╔════╝╚══██╔══╝██╔══██╗██║██╔════╝██╔════╝   ██╔════╝██╔══██╗██╔══██╗
+██╔████╔██║█████╗     ██║   ██████╔╝██║██║     ███████╗   ██║     ██████╔╝██████╔╝
+██║╚██╔╝██║██╔══╝     ██║   ██╔══██╗██║██║     ╚════██║   ██║     ██╔═══╝ ██╔═══╝
+██║ ╚═╝ ██║███████╗   ██║   ██║  ██║██║╚██████╗███████║██╗╚██████╗██║     ██║
+╚═╝     ╚═╝╚══════╝   ╚═╝   ╚═╝  ╚═╝╚═╝ ╚═════╝╚══════╝╚═╝ ╚═════╝╚═╝     ╚═╝
+*/
+
+/*
+MIT License
+
+Copyright (c) 2026 A-McD Technology LLC
+*/
+
+#include "metrics.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+namespace Metrics {
+
+namespace {
+
+constexpr double kExportedQuantiles[] = { 0.5, 0.9, 0.99 };
+
+std::string labelsKey(const Labels& labels)
+{
+    std::string key;
+    for (const auto& [name, value] : labels) {
+        key += name;
+        key += '\x1f';
+        key += value;
+        key += '\x1e';
+    }
+    return key;
+}
+
+std::string escapeLabelValue(const std::string& value)
+{
+    std::string escaped;
+    escaped.reserve(value.size());
+    for (const char c : value) {
+        switch (c) {
+        case '\\':
+            escaped += "\\\\";
+            break;
+        case '"':
+            escaped += "\\\"";
+            break;
+        case '\n':
+            escaped += "\\n";
+            break;
+        default:
+            escaped += c;
+        }
+    }
+    return escaped;
+}
+
+std::string formatQuantile(double quantile)
+{
+    std::ostringstream out;
+    out << quantile;
+    return out.str();
+}
+
+nlohmann::json labelsToJson(const Labels& labels)
+{
+    nlohmann::json out = nlohmann::json::object();
+    for (const auto& [name, value] : labels) {
+        out[name] = value;
+    }
+    return out;
+}
+
+} // namespace
+
+std::string renderPrometheusLabels(const Labels& labels, const std::string& extraName, const std::string& extraValue)
+{
+    if (labels.empty() && extraName.empty()) {
+        return "";
+    }
+    std::string rendered = "{";
+    bool first = true;
+    for (const auto& [name, value] : labels) {
+        if (!first) {
+            rendered += ",";
+        }
+        rendered += name + "=\"" + escapeLabelValue(value) + "\"";
+        first = false;
+    }
+    if (!extraName.empty()) {
+        if (!first) {
+            rendered += ",";
+        }
+        rendered += extraName + "=\"" + escapeLabelValue(extraValue) + "\"";
+    }
+    rendered += "}";
+    return rendered;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+double HistogramSnapshot::mean() const
+{
+    if (count == 0) {
+        return 0.0;
+    }
+    return static_cast<double>(sum) / static_cast<double>(count);
+}
+
+/**
+ * @brief Estimate a quantile from the bucket counts. The result is the upper edge of the bucket that
+ * holds the requested rank, clamped to the observed min/max so small samples report exact values.
+ */
+uint64_t HistogramSnapshot::percentile(double quantile) const
+{
+    if (count == 0) {
+        return 0;
+    }
+    quantile = std::clamp(quantile, 0.0, 1.0);
+    const auto rank = std::max<uint64_t>(1, static_cast<uint64_t>(std::ceil(quantile * static_cast<double>(count))));
+    uint64_t seen = 0;
+    for (const auto& [lower, upper, bucketCount] : buckets) {
+        seen += bucketCount;
+        if (seen >= rank) {
+            const uint64_t highest = upper == 0 ? std::numeric_limits<uint64_t>::max() : upper - 1;
+            return std::clamp(highest, std::max(lower, min), max);
+        }
+    }
+    return max;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+size_t Histogram::bucketIndex(uint64_t value)
+{
+    if (value < kSubBucketCount) {
+        return static_cast<size_t>(value);
+    }
+    const unsigned msb = static_cast<unsigned>(std::bit_width(value)) - 1;
+    const unsigned shift = msb - kSubBucketBits;
+    return (shift + 1) * kSubBucketCount + static_cast<size_t>((value >> shift) & (kSubBucketCount - 1));
+}
+
+uint64_t Histogram::bucketLowerBound(size_t index)
+{
+    if (index < kSubBucketCount) {
+        return index;
+    }
+    const size_t shift = index / kSubBucketCount - 1;
+    const uint64_t sub = index % kSubBucketCount;
+    return (kSubBucketCount + sub) << shift;
+}
+
+uint64_t Histogram::bucketUpperBound(size_t index)
+{
+    if (index < kSubBucketCount) {
+        return index + 1;
+    }
+    const size_t shift = index / kSubBucketCount - 1;
+    // Wraps to 0 for the very last bucket; callers treat 0 as "no upper bound".
+    return bucketLowerBound(index) + (uint64_t { 1 } << shift);
+}
+
+void Histogram::record(uint64_t value)
+{
+    buckets_[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+    sum_.fetch_add(value, std::memory_order_relaxed);
+
+    uint64_t currentMin = min_.load(std::memory_order_relaxed);
+    while (value < currentMin && !min_.compare_exchange_weak(currentMin, value, std::memory_order_relaxed)) { }
+    uint64_t currentMax = max_.load(std::memory_order_relaxed);
+    while (value > currentMax && !max_.compare_exchange_weak(currentMax, value, std::memory_order_relaxed)) { }
+
+    // Count is bumped last so a concurrent snapshot never sees more samples than bucket entries.
+    count_.fetch_add(1, std::memory_order_release);
+}
+
+HistogramSnapshot Histogram::snapshot() const
+{
+    HistogramSnapshot out;
+    out.count = count_.load(std::memory_order_acquire);
+    out.sum = sum_.load(std::memory_order_relaxed);
+    out.min = out.count == 0 ? 0 : min_.load(std::memory_order_relaxed);
+    out.max = max_.load(std::memory_order_relaxed);
+    uint64_t bucketTotal = 0;
+    for (size_t i = 0; i < kBucketCount; ++i) {
+        const auto bucketCount = buckets_[i].load(std::memory_order_relaxed);
+        if (bucketCount == 0) {
+            continue;
+        }
+        bucketTotal += bucketCount;
+        out.buckets.emplace_back(bucketLowerBound(i), bucketUpperBound(i), bucketCount);
+    }
+    // Recording is not atomic across fields; keep count consistent with what the buckets hold.
+    out.count = std::max(out.count, bucketTotal);
+    return out;
+}
+
+/////////////////////////////////////////////////////////////////////////////////////
+
+MetricsRegistry& MetricsRegistry::instance()
+{
+    static MetricsRegistry registry;
+    return registry;
+}
+
+template <typename T>
+std::shared_ptr<T> MetricsRegistry::getOrCreate(const std::string& name, const std::string& help, const Labels& labels, MetricType type)
+{
+    std::scoped_lock lock(mutex_);
+    auto [familyIt, inserted] = families_.try_emplace(name);
+    auto& family = familyIt->second;
+    if (inserted) {
+        family.type = type;
+        family.help = help;
+    } else if (family.type != type) {
+        throw std::invalid_argument("Metric " + name + " is already registered with a different type");
+    }
+
+    const auto key = labelsKey(labels);
+    auto seriesIt = family.series.find(key);
+    if (seriesIt != family.series.end()) {
+        return std::static_pointer_cast<T>(seriesIt->second.second);
+    }
+    auto metric = std::make_shared<T>();
+    family.series.emplace(key, std::make_pair(labels, std::static_pointer_cast<void>(metric)));
+    return metric;
+}
+
+std::shared_ptr<Counter> MetricsRegistry::counter(const std::string& name, const std::string& help, const Labels& labels)
+{
+    return getOrCreate<Counter>(name, help, labels, MetricType::COUNTER);
+}
+
+std::shared_ptr<Gauge> MetricsRegistry::gauge(const std::string& name, const std::string& help, const Labels& labels)
+{
+    return getOrCreate<Gauge>(name, help, labels, MetricType::GAUGE);
+}
+
+std::shared_ptr<Histogram> MetricsRegistry::histogram(const std::string& name, const std::string& help, const Labels& labels)
+{
+    return getOrCreate<Histogram>(name, help, labels, MetricType::HISTOGRAM);
+}
+
+nlohmann::json MetricsRegistry::toJson() const
+{
+    std::scoped_lock lock(mutex_);
+    nlohmann::json metrics = nlohmann::json::array();
+    for (const auto& [name, family] : families_) {
+        nlohmann::json series = nlohmann::json::array();
+        for (const auto& [key, entry] : family.series) {
+            const auto& [labels, metric] = entry;
+            nlohmann::json item = { { "labels", labelsToJson(labels) } };
+            switch (family.type) {
+            case MetricType::COUNTER:
+                item["value"] = std::static_pointer_cast<Counter>(metric)->value();
+                break;
+            case MetricType::GAUGE:
+                item["value"] = std::static_pointer_cast<Gauge>(metric)->value();
+                break;
+            case MetricType::HISTOGRAM: {
+                const auto snapshot = std::static_pointer_cast<Histogram>(metric)->snapshot();
+                item["count"] = snapshot.count;
+                item["sum"] = snapshot.sum;
+                item["min"] = snapshot.min;
+                item["max"] = snapshot.max;
+                item["mean"] = snapshot.mean();
+                item["p50"] = snapshot.percentile(0.5);
+                item["p90"] = snapshot.percentile(0.9);
+                item["p99"] = snapshot.percentile(0.99);
+                nlohmann::json buckets = nlohmann::json::array();
+                for (const auto& [lower, upper, bucketCount] : snapshot.buckets) {
+                    buckets.push_back({ { "lower", lower }, { "upper", upper }, { "count", bucketCount } });
+                }
+                item["buckets"] = buckets;
+                break;
+            }
+            }
+            series.push_back(item);
+        }
+        const char* typeName = family.type == MetricType::COUNTER ? "counter"
+            : family.type == MetricType::GAUGE                   ? "gauge"
+                                                                 : "histogram";
+        metrics.push_back({ { "name", name }, { "type", typeName }, { "help", family.help }, { "series", series } });
+    }
+    return nlohmann::json({ { "metrics", metrics } });
+}
+
+/**
+ * @brief Render the registry in the Prometheus text exposition format. Histograms are exported as
+ * summaries (quantiles plus _sum/_count) since the log-linear bucket layout is far too fine-grained to
+ * ship as cumulative "le" buckets.
+ */
+std::string MetricsRegistry::toPrometheus() const
+{
+    std::scoped_lock lock(mutex_);
+    std::ostringstream out;
+    for (const auto& [name, family] : families_) {
+        const char* typeName = family.type == MetricType::COUNTER ? "counter"
+            : family.type == MetricType::GAUGE                   ? "gauge"
+                                                                 : "summary";
+        out << "# HELP " << name << " " << family.help << "\n";
+        out << "# TYPE " << name << " " << typeName << "\n";
+        for (const auto& [key, entry] : family.series) {
+            const auto& [labels, metric] = entry;
+            switch (family.type) {
+            case MetricType::COUNTER:
+                out << name << renderPrometheusLabels(labels) << " " << std::static_pointer_cast<Counter>(metric)->value() << "\n";
+                break;
+            case MetricType::GAUGE:
+                out << name << renderPrometheusLabels(labels) << " " << std::static_pointer_cast<Gauge>(metric)->value() << "\n";
+                break;
+            case MetricType::HISTOGRAM: {
+                const auto snapshot = std::static_pointer_cast<Histogram>(metric)->snapshot();
+                for (const double quantile : kExportedQuantiles) {
+                    out << name << renderPrometheusLabels(labels, "quantile", formatQuantile(quantile))
+                        << " " << snapshot.percentile(quantile) << "\n";
+                }
+                out << name << "_sum" << renderPrometheusLabels(labels) << " " << snapshot.sum << "\n";
+                out << name << "_count" << renderPrometheusLabels(labels) << " " << snapshot.count << "\n";
+                break;
+            }
+            }
+        }
+    }
+    return out.str();
+}
+
+} // namespace Metrics
@@ -0,0 +1,140 @@
+/*
+███╗   ███╗███████╗████████╗██████╗ ██╗ ██████╗███████╗   ██╗  ██╗
+████╗ ████║██╔════╝╚══██╔══╝██╔══██╗██║██╔════╝██╔════╝   ██║  ██║
+██╔████╔██║█████╗     ██║   ██████╔╝██║██║     ███████╗   ███████║
+██║╚██╔╝██║██╔══╝     ██║   ██╔══██╗██║██║     ╚════██║   ██╔══██║
+██║ ╚═╝ ██║███████╗   ██║   ██║  ██║██║╚██████╗███████║██╗██║  ██║
+╚═╝     ╚═╝╚══════╝   ╚═╝   ╚═╝  ╚═╝╚═╝ ╚═════╝╚══════╝╚═╝╚═╝  ╚═╝
+*/
+
+/*
+MIT License
+
+Copyright (c) 2026 A-McD Technology LLC
+*/
+
+#pragma once
+#ifndef METRICS_H
+#define METRICS_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <nlohmann/json.hpp>
+
+/*
+
+In-process metrics registry shared by every subsystem. Registration (counter(), gauge(), histogram())
+takes the registry mutex and returns a shared_ptr that stays valid for the life of the process, so hot
+paths should look a metric up once and keep the pointer. Recording on a metric is lock-free.
+
+Histograms use log-linear buckets: values below 2^kSubBucketBits get one bucket each and every power of
+two above that is split into 2^kSubBucketBits linear sub-buckets. That bounds the relative error of a
+reported percentile to 1 / 2^kSubBucketBits (12.5%) over the whole uint64 range with a fixed 4 KB of
+counters per histogram.
+
+*/
+
+namespace Metrics {
+
+using Labels = std::vector<std::pair<std::string, std::string>>;
+
+class Counter {
+public:
+    void increment(uint64_t amount = 1) { value_.fetch_add(amount, std::memory_order_relaxed); }
+    uint64_t value() const { return value_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<uint64_t> value_ { 0 };
+};
+
+class Gauge {
+public:
+    void set(double value) { value_.store(value, std::memory_order_relaxed); }
+    void add(double amount) { value_.fetch_add(amount, std::memory_order_relaxed); }
+    double value() const { return value_.load(std::memory_order_relaxed); }
+
+private:
+    std::atomic<double> value_ { 0.0 };
+};
+
+struct HistogramSnapshot {
+    uint64_t count = 0;
+    uint64_t sum = 0;
+    uint64_t min = 0;
+    uint64_t max = 0;
+    // Non-empty buckets only, as (inclusive lower bound, exclusive upper bound, count).
+    std::vector<std::tuple<uint64_t, uint64_t, uint64_t>> buckets;
+
+    double mean() const;
+    uint64_t percentile(double quantile) const;
+};
+
+class Histogram {
+public:
+    static constexpr unsigned kSubBucketBits = 3;
+    static constexpr size_t kSubBucketCount = size_t { 1 } << kSubBucketBits;
+    static constexpr size_t kBucketCount = (64 - kSubBucketBits + 1) * kSubBucketCount;
+
+    void record(uint64_t value);
+    HistogramSnapshot snapshot() const;
+    uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+
+    static size_t bucketIndex(uint64_t value);
+    static uint64_t bucketLowerBound(size_t index);
+    static uint64_t bucketUpperBound(size_t index);
+
+private:
+    std::array<std::atomic<uint64_t>, kBucketCount> buckets_ {};
+    std::atomic<uint64_t> count_ { 0 };
+    std::atomic<uint64_t> sum_ { 0 };
+    std::atomic<uint64_t> min_ { std::numeric_limits<uint64_t>::max() };
+    std::atomic<uint64_t> max_ { 0 };
+};
+
+class MetricsRegistry {
+public:
+    static MetricsRegistry& instance();
+
+    std::shared_ptr<Counter> counter(const std::string& name, const std::string& help, const Labels& labels = {});
+    std::shared_ptr<Gauge> gauge(const std::string& name, const std::string& help, const Labels& labels = {});
+    std::shared_ptr<Histogram> histogram(const std::string& name, const std::string& help, const Labels& labels = {});
+
+    nlohmann::json toJson() const;
+    std::string toPrometheus() const;
+
+private:
+    enum class MetricType {
+        COUNTER,
+        GAUGE,
+        HISTOGRAM
+    };
+
+    struct Family {
+        MetricType type = MetricType::COUNTER;
+        std::string help;
+        // Keyed by the rendered label set so exports come out in a stable order.
+        std::map<std::string, std::pair<Labels, std::shared_ptr<void>>> series;
+    };
+
+    template <typename T>
+    std::shared_ptr<T> getOrCreate(const std::string& name, const std::string& help, const Labels& labels, MetricType type);
+
+    mutable std::mutex mutex_;
+    std::map<std::string, Family> families_;
+};
+
+std::string renderPrometheusLabels(const Labels& labels, const std::string& extraName = "", const std::string& extraValue = "");
+
+} // namespace Metrics
+
+#endif // METRICS_H
@@ -0,0 +1,49 @@
+/*
+███╗   ███╗███████╗████████╗██████╗ ██╗ ██████╗███████╗ █████╗ ██████╗ ██╗    ██████╗██████╗ ██████╗
+████╗ ████║██╔════╝╚══██╔══╝██╔══██╗██║██╔════╝██╔════╝██╔══██╗██╔══██╗██║   ██╔════╝██╔══██╗██╔══██╗
+██╔████╔██║█████╗     ██║   ██████╔╝██║██║     ███████╗███████║██████╔╝██║   ██║     ██████╔╝██████╔╝
+██║╚██╔╝██║██╔══╝     ██║   ██╔══██╗██║██║     ╚════██║██╔══██║██╔═══╝ ██║   ██║     ██╔═══╝ ██╔═══╝
+██║ ╚═╝ ██║███████╗   ██║   ██║  ██║██║╚██████╗███████║██║  ██║██║     ██║██╗╚██████╗██║     ██║
+╚═╝     ╚═╝╚══════╝   ╚═╝   ╚═╝  ╚═╝╚═╝ ╚═════╝╚══════╝╚═╝  ╚═╝╚═╝     ╚═╝╚═╝ ╚═════╝╚═╝     ╚═╝
+*/
+
+/*
+MIT License
+
+Copyright (c) 2026 A-McD Technology LLC
+*/
+
+#include "metricsAPI.h"
+
+HttpEndPointData_t MetricsAPI::getHttpEndpointData()
+{
+    HttpEndPointData_t data;
+
+    data.push_back({
+        PRIVATE_ENDPOINT | GET_ENDPOINT,
+        [](const httplib::Request& req, httplib::Response& res) {
+            (void)req;
+            res.status = 200;
+            res.set_content(Metrics::MetricsRegistry::instance().toJson().dump(), "application/json");
+            return EndpointError(EndpointError::ERROR_TYPES::ENDPOINT_NO_ERROR, "");
+        },
+        "snapshot",
+        nlohmann::json({ { "type", "object" }, { "properties", nlohmann::json::object() } }),
+        "Get all registered counters, gauges and latency histograms as JSON"
+    });
+
+    data.push_back({
+        PRIVATE_ENDPOINT | GET_ENDPOINT,
+        [](const httplib::Request& req, httplib::Response& res) {
+            (void)req;
+            res.status = 200;
+            res.set_content(Metrics::MetricsRegistry::instance().toPrometheus(), "text/plain; version=0.0.4");
+            return EndpointError(EndpointError::ERROR_TYPES::ENDPOINT_NO_ERROR, "");
+        },
+        "prometheus",
+        nlohmann::json({ { "type", "object" }, { "properties", nlohmann::json::object() } }),
+        "Get all registered metrics in the Prometheus text exposition format"
+    });
+
+    return data;
+}
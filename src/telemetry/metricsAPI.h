@@ -0,0 +1,31 @@
+/*
+███╗   ███╗███████╗████████╗██████╗ ██╗ ██████╗███████╗ █████╗ ██████╗ ██╗   ██╗  ██╗
+████╗ ████║██╔════╝╚══██╔══╝██╔══██╗██║██╔════╝██╔════╝██╔══██╗██╔══██╗██║   ██║  ██║
+██╔████╔██║█████╗     ██║   ██████╔╝██║██║     ███████╗███████║██████╔╝██║   ███████║
+██║╚██╔╝██║██╔══╝     ██║   ██╔══██╗██║██║     ╚════██║██╔══██║██╔═══╝ ██║   ██╔══██║
+██║ ╚═╝ ██║███████╗   ██║   ██║  ██║██║╚██████╗███████║██║  ██║██║     ██║██╗██║  ██║
+╚═╝     ╚═╝╚══════╝   ╚═╝   ╚═╝  ╚═╝╚═╝ ╚═════╝╚══════╝╚═╝  ╚═╝╚═╝     ╚═╝╚═╝╚═╝  ╚═╝
+*/
+
+/*
+MIT License
+
+Copyright (c) 2026 A-McD Technology LLC
+*/
+
+#pragma once
+#ifndef METRICS_API_H
+#define METRICS_API_H
+
+#include "../api/api.h"
+#include "metrics.h"
+
+class MetricsAPI : public AutoRegisterAPI<MetricsAPI> {
+public:
+    MetricsAPI() = default;
+
+    std::string getInterfaceName() const override { return "Metrics"; }
+    HttpEndPointData_t getHttpEndpointData() override;
+};
+
+#endif
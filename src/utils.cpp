@@ -35,6 +35,8 @@ SOFTWARE.
 #include <logger.h>
 #endif
 #include "utils.h"
+#include "hardware/systemSensorSampler.h"
+#include "periodicScheduler.h"
 
 void genericSleep(int ms)
 {
@@ -45,52 +47,32 @@ void monitorMemoryAndCPU()
 {
     CubeLog::info("Memory: " + getMemoryFootprint());
     CubeLog::info("CPU: " + getCpuUsage());
+    for (const auto& scheduler : PeriodicScheduler::allStats()) {
+        char rate[32];
+        std::snprintf(rate, sizeof(rate), "%.2f", scheduler.wakeupsPerSecond());
+        std::string line = "Scheduler " + scheduler.name + ": " + rate + " wakeups/s";
+        for (const auto& task : scheduler.tasks) {
+            line += ", " + task.name + " p99 late " + std::to_string(task.lateness.percentile(0.99)) + "us";
+        }
+        CubeLog::info(line);
+    }
 }
 
 std::string getMemoryFootprint()
 {
-    std::ifstream file("/proc/self/status");
-    std::string line;
-    while (std::getline(file, line)) {
-        if (line.find("VmRSS") != std::string::npos) {
-            std::string rss = line.substr(line.find(":") + 1);
-            rss.erase(std::remove_if(rss.begin(), rss.end(), isspace), rss.end());
-            return rss;
-        }
-    }
-    return "0";
+    const auto rssKb = SystemSensorSampler::shared().latest().processRssKb;
+    return rssKb ? std::to_string(*rssKb) + "kB" : "0";
 }
 
 std::string getCpuUsage()
 {
-    std::ifstream file("/proc/stat");
-    std::string line;
-    while (std::getline(file, line)) {
-        if (line.find("cpu") != std::string::npos) {
-            std::istringstream ss(line);
-            std::vector<std::string> tokens;
-            std::string token;
-            while (std::getline(ss, token, ' ')) {
-                tokens.push_back(token);
-            }
-            // TODO: fix this
-            // long user = std::stol(tokens[1]);
-            // long nice = std::stol(tokens[2]);
-            // long system = std::stol(tokens[3]);
-            // long idle = std::stol(tokens[4]);
-            // long iowait = std::stol(tokens[5]);
-            // long irq = std::stol(tokens[6]);
-            // long softirq = std::stol(tokens[7]);
-            // long steal = std::stol(tokens[8]);
-            // long guest = std::stol(tokens[9]);
-            // long guest_nice = std::stol(tokens[10]);
-            // long total = user + nice + system + idle + iowait + irq + softirq + steal + guest + guest_nice;
-            // long idleTotal = idle + iowait;
-            // return std::to_string((total - idleTotal) * 100 / total);
-            return "";
-        }
+    const auto usage = SystemSensorSampler::shared().latest().cpuUsagePercent;
+    if (!usage) {
+        return "0";
     }
-    return "0";
+    char text[16];
+    std::snprintf(text, sizeof(text), "%.1f%%", *usage);
+    return text;
 }
 
 std::string sha256(std::string input){
@@ -1,8 +1,11 @@
 #include "../../src/api/apiEventBroker.h"
 #include <gtest/gtest.h>
 
+#include <atomic>
 #include <future>
+#include <string>
 #include <thread>
+#include <vector>
 
 namespace {
 
@@ -93,4 +96,53 @@ TEST(ApiEventBrokerTest, WaitsForMatchingEventsAndTimesOutWhenNoneArrive)
     EXPECT_EQ(timeoutPage.nextSequence, page.nextSequence);
 }
 
+TEST(ApiEventBrokerTest, DeliversPublishedEventsToListenersUntilRemoved)
+{
+    ApiEventBroker broker(8);
+    std::vector<std::string> received;
+    const auto handle = broker.addListener([&received, &broker](const ApiEvent& event) {
+        // Listeners run outside the broker lock, so querying the broker here must not deadlock.
+        EXPECT_EQ(broker.latestSequence(), event.sequence);
+        received.push_back(event.source + ":" + event.event);
+    });
+    ASSERT_NE(handle, 0u);
+
+    broker.publish("presence", "present", nlohmann::json::object(), 1000);
+    broker.publish("interaction", "tap", nlohmann::json::object(), 1100);
+    EXPECT_TRUE(broker.removeListener(handle));
+    EXPECT_FALSE(broker.removeListener(handle));
+    broker.publish("interaction", "tap", nlohmann::json::object(), 1200);
+
+    ASSERT_EQ(received.size(), 2u);
+    EXPECT_EQ(received[0], "presence:present");
+    EXPECT_EQ(received[1], "interaction:tap");
+    EXPECT_TRUE(broker.hasSource("presence"));
+}
+
+TEST(ApiEventBrokerTest, DeferredPayloadIsBuiltOnceOnFirstRead)
+{
+    ApiEventBroker broker(8);
+    std::atomic<int> builds { 0 };
+    broker.publish(
+        "interaction",
+        "tap",
+        ApiEventPayload::deferred([&builds]() {
+            builds++;
+            return nlohmann::json { { "liftStateAfter", "on_desk" } };
+        }),
+        1000);
+
+    auto page = broker.waitForEvents(0, std::nullopt, 10, std::chrono::milliseconds::zero());
+    ASSERT_EQ(page.events.size(), 1u);
+    EXPECT_FALSE(page.events[0].payload.isBuilt());
+    EXPECT_EQ(builds.load(), 0);
+
+    EXPECT_EQ(page.events[0].payload.get().value("liftStateAfter", ""), "on_desk");
+    // The page holds copies of the stored event; they share the built value.
+    page = broker.waitForEvents(0, std::nullopt, 10, std::chrono::milliseconds::zero());
+    EXPECT_TRUE(page.events[0].payload.isBuilt());
+    EXPECT_EQ(page.events[0].payload.get().value("liftStateAfter", ""), "on_desk");
+    EXPECT_EQ(builds.load(), 1);
+}
+
 } // namespace
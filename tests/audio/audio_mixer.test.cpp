@@ -0,0 +1,165 @@
+#include "audio/audioMixer.h"
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <functional>
+#include <thread>
+#include <vector>
+
+namespace {
+
+bool waitUntil(const std::function<bool()>& predicate, std::chrono::milliseconds timeout)
+{
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (predicate()) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    return predicate();
+}
+
+std::vector<float> constantFrames(size_t frames, float value)
+{
+    return std::vector<float>(frames * AudioMixer::CHANNELS, value);
+}
+
+} // namespace
+
+TEST(SpscSampleRingTest, WrapsAndPreservesOrder)
+{
+    SpscSampleRing ring(8);
+    std::vector<float> out(8);
+    for (int round = 0; round < 5; ++round) {
+        const std::vector<float> in = { 1.0f + round, 2.0f + round, 3.0f + round, 4.0f + round, 5.0f + round };
+        ASSERT_EQ(ring.write(in), in.size());
+        ASSERT_EQ(ring.read(std::span<float>(out.data(), in.size())), in.size());
+        EXPECT_EQ(std::vector<float>(out.begin(), out.begin() + in.size()), in);
+    }
+    EXPECT_EQ(ring.write(std::vector<float>(20, 0.0f)), ring.capacity());
+    EXPECT_EQ(ring.writeAvailable(), 0u);
+}
+
+TEST(AudioMixerTest, AppliesVoiceAndSourceGain)
+{
+    AudioMixer mixer;
+    mixer.setSourceGain(AudioSource::UI, 0.5f);
+    auto clip = std::make_shared<std::vector<float>>(constantFrames(4, 0.8f));
+    ASSERT_NE(mixer.playClip(AudioSource::UI, clip, 0.5f), nullptr);
+    auto speech = mixer.openVoice(AudioSource::SPEECH, 1.0f, 16);
+    ASSERT_NE(speech, nullptr);
+    ASSERT_EQ(speech->write(constantFrames(4, 0.1f)), 4u);
+    speech->finish();
+
+    std::vector<double> out(4 * AudioMixer::CHANNELS, 0.0);
+    mixer.render(out.data(), 4);
+    for (double sample : out) {
+        EXPECT_NEAR(sample, 0.8 * 0.5 * 0.5 + 0.1, 1e-6);
+    }
+
+    // Both voices are drained; the next render retires them without counting an underrun.
+    mixer.render(out.data(), 4);
+    EXPECT_EQ(mixer.activeVoices(), 0u);
+    EXPECT_EQ(mixer.stats().underruns[static_cast<size_t>(AudioSource::SPEECH)], 0u);
+}
+
+TEST(AudioMixerTest, CountsUnderrunsOnlyAfterVoiceStarted)
+{
+    AudioMixer mixer;
+    auto voice = mixer.openVoice(AudioSource::SPEECH, 1.0f, 64);
+    std::vector<double> out(8 * AudioMixer::CHANNELS, 0.0);
+
+    // Waiting for the first chunk is time-to-first-audio, not an underrun.
+    mixer.render(out.data(), 8);
+    EXPECT_EQ(mixer.stats().underruns[static_cast<size_t>(AudioSource::SPEECH)], 0u);
+
+    voice->write(constantFrames(4, 0.2f));
+    mixer.render(out.data(), 8);
+    EXPECT_TRUE(voice->started());
+    EXPECT_EQ(mixer.stats().underruns[static_cast<size_t>(AudioSource::SPEECH)], 1u);
+    EXPECT_GE(mixer.stats().lastTimeToFirstAudioUs, 0);
+
+    voice->finish();
+    mixer.render(out.data(), 8);
+    EXPECT_TRUE(voice->done());
+    EXPECT_EQ(mixer.stats().underruns[static_cast<size_t>(AudioSource::SPEECH)], 1u);
+}
+
+TEST(AudioMixerTest, StopSourceCancelsOnlyThatSource)
+{
+    AudioMixer mixer;
+    auto alarm = mixer.playClip(AudioSource::ALARM, std::make_shared<std::vector<float>>(constantFrames(1000, 0.3f)));
+    auto ui = mixer.playClip(AudioSource::UI, std::make_shared<std::vector<float>>(constantFrames(1000, 0.3f)));
+    mixer.stopSource(AudioSource::ALARM);
+
+    std::vector<double> out(8 * AudioMixer::CHANNELS, 0.0);
+    mixer.render(out.data(), 8);
+    EXPECT_TRUE(alarm->done());
+    EXPECT_FALSE(ui->done());
+    EXPECT_NEAR(out[0], 0.3, 1e-6);
+}
+
+TEST(AudioMixerTest, StreamsThroughNullClockAndMeasuresTimeToFirstAudio)
+{
+    AudioMixer mixer;
+    NullAudioClock clock([&mixer](double* out, unsigned int frames) { mixer.render(out, frames); });
+    clock.start();
+
+    auto voice = mixer.openVoice(AudioSource::SPEECH);
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    // Producer streams 200 ms in 20 ms chunks, faster than real time, so the ring never runs dry.
+    StereoResampler resampler(16000, 1);
+    std::vector<float> mono(320, 0.25f);
+    std::vector<float> stereo;
+    for (int chunk = 0; chunk < 10; ++chunk) {
+        stereo.clear();
+        resampler.push(mono, 1.0f, stereo);
+        ASSERT_TRUE(voice->writeAll(stereo));
+    }
+    voice->finish();
+
+    ASSERT_TRUE(waitUntil([&] { return voice->done(); }, std::chrono::milliseconds(2000)));
+    clock.stop();
+    const auto stats = mixer.stats();
+    EXPECT_GE(stats.lastTimeToFirstAudioUs, 30000);
+    EXPECT_LT(stats.lastTimeToFirstAudioUs, 200000);
+    EXPECT_EQ(stats.underruns[static_cast<size_t>(AudioSource::SPEECH)], 0u);
+}
+
+TEST(AudioMixerTest, TimeToFirstAudioStartsAtTheRequestTime)
+{
+    AudioMixer mixer;
+    const auto requestedAt = AudioVoice::Clock::now() - std::chrono::milliseconds(50);
+    auto voice = mixer.openVoice(AudioSource::SPEECH, 1.0f, 64, requestedAt);
+    ASSERT_NE(voice, nullptr);
+    const auto frames = constantFrames(16, 0.5f);
+    ASSERT_EQ(voice->write(frames), 16u);
+
+    std::vector<double> out(16 * AudioMixer::CHANNELS, 0.0);
+    mixer.render(out.data(), 16);
+    EXPECT_GE(mixer.stats().lastTimeToFirstAudioUs, 50000);
+}
+
+TEST(StereoResamplerTest, ChunkedInputMatchesSingleBlock)
+{
+    std::vector<float> input(1000);
+    for (size_t i = 0; i < input.size(); ++i) {
+        input[i] = static_cast<float>(i % 97) / 97.0f;
+    }
+    std::vector<float> whole;
+    StereoResampler single(22050, 1);
+    single.push(input, 1.0f, whole);
+    single.flush(1.0f, whole);
+
+    std::vector<float> chunked;
+    StereoResampler streaming(22050, 1);
+    for (size_t offset = 0; offset < input.size(); offset += 33) {
+        const size_t count = std::min<size_t>(33, input.size() - offset);
+        streaming.push(std::span<const float>(input.data() + offset, count), 1.0f, chunked);
+    }
+    streaming.flush(1.0f, chunked);
+    EXPECT_EQ(whole, chunked);
+    EXPECT_NEAR(static_cast<double>(whole.size()) / 2.0, 1000.0 * 48000.0 / 22050.0, 3.0);
+}
@@ -0,0 +1,121 @@
+#include <gtest/gtest.h>
+
+#include "audio/audioOutput.h"
+#include "httplib.h"
+
+#include <algorithm>
+#include <cmath>
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+class ScopedHttpServer {
+public:
+    ScopedHttpServer()
+    {
+        port_ = server_.bind_to_any_port("127.0.0.1");
+        if (port_ <= 0) {
+            throw std::runtime_error("Failed to bind HTTP test server");
+        }
+        thread_ = std::thread([this]() { server_.listen_after_bind(); });
+        std::this_thread::sleep_for(std::chrono::milliseconds(25));
+    }
+
+    ~ScopedHttpServer()
+    {
+        server_.stop();
+        if (thread_.joinable()) {
+            thread_.join();
+        }
+    }
+
+    int port() const { return port_; }
+    httplib::Server& server() { return server_; }
+
+private:
+    httplib::Server server_;
+    std::thread thread_;
+    int port_ = -1;
+};
+
+void pointConfigAt(const ScopedHttpServer& server)
+{
+    Config::set("REMOTE_SERVER_BASE_URL", "http://127.0.0.1:" + std::to_string(server.port()));
+    Config::set("REMOTE_SERVER_BEARER_TOKEN", "dev-user");
+    Config::erase("REMOTE_TTS_STREAMING");
+    Config::erase("REMOTE_TTS_PCM_SAMPLE_RATE_HZ");
+}
+
+// Renders everything the voice holds and returns the loudest sample.
+double renderPeak(AudioMixer& mixer)
+{
+    std::vector<double> out(AudioMixer::SAMPLE_RATE * AudioMixer::CHANNELS, 0.0);
+    mixer.render(out.data(), AudioMixer::SAMPLE_RATE);
+    double peak = 0.0;
+    for (const double sample : out) {
+        peak = std::max(peak, std::abs(sample));
+    }
+    return peak;
+}
+
+} // namespace
+
+TEST(SpeechSynthesisTest, ErrorResponseIsNotPlayed)
+{
+    ScopedHttpServer server;
+    server.server().Post("/API/audio/synthesize", [](const httplib::Request&, httplib::Response& res) {
+        res.status = 500;
+        res.set_content("Internal Server Error: speech backend unavailable", "text/plain");
+    });
+    pointConfigAt(server);
+
+    AudioMixer mixer;
+    auto voice = mixer.openVoice(AudioSource::SPEECH);
+    ASSERT_NE(voice, nullptr);
+    synthesizeSpeechInto("hello", voice);
+    voice->finish();
+
+    EXPECT_EQ(renderPeak(mixer), 0.0);
+}
+
+TEST(SpeechSynthesisTest, RawPcmResponseIsPlayed)
+{
+    ScopedHttpServer server;
+    server.server().Post("/API/audio/synthesize", [](const httplib::Request&, httplib::Response& res) {
+        const std::vector<int16_t> samples(1600, 8000);
+        res.set_content(reinterpret_cast<const char*>(samples.data()), samples.size() * sizeof(int16_t), "application/octet-stream");
+    });
+    pointConfigAt(server);
+
+    AudioMixer mixer;
+    auto voice = mixer.openVoice(AudioSource::SPEECH);
+    ASSERT_NE(voice, nullptr);
+    synthesizeSpeechInto("hello", voice);
+    voice->finish();
+
+    EXPECT_GT(renderPeak(mixer), 0.1);
+}
+
+TEST(SpeechSynthesisTest, PcmThatStartsLikeJsonIsPlayedWhenTheContentTypeSaysAudio)
+{
+    ScopedHttpServer server;
+    server.server().Post("/API/audio/synthesize", [](const httplib::Request&, httplib::Response& res) {
+        // 0x207B is little-endian "{ ", which a body sniffer would take for JSON.
+        const std::vector<int16_t> samples(1600, 0x207B);
+        res.set_content(reinterpret_cast<const char*>(samples.data()), samples.size() * sizeof(int16_t), "application/octet-stream");
+    });
+    pointConfigAt(server);
+
+    AudioMixer mixer;
+    auto voice = mixer.openVoice(AudioSource::SPEECH);
+    ASSERT_NE(voice, nullptr);
+    synthesizeSpeechInto("hello", voice);
+    voice->finish();
+
+    EXPECT_GT(renderPeak(mixer), 0.1);
+}
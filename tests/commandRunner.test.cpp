@@ -0,0 +1,59 @@
+#include <gtest/gtest.h>
+#include "../src/commandRunner.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+TEST(SystemCommandRunnerTest, RunCapturesOutputAndExitCode)
+{
+    SystemCommandRunner runner;
+    const CommandResult result = runner.run({ "sh", "-c", "echo out; echo err >&2; exit 3" });
+
+    EXPECT_EQ(result.exitCode, 3);
+    EXPECT_EQ(result.output, "out\nerr\n");
+}
+
+TEST(SystemCommandRunnerTest, RunFinishesWhileStreamsAreForkedAlongside)
+{
+    // A stream() child forked between run()'s pipe() and its close of the write end would inherit that end and
+    // keep run() from seeing EOF for as long as the stream lives. Fork streams continuously while run() is
+    // called in a loop, keeping every stream alive until the end.
+    SystemCommandRunner runner;
+    std::atomic<bool> running { true };
+    std::vector<std::unique_ptr<ICommandLineStream>> monitors;
+    std::thread forker([&]() {
+        while (running.load() && monitors.size() < 200) {
+            monitors.push_back(runner.stream({ "sleep", "10" }));
+        }
+    });
+
+    auto slowest = std::chrono::steady_clock::duration::zero();
+    for (int attempt = 0; attempt < 200; ++attempt) {
+        const auto started = std::chrono::steady_clock::now();
+        const CommandResult result = runner.run({ "echo", "done" });
+        slowest = std::max(slowest, std::chrono::steady_clock::now() - started);
+        ASSERT_EQ(result.output, "done\n");
+    }
+    running = false;
+    forker.join();
+
+    EXPECT_LT(slowest, std::chrono::seconds(2));
+}
+
+TEST(SystemCommandRunnerTest, StreamReadsLinesUntilTheCommandExits)
+{
+    SystemCommandRunner runner;
+    auto stream = runner.stream({ "sh", "-c", "echo first; echo second" });
+    ASSERT_NE(stream, nullptr);
+
+    std::string line;
+    ASSERT_EQ(stream->readLine(line, std::chrono::seconds(2)), CommandStreamRead::Line);
+    EXPECT_EQ(line, "first");
+    ASSERT_EQ(stream->readLine(line, std::chrono::seconds(2)), CommandStreamRead::Line);
+    EXPECT_EQ(line, "second");
+    EXPECT_EQ(stream->readLine(line, std::chrono::seconds(2)), CommandStreamRead::Closed);
+}
@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+
+#include "../../src/decisionEngine/personalityManager.h"
+
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <functional>
+#include <thread>
+#include <vector>
+
+using namespace Personality;
+
+namespace {
+
+bool waitUntil(const std::function<bool()>& predicate, std::chrono::milliseconds timeout)
+{
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (predicate()) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return predicate();
+}
+
+std::chrono::nanoseconds processCpuTime()
+{
+    timespec ts {};
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec);
+}
+
+} // namespace
+
+TEST(PersonalityManagerTest, SetValuePersistsAndIsPublished)
+{
+    PersonalityManager manager;
+    const auto before = manager.getSnapshot();
+
+    ASSERT_TRUE(manager.setEmotion(Emotion::EmotionType::PLAYFULNESS, 42));
+    EXPECT_EQ(manager.getEmotionValue(Emotion::EmotionType::PLAYFULNESS), 42);
+    EXPECT_GT(manager.getSnapshot().version, before.version);
+
+    // Nothing is ramping, so the value must not drift back to the default.
+    std::this_thread::sleep_for(std::chrono::milliseconds(PERSONALITY_RAMP_TICK_MS * 2));
+    EXPECT_EQ(manager.getEmotionValue(Emotion::EmotionType::PLAYFULNESS), 42);
+
+    ASSERT_TRUE(manager.setEmotion(Emotion::EmotionType::PLAYFULNESS, EMOTION_MAX_VALUE + 50));
+    EXPECT_EQ(manager.getEmotionValue(Emotion::EmotionType::PLAYFULNESS), EMOTION_MAX_VALUE);
+    EXPECT_FALSE(manager.setEmotion(Emotion::EmotionType::EMOTION_NOT_ASSIGNED, 10));
+    // Unknown emotions report -1, which is outside the valid range.
+    EXPECT_EQ(manager.getEmotionValue(Emotion::EmotionType::EMOTION_NOT_ASSIGNED), -1);
+    EXPECT_EQ(manager.getEmotionValue(Emotion::EmotionType::EMOTION_COUNT), -1);
+
+    const auto all = manager.getAllEmotionsCurrent();
+    ASSERT_EQ(all.size(), EMOTION_SLOT_COUNT);
+    EXPECT_EQ(all.front().emotion, Emotion::EmotionType::CURIOSITY);
+    EXPECT_EQ(all.back().emotion, Emotion::EmotionType::ANNOYANCE);
+}
+
+TEST(PersonalityManagerTest, StepExpirationRevertsToDefault)
+{
+    PersonalityManager manager;
+    const int defaultValue = manager.getEmotionValue(Emotion::EmotionType::CURIOSITY);
+    const int temporary = defaultValue > 50 ? 10 : 90;
+
+    ASSERT_TRUE(manager.setEmotion(Emotion::EmotionType::CURIOSITY,
+        std::chrono::system_clock::now() + std::chrono::milliseconds(150), temporary));
+    EXPECT_EQ(manager.getEmotionValue(Emotion::EmotionType::CURIOSITY), temporary);
+    EXPECT_TRUE(waitUntil([&] { return manager.getEmotionValue(Emotion::EmotionType::CURIOSITY) == defaultValue; },
+        std::chrono::milliseconds(1000)));
+}
+
+TEST(PersonalityManagerTest, RampReachesTargetThenReturnsToDefault)
+{
+    PersonalityManager manager;
+    const int defaultValue = manager.getEmotionValue(Emotion::EmotionType::EMPATHY);
+    const int target = defaultValue > 50 ? 5 : 95;
+    const auto now = std::chrono::system_clock::now();
+
+    ASSERT_TRUE(manager.setEmotion(Emotion::EmotionType::EMPATHY, now + std::chrono::milliseconds(300), target,
+        now + std::chrono::milliseconds(900), Emotion::TimeTargetType::TARGET_RAMP_LINEAR));
+    EXPECT_TRUE(waitUntil([&] {
+        const int value = manager.getEmotionValue(Emotion::EmotionType::EMPATHY);
+        return value != defaultValue && value != target;
+    }, std::chrono::milliseconds(300)));
+    EXPECT_TRUE(waitUntil([&] { return manager.getEmotionValue(Emotion::EmotionType::EMPATHY) == defaultValue; },
+        std::chrono::milliseconds(2000)));
+}
+
+TEST(PersonalityManagerTest, ReadersNeverSeeTornSnapshots)
+{
+    PersonalityManager manager;
+    // Defaults come straight from settings and are not clamped, so accept them as well.
+    const auto initial = manager.getSnapshot();
+    std::atomic<bool> stop { false };
+    std::atomic<int> bad { 0 };
+    std::vector<std::thread> readers;
+    for (int i = 0; i < 4; ++i) {
+        readers.emplace_back([&] {
+            uint64_t lastVersion = 0;
+            while (!stop.load()) {
+                const auto snapshot = manager.getSnapshot();
+                if (snapshot.version % 2 != 0 || snapshot.version < lastVersion)
+                    bad.fetch_add(1);
+                for (size_t slot = 0; slot < EMOTION_SLOT_COUNT; ++slot) {
+                    const int value = snapshot.values[slot];
+                    if (value != initial.values[slot] && (value < EMOTION_MIN_VALUE || value > EMOTION_MAX_VALUE))
+                        bad.fetch_add(1);
+                }
+                lastVersion = snapshot.version;
+            }
+        });
+    }
+    for (int i = 0; i < 20000; ++i) {
+        manager.setEmotion(emotionAtSlot(i % EMOTION_SLOT_COUNT), EMOTION_MIN_VALUE + i % EMOTION_MAX_VALUE);
+    }
+    stop = true;
+    for (auto& reader : readers)
+        reader.join();
+    EXPECT_EQ(bad.load(), 0);
+}
+
+TEST(PersonalityManagerTest, IdleManagerDoesNotBurnCpu)
+{
+    PersonalityManager manager;
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    const auto cpuBefore = processCpuTime();
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    EXPECT_LT(processCpuTime() - cpuBefore, std::chrono::milliseconds(10));
+}
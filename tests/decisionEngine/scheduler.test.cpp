@@ -0,0 +1,198 @@
+#include <gtest/gtest.h>
+
+#include "../../src/decisionEngine/scheduler.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+using namespace DecisionEngine;
+
+namespace {
+
+bool waitUntil(const std::function<bool()>& predicate, std::chrono::milliseconds timeout)
+{
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (predicate()) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return predicate();
+}
+
+std::chrono::nanoseconds processCpuTime()
+{
+    timespec ts {};
+    clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+    return std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec);
+}
+
+TimePoint utcDate(int y, unsigned m, unsigned d, int hour = 0)
+{
+    using namespace std::chrono;
+    return time_point_cast<TimePoint::duration>(sys_days(year_month_day { year(y), month(m), day(d) }) + hours(hour));
+}
+
+std::shared_ptr<Intent> makeIntent(const std::string& name, std::function<void()> fn = {})
+{
+    return std::make_shared<Intent>(name, [fn](const Parameters&, Intent) {
+        if (fn) {
+            fn();
+        }
+    });
+}
+
+} // namespace
+
+TEST(SchedulerTest, MonthlyRepeatClampsToEndOfMonth)
+{
+    using Interval = ScheduledTask::RepeatInterval::Interval;
+    const ScheduledTask::RepeatInterval monthly(Interval::REPEAT_MONTHS, 1);
+    const auto anchor = utcDate(2024, 1, 31, 9);
+
+    EXPECT_EQ(ScheduledTask::nextOccurrence(anchor, monthly, 1), utcDate(2024, 2, 29, 9));
+    EXPECT_EQ(ScheduledTask::nextOccurrence(anchor, monthly, 2), utcDate(2024, 3, 31, 9));
+    EXPECT_EQ(ScheduledTask::nextOccurrence(anchor, monthly, 3), utcDate(2024, 4, 30, 9));
+    EXPECT_EQ(ScheduledTask::nextOccurrence(anchor, monthly, 13), utcDate(2025, 2, 28, 9));
+
+    const ScheduledTask::RepeatInterval yearly(Interval::REPEAT_YEARS, 1);
+    EXPECT_EQ(ScheduledTask::nextOccurrence(utcDate(2024, 2, 29), yearly, 1), utcDate(2025, 2, 28));
+    EXPECT_EQ(ScheduledTask::nextOccurrence(utcDate(2024, 2, 29), yearly, 4), utcDate(2028, 2, 29));
+}
+
+TEST(SchedulerTest, RescheduleSkipsMissedOccurrencesWithoutDrift)
+{
+    using Interval = ScheduledTask::RepeatInterval::Interval;
+    const auto anchor = utcDate(2025, 6, 1);
+    ScheduledTask task(makeIntent("daily"), anchor, ScheduledTask::RepeatInterval(Interval::REPEAT_DAYS, 1));
+
+    // Executed late: the next run stays on the anchor's time of day.
+    ASSERT_TRUE(task.rescheduleAfterExecution(anchor + std::chrono::minutes(5)));
+    EXPECT_EQ(task.getSchedule().time, utcDate(2025, 6, 2));
+
+    // Several days missed: jump to the first occurrence after now.
+    ASSERT_TRUE(task.rescheduleAfterExecution(utcDate(2025, 6, 5, 12)));
+    EXPECT_EQ(task.getSchedule().time, utcDate(2025, 6, 6));
+
+    ScheduledTask bounded(makeIntent("bounded"), anchor, ScheduledTask::RepeatInterval(Interval::REPEAT_DAYS, 1), utcDate(2025, 6, 2));
+    EXPECT_TRUE(bounded.rescheduleAfterExecution(anchor));
+    EXPECT_FALSE(bounded.rescheduleAfterExecution(utcDate(2025, 6, 2)));
+}
+
+TEST(SchedulerTest, RemoveAndRescheduleByHandleAndName)
+{
+    Scheduler scheduler;
+    const auto later = std::chrono::system_clock::now() + std::chrono::hours(1);
+    const auto a = scheduler.addTask(ScheduledTask(makeIntent("alpha"), later + std::chrono::minutes(2)));
+    const auto b = scheduler.addTask(ScheduledTask(makeIntent("beta"), later + std::chrono::minutes(1)));
+    scheduler.addTask(ScheduledTask(makeIntent("gamma"), later + std::chrono::minutes(3)));
+    ASSERT_EQ(scheduler.taskCount(), 3u);
+    EXPECT_EQ(scheduler.nextDueTime(), later + std::chrono::minutes(1));
+
+    EXPECT_TRUE(scheduler.rescheduleTask(a, later));
+    EXPECT_EQ(scheduler.nextDueTime(), later);
+
+    scheduler.removeTask(a);
+    EXPECT_EQ(scheduler.nextDueTime(), later + std::chrono::minutes(1));
+    scheduler.removeTask(std::string("beta"));
+    EXPECT_EQ(scheduler.nextDueTime(), later + std::chrono::minutes(3));
+    EXPECT_EQ(scheduler.taskCount(), 1u);
+    EXPECT_FALSE(scheduler.rescheduleTask(b, later));
+}
+
+TEST(SchedulerTest, EarlierTaskWakesSleepingScheduler)
+{
+    Scheduler scheduler;
+    scheduler.start();
+    scheduler.addTask(ScheduledTask(makeIntent("far"), std::chrono::system_clock::now() + std::chrono::hours(1)));
+    // Let the thread go to sleep on the far deadline before adding the near one.
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    std::atomic<bool> fired { false };
+    scheduler.addTask(ScheduledTask(makeIntent("near", [&]() { fired = true; }), std::chrono::system_clock::now() + std::chrono::milliseconds(20)));
+    EXPECT_TRUE(waitUntil([&]() { return fired.load(); }, std::chrono::milliseconds(1000)));
+    EXPECT_EQ(scheduler.taskCount(), 1u);
+    scheduler.stop();
+}
+
+TEST(SchedulerTest, DisabledOneShotWaitsUntilReEnabled)
+{
+    Scheduler scheduler;
+    scheduler.start();
+    std::atomic<int> fired { 0 };
+    ScheduledTask task(makeIntent("paused", [&]() { fired++; }), std::chrono::system_clock::now() + std::chrono::milliseconds(10));
+    task.setEnabled(false);
+    const auto handle = scheduler.addTask(task);
+
+    // Past due and disabled: kept, but not fired and not holding the head of the heap.
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_EQ(fired.load(), 0);
+    EXPECT_EQ(scheduler.taskCount(), 1u);
+    EXPECT_EQ(scheduler.nextDueTime(), std::nullopt);
+
+    EXPECT_TRUE(scheduler.setTaskEnabled(handle, true));
+    EXPECT_TRUE(waitUntil([&]() { return fired.load() == 1; }, std::chrono::milliseconds(1000)));
+    EXPECT_TRUE(waitUntil([&]() { return scheduler.taskCount() == 0; }, std::chrono::milliseconds(1000)));
+    EXPECT_FALSE(scheduler.setTaskEnabled(handle, true));
+    scheduler.stop();
+}
+
+TEST(SchedulerTest, HundredThousandTasksFireWithLowJitter)
+{
+    constexpr size_t taskCount = 100000;
+    Scheduler scheduler;
+
+    std::mutex latenessMutex;
+    std::vector<std::chrono::microseconds> lateness;
+    lateness.reserve(taskCount);
+    std::atomic<size_t> fired { 0 };
+
+    const auto base = std::chrono::system_clock::now() + std::chrono::milliseconds(300);
+    for (size_t i = 0; i < taskCount; ++i) {
+        const auto due = base + std::chrono::microseconds((i * 7919) % 1000000);
+        scheduler.addTask(ScheduledTask(makeIntent("task-" + std::to_string(i), [&, due]() {
+            const auto late = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now() - due);
+            {
+                std::lock_guard<std::mutex> lock(latenessMutex);
+                lateness.push_back(late);
+            }
+            fired.fetch_add(1, std::memory_order_relaxed);
+        }), due));
+    }
+    ASSERT_EQ(scheduler.taskCount(), taskCount);
+    scheduler.start();
+
+    ASSERT_TRUE(waitUntil([&]() { return fired.load() == taskCount; }, std::chrono::seconds(20)));
+    EXPECT_EQ(scheduler.taskCount(), 0u);
+    scheduler.stop();
+
+    std::lock_guard<std::mutex> lock(latenessMutex);
+    std::sort(lateness.begin(), lateness.end());
+    EXPECT_GE(lateness.front().count(), 0);
+    // Generous bounds for loaded CI machines; the old 100 ms poll loop alone averaged ~50 ms late.
+    EXPECT_LT(lateness[lateness.size() / 2], std::chrono::milliseconds(20));
+    EXPECT_LT(lateness[lateness.size() * 99 / 100], std::chrono::milliseconds(100));
+}
+
+TEST(SchedulerTest, IdleSchedulerDoesNotBurnCpu)
+{
+    Scheduler scheduler;
+    scheduler.start();
+    for (int i = 0; i < 1000; ++i) {
+        scheduler.addTask(ScheduledTask(makeIntent("idle-" + std::to_string(i)), std::chrono::system_clock::now() + std::chrono::hours(1 + i)));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+
+    const auto cpuBefore = processCpuTime();
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    const auto cpuUsed = processCpuTime() - cpuBefore;
+    EXPECT_LT(cpuUsed, std::chrono::milliseconds(10));
+    scheduler.stop();
+}
@@ -0,0 +1,237 @@
+#include <gtest/gtest.h>
+
+#include "../../src/api/apiEventBroker.h"
+#include "../../src/decisionEngine/intentRegistry.h"
+#include "../../src/decisionEngine/triggers.h"
+#include "../../src/hardware/interactionEvents.h"
+
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+
+using namespace DecisionEngine;
+
+namespace {
+
+bool waitUntil(const std::function<bool()>& predicate, std::chrono::milliseconds timeout)
+{
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (predicate()) {
+            return true;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+    return predicate();
+}
+
+} // namespace
+
+TEST(TriggerManagerTest, EventTriggerFiresOnlyForSubscribedEvents)
+{
+    TriggerManager manager;
+    std::atomic<int> taps { 0 };
+    auto trig = std::make_shared<EventTrigger>([&]() { taps++; });
+    trig->subscribe("test", "tap");
+    trig->setEnabled(true);
+    const auto handle = manager.addTrigger(trig);
+
+    manager.notifyEvent("test", "lift_started");
+    manager.notifyEvent("other", "tap");
+    manager.notifyEvent("test", "tap");
+    manager.notifyEvent("test", "tap");
+    ASSERT_TRUE(waitUntil([&]() { return taps.load() == 2; }, std::chrono::milliseconds(500)));
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(taps.load(), 2);
+    const auto stats = manager.getTriggerStats(handle);
+    ASSERT_TRUE(stats.has_value());
+    EXPECT_EQ(stats->evaluations, 2u);
+    EXPECT_EQ(stats->fires, 2u);
+}
+
+TEST(TriggerManagerTest, EventTriggerCheckGuardsFiring)
+{
+    TriggerManager manager;
+    std::atomic<bool> allow { false };
+    std::atomic<int> fires { 0 };
+    auto trig = std::make_shared<EventTrigger>([&]() { fires++; }, [&]() { return allow.load(); });
+    trig->subscribe("test");
+    trig->setEnabled(true);
+    const auto handle = manager.addTrigger(trig);
+
+    manager.notifyEvent("test", "anything");
+    ASSERT_TRUE(waitUntil([&]() { return manager.getTriggerStats(handle)->evaluations == 1; }, std::chrono::milliseconds(500)));
+    EXPECT_EQ(fires.load(), 0);
+
+    allow = true;
+    manager.notifyEvent("test", "anything");
+    ASSERT_TRUE(waitUntil([&]() { return fires.load() == 1; }, std::chrono::milliseconds(500)));
+}
+
+TEST(TriggerManagerTest, InteractionAndBrokerEventsReachSubscribers)
+{
+    auto broker = std::make_shared<ApiEventBroker>();
+    TriggerManager manager;
+    manager.attachEventBroker(broker);
+
+    std::atomic<int> taps { 0 };
+    std::atomic<int> presence { 0 };
+    auto tapTrigger = std::make_shared<EventTrigger>([&]() { taps++; });
+    tapTrigger->subscribe("interaction", "tap");
+    tapTrigger->setEnabled(true);
+    manager.addTrigger(tapTrigger);
+    auto presenceTrigger = std::make_shared<EventTrigger>([&]() { presence++; });
+    presenceTrigger->subscribe("presence", "present");
+    presenceTrigger->setEnabled(true);
+    manager.addTrigger(presenceTrigger);
+
+    InteractionEvent tap;
+    tap.type = InteractionEventType::Tap;
+    InteractionEvents::publish(tap);
+    // The bridge's copy on the broker must not fire the trigger a second time.
+    broker->publish("interaction", "tap", nlohmann::json::object(), 0);
+    broker->publish("presence", "present", nlohmann::json::object(), 0);
+
+    ASSERT_TRUE(waitUntil([&]() { return taps.load() == 1 && presence.load() == 1; }, std::chrono::milliseconds(500)));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(taps.load(), 1);
+}
+
+TEST(TriggerManagerTest, TimeTriggerFiresAtDeadlineWithoutTicking)
+{
+    TriggerManager manager;
+    std::atomic<bool> fired { false };
+    std::chrono::system_clock::time_point firedAt;
+    const auto due = std::chrono::system_clock::now() + std::chrono::milliseconds(60);
+    auto trig = std::make_shared<TimeTrigger>(due, [&]() {
+        firedAt = std::chrono::system_clock::now();
+        fired = true;
+    });
+    trig->setEnabled(true);
+    const auto handle = manager.addTrigger(trig);
+
+    ASSERT_TRUE(waitUntil([&]() { return fired.load(); }, std::chrono::milliseconds(1000)));
+    EXPECT_GE(firedAt, due);
+    EXPECT_LT(firedAt - due, std::chrono::milliseconds(30));
+    EXPECT_FALSE(trig->isEnabled());
+    EXPECT_EQ(manager.getTriggerStats(handle)->evaluations, 1u);
+}
+
+TEST(TriggerManagerTest, PredicateFiresOnRisingEdgeAndBacksOff)
+{
+    TriggerManager manager;
+    std::atomic<bool> condition { false };
+    std::atomic<int> fires { 0 };
+    auto trig = std::make_shared<EventTrigger>([&]() { fires++; }, [&]() { return condition.load(); });
+    trig->setEnabled(true);
+    const auto handle = manager.addTrigger(trig);
+
+    condition = true;
+    ASSERT_TRUE(waitUntil([&]() { return fires.load() == 1; }, std::chrono::milliseconds(1000)));
+    // Staying true does not fire again, and evaluations slow down while nothing changes.
+    std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+    EXPECT_EQ(fires.load(), 1);
+    const auto evaluations = manager.getTriggerStats(handle)->evaluations;
+    EXPECT_LT(evaluations, 1000u / TRIGGER_POLL_MIN_INTERVAL_MS);
+
+    condition = false;
+    std::this_thread::sleep_for(std::chrono::milliseconds(TRIGGER_POLL_MAX_INTERVAL_MS + 100));
+    condition = true;
+    ASSERT_TRUE(waitUntil([&]() { return fires.load() == 2; }, std::chrono::milliseconds(2 * TRIGGER_POLL_MAX_INTERVAL_MS)));
+}
+
+TEST(TriggerManagerTest, SourcelessEventTriggerOnlyFiresManually)
+{
+    TriggerManager manager;
+    std::atomic<int> fires { 0 };
+    auto registry = std::make_shared<IntentRegistry>();
+    registry->registerIntent("manualOnly", std::make_shared<Intent>("manualOnly", [&](const Parameters&, Intent) { fires++; }));
+    manager.setIntentRegistry(registry);
+
+    const auto endpoints = manager.getHttpEndpointData();
+    auto call = [&](const std::string& name, const std::string& body) {
+        for (const auto& endpoint : endpoints) {
+            if (std::get<2>(endpoint) == name) {
+                httplib::Request req;
+                httplib::Response res;
+                req.set_header("Content-Type", "application/json");
+                req.body = body;
+                std::get<1>(endpoint)(req, res);
+                return nlohmann::json::parse(res.body);
+            }
+        }
+        return nlohmann::json();
+    };
+
+    const auto created = call("createEventTrigger", R"({"intentName":"manualOnly"})");
+    ASSERT_TRUE(created.value("success", false));
+    const auto handle = created["handle"].get<TriggerManager::TriggerHandle>();
+    std::this_thread::sleep_for(std::chrono::milliseconds(5 * TRIGGER_POLL_MIN_INTERVAL_MS));
+    EXPECT_EQ(fires.load(), 0);
+    EXPECT_EQ(manager.getTriggerStats(handle)->evaluations, 0u);
+
+    ASSERT_TRUE(call("fireTrigger", "{\"handle\":" + std::to_string(handle) + "}").value("success", false));
+    EXPECT_EQ(fires.load(), 1);
+}
+
+TEST(TriggerManagerTest, RemovedAndDisabledTriggersDoNotFire)
+{
+    TriggerManager manager;
+    std::atomic<int> fires { 0 };
+    auto trig = std::make_shared<EventTrigger>([&]() { fires++; });
+    trig->subscribe("test", "tap");
+    trig->setEnabled(true);
+    const auto handle = manager.addTrigger(trig);
+
+    ASSERT_TRUE(manager.setTriggerEnabled(handle, false));
+    manager.notifyEvent("test", "tap");
+    ASSERT_TRUE(manager.removeTrigger(handle));
+    EXPECT_FALSE(manager.removeTrigger(handle));
+    manager.notifyEvent("test", "tap");
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(fires.load(), 0);
+    EXPECT_FALSE(manager.getTriggerStats(handle).has_value());
+}
+
+TEST(TriggerManagerTest, OverlappingSubscriptionsEvaluateOncePerEvent)
+{
+    TriggerManager manager;
+    std::atomic<int> fires { 0 };
+    auto trig = std::make_shared<EventTrigger>([&]() { fires++; });
+    trig->subscribe("test", "tap");
+    trig->subscribe("test");
+    trig->setEnabled(true);
+    const auto handle = manager.addTrigger(trig);
+
+    manager.notifyEvent("test", "tap");
+    ASSERT_TRUE(waitUntil([&]() { return fires.load() == 1; }, std::chrono::milliseconds(500)));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    EXPECT_EQ(fires.load(), 1);
+    EXPECT_EQ(manager.getTriggerStats(handle)->evaluations, 1u);
+}
+
+TEST(TriggerManagerTest, SetTimeAndDirectEnableRearmTheDeadline)
+{
+    TriggerManager manager;
+    std::atomic<int> fires { 0 };
+    auto trig = std::make_shared<TimeTrigger>(std::chrono::system_clock::now() + std::chrono::hours(1), [&]() { fires++; });
+    trig->setEnabled(true);
+    manager.addTrigger(trig);
+
+    // Moving the time forward wakes the manager; nothing else is queued to wake it.
+    auto start = std::chrono::steady_clock::now();
+    trig->setTime(std::chrono::system_clock::now() + std::chrono::milliseconds(40));
+    ASSERT_TRUE(waitUntil([&]() { return fires.load() == 1; }, std::chrono::milliseconds(1000)));
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(500));
+
+    // Re-enabling on the trigger itself (not through setTriggerEnabled) arms it again.
+    trig->setTime(std::chrono::system_clock::now() + std::chrono::milliseconds(40));
+    start = std::chrono::steady_clock::now();
+    trig->setEnabled(true);
+    ASSERT_TRUE(waitUntil([&]() { return fires.load() == 2; }, std::chrono::milliseconds(1000)));
+    EXPECT_LT(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(500));
+}
@@ -0,0 +1,150 @@
+#include <gtest/gtest.h>
+
+#include "../../src/gui/animationTrack.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <vector>
+
+namespace {
+
+AnimationKeyframe keyframe(Animations::AnimationType type, float value, unsigned int start, unsigned int end, Animations::AnimationEasing easing = Animations::AnimationEasing::LINEAR)
+{
+    AnimationKeyframe frame;
+    frame.type = type;
+    frame.value = value;
+    frame.timeStart = start;
+    frame.timeEnd = end;
+    frame.easing = easing;
+    frame.easingFunction = easingFunctionFor(easing);
+    frame.axis = glm::vec3(0.f, 1.f, 0.f);
+    frame.point = glm::vec3(0.f, 0.f, -16.5f);
+    return frame;
+}
+
+// The first frames of Character_TheCube's anim_neutral_1.
+std::vector<AnimationKeyframe> neutral()
+{
+    using Animations::AnimationEasing;
+    using Animations::AnimationType;
+    return {
+        keyframe(AnimationType::ROTATE_ABOUT, -30.f, 0, 20, AnimationEasing::EASE_IN_OUT),
+        keyframe(AnimationType::SCALE_XYZ, -0.9f, 0, 20),
+        keyframe(AnimationType::ROTATE_ABOUT, 30.f, 20, 25, AnimationEasing::EASE_IN),
+        keyframe(AnimationType::SCALE_XYZ, 1.2f, 20, 35),
+        keyframe(AnimationType::TRANSLATE, 0.5f, 25, 50, AnimationEasing::EASE_IN_OUT),
+        keyframe(AnimationType::ROTATE_ABOUT, 360.f, 25, 75),
+        keyframe(AnimationType::NOP, 0.f, 60, 180, AnimationEasing::EASE_IN_OUT),
+        keyframe(AnimationType::RETURN_HOME, 1.f, 180, 200),
+    };
+}
+
+} // namespace
+
+TEST(AnimationTrackTest, LiveKeyframesMatchAScanOfEveryKeyframe)
+{
+    const auto keyframes = neutral();
+    AnimationTrack track(keyframes);
+    std::vector<AnimationStep> steps;
+    // forwards, then a jump back as when an animation restarts
+    std::vector<unsigned long long> frames;
+    for (unsigned long long f = 0; f < 210; f++) {
+        frames.push_back(f);
+    }
+    frames.push_back(22);
+    frames.push_back(3);
+    for (auto f : frames) {
+        std::vector<uint32_t> live, expected;
+        for (uint32_t i = 0; i < keyframes.size(); i++) {
+            if (keyframes[i].timeStart <= f && keyframes[i].timeEnd > f) {
+                expected.push_back(i);
+            }
+        }
+        EXPECT_EQ(track.evaluate(f, steps, &live), !expected.empty()) << f;
+        EXPECT_EQ(live, expected) << f;
+    }
+}
+
+TEST(AnimationTrackTest, StepsUseTheKeyframeEasing)
+{
+    const auto keyframes = neutral();
+    AnimationTrack track(keyframes);
+    std::vector<AnimationStep> steps;
+    ASSERT_TRUE(track.evaluate(7, steps));
+    ASSERT_EQ(steps.size(), 2u);
+
+    const AnimationKeyframe& rotate = keyframes[0];
+    double expected = rotate.value * (rotate.easingFunction(7.0 / 20.0) - rotate.easingFunction(6.0 / 20.0));
+    EXPECT_EQ(steps[0].type, Animations::AnimationType::ROTATE_ABOUT);
+    EXPECT_EQ(steps[0].angle, static_cast<float>(expected));
+    EXPECT_EQ(steps[1].type, Animations::AnimationType::SCALE_XYZ);
+    EXPECT_EQ(steps[1].amount, glm::vec3(1.f, static_cast<float>(-0.9 * (1.0 / 20.0) + 1.0), 1.f));
+
+    for (auto easing : { Animations::AnimationEasing::LINEAR, Animations::AnimationEasing::EASE_IN, Animations::AnimationEasing::EASE_OUT, Animations::AnimationEasing::EASE_IN_OUT }) {
+        EXPECT_EQ(AnimationTrack::ease(easing, 0.3), easingFunctionFor(easing)(0.3));
+    }
+}
+
+TEST(AnimationTrackTest, StillAndNopKeyframesAreLiveButProduceNoSteps)
+{
+    AnimationTrack track({ keyframe(Animations::AnimationType::NOP, 5.f, 0, 10), keyframe(Animations::AnimationType::TRANSLATE, 0.f, 0, 10) });
+    std::vector<AnimationStep> steps;
+    EXPECT_TRUE(track.evaluate(4, steps));
+    EXPECT_TRUE(steps.empty());
+    EXPECT_FALSE(track.evaluate(10, steps));
+    EXPECT_FALSE(AnimationTrack().evaluate(0, steps));
+}
+
+TEST(AnimationTrackTest, FoldMatchesApplyingEachStepToTheModelMatrix)
+{
+    std::vector<AnimationStep> steps = {
+        { Animations::AnimationType::TRANSLATE, 0, 0.f, glm::vec3(0.2f, -0.1f, 0.f), glm::vec3(0.f), glm::vec3(0.f), 0.0 },
+        { Animations::AnimationType::ROTATE_ABOUT, 1, 12.f, glm::vec3(0.f), glm::vec3(0.f, 1.f, 0.f), glm::vec3(0.f, 0.f, -16.5f), 0.0 },
+        { Animations::AnimationType::SCALE_XYZ, 2, 0.f, glm::vec3(1.f, 0.95f, 1.f), glm::vec3(0.f), glm::vec3(0.f), 0.0 },
+        { Animations::AnimationType::ROTATE, 3, -4.f, glm::vec3(0.f), glm::vec3(1.f, 0.f, 0.f), glm::vec3(0.f), 0.0 },
+        { Animations::AnimationType::ROTATE_ABOUT, 4, 3.f, glm::vec3(0.f), glm::vec3(0.f, 0.f, 2.f), glm::vec3(1.f, 0.f, 0.f), 0.0 },
+    };
+    glm::mat4 model = glm::scale(glm::translate(glm::mat4(1.0f), glm::vec3(0.f, -0.5f, -2.f)), glm::vec3(1.5f));
+    glm::mat4 stepped = model;
+    for (const auto& step : steps) {
+        switch (step.type) {
+        case Animations::AnimationType::TRANSLATE:
+            stepped = glm::translate(stepped, step.amount);
+            break;
+        case Animations::AnimationType::ROTATE:
+            stepped = glm::rotate(stepped, glm::radians(step.angle), step.axis);
+            break;
+        case Animations::AnimationType::SCALE_XYZ:
+            stepped = glm::scale(stepped, step.amount);
+            break;
+        default: {
+            glm::mat4 about = glm::translate(glm::mat4(1.0f), step.point);
+            about = glm::rotate(about, glm::radians(step.angle), glm::normalize(step.axis));
+            stepped = glm::translate(about, -step.point) * stepped;
+            break;
+        }
+        }
+    }
+    AnimationDelta delta;
+    EXPECT_EQ(AnimationTrack::fold(steps, 0, delta), steps.size());
+    EXPECT_FALSE(delta.empty);
+    const glm::mat4 folded = delta.pre * model * delta.post;
+    for (int c = 0; c < 4; c++) {
+        for (int r = 0; r < 4; r++) {
+            EXPECT_NEAR(folded[c][r], stepped[c][r], 1e-5f) << c << "," << r;
+        }
+    }
+}
+
+TEST(AnimationTrackTest, FoldStopsAtStepsItCannotFold)
+{
+    std::vector<AnimationStep> steps = {
+        { Animations::AnimationType::TRANSLATE, 0, 0.f, glm::vec3(1.f, 0.f, 0.f), glm::vec3(0.f), glm::vec3(0.f), 0.0 },
+        { Animations::AnimationType::SCALE_XYZ, 1, 0.f, glm::vec3(1.f, 0.f, 1.f), glm::vec3(0.f), glm::vec3(0.f), 0.0 },
+        { Animations::AnimationType::RETURN_HOME, 2, 0.f, glm::vec3(0.f), glm::vec3(0.f), glm::vec3(0.f), 0.05 },
+    };
+    AnimationDelta delta;
+    EXPECT_EQ(AnimationTrack::fold(steps, 0, delta), 1u);
+    AnimationDelta next;
+    EXPECT_EQ(AnimationTrack::fold(steps, 2, next), 2u);
+    EXPECT_TRUE(next.empty);
+}
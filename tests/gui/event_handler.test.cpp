@@ -28,6 +28,7 @@ public:
         area_.xMax = xMax;
         area_.yMin = yMin;
         area_.yMax = yMax;
+        ClickableArea::changed();
     }
     void capturePosition() override { }
     void restorePosition() override { }
@@ -36,6 +37,7 @@ public:
     bool setIsClickable(bool isClickable) override
     {
         clickable_ = isClickable;
+        ClickableArea::changed();
         return clickable_;
     }
     void draw() override { }
@@ -125,3 +127,119 @@ TEST(EventManager, DragBeyondThresholdEmitsDragEventWithoutClick)
     EXPECT_EQ(clickable.mouseDownCount, 1);
     EXPECT_EQ(clickable.releaseCount, 1);
 }
+
+TEST(EventManager, RemovedAreasStopReceivingClicksAndDuplicatesAreIgnored)
+{
+    EventManager manager;
+    TestClickable clickable(0, 100, 0, 100);
+    manager.addClickableArea(clickable.getClickableArea());
+    manager.addClickableArea(clickable.getClickableArea());
+
+    CubeEvent press;
+    press.type = CubeEventType::MouseButtonPressed;
+    press.mouseButton = CubeMouseButton::Left;
+    press.x = 10;
+    press.y = 10;
+    CubeEvent release = press;
+    release.type = CubeEventType::MouseButtonReleased;
+
+    manager.triggerEvent(press);
+    manager.triggerEvent(release);
+    EXPECT_EQ(clickable.clickCount, 1);
+
+    EXPECT_TRUE(manager.removeClickableArea(clickable.getClickableArea()));
+    EXPECT_FALSE(manager.removeClickableArea(clickable.getClickableArea()));
+    EXPECT_FALSE(manager.triggerEvent(press));
+    EXPECT_FALSE(manager.triggerEvent(release));
+    EXPECT_EQ(clickable.clickCount, 1);
+}
+
+namespace {
+
+CubeEvent pointer(CubeEventType type, int x, int y)
+{
+    CubeEvent event;
+    event.type = type;
+    event.mouseButton = CubeMouseButton::Left;
+    event.x = x;
+    event.y = y;
+    return event;
+}
+
+void click(EventManager& manager, int x, int y)
+{
+    manager.triggerEvent(pointer(CubeEventType::MouseButtonPressed, x, y));
+    manager.triggerEvent(pointer(CubeEventType::MouseButtonReleased, x, y));
+}
+
+} // namespace
+
+TEST(EventManager, HitTestFollowsMovedHiddenAndOffscreenAreas)
+{
+    EventManager manager;
+    TestClickable entry(0, 720, 100, 150);
+    TestClickable overlay(300, 400, 0, 720);
+    TestClickable offscreen(-50, 60, 700, 900);
+    manager.addClickableArea(entry.getClickableArea());
+    manager.addClickableArea(overlay.getClickableArea());
+    manager.addClickableArea(offscreen.getClickableArea());
+
+    // Where areas overlap the first one registered wins, as it did with a linear scan.
+    click(manager, 350, 120);
+    EXPECT_EQ(entry.clickCount, 1);
+    EXPECT_EQ(overlay.clickCount, 0);
+
+    // Scrolling the entry away exposes the overlay underneath without re-registering anything.
+    entry.setClickAreaSize(0, 720, 20, 70);
+    click(manager, 350, 120);
+    EXPECT_EQ(overlay.clickCount, 1);
+    click(manager, 10, 40);
+    EXPECT_EQ(entry.clickCount, 2);
+
+    // Hidden areas drop out of the index and stop taking clicks.
+    entry.setIsClickable(false);
+    click(manager, 350, 40);
+    EXPECT_EQ(entry.clickCount, 2);
+    EXPECT_EQ(overlay.clickCount, 2);
+
+    entry.setIsClickable(true);
+    click(manager, 350, 40);
+    EXPECT_EQ(entry.clickCount, 3);
+
+    click(manager, 5, 710);
+    EXPECT_EQ(offscreen.clickCount, 1);
+}
+
+TEST(EventManager, DispatchFollowsHandlersRetypedAfterCreation)
+{
+    EventManager manager;
+    int keyPresses = 0;
+    int dragX = 0;
+    EventHandler* handler = manager.getEvent(manager.createEvent("Key"));
+    handler->setAction([&](const CubeEvent&) { ++keyPresses; });
+    handler->setEventType(CubeEventType::KeyPressed);
+
+    CubeEvent key;
+    key.type = CubeEventType::KeyPressed;
+    EXPECT_TRUE(manager.triggerEvent(CubeEventType::KeyPressed, key));
+    EXPECT_FALSE(manager.triggerEvent(CubeEventType::KeyReleased, key));
+    EXPECT_EQ(keyPresses, 1);
+
+    // A handler with a specific type only answers to that pair.
+    handler->setSpecificEventType(SpecificEventTypes::KEYPRESS_A);
+    EXPECT_FALSE(manager.triggerEvent(CubeEventType::KeyPressed, key));
+    EXPECT_TRUE(manager.triggerEvent(SpecificEventTypes::KEYPRESS_A, CubeEventType::KeyPressed, key));
+    EXPECT_EQ(keyPresses, 2);
+
+    // Handlers registered from inside a handler take effect on the next event.
+    handler->setAction([&](const CubeEvent&) {
+        ++keyPresses;
+        EventHandler* drag = manager.getEvent(manager.createEvent("DragX"));
+        drag->setEventType(CubeEventType::MouseMoved);
+        drag->setSpecificEventType(SpecificEventTypes::DRAG_X);
+        drag->setAction([&](const CubeEvent&) { ++dragX; });
+    });
+    EXPECT_TRUE(manager.triggerEvent(SpecificEventTypes::KEYPRESS_A, CubeEventType::KeyPressed, key));
+    EXPECT_TRUE(manager.triggerEvent(SpecificEventTypes::DRAG_X, CubeEventType::MouseMoved, key));
+    EXPECT_EQ(dragX, 1);
+}
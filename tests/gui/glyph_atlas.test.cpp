@@ -0,0 +1,75 @@
+#include <gtest/gtest.h>
+
+#include "../../src/gui/renderables/glyphAtlas.h"
+
+#include <random>
+#include <vector>
+
+namespace {
+
+struct PlacedRect {
+    int x;
+    int y;
+    int w;
+    int h;
+};
+
+bool overlaps(const PlacedRect& a, const PlacedRect& b)
+{
+    return a.x < b.x + b.w && b.x < a.x + a.w && a.y < b.y + b.h && b.y < a.y + a.h;
+}
+
+} // namespace
+
+TEST(SkylinePackerTest, PlacementsStayInBoundsAndNeverOverlap)
+{
+    SkylinePacker packer(256, 256);
+    std::mt19937 rng(7);
+    std::uniform_int_distribution<int> size(4, 28);
+    std::vector<PlacedRect> placed;
+    while (true) {
+        const int w = size(rng);
+        const int h = size(rng);
+        const auto origin = packer.pack(w, h);
+        if (!origin) {
+            break;
+        }
+        const PlacedRect rect { origin->x, origin->y, w, h };
+        ASSERT_GE(rect.x, 0);
+        ASSERT_GE(rect.y, 0);
+        ASSERT_LE(rect.x + rect.w, 256);
+        ASSERT_LE(rect.y + rect.h, 256);
+        for (const auto& other : placed) {
+            ASSERT_FALSE(overlaps(rect, other));
+        }
+        placed.push_back(rect);
+    }
+    EXPECT_GT(placed.size(), 100u);
+    EXPECT_GT(packer.occupancy(), 0.6f);
+}
+
+TEST(SkylinePackerTest, GlyphSizedRectsPackDensely)
+{
+    SkylinePacker packer(GLYPH_ATLAS_PAGE_SIZE, GLYPH_ATLAS_PAGE_SIZE);
+    int packed = 0;
+    while (packer.pack(17 + packed % 5, 25 + packed % 3)) {
+        ++packed;
+    }
+    EXPECT_GT(packer.occupancy(), 0.9f);
+    EXPECT_GT(packed, 1800);
+}
+
+TEST(SkylinePackerTest, RejectsOversizedAndRecoversAfterReset)
+{
+    SkylinePacker packer(64, 64);
+    EXPECT_FALSE(packer.pack(65, 1));
+    EXPECT_FALSE(packer.pack(0, 4));
+    ASSERT_TRUE(packer.pack(64, 64));
+    EXPECT_FALSE(packer.pack(1, 1));
+    packer.reset();
+    EXPECT_FLOAT_EQ(packer.occupancy(), 0.f);
+    const auto origin = packer.pack(10, 10);
+    ASSERT_TRUE(origin);
+    EXPECT_EQ(origin->x, 0);
+    EXPECT_EQ(origin->y, 0);
+}
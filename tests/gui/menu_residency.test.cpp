@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+
+#include "../../src/gui/menu/menuResidency.h"
+
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <set>
+
+namespace fs = std::filesystem;
+
+TEST(MenuResidencyTest, EvictsLeastRecentlyOpenedOverTheLimit)
+{
+    MenuResidency residency(2);
+    residency.touch("WiFi");
+    residency.touch("Sound");
+    residency.touch("Display");
+    EXPECT_EQ(residency.resident(), 3u);
+    EXPECT_EQ(residency.victims(nullptr, false), (std::vector<std::string> { "WiFi" }));
+
+    // Reopening WiFi makes Sound the oldest.
+    residency.touch("WiFi");
+    EXPECT_EQ(residency.victims(nullptr, false), (std::vector<std::string> { "Sound" }));
+
+    residency.forget("Sound");
+    EXPECT_FALSE(residency.contains("Sound"));
+    EXPECT_TRUE(residency.victims(nullptr, false).empty());
+}
+
+TEST(MenuResidencyTest, PinnedMenusAreSkipped)
+{
+    MenuResidency residency(1);
+    residency.touch("Connections");
+    residency.touch("WiFi");
+    residency.touch("WiFi Networks");
+    const std::set<std::string> path { "Connections", "WiFi Networks" };
+    auto pinned = [&path](const std::string& id) { return path.contains(id); };
+    EXPECT_EQ(residency.victims(pinned, false), (std::vector<std::string> { "WiFi" }));
+}
+
+TEST(MenuResidencyTest, PressureReturnsEverythingUnpinned)
+{
+    MenuResidency residency(8);
+    residency.touch("A");
+    residency.touch("B");
+    residency.touch("C");
+    EXPECT_TRUE(residency.victims(nullptr, false).empty());
+    auto pinned = [](const std::string& id) { return id == "C"; };
+    EXPECT_EQ(residency.victims(pinned, true), (std::vector<std::string> { "A", "B" }));
+}
+
+TEST(MenuResidencyTest, ReadsMemAvailable)
+{
+    const fs::path path = fs::temp_directory_path() / ("menu_residency_meminfo_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+    {
+        std::ofstream out(path);
+        out << "MemTotal:        3884192 kB\n"
+            << "MemFree:          120400 kB\n"
+            << "MemAvailable:     524288 kB\n";
+    }
+    EXPECT_EQ(MenuResidency::availableMemory(path.string()), std::optional<uint64_t> { 524288ull * 1024 });
+    fs::remove(path);
+    EXPECT_EQ(MenuResidency::availableMemory(path.string()), std::nullopt);
+}
@@ -0,0 +1,234 @@
+#include <gtest/gtest.h>
+
+#include "../../src/gui/renderables/meshBundle.h"
+
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+class MeshBundleTest : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        tempRoot_ = fs::temp_directory_path() / ("mesh_bundle_test_" + std::to_string(std::chrono::steady_clock::now().time_since_epoch().count()));
+        fs::create_directories(tempRoot_);
+    }
+
+    void TearDown() override { fs::remove_all(tempRoot_); }
+
+    std::string writeSource(const std::string& name, const std::string& contents)
+    {
+        const std::string path = (tempRoot_ / name).string();
+        std::ofstream(path, std::ios::binary) << contents;
+        return path;
+    }
+
+    uint64_t hashOf(const std::string& path)
+    {
+        uint64_t hash = 0;
+        EXPECT_TRUE(MeshBundle::hashFile(path, hash));
+        return hash;
+    }
+
+    std::string bundlePath() const { return (tempRoot_ / MeshBundle::FILE_NAME).string(); }
+
+    fs::path tempRoot_;
+};
+
+AnimationKeyframe keyframe(Animations::AnimationType type, float value, Animations::AnimationEasing easing)
+{
+    AnimationKeyframe frame;
+    frame.type = type;
+    frame.value = value;
+    frame.timeStart = 3;
+    frame.timeEnd = 12;
+    frame.easing = easing;
+    frame.easingFunction = easingFunctionFor(easing);
+    frame.axis = glm::vec3(0.f, 1.f, 0.f);
+    frame.point = glm::vec3(0.5f, -0.25f, 2.f);
+    return frame;
+}
+
+} // namespace
+
+TEST_F(MeshBundleTest, ObjMeshIsStoredIndexedAndExpandsToTheParsedVertices)
+{
+    const std::vector<Vertex> parsed = {
+        { 1.f, 0.f, 0.f, 1.f, 0.f, 0.f },
+        { 0.f, 1.f, 0.f, 1.f, 0.f, 0.f },
+        { 0.f, 0.f, 1.f, 1.f, 0.f, 0.f },
+        { 0.f, 1.f, 0.f, 1.f, 0.f, 0.f },
+        { 0.f, 0.f, 1.f, 1.f, 0.f, 0.f },
+        { 0.f, 0.f, 1.f, 0.f, 0.f, 1.f }, // same position, different colour
+    };
+    const std::string source = writeSource("Face.obj", "o Face\n");
+    MeshBundleWriter writer;
+    writer.addObjMesh("Face.obj", hashOf(source), parsed, 2);
+    ASSERT_TRUE(writer.write(bundlePath()));
+
+    MeshBundle bundle(bundlePath());
+    ASSERT_TRUE(bundle.isOpen());
+    const MeshBundleEntry* entry = bundle.findFresh(source, MeshBundleEntryKind::OBJ_MESH);
+    ASSERT_NE(entry, nullptr);
+    MeshBundleObjView view;
+    ASSERT_TRUE(bundle.objMesh(*entry, view));
+    EXPECT_EQ(view.header->shapeCount, 2u);
+    EXPECT_EQ(view.vertices.size(), 4u);
+    ASSERT_EQ(view.indices.size(), parsed.size());
+    for (size_t i = 0; i < parsed.size(); i++) {
+        EXPECT_EQ(std::memcmp(&view.vertices[view.indices[i]], &parsed[i], sizeof(Vertex)), 0) << i;
+    }
+    const glm::vec3 center = OBJObject::centerOf(parsed);
+    EXPECT_EQ(view.header->center[0], center.x);
+    EXPECT_EQ(view.header->center[1], center.y);
+    EXPECT_EQ(view.header->center[2], center.z);
+    EXPECT_EQ(view.header->width, OBJObject::widthOf(parsed));
+}
+
+TEST_F(MeshBundleTest, CubesAnimationsAndExpressionsRoundTrip)
+{
+    const std::string meshSource = writeSource("hand.mesh", "$CUBES\n0 0 0\n");
+    const std::string animSource = writeSource("anim_jump.json", "{}");
+    const std::string exprSource = writeSource("expr_happy.json", "{ }");
+
+    Animation animation;
+    animation.name = Animations::AnimationNames_enum::JUMP_UP;
+    animation.expression = "happy";
+    animation.keyframes = {
+        keyframe(Animations::AnimationType::TRANSLATE, 1.5f, Animations::AnimationEasing::EASE_IN_OUT),
+        keyframe(Animations::AnimationType::ROTATE_ABOUT, -90.f, Animations::AnimationEasing::EASE_OUT),
+    };
+    ExpressionDefinition expression;
+    expression.name = Expressions::ExpressionNames_enum::HAPPY;
+    expression.expression = "happy";
+    expression.objects = { "OpenEyesSmile", "ClosedEyesSmile" };
+    expression.visibility = { { true, false }, { false, true, true, false, true } };
+    expression.animationKeyframes = { keyframe(Animations::AnimationType::NOP, 0.f, Animations::AnimationEasing::LINEAR) };
+
+    MeshBundleWriter writer;
+    writer.addCubes("hand.mesh", hashOf(meshSource), { glm::vec4(-0.5f, 0.25f, 1.f, 2.f) });
+    writer.addAnimation("anim_jump.json", hashOf(animSource), animation);
+    writer.addExpression("expr_happy.json", hashOf(exprSource), expression);
+    ASSERT_TRUE(writer.write(bundlePath()));
+
+    MeshBundle bundle(bundlePath());
+    std::span<const MeshBundleCube> cubes;
+    const MeshBundleEntry* meshEntry = bundle.findFresh(meshSource, MeshBundleEntryKind::CUBE_MESH);
+    ASSERT_NE(meshEntry, nullptr);
+    ASSERT_TRUE(bundle.cubes(*meshEntry, cubes));
+    ASSERT_EQ(cubes.size(), 1u);
+    EXPECT_EQ(cubes[0].x, -0.5f);
+    EXPECT_EQ(cubes[0].scale, 2.f);
+
+    Animation loaded;
+    const MeshBundleEntry* animEntry = bundle.findFresh(animSource, MeshBundleEntryKind::ANIMATION);
+    ASSERT_NE(animEntry, nullptr);
+    ASSERT_TRUE(bundle.animation(*animEntry, loaded));
+    EXPECT_EQ(loaded.name, animation.name);
+    EXPECT_EQ(loaded.expression, "happy");
+    ASSERT_EQ(loaded.keyframes.size(), 2u);
+    EXPECT_EQ(loaded.keyframes[1].type, Animations::AnimationType::ROTATE_ABOUT);
+    EXPECT_EQ(loaded.keyframes[1].value, -90.f);
+    EXPECT_EQ(loaded.keyframes[1].timeEnd, 12u);
+    EXPECT_EQ(loaded.keyframes[1].point, glm::vec3(0.5f, -0.25f, 2.f));
+    EXPECT_EQ(loaded.keyframes[0].easingFunction(0.25), animation.keyframes[0].easingFunction(0.25));
+    EXPECT_EQ(loaded.keyframes[1].easingFunction(0.25), animation.keyframes[1].easingFunction(0.25));
+
+    ExpressionDefinition loadedExpression;
+    const MeshBundleEntry* exprEntry = bundle.findFresh(exprSource, MeshBundleEntryKind::EXPRESSION);
+    ASSERT_NE(exprEntry, nullptr);
+    ASSERT_TRUE(bundle.expression(*exprEntry, loadedExpression));
+    EXPECT_EQ(loadedExpression.name, Expressions::ExpressionNames_enum::HAPPY);
+    EXPECT_EQ(loadedExpression.objects, expression.objects);
+    EXPECT_EQ(loadedExpression.visibility, expression.visibility);
+    EXPECT_EQ(loadedExpression.animationKeyframes.size(), 1u);
+}
+
+TEST_F(MeshBundleTest, EditedOrMismatchedSourcesFallBackToParsing)
+{
+    const std::string source = writeSource("anim_spin.json", "{\"name\":\"funny_spin\"}");
+    MeshBundleWriter writer;
+    writer.addAnimation("anim_spin.json", hashOf(source), Animation {});
+    ASSERT_TRUE(writer.write(bundlePath()));
+
+    MeshBundle bundle(bundlePath());
+    EXPECT_NE(bundle.findFresh(source, MeshBundleEntryKind::ANIMATION), nullptr);
+    EXPECT_EQ(bundle.findFresh(source, MeshBundleEntryKind::EXPRESSION), nullptr);
+    EXPECT_EQ(bundle.findFresh(writeSource("anim_other.json", "{}"), MeshBundleEntryKind::ANIMATION), nullptr);
+
+    writeSource("anim_spin.json", "{\"name\":\"funny_jump\"}");
+    EXPECT_EQ(bundle.findFresh(source, MeshBundleEntryKind::ANIMATION), nullptr);
+}
+
+TEST_F(MeshBundleTest, InvalidBundlesAreIgnored)
+{
+    EXPECT_FALSE(MeshBundle((tempRoot_ / "missing.cmb").string()).isOpen());
+
+    writeSource(MeshBundle::FILE_NAME, std::string(64, 'x'));
+    MeshBundle garbage(bundlePath());
+    EXPECT_FALSE(garbage.isOpen());
+    EXPECT_EQ(garbage.findFresh(bundlePath(), MeshBundleEntryKind::OBJ_MESH), nullptr);
+}
+
+TEST_F(MeshBundleTest, CorruptLengthsInAPayloadAreRejected)
+{
+    const std::string source = writeSource("expr_happy.json", "{ }");
+    ExpressionDefinition expression;
+    expression.name = Expressions::ExpressionNames_enum::HAPPY;
+    expression.expression = "happy";
+    expression.objects = { "OpenEyesSmile" };
+    expression.visibility = { { true } };
+    MeshBundleWriter writer;
+    writer.addExpression("expr_happy.json", hashOf(source), expression);
+    ASSERT_TRUE(writer.write(bundlePath()));
+
+    std::string original;
+    {
+        std::ifstream file(bundlePath(), std::ios::binary);
+        original.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    }
+    MeshBundleEntry entry;
+    std::memcpy(&entry, original.data() + sizeof(MeshBundleHeader), sizeof(entry));
+    // Payload: name, expression string ("happy" padded to 8 bytes), object count, ...
+    const size_t expressionLength = entry.offset + sizeof(uint32_t);
+    const size_t objectCount = expressionLength + sizeof(uint32_t) + 8;
+
+    const auto loadWith = [&](size_t at, uint32_t value) {
+        std::string patched = original;
+        std::memcpy(patched.data() + at, &value, sizeof(value));
+        std::ofstream(bundlePath(), std::ios::binary | std::ios::trunc) << patched;
+        MeshBundle bundle(bundlePath());
+        const MeshBundleEntry* found = bundle.findFresh(source, MeshBundleEntryKind::EXPRESSION);
+        ExpressionDefinition loaded;
+        return found != nullptr && bundle.expression(*found, loaded);
+    };
+    EXPECT_TRUE(loadWith(objectCount, 1));
+    EXPECT_FALSE(loadWith(expressionLength, 0xFFFFFFFFu));
+    EXPECT_FALSE(loadWith(expressionLength, 0xFFFFFFFDu));
+    EXPECT_FALSE(loadWith(objectCount, 0x7FFFFFFFu));
+}
+
+TEST(AnimationKeyframeTest, EasingIsParsedToAnId)
+{
+    nlohmann::json frame = {
+        { "type", "TRANSLATE" },
+        { "value", 1.0 },
+        { "time", { { "start", 0 }, { "end", 10 } } },
+        { "axis", { { "x", 1 }, { "y", 0 }, { "z", 0 } } },
+        { "point", { { "x", 0 }, { "y", 0 }, { "z", 0 } } },
+        { "easing", "easeOut" },
+    };
+    AnimationKeyframe parsed = loadKeyframe(frame);
+    EXPECT_EQ(parsed.easing, Animations::AnimationEasing::EASE_OUT);
+    EXPECT_DOUBLE_EQ(parsed.easingFunction(0.5), 0.75);
+
+    frame["easing"] = "bounce";
+    EXPECT_EQ(loadKeyframe(frame).easing, Animations::AnimationEasing::LINEAR);
+}
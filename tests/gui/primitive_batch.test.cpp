@@ -0,0 +1,118 @@
+#include <gtest/gtest.h>
+
+#include "../../src/gui/renderables/primitiveBatch.h"
+
+#include <vector>
+
+namespace {
+
+// Twice the signed area of a triangle in the xy plane; the sign gives its winding.
+float winding(const Vertex& a, const Vertex& b, const Vertex& c)
+{
+    return (b.x - a.x) * (c.y - a.y) - (c.x - a.x) * (b.y - a.y);
+}
+
+std::vector<Vertex> unitSquareStrip()
+{
+    // Same order M_Rect uses for its fill.
+    return { { 1.f, 0.f, 0.f, 1.f }, { 0.f, 0.f, 0.f, 1.f }, { 1.f, 1.f, 0.f, 1.f }, { 0.f, 1.f, 0.f, 1.f } };
+}
+
+} // namespace
+
+TEST(PrimitiveBatchTest, FanBecomesTriangleListAroundTheCentre)
+{
+    const std::vector<Vertex> fan = { { 0.f, 0.f, 0.f, 0.5f }, { 1.f, 0.f, 0.f, 0.5f }, { 1.f, 1.f, 0.f, 0.5f }, { 0.f, 1.f, 0.f, 0.5f } };
+    std::vector<Vertex> triangles, lines;
+    ASSERT_TRUE(PrimitiveBatch::appendAsList(GL_TRIANGLE_FAN, glm::mat4(1.0f), fan, triangles, lines));
+    ASSERT_EQ(triangles.size(), 6u);
+    EXPECT_TRUE(lines.empty());
+    for (size_t i = 0; i < triangles.size(); i += 3) {
+        EXPECT_EQ(triangles[i].x, 0.f);
+        EXPECT_EQ(triangles[i].y, 0.f);
+        EXPECT_GT(winding(triangles[i], triangles[i + 1], triangles[i + 2]), 0.f);
+    }
+    EXPECT_EQ(triangles[0].r, 0.5f);
+}
+
+TEST(PrimitiveBatchTest, StripKeepsEveryTriangleFacingTheSameWay)
+{
+    std::vector<Vertex> triangles, lines;
+    ASSERT_TRUE(PrimitiveBatch::appendAsList(GL_TRIANGLE_STRIP, glm::mat4(1.0f), unitSquareStrip(), triangles, lines));
+    ASSERT_EQ(triangles.size(), 6u);
+    const float first = winding(triangles[0], triangles[1], triangles[2]);
+    const float second = winding(triangles[3], triangles[4], triangles[5]);
+    EXPECT_NE(first, 0.f);
+    EXPECT_EQ(first > 0.f, second > 0.f);
+}
+
+TEST(PrimitiveBatchTest, LoopsAndStripsBecomeLineLists)
+{
+    std::vector<Vertex> triangles, lines;
+    ASSERT_TRUE(PrimitiveBatch::appendAsList(GL_LINE_LOOP, glm::mat4(1.0f), unitSquareStrip(), triangles, lines));
+    EXPECT_EQ(lines.size(), 8u);
+    EXPECT_EQ(lines.back().x, 1.f);
+    EXPECT_EQ(lines.back().y, 0.f);
+    lines.clear();
+    ASSERT_TRUE(PrimitiveBatch::appendAsList(GL_LINE_STRIP, glm::mat4(1.0f), unitSquareStrip(), triangles, lines));
+    EXPECT_EQ(lines.size(), 6u);
+    lines.clear();
+    ASSERT_TRUE(PrimitiveBatch::appendAsList(GL_LINES, glm::mat4(1.0f), unitSquareStrip(), triangles, lines));
+    EXPECT_EQ(lines.size(), 4u);
+    EXPECT_TRUE(triangles.empty());
+}
+
+TEST(PrimitiveBatchTest, VerticesAreMovedByTheModelMatrix)
+{
+    glm::mat4 model(1.0f);
+    model[3] = glm::vec4(2.f, -1.f, 0.5f, 1.f);
+    std::vector<Vertex> triangles, lines;
+    ASSERT_TRUE(PrimitiveBatch::appendAsList(GL_LINES, model, { { 1.f, 1.f, 0.f, 1.f }, { 0.f, 0.f, 0.f, 1.f } }, triangles, lines));
+    ASSERT_EQ(lines.size(), 2u);
+    EXPECT_EQ(lines[0].x, 3.f);
+    EXPECT_EQ(lines[0].y, 0.f);
+    EXPECT_EQ(lines[0].z, 0.5f);
+    EXPECT_EQ(lines[1].x, 2.f);
+}
+
+TEST(PrimitiveBatchTest, ProjectiveModelsAreDividedByW)
+{
+    glm::mat4 model(1.0f);
+    model[3] = glm::vec4(0.f, 0.f, 0.f, 2.f);
+    std::vector<Vertex> triangles, lines;
+    ASSERT_TRUE(PrimitiveBatch::appendAsList(GL_LINES, model, { { 4.f, -2.f, 1.f, 1.f }, { 0.f, 0.f, 0.f, 1.f } }, triangles, lines));
+    ASSERT_EQ(lines.size(), 2u);
+    EXPECT_EQ(lines[0].x, 2.f);
+    EXPECT_EQ(lines[0].y, -1.f);
+    EXPECT_EQ(lines[0].z, 0.5f);
+    EXPECT_EQ(lines[1].x, 0.f);
+}
+
+TEST(PrimitiveBatchTest, OtherModesAreNotBatched)
+{
+    std::vector<Vertex> triangles, lines;
+    EXPECT_FALSE(PrimitiveBatch::appendAsList(GL_POINTS, glm::mat4(1.0f), unitSquareStrip(), triangles, lines));
+    EXPECT_TRUE(triangles.empty());
+    EXPECT_TRUE(lines.empty());
+}
+
+TEST(PrimitiveBatchTest, ScopesOnlyRecordWhileEnabled)
+{
+    PrimitiveBatch& batch = PrimitiveBatch::shared();
+    EXPECT_FALSE(batch.recording());
+    {
+        PrimitiveBatch::Scope outer;
+        {
+            PrimitiveBatch::Scope inner;
+            EXPECT_TRUE(batch.recording());
+        }
+        EXPECT_TRUE(batch.recording());
+    }
+    EXPECT_FALSE(batch.recording());
+    batch.setEnabled(false);
+    {
+        PrimitiveBatch::Scope scope;
+        EXPECT_FALSE(batch.recording());
+    }
+    batch.setEnabled(true);
+}
@@ -0,0 +1,95 @@
+#include <gtest/gtest.h>
+
+#include "../../src/gui/renderDamage.h"
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace {
+
+struct DamageReset {
+    DamageReset() { RenderDamage::take(); }
+    ~DamageReset()
+    {
+        RenderDamage::setWakeHook(nullptr);
+        RenderDamage::take();
+    }
+};
+
+} // namespace
+
+TEST(RenderDamageTest, NothingPendingMeansNoFrame)
+{
+    DamageReset reset;
+    EXPECT_FALSE(RenderDamage::pending());
+    EXPECT_FALSE(RenderDamage::take().dirty);
+}
+
+TEST(RenderDamageTest, TakeConsumesDamage)
+{
+    DamageReset reset;
+    RenderDamage::invalidate();
+    EXPECT_TRUE(RenderDamage::pending());
+    const auto frame = RenderDamage::take();
+    EXPECT_TRUE(frame.dirty);
+    EXPECT_TRUE(frame.full);
+    EXPECT_FALSE(RenderDamage::pending());
+    EXPECT_FALSE(RenderDamage::take().dirty);
+}
+
+TEST(RenderDamageTest, RectsAreUnitedUntilSomethingDamagesEverything)
+{
+    DamageReset reset;
+    RenderDamage::invalidate(DamageRect { 10, 10, 20, 5 });
+    RenderDamage::invalidate(DamageRect { 100, 0, 10, 40 });
+    auto frame = RenderDamage::take();
+    ASSERT_TRUE(frame.dirty);
+    EXPECT_FALSE(frame.full);
+    EXPECT_EQ(frame.rect.x, 10);
+    EXPECT_EQ(frame.rect.y, 0);
+    EXPECT_EQ(frame.rect.width, 100);
+    EXPECT_EQ(frame.rect.height, 40);
+
+    RenderDamage::invalidate(DamageRect { 0, 0, 4, 4 });
+    RenderDamage::invalidate();
+    frame = RenderDamage::take();
+    EXPECT_TRUE(frame.full);
+
+    // An empty rect is not damage at all.
+    RenderDamage::invalidate(DamageRect {});
+    EXPECT_FALSE(RenderDamage::pending());
+}
+
+TEST(RenderDamageTest, CoveringRoundsOutwardWithMargin)
+{
+    const auto rect = DamageRect::covering(2.5f, 10.2f, 40.1f, 3.9f);
+    EXPECT_EQ(rect.x, 1);
+    EXPECT_EQ(rect.y, 2);
+    EXPECT_EQ(rect.x + rect.width, 42);
+    EXPECT_EQ(rect.y + rect.height, 12);
+}
+
+TEST(RenderDamageTest, WakeHookRunsOncePerIdleToDirtyTransition)
+{
+    DamageReset reset;
+    std::atomic<int> wakes = 0;
+    RenderDamage::setWakeHook([&wakes]() { wakes++; });
+
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; t++) {
+        threads.emplace_back([]() {
+            for (int i = 0; i < 1000; i++) {
+                RenderDamage::invalidate();
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(wakes.load(), 1);
+
+    RenderDamage::take();
+    RenderDamage::invalidate(DamageRect { 0, 0, 1, 1 });
+    EXPECT_EQ(wakes.load(), 2);
+}
@@ -0,0 +1,147 @@
+#include <gtest/gtest.h>
+
+#include "../../src/gui/drawList.h"
+#include "../../src/gui/objects.h"
+#include "../../src/gui/sceneGraph.h"
+
+#include <vector>
+
+namespace {
+
+glm::vec3 origin(const glm::mat4& m)
+{
+    return { m[3].x, m[3].y, m[3].z };
+}
+
+// Records its draws; the key stands in for a program/texture pair.
+class FakeMesh : public MeshObject {
+public:
+    FakeMesh(int id, GLuint texture, std::vector<int>* drawn)
+        : id(id)
+        , texture(texture)
+        , drawn(drawn)
+    {
+    }
+    void draw() override { this->drawn->push_back(this->id); }
+    uint64_t drawKey() override { return DrawList::key(nullptr, this->texture); }
+    void setProjectionMatrix(glm::mat4) override { }
+    void setViewMatrix(glm::vec3) override { }
+    void setViewMatrix(glm::mat4) override { }
+    void setModelMatrix(glm::mat4) override { }
+    glm::mat4 getModelMatrix() override { return glm::mat4(1.0f); }
+    glm::mat4 getViewMatrix() override { return glm::mat4(1.0f); }
+    glm::mat4 getProjectionMatrix() override { return glm::mat4(1.0f); }
+    void translate(glm::vec3) override { }
+    void rotate(float, glm::vec3) override { }
+    void scale(glm::vec3) override { }
+    void uniformScale(float) override { }
+    void rotateAbout(float, glm::vec3) override { }
+    void rotateAbout(float, glm::vec3, glm::vec3) override { }
+    glm::vec3 getCenterPoint() override { return glm::vec3(0.0f); }
+    std::vector<Vertex> getVertices() override { return {}; }
+    float getWidth() override { return 0.0f; }
+    void capturePosition() override { }
+    void restorePosition() override { }
+    void setVisibility(bool) override { }
+    void getRestorePositionDiff(glm::mat4*, glm::mat4*, glm::mat4*) override { }
+
+private:
+    int id;
+    GLuint texture;
+    std::vector<int>* drawn;
+};
+
+} // namespace
+
+TEST(SceneGraphTest, ParentTranslationPropagatesToChildren)
+{
+    SceneGraph graph;
+    const SceneNode parent = graph.create();
+    const SceneNode child = graph.create(parent);
+    graph.translate(child, { 1.f, 0.f, 0.f });
+    graph.translate(parent, { 0.f, 2.f, 0.f });
+    graph.update();
+    EXPECT_EQ(origin(graph.world(parent)), glm::vec3(0.f, 2.f, 0.f));
+    EXPECT_EQ(origin(graph.world(child)), glm::vec3(1.f, 2.f, 0.f));
+    EXPECT_EQ(origin(graph.local(child)), glm::vec3(1.f, 0.f, 0.f));
+}
+
+TEST(SceneGraphTest, UpdateOnlyRecomputesChangedSubtrees)
+{
+    SceneGraph graph;
+    const SceneNode a = graph.create();
+    const SceneNode b = graph.create();
+    std::vector<SceneNode> aChildren;
+    for (int i = 0; i < 4; i++) {
+        aChildren.push_back(graph.create(a));
+    }
+    graph.create(b);
+    graph.create(b);
+    EXPECT_EQ(graph.update(), 8u);
+    EXPECT_EQ(graph.update(), 0u);
+
+    // Moving a root touches it and its descendants only, however many times it moved.
+    graph.translate(a, { 1.f, 0.f, 0.f });
+    graph.translate(a, { 1.f, 0.f, 0.f });
+    graph.translate(aChildren[0], { 0.f, 1.f, 0.f });
+    EXPECT_EQ(graph.update(), 5u);
+    EXPECT_EQ(origin(graph.world(aChildren[0])), glm::vec3(2.f, 1.f, 0.f));
+
+    graph.translate(aChildren[3], { 0.f, 0.f, 1.f });
+    EXPECT_EQ(graph.update(), 1u);
+}
+
+TEST(SceneGraphTest, DestroyedParentLeavesRootedChildren)
+{
+    SceneGraph graph;
+    const SceneNode parent = graph.create();
+    const SceneNode child = graph.create(parent);
+    graph.translate(parent, { 5.f, 0.f, 0.f });
+    graph.translate(child, { 1.f, 0.f, 0.f });
+    graph.update();
+    graph.destroy(parent);
+    EXPECT_EQ(graph.parent(child), INVALID_SCENE_NODE);
+    graph.update();
+    EXPECT_EQ(origin(graph.world(child)), glm::vec3(1.f, 0.f, 0.f));
+    EXPECT_EQ(graph.liveNodes(), 1u);
+}
+
+TEST(SceneGraphTest, DestroyedNodesAreReused)
+{
+    SceneGraph graph;
+    const SceneNode first = graph.create();
+    graph.translate(first, { 3.f, 0.f, 0.f });
+    graph.destroy(first);
+    const SceneNode second = graph.create();
+    EXPECT_EQ(second, first);
+    graph.update();
+    EXPECT_EQ(graph.world(second), glm::mat4(1.0f));
+}
+
+TEST(SceneGraphTest, ReparentingUnderADescendantIsRejected)
+{
+    SceneGraph graph;
+    const SceneNode parent = graph.create();
+    const SceneNode child = graph.create(parent);
+    graph.setParent(parent, child);
+    EXPECT_EQ(graph.parent(parent), INVALID_SCENE_NODE);
+    EXPECT_EQ(graph.parent(child), parent);
+}
+
+TEST(DrawListTest, GroupsByStateAndKeepsLayersAndInsertionOrder)
+{
+    std::vector<int> drawn;
+    FakeMesh text1(1, 7, &drawn), widget1(2, 9, &drawn), text2(3, 7, &drawn), widget2(4, 9, &drawn), top(5, 7, &drawn);
+    DrawList list;
+    list.add(&widget1);
+    list.add(&text1);
+    list.add(&top, 1);
+    list.add(&widget2);
+    list.add(&text2);
+    list.draw();
+    EXPECT_EQ(drawn, (std::vector<int> { 1, 3, 2, 4, 5 }));
+    EXPECT_EQ(list.lastStateChanges(), 3u);
+
+    list.clear();
+    EXPECT_TRUE(list.empty());
+}
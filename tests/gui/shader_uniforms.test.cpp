@@ -0,0 +1,193 @@
+#include <gtest/gtest.h>
+
+#include "../../src/gui/shader.h"
+
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace {
+
+// GLEW resolves every GL 2.0+ entry point through a writable function pointer, so the driver can be
+// replaced without a context. The fake program exposes the uniforms below at fixed locations and
+// records what the shader asks the driver for.
+struct FakeUniform {
+    const char* reportedName;
+    GLint location;
+};
+
+const std::vector<FakeUniform> fakeUniforms = {
+    { "model", 3 },
+    { "alpha", 7 },
+    { "weights[0]", 11 },
+    { "projection", -1 }, // lives in a uniform block
+};
+
+int locationQueries = 0;
+std::vector<GLint> floatUploads;
+std::vector<GLint> matrixUploads;
+
+GLuint GLAPIENTRY fakeCreateShader(GLenum) { return 1; }
+void GLAPIENTRY fakeShaderSource(GLuint, GLsizei, const GLchar* const*, const GLint*) { }
+void GLAPIENTRY fakeCompileShader(GLuint) { }
+void GLAPIENTRY fakeGetShaderiv(GLuint, GLenum, GLint* params) { *params = GL_TRUE; }
+void GLAPIENTRY fakeDeleteShader(GLuint) { }
+GLuint GLAPIENTRY fakeCreateProgram() { return 42; }
+void GLAPIENTRY fakeAttachShader(GLuint, GLuint) { }
+void GLAPIENTRY fakeLinkProgram(GLuint) { }
+void GLAPIENTRY fakeDeleteProgram(GLuint) { }
+
+void GLAPIENTRY fakeGetProgramiv(GLuint, GLenum name, GLint* params)
+{
+    switch (name) {
+    case GL_ACTIVE_UNIFORMS:
+        *params = static_cast<GLint>(fakeUniforms.size());
+        break;
+    case GL_ACTIVE_UNIFORM_MAX_LENGTH:
+        *params = 32;
+        break;
+    default:
+        *params = GL_TRUE;
+    }
+}
+
+void GLAPIENTRY fakeGetActiveUniform(GLuint, GLuint index, GLsizei bufSize, GLsizei* length, GLint* size, GLenum* type, GLchar* name)
+{
+    const char* reported = fakeUniforms[index].reportedName;
+    std::strncpy(name, reported, static_cast<size_t>(bufSize));
+    *length = static_cast<GLsizei>(std::strlen(reported));
+    *size = 1;
+    *type = GL_FLOAT;
+}
+
+GLint GLAPIENTRY fakeGetUniformLocation(GLuint, const GLchar* name)
+{
+    ++locationQueries;
+    for (const auto& uniform : fakeUniforms) {
+        if (std::strcmp(uniform.reportedName, name) == 0) {
+            return uniform.location;
+        }
+    }
+    return -1;
+}
+
+void GLAPIENTRY fakeUniform1f(GLint location, GLfloat) { floatUploads.push_back(location); }
+void GLAPIENTRY fakeUniformMatrix4fv(GLint location, GLsizei, GLboolean, const GLfloat*) { matrixUploads.push_back(location); }
+
+class ShaderUniformCacheTest : public ::testing::Test {
+protected:
+    void SetUp() override
+    {
+        saved = { glCreateShader, glShaderSource, glCompileShader, glGetShaderiv, glDeleteShader, glCreateProgram, glAttachShader,
+            glLinkProgram, glDeleteProgram, glGetProgramiv, glGetActiveUniform, glGetUniformLocation, glUniform1f, glUniformMatrix4fv };
+        glCreateShader = fakeCreateShader;
+        glShaderSource = fakeShaderSource;
+        glCompileShader = fakeCompileShader;
+        glGetShaderiv = fakeGetShaderiv;
+        glDeleteShader = fakeDeleteShader;
+        glCreateProgram = fakeCreateProgram;
+        glAttachShader = fakeAttachShader;
+        glLinkProgram = fakeLinkProgram;
+        glDeleteProgram = fakeDeleteProgram;
+        glGetProgramiv = fakeGetProgramiv;
+        glGetActiveUniform = fakeGetActiveUniform;
+        glGetUniformLocation = fakeGetUniformLocation;
+        glUniform1f = fakeUniform1f;
+        glUniformMatrix4fv = fakeUniformMatrix4fv;
+
+        sourcePath = std::filesystem::temp_directory_path() / "shader_uniform_cache_test.glsl";
+        std::ofstream(sourcePath) << "// compiled by the fake driver\n";
+        locationQueries = 0;
+        floatUploads.clear();
+        matrixUploads.clear();
+    }
+
+    void TearDown() override
+    {
+        Shader::setUniformCacheEnabled(true);
+        glCreateShader = saved.createShader;
+        glShaderSource = saved.shaderSource;
+        glCompileShader = saved.compileShader;
+        glGetShaderiv = saved.getShaderiv;
+        glDeleteShader = saved.deleteShader;
+        glCreateProgram = saved.createProgram;
+        glAttachShader = saved.attachShader;
+        glLinkProgram = saved.linkProgram;
+        glDeleteProgram = saved.deleteProgram;
+        glGetProgramiv = saved.getProgramiv;
+        glGetActiveUniform = saved.getActiveUniform;
+        glGetUniformLocation = saved.getUniformLocation;
+        glUniform1f = saved.uniform1f;
+        glUniformMatrix4fv = saved.uniformMatrix4fv;
+        std::filesystem::remove(sourcePath);
+    }
+
+    struct SavedEntryPoints {
+        PFNGLCREATESHADERPROC createShader;
+        PFNGLSHADERSOURCEPROC shaderSource;
+        PFNGLCOMPILESHADERPROC compileShader;
+        PFNGLGETSHADERIVPROC getShaderiv;
+        PFNGLDELETESHADERPROC deleteShader;
+        PFNGLCREATEPROGRAMPROC createProgram;
+        PFNGLATTACHSHADERPROC attachShader;
+        PFNGLLINKPROGRAMPROC linkProgram;
+        PFNGLDELETEPROGRAMPROC deleteProgram;
+        PFNGLGETPROGRAMIVPROC getProgramiv;
+        PFNGLGETACTIVEUNIFORMPROC getActiveUniform;
+        PFNGLGETUNIFORMLOCATIONPROC getUniformLocation;
+        PFNGLUNIFORM1FPROC uniform1f;
+        PFNGLUNIFORMMATRIX4FVPROC uniformMatrix4fv;
+    } saved {};
+    std::filesystem::path sourcePath;
+};
+
+} // namespace
+
+TEST_F(ShaderUniformCacheTest, KnownUniformsResolveToTheirLinkTimeLocations)
+{
+    Shader shader(sourcePath.string(), sourcePath.string());
+    const int queriesAtLink = locationQueries;
+
+    EXPECT_TRUE(shader.hasUniform(ShaderUniform::MODEL));
+    EXPECT_TRUE(shader.hasUniform(ShaderUniform::ALPHA));
+    EXPECT_FALSE(shader.hasUniform(ShaderUniform::PROJECTION));
+    EXPECT_FALSE(shader.hasUniform(ShaderUniform::TEXT_COLOR));
+
+    shader.setMat4(ShaderUniform::MODEL, glm::mat4(2.0f));
+    shader.setFloat(ShaderUniform::ALPHA, 0.5f);
+    shader.setFloat(ShaderUniform::TEXT_COLOR, 1.0f);
+    EXPECT_EQ(matrixUploads, std::vector<GLint> { 3 });
+    EXPECT_EQ(floatUploads, std::vector<GLint> { 7 });
+    EXPECT_EQ(locationQueries, queriesAtLink);
+}
+
+TEST_F(ShaderUniformCacheTest, ArraysAreRegisteredUnderTheirBareName)
+{
+    Shader shader(sourcePath.string(), sourcePath.string());
+    shader.setFloat("weights", 0.25f);
+    shader.setFloat("weights[0]", 0.5f);
+    EXPECT_EQ(floatUploads, std::vector<GLint> { 11 });
+}
+
+TEST_F(ShaderUniformCacheTest, RepeatedValuesAreNotUploadedAgain)
+{
+    Shader shader(sourcePath.string(), sourcePath.string());
+    shader.setFloat(ShaderUniform::ALPHA, 0.5f);
+    shader.setFloat(ShaderUniform::ALPHA, 0.5f);
+    shader.setFloat("alpha", 0.5f);
+    shader.setFloat(ShaderUniform::ALPHA, 0.75f);
+    EXPECT_EQ(floatUploads, (std::vector<GLint> { 7, 7 }));
+}
+
+TEST_F(ShaderUniformCacheTest, DisabledCacheQueriesTheDriverAndUploadsEveryTime)
+{
+    Shader shader(sourcePath.string(), sourcePath.string());
+    const int queriesAtLink = locationQueries;
+    Shader::setUniformCacheEnabled(false);
+    shader.setFloat(ShaderUniform::ALPHA, 0.5f);
+    shader.setFloat(ShaderUniform::ALPHA, 0.5f);
+    EXPECT_EQ(floatUploads, (std::vector<GLint> { 7, 7 }));
+    EXPECT_EQ(locationQueries, queriesAtLink + 2);
+}
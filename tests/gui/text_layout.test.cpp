@@ -0,0 +1,133 @@
+#include <gtest/gtest.h>
+
+#include "../../src/gui/renderables/textLayout.h"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+
+namespace {
+
+// Every glyph is 10 px wide and has no bitmap; 'X' is missing from the font.
+TextLayout::GlyphSource monospace(std::atomic<int>* calls = nullptr)
+{
+    return [calls](const std::string&, uint32_t codepoint, int) -> std::optional<TextLayout::Glyph> {
+        if (calls != nullptr) {
+            (*calls)++;
+        }
+        if (codepoint == 'X') {
+            return std::nullopt;
+        }
+        TextLayout::Glyph glyph;
+        glyph.codepoint = codepoint;
+        glyph.advance = 10 << 6;
+        return glyph;
+    };
+}
+
+float tenPixels(uint32_t)
+{
+    return 10.f;
+}
+
+std::vector<std::string> texts(const std::vector<TextLayout::Line>& lines)
+{
+    std::vector<std::string> out;
+    for (const auto& line : lines) {
+        out.push_back(line.text);
+    }
+    return out;
+}
+
+std::shared_ptr<const TextLayout::Result> await(TextLayout& layout, const std::string& text, int width)
+{
+    std::promise<std::shared_ptr<const TextLayout::Result>> ready;
+    auto future = ready.get_future();
+    if (auto cached = layout.request("font.ttf", text, 20, width, [&ready](auto result) { ready.set_value(result); })) {
+        return cached;
+    }
+    EXPECT_EQ(future.wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    return future.get();
+}
+
+} // namespace
+
+TEST(TextLayoutTest, WrapsOnMeasuredWidth)
+{
+    const auto lines = TextLayout::wrap("aaa bbb ccc\n\nlongwordthatdoesnotfit x", 75.f, tenPixels);
+    EXPECT_EQ(texts(lines), (std::vector<std::string> { "aaa bbb", "ccc", "", "longwordthatdoesnotfit", "x" }));
+    EXPECT_FLOAT_EQ(lines[0].width, 70.f);
+    EXPECT_FLOAT_EQ(lines[3].width, 220.f);
+
+    // Collapses runs of spaces, as the old wrapping did.
+    EXPECT_EQ(texts(TextLayout::wrap("a   b", 1000.f, tenPixels)), (std::vector<std::string> { "a b" }));
+    EXPECT_EQ(texts(TextLayout::wrap("", 100.f, tenPixels)), (std::vector<std::string> { "" }));
+}
+
+TEST(TextLayoutTest, DecodesUtf8AndDropsInvisibleCodepoints)
+{
+    EXPECT_EQ(TextLayout::codepoints("a\xC3\xA9\xE2\x80\x8B\t\xFF"), (std::vector<uint32_t> { 'a', 0xE9, '?' }));
+}
+
+TEST(TextLayoutTest, LaysOutOffThreadAndCachesTheResult)
+{
+    std::atomic<int> calls = 0;
+    TextLayout layout(4, monospace(&calls));
+    const auto first = await(layout, "abc abc abc", 75);
+    ASSERT_NE(first, nullptr);
+    EXPECT_EQ(texts(first->lines), (std::vector<std::string> { "abc abc", "abc" }));
+    // One render per distinct codepoint, including the space.
+    EXPECT_EQ(calls.load(), 4);
+    EXPECT_EQ(first->glyphs.size(), 4u);
+
+    EXPECT_EQ(layout.request("font.ttf", "abc abc abc", 20, 75, nullptr), first);
+    EXPECT_EQ(calls.load(), 4);
+    // Width, size and font are all part of the key.
+    EXPECT_EQ(layout.request("font.ttf", "abc abc abc", 20, 200, nullptr), nullptr);
+    EXPECT_EQ(layout.request("other.ttf", "abc abc abc", 20, 75, nullptr), nullptr);
+    const auto stats = layout.stats();
+    EXPECT_EQ(stats.hits, 1u);
+    EXPECT_EQ(stats.misses, 3u);
+}
+
+TEST(TextLayoutTest, MissingGlyphsAreMeasuredAsQuestionMarks)
+{
+    TextLayout layout(4, monospace());
+    const auto result = await(layout, "aXa", 1000);
+    EXPECT_FLOAT_EQ(result->lines[0].width, 30.f);
+}
+
+TEST(TextLayoutTest, ConcurrentRequestsForTheSameTextShareOneBuild)
+{
+    std::promise<void> release;
+    std::shared_future<void> gate = release.get_future().share();
+    TextLayout layout(4, [gate](const std::string&, uint32_t codepoint, int) -> std::optional<TextLayout::Glyph> {
+        gate.wait();
+        TextLayout::Glyph glyph;
+        glyph.codepoint = codepoint;
+        glyph.advance = 10 << 6;
+        return glyph;
+    });
+
+    std::promise<void> firstDone, secondDone;
+    // The first job occupies the worker, so the next two requests queue behind it.
+    layout.request("font.ttf", "busy", 20, 100, nullptr);
+    EXPECT_EQ(layout.request("font.ttf", "shared", 20, 100, [&](auto) { firstDone.set_value(); }), nullptr);
+    EXPECT_EQ(layout.request("font.ttf", "shared", 20, 100, [&](auto) { secondDone.set_value(); }), nullptr);
+    release.set_value();
+    EXPECT_EQ(firstDone.get_future().wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_EQ(secondDone.get_future().wait_for(std::chrono::seconds(5)), std::future_status::ready);
+    EXPECT_EQ(layout.stats().built, 2u);
+}
+
+TEST(TextLayoutTest, EvictsLeastRecentlyUsedLayouts)
+{
+    TextLayout layout(2, monospace());
+    const auto a = await(layout, "a", 100);
+    await(layout, "b", 100);
+    EXPECT_EQ(layout.request("font.ttf", "a", 20, 100, nullptr), a);
+    await(layout, "c", 100);
+    EXPECT_EQ(layout.stats().cached, 2u);
+    EXPECT_EQ(layout.request("font.ttf", "a", 20, 100, nullptr), a);
+    EXPECT_EQ(layout.request("font.ttf", "b", 20, 100, nullptr), nullptr);
+}
@@ -1,6 +1,7 @@
 #include "../../src/hardware/accel.h"
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <deque>
 
 namespace {
@@ -81,6 +82,176 @@ I2CBytes samplePayload(int16_t x, int16_t y, int16_t z)
     };
 }
 
+// Plays back a FIFO dump recorded at the sensor's ODR. Frames become visible as the fake clock advances, the
+// way the real FIFO fills between reads, and every bus call is counted as one I2C transaction.
+class FifoReplayBus final : public ILocalI2CBus {
+public:
+    FifoReplayBus(std::vector<I2CBytes> frames, int64_t samplePeriodMs)
+        : frames(std::move(frames))
+        , samplePeriodMs(samplePeriodMs)
+    {
+    }
+
+    std::expected<void, I2CError> write(uint16_t, const I2CBytes&, bool = false) override
+    {
+        ++transactions;
+        return { };
+    }
+
+    std::expected<I2CBytes, I2CError> writeRead(uint16_t, const I2CBytes& txData, size_t rxLen, bool = false) override
+    {
+        ++transactions;
+        const size_t produced = std::min(frames.size(), static_cast<size_t>(nowMs / samplePeriodMs) + 1);
+        switch (txData.at(0)) {
+        case 0x00:
+            return I2CBytes { 0x24 };
+        case 0x0C:
+            return frames[produced - 1];
+        case 0x24: {
+            const size_t bytes = (produced - fifoCursor) * 6;
+            return I2CBytes { static_cast<unsigned char>(bytes & 0xFF), static_cast<unsigned char>((bytes >> 8) & 0x3F) };
+        }
+        case 0x26: {
+            I2CBytes payload;
+            for (size_t index = 0; index < rxLen / 6; ++index, ++fifoCursor) {
+                const I2CBytes frame = fifoCursor < produced ? frames[fifoCursor] : I2CBytes { 0x00, 0x80, 0x00, 0x80, 0x00, 0x80 };
+                payload.insert(payload.end(), frame.begin(), frame.end());
+            }
+            return payload;
+        }
+        default:
+            return std::unexpected(I2CError::IO_FAILED);
+        }
+    }
+
+    size_t buffered() const
+    {
+        return std::min(frames.size(), static_cast<size_t>(nowMs / samplePeriodMs) + 1) - fifoCursor;
+    }
+
+    std::vector<I2CBytes> frames;
+    int64_t samplePeriodMs = 10;
+    int64_t nowMs = 0;
+    size_t fifoCursor = 0;
+    size_t transactions = 0;
+};
+
+// Deterministic desk noise: +/-20 LSB (about 2.5 mg) from a fixed-seed LCG.
+class DeskNoise {
+public:
+    int16_t next()
+    {
+        state = state * 1664525u + 1013904223u;
+        return static_cast<int16_t>(static_cast<int32_t>(state >> 24) % 40 - 20);
+    }
+
+private:
+    uint32_t state = 12345;
+};
+
+// Synthetic trace: ten seconds of a cube resting on a desk at 100 Hz with desk noise, tapped once at each
+// index. A tap is modelled as a +9000 LSB (1.1 g) z spike followed by one -3000 LSB sample of ringing.
+std::vector<I2CBytes> syntheticDeskTapTrace(const std::vector<size_t>& tapIndices)
+{
+    std::vector<I2CBytes> frames;
+    DeskNoise noise;
+    for (size_t index = 0; index < 1000; ++index) {
+        int16_t z = static_cast<int16_t>(8192 + noise.next());
+        if (std::find(tapIndices.begin(), tapIndices.end(), index) != tapIndices.end()) {
+            z = static_cast<int16_t>(z + 9000);
+        } else if (index > 0 && std::find(tapIndices.begin(), tapIndices.end(), index - 1) != tapIndices.end()) {
+            z = static_cast<int16_t>(z - 3000);
+        }
+        frames.push_back(samplePayload(noise.next(), noise.next(), z));
+    }
+    return frames;
+}
+
+// Synthetic trace: two seconds at rest at 100 Hz, then the cube is lifted. z ramps up by 0.3 g over 50 ms,
+// holds for a second, and ramps back down over 50 ms. No single 10 ms step reaches the lift threshold.
+std::vector<I2CBytes> syntheticLiftTrace()
+{
+    std::vector<I2CBytes> frames;
+    DeskNoise noise;
+    constexpr int16_t kRampStep = 492; // 0.06 g
+    int16_t lift = 0;
+    for (size_t index = 0; index < 400; ++index) {
+        if (index >= 200 && index < 205) {
+            lift = static_cast<int16_t>(lift + kRampStep);
+        } else if (index >= 305 && index < 310) {
+            lift = static_cast<int16_t>(lift - kRampStep);
+        }
+        frames.push_back(samplePayload(noise.next(), noise.next(), static_cast<int16_t>(8192 + lift + noise.next())));
+    }
+    return frames;
+}
+
+struct ReplayCounts {
+    size_t taps = 0;
+    size_t motion = 0;
+    size_t samples = 0;
+    size_t transactions = 0;
+};
+
+Bmi270Accelerometer::MonotonicNowReader replayClock(const std::shared_ptr<FifoReplayBus>& bus)
+{
+    return [bus]() {
+        return std::chrono::steady_clock::time_point(std::chrono::milliseconds(bus->nowMs));
+    };
+}
+
+// Polls a single register snapshot every pollIntervalMs, the way the interaction loop does without a FIFO.
+ReplayCounts replayPolling(std::vector<I2CBytes> frames, int64_t pollIntervalMs)
+{
+    auto bus = std::make_shared<FifoReplayBus>(std::move(frames), 10);
+    const auto traceMs = static_cast<int64_t>(bus->frames.size()) * 10;
+    Bmi270Accelerometer polling(bus);
+    polling.setMonotonicNowReader(replayClock(bus));
+    EXPECT_TRUE(polling.configureInteractionDetection(Bmi270InteractionConfig {}).has_value());
+    bus->transactions = 0;
+    ReplayCounts counts;
+    for (bus->nowMs = 0; bus->nowMs < traceMs; bus->nowMs += pollIntervalMs) {
+        const auto status = polling.pollInteractionStatus();
+        EXPECT_TRUE(status.has_value());
+        if (!status) {
+            break;
+        }
+        counts.taps += status->interruptStatus.tapDetected ? 1 : 0;
+        counts.motion += status->interruptStatus.motionDetected ? 1 : 0;
+        counts.samples += status->sampleCount;
+    }
+    counts.transactions = bus->transactions;
+    return counts;
+}
+
+// Drains the FIFO exactly when the watermark interrupt would fire.
+ReplayCounts replayFifo(std::vector<I2CBytes> frames, uint16_t watermark)
+{
+    auto bus = std::make_shared<FifoReplayBus>(std::move(frames), 10);
+    const auto traceMs = static_cast<int64_t>(bus->frames.size()) * 10;
+    Bmi270Accelerometer fifo(bus);
+    fifo.setMonotonicNowReader(replayClock(bus));
+    EXPECT_TRUE(fifo.setFifoConfig(Bmi270FifoConfig { .outputDataRateHz = 100, .watermarkSamples = watermark }).has_value());
+    EXPECT_TRUE(fifo.configureInteractionDetection(Bmi270InteractionConfig {}).has_value());
+    EXPECT_TRUE(fifo.isFifoEnabled());
+    bus->transactions = 0;
+    ReplayCounts counts;
+    for (bus->nowMs = (watermark - 1) * 10; bus->nowMs < traceMs;
+        bus->nowMs = static_cast<int64_t>(bus->fifoCursor + watermark - 1) * 10) {
+        EXPECT_GE(bus->buffered(), watermark);
+        const auto batch = fifo.pollInteractionStatus();
+        EXPECT_TRUE(batch.has_value());
+        if (!batch) {
+            break;
+        }
+        counts.taps += batch->interruptStatus.tapDetected ? 1 : 0;
+        counts.motion += batch->interruptStatus.motionDetected ? 1 : 0;
+        counts.samples += batch->sampleCount;
+    }
+    counts.transactions = bus->transactions;
+    return counts;
+}
+
 TEST(Bmi270AccelerometerTest, ReadsExpectedChipIdRegister)
 {
     auto bus = std::make_shared<FakeI2CBus>();
@@ -182,4 +353,135 @@ TEST(Bmi270AccelerometerTest, UnexpectedChipIdMarksDeviceUnavailable)
     EXPECT_FALSE(accelerometer.isAvailable());
 }
 
+TEST(Bmi270AccelerometerTest, FifoModeConfiguresWatermarkInterruptAndFlushes)
+{
+    auto bus = std::make_shared<FakeI2CBus>();
+    bus->readResponse = I2CBytes { 0x24 };
+
+    Bmi270Accelerometer accelerometer(bus);
+    ASSERT_TRUE(accelerometer.setFifoConfig(Bmi270FifoConfig { .outputDataRateHz = 100, .watermarkSamples = 16 }).has_value());
+    EXPECT_FALSE(accelerometer.isFifoEnabled());
+    ASSERT_TRUE(accelerometer.initialize().has_value());
+    EXPECT_TRUE(accelerometer.isFifoEnabled());
+
+    auto wrote = [&bus](uint8_t reg, uint8_t value) {
+        return std::ranges::any_of(bus->writeCalls, [&](const FakeI2CBus::WriteCall& call) {
+            return call.txData == I2CBytes { reg, value };
+        });
+    };
+    EXPECT_TRUE(wrote(0x7C, 0x00));
+    EXPECT_TRUE(wrote(0x40, 0xA8));
+    EXPECT_TRUE(wrote(0x46, 96));
+    EXPECT_TRUE(wrote(0x47, 0));
+    EXPECT_TRUE(wrote(0x49, 0x40));
+    EXPECT_TRUE(wrote(0x58, 0x02));
+    EXPECT_TRUE(wrote(0x7D, 0x04));
+    ASSERT_FALSE(bus->writeCalls.empty());
+    EXPECT_EQ(bus->writeCalls.back().txData, (I2CBytes { 0x7E, 0xB0 }));
+}
+
+TEST(Bmi270AccelerometerTest, InvalidFifoConfigurationIsRejected)
+{
+    auto bus = std::make_shared<FakeI2CBus>();
+    Bmi270Accelerometer accelerometer(bus);
+
+    const auto badRate = accelerometer.setFifoConfig(Bmi270FifoConfig { .outputDataRateHz = 120, .watermarkSamples = 16 });
+    ASSERT_FALSE(badRate.has_value());
+    EXPECT_EQ(badRate.error(), Bmi270Error::InvalidConfig);
+
+    const auto badWatermark = accelerometer.setFifoConfig(Bmi270FifoConfig { .outputDataRateHz = 100, .watermarkSamples = 0 });
+    ASSERT_FALSE(badWatermark.has_value());
+    EXPECT_EQ(badWatermark.error(), Bmi270Error::InvalidConfig);
+}
+
+TEST(Bmi270AccelerometerTest, FifoFailureFallsBackToPolling)
+{
+    auto bus = std::make_shared<FakeI2CBus>();
+    bus->readResponse = I2CBytes { 0x24 };
+    bus->writeError = I2CError::IO_FAILED;
+
+    Bmi270Accelerometer accelerometer(bus);
+    ASSERT_TRUE(accelerometer.setFifoConfig(Bmi270FifoConfig {}).has_value());
+    ASSERT_TRUE(accelerometer.initialize().has_value());
+    EXPECT_FALSE(accelerometer.isFifoEnabled());
+}
+
+TEST(Bmi270AccelerometerTest, DrainsFifoBatchWithLengthAndBurstRead)
+{
+    auto bus = std::make_shared<FakeI2CBus>();
+    bus->queuedResponses.push_back(I2CBytes { 0x24 });
+    Bmi270Accelerometer accelerometer(bus);
+    ASSERT_TRUE(accelerometer.setFifoConfig(Bmi270FifoConfig {}).has_value());
+    ASSERT_TRUE(accelerometer.initialize().has_value());
+    bus->writeReadCalls.clear();
+
+    I2CBytes fifo;
+    for (const auto& frame : { samplePayload(0, 0, 8192), samplePayload(0, 0, 16384), samplePayload(-32768, -32768, -32768) }) {
+        fifo.insert(fifo.end(), frame.begin(), frame.end());
+    }
+    bus->queuedResponses.push_back(I2CBytes { 19, 0 });
+    bus->queuedResponses.push_back(fifo);
+
+    const auto batch = accelerometer.pollInteractionStatus();
+
+    ASSERT_TRUE(batch.has_value());
+    EXPECT_EQ(batch->sampleCount, 2u);
+    EXPECT_TRUE(batch->interruptStatus.tapDetected);
+    EXPECT_TRUE(batch->interruptStatus.motionDetected);
+    ASSERT_TRUE(batch->latestSample.has_value());
+    EXPECT_FLOAT_EQ(batch->latestSample->zG, 2.0f);
+    ASSERT_EQ(bus->writeReadCalls.size(), 2u);
+    EXPECT_EQ(bus->writeReadCalls[0].txData, (I2CBytes { 0x24 }));
+    EXPECT_EQ(bus->writeReadCalls[0].rxLen, 2u);
+    EXPECT_EQ(bus->writeReadCalls[1].txData, (I2CBytes { 0x26 }));
+    EXPECT_EQ(bus->writeReadCalls[1].rxLen, 18u);
+}
+
+TEST(Bmi270AccelerometerTest, ReplayedFifoDumpCatchesTapsThatPollingMisses)
+{
+    const std::vector<size_t> taps { 101, 233, 347, 460, 512, 678, 795, 903 };
+    constexpr int64_t kTraceMs = 10000;
+
+    const auto polling = replayPolling(syntheticDeskTapTrace(taps), 50);
+    const auto fifo = replayFifo(syntheticDeskTapTrace(taps), 16);
+
+    // Every sample is classified, so every tap is caught exactly once.
+    EXPECT_EQ(fifo.taps, taps.size());
+    EXPECT_EQ(fifo.samples, 992u);
+    EXPECT_LE(polling.taps, 2u);
+
+    // 50 ms polling costs 20 transactions/s; a length read plus a burst read per 160 ms batch costs 12.5.
+    const double seconds = static_cast<double>(kTraceMs) / 1000.0;
+    EXPECT_DOUBLE_EQ(static_cast<double>(polling.transactions) / seconds, 20.0);
+    EXPECT_LE(static_cast<double>(fifo.transactions) / seconds, 12.5);
+}
+
+TEST(Bmi270AccelerometerTest, FifoTapDetectionRateIsPinned)
+{
+    // Thirty taps 170-300 ms apart, so no two share a 160 ms batch: all of them are reported, once each, and the resting desk never is.
+    std::vector<size_t> taps;
+    for (size_t index = 40, gap = 0; taps.size() < 30; index += 17 + (gap++ * 7) % 14) {
+        taps.push_back(index);
+    }
+    ASSERT_LT(taps.back(), 990u);
+
+    EXPECT_EQ(replayFifo(syntheticDeskTapTrace(taps), 16).taps, taps.size());
+    const auto resting = replayFifo(syntheticDeskTapTrace({}), 16);
+    EXPECT_EQ(resting.taps, 0u);
+    EXPECT_EQ(resting.motion, 0u);
+}
+
+TEST(Bmi270AccelerometerTest, FifoMeasuresLiftDeltasOverThePollSpacing)
+{
+    // The lift thresholds were tuned on 50 ms polls; a ramp that only clears them over 50 ms must still be seen
+    // when the same motion arrives as 10 ms FIFO frames.
+    const auto polling = replayPolling(syntheticLiftTrace(), 50);
+    const auto fifo = replayFifo(syntheticLiftTrace(), 16);
+
+    EXPECT_GE(polling.motion, 1u);
+    EXPECT_GE(fifo.motion, 1u);
+    EXPECT_EQ(polling.taps, 0u);
+    EXPECT_EQ(fifo.taps, 0u);
+}
+
 } // namespace
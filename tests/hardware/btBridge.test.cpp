@@ -0,0 +1,199 @@
+#include "../../src/hardware/btBridge.h"
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <mutex>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+namespace {
+
+using namespace std::chrono_literals;
+
+std::string socketPath(const std::string& name)
+{
+    return (std::filesystem::temp_directory_path() / ("bt-bridge-" + name + "-" + std::to_string(::getpid()) + ".sock")).string();
+}
+
+bool waitUntil(const std::function<bool()>& predicate, std::chrono::milliseconds timeout = 2000ms)
+{
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (predicate()) {
+            return true;
+        }
+        std::this_thread::sleep_for(2ms);
+    }
+    return predicate();
+}
+
+BtBridgeOptions fastOptions(const std::string& path)
+{
+    BtBridgeOptions options;
+    options.socketPath = path;
+    options.authToken = "token";
+    options.requestTimeout = 1000ms;
+    options.reconnectDelay = 20ms;
+    return options;
+}
+
+TEST(BtBridgeFrameTest, ReaderReassemblesSplitAndBackToBackFrames)
+{
+    const std::string bytes = BtBridgeFrame::encode({ { "type", "ping" } }) + BtBridgeFrame::encode({ { "type", "notify" }, { "event", "device_paired" } });
+    BtBridgeFrameReader reader;
+    nlohmann::json frame;
+    reader.append(bytes.data(), 3);
+    EXPECT_EQ(reader.next(frame), BtBridgeFrameReader::Status::NeedMore);
+    reader.append(bytes.data() + 3, bytes.size() - 3);
+    ASSERT_EQ(reader.next(frame), BtBridgeFrameReader::Status::Frame);
+    EXPECT_EQ(frame["type"], "ping");
+    ASSERT_EQ(reader.next(frame), BtBridgeFrameReader::Status::Frame);
+    EXPECT_EQ(frame["event"], "device_paired");
+    EXPECT_EQ(reader.next(frame), BtBridgeFrameReader::Status::NeedMore);
+}
+
+TEST(BtBridgeFrameTest, ReaderRejectsOversizedAndNonObjectFrames)
+{
+    BtBridgeFrameReader oversized;
+    const char header[4] = { 0x7F, 0x00, 0x00, 0x00 };
+    oversized.append(header, sizeof(header));
+    nlohmann::json frame;
+    EXPECT_EQ(oversized.next(frame), BtBridgeFrameReader::Status::Invalid);
+
+    BtBridgeFrameReader array;
+    const std::string bytes = BtBridgeFrame::encode(nlohmann::json::array({ 1, 2 }));
+    array.append(bytes.data(), bytes.size());
+    EXPECT_EQ(array.next(frame), BtBridgeFrameReader::Status::Invalid);
+}
+
+TEST(BtBridgeClientTest, ConcurrentCallsShareOneConnection)
+{
+    const auto path = socketPath("calls");
+    BtBridgeStandIn helper(path);
+    helper.handle("echo", [](const nlohmann::json& params) -> std::expected<nlohmann::json, std::string> { return params; });
+    helper.handle("fail", [](const nlohmann::json&) -> std::expected<nlohmann::json, std::string> { return std::unexpected("nope"); });
+    ASSERT_TRUE(helper.start());
+
+    BtBridgeClient client(fastOptions(path));
+    client.start();
+    ASSERT_TRUE(waitUntil([&]() { return client.isConnected(); }));
+
+    std::atomic<int> matched { 0 };
+    std::vector<std::jthread> callers;
+    for (int caller = 0; caller < 8; caller++) {
+        callers.emplace_back([&, caller]() {
+            for (int call = 0; call < 50; call++) {
+                const nlohmann::json params { { "caller", caller }, { "call", call } };
+                if (auto result = client.call("echo", params); result && *result == params) {
+                    matched++;
+                }
+            }
+        });
+    }
+    callers.clear();
+    EXPECT_EQ(matched.load(), 400);
+    EXPECT_EQ(helper.clientCount(), 1u);
+    EXPECT_EQ(client.call("fail").error(), BtBridgeError::REMOTE_ERROR);
+    EXPECT_EQ(client.call("missing").error(), BtBridgeError::REMOTE_ERROR);
+}
+
+TEST(BtBridgeClientTest, NotificationsArriveWithoutPolling)
+{
+    const auto path = socketPath("notify");
+    BtBridgeStandIn helper(path);
+    ASSERT_TRUE(helper.start());
+
+    BtBridgeClient client(fastOptions(path));
+    std::mutex mutex;
+    std::vector<std::string> events;
+    client.addNotificationHandler([&](const std::string& event, const nlohmann::json& payload) {
+        std::lock_guard<std::mutex> lock(mutex);
+        events.push_back(event + ":" + payload.value("mac", ""));
+    });
+    client.start();
+    ASSERT_TRUE(waitUntil([&]() { return helper.clientCount() == 1; }));
+
+    helper.notify("pairing_request", { { "mac", "AA:BB" } });
+    helper.notify("gatt_write", { { "mac", "CC:DD" } });
+    ASSERT_TRUE(waitUntil([&]() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return events.size() == 2;
+    }));
+    std::lock_guard<std::mutex> lock(mutex);
+    EXPECT_EQ(events, (std::vector<std::string> { "pairing_request:AA:BB", "gatt_write:CC:DD" }));
+}
+
+TEST(BtBridgeClientTest, ReconnectsAndReplaysRegistrationsAfterHelperRestart)
+{
+    const auto path = socketPath("restart");
+    auto helper = std::make_unique<BtBridgeStandIn>(path);
+    ASSERT_TRUE(helper->start());
+
+    BtBridgeClient client(fastOptions(path));
+    std::mutex mutex;
+    std::vector<std::string> clientIds;
+    client.registerClient({ { "name", "control" } }, [&](const std::string& clientId) {
+        std::lock_guard<std::mutex> lock(mutex);
+        clientIds.push_back(clientId);
+    });
+    client.start();
+    ASSERT_TRUE(waitUntil([&]() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return clientIds.size() == 1;
+    }));
+
+    helper.reset();
+    ASSERT_TRUE(waitUntil([&]() { return !client.isConnected(); }));
+    EXPECT_EQ(client.call("echo").error(), BtBridgeError::NOT_CONNECTED);
+
+    helper = std::make_unique<BtBridgeStandIn>(path);
+    ASSERT_TRUE(helper->start());
+    ASSERT_TRUE(waitUntil([&]() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return clientIds.size() == 2;
+    }));
+    EXPECT_EQ(client.connectCount(), 2u);
+}
+
+TEST(BtBridgeClientTest, UnregisteredClientIsNotReplayedAfterReconnect)
+{
+    const auto path = socketPath("unregister");
+    auto helper = std::make_unique<BtBridgeStandIn>(path);
+    ASSERT_TRUE(helper->start());
+
+    BtBridgeClient client(fastOptions(path));
+    std::atomic<int> kept { 0 };
+    std::atomic<int> dropped { 0 };
+    client.registerClient({ { "name", "control" } }, [&](const std::string&) { kept++; });
+    const auto service = client.registerClient({ { "name", "service" } }, [&](const std::string&) { dropped++; });
+    client.start();
+    ASSERT_TRUE(waitUntil([&]() { return kept == 1 && dropped == 1; }));
+
+    client.unregisterClient(service);
+    helper.reset();
+    ASSERT_TRUE(waitUntil([&]() { return !client.isConnected(); }));
+    helper = std::make_unique<BtBridgeStandIn>(path);
+    ASSERT_TRUE(helper->start());
+    ASSERT_TRUE(waitUntil([&]() { return kept == 2; }));
+    EXPECT_EQ(dropped, 1);
+}
+
+TEST(BtBridgeClientTest, IdleConnectionIsKeptAliveWithPings)
+{
+    const auto path = socketPath("keepalive");
+    BtBridgeStandIn helper(path);
+    ASSERT_TRUE(helper.start());
+
+    auto options = fastOptions(path);
+    options.keepaliveInterval = 30ms;
+    BtBridgeClient client(options);
+    client.start();
+    ASSERT_TRUE(waitUntil([&]() { return helper.pingsReceived() >= 3; }));
+    EXPECT_TRUE(client.isConnected());
+    EXPECT_EQ(client.connectCount(), 1u);
+}
+
+} // namespace
@@ -0,0 +1,230 @@
+#include "../../src/hardware/hardwareEventBus.h"
+#include "../../src/hardware/interactionEvents.h"
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+using namespace std::chrono_literals;
+
+bool waitUntil(const std::function<bool()>& condition, std::chrono::milliseconds timeout = 1000ms)
+{
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!condition()) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(1ms);
+    }
+    return true;
+}
+
+InteractionEvent tap(uint64_t sequence)
+{
+    InteractionEvent event;
+    event.sequence = sequence;
+    event.type = InteractionEventType::Tap;
+    event.occurredAtEpochMs = 1000 + sequence;
+    return event;
+}
+
+TEST(BoundedEventQueueTest, RejectsPushWhenFullAndKeepsOrder)
+{
+    BoundedEventQueue<int> queue(3);
+    EXPECT_EQ(queue.capacity(), 4u);
+    for (int i = 0; i < 4; i++) {
+        EXPECT_TRUE(queue.tryPush(i));
+    }
+    EXPECT_FALSE(queue.tryPush(4));
+    int value = -1;
+    for (int i = 0; i < 4; i++) {
+        ASSERT_TRUE(queue.tryPop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(queue.readable());
+    EXPECT_FALSE(queue.tryPop(value));
+}
+
+TEST(HardwareEventBusTest, SlowSubscriberDoesNotHoldUpPublisherOrOthers)
+{
+    HardwareEventBus<InteractionEvent> bus("test_slow");
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    bus.subscribe([released](const InteractionEvent&) { released.wait(); });
+    std::atomic<int> fastSeen { 0 };
+    bus.subscribe([&fastSeen](const InteractionEvent&) { fastSeen++; });
+
+    const auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 1; i <= 10; i++) {
+        bus.publish(tap(i));
+    }
+    EXPECT_LT(std::chrono::steady_clock::now() - start, 50ms);
+    EXPECT_TRUE(waitUntil([&fastSeen] { return fastSeen.load() == 10; }));
+    release.set_value();
+}
+
+TEST(HardwareEventBusTest, CoalescesTapsQueuedBehindABusySubscriber)
+{
+    HardwareEventBus<InteractionEvent> bus("test_coalesce");
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    std::atomic<bool> entered { false };
+    std::mutex mutex;
+    std::vector<InteractionEvent> seen;
+    HardwareEventBus<InteractionEvent>::SubscribeOptions options;
+    options.coalesce = coalesceRepeatedTaps;
+    const auto handle = bus.subscribe([&](const InteractionEvent& event) {
+        entered = true;
+        released.wait();
+        std::lock_guard<std::mutex> lock(mutex);
+        seen.push_back(event);
+    },
+        options);
+
+    // The first tap is delivered on its own and holds the executor while the rest queue up.
+    bus.publish(tap(1));
+    ASSERT_TRUE(waitUntil([&entered] { return entered.load(); }));
+    for (uint64_t i = 2; i <= 6; i++) {
+        bus.publish(tap(i));
+    }
+    InteractionEvent lift;
+    lift.sequence = 7;
+    lift.type = InteractionEventType::LiftStarted;
+    bus.publish(lift);
+    release.set_value();
+    bus.unsubscribe(handle);
+
+    ASSERT_EQ(seen.size(), 3u);
+    EXPECT_EQ(seen[0].sequence, 1u);
+    EXPECT_EQ(seen[0].count, 1u);
+    EXPECT_EQ(seen[1].sequence, 6u);
+    EXPECT_EQ(seen[1].count, 5u);
+    EXPECT_EQ(seen[1].occurredAtEpochMs, 1006u);
+    EXPECT_EQ(seen[2].type, InteractionEventType::LiftStarted);
+}
+
+TEST(HardwareEventBusTest, InlineSubscriberSeesEveryEventOnThePublishingThread)
+{
+    HardwareEventBus<InteractionEvent> bus("test_inline");
+    std::vector<InteractionEvent> seen;
+    bool onPublisher = true;
+    const auto publisher = std::this_thread::get_id();
+    HardwareEventBus<InteractionEvent>::SubscribeOptions options;
+    options.inlineDelivery = true;
+    options.coalesce = coalesceRepeatedTaps;
+    const auto handle = bus.subscribe([&](const InteractionEvent& event) {
+        onPublisher = onPublisher && std::this_thread::get_id() == publisher;
+        seen.push_back(event);
+    },
+        options);
+
+    for (uint64_t i = 1; i <= 5; i++) {
+        bus.publish(tap(i));
+        ASSERT_EQ(seen.size(), i);
+    }
+    EXPECT_TRUE(onPublisher);
+    for (uint64_t i = 0; i < 5; i++) {
+        EXPECT_EQ(seen[i].sequence, i + 1);
+        EXPECT_EQ(seen[i].count, 1u);
+    }
+    EXPECT_EQ(bus.stats(handle)->delivered, 5u);
+    EXPECT_TRUE(bus.unsubscribe(handle));
+    bus.publish(tap(6));
+    EXPECT_EQ(seen.size(), 5u);
+}
+
+TEST(HardwareEventBusTest, FullQueueDropsAndCounts)
+{
+    HardwareEventBus<InteractionEvent> bus("test_drop");
+    std::promise<void> release;
+    auto released = release.get_future().share();
+    std::atomic<int> seen { 0 };
+    HardwareEventBus<InteractionEvent>::SubscribeOptions options;
+    options.queueCapacity = 4;
+    const auto handle = bus.subscribe([&](const InteractionEvent&) {
+        seen++;
+        released.wait();
+    },
+        options);
+
+    bus.publish(tap(1));
+    ASSERT_TRUE(waitUntil([&seen] { return seen.load() == 1; }));
+    for (uint64_t i = 2; i <= 11; i++) {
+        bus.publish(tap(i));
+    }
+    EXPECT_EQ(bus.stats(handle)->dropped, 6u);
+    release.set_value();
+    bus.unsubscribe(handle);
+    EXPECT_EQ(seen.load(), 5);
+}
+
+TEST(HardwareEventBusTest, UnsubscribeDeliversQueuedEventsAndStopsDelivery)
+{
+    HardwareEventBus<InteractionEvent> bus("test_unsubscribe");
+    std::vector<uint64_t> seen;
+    const auto handle = bus.subscribe([&seen](const InteractionEvent& event) {
+        std::this_thread::sleep_for(1ms);
+        seen.push_back(event.sequence);
+    });
+    for (uint64_t i = 1; i <= 20; i++) {
+        bus.publish(tap(i));
+    }
+    EXPECT_TRUE(bus.unsubscribe(handle));
+    EXPECT_EQ(seen.size(), 20u);
+    EXPECT_EQ(seen.back(), 20u);
+    EXPECT_FALSE(bus.unsubscribe(handle));
+    EXPECT_FALSE(bus.stats(handle).has_value());
+
+    bus.publish(tap(21));
+    EXPECT_EQ(seen.size(), 20u);
+}
+
+TEST(HardwareEventBusTest, DestructorWaitsForAnExecutorThatUnsubscribedItself)
+{
+    auto bus = std::make_unique<HardwareEventBus<InteractionEvent>>("test_self_unsubscribe");
+    std::atomic<HardwareEventBus<InteractionEvent>::Handle> handle { 0 };
+    std::atomic<bool> unsubscribed { false };
+    std::atomic<bool> finished { false };
+    handle = bus->subscribe([&](const InteractionEvent&) {
+        bus->unsubscribe(handle.load());
+        unsubscribed = true;
+        std::this_thread::sleep_for(20ms);
+        finished = true;
+    });
+
+    bus->publish(tap(1));
+    ASSERT_TRUE(waitUntil([&unsubscribed] { return unsubscribed.load(); }));
+    bus.reset();
+    EXPECT_TRUE(finished.load());
+}
+
+TEST(HardwareEventBusTest, ConcurrentPublishersLoseNothingWithRoom)
+{
+    HardwareEventBus<InteractionEvent> bus("test_concurrent");
+    std::atomic<uint64_t> sum { 0 };
+    HardwareEventBus<InteractionEvent>::SubscribeOptions options;
+    options.queueCapacity = 4096;
+    const auto handle = bus.subscribe([&sum](const InteractionEvent& event) { sum += event.sequence; }, options);
+
+    std::vector<std::thread> publishers;
+    for (int t = 0; t < 4; t++) {
+        publishers.emplace_back([&bus, t] {
+            for (uint64_t i = 1; i <= 500; i++) {
+                bus.publish(tap(static_cast<uint64_t>(t) * 500 + i));
+            }
+        });
+    }
+    for (auto& publisher : publishers) {
+        publisher.join();
+    }
+    bus.unsubscribe(handle);
+    EXPECT_EQ(sum.load(), 2000u * 2001u / 2u);
+}
+
+} // namespace
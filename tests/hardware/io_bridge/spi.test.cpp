@@ -3,6 +3,8 @@
 #include "../../../src/utils.h"
 #include <gtest/gtest.h>
 
+#include <numeric>
+
 namespace {
 
 class FakeIoBridgeTransport final : public IIoBridgeTransport {
@@ -19,6 +21,43 @@ public:
     std::expected<IoBridgePayload, IoBridgeError> response = IoBridgePayload { 0x04, 0x05 };
 };
 
+// Wires MOSI to MISO: each frame answers with its own tx bytes, zero padded to rxLen.
+class LoopbackIoBridgeTransport final : public IIoBridgeTransport {
+public:
+    explicit LoopbackIoBridgeTransport(size_t mtu)
+        : mtu_(mtu)
+    {
+    }
+
+    std::expected<IoBridgePayload, IoBridgeError> transact(const IoBridgeTransaction& transaction) override
+    {
+        EXPECT_LE(transaction.payload.size(), mtu_);
+        const auto request = SpixXferRequest::decode(transaction.payload);
+        if (!request) {
+            return std::unexpected(IoBridgeError::INVALID_RESPONSE);
+        }
+        requests.push_back(*request);
+        IoBridgePayload rx(request->rxLen, 0);
+        std::copy_n(request->tx.begin(), std::min(rx.size(), request->tx.size()), rx.begin());
+        return rx;
+    }
+
+    std::expected<std::vector<IoBridgePayload>, IoBridgeError> transactBatch(std::span<const IoBridgeTransaction> transactions) override
+    {
+        ++batchCount;
+        return IIoBridgeTransport::transactBatch(transactions);
+    }
+
+    size_t mtu() const override { return mtu_; }
+
+    int batchCount = 0;
+    // Copies of the decoded headers; tx views are not kept valid.
+    std::vector<SpixXferRequest> requests;
+
+private:
+    size_t mtu_;
+};
+
 class ScopedConfigValue {
 public:
     ScopedConfigValue(const std::string& key, const std::string& value)
@@ -77,4 +116,106 @@ TEST(BridgeSpiTest, EnabledByConfigAllowsBridgeTransfer)
     EXPECT_EQ(transport->lastTransaction.endpoint, IoBridgeEndpoint::Spi);
 }
 
+TEST(BridgeSpiTest, SpixXferRequestRoundTrips)
+{
+    const std::vector<uint8_t> tx { 0x9F, 0x00, 0x01 };
+    SpixXferRequest request;
+    request.txn = 0x1234;
+    request.mode = 3;
+    request.flags = SpixXferRequest::kFlagHoldChipSelect;
+    request.speedHz = 125000;
+    request.rxLen = 3;
+    request.handle = "flash";
+    request.tx = tx;
+
+    IoBridgePayload payload;
+    request.encodeTo(payload);
+    ASSERT_EQ(payload.size(), SpixXferRequest::headerBytes(5) + tx.size());
+
+    const auto decoded = SpixXferRequest::decode(payload);
+    ASSERT_TRUE(decoded.has_value());
+    EXPECT_EQ(decoded->txn, 0x1234);
+    EXPECT_EQ(decoded->mode, 3);
+    EXPECT_EQ(decoded->flags, SpixXferRequest::kFlagHoldChipSelect);
+    EXPECT_EQ(decoded->speedHz, 125000u);
+    EXPECT_EQ(decoded->rxLen, 3);
+    EXPECT_EQ(decoded->handle, "flash");
+    EXPECT_TRUE(std::equal(decoded->tx.begin(), decoded->tx.end(), tx.begin(), tx.end()));
+
+    payload.resize(SpixXferRequest::kFixedHeaderBytes + 2);
+    EXPECT_FALSE(SpixXferRequest::decode(payload).has_value());
+}
+
+TEST(BridgeSpiTest, LargeTransferIsChunkedToMtuAndReassembled)
+{
+    ScopedConfigValue hardwareSpiEnabled("HARDWARE_SPI_ENABLED", "1");
+
+    constexpr size_t kMtu = 64;
+    auto transport = std::make_shared<LoopbackIoBridgeTransport>(kMtu);
+    SPI spi(std::make_shared<IoBridgeSession>(transport));
+    ASSERT_TRUE(spi.registerHandle("flash", 8000000, 0).has_value());
+
+    std::vector<uint8_t> tx(300);
+    std::iota(tx.begin(), tx.end(), 0);
+    std::vector<uint8_t> rx(tx.size(), 0xAA);
+    ASSERT_TRUE(spi.transfer("flash", tx, rx).has_value());
+
+    EXPECT_EQ(rx, tx);
+    EXPECT_EQ(transport->batchCount, 1);
+    const size_t chunk = kMtu - SpixXferRequest::headerBytes(5);
+    ASSERT_EQ(transport->requests.size(), (tx.size() + chunk - 1) / chunk);
+    for (size_t i = 0; i < transport->requests.size(); i++) {
+        const bool last = i + 1 == transport->requests.size();
+        EXPECT_EQ(transport->requests[i].flags, last ? 0 : SpixXferRequest::kFlagHoldChipSelect);
+        EXPECT_EQ(transport->requests[i].txn, transport->requests[0].txn);
+        EXPECT_EQ(transport->requests[i].speedHz, 8000000u);
+    }
+}
+
+TEST(BridgeSpiTest, ScatterGatherListRunsAsOneBatch)
+{
+    ScopedConfigValue hardwareSpiEnabled("HARDWARE_SPI_ENABLED", "1");
+
+    auto transport = std::make_shared<LoopbackIoBridgeTransport>(kIoBridgeDefaultMtu);
+    SPI spi(std::make_shared<IoBridgeSession>(transport));
+    ASSERT_TRUE(spi.registerHandle("display", 1000000, 0).has_value());
+
+    // Command byte with no read-back, then a write that reads back fewer bytes, then a pure read.
+    const std::vector<uint8_t> command { 0x2C };
+    const std::vector<uint8_t> pixels { 1, 2, 3, 4 };
+    std::vector<uint8_t> echo(2);
+    std::vector<uint8_t> status(3, 0xAA);
+    const std::vector<SPITransferSegment> segments {
+        { command, {} },
+        { pixels, echo },
+        { {}, status },
+    };
+    ASSERT_TRUE(spi.transfer("display", segments).has_value());
+
+    EXPECT_EQ(transport->batchCount, 1);
+    ASSERT_EQ(transport->requests.size(), 3u);
+    EXPECT_EQ(transport->requests[0].rxLen, 0);
+    EXPECT_EQ(transport->requests[1].rxLen, 2);
+    EXPECT_EQ(transport->requests[2].rxLen, 3);
+    EXPECT_EQ(transport->requests[2].flags, 0);
+    EXPECT_EQ(echo, (std::vector<uint8_t> { 1, 2 }));
+    EXPECT_EQ(status, (std::vector<uint8_t> { 0, 0, 0 }));
+}
+
+TEST(BridgeSpiTest, ShortResponseIsRejected)
+{
+    ScopedConfigValue hardwareSpiEnabled("HARDWARE_SPI_ENABLED", "1");
+
+    auto transport = std::make_shared<FakeIoBridgeTransport>();
+    SPI spi(std::make_shared<IoBridgeSession>(transport));
+    ASSERT_TRUE(spi.registerHandle("flash", 1000000, 0).has_value());
+
+    const std::vector<uint8_t> tx { 0x03 };
+    std::vector<uint8_t> rx(4);
+    const auto result = spi.transfer("flash", tx, rx);
+    ASSERT_FALSE(result.has_value());
+    EXPECT_EQ(result.error(), SPIError::SPI_INVALID_RESPONSE);
+    EXPECT_EQ(spi.transfer("missing", tx, rx).error(), SPIError::HANDLE_NOT_FOUND);
+}
+
 } // namespace
@@ -0,0 +1,155 @@
+#include "../../src/hardware/mmWaveFrameDecoder.h"
+#include <gtest/gtest.h>
+#include <vector>
+
+namespace {
+std::vector<uint8_t> frame(const std::vector<uint8_t>& payload)
+{
+    std::vector<uint8_t> bytes = { 0xF4, 0xF3, 0xF2, 0xF1 };
+    bytes.push_back(static_cast<uint8_t>(payload.size() & 0xFF));
+    bytes.push_back(static_cast<uint8_t>(payload.size() >> 8));
+    bytes.insert(bytes.end(), payload.begin(), payload.end());
+    bytes.insert(bytes.end(), { 0xF8, 0xF7, 0xF6, 0xF5 });
+    return bytes;
+}
+
+std::vector<uint8_t> normalFrame(uint8_t targetState, uint16_t movingCm, uint16_t stationaryCm, uint16_t detectionCm)
+{
+    return frame({ 0x02, 0xAA, targetState,
+        static_cast<uint8_t>(movingCm), static_cast<uint8_t>(movingCm >> 8), 40,
+        static_cast<uint8_t>(stationaryCm), static_cast<uint8_t>(stationaryCm >> 8), 60,
+        static_cast<uint8_t>(detectionCm), static_cast<uint8_t>(detectionCm >> 8),
+        0x55, 0x00 });
+}
+
+struct Decoded {
+    std::vector<MmWaveFrame> frames;
+    std::vector<MmWaveFrameError> errors;
+};
+
+// Feeds bytes in chunks of chunkSize, the way read() would hand them over.
+Decoded decodeAll(MmWaveFrameDecoder& decoder, const std::vector<uint8_t>& bytes, size_t chunkSize)
+{
+    Decoded decoded;
+    MmWaveFrame out;
+    for (size_t offset = 0; offset < bytes.size(); offset += chunkSize) {
+        std::span<const uint8_t> input(bytes.data() + offset, std::min(chunkSize, bytes.size() - offset));
+        while (!input.empty()) {
+            switch (decoder.decode(input, out)) {
+            case MmWaveFrameDecoder::Status::Frame:
+                decoded.frames.push_back(out);
+                break;
+            case MmWaveFrameDecoder::Status::Error:
+                decoded.errors.push_back(decoder.lastError());
+                break;
+            case MmWaveFrameDecoder::Status::NeedMore:
+                break;
+            }
+        }
+    }
+    return decoded;
+}
+}
+
+TEST(MmWaveFrameDecoderTest, DecodesNormalFramesRegardlessOfChunking)
+{
+    std::vector<uint8_t> stream;
+    for (uint16_t i = 0; i < 5; i++) {
+        const auto bytes = normalFrame(static_cast<uint8_t>(i % 4), 100 + i, 200 + i, 300 + i);
+        stream.insert(stream.end(), bytes.begin(), bytes.end());
+    }
+
+    for (size_t chunk : { size_t(1), size_t(3), size_t(7), size_t(23), stream.size() }) {
+        MmWaveFrameDecoder decoder;
+        const Decoded decoded = decodeAll(decoder, stream, chunk);
+        ASSERT_EQ(decoded.frames.size(), 5u) << "chunk=" << chunk;
+        EXPECT_TRUE(decoded.errors.empty());
+        for (uint16_t i = 0; i < 5; i++) {
+            const MmWaveReading& reading = decoded.frames[i].reading;
+            EXPECT_EQ(decoded.frames[i].dataType, MmWaveFrameDecoder::DATA_TYPE_NORMAL);
+            EXPECT_EQ(reading.targetState, i % 4);
+            EXPECT_EQ(reading.movingTargetDistance, 100 + i);
+            EXPECT_EQ(reading.movingTargetEnergy, 40);
+            EXPECT_EQ(reading.stationaryTargetDistance, 200 + i);
+            EXPECT_EQ(reading.stationaryTargetEnergy, 60);
+            EXPECT_EQ(reading.detectionDistance, 300 + i);
+        }
+        EXPECT_EQ(decoder.stats().frames, 5u);
+        EXPECT_EQ(decoder.stats().skippedBytes, 0u);
+    }
+}
+
+TEST(MmWaveFrameDecoderTest, ResynchronisesAfterNoiseAndPartialHeaders)
+{
+    // Noise containing header prefixes (F4, F4 F3 F2) right before a real header.
+    std::vector<uint8_t> stream = { 0x00, 0xF4, 0x11, 0xF4, 0xF3, 0xF2, 0xF4 };
+    const auto bytes = normalFrame(1, 50, 60, 70);
+    stream.insert(stream.end(), bytes.begin(), bytes.end());
+
+    MmWaveFrameDecoder decoder;
+    const Decoded decoded = decodeAll(decoder, stream, 4);
+    ASSERT_EQ(decoded.frames.size(), 1u);
+    EXPECT_EQ(decoded.frames[0].reading.detectionDistance, 70);
+    EXPECT_EQ(decoder.stats().skippedBytes, 7u);
+}
+
+TEST(MmWaveFrameDecoderTest, RejectsBadFramesAndKeepsGoing)
+{
+    std::vector<uint8_t> badTail = normalFrame(1, 1, 1, 1);
+    badTail.back() = 0x00;
+    std::vector<uint8_t> badHead = normalFrame(1, 1, 1, 1);
+    badHead[7] = 0xAB;
+    std::vector<uint8_t> badLength = { 0xF4, 0xF3, 0xF2, 0xF1, 0xFF, 0x00 };
+    std::vector<uint8_t> badSize = frame({ 0x02, 0xAA, 0x01, 0x55, 0x00 });
+    std::vector<uint8_t> unknownType = frame({ 0x07, 0xAA, 0x01, 0x55, 0x00 });
+    std::vector<uint8_t> good = normalFrame(2, 10, 20, 30);
+
+    std::vector<uint8_t> stream;
+    for (const auto* part : { &badTail, &badHead, &badLength, &badSize, &unknownType, &good }) {
+        stream.insert(stream.end(), part->begin(), part->end());
+    }
+
+    MmWaveFrameDecoder decoder;
+    const Decoded decoded = decodeAll(decoder, stream, 16);
+    ASSERT_EQ(decoded.frames.size(), 1u);
+    EXPECT_EQ(decoded.frames[0].reading.detectionDistance, 30);
+    EXPECT_EQ(decoded.errors, (std::vector<MmWaveFrameError> { MmWaveFrameError::BadTail, MmWaveFrameError::BadHead,
+                                  MmWaveFrameError::BadLength, MmWaveFrameError::BadSize, MmWaveFrameError::UnknownType }));
+}
+
+TEST(MmWaveFrameDecoderTest, RejectedPayloadIsAvailableForDiagnostics)
+{
+    std::vector<uint8_t> bytes = normalFrame(1, 1, 1, 1);
+    bytes[bytes.size() - 4] = 0x00;
+    MmWaveFrameDecoder decoder;
+    std::span<const uint8_t> input(bytes);
+    MmWaveFrame out;
+    EXPECT_EQ(decoder.decode(input, out), MmWaveFrameDecoder::Status::Error);
+    EXPECT_EQ(decoder.lastError(), MmWaveFrameError::BadTail);
+    ASSERT_EQ(decoder.rejected().size(), 13u);
+    EXPECT_EQ(decoder.rejected()[0], 0x02);
+    EXPECT_EQ(decoder.rejected()[1], 0xAA);
+}
+
+TEST(MmWaveFrameDecoderTest, DecodesEngineeringFrameGates)
+{
+    // Max gate indexes 2 (moving) and 1 (stationary): 3 + 2 energies.
+    const auto bytes = frame({ 0x01, 0xAA, 0x03, 0x10, 0x00, 0x20, 0x30, 0x00, 0x40, 0x50, 0x00,
+        0x02, 0x01, 11, 12, 13, 21, 22, 0x99, 0x01, 0x55, 0x00 });
+
+    MmWaveFrameDecoder decoder;
+    const Decoded decoded = decodeAll(decoder, bytes, 5);
+    ASSERT_EQ(decoded.frames.size(), 1u);
+    const MmWaveFrame& f = decoded.frames[0];
+    EXPECT_EQ(f.dataType, MmWaveFrameDecoder::DATA_TYPE_ENGINEERING);
+    EXPECT_EQ(f.reading.targetState, 3);
+    EXPECT_EQ(f.reading.movingTargetDistance, 0x10);
+    EXPECT_EQ(f.reading.stationaryTargetDistance, 0x30);
+    EXPECT_EQ(f.reading.detectionDistance, 0x50);
+    ASSERT_EQ(f.movingGateCount, 3);
+    ASSERT_EQ(f.stationaryGateCount, 2);
+    EXPECT_EQ(f.movingGateEnergy[0], 11);
+    EXPECT_EQ(f.movingGateEnergy[2], 13);
+    EXPECT_EQ(f.stationaryGateEnergy[0], 21);
+    EXPECT_EQ(f.stationaryGateEnergy[1], 22);
+}
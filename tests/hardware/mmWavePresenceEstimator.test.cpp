@@ -1,6 +1,9 @@
 #include "../../src/hardware/mmWave.h"
 #include "../../src/hardware/mmWavePresenceEstimator.h"
+#include <algorithm>
+#include <deque>
 #include <gtest/gtest.h>
+#include <vector>
 
 namespace {
 
@@ -24,6 +27,151 @@ MmWaveReading makeReading(
     return reading;
 }
 
+// The estimator as it was before the windows became running sums: every update re-walks the retained
+// samples and sums floats in order. The trace tests hold the incremental version to its exact output.
+class ReferenceEstimator {
+public:
+    explicit ReferenceEstimator(const MmWavePresenceConfig& config) { setConfig(config); }
+
+    void setConfig(const MmWavePresenceConfig& config)
+    {
+        config_ = config;
+        for (int* window : { &config_.detectionDistanceAverageWindowSecs, &config_.movingDistanceAverageWindowSecs,
+                 &config_.stationaryDistanceAverageWindowSecs, &config_.stationaryEnergyAverageWindowSecs }) {
+            *window = std::clamp(*window, 1, 30);
+        }
+        if (!samples_.empty()) {
+            recompute(samples_.back().second);
+        }
+    }
+
+    MmWavePresenceDecision update(const MmWaveReading& reading, Clock::time_point now)
+    {
+        samples_.push_back({ reading, now });
+        recompute(now);
+        return decision_;
+    }
+
+    const MmWavePresenceDecision& decision() const { return decision_; }
+
+private:
+    template <typename Accessor>
+    std::pair<std::optional<float>, size_t> average(Clock::time_point latest, int windowSeconds, Accessor accessor) const
+    {
+        const auto cutoff = latest - std::chrono::seconds(windowSeconds);
+        float total = 0.0f;
+        size_t count = 0;
+        for (const auto& [reading, timestamp] : samples_) {
+            if (timestamp >= cutoff) {
+                total += accessor(reading);
+                ++count;
+            }
+        }
+        if (count == 0) {
+            return { std::nullopt, 0 };
+        }
+        return { total / static_cast<float>(count), count };
+    }
+
+    void recompute(Clock::time_point latest)
+    {
+        const int maxWindow = std::max({ config_.detectionDistanceAverageWindowSecs, config_.movingDistanceAverageWindowSecs,
+            config_.stationaryDistanceAverageWindowSecs, config_.stationaryEnergyAverageWindowSecs });
+        while (!samples_.empty() && samples_.front().second < latest - std::chrono::seconds(maxWindow)) {
+            samples_.pop_front();
+        }
+
+        MmWavePresenceDecision next;
+        next.timestamp = latest;
+        const uint8_t targetState = samples_.back().first.targetState & 0x03u;
+        next.latestTargetState = targetState;
+        std::tie(next.detectionDistanceAverageCm, next.detectionDistanceAverageSampleCount) = average(
+            latest, config_.detectionDistanceAverageWindowSecs, [](const MmWaveReading& r) { return static_cast<float>(r.detectionDistance); });
+        std::tie(next.movingTargetDistanceAverageCm, next.movingTargetDistanceAverageSampleCount) = average(
+            latest, config_.movingDistanceAverageWindowSecs, [](const MmWaveReading& r) { return static_cast<float>(r.movingTargetDistance); });
+        std::tie(next.stationaryTargetDistanceAverageCm, next.stationaryTargetDistanceAverageSampleCount) = average(
+            latest, config_.stationaryDistanceAverageWindowSecs, [](const MmWaveReading& r) { return static_cast<float>(r.stationaryTargetDistance); });
+        std::tie(next.stationaryTargetEnergyAverage, next.stationaryTargetEnergyAverageSampleCount) = average(
+            latest, config_.stationaryEnergyAverageWindowSecs, [](const MmWaveReading& r) { return static_cast<float>(r.stationaryTargetEnergy); });
+
+        float reduction = targetState == 0u ? 0.15f : 0.0f;
+        if (next.stationaryTargetEnergyAverage.has_value() && *next.stationaryTargetEnergyAverage < 75.0f) {
+            reduction += 0.10f;
+        }
+        const float multiplier = std::max(0.5f, 1.0f - reduction);
+        next.absentDetectionDistanceThresholdCm = 150.0f * multiplier;
+        next.absentMovingDistanceThresholdCm = 200.0f * multiplier;
+        next.absentStationaryDistanceThresholdCm = 200.0f * multiplier;
+
+        std::vector<std::pair<std::optional<float>, float>> active = { { next.detectionDistanceAverageCm, next.absentDetectionDistanceThresholdCm } };
+        if (targetState == 1u || targetState == 3u) {
+            active.push_back({ next.movingTargetDistanceAverageCm, next.absentMovingDistanceThresholdCm });
+        }
+        if (targetState == 2u || targetState == 3u) {
+            active.push_back({ next.stationaryTargetDistanceAverageCm, next.absentStationaryDistanceThresholdCm });
+        }
+        const bool all = std::all_of(active.begin(), active.end(), [](const auto& m) { return m.first.has_value(); });
+        if (all && std::all_of(active.begin(), active.end(), [](const auto& m) { return *m.first < 100.0f; })) {
+            state_ = MmWavePresenceState::Present;
+        } else if (all && std::all_of(active.begin(), active.end(), [](const auto& m) { return *m.first > m.second; })) {
+            state_ = MmWavePresenceState::Absent;
+        }
+        next.state = state_;
+        decision_ = next;
+    }
+
+    MmWavePresenceConfig config_;
+    std::deque<std::pair<MmWaveReading, Clock::time_point>> samples_;
+    MmWavePresenceState state_ = MmWavePresenceState::Unknown;
+    MmWavePresenceDecision decision_;
+};
+
+void expectSameDecision(const MmWavePresenceDecision& actual, const MmWavePresenceDecision& expected, size_t step)
+{
+    ASSERT_EQ(actual.state, expected.state) << "step " << step;
+    ASSERT_EQ(actual.timestamp, expected.timestamp) << "step " << step;
+    ASSERT_EQ(actual.latestTargetState, expected.latestTargetState) << "step " << step;
+    ASSERT_EQ(actual.detectionDistanceAverageCm, expected.detectionDistanceAverageCm) << "step " << step;
+    ASSERT_EQ(actual.movingTargetDistanceAverageCm, expected.movingTargetDistanceAverageCm) << "step " << step;
+    ASSERT_EQ(actual.stationaryTargetDistanceAverageCm, expected.stationaryTargetDistanceAverageCm) << "step " << step;
+    ASSERT_EQ(actual.stationaryTargetEnergyAverage, expected.stationaryTargetEnergyAverage) << "step " << step;
+    ASSERT_EQ(actual.detectionDistanceAverageSampleCount, expected.detectionDistanceAverageSampleCount) << "step " << step;
+    ASSERT_EQ(actual.movingTargetDistanceAverageSampleCount, expected.movingTargetDistanceAverageSampleCount) << "step " << step;
+    ASSERT_EQ(actual.stationaryTargetDistanceAverageSampleCount, expected.stationaryTargetDistanceAverageSampleCount) << "step " << step;
+    ASSERT_EQ(actual.stationaryTargetEnergyAverageSampleCount, expected.stationaryTargetEnergyAverageSampleCount) << "step " << step;
+    ASSERT_EQ(actual.absentDetectionDistanceThresholdCm, expected.absentDetectionDistanceThresholdCm) << "step " << step;
+    ASSERT_EQ(actual.absentMovingDistanceThresholdCm, expected.absentMovingDistanceThresholdCm) << "step " << step;
+    ASSERT_EQ(actual.absentStationaryDistanceThresholdCm, expected.absentStationaryDistanceThresholdCm) << "step " << step;
+}
+
+// A person walking up to the cube, sitting, leaving, with sensor jitter and dropouts. Deterministic.
+struct TracePlayer {
+    uint32_t seed = 12345;
+    Clock::time_point now = Clock::time_point {} + std::chrono::hours(1);
+
+    uint32_t next()
+    {
+        seed = seed * 1664525u + 1013904223u;
+        return seed >> 8;
+    }
+
+    MmWaveReading reading(size_t step)
+    {
+        const size_t phase = (step / 700) % 4;
+        const uint16_t base = phase == 0 ? 320 : phase == 1 ? 140 : phase == 2 ? 70 : 210;
+        const uint16_t jitter = static_cast<uint16_t>(next() % 60);
+        const uint8_t targetState = (next() % 23 == 0) ? 0 : static_cast<uint8_t>(phase == 2 ? 2 : 1 + next() % 3);
+        return makeReading(targetState, static_cast<uint16_t>(base + jitter), static_cast<uint16_t>(base + 20 - jitter / 2),
+            static_cast<uint16_t>(base + jitter / 3), static_cast<uint8_t>(40 + next() % 60), static_cast<uint8_t>(next() % 100));
+    }
+
+    Clock::time_point advance(int minMs, int maxMs)
+    {
+        now += std::chrono::milliseconds(minMs + static_cast<int>(next() % static_cast<uint32_t>(maxMs - minMs + 1)));
+        return now;
+    }
+};
+
 } // namespace
 
 TEST(MmWavePresenceEstimatorTest, MarksPresentWhenAllRelevantAveragesAreBelowPresentThreshold)
@@ -193,3 +341,56 @@ TEST(MmWavePresenceEstimatorTest, DiscardsSamplesOutsideLargestConfiguredWindow)
     ASSERT_TRUE(decision.detectionDistanceAverageCm.has_value());
     EXPECT_FLOAT_EQ(*decision.detectionDistanceAverageCm, 92.0f);
 }
+
+TEST(MmWavePresenceEstimatorTest, LongTraceMatchesReferenceExactly)
+{
+    MmWavePresenceConfig config;
+    config.detectionDistanceAverageWindowSecs = 3;
+    config.movingDistanceAverageWindowSecs = 10;
+    config.stationaryDistanceAverageWindowSecs = 30;
+    config.stationaryEnergyAverageWindowSecs = 7;
+    MmWavePresenceEstimator estimator(config);
+    ReferenceEstimator reference(config);
+    TracePlayer trace;
+
+    for (size_t step = 0; step < 20000; ++step) {
+        if (step % 5000 == 4999) {
+            // Reconfigure mid-stream, including out-of-range values that get clamped.
+            config.detectionDistanceAverageWindowSecs = static_cast<int>(trace.next() % 40);
+            config.movingDistanceAverageWindowSecs = static_cast<int>(trace.next() % 40) - 5;
+            config.stationaryDistanceAverageWindowSecs = 1 + static_cast<int>(trace.next() % 30);
+            config.stationaryEnergyAverageWindowSecs = 1 + static_cast<int>(trace.next() % 30);
+            estimator.setConfig(config);
+            reference.setConfig(config);
+            expectSameDecision(estimator.decision(), reference.decision(), step);
+        }
+        // Mostly ~15 frames/s, with an occasional multi-second dropout.
+        const auto now = (step % 3000 == 1500) ? trace.advance(4000, 12000) : trace.advance(40, 90);
+        const MmWaveReading reading = trace.reading(step);
+        expectSameDecision(estimator.update(reading, now), reference.update(reading, now), step);
+    }
+}
+
+TEST(MmWavePresenceEstimatorTest, HighFrameRateGrowsTheRingAndStillMatchesReference)
+{
+    MmWavePresenceConfig config;
+    config.detectionDistanceAverageWindowSecs = 30;
+    config.movingDistanceAverageWindowSecs = 30;
+    config.stationaryDistanceAverageWindowSecs = 5;
+    config.stationaryEnergyAverageWindowSecs = 30;
+    MmWavePresenceEstimator estimator(config);
+    ReferenceEstimator reference(config);
+    TracePlayer trace;
+
+    // 200 frames/s keeps ~6000 samples in the 30 s windows.
+    for (size_t step = 0; step < 8000; ++step) {
+        const auto now = trace.advance(4, 6);
+        const MmWaveReading reading = trace.reading(step);
+        expectSameDecision(estimator.update(reading, now), reference.update(reading, now), step);
+    }
+
+    estimator.reset();
+    const MmWavePresenceDecision afterReset = estimator.update(makeReading(0x03u, 90, 95, 92), trace.advance(5, 5));
+    EXPECT_EQ(afterReset.detectionDistanceAverageSampleCount, 1u);
+    EXPECT_EQ(afterReset.state, MmWavePresenceState::Present);
+}
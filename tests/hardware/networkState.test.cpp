@@ -0,0 +1,346 @@
+#include "../../src/hardware/networkState.h"
+#include <gtest/gtest.h>
+
+#include <condition_variable>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+using namespace std::chrono_literals;
+
+// Recorded from `nmcli -t` on a Pi 5 associated with a WPA2 network.
+const std::string kRadioEnabled = "enabled\n";
+const std::string kDevicesConnected = "wlan0:wifi:connected:HomeNet\n"
+                                      "eth0:ethernet:unavailable:\n"
+                                      "lo:loopback:connected (externally):lo\n"
+                                      "p2p-dev-wlan0:wifi-p2p:disconnected:\n";
+const std::string kDevicesDisconnected = "wlan0:wifi:disconnected:\n"
+                                         "eth0:ethernet:unavailable:\n"
+                                         "lo:loopback:connected (externally):lo\n";
+const std::string kDeviceShowConnected = "GENERAL.HWADDR:D8\\:3A\\:DD\\:12\\:34\\:56\n"
+                                         "IP4.ADDRESS[1]:192.168.1.42/24\n"
+                                         "IP4.GATEWAY:192.168.1.1\n"
+                                         "IP4.DNS[1]:192.168.1.1\n"
+                                         "IP4.DNS[2]:1.1.1.1\n"
+                                         "DHCP4.OPTION[1]:broadcast_address = 192.168.1.255\n"
+                                         "DHCP4.OPTION[2]:dhcp_server_identifier = 192.168.1.1\n"
+                                         "DHCP4.OPTION[3]:lease_time = 86400\n";
+const std::string kDeviceShowDisconnected = "GENERAL.HWADDR:D8\\:3A\\:DD\\:12\\:34\\:56\n"
+                                            "IP4.GATEWAY:--\n";
+const std::string kAccessPointsConnected = "*:HomeNet:AA\\:BB\\:CC\\:DD\\:EE\\:01:82:WPA2:5180 MHz:36:540 Mbit/s\n"
+                                           " :Neighbour:AA\\:BB\\:CC\\:DD\\:EE\\:02:40:WPA1 WPA2:2437 MHz:6:130 Mbit/s\n";
+const std::string kAccessPointsDisconnected = " :HomeNet:AA\\:BB\\:CC\\:DD\\:EE\\:01:80:WPA2:5180 MHz:36:540 Mbit/s\n"
+                                              " :Neighbour:AA\\:BB\\:CC\\:DD\\:EE\\:02:41:WPA1 WPA2:2437 MHz:6:130 Mbit/s\n";
+
+std::string joined(const std::vector<std::string>& command)
+{
+    std::string text;
+    for (const auto& part : command) {
+        text += (text.empty() ? "" : " ") + part;
+    }
+    return text;
+}
+
+struct MonitorFeed {
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::deque<std::string> lines;
+    bool closed = false;
+
+    void push(const std::string& line)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        lines.push_back(line);
+        changed.notify_all();
+    }
+
+    void close()
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        closed = true;
+        changed.notify_all();
+    }
+};
+
+class FakeMonitorStream final : public ICommandLineStream {
+public:
+    explicit FakeMonitorStream(std::shared_ptr<MonitorFeed> feed)
+        : feed_(std::move(feed))
+    {
+    }
+
+    CommandStreamRead readLine(std::string& line, std::chrono::milliseconds timeout) override
+    {
+        std::unique_lock<std::mutex> lock(feed_->mutex);
+        if (!feed_->changed.wait_for(lock, timeout, [this]() { return !feed_->lines.empty() || feed_->closed; })) {
+            return CommandStreamRead::Timeout;
+        }
+        if (feed_->lines.empty()) {
+            return CommandStreamRead::Closed;
+        }
+        line = feed_->lines.front();
+        feed_->lines.pop_front();
+        return CommandStreamRead::Line;
+    }
+
+private:
+    std::shared_ptr<MonitorFeed> feed_;
+};
+
+// Replays recorded nmcli output by command line and counts the processes a real runner would fork.
+class FakeNmcliRunner final : public ICommandRunner {
+public:
+    FakeNmcliRunner()
+    {
+        setConnected(true);
+    }
+
+    CommandResult run(const std::vector<std::string>& command) override
+    {
+        const std::string key = joined(command);
+        std::unique_lock<std::mutex> lock(mutex_);
+        calls_.push_back(key);
+        if (key.ends_with("--rescan yes")) {
+            ++scansStarted_;
+            scanStarted_.notify_all();
+            scanRelease_.wait(lock, [this]() { return !holdScans_; });
+        }
+        const auto output = outputs_.find(key);
+        return output == outputs_.end() ? CommandResult { 10, "Error: unexpected command\n" } : CommandResult { 0, output->second };
+    }
+
+    std::unique_ptr<ICommandLineStream> stream(const std::vector<std::string>& command) override
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        calls_.push_back(joined(command));
+        ++streamsStarted_;
+        feed_ = std::make_shared<MonitorFeed>();
+        streamStarted_.notify_all();
+        return std::make_unique<FakeMonitorStream>(feed_);
+    }
+
+    void setConnected(bool connected)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        const std::string accessPoints = connected ? kAccessPointsConnected : kAccessPointsDisconnected;
+        outputs_["nmcli -t radio wifi"] = kRadioEnabled;
+        outputs_["nmcli -t -f DEVICE,TYPE,STATE,CONNECTION device status"] = connected ? kDevicesConnected : kDevicesDisconnected;
+        outputs_["nmcli -t -f GENERAL.HWADDR,IP4.ADDRESS,IP4.GATEWAY,IP4.DNS,DHCP4.OPTION device show wlan0"] = connected ? kDeviceShowConnected : kDeviceShowDisconnected;
+        outputs_["nmcli -t -f IN-USE,SSID,BSSID,SIGNAL,SECURITY,FREQ,CHAN,RATE device wifi list --rescan no"] = accessPoints;
+        outputs_["nmcli -t -f IN-USE,SSID,BSSID,SIGNAL,SECURITY,FREQ,CHAN,RATE device wifi list --rescan yes"] = accessPoints;
+    }
+
+    std::shared_ptr<MonitorFeed> waitForMonitor(int streams)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        streamStarted_.wait_for(lock, 2s, [this, streams]() { return streamsStarted_ >= streams; });
+        return feed_;
+    }
+
+    void holdScans(bool hold)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        holdScans_ = hold;
+        scanRelease_.notify_all();
+    }
+
+    void waitForScanStart()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        scanStarted_.wait_for(lock, 2s, [this]() { return scansStarted_ > 0; });
+    }
+
+    std::vector<std::string> calls()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return calls_;
+    }
+
+    int scansStarted()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return scansStarted_;
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable streamStarted_;
+    std::condition_variable scanStarted_;
+    std::condition_variable scanRelease_;
+    std::map<std::string, std::string> outputs_;
+    std::vector<std::string> calls_;
+    std::shared_ptr<MonitorFeed> feed_;
+    int streamsStarted_ = 0;
+    int scansStarted_ = 0;
+    bool holdScans_ = false;
+};
+
+struct FakeClock {
+    std::mutex mutex;
+    std::chrono::steady_clock::time_point now = std::chrono::steady_clock::time_point {} + 1h;
+
+    NetworkStateService::MonotonicNowReader reader()
+    {
+        return [this]() {
+            std::lock_guard<std::mutex> lock(mutex);
+            return now;
+        };
+    }
+
+    void advance(std::chrono::milliseconds delta)
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        now += delta;
+    }
+};
+
+NetworkStateOptions fastOptions()
+{
+    NetworkStateOptions options;
+    options.eventDebounce = 20ms;
+    options.monitorRetryDelay = 10ms;
+    return options;
+}
+
+TEST(NetworkStateServiceTest, StartReadsEachPartOnceAndQueriesNeverFork)
+{
+    auto runner = std::make_shared<FakeNmcliRunner>();
+    FakeClock clock;
+    NetworkStateService service(runner, fastOptions(), clock.reader());
+    service.start();
+    runner->waitForMonitor(1);
+
+    const auto state = service.snapshot();
+    EXPECT_TRUE(state->radioEnabled);
+    EXPECT_EQ(state->wifiDevice, "wlan0");
+    EXPECT_TRUE(state->connected);
+    EXPECT_EQ(state->localMac, "D8:3A:DD:12:34:56");
+    EXPECT_EQ(state->active.ssid, "HomeNet");
+    EXPECT_EQ(state->active.mac, "AA:BB:CC:DD:EE:01");
+    EXPECT_EQ(state->active.signalStrength, "82");
+    EXPECT_EQ(state->active.frequency, "5180 MHz");
+    EXPECT_EQ(state->active.ip.ip, "192.168.1.42");
+    EXPECT_EQ(state->active.subnet.cidr, 24);
+    EXPECT_EQ(state->active.subnet.mask, "255.255.255.0");
+    EXPECT_EQ(state->active.gateway.ip, "192.168.1.1");
+    EXPECT_EQ(state->active.dns2.ip, "1.1.1.1");
+    EXPECT_EQ(state->active.dhcp.ip, "192.168.1.1");
+    EXPECT_EQ(state->active.dhcpLease, 86400u);
+    ASSERT_EQ(state->accessPoints.size(), 2u);
+    EXPECT_EQ(state->accessPoints[1].securityType, "WPA1 WPA2");
+
+    // radio, device status, device show, AP list, then the monitor.
+    EXPECT_EQ(service.commandsStarted(), 5u);
+    for (int query = 0; query < 1000; ++query) {
+        EXPECT_EQ(service.snapshot()->active.ssid, "HomeNet");
+    }
+    EXPECT_EQ(service.commandsStarted(), 5u);
+}
+
+TEST(NetworkStateServiceTest, EventBurstIsAppliedWithOneRefresh)
+{
+    auto runner = std::make_shared<FakeNmcliRunner>();
+    FakeClock clock;
+    NetworkStateService service(runner, fastOptions(), clock.reader());
+    service.start();
+    auto monitor = runner->waitForMonitor(1);
+    const auto before = service.snapshot();
+    const size_t callsBefore = runner->calls().size();
+
+    runner->setConnected(false);
+    monitor->push("wlan0: deactivating");
+    monitor->push("wlan0: disconnected");
+    monitor->push("Networkmanager is now in the 'disconnected' state");
+    monitor->push("There's no primary connection");
+
+    const auto after = service.waitForChange(before->generation, 2s);
+    EXPECT_EQ(after->generation, before->generation + 1);
+    EXPECT_FALSE(after->connected);
+    EXPECT_EQ(after->active.ssid, "");
+    EXPECT_EQ(after->active.ip.ip, "");
+    EXPECT_EQ(after->localMac, "D8:3A:DD:12:34:56");
+
+    // One device status, one device show and one AP list for the whole burst.
+    EXPECT_EQ(runner->calls().size() - callsBefore, 3u);
+}
+
+TEST(NetworkStateServiceTest, ScansAreCoalescedAndRateLimited)
+{
+    auto runner = std::make_shared<FakeNmcliRunner>();
+    FakeClock clock;
+    NetworkStateService service(runner, fastOptions(), clock.reader());
+
+    runner->holdScans(true);
+    bool firstResult = false;
+    bool secondResult = false;
+    std::thread first([&]() { firstResult = service.scan(); });
+    runner->waitForScanStart();
+    std::thread second([&]() { secondResult = service.scan(); });
+    std::this_thread::sleep_for(20ms);
+    runner->holdScans(false);
+    first.join();
+    second.join();
+
+    EXPECT_TRUE(firstResult);
+    EXPECT_TRUE(secondResult);
+    EXPECT_EQ(runner->scansStarted(), 1);
+    EXPECT_EQ(service.snapshot()->accessPoints.size(), 2u);
+
+    EXPECT_TRUE(service.scan());
+    EXPECT_EQ(runner->scansStarted(), 1);
+
+    clock.advance(NetworkStateOptions {}.minScanInterval);
+    EXPECT_TRUE(service.scan());
+    EXPECT_EQ(runner->scansStarted(), 2);
+
+    EXPECT_TRUE(service.scan(true));
+    EXPECT_EQ(runner->scansStarted(), 3);
+}
+
+TEST(NetworkStateServiceTest, IdleMinuteCostsOneAccessPointRead)
+{
+    auto runner = std::make_shared<FakeNmcliRunner>();
+    FakeClock clock;
+    NetworkStateService service(runner, fastOptions(), clock.reader());
+    service.start();
+    runner->waitForMonitor(1);
+    const uint64_t startup = service.commandsStarted();
+    const auto before = service.snapshot();
+
+    // A Wi-Fi status screen reading a dozen fields ten times a second; each read used to fork nmcli.
+    for (int frame = 0; frame < 600; ++frame) {
+        for (int field = 0; field < 12; ++field) {
+            (void)service.snapshot()->active.signalStrength;
+        }
+    }
+    clock.advance(NetworkStateOptions {}.accessPointRefreshInterval);
+    service.waitForChange(before->generation, 2s);
+
+    const uint64_t forksPerMinute = service.commandsStarted() - startup;
+    RecordProperty("forks_per_minute", static_cast<int>(forksPerMinute));
+    RecordProperty("legacy_forks_per_minute", 600 * 12);
+    EXPECT_EQ(forksPerMinute, 1u);
+}
+
+TEST(NetworkStateServiceTest, MonitorRestartRereadsEverything)
+{
+    auto runner = std::make_shared<FakeNmcliRunner>();
+    FakeClock clock;
+    NetworkStateService service(runner, fastOptions(), clock.reader());
+    service.start();
+    auto monitor = runner->waitForMonitor(1);
+    const auto before = service.snapshot();
+
+    runner->setConnected(false);
+    monitor->close();
+    runner->waitForMonitor(2);
+
+    const auto after = service.waitForChange(before->generation, 2s);
+    EXPECT_FALSE(after->connected);
+    EXPECT_EQ(after->active.ssid, "");
+}
+
+} // namespace
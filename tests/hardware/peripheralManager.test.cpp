@@ -3,6 +3,8 @@
 #include "../../src/settings/globalSettings.h"
 #include <gtest/gtest.h>
 
+#include <atomic>
+
 #include <deque>
 #include <thread>
 
@@ -256,8 +258,9 @@ TEST(PeripheralManagerTest, StatusEndpointReturnsImmediateAndDelayedPresenceFiel
     TestPeripheralManager manager(nullptr);
     const auto endpoints = manager.getHttpEndpointData();
 
-    ASSERT_EQ(endpoints.size(), 1u);
+    ASSERT_EQ(endpoints.size(), 2u);
     EXPECT_EQ(std::get<2>(endpoints[0]), "status");
+    EXPECT_EQ(std::get<2>(endpoints[1]), "systemSensors");
     EXPECT_EQ(
         std::get<0>(endpoints[0]),
         PUBLIC_ENDPOINT | GET_ENDPOINT);
@@ -504,4 +507,38 @@ TEST(PeripheralManagerInteractionTest, RegisteredInteractionCallbacksWakeLoopAnd
     }
 }
 
+TEST(PeripheralManagerInteractionTest, SettingsCallbacksRacingShutdownLeaveTheSchedulerAlone)
+{
+    GlobalSettings defaults;
+    std::atomic<bool> running { true };
+    std::thread settings([&running]() {
+        int interval = 20;
+        while (running.load()) {
+            interval = interval == 20 ? 30 : 20;
+            GlobalSettings::setSetting(GlobalSettings::SettingType::INTERACTION_POLL_INTERVAL_MS, interval);
+            GlobalSettings::setSetting(GlobalSettings::SettingType::INTERACTION_TAP_DEBOUNCE_MS, interval * 5);
+        }
+    });
+
+    // Each manager removes its callbacks on destruction, but one already copied out by a concurrent setSetting
+    // may still run; it must never reach the destroyed manager's scheduler.
+    for (int round = 0; round < 50; ++round) {
+        TestPeripheralManager manager(
+            nullptr,
+            nullptr,
+            std::make_unique<FakeAccelerometer>(),
+            {},
+            {},
+            {},
+            {},
+            true,
+            false,
+            true);
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+
+    running = false;
+    settings.join();
+}
+
 } // namespace
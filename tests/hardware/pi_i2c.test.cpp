@@ -2,6 +2,11 @@
 #include "../../src/utils.h"
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
+
 namespace {
 
 class ScopedConfigValue {
@@ -31,6 +36,169 @@ private:
     std::string previousValue_;
 };
 
+// Records what the default ILocalI2CBus::transfer() turns a combined transaction into.
+class RecordingI2CBus final : public ILocalI2CBus {
+public:
+    std::expected<void, I2CError> write(uint16_t address, const I2CBytes& txData, bool = false) override
+    {
+        calls.push_back("write " + std::to_string(address) + " " + std::to_string(txData.size()));
+        return { };
+    }
+
+    std::expected<I2CBytes, I2CError> writeRead(uint16_t address, const I2CBytes& txData, size_t rxLen, bool = false) override
+    {
+        calls.push_back("writeRead " + std::to_string(address) + " " + std::to_string(txData.size()) + " " + std::to_string(rxLen));
+        return I2CBytes(rxLen, static_cast<unsigned char>(address));
+    }
+
+    std::vector<std::string> calls;
+};
+
+template <typename Predicate>
+bool waitFor(Predicate predicate)
+{
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (!predicate()) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+TEST(I2CTransactionTest, WriteReadAddsOnlyNonEmptySegments)
+{
+    I2CTransaction transaction;
+    transaction.writeRead(0x68, I2CBytes { 0x0C }, 6).writeRead(0x68, I2CBytes {}, 2).writeRead(0x50, I2CBytes { 0x00, 0x10 }, 0);
+
+    const auto& segments = transaction.segments();
+    ASSERT_EQ(segments.size(), 4u);
+    EXPECT_FALSE(segments[0].read);
+    EXPECT_TRUE(segments[1].read);
+    EXPECT_EQ(segments[1].length, 6u);
+    EXPECT_TRUE(segments[2].read);
+    EXPECT_EQ(segments[3].address, 0x50);
+    EXPECT_EQ(transaction.readCount(), 2u);
+}
+
+TEST(I2CTransactionTest, DefaultTransferPairsEachWriteWithTheReadThatFollowsIt)
+{
+    RecordingI2CBus bus;
+    I2CTransaction transaction;
+    transaction.write(0x68, I2CBytes { 0x40, 0xA8 })
+        .write(0x68, I2CBytes { 0x24 })
+        .read(0x68, 2)
+        .write(0x68, I2CBytes { 0x26 })
+        .read(0x2A, 4)
+        .read(0x2A, 1);
+
+    const auto reads = bus.transfer(transaction);
+
+    ASSERT_TRUE(reads.has_value());
+    ASSERT_EQ(reads->size(), 3u);
+    EXPECT_EQ((*reads)[0].size(), 2u);
+    EXPECT_EQ((*reads)[1], I2CBytes(4, 0x2A));
+    EXPECT_EQ(bus.calls, (std::vector<std::string> {
+                             "write 104 2",
+                             "writeRead 104 1 2",
+                             "write 104 1",
+                             "writeRead 42 0 4",
+                             "writeRead 42 0 1",
+                         }));
+}
+
+TEST(I2CBusArbiterTest, QueuedInteractiveRequestGoesBeforeQueuedPeriodicReads)
+{
+    I2CBusArbiter arbiter;
+    std::vector<std::string> order;
+    std::mutex orderMutex;
+    auto record = [&](const std::string& name) {
+        std::lock_guard<std::mutex> lock(orderMutex);
+        order.push_back(name);
+    };
+
+    std::optional<I2CBusArbiter::Grant> held(arbiter.acquire(I2CPriority::Periodic));
+    std::jthread firstPeriodic([&]() {
+        const auto grant = arbiter.acquire(I2CPriority::Periodic);
+        record("periodic-1");
+    });
+    ASSERT_TRUE(waitFor([&]() { return arbiter.waiting(I2CPriority::Periodic) == 1; }));
+    std::jthread secondPeriodic([&]() {
+        const auto grant = arbiter.acquire(I2CPriority::Periodic);
+        record("periodic-2");
+    });
+    ASSERT_TRUE(waitFor([&]() { return arbiter.waiting(I2CPriority::Periodic) == 2; }));
+    std::jthread interactive([&]() {
+        const auto grant = arbiter.acquire(I2CPriority::Interactive);
+        record("interactive");
+    });
+    ASSERT_TRUE(waitFor([&]() { return arbiter.waiting(I2CPriority::Interactive) == 1; }));
+
+    held.reset();
+    firstPeriodic.join();
+    secondPeriodic.join();
+    interactive.join();
+
+    EXPECT_EQ(order, (std::vector<std::string> { "interactive", "periodic-1", "periodic-2" }));
+}
+
+TEST(PiI2CBusTest, SharedBusKeepsOneDeviceHandleAcrossTransfers)
+{
+    ScopedConfigValue hardwareI2cEnabled("HARDWARE_I2C_ENABLED", "1");
+
+    // /dev/null opens like an adapter but rejects I2C_RDWR, which is enough to watch the handle being reused.
+    const auto bus = PiI2CBus::forDevice("/dev/null");
+    ASSERT_NE(bus, nullptr);
+    EXPECT_EQ(PiI2CBus::forDevice("/dev/null"), bus);
+    EXPECT_EQ(PiI2CBus::forDevice("/dev/this-is-not-an-i2c-adapter"), nullptr);
+
+    PiI2CBusView periodic(bus, I2CPriority::Periodic);
+    const auto first = periodic.writeRead(0x68, I2CBytes { 0x0C }, 6);
+    const auto second = bus->writeRead(0x68, I2CBytes { 0x0C }, 6);
+
+    ASSERT_FALSE(first.has_value());
+    EXPECT_EQ(first.error(), I2CError::IOCTL_FAILED);
+    ASSERT_FALSE(second.has_value());
+    const PiI2CBusStats stats = bus->stats();
+    EXPECT_EQ(stats.deviceOpens, 1u);
+    EXPECT_EQ(stats.transactions, 2u);
+    // open + I2C_FUNCS once, then a single I2C_RDWR per transaction.
+    EXPECT_EQ(stats.syscalls, 4u);
+}
+
+TEST(PiI2CBusTest, InjectedIoctlReceivesWriteReadAsOneCombinedTransfer)
+{
+    ScopedConfigValue hardwareI2cEnabled("HARDWARE_I2C_ENABLED", "1");
+
+    PiI2CBus bus;
+    ASSERT_TRUE(bus.setI2cDevicePath("/dev/null"));
+    std::vector<unsigned long> requests;
+    std::vector<uint16_t> messageFlags;
+    bus.setIoctlCall([&](int, unsigned long request, unsigned long argument) {
+        requests.push_back(request);
+        if (request == I2C_FUNCS) {
+            *reinterpret_cast<unsigned long*>(argument) = I2C_FUNC_I2C;
+        } else if (request == I2C_RDWR) {
+            auto* rdwr = reinterpret_cast<i2c_rdwr_ioctl_data*>(argument);
+            for (uint32_t index = 0; index < rdwr->nmsgs; ++index) {
+                messageFlags.push_back(rdwr->msgs[index].flags);
+                if (rdwr->msgs[index].flags & I2C_M_RD) {
+                    std::fill_n(rdwr->msgs[index].buf, rdwr->msgs[index].len, 0x24);
+                }
+            }
+        }
+        return 0;
+    });
+
+    const auto chipId = bus.writeRead(0x68, I2CBytes { 0x00 }, 1);
+
+    ASSERT_TRUE(chipId.has_value());
+    EXPECT_EQ(*chipId, (I2CBytes { 0x24 }));
+    EXPECT_EQ(requests, (std::vector<unsigned long> { I2C_FUNCS, I2C_RDWR }));
+    EXPECT_EQ(messageFlags, (std::vector<uint16_t> { 0, I2C_M_RD }));
+}
+
 TEST(PiI2CBusTest, DisabledByConfigBlocksWriteBeforeDeviceAccess)
 {
     ScopedConfigValue hardwareI2cEnabled("HARDWARE_I2C_ENABLED", "0");
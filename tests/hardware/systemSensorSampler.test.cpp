@@ -0,0 +1,167 @@
+#include "../../src/hardware/systemSensorSampler.h"
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+
+namespace {
+
+class TempDir {
+public:
+    TempDir()
+    {
+        path_ = std::filesystem::temp_directory_path() / std::filesystem::path("thecube-sensors-" + std::to_string(++counter_));
+        std::filesystem::create_directories(path_);
+    }
+
+    ~TempDir()
+    {
+        std::error_code ec;
+        std::filesystem::remove_all(path_, ec);
+    }
+
+    const std::filesystem::path& path() const
+    {
+        return path_;
+    }
+
+private:
+    static inline int counter_ = 0;
+    std::filesystem::path path_;
+};
+
+// Truncates in place, so an fd opened earlier sees the new contents the way sysfs and procfs readers do.
+void writeText(const std::filesystem::path& path, const std::string& value)
+{
+    std::filesystem::create_directories(path.parent_path());
+    std::ofstream file(path);
+    file << value;
+}
+
+struct FakeRoots {
+    TempDir sys;
+    TempDir proc;
+
+    FakeRoots()
+    {
+        writeText(sys.path() / "class/thermal/thermal_zone0/type", "cpu-thermal\n");
+        writeText(sys.path() / "class/thermal/thermal_zone0/temp", "45000\n");
+        writeText(sys.path() / "class/thermal/thermal_zone1/type", "board\n");
+        writeText(sys.path() / "class/thermal/thermal_zone1/temp", "39500\n");
+        writeProcStat(100, 400, 50, 200);
+        writeText(proc.path() / "meminfo",
+            "MemTotal:        3884192 kB\n"
+            "MemFree:          120400 kB\n"
+            "MemAvailable:     524288 kB\n");
+        writeText(proc.path() / "self/status",
+            "Name:\tCubeCore\n"
+            "VmPeak:\t  812340 kB\n"
+            "VmRSS:\t  123456 kB\n");
+        writeText(proc.path() / "loadavg", "0.52 0.31 0.12 2/345 6789\n");
+    }
+
+    // cpu0 and cpu1 split the aggregate evenly.
+    void writeProcStat(uint64_t user0, uint64_t idle0, uint64_t user1, uint64_t idle1)
+    {
+        auto line = [](const std::string& name, uint64_t user, uint64_t idle) {
+            return name + " " + std::to_string(user) + " 0 0 " + std::to_string(idle) + " 0 0 0 0 0 0\n";
+        };
+        writeText(proc.path() / "stat",
+            line("cpu ", user0 + user1, idle0 + idle1) + line("cpu0", user0, idle0) + line("cpu1", user1, idle1)
+                + "intr 12345 0 0\nctxt 67890\n");
+    }
+};
+
+TEST(SystemSensorSamplerTest, DiscoversSensorsAndCoresOnce)
+{
+    FakeRoots roots;
+    SystemSensorSampler sampler(roots.sys.path(), roots.proc.path());
+
+    // Two temperature sensors plus stat, meminfo, self/status and loadavg.
+    EXPECT_EQ(sampler.openHandleCount(), 6u);
+
+    const auto snapshot = sampler.sample();
+    ASSERT_TRUE(snapshot.layout);
+    EXPECT_EQ(snapshot.layout->cpuCoreCount, 2u);
+    ASSERT_EQ(snapshot.layout->temperatureSensors.size(), 2u);
+    EXPECT_EQ(snapshot.layout->temperatureSensors[0].name, "cpu-thermal");
+    EXPECT_TRUE(snapshot.layout->temperatureSensors[0].cpuLike);
+    EXPECT_EQ(snapshot.sequence, 1u);
+}
+
+TEST(SystemSensorSamplerTest, ParsesTemperaturesMemoryAndLoad)
+{
+    FakeRoots roots;
+    SystemSensorSampler sampler(roots.sys.path(), roots.proc.path());
+
+    const auto snapshot = sampler.sample();
+    EXPECT_DOUBLE_EQ(snapshot.temperaturesC[0], 45.0);
+    EXPECT_DOUBLE_EQ(snapshot.temperaturesC[1], 39.5);
+    EXPECT_EQ(snapshot.cpuTemperatureC, std::optional<double> { 45.0 });
+    EXPECT_EQ(snapshot.systemTemperatureC, std::optional<double> { 45.0 });
+    EXPECT_EQ(snapshot.memoryTotalKb, std::optional<uint64_t> { 3884192 });
+    EXPECT_EQ(snapshot.memoryAvailableKb, std::optional<uint64_t> { 524288 });
+    EXPECT_EQ(snapshot.processRssKb, std::optional<uint64_t> { 123456 });
+    ASSERT_TRUE(snapshot.loadAverage.has_value());
+    EXPECT_DOUBLE_EQ((*snapshot.loadAverage)[0], 0.52);
+    EXPECT_DOUBLE_EQ((*snapshot.loadAverage)[2], 0.12);
+
+    const auto readings = snapshot.temperatureReadings();
+    ASSERT_EQ(readings.size(), 2u);
+    EXPECT_DOUBLE_EQ(readings[1].celsius, 39.5);
+}
+
+TEST(SystemSensorSamplerTest, RereadsTheSameHandlesAndComputesCpuDeltas)
+{
+    FakeRoots roots;
+    SystemSensorSampler sampler(roots.sys.path(), roots.proc.path());
+
+    const auto first = sampler.sample();
+    EXPECT_FALSE(first.cpuUsagePercent.has_value());
+    EXPECT_TRUE(std::isnan(first.coreUsagePercent[0]));
+
+    writeText(roots.sys.path() / "class/thermal/thermal_zone0/temp", "61000\n");
+    // cpu0: 75 busy of 100; cpu1: 25 busy of 100.
+    roots.writeProcStat(175, 425, 75, 275);
+
+    const auto second = sampler.sample();
+    EXPECT_EQ(second.sequence, first.sequence + 1);
+    EXPECT_EQ(sampler.openHandleCount(), 6u);
+    EXPECT_DOUBLE_EQ(second.temperaturesC[0], 61.0);
+    EXPECT_EQ(second.cpuTemperatureC, std::optional<double> { 61.0 });
+    ASSERT_TRUE(second.cpuUsagePercent.has_value());
+    EXPECT_DOUBLE_EQ(*second.cpuUsagePercent, 50.0);
+    EXPECT_DOUBLE_EQ(second.coreUsagePercent[0], 75.0);
+    EXPECT_DOUBLE_EQ(second.coreUsagePercent[1], 25.0);
+}
+
+TEST(SystemSensorSamplerTest, LatestReusesAFreshSnapshot)
+{
+    FakeRoots roots;
+    SystemSensorSampler sampler(roots.sys.path(), roots.proc.path());
+
+    const auto first = sampler.latest(std::chrono::hours(1));
+    const auto reused = sampler.latest(std::chrono::hours(1));
+    EXPECT_EQ(reused.sequence, first.sequence);
+    EXPECT_EQ(sampler.published().sequence, first.sequence);
+
+    const auto refreshed = sampler.latest(std::chrono::milliseconds(0));
+    EXPECT_EQ(refreshed.sequence, first.sequence + 1);
+}
+
+TEST(SystemSensorSamplerTest, MissingFilesLeaveFieldsEmpty)
+{
+    TempDir sys;
+    TempDir proc;
+    SystemSensorSampler sampler(sys.path(), proc.path());
+
+    EXPECT_EQ(sampler.openHandleCount(), 0u);
+    const auto snapshot = sampler.sample();
+    EXPECT_FALSE(snapshot.cpuTemperatureC.has_value());
+    EXPECT_FALSE(snapshot.memoryTotalKb.has_value());
+    EXPECT_FALSE(snapshot.loadAverage.has_value());
+    EXPECT_TRUE(snapshot.temperatureReadings().empty());
+}
+
+} // namespace
@@ -1,6 +1,10 @@
 #include "../../src/settings/globalSettings.h"
 #include <gtest/gtest.h>
 
+#include <atomic>
+#include <thread>
+#include <vector>
+
 namespace {
 
 TEST(GlobalSettingsTest, ThermalDefaultsAreInitialized)
@@ -131,4 +135,45 @@ TEST(GlobalSettingsTest, InvalidThermalCurveFallsBackToDefaults)
         }));
 }
 
+TEST(GlobalSettingsTest, RemovedSettingCallbackIsNotCalled)
+{
+    GlobalSettings defaults;
+    int calls = 0;
+    const auto id = GlobalSettings::setSettingCB(GlobalSettings::SettingType::INTERACTION_TAP_DEBOUNCE_MS, std::function<void()>([&calls]() { calls++; }));
+
+    GlobalSettings::setSetting(GlobalSettings::SettingType::INTERACTION_TAP_DEBOUNCE_MS, 200);
+    EXPECT_EQ(calls, 1);
+    EXPECT_TRUE(GlobalSettings::removeSettingCB(id));
+    EXPECT_FALSE(GlobalSettings::removeSettingCB(id));
+    GlobalSettings::setSetting(GlobalSettings::SettingType::INTERACTION_TAP_DEBOUNCE_MS, 300);
+    EXPECT_EQ(calls, 1);
+}
+
+TEST(GlobalSettingsTest, CallbacksCanBeRegisteredWhileSettingsChange)
+{
+    GlobalSettings defaults;
+    std::atomic<bool> done { false };
+    std::atomic<int> calls { 0 };
+    std::thread setter([&done]() {
+        int value = 100;
+        while (!done.load()) {
+            GlobalSettings::setSetting(GlobalSettings::SettingType::INTERACTION_REST_STABLE_MS, value);
+            value = value == 100 ? 200 : 100;
+        }
+    });
+
+    std::vector<GlobalSettings::SettingCallbackId> ids;
+    for (int i = 0; i < 500; i++) {
+        ids.push_back(GlobalSettings::setSettingCB(GlobalSettings::SettingType::INTERACTION_REST_STABLE_MS, std::function<void()>([&calls]() { calls++; })));
+    }
+    while (calls.load() == 0) {
+        std::this_thread::yield();
+    }
+    for (const auto id : ids) {
+        EXPECT_TRUE(GlobalSettings::removeSettingCB(id));
+    }
+    done = true;
+    setter.join();
+}
+
 } // namespace
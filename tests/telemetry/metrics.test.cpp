@@ -0,0 +1,100 @@
+#include "../../src/telemetry/metrics.h"
+#include <gtest/gtest.h>
+
+#include <thread>
+#include <vector>
+
+namespace {
+
+TEST(MetricsHistogramTest, BucketBoundsCoverEveryValueWithBoundedRelativeError)
+{
+    const std::vector<uint64_t> values = { 0, 1, 7, 8, 9, 15, 16, 17, 100, 1000, 123456789, std::numeric_limits<uint64_t>::max() };
+    for (const auto value : values) {
+        const auto index = Metrics::Histogram::bucketIndex(value);
+        ASSERT_LT(index, Metrics::Histogram::kBucketCount);
+        const auto lower = Metrics::Histogram::bucketLowerBound(index);
+        const auto upper = Metrics::Histogram::bucketUpperBound(index);
+        EXPECT_LE(lower, value);
+        if (upper != 0) {
+            EXPECT_LT(value, upper);
+            EXPECT_LE(static_cast<double>(upper - lower), std::max(1.0, static_cast<double>(lower) / Metrics::Histogram::kSubBucketCount));
+        }
+    }
+}
+
+TEST(MetricsHistogramTest, ReportsPercentilesWithinBucketPrecision)
+{
+    Metrics::Histogram histogram;
+    for (uint64_t i = 1; i <= 1000; ++i) {
+        histogram.record(i);
+    }
+
+    const auto snapshot = histogram.snapshot();
+    EXPECT_EQ(snapshot.count, 1000u);
+    EXPECT_EQ(snapshot.sum, 500500u);
+    EXPECT_EQ(snapshot.min, 1u);
+    EXPECT_EQ(snapshot.max, 1000u);
+    EXPECT_NEAR(static_cast<double>(snapshot.percentile(0.5)), 500.0, 500.0 / Metrics::Histogram::kSubBucketCount);
+    EXPECT_NEAR(static_cast<double>(snapshot.percentile(0.99)), 990.0, 990.0 / Metrics::Histogram::kSubBucketCount);
+    EXPECT_EQ(snapshot.percentile(1.0), 1000u);
+}
+
+TEST(MetricsHistogramTest, ConcurrentRecordingLosesNoSamples)
+{
+    Metrics::Histogram histogram;
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 4; ++t) {
+        threads.emplace_back([&histogram]() {
+            for (uint64_t i = 0; i < 10000; ++i) {
+                histogram.record(i);
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    EXPECT_EQ(histogram.snapshot().count, 40000u);
+}
+
+TEST(MetricsRegistryTest, ReturnsSameSeriesForSameNameAndLabels)
+{
+    auto& registry = Metrics::MetricsRegistry::instance();
+    auto first = registry.counter("test_registry_counter_total", "Test counter", { { "lane", "a" } });
+    auto second = registry.counter("test_registry_counter_total", "Test counter", { { "lane", "a" } });
+    auto other = registry.counter("test_registry_counter_total", "Test counter", { { "lane", "b" } });
+
+    EXPECT_EQ(first, second);
+    EXPECT_NE(first, other);
+    EXPECT_THROW(registry.gauge("test_registry_counter_total", "Wrong type"), std::invalid_argument);
+}
+
+TEST(MetricsRegistryTest, ExportsJsonAndPrometheusText)
+{
+    auto& registry = Metrics::MetricsRegistry::instance();
+    registry.counter("test_export_events_total", "Events seen")->increment(3);
+    registry.gauge("test_export_depth", "Queue depth")->set(7);
+    auto histogram = registry.histogram("test_export_latency_ms", "Latency", { { "stage", "wake" } });
+    histogram->record(10);
+    histogram->record(20);
+
+    const auto json = registry.toJson();
+    bool foundHistogram = false;
+    for (const auto& metric : json["metrics"]) {
+        if (metric["name"] == "test_export_latency_ms") {
+            foundHistogram = true;
+            EXPECT_EQ(metric["type"], "histogram");
+            EXPECT_EQ(metric["series"][0]["labels"]["stage"], "wake");
+            EXPECT_EQ(metric["series"][0]["count"], 2);
+        }
+    }
+    EXPECT_TRUE(foundHistogram);
+
+    const auto text = registry.toPrometheus();
+    EXPECT_NE(text.find("# TYPE test_export_events_total counter"), std::string::npos);
+    EXPECT_NE(text.find("test_export_events_total 3\n"), std::string::npos);
+    EXPECT_NE(text.find("test_export_depth 7\n"), std::string::npos);
+    EXPECT_NE(text.find("test_export_latency_ms{stage=\"wake\",quantile=\"0.5\"}"), std::string::npos);
+    EXPECT_NE(text.find("test_export_latency_ms_count{stage=\"wake\"} 2\n"), std::string::npos);
+}
+
+} // namespace
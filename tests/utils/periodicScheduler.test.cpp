@@ -0,0 +1,132 @@
+#include "../../src/periodicScheduler.h"
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+namespace {
+
+using namespace std::chrono_literals;
+
+bool waitUntil(const std::function<bool()>& predicate, std::chrono::milliseconds timeout = 2000ms)
+{
+    const auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (std::chrono::steady_clock::now() < deadline) {
+        if (predicate()) {
+            return true;
+        }
+        std::this_thread::sleep_for(2ms);
+    }
+    return predicate();
+}
+
+const PeriodicTaskStats* findTask(const PeriodicSchedulerStats& stats, const std::string& name)
+{
+    for (const auto& task : stats.tasks) {
+        if (task.name == name) {
+            return &task;
+        }
+    }
+    return nullptr;
+}
+
+TEST(PeriodicSchedulerTest, TasksWithinTheirBudgetShareWakeups)
+{
+    PeriodicScheduler scheduler("test-coalesce");
+    std::atomic<int> strictRuns { 0 };
+    std::atomic<int> relaxedRuns { 0 };
+    scheduler.add({ "strict", 50ms, 0ms }, [&]() { strictRuns++; });
+    std::this_thread::sleep_for(20ms);
+    // Due 20 ms after "strict" each period, but allowed to wait for it.
+    scheduler.add({ "relaxed", 50ms, 40ms }, [&]() { relaxedRuns++; });
+
+    std::this_thread::sleep_for(600ms);
+    const auto stats = scheduler.stats();
+    ASSERT_GE(strictRuns.load(), 8);
+    ASSERT_GE(relaxedRuns.load(), 8);
+    // Without coalescing every run would need its own wakeup.
+    EXPECT_LE(stats.wakeups, static_cast<uint64_t>(strictRuns.load() + 4));
+
+    const auto* relaxed = findTask(stats, "relaxed");
+    ASSERT_NE(relaxed, nullptr);
+    EXPECT_EQ(relaxed->runs, static_cast<uint64_t>(relaxedRuns.load()));
+    EXPECT_EQ(relaxed->lateness.count, relaxed->runs);
+    EXPECT_GE(relaxed->lateness.max, 20000u);
+    EXPECT_LT(relaxed->lateness.max, 40000u + 20000u);
+}
+
+TEST(PeriodicSchedulerTest, PushedPeriodTakesEffectWithoutWaitingOutTheOldOne)
+{
+    PeriodicScheduler scheduler("test-period");
+    std::atomic<int> runs { 0 };
+    const auto task = scheduler.add({ "slow", 10s, 0ms }, [&]() { runs++; });
+    ASSERT_TRUE(waitUntil([&]() { return runs.load() == 1; }));
+
+    scheduler.setPeriod(task, 20ms);
+    EXPECT_TRUE(waitUntil([&]() { return runs.load() >= 4; }, 1000ms));
+    const auto stats = scheduler.stats();
+    ASSERT_EQ(stats.tasks.size(), 1u);
+    EXPECT_EQ(stats.tasks[0].period, 20ms);
+}
+
+TEST(PeriodicSchedulerTest, WakeRunsATaskAheadOfItsDeadlineAndBudget)
+{
+    PeriodicScheduler scheduler("test-wake");
+    std::atomic<int> runs { 0 };
+    const auto task = scheduler.add({ "idle", 10s, 200ms }, [&]() { runs++; });
+    ASSERT_TRUE(waitUntil([&]() { return runs.load() == 1; }));
+
+    scheduler.wake(task);
+    EXPECT_TRUE(waitUntil([&]() { return runs.load() == 2; }, 500ms));
+    std::this_thread::sleep_for(100ms);
+    EXPECT_EQ(runs.load(), 2);
+}
+
+TEST(PeriodicSchedulerTest, RemoveWaitsForARunningTaskAndTasksCanRemoveThemselves)
+{
+    PeriodicScheduler scheduler("test-remove");
+    std::atomic<bool> started { false };
+    std::atomic<bool> finished { false };
+    const auto slow = scheduler.add({ "slow", 10s, 0ms }, [&]() {
+        started = true;
+        std::this_thread::sleep_for(50ms);
+        finished = true;
+    });
+    ASSERT_TRUE(waitUntil([&]() { return started.load(); }));
+    scheduler.remove(slow);
+    EXPECT_TRUE(finished.load());
+
+    std::atomic<int> selfRuns { 0 };
+    PeriodicScheduler::TaskId self = 0;
+    std::atomic<bool> added { false };
+    self = scheduler.add({ "once", 5ms, 0ms }, [&]() {
+        while (!added.load()) {
+            std::this_thread::yield();
+        }
+        selfRuns++;
+        scheduler.remove(self);
+    });
+    added = true;
+    std::this_thread::sleep_for(100ms);
+    EXPECT_EQ(selfRuns.load(), 1);
+    EXPECT_TRUE(scheduler.stats().tasks.empty());
+}
+
+TEST(PeriodicSchedulerTest, AllStatsListsLiveSchedulers)
+{
+    auto countNamed = [](const std::string& name) {
+        int count = 0;
+        for (const auto& stats : PeriodicScheduler::allStats()) {
+            count += stats.name == name ? 1 : 0;
+        }
+        return count;
+    };
+    {
+        PeriodicScheduler scheduler("test-registry");
+        EXPECT_EQ(countNamed("test-registry"), 1);
+    }
+    EXPECT_EQ(countNamed("test-registry"), 0);
+}
+
+} // namespace
@@ -0,0 +1,92 @@
+/*
+███╗   ███╗███████╗███████╗██╗  ██╗██████╗ ██╗   ██╗███╗   ██╗██████╗ ██╗     ███████╗██████╗     ██████╗██████╗ ██████╗
+████╗ ████║██╔════╝██╔════╝██║  ██║██╔══██╗██║   ██║████╗  ██║██╔══██╗██║     ██╔════╝██╔══██╗   ██╔════╝██╔══██╗██╔══██╗
+██╔████╔██║█████╗  ███████╗███████║██████╔╝██║   ██║██╔██╗ ██║██║  ██║██║     █████╗  ██████╔╝   ██║     ██████╔╝██████╔╝
+██║╚██╔╝██║██╔══╝  ╚════██║██╔══██║██╔══██╗██║   ██║██║╚██╗██║██║  ██║██║     ██╔══╝  ██╔══██╗   ██║     ██╔═══╝ ██╔═══╝
+██║ ╚═╝ ██║███████╗███████║██║  ██║██████╔╝╚██████╔╝██║ ╚████║██████╔╝███████╗███████╗██║  ██║██╗╚██████╗██║     ██║
+╚═╝     ╚═╝╚══════╝╚══════╝╚═╝  ╚═╝╚═════╝  ╚═════╝ ╚═╝  ╚═══╝╚═════╝ ╚══════╝╚══════╝╚═╝  ╚═╝╚═╝ ╚═════╝╚═╝     ╚═╝
+*/
+
+/*
+MIT License
+
+Copyright (c) 2026 A-McD Technology LLC
+*/
+
+
+// CubeMeshBundler <meshes dir>
+//
+// Bakes every mesh folder under <meshes dir> into <folder>/bundle.cmb (see meshBundle.h), parsing each
+// source with the same code the loaders fall back to. Run it from the directory the application runs
+// from: OBJ files name their .mtl relative to the working directory.
+
+#include "../../src/gui/renderables/meshBundle.h"
+#include <filesystem>
+#include <iostream>
+
+namespace {
+
+bool bundleFolder(const std::filesystem::path& folder)
+{
+    MeshBundleWriter writer;
+    for (const auto& file : std::filesystem::directory_iterator(folder)) {
+        if (file.is_directory()) {
+            continue;
+        }
+        const std::string path = file.path().string();
+        const std::string fileName = file.path().filename().string();
+        const std::string extension = file.path().extension().string();
+        uint64_t sourceHash = 0;
+        if (fileName == MeshBundle::FILE_NAME || !MeshBundle::hashFile(path, sourceHash)) {
+            continue;
+        }
+        // the same selection rules as MeshLoader, AnimationLoader and ExpressionLoader
+        if (extension == ".obj") {
+            std::vector<Vertex> vertices;
+            size_t shapeCount = 0;
+            if (MeshLoader::parseObj(path, vertices, shapeCount)) {
+                writer.addObjMesh(fileName, sourceHash, vertices, static_cast<uint32_t>(shapeCount));
+            }
+        } else if (extension == ".mesh") {
+            writer.addCubes(fileName, sourceHash, MeshLoader::parseCubes(path));
+        }
+        if (extension == ".json" && fileName.find("expr_") == 0) {
+            writer.addExpression(fileName, sourceHash, ExpressionLoader::loadExpression(path));
+        }
+        if (extension == ".json" && (fileName.find("anim_") != std::string::npos || fileName.find("animation_") != std::string::npos)) {
+            writer.addAnimation(fileName, sourceHash, AnimationLoader::loadAnimation(path));
+        }
+    }
+    if (writer.size() == 0) {
+        return true;
+    }
+    const std::string output = (folder / MeshBundle::FILE_NAME).string();
+    if (!writer.write(output)) {
+        std::cerr << "CubeMeshBundler: failed to write " << output << std::endl;
+        return false;
+    }
+    std::cout << "CubeMeshBundler: wrote " << writer.size() << " entries to " << output << std::endl;
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    if (argc != 2) {
+        std::cerr << "usage: CubeMeshBundler <meshes dir>" << std::endl;
+        return 2;
+    }
+    std::error_code error;
+    if (!std::filesystem::is_directory(argv[1], error)) {
+        std::cerr << "CubeMeshBundler: not a directory: " << argv[1] << std::endl;
+        return 1;
+    }
+    bool ok = true;
+    for (const auto& entry : std::filesystem::directory_iterator(argv[1])) {
+        if (entry.is_directory()) {
+            ok = bundleFolder(entry.path()) && ok;
+        }
+    }
+    return ok ? 0 : 1;
+}